@@ -171,6 +171,12 @@
 // kd 木 | kd-tree
 # include <Siv3D/KDTree.hpp>
 
+// 点の追加・削除に対応した kd 木 | Dynamic kd-tree
+# include <Siv3D/DynamicKDTree.hpp>
+
+// 2D 図形の空間ハッシュ | Spatial hash for 2D shapes
+# include <Siv3D/SpatialHash2D.hpp>
+
 //////////////////////////////////////////////////
 //
 //	並列・並行処理 | Parallel and Concurrent
@@ -339,6 +345,9 @@
 // プロファイラー | Profiler
 # include <Siv3D/Profiler.hpp>
 
+// 区間計測 | Scoped profiler zone
+# include <Siv3D/ProfilerZone.hpp>
+
 // 処理にかかった時間の測定 | Clock counter in milliseconds
 # include <Siv3D/MillisecClock.hpp>
 
@@ -447,6 +456,12 @@
 // ZIP 圧縮ファイルの書き出し | ZIP writer
 //# include <Siv3D/ZIPWriter.hpp> // [Siv3D ToDo]
 
+// アセットアーカイブの読み込み | Asset archive reader
+# include <Siv3D/AssetArchive.hpp>
+
+// アセットアーカイブの作成 | Asset archive writer
+# include <Siv3D/AssetArchiveWriter.hpp>
+
 //////////////////////////////////////////////////
 //
 //	テキストファイルと設定ファイル | Text Files and Configuration Files
@@ -1358,6 +1373,10 @@
 
 # include <Siv3D/AssetInfo.hpp>
 
+# include <Siv3D/AssetLoadPriority.hpp>
+
+# include <Siv3D/AssetLoadProgress.hpp>
+
 # include <Siv3D/Asset.hpp>
 
 # include <Siv3D/AudioAssetData.hpp>
@@ -1391,6 +1410,9 @@
 // ナビメッシュ | Navigation mesh
 # include <Siv3D/NavMesh.hpp>
 
+// 群衆シミュレーション | Crowd simulation
+# include <Siv3D/NavCrowd.hpp>
+
 //////////////////////////////////////////////////
 //
 //	シーン | Scene
@@ -1432,6 +1454,9 @@
 // レンダーステートスコープ | Render states scope
 # include <Siv3D/ScopedRenderStates2D.hpp>
 
+// 描画順序の並べ替えスコープ | Batch reorder scope
+# include <Siv3D/ScopedBatchReorder.hpp>
+
 // 2D 座標変換スコープ | 2D Transformation scope
 # include <Siv3D/Transformer2D.hpp>
 
@@ -1529,6 +1554,9 @@
 // テクスチャ | Texture
 # include <Siv3D/Texture.hpp>
 
+// インスタンス描画用のスプライトデータ | Sprite instance data
+# include <Siv3D/SpriteInstance.hpp>
+
 # include <Siv3D/TextureRegion.hpp>
 
 // 円に貼り付けたテクスチャ
@@ -1563,6 +1591,7 @@
 # include <Siv3D/BitmapGlyph.hpp>
 # include <Siv3D/SDFGlyph.hpp>
 # include <Siv3D/MSDFGlyph.hpp>
+# include <Siv3D/GlyphCacheStat.hpp>
 
 // フォント描画方式 | Font rendering method
 # include <Siv3D/FontMethod.hpp>
@@ -1693,6 +1722,7 @@
 # include <Siv3D/Physics2D/P2ContactPair.hpp>
 # include <Siv3D/Physics2D/P2Contact.hpp>
 # include <Siv3D/Physics2D/P2Collision.hpp>
+# include <Siv3D/Physics2D/P2WorldProfile.hpp>
 # include <Siv3D/Physics2D/P2World.hpp>
 # include <Siv3D/Physics2D/P2Body.hpp>
 # include <Siv3D/Physics2D/P2Shape.hpp>
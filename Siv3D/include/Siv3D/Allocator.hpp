@@ -33,6 +33,14 @@ namespace s3d
 
 		static constexpr size_t alignment = Alignment;
 
+		/// @brief アライメントを保ったまま、別の型のアロケータを得ます。
+		/// @remark Alignment が非型テンプレート引数であるため、std::allocator_traits による既定の rebind が使えません。
+		template <class Other>
+		struct rebind
+		{
+			using other = Allocator<Other, ((alignof(Other) < Alignment) ? Alignment : alignof(Other))>;
+		};
+
 		SIV3D_NODISCARD_CXX20
 		constexpr Allocator() noexcept = default;
 
@@ -13,6 +13,7 @@
 # include "Common.hpp"
 # include <vector>
 # ifndef SIV3D_NO_CONCURRENT_API
+	# include <atomic>
 	# include <future>
 	# if SIV3D_PLATFORM(WINDOWS)
 	#	include <execution>
@@ -10,11 +10,14 @@
 //-----------------------------------------------
 
 # pragma once
+# include <functional>
 # include "Common.hpp"
 # include "String.hpp"
 # include "Array.hpp"
 # include "AssetState.hpp"
 # include "AssetInfo.hpp"
+# include "AssetLoadPriority.hpp"
+# include "AssetLoadProgress.hpp"
 
 namespace s3d
 {
@@ -48,6 +51,21 @@ namespace s3d
 		[[nodiscard]]
 		bool isFinished() const;
 
+		/// @brief 非同期ロードの優先度を設定します。
+		/// @param priority 優先度
+		/// @remark 待機中の非同期ロードの優先度を上げた場合、新しい優先度で再度キューに入ります。
+		void setLoadPriority(AssetLoadPriority priority);
+
+		/// @brief 非同期ロードの優先度を返します。
+		/// @return 非同期ロードの優先度
+		[[nodiscard]]
+		AssetLoadPriority getLoadPriority() const;
+
+		/// @brief まだ開始していない非同期ロードを取り消します。
+		/// @return 取り消せた場合 true, ロードがすでに開始しているか、非同期ロード中でない場合は false
+		/// @remark 取り消されたアセットは未初期化の状態に戻ります。
+		bool cancelLoadAsync();
+
 	protected:
 
 		[[nodiscard]]
@@ -58,10 +76,43 @@ namespace s3d
 
 		void setState(AssetState state);
 
+		/// @brief アセットローダーのスレッドプールで非同期ロードを開始します。
+		/// @param load ロード処理。成功した場合 true を返す関数
+		/// @remark アセットの状態を AsyncLoading にし、完了時に Loaded または Failed にします。
+		void startLoadAsync(std::function<bool()> load);
+
+		/// @brief 非同期ロードの完了を待ちます。
+		/// @remark ロードがまだ開始していない場合は、呼び出し元のスレッドで実行します。
+		void waitLoadAsync();
+
 	private:
 
 		class IAssetDetail;
 
 		std::shared_ptr<IAssetDetail> pImpl;
 	};
+
+	namespace Asset
+	{
+		/// @brief 指定したタグを持つすべての登録済みアセットの非同期ロードを開始します。 | Starts asynchronous loading of all registered assets with the specified tag.
+		/// @param tag アセットタグ | Asset tag
+		/// @param priority 非同期ロードの優先度 | Loading priority
+		/// @return グループに含まれるアセットの数 | Number of assets in the group
+		size_t LoadAsyncGroup(const AssetTag& tag, AssetLoadPriority priority = AssetLoadPriority::Normal);
+
+		/// @brief 指定したタグを持つアセットのロードの進捗を返します。 | Returns the loading progress of the assets with the specified tag.
+		/// @param tag アセットタグ | Asset tag
+		/// @return ロードの進捗 | Loading progress
+		[[nodiscard]]
+		AssetLoadProgress GetGroupProgress(const AssetTag& tag);
+
+		/// @brief 指定したタグを持つアセットの、まだ開始していない非同期ロードを取り消します。 | Cancels queued asynchronous loading of the assets with the specified tag.
+		/// @param tag アセットタグ | Asset tag
+		/// @return 取り消したアセットの数 | Number of canceled assets
+		size_t CancelGroup(const AssetTag& tag);
+
+		/// @brief 指定したタグを持つアセットの非同期ロードの完了を待ちます。 | Waits for asynchronous loading of the assets with the specified tag to finish.
+		/// @param tag アセットタグ | Asset tag
+		void WaitGroup(const AssetTag& tag);
+	}
 }
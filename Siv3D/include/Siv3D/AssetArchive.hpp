@@ -0,0 +1,157 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+# pragma once
+# include <memory>
+# include "Common.hpp"
+# include "String.hpp"
+# include "Array.hpp"
+# include "Blob.hpp"
+# include "MemoryReader.hpp"
+# include "MemoryViewReader.hpp"
+# include "Image.hpp"
+# include "Wave.hpp"
+# include "Texture.hpp"
+
+namespace s3d
+{
+	/// @brief アセットアーカイブ (.s3da) の読み込み | Asset archive (.s3da) reader
+	/// @remark ファイル全体をメモリマップし、非圧縮のエントリはマップされたページから直接読み込みます。
+	/// @remark アーカイブは AssetArchiveWriter で作成します。
+	class AssetArchive
+	{
+	public:
+
+		/// @brief エントリのデータへの参照 | Reference to the data of an entry
+		/// @remark owner を保持している間、data は有効です。アーカイブを閉じた後も有効です。
+		struct SharedView
+		{
+			/// @brief data の寿命を管理するオブジェクト
+			std::shared_ptr<const void> owner;
+
+			/// @brief エントリのデータの先頭へのポインタ
+			const Byte* data = nullptr;
+
+			/// @brief エントリのデータのサイズ（バイト）
+			size_t size = 0;
+
+			[[nodiscard]]
+			explicit operator bool() const noexcept
+			{
+				return (data != nullptr);
+			}
+		};
+
+		SIV3D_NODISCARD_CXX20
+		AssetArchive();
+
+		/// @brief アセットアーカイブを開きます。 | Opens an asset archive.
+		/// @param path アーカイブのパス | Path to the archive
+		SIV3D_NODISCARD_CXX20
+		explicit AssetArchive(FilePathView path);
+
+		~AssetArchive();
+
+		/// @brief アセットアーカイブを開きます。 | Opens an asset archive.
+		/// @param path アーカイブのパス | Path to the archive
+		/// @return 開くのに成功した場合 true, それ以外の場合は false | True if succeeded, false otherwise
+		bool open(FilePathView path);
+
+		/// @brief アセットアーカイブを閉じます。 | Closes the asset archive.
+		/// @remark すでに取得した SharedView や、アーカイブから作成した Font は引き続き有効です。
+		void close();
+
+		[[nodiscard]]
+		bool isOpen() const noexcept;
+
+		[[nodiscard]]
+		explicit operator bool() const noexcept;
+
+		/// @brief アーカイブに含まれるファイルのパスの一覧を返します。 | Returns the paths of the files in the archive.
+		/// @return ファイルのパスの一覧 | Paths of the files
+		[[nodiscard]]
+		const Array<FilePath>& enumPaths() const;
+
+		/// @brief アーカイブにファイルが含まれるかを返します。 | Returns whether the archive contains the file.
+		/// @param path ファイルのパス | Path to the file
+		/// @return ファイルが含まれる場合 true, それ以外の場合は false | True if the archive contains the file, false otherwise
+		[[nodiscard]]
+		bool contains(FilePathView path) const;
+
+		/// @brief ファイルが圧縮されて格納されているかを返します。 | Returns whether the file is stored compressed.
+		/// @param path ファイルのパス | Path to the file
+		/// @return 圧縮されている場合 true, 非圧縮の場合やファイルが無い場合は false | True if compressed, false otherwise
+		[[nodiscard]]
+		bool isCompressed(FilePathView path) const;
+
+		/// @brief ファイルの展開後のサイズを返します。 | Returns the uncompressed size of the file.
+		/// @param path ファイルのパス | Path to the file
+		/// @return ファイルのサイズ（バイト）。ファイルが無い場合は 0 | Size of the file in bytes, or 0 if not found
+		[[nodiscard]]
+		int64 fileSize(FilePathView path) const;
+
+		/// @brief 非圧縮のファイルを、マップされたページから直接読み込むリーダーを返します。 | Returns a reader that reads an uncompressed file directly from the mapped pages.
+		/// @param path ファイルのパス | Path to the file
+		/// @return リーダー。ファイルが無いか圧縮されている場合は空のリーダー | Reader, or an empty reader if the file is not found or compressed
+		/// @remark リーダーはアーカイブを閉じるまで有効です。
+		[[nodiscard]]
+		MemoryViewReader view(FilePathView path) const;
+
+		/// @brief ファイルのデータへの参照を返します。 | Returns a reference to the data of the file.
+		/// @param path ファイルのパス | Path to the file
+		/// @return 非圧縮のファイルはマップされたページを、圧縮されたファイルは展開したデータを参照します。 | Refers to the mapped pages for uncompressed files, or to the decompressed data for compressed ones
+		[[nodiscard]]
+		SharedView acquire(FilePathView path) const;
+
+		/// @brief ファイルを展開して MemoryReader で返します。 | Extracts the file into a MemoryReader.
+		/// @param path ファイルのパス | Path to the file
+		/// @return ファイルのデータを持つ MemoryReader | MemoryReader that owns the file data
+		[[nodiscard]]
+		MemoryReader extract(FilePathView path) const;
+
+		/// @brief ファイルを展開して Blob で返します。 | Extracts the file into a Blob.
+		/// @param path ファイルのパス | Path to the file
+		/// @return ファイルのデータ | File data
+		[[nodiscard]]
+		Blob extractToBlob(FilePathView path) const;
+
+		/// @brief 画像ファイルを読み込みます。 | Loads an image file.
+		/// @param path ファイルのパス | Path to the file
+		/// @param format 画像のフォーマット | Image format
+		/// @return 読み込んだ画像 | Loaded image
+		[[nodiscard]]
+		Image loadImage(FilePathView path, ImageFormat format = ImageFormat::Unspecified) const;
+
+		/// @brief 音声ファイルを読み込みます。 | Loads an audio file.
+		/// @param path ファイルのパス | Path to the file
+		/// @param format 音声のフォーマット | Audio format
+		/// @return 読み込んだ音声 | Loaded audio
+		[[nodiscard]]
+		Wave loadWave(FilePathView path, AudioFormat format = AudioFormat::Unspecified) const;
+
+		/// @brief 画像ファイルからテクスチャを作成します。 | Creates a texture from an image file.
+		/// @param path ファイルのパス | Path to the file
+		/// @param desc テクスチャの設定 | Texture description
+		/// @return 作成したテクスチャ | Created texture
+		[[nodiscard]]
+		Texture loadTexture(FilePathView path, TextureDesc desc = TextureDesc::Unmipped) const;
+
+		/// @brief アーカイブのパスを返します。 | Returns the path to the archive.
+		/// @return アーカイブのパス | Path to the archive
+		[[nodiscard]]
+		const FilePath& path() const noexcept;
+
+	private:
+
+		class AssetArchiveDetail;
+
+		std::shared_ptr<AssetArchiveDetail> pImpl;
+	};
+}
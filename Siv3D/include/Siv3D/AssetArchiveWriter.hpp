@@ -0,0 +1,80 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+# pragma once
+# include <memory>
+# include "Common.hpp"
+# include "String.hpp"
+# include "Blob.hpp"
+# include "Compression.hpp"
+
+namespace s3d
+{
+	/// @brief アセットアーカイブ (.s3da) の作成 | Asset archive (.s3da) builder
+	/// @remark 追加したファイルは save() を呼ぶまで読み込まれません。
+	class AssetArchiveWriter
+	{
+	public:
+
+		/// @brief 圧縮せずに格納することを表す圧縮レベル | Compression level that stores the file uncompressed
+		static constexpr int32 Store = 0;
+
+		/// @brief 非圧縮のエントリの既定のアライメント（バイト） | Default alignment of uncompressed entries in bytes
+		static constexpr uint32 DefaultAlignment = 16;
+
+		SIV3D_NODISCARD_CXX20
+		AssetArchiveWriter();
+
+		~AssetArchiveWriter();
+
+		/// @brief ファイルを追加します。 | Adds a file.
+		/// @param sourcePath 追加するファイルのパス | Path to the source file
+		/// @param archivePath アーカイブ内のパス | Path in the archive
+		/// @param compressionLevel zstd の圧縮レベル。Store の場合は圧縮しない | zstd compression level, or Store to keep it uncompressed
+		/// @return 追加に成功した場合 true, すでに同じパスのファイルがある場合は false | True if added, false if the path already exists
+		/// @remark 圧縮してもサイズがほとんど減らない場合は、マップしたページから直接読めるよう非圧縮で格納します。
+		bool addFile(FilePathView sourcePath, FilePathView archivePath, int32 compressionLevel = Compression::DefaultLevel);
+
+		/// @brief メモリ上のデータを追加します。 | Adds data in memory.
+		/// @param blob データ | Data
+		/// @param archivePath アーカイブ内のパス | Path in the archive
+		/// @param compressionLevel zstd の圧縮レベル。Store の場合は圧縮しない | zstd compression level, or Store to keep it uncompressed
+		/// @return 追加に成功した場合 true, すでに同じパスのファイルがある場合は false | True if added, false if the path already exists
+		bool addBlob(const Blob& blob, FilePathView archivePath, int32 compressionLevel = Compression::DefaultLevel);
+
+		/// @brief ディレクトリ内のすべてのファイルを追加します。 | Adds all files in a directory.
+		/// @param sourceDirectory 追加するディレクトリのパス | Path to the source directory
+		/// @param archiveDirectory アーカイブ内の追加先のディレクトリ | Destination directory in the archive
+		/// @param compressionLevel zstd の圧縮レベル。Store の場合は圧縮しない | zstd compression level, or Store to keep it uncompressed
+		/// @return 追加したファイルの数 | Number of added files
+		size_t addDirectory(FilePathView sourceDirectory, FilePathView archiveDirectory = U"", int32 compressionLevel = Compression::DefaultLevel);
+
+		/// @brief 非圧縮のエントリのアライメントを設定します。 | Sets the alignment of uncompressed entries.
+		/// @param alignment アライメント（バイト、2 の累乗） | Alignment in bytes (power of two)
+		/// @remark ページサイズ (4096) を指定すると、各エントリをページ境界から直接マップできます。
+		void setAlignment(uint32 alignment);
+
+		/// @brief 追加したファイルの数を返します。 | Returns the number of added files.
+		/// @return 追加したファイルの数 | Number of added files
+		[[nodiscard]]
+		size_t num_entries() const noexcept;
+
+		/// @brief アーカイブをファイルに書き出します。 | Writes the archive to a file.
+		/// @param path 書き出すファイルのパス | Path to the output file
+		/// @return 書き出しに成功した場合 true, それ以外の場合は false | True if succeeded, false otherwise
+		bool save(FilePathView path) const;
+
+	private:
+
+		class AssetArchiveWriterDetail;
+
+		std::shared_ptr<AssetArchiveWriterDetail> pImpl;
+	};
+}
@@ -0,0 +1,28 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+# pragma once
+# include "Common.hpp"
+
+namespace s3d
+{
+	/// @brief アセットの非同期ロードの優先度 | Priority of asynchronous asset loading
+	enum class AssetLoadPriority : uint8
+	{
+		/// @brief 低い | Low
+		Low,
+
+		/// @brief 通常 | Normal
+		Normal,
+
+		/// @brief 高い | High
+		High,
+	};
+}
@@ -0,0 +1,48 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+# pragma once
+# include "Common.hpp"
+
+namespace s3d
+{
+	/// @brief アセットのグループの非同期ロードの進捗 | Progress of asynchronous loading of an asset group
+	struct AssetLoadProgress
+	{
+		/// @brief グループに含まれるアセットの数 | Number of assets in the group
+		size_t total = 0;
+
+		/// @brief ロードに成功したアセットの数 | Number of assets loaded successfully
+		size_t loaded = 0;
+
+		/// @brief ロードに失敗したアセットの数 | Number of assets that failed to load
+		size_t failed = 0;
+
+		/// @brief 非同期ロード中 (待機中を含む) のアセットの数 | Number of assets being loaded asynchronously (including queued ones)
+		size_t loading = 0;
+
+		/// @brief ロードが完了した (成功または失敗した) アセットの数を返します。 | Returns the number of assets whose loading has finished (succeeded or failed).
+		/// @return ロードが完了したアセットの数 | Number of finished assets
+		[[nodiscard]]
+		constexpr size_t finished() const noexcept;
+
+		/// @brief 進捗を 0.0 から 1.0 の範囲で返します。 | Returns the progress in the range [0.0, 1.0].
+		/// @return 進捗。グループが空の場合は 1.0 | Progress. 1.0 if the group is empty
+		[[nodiscard]]
+		constexpr double progress() const noexcept;
+
+		/// @brief 非同期ロード中のアセットが無いかを返します。 | Returns whether no asset in the group is being loaded asynchronously.
+		/// @return 非同期ロード中のアセットが無い場合 true, それ以外の場合は false | True if no asset is being loaded, false otherwise
+		[[nodiscard]]
+		constexpr bool isFinished() const noexcept;
+	};
+}
+
+# include "detail/AssetLoadProgress.ipp"
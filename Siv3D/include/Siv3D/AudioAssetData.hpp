@@ -69,9 +69,5 @@ namespace s3d
 		static bool DefaultLoad(AudioAssetData& asset, const String& hint);
 
 		static void DefaultRelease(AudioAssetData& asset);
-
-	private:
-
-		AsyncTask<void> m_task;
 	};
 }
@@ -0,0 +1,174 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+# include "Array.hpp"
+# include "KDTree.hpp"
+
+namespace s3d
+{
+	/// @brief 点の追加・削除に対応した kd-tree | kd-tree that supports inserting and removing points
+	/// @tparam DatasetAdapter kd-tree 用のアダプタ型
+	/// @remark 大きさが 2 のべき乗の静的な kd-tree の集まりで点を管理し、追加は償却 O(log^2 N) で行います。
+	/// @remark 削除された点は探索から除外され、削除された点が多くなると自動的に再構築されます。
+	/// @remark 全体の再構築 rebuildIndex() はスレッドプールで並列に行います。ほとんどの点が毎フレーム動く場合は、rebuildIndex() のほうが高速です。
+	/// @remark データセットの点を動かした場合は、その点の update() を呼んでください。
+	template <class DatasetAdapter>
+	class DynamicKDTree
+	{
+	public:
+
+		using adapter_type	= detail::KDAdapter<DatasetAdapter>;
+
+		using point_type	= typename adapter_type::point_type;
+
+		using element_type	= typename adapter_type::element_type;
+
+		using dataset_type	= typename adapter_type::dataset_type;
+
+		static constexpr int32 Dimensions = adapter_type::Dimensions;
+
+		/// @brief 葉に格納する点の最大数
+		static constexpr size_t LeafSize = 10;
+
+		DynamicKDTree() = default;
+
+		/// @brief データセットのすべての点から kd-tree を構築します。
+		/// @param dataset データセット。kd-tree より長く存在する必要があります。
+		explicit DynamicKDTree(const dataset_type& dataset);
+
+		/// @brief データセットのすべての点から kd-tree を並列に構築し直します。
+		void rebuildIndex();
+
+		/// @brief データセットの index 番目の点を追加します。
+		/// @param index 追加する点のインデックス
+		/// @remark 既に追加されている場合は update() と同じです。
+		void insert(size_t index);
+
+		/// @brief データセットの index 番目の点を取り除きます。
+		/// @param index 取り除く点のインデックス
+		void remove(size_t index);
+
+		/// @brief 位置が変わったデータセットの index 番目の点を更新します。
+		/// @param index 更新する点のインデックス
+		void update(size_t index);
+
+		/// @brief データセットの index 番目の点が kd-tree に含まれているかを返します。
+		/// @param index 点のインデックス
+		/// @return 含まれている場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool contains(size_t index) const noexcept;
+
+		/// @brief kd-tree に含まれている点の数を返します。
+		/// @return kd-tree に含まれている点の数
+		[[nodiscard]]
+		size_t size() const noexcept;
+
+		[[nodiscard]]
+		bool isEmpty() const noexcept;
+
+		void release();
+
+		[[nodiscard]]
+		size_t usedMemory() const;
+
+		[[nodiscard]]
+		Array<size_t> knnSearch(size_t k, const point_type& point) const;
+
+		void knnSearch(Array<size_t>& results, size_t k, const point_type& point) const;
+
+		void knnSearch(Array<size_t>& results, Array<element_type>& distanceSqResults, size_t k, const point_type& point) const;
+
+		[[nodiscard]]
+		Array<size_t> radiusSearch(const point_type& point, element_type radius, SortByDistance sortByDistance = SortByDistance::No) const;
+
+		void radiusSearch(Array<size_t>& results, const point_type& point, element_type radius, SortByDistance sortByDistance = SortByDistance::No) const;
+
+		/// @brief 複数の点それぞれについて、近い順に k 個の点を並列に探索します。
+		/// @param k 探索する点の数
+		/// @param points 探索の中心となる点
+		/// @return points[i] に対する探索結果を i 番目に格納した配列
+		[[nodiscard]]
+		Array<Array<size_t>> knnSearchBatch(size_t k, const Array<point_type>& points) const;
+
+		void knnSearchBatch(Array<Array<size_t>>& results, size_t k, const Array<point_type>& points) const;
+
+		/// @brief 複数の点それぞれについて、半径 radius 以内にある点を並列に探索します。
+		/// @param points 探索の中心となる点
+		/// @param radius 探索する半径
+		/// @param sortByDistance 結果を距離の近い順に並べるか
+		/// @return points[i] に対する探索結果を i 番目に格納した配列
+		[[nodiscard]]
+		Array<Array<size_t>> radiusSearchBatch(const Array<point_type>& points, element_type radius, SortByDistance sortByDistance = SortByDistance::No) const;
+
+		void radiusSearchBatch(Array<Array<size_t>>& results, const Array<point_type>& points, element_type radius, SortByDistance sortByDistance = SortByDistance::No) const;
+
+	private:
+
+		struct Node
+		{
+			/// @brief 分割する次元。葉の場合は -1
+			int32 dim = -1;
+
+			element_type split = 0;
+
+			uint32 left = 0;
+
+			uint32 right = 0;
+
+			/// @brief 葉に含まれる点の、Tree::indices における範囲 [begin, end)
+			uint32 begin = 0;
+
+			uint32 end = 0;
+		};
+
+		struct Tree
+		{
+			Array<Node> nodes;
+
+			Array<size_t> indices;
+		};
+
+		static constexpr int8 NotContained = -1;
+
+		const dataset_type* m_dataset = nullptr;
+
+		/// @brief 大きさが 2^i 以下の kd-tree
+		Array<Tree> m_trees;
+
+		/// @brief 各点を含む kd-tree の番号。含まれない場合は NotContained
+		Array<int8> m_locations;
+
+		size_t m_size = 0;
+
+		/// @brief kd-tree に残っている、取り除かれたか更新前の古い点の数
+		size_t m_staleCount = 0;
+
+		[[nodiscard]]
+		element_type getElement(size_t index, size_t dim) const;
+
+		void buildTree(size_t treeIndex, Array<size_t>&& indices);
+
+		size_t splitRange(Array<size_t>& indices, size_t begin, size_t end, Node& node) const;
+
+		uint32 buildNode(Array<Node>& nodes, Array<size_t>& indices, size_t begin, size_t end) const;
+
+		void compact();
+
+		void compactIfNeeded();
+
+		template <class ResultSet>
+		void search(const Tree& tree, int8 treeIndex, const Node& node, const element_type* point, ResultSet& resultSet) const;
+	};
+}
+
+# include "detail/DynamicKDTree.ipp"
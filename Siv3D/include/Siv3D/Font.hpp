@@ -25,12 +25,14 @@
 # include "Typeface.hpp"
 # include "TextStyle.hpp"
 # include "Glyph.hpp"
+# include "GlyphCacheStat.hpp"
 # include "PixelShader.hpp"
 # include "PredefinedYesNo.hpp"
 
 namespace s3d
 {
 	struct DrawableText;
+	class AssetArchive;
 
 	/// @brief フォント
 	class Font : public AssetHandle<Font>
@@ -88,6 +90,27 @@ namespace s3d
 		SIV3D_NODISCARD_CXX20
 		Font(FontMethod fontMethod, int32 fontSize, Typeface typeface = Typeface::Regular, FontStyle style = FontStyle::Default);
 
+		/// @brief アセットアーカイブ内のフォントファイルからフォントを作成します。
+		/// @param fontSize フォントの基本サイズ
+		/// @param archive アセットアーカイブ
+		/// @param path アーカイブ内のフォントファイルのパス
+		/// @param style フォントのスタイル
+		/// @remark 非圧縮で格納されたフォントファイルは、コピーせずにマップされたページから直接読み込みます。
+		SIV3D_NODISCARD_CXX20
+		Font(int32 fontSize, const AssetArchive& archive, FilePathView path, FontStyle style = FontStyle::Default);
+
+		/// @brief アセットアーカイブ内のフォントファイルからフォントを作成します。
+		/// @param fontMethod フォントのレンダリング方式
+		/// @param fontSize フォントの基本サイズ
+		/// @param archive アセットアーカイブ
+		/// @param path アーカイブ内のフォントファイルのパス
+		/// @param faceIndex フォントファイルが複数のフォントコレクションを含む場合のインデックス
+		/// @param style フォントのスタイル
+		/// @remark 非圧縮で格納されたフォントファイルは、コピーせずにマップされたページから直接読み込みます。
+		/// @remark フォントが参照するデータは、アーカイブを閉じた後もフォントが破棄されるまで保持されます。
+		SIV3D_NODISCARD_CXX20
+		Font(FontMethod fontMethod, int32 fontSize, const AssetArchive& archive, FilePathView path, size_t faceIndex = 0, FontStyle style = FontStyle::Default);
+
 		/// @brief デストラクタ
 		virtual ~Font();
 
@@ -366,11 +389,25 @@ namespace s3d
 		/// @return 事前生成に成功した場合 true, それ以外の場合は false
 		bool preload(StringView chars) const;
 
+		/// @brief 指定した文字列のためのグリフの生成を、スレッドプールで非同期に開始します。
+		/// @param chars 文字列
+		/// @remark SDF / MSDF フォントでは、グリフの画像の生成がワーカースレッドで行われ、完了したグリフはその後のフレームで描画時にキャッシュテクスチャに登録されます。
+		/// @remark 生成が完了する前に描画されたグリフは、従来通り描画時に生成されます。
+		/// @remark Bitmap フォントでは `preload()` と同じです。
+		/// @return 事前生成の開始に成功した場合 true, それ以外の場合は false
+		bool preloadAsync(StringView chars) const;
+
 		/// @brief フォントの内部でキャッシュされているテクスチャを返します。
+		/// @remark キャッシュテクスチャが複数のページに分かれている場合、最初のページを返します。
 		/// @return フォントの内部でキャッシュされているテクスチャ
 		[[nodiscard]]
 		const Texture& getTexture() const;
 
+		/// @brief フォントの内部のグリフキャッシュの統計情報を返します。
+		/// @return グリフキャッシュの統計情報
+		[[nodiscard]]
+		GlyphCacheStat getGlyphCacheStat() const;
+
 		/// @brief 指定した文字の描画用のグリフを返します。
 		/// @param ch 文字
 		/// @return 描画用グリフ
@@ -57,9 +57,5 @@ namespace s3d
 		static bool DefaultLoad(FontAssetData& asset, const String& hint);
 
 		static void DefaultRelease(FontAssetData& asset);
-
-	private:
-
-		AsyncTask<void> m_task;
 	};
 }
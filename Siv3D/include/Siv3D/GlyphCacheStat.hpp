@@ -0,0 +1,47 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+
+namespace s3d
+{
+	/// @brief フォントのグリフキャッシュの統計情報
+	struct GlyphCacheStat
+	{
+		/// @brief キャッシュ済みのグリフが参照された回数
+		uint64 hitCount = 0;
+
+		/// @brief キャッシュに無く、新たにレンダリングされたグリフの数
+		uint64 missCount = 0;
+
+		/// @brief ページの追い出しによってキャッシュから削除されたグリフの数
+		uint64 evictedGlyphCount = 0;
+
+		/// @brief 追い出されたページの数
+		uint64 evictedPageCount = 0;
+
+		/// @brief 使用中のキャッシュテクスチャのページ数
+		uint32 pageCount = 0;
+
+		/// @brief 現在キャッシュされているグリフの数
+		uint32 glyphCount = 0;
+
+		/// @brief キャッシュのヒット率を返します。
+		/// @return キャッシュのヒット率 [0.0, 1.0]。参照が 1 回も無い場合は 0.0
+		[[nodiscard]]
+		constexpr double hitRate() const noexcept
+		{
+			const uint64 total = (hitCount + missCount);
+			return (total ? (static_cast<double>(hitCount) / total) : 0.0);
+		}
+	};
+}
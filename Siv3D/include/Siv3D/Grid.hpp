@@ -353,6 +353,23 @@ namespace s3d
 		[[nodiscard]]
 		bool none(Fty f = Identity) const;
 
+	# ifndef SIV3D_NO_CONCURRENT_API
+
+		template <class Fty, std::enable_if_t<std::is_invocable_r_v<bool, Fty, Type>>* = nullptr>
+		[[nodiscard]]
+		size_t parallel_count_if(Fty f) const;
+
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Type&>>* = nullptr>
+		void parallel_each(Fty f);
+
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Type>>* = nullptr>
+		void parallel_each(Fty f) const;
+
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Type>>* = nullptr>
+		auto parallel_map(Fty f) const;
+
+	# endif
+
 		template <class Fty, class R = std::decay_t<std::invoke_result_t<Fty, Type, Type>>>
 		auto reduce(Fty f, R init) const;
 
@@ -13,6 +13,7 @@
 # include "Common.hpp"
 # include "PointVector.hpp"
 # include "Emission2D.hpp"
+# include "PRNG.hpp"
 
 namespace s3d
 {
@@ -22,6 +23,29 @@ namespace s3d
 
 		virtual Emission2D emit(const Vec2& emitterPosition, double startSpeed) = 0;
 
+		/// @brief 指定した乱数エンジンを使って、count 個の放出をまとめて生成します。
+		/// @param emissions 結果の格納先
+		/// @param count 生成する個数
+		/// @param emitterPosition エミッターの位置
+		/// @param startSpeed 初速
+		/// @param rng 乱数エンジン
+		/// @remark 既定の実装は emit() を count 回呼び出すため、rng を使いません。
+		virtual void emitN(Emission2D* emissions, size_t count, const Vec2& emitterPosition, double startSpeed, [[maybe_unused]] SmallRNG& rng)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				emissions[i] = emit(emitterPosition, startSpeed);
+			}
+		}
+
+		/// @brief emitN() を複数のスレッドから同時に呼び出せるかを返します。
+		/// @return 同時に呼び出せる場合 true, それ以外の場合は false
+		[[nodiscard]]
+		virtual bool supportsParallelEmission() const noexcept
+		{
+			return false;
+		}
+
 		virtual void drawDebug(const Vec2& emitterPosition) const = 0;
 	};
 }
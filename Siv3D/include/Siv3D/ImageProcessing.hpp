@@ -28,9 +28,18 @@ namespace s3d
 
 		/// @brief 画像からミップマップ画像を作成します。
 		/// @param src 画像
+		/// @param sRGB 画像の色を sRGB として扱い、線形色空間で平均する場合 true
+		/// @remark 大きな画像は、スレッドプールで行ごとに並列に処理されます。
 		/// @return ミップマップ画像
 		[[nodiscard]] 
-		Array<Image> GenerateMips(const Image& src);
+		Array<Image> GenerateMips(const Image& src, bool sRGB = false);
+
+		/// @brief 複数の画像からミップマップ画像をスレッドプールで並列に作成します。
+		/// @param images 画像の配列
+		/// @param sRGB 画像の色を sRGB として扱い、線形色空間で平均する場合 true
+		/// @return 各画像のミップマップ画像
+		[[nodiscard]]
+		Array<Array<Image>> GenerateMips(const Array<Image>& images, bool sRGB = false);
 
 		void Sobel(const Image& src, Image& dst, int32 dx = 1, int32 dy = 1, int32 apertureSize = 3);
 
@@ -14,6 +14,7 @@
 # include "Array.hpp"
 # include "YesNo.hpp"
 # include "PredefinedYesNo.hpp"
+# include "Threading.hpp"
 # include <ThirdParty/nanoflann/nanoflann.hpp>
 
 namespace s3d
@@ -95,6 +96,34 @@ namespace s3d
 
 		void radiusSearch(Array<size_t>& results, const point_type& point, element_type radius, const SortByDistance sortByDistance = SortByDistance::No) const;
 
+		/// @brief 複数の点それぞれについて、近い順に k 個の点を並列に探索します。
+		/// @param k 探索する点の数
+		/// @param points 探索の中心となる点
+		/// @return points[i] に対する探索結果を i 番目に格納した配列
+		[[nodiscard]]
+		Array<Array<size_t>> knnSearchBatch(size_t k, const Array<point_type>& points) const;
+
+		/// @brief 複数の点それぞれについて、近い順に k 個の点を並列に探索します。
+		/// @param results 探索結果の格納先。既存の要素のメモリは再利用されます。
+		/// @param k 探索する点の数
+		/// @param points 探索の中心となる点
+		void knnSearchBatch(Array<Array<size_t>>& results, size_t k, const Array<point_type>& points) const;
+
+		/// @brief 複数の点それぞれについて、半径 radius 以内にある点を並列に探索します。
+		/// @param points 探索の中心となる点
+		/// @param radius 探索する半径
+		/// @param sortByDistance 結果を距離の近い順に並べるか
+		/// @return points[i] に対する探索結果を i 番目に格納した配列
+		[[nodiscard]]
+		Array<Array<size_t>> radiusSearchBatch(const Array<point_type>& points, element_type radius, SortByDistance sortByDistance = SortByDistance::No) const;
+
+		/// @brief 複数の点それぞれについて、半径 radius 以内にある点を並列に探索します。
+		/// @param results 探索結果の格納先。既存の要素のメモリは再利用されます。
+		/// @param points 探索の中心となる点
+		/// @param radius 探索する半径
+		/// @param sortByDistance 結果を距離の近い順に並べるか
+		void radiusSearchBatch(Array<Array<size_t>>& results, const Array<point_type>& points, element_type radius, SortByDistance sortByDistance = SortByDistance::No) const;
+
 	private:
 
 		adapter_type m_adapter;
@@ -0,0 +1,158 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+# include "Array.hpp"
+# include "PointVector.hpp"
+# include "Scene.hpp"
+# include "NavMesh.hpp"
+
+namespace s3d
+{
+	/// @brief 群衆シミュレーションのエージェントの ID
+	using NavCrowdAgentID = uint32;
+
+	/// @brief 群衆シミュレーションのエージェントのパラメータ
+	struct NavCrowdAgentParameters
+	{
+		/// @brief エージェントの半径
+		double radius = 0.5;
+
+		/// @brief エージェントの高さ
+		/// @remark 高さの範囲が重ならないエージェントどうしは、衝突を回避しません。
+		double height = 2.0;
+
+		/// @brief 最大の速さ
+		double maxSpeed = 3.5;
+
+		/// @brief 最大の加速度
+		double maxAcceleration = 8.0;
+	};
+
+	/// @brief ナビメッシュ上の群衆シミュレーション
+	/// @remark 各エージェントの経路探索と経路の最適化、ほかのエージェントとの衝突回避を、`update()` でまとめて計算します。
+	/// @remark エージェントの状態は、エージェントの番号（0 から `num_agents() - 1`）ごとに配列で保持されます。
+	/// @remark エージェントを削除すると、最後のエージェントがその番号に移動します。
+	class NavCrowd
+	{
+	public:
+
+		/// @brief デフォルトコンストラクタ
+		SIV3D_NODISCARD_CXX20
+		NavCrowd();
+
+		/// @brief 群衆シミュレーションを作成します。
+		/// @param navMesh エージェントが移動するナビメッシュ
+		/// @param areaCosts エリアのコスト
+		/// @remark ナビメッシュのタイルが差し替えられると、移動中のエージェントの経路は再計算されます。
+		SIV3D_NODISCARD_CXX20
+		explicit NavCrowd(const NavMesh& navMesh, const Array<std::pair<int32, double>>& areaCosts = {});
+
+		/// @brief デストラクタ
+		~NavCrowd();
+
+		/// @brief 2D のナビメッシュにエージェントを追加します。
+		/// @param pos エージェントの位置
+		/// @param parameters エージェントのパラメータ
+		/// @return エージェントの ID。ナビメッシュ上の位置が見つからない場合は 0
+		NavCrowdAgentID addAgent(const Vec2& pos, const NavCrowdAgentParameters& parameters = {});
+
+		/// @brief 3D のナビメッシュにエージェントを追加します。
+		/// @param pos エージェントの位置
+		/// @param parameters エージェントのパラメータ
+		/// @return エージェントの ID。ナビメッシュ上の位置が見つからない場合は 0
+		NavCrowdAgentID addAgent(const Vec3& pos, const NavCrowdAgentParameters& parameters = {});
+
+		/// @brief エージェントを削除します。
+		/// @param id エージェントの ID
+		/// @return エージェントを削除した場合 true, 存在しない ID の場合は false
+		bool removeAgent(NavCrowdAgentID id);
+
+		/// @brief すべてのエージェントを削除します。
+		void clear();
+
+		/// @brief エージェントの目的地を設定します。
+		/// @param id エージェントの ID
+		/// @param target 2D のナビメッシュ上の目的地
+		/// @remark 経路は次の `update()` で、ほかのエージェントの経路とまとめて計算されます。
+		/// @return 目的地を設定した場合 true, 存在しない ID の場合は false
+		bool setTarget(NavCrowdAgentID id, const Vec2& target);
+
+		/// @brief エージェントの目的地を設定します。
+		/// @param id エージェントの ID
+		/// @param target 3D のナビメッシュ上の目的地
+		/// @remark 経路は次の `update()` で、ほかのエージェントの経路とまとめて計算されます。
+		/// @return 目的地を設定した場合 true, 存在しない ID の場合は false
+		bool setTarget(NavCrowdAgentID id, const Vec3& target);
+
+		/// @brief エージェントを目的地に向かわせるのをやめます。
+		/// @param id エージェントの ID
+		/// @return 存在しない ID の場合は false, それ以外の場合は true
+		bool resetTarget(NavCrowdAgentID id);
+
+		/// @brief すべてのエージェントを移動させます。
+		/// @param deltaTime 前回の更新からの経過時間（秒）
+		void update(double deltaTime = Scene::DeltaTime());
+
+		/// @brief エージェントの数を返します。
+		/// @return エージェントの数
+		[[nodiscard]]
+		size_t num_agents() const noexcept;
+
+		/// @brief エージェントが存在するかを返します。
+		/// @param id エージェントの ID
+		/// @return エージェントが存在する場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool hasAgent(NavCrowdAgentID id) const;
+
+		/// @brief エージェントの番号を返します。
+		/// @param id エージェントの ID
+		/// @return エージェントの番号。存在しない ID の場合は `num_agents()`
+		[[nodiscard]]
+		size_t getIndex(NavCrowdAgentID id) const;
+
+		/// @brief エージェントが目的地に向かって移動中であるかを返します。
+		/// @param id エージェントの ID
+		/// @remark 目的地に届かない場合は、届く範囲で最も近い点に着くと false になります。ナビメッシュのタイルが更新されると、再び目的地に向かいます。
+		/// @return 移動中である場合 true, 目的地に到着したか目的地が無い場合は false
+		[[nodiscard]]
+		bool isMoving(NavCrowdAgentID id) const;
+
+		/// @brief エージェントの ID の配列を返します。
+		/// @return エージェントの番号ごとの ID
+		[[nodiscard]]
+		const Array<NavCrowdAgentID>& agentIDs() const noexcept;
+
+		/// @brief エージェントの位置の配列を返します。
+		/// @remark 2D のナビメッシュでは、(x, z) が平面上の座標です。
+		/// @return エージェントの番号ごとの位置
+		[[nodiscard]]
+		const Array<Float3>& positions() const noexcept;
+
+		/// @brief エージェントの速度の配列を返します。
+		/// @remark 2D のナビメッシュでは、(x, z) が平面上の速度です。
+		/// @return エージェントの番号ごとの速度
+		[[nodiscard]]
+		const Array<Float3>& velocities() const noexcept;
+
+		/// @brief エージェントの半径の配列を返します。
+		/// @return エージェントの番号ごとの半径
+		[[nodiscard]]
+		const Array<float>& radii() const noexcept;
+
+	private:
+
+		class NavCrowdDetail;
+
+		std::shared_ptr<NavCrowdDetail> pImpl;
+	};
+}
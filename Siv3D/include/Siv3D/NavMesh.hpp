@@ -14,10 +14,36 @@
 # include "NavMeshConfig.hpp"
 # include "TriangleIndex.hpp"
 # include "Polygon.hpp"
+# include "Cylinder.hpp"
+# include "Box.hpp"
 
 namespace s3d
 {
+	/// @brief ナビメッシュの一時的な障害物の ID
+	using NavMeshObstacleID = uint64;
+
+	/// @brief 複数フレームに分けて計算する経路探索の ID
+	using NavMeshQueryID = uint64;
+
+	/// @brief 複数フレームに分けて計算する経路探索の状態
+	enum class NavMeshQueryState : uint8
+	{
+		/// @brief 存在しない経路探索
+		Invalid,
+
+		/// @brief 計算中
+		InProgress,
+
+		/// @brief 経路が見つかった
+		Succeeded,
+
+		/// @brief 経路が見つからなかった
+		Failed,
+	};
+
 	/// @brief ナビメッシュ
+	/// @remark `build()` 以外のメンバ関数は、複数のスレッドから同時に呼び出せます。
+	/// @remark `build()` を呼ぶと、`beginQuery()` で要求された経路探索はすべて取り消されます。
 	class NavMesh
 	{
 	public:
@@ -87,9 +113,128 @@ namespace s3d
 		/// @return ナビメッシュ上の経路
 		[[nodiscard]]
 		Array<Vec3> query(const Vec3& start, const Vec3& end, const Array<std::pair<int32, double>>& areaCosts = {}) const;
+
+		/// @brief 複数の経路を並列に計算します。
+		/// @param startEnds 出発地点と目的地の座標の組
+		/// @param areaCosts エリアのコスト
+		/// @return startEnds[i] に対する経路を i 番目に格納した配列
+		[[nodiscard]]
+		Array<Array<Vec2>> queryBatch(const Array<std::pair<Vec2, Vec2>>& startEnds, const Array<std::pair<int32, double>>& areaCosts = {}) const;
+
+		/// @brief 複数の経路を並列に計算します。
+		/// @param startEnds 出発地点と目的地の座標の組
+		/// @param areaCosts エリアのコスト
+		/// @return startEnds[i] に対する経路を i 番目に格納した配列
+		[[nodiscard]]
+		Array<Array<Vec3>> queryBatch(const Array<std::pair<Vec3, Vec3>>& startEnds, const Array<std::pair<int32, double>>& areaCosts = {}) const;
+
+		/// @brief 複数フレームに分けて計算する経路探索を要求します。
+		/// @param start 出発地点の座標
+		/// @param end 目的地の座標
+		/// @param areaCosts エリアのコスト
+		/// @remark 経路探索は `updateQueries()` で、要求された順に進みます。
+		/// @return 経路探索の ID
+		NavMeshQueryID beginQuery(const Vec2& start, const Vec2& end, const Array<std::pair<int32, double>>& areaCosts = {});
+
+		/// @brief 複数フレームに分けて計算する経路探索を要求します。
+		/// @param start 出発地点の座標
+		/// @param end 目的地の座標
+		/// @param areaCosts エリアのコスト
+		/// @remark 経路探索は `updateQueries()` で、要求された順に進みます。
+		/// @return 経路探索の ID
+		NavMeshQueryID beginQuery(const Vec3& start, const Vec3& end, const Array<std::pair<int32, double>>& areaCosts = {});
+
+		/// @brief 要求された経路探索を進めます。
+		/// @param maxIterations この呼び出しで探索するノードの最大数
+		/// @remark 毎フレーム呼び出すことで、経路探索の負荷を複数のフレームに分散できます。
+		void updateQueries(int32 maxIterations);
+
+		/// @brief 経路探索の状態を返します。
+		/// @param id 経路探索の ID
+		/// @return 経路探索の状態
+		[[nodiscard]]
+		NavMeshQueryState getQueryState(NavMeshQueryID id) const;
+
+		/// @brief 完了した経路探索の結果を取り出します。
+		/// @param id 経路探索の ID
+		/// @param path 経路の格納先。経路が見つからなかった場合は空になります。
+		/// @remark 結果を取り出した経路探索は削除されます。
+		/// @return 経路探索が完了していた場合 true, それ以外の場合は false
+		bool retrieveQueryResult(NavMeshQueryID id, Array<Vec2>& path);
+
+		/// @brief 完了した経路探索の結果を取り出します。
+		/// @param id 経路探索の ID
+		/// @param path 経路の格納先。経路が見つからなかった場合は空になります。
+		/// @remark 結果を取り出した経路探索は削除されます。
+		/// @return 経路探索が完了していた場合 true, それ以外の場合は false
+		bool retrieveQueryResult(NavMeshQueryID id, Array<Vec3>& path);
+
+		/// @brief 経路探索を取り消します。
+		/// @param id 経路探索の ID
+		void cancelQuery(NavMeshQueryID id);
+
+		/// @brief 2D のナビメッシュに円形の一時的な障害物を追加します。
+		/// @param circle 障害物の形状
+		/// @remark 障害物は、影響するタイルが `update()` または `rebuildTiles()` で再構築されたときに反映されます。
+		/// @return 障害物の ID。ナビメッシュが構築されていない場合は 0
+		NavMeshObstacleID addObstacle(const Circle& circle);
+
+		/// @brief 2D のナビメッシュに長方形の一時的な障害物を追加します。
+		/// @param rect 障害物の形状
+		/// @remark 障害物は、影響するタイルが `update()` または `rebuildTiles()` で再構築されたときに反映されます。
+		/// @return 障害物の ID。ナビメッシュが構築されていない場合は 0
+		NavMeshObstacleID addObstacle(const RectF& rect);
+
+		/// @brief 3D のナビメッシュに円柱の一時的な障害物を追加します。
+		/// @param cylinder 障害物の形状
+		/// @remark 円柱の向きは無視され、常に Y 軸に平行な円柱として扱われます。
+		/// @remark 障害物は、影響するタイルが `update()` または `rebuildTiles()` で再構築されたときに反映されます。
+		/// @return 障害物の ID。ナビメッシュが構築されていない場合は 0
+		NavMeshObstacleID addObstacle(const Cylinder& cylinder);
+
+		/// @brief 3D のナビメッシュに直方体の一時的な障害物を追加します。
+		/// @param box 障害物の形状
+		/// @remark 障害物は、影響するタイルが `update()` または `rebuildTiles()` で再構築されたときに反映されます。
+		/// @return 障害物の ID。ナビメッシュが構築されていない場合は 0
+		NavMeshObstacleID addObstacle(const Box& box);
+
+		/// @brief 一時的な障害物を削除します。
+		/// @param id 障害物の ID
+		/// @return 障害物を削除した場合 true, 存在しない ID の場合は false
+		bool removeObstacle(NavMeshObstacleID id);
+
+		/// @brief すべての一時的な障害物を削除します。
+		void clearObstacles();
+
+		/// @brief 一時的な障害物の個数を返します。
+		/// @return 一時的な障害物の個数
+		[[nodiscard]]
+		size_t num_obstacles() const;
+
+		/// @brief 障害物の変更で再構築が必要になったタイルを、バックグラウンドで再構築します。
+		/// @remark 毎フレーム呼び出してください。再構築が完了したタイルは、次以降の呼び出しでナビメッシュに反映されます。
+		/// @remark タイルの再構築中も経路探索は待たされず、タイルを差し替える短い間だけ待たされます。
+		/// @return ナビメッシュに反映されたタイルがある場合 true, それ以外の場合は false
+		bool update();
+
+		/// @brief 再構築が必要なタイルを、すぐに再構築してナビメッシュに反映します。
+		/// @remark バックグラウンドで再構築中のタイルがある場合は、その完了も待ちます。
+		void rebuildTiles();
+
+		/// @brief 再構築が必要なタイル、または再構築中のタイルがあるかを返します。
+		/// @return 再構築が必要なタイル、または再構築中のタイルがある場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isUpdating() const;
+
+		/// @brief ナビメッシュの X 方向と Z 方向（2D の場合は Y 方向）のタイルの数を返します。
+		/// @return タイルの数。ナビメッシュが構築されていない場合は (0, 0)
+		[[nodiscard]]
+		Size getTileCount() const;
 	
 	private:
 
+		friend class NavCrowd;
+
 		class NavMeshDetail;
 
 		std::shared_ptr<NavMeshDetail> pImpl;
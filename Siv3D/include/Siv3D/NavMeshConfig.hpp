@@ -31,5 +31,10 @@ namespace s3d
 		/// @brief エージェントの半径
 		/// @remark これより狭い経路を通過できません
 		double agentRadius = 0.25;
+
+		/// @brief タイル 1 辺のセル数
+		/// @remark 0 より大きい場合、ナビメッシュをタイルに分割して構築し、障害物の変更時には影響するタイルだけを再構築します。
+		/// @remark 0 の場合、ナビメッシュ全体を 1 枚のタイルとして構築します。
+		int32 tileSize = 0;
 	};
 }
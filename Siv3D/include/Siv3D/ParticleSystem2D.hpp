@@ -12,6 +12,8 @@
 # pragma once
 # include "Common.hpp"
 # include "PointVector.hpp"
+# include "Array.hpp"
+# include "Particle2D.hpp"
 # include "IEmitter2D.hpp"
 # include "ParticleSystem2DParameters.hpp"
 # include "Scene.hpp"
@@ -53,9 +55,19 @@ namespace s3d
 
 		void setTexture(const Texture& texture) noexcept;
 
+		/// @brief パーティクルの生成に使う乱数のシード値を設定します。
+		/// @param seed シード値
+		/// @remark 同じシード値、同じパラメータで同じ時間だけ更新すると、同じパーティクルが生成されます。
+		void setSeed(uint64 seed) noexcept;
+
 		[[nodiscard]]
 		size_t num_particles() const noexcept;
 
+		/// @brief 現在のパーティクルの一覧を返します。
+		/// @return パーティクルの一覧。古いものから順に並びます
+		[[nodiscard]]
+		Array<Particle2D> getParticles() const;
+
 		void prewarm();
 
 		void update(double deltaTime = Scene::DeltaTime());
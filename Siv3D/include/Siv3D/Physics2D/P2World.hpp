@@ -19,6 +19,7 @@
 # include "P2BodyType.hpp"
 # include "P2Material.hpp"
 # include "P2Filter.hpp"
+# include "P2WorldProfile.hpp"
 # include "P2Body.hpp"
 # include "P2PivotJoint.hpp"
 # include "P2DistanceJoint.hpp"
@@ -49,6 +50,41 @@ namespace s3d
 		/// @param positionIterations 物体の衝突時の位置の補正の回数
 		void update(double timeStep = Scene::DeltaTime(), int32 velocityIterations = 6, int32 positionIterations = 2) const;
 
+		/// @brief 固定のタイムステップで 2D 物理演算のワールドの状態を更新します。
+		/// @param deltaTime 前回の更新からの経過時間（秒）
+		/// @param fixedTimeStep 1 ステップのタイムステップ（秒）
+		/// @param maxSteps 1 回の更新で実行する最大のステップ数
+		/// @param velocityIterations 物体の衝突時の速度の補正の回数
+		/// @param positionIterations 物体の衝突時の位置の補正の回数
+		/// @remark 経過時間を蓄積し、`fixedTimeStep` 秒ごとに 1 ステップ進めます。ステップに満たない残りの時間は次回に持ち越されます。
+		/// @remark `maxSteps` で処理が追いつかない場合、残りの時間は切り捨てられます。
+		/// @remark `deltaTime` が負の場合は 0 として扱います。
+		/// @remark 描画時には `getInterpolationAlpha()` と `P2Body::getInterpolatedPos()` で、直前のステップとの間を補間できます。
+		/// @throw Error fixedTimeStep が 0 以下の場合
+		/// @return 実行したステップの数
+		size_t updateFixed(double deltaTime = Scene::DeltaTime(), double fixedTimeStep = (1.0 / 120.0), size_t maxSteps = 8, int32 velocityIterations = 6, int32 positionIterations = 2) const;
+
+		/// @brief `updateFixed()` で持ち越された時間の、タイムステップに対する割合を返します。
+		/// @remark 直前のステップの状態と現在の状態を補間する係数として使います。
+		/// @return 持ち越された時間の割合 [0, 1)
+		[[nodiscard]]
+		double getInterpolationAlpha() const noexcept;
+
+		/// @brief 直前の更新にかかった時間を返します。
+		/// @return 直前の更新にかかった時間
+		[[nodiscard]]
+		const P2WorldProfile& getProfile() const noexcept;
+
+		/// @brief 互いに独立した物体のまとまり（島）を、複数のスレッドで並列に解くことを許可・不許可を設定します（デフォルトでは許可）。
+		/// @remark 並列に解いた場合も結果は変わりません。物体の数が少ない場合は常に 1 つのスレッドで解きます。
+		/// @param enabled 許可する場合 true, 許可しない場合 false
+		void setParallelIslandsEnabled(bool enabled);
+
+		/// @brief 島を複数のスレッドで並列に解くことを許可しているかの現在の設定を返します。
+		/// @return 許可している場合 true, 許可していない場合 false
+		[[nodiscard]]
+		bool getParallelIslandsEnabled() const;
+
 		/// @brief ワールド内の物体がスリープ状態になることを許可・不許可を設定します（デフォルトでは許可）。
 		/// @param enabled 許可する場合 true, 許可しない場合 false
 		void setSleepEnabled(bool enabled);
@@ -0,0 +1,39 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "../Common.hpp"
+
+namespace s3d
+{
+	/// @brief 2D 物理演算のワールドの更新にかかった時間
+	/// @remark 1 回の更新で複数のステップを実行した場合は、その合計です。
+	struct P2WorldProfile
+	{
+		/// @brief 実行したステップの数
+		int32 stepCount = 0;
+
+		/// @brief ステップ全体にかかった時間（ミリ秒）
+		double step = 0.0;
+
+		/// @brief 接触の更新（ナローフェーズ）にかかった時間（ミリ秒）
+		double collide = 0.0;
+
+		/// @brief 島の構築と拘束の求解にかかった時間（ミリ秒）
+		double solve = 0.0;
+
+		/// @brief ブロードフェーズにかかった時間（ミリ秒）
+		double broadphase = 0.0;
+
+		/// @brief 連続衝突判定（TOI）にかかった時間（ミリ秒）
+		double solveTOI = 0.0;
+	};
+}
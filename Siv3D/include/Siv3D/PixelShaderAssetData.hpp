@@ -64,9 +64,5 @@ namespace s3d
 		static bool DefaultLoad(PixelShaderAssetData& asset, const String& hint);
 
 		static void DefaultRelease(PixelShaderAssetData& asset);
-
-	private:
-
-		AsyncTask<void> m_task;
 	};
 }
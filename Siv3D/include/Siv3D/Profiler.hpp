@@ -11,7 +11,9 @@
 
 # pragma once
 # include "Common.hpp"
+# include "StringView.hpp"
 # include "ProfilerStat.hpp"
+# include "ProfilerZone.hpp"
 
 namespace s3d
 {
@@ -29,5 +31,24 @@ namespace s3d
 
 		[[nodiscard]]
 		const ProfilerStat& GetStat();
+
+		/// @brief 区間計測の記録を開始します。 | Starts recording profiler zones.
+		/// @remark それまでの記録は破棄されます。
+		/// @remark BeginTrace(), EndTrace(), SaveTrace() はメインスレッドから呼んでください。
+		void BeginTrace();
+
+		/// @brief 区間計測の記録を終了します。 | Stops recording profiler zones.
+		void EndTrace();
+
+		/// @brief 区間計測を記録中であるかを返します。 | Returns whether profiler zones are being recorded.
+		/// @return 記録中である場合 true, それ以外の場合は false | True if recording, false otherwise
+		[[nodiscard]]
+		bool IsTracing() noexcept;
+
+		/// @brief 記録した区間計測を Chrome のトレースイベント形式の JSON で保存します。 | Saves the recorded zones as Chrome trace-event JSON.
+		/// @param path 保存するファイルのパス | File path
+		/// @return 保存に成功した場合 true, それ以外の場合は false | True if succeeded, false otherwise
+		/// @remark chrome://tracing や Perfetto UI で開くことができます。
+		bool SaveTrace(FilePathView path);
 	}
 }
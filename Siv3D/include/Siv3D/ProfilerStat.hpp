@@ -20,8 +20,18 @@ namespace s3d
 
 		uint32 triangleCount = 0;
 
+		uint32 instanceCount = 0;
+
+		uint32 savedDrawCalls = 0;
+
 		uint32 textureCount = 0;
 
+		/// @brief 別スレッドから要求され、作成を待っているテクスチャの数
+		uint32 textureUploadQueueDepth = 0;
+
+		/// @brief 直近のフレームで作成されたテクスチャの、要求から作成までの最大時間（マイクロ秒）
+		uint32 textureUploadLatencyMicrosec = 0;
+
 		uint32 fontCount = 0;
 
 		uint32 audioCount = 0;
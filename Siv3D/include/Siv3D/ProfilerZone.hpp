@@ -0,0 +1,48 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+
+namespace s3d
+{
+	/// @brief スコープの実行時間を区間計測として記録するクラス | Records the lifetime of a scope as a profiler zone
+	/// @remark Profiler::BeginTrace() から Profiler::EndTrace() までの間だけ記録します。
+	/// @remark 記録はスレッドごとのバッファに書き込まれ、ロックを取りません。
+	class ProfilerZone
+	{
+	public:
+
+		/// @brief 区間計測を開始します。 | Begins a profiler zone.
+		/// @param name 区間の名前。文字列リテラルなど、プログラムの終了まで有効な文字列である必要があります。 | Name of the zone. Must outlive the program, such as a string literal
+		SIV3D_NODISCARD_CXX20
+		explicit ProfilerZone(const char32* name) noexcept;
+
+		/// @brief 区間計測を終了します。 | Ends the profiler zone.
+		~ProfilerZone();
+
+		ProfilerZone(const ProfilerZone&) = delete;
+
+		ProfilerZone& operator =(const ProfilerZone&) = delete;
+
+	private:
+
+		const char32* m_name = nullptr;
+
+		uint64 m_beginNanosec = 0;
+	};
+}
+
+# define SIV3D_PROFILE_ZONE_CONCAT_IMPL(a, b) a##b
+# define SIV3D_PROFILE_ZONE_CONCAT(a, b) SIV3D_PROFILE_ZONE_CONCAT_IMPL(a, b)
+
+/// @brief 現在のスコープを区間計測として記録します。 | Records the current scope as a profiler zone.
+# define SIV3D_PROFILE_ZONE(name) const s3d::ProfilerZone SIV3D_PROFILE_ZONE_CONCAT(siv3dProfilerZone, __LINE__){ name }
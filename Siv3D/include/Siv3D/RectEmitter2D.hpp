@@ -29,6 +29,11 @@ namespace s3d
 
 		Emission2D emit(const Vec2& emitterPosition, double startSpeed) override;
 
+		void emitN(Emission2D* emissions, size_t count, const Vec2& emitterPosition, double startSpeed, SmallRNG& rng) override;
+
+		[[nodiscard]]
+		bool supportsParallelEmission() const noexcept override;
+
 		void drawDebug(const Vec2& emitterPosition) const override;
 	};
 }
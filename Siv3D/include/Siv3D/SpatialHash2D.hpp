@@ -0,0 +1,219 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+# include "Array.hpp"
+# include "HashTable.hpp"
+# include "2DShapes.hpp"
+# include "Utility.hpp"
+# include "Threading.hpp"
+
+namespace s3d
+{
+	/// @brief 2D 図形の広域衝突判定のための空間ハッシュ | Spatial hash for the 2D collision broadphase
+	/// @tparam Type 格納する値の型。Circle や RectF, Polygon などの図形の場合は、バウンディングボックスを省略して追加できます。
+	/// @remark 空間を一辺 cellSize の正方形のセルに分割し、各オブジェクトをそのバウンディングボックスと重なるセルに登録します。
+	/// @remark cellSize は、オブジェクトの典型的な大きさの 1 ～ 2 倍程度にすると効率的です。
+	/// @remark 多くのセルにまたがる大きなオブジェクトは、セルに登録せずに別に管理します。
+	template <class Type>
+	class SpatialHash2D
+	{
+	public:
+
+		using value_type	= Type;
+
+		/// @brief オブジェクトの ID。remove() した ID は、後で追加されるオブジェクトに再利用されます。
+		using IDType		= uint32;
+
+		/// @brief これより多くのセルにまたがるオブジェクトは、セルに登録せずに別に管理します。
+		static constexpr size_t MaxCellsPerObject = 64;
+
+		SIV3D_NODISCARD_CXX20
+		explicit SpatialHash2D(double cellSize = 64.0);
+
+		/// @brief オブジェクトを追加します。
+		/// @param value 値
+		/// @param boundingRect オブジェクトのバウンディングボックス
+		/// @return オブジェクトの ID
+		IDType insert(const Type& value, const RectF& boundingRect);
+
+		/// @brief 図形を追加します。バウンディングボックスは図形から計算されます。
+		/// @param value 図形
+		/// @return オブジェクトの ID
+		IDType insert(const Type& value);
+
+		/// @brief 移動したオブジェクトのバウンディングボックスを更新します。
+		/// @param id オブジェクトの ID
+		/// @param boundingRect 新しいバウンディングボックス
+		/// @remark 登録されているセルが変わらない場合は、バウンディングボックスを書き換えるだけです。
+		void update(IDType id, const RectF& boundingRect);
+
+		/// @brief 移動した図形を更新します。バウンディングボックスは図形から計算されます。
+		/// @param id オブジェクトの ID
+		/// @param value 新しい図形
+		void update(IDType id, const Type& value);
+
+		/// @brief オブジェクトを取り除きます。
+		/// @param id オブジェクトの ID
+		/// @return 取り除いた場合 true, 存在しなかった場合 false
+		bool remove(IDType id);
+
+		[[nodiscard]]
+		bool contains(IDType id) const noexcept;
+
+		[[nodiscard]]
+		const Type& operator [](IDType id) const;
+
+		[[nodiscard]]
+		Type& operator [](IDType id);
+
+		[[nodiscard]]
+		const RectF& boundingRect(IDType id) const;
+
+		/// @brief 格納しているオブジェクトの数を返します。
+		[[nodiscard]]
+		size_t size() const noexcept;
+
+		[[nodiscard]]
+		bool isEmpty() const noexcept;
+
+		void clear();
+
+		void reserve(size_t n);
+
+		[[nodiscard]]
+		double cellSize() const noexcept;
+
+		/// @brief バウンディングボックスが rect と重なるオブジェクトを探索します。
+		/// @param rect 探索する範囲
+		/// @return オブジェクトの ID
+		[[nodiscard]]
+		Array<IDType> query(const RectF& rect) const;
+
+		void query(const RectF& rect, Array<IDType>& results) const;
+
+		/// @brief バウンディングボックスが circle と重なるオブジェクトを探索します。
+		/// @param circle 探索する範囲
+		/// @return オブジェクトの ID
+		[[nodiscard]]
+		Array<IDType> query(const Circle& circle) const;
+
+		void query(const Circle& circle, Array<IDType>& results) const;
+
+		/// @brief バウンディングボックスが重なるすべてのオブジェクトのペアについて関数を呼びます。
+		/// @tparam Fty 関数の型
+		/// @param f 呼ばれる関数 f(IDType, IDType)
+		/// @remark 各ペアは 1 度だけ報告されます。辺が接しているだけのペアも含みます。
+		template <class Fty>
+		void forEachOverlappingPair(Fty f) const;
+
+		/// @brief Geometry2D::Intersect() で交差していると判定されたすべてのオブジェクトのペアについて関数を呼びます。
+		/// @tparam Fty 関数の型
+		/// @param f 呼ばれる関数 f(IDType, IDType)
+		template <class Fty>
+		void forEachIntersectingPair(Fty f) const;
+
+		/// @brief バウンディングボックスが重なるすべてのオブジェクトのペアを並列に探索します。
+		/// @return オブジェクトの ID のペア
+		[[nodiscard]]
+		Array<std::pair<IDType, IDType>> getOverlappingPairs() const;
+
+		/// @brief Geometry2D::Intersect() で交差していると判定されたすべてのオブジェクトのペアを並列に探索します。
+		/// @return オブジェクトの ID のペア
+		[[nodiscard]]
+		Array<std::pair<IDType, IDType>> getIntersectingPairs() const;
+
+	private:
+
+		struct CellRange
+		{
+			int32 x0 = 0;
+
+			int32 y0 = 0;
+
+			int32 x1 = -1;
+
+			int32 y1 = -1;
+
+			[[nodiscard]]
+			size_t num_cells() const noexcept;
+
+			[[nodiscard]]
+			bool operator ==(const CellRange& other) const noexcept;
+		};
+
+		struct Entry
+		{
+			Type value;
+
+			RectF rect;
+
+			CellRange cells;
+
+			bool active = false;
+
+			bool large = false;
+		};
+
+		using CellKey = uint64;
+
+		double m_cellSize = 64.0;
+
+		double m_inverseCellSize = (1.0 / 64.0);
+
+		Array<Entry> m_entries;
+
+		Array<IDType> m_freeIDs;
+
+		HashTable<CellKey, Array<IDType>> m_cells;
+
+		/// @brief セルに登録していない大きなオブジェクト
+		Array<IDType> m_largeObjects;
+
+		size_t m_size = 0;
+
+		[[nodiscard]]
+		static CellKey MakeKey(int32 x, int32 y) noexcept;
+
+		[[nodiscard]]
+		static bool Overlaps(const RectF& a, const RectF& b) noexcept;
+
+		[[nodiscard]]
+		int32 toCell(double v) const noexcept;
+
+		[[nodiscard]]
+		CellRange toCellRange(const RectF& rect) const noexcept;
+
+		void link(IDType id);
+
+		void unlink(IDType id);
+
+		/// @brief rect と other の重なりの左上の点を含むセルが (x, y) であるかを返します。
+		/// @remark 複数のセルにまたがるオブジェクトを 1 度だけ報告するために使います。
+		[[nodiscard]]
+		bool isReportingCell(const RectF& rect, const RectF& other, int32 x, int32 y) const noexcept;
+
+		template <class Fty>
+		void forEachGridCandidate(const RectF& rect, Fty f) const;
+
+		template <class Fty>
+		void forEachPairInCell(CellKey key, const Array<IDType>& ids, Fty& f) const;
+
+		template <class Fty>
+		void forEachPairWithLargeObjects(Fty& f) const;
+
+		template <class Filter>
+		Array<std::pair<IDType, IDType>> getPairs(Filter filter) const;
+	};
+}
+
+# include "detail/SpatialHash2D.ipp"
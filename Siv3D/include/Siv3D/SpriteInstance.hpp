@@ -0,0 +1,37 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+# include "PointVector.hpp"
+# include "FloatRect.hpp"
+
+namespace s3d
+{
+	/// @brief インスタンス描画 `Texture::drawInstanced()` で使う、スプライト 1 個分のデータ | Per-instance data for `Texture::drawInstanced()`
+	struct SpriteInstance
+	{
+		/// @brief 中心座標 | Center position
+		Float2 center{ 0.0f, 0.0f };
+
+		/// @brief 幅と高さ | Width and height
+		Float2 size{ 0.0f, 0.0f };
+
+		/// @brief テクスチャ UV 座標の範囲 (left, top, right, bottom) | UV rectangle (left, top, right, bottom)
+		FloatRect uv{ 0.0f, 0.0f, 1.0f, 1.0f };
+
+		/// @brief 乗算する色 | Color multiplier
+		Float4 color{ 1.0f, 1.0f, 1.0f, 1.0f };
+
+		/// @brief 中心を軸とした時計回りの回転角度（ラジアン） | Clockwise rotation angle around the center (in radians)
+		float angle = 0.0f;
+	};
+}
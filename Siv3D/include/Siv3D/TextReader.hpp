@@ -112,6 +112,13 @@ namespace s3d
 		/// @return 読み込みに成功した場合 true, ファイルの終端や失敗の場合は false
 		bool readLine(String& line);
 
+		/// @brief テキストファイルから 1 行読み込み、TextReader が内部に持つ String への参照として返します。
+		/// @remark 行は毎回同じ内部の String に読み込まれるため、行ごとのメモリ確保が発生せず、引数の無い `readLine()` より効率的です。
+		/// @remark 返された StringView は、次にこの TextReader から読み込むか、`close()` するまで有効です。
+		/// @return 読み込みに成功した場合はその文字列の Optional, ファイルの終端や失敗の場合は none
+		[[nodiscard]]
+		Optional<StringView> readLineView();
+
 		/// @brief テキストファイルのすべての行を読み込みます。
 		/// @param lines 読み込んだ文字列の格納先
 		/// @return 読み込みに成功した場合 true, ファイルの終端や失敗の場合は false
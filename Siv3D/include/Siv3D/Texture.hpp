@@ -16,6 +16,7 @@
 # include "TextureFormat.hpp"
 # include "AssetHandle.hpp"
 # include "2DShapesFwd.hpp"
+# include "SpriteInstance.hpp"
 # include "PredefinedNamedParameter.hpp"
 # include "PredefinedYesNo.hpp"
 
@@ -168,6 +169,12 @@ namespace s3d
 
 		RectF drawAtClipped(const Vec2& pos, const RectF& clipRect, const ColorF& diffuse = Palette::White) const;
 
+		/// @brief テクスチャを貼り付けたスプライトを、インスタンス描画でまとめて描きます。 | Draws many sprites with this texture using instanced rendering.
+		/// @param instances 各スプライトの位置・大きさ・UV・色・回転 | Per-sprite position, size, UV, color and rotation
+		/// @remark 頂点の生成をスプライトごとに行わないため、同じテクスチャのスプライトを大量に描く場合に高速です。
+		/// @remark 描画順序は、前後で行われた他の描画と同じく呼び出し順に従います。
+		void drawInstanced(const Array<SpriteInstance>& instances) const;
+
 		[[nodiscard]]
 		TextureRegion operator ()(double x, double y, double w, double h) const;
 
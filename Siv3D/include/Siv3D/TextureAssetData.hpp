@@ -70,9 +70,5 @@ namespace s3d
 		static bool DefaultLoad(TextureAssetData& asset, const String& hint);
 
 		static void DefaultRelease(TextureAssetData& asset);
-
-	private:
-
-		AsyncTask<void> m_task;
 	};
 }
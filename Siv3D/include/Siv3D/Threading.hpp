@@ -10,6 +10,11 @@
 //-----------------------------------------------
 
 # pragma once
+# include <functional>
+# include "Common.hpp"
+# ifndef SIV3D_NO_CONCURRENT_API
+#	include "AsyncTask.hpp"
+# endif
 
 namespace s3d
 {
@@ -19,5 +24,50 @@ namespace s3d
 		/// @return サポートされるスレッド数 | Number of concurrent threads supported
 		[[nodiscard]]
 		size_t GetConcurrency() noexcept;
+
+	# ifndef SIV3D_NO_CONCURRENT_API
+
+		/// @brief エンジンのスレッドプールのワーカースレッド数を返します。 | Returns the number of worker threads in the engine thread pool.
+		/// @return ワーカースレッド数 | Number of worker threads
+		[[nodiscard]]
+		size_t GetWorkerCount() noexcept;
+
+		/// @brief 現在のスレッドがスレッドプールのワーカースレッドであるかを返します。 | Returns whether the current thread is a worker thread of the engine thread pool.
+		/// @return ワーカースレッドである場合 true, それ以外の場合は false | True if the current thread is a worker thread, false otherwise
+		[[nodiscard]]
+		bool IsWorkerThread() noexcept;
+
+		/// @brief [0, count) の範囲を grainSize 個ずつのブロックに分割し、スレッドプールで並列に処理します。 | Splits [0, count) into blocks of grainSize and processes them in parallel on the engine thread pool.
+		/// @param count 処理する要素数 | Number of elements
+		/// @param f 各ブロックに対して呼ばれる関数 f(first, last) | Function called for each block as f(first, last)
+		/// @param grainSize 1 ブロックあたりの要素数。0 の場合は自動で決定 | Number of elements per block. If 0, it is chosen automatically
+		/// @remark 呼び出し元のスレッドも処理に参加し、すべてのブロックが完了してから戻ります。
+		/// @remark ワーカースレッド内からの入れ子の呼び出しにも対応します。
+		/// @remark f が例外を投げた場合、すべてのブロックの完了後に最初の例外を再送出します。
+		void ParallelFor(size_t count, const std::function<void(size_t, size_t)>& f, size_t grainSize = 0);
+
+		/// @brief 関数をスレッドプールで非同期に実行します。 | Runs a function asynchronously on the engine thread pool.
+		/// @tparam Fty 実行する関数の型
+		/// @tparam ...Args 実行する関数の引数の型
+		/// @param f 実行する関数
+		/// @param ...args 実行する関数の引数
+		/// @remark ワーカースレッド内で、別のタスクの完了を `get()` で待つことは避けてください。代わりに `ParallelFor()` を使ってください。
+		/// @return 作成された非同期処理のタスク
+		template <class Fty, class... Args, std::enable_if_t<std::is_invocable_v<Fty, Args...>>* = nullptr>
+		[[nodiscard]]
+		auto Submit(Fty&& f, Args&&... args);
+
+	# endif
 	}
+
+# ifndef SIV3D_NO_CONCURRENT_API
+
+	namespace detail
+	{
+		void PostTask_impl(std::function<void()> task);
+	}
+
+# endif
 }
+
+# include "detail/Threading.ipp"
@@ -64,9 +64,5 @@ namespace s3d
 		static bool DefaultLoad(VertexShaderAssetData& asset, const String& hint);
 
 		static void DefaultRelease(VertexShaderAssetData& asset);
-
-	private:
-
-		AsyncTask<void> m_task;
 	};
 }
@@ -1485,49 +1485,14 @@ namespace s3d
 			return 0;
 		}
 
-		const size_t numThreads = Threading::GetConcurrency();
+		std::atomic<size_t> result = 0;
 
-		if (numThreads <= 1)
-		{
-			return count_if(f);
-		}
-
-		const size_t countPerthread = Max<size_t>(1, (size() + (numThreads - 1)) / numThreads);
-
-		Array<std::future<std::ptrdiff_t>> futures;
-
-		auto it = begin();
-		size_t countLeft = size();
+		const auto first = begin();
 
-		for (size_t i = 0; i < (numThreads - 1); ++i)
+		Threading::ParallelFor(size(), [=, &f, &result](size_t beginIndex, size_t endIndex)
 		{
-			const size_t n = Min(countPerthread, countLeft);
-
-			if (n == 0)
-			{
-				break;
-			}
-
-			futures.emplace_back(std::async(std::launch::async, [=, &f]()
-			{
-				return std::count_if(it, it + n, f);
-			}));
-
-			it += n;
-			countLeft -= n;
-		}
-
-		size_t result = 0;
-		
-		if (countLeft)
-		{
-			result = std::count_if(it, it + countLeft, f);
-		}
-
-		for (auto& future : futures)
-		{
-			result += future.get();
-		}
+			result += std::count_if(first + beginIndex, first + endIndex, f);
+		});
 
 		return result;
 
@@ -1549,47 +1514,12 @@ namespace s3d
 			return;
 		}
 
-		const size_t numThreads = Threading::GetConcurrency();
+		const auto first = begin();
 
-		if (numThreads <= 1)
+		Threading::ParallelFor(size(), [=, &f](size_t beginIndex, size_t endIndex)
 		{
-			return each(f);
-		}
-
-		const size_t countPerthread = Max<size_t>(1, (size() + (numThreads - 1)) / numThreads);
-
-		Array<std::future<std::ptrdiff_t>> futures;
-
-		auto it = begin();
-		size_t countLeft = size();
-
-		for (size_t i = 0; i < (numThreads - 1); ++i)
-		{
-			const size_t n = Min(countPerthread, countLeft);
-
-			if (n == 0)
-			{
-				break;
-			}
-
-			futures.emplace_back(std::async(std::launch::async, [=, &f]()
-			{
-				std::for_each(it, it + n, f);
-			}));
-
-			it += n;
-			countLeft -= n;
-		}
-
-		if (countLeft)
-		{
-			std::for_each(it, it + countLeft, f);
-		}
-
-		for (auto& future : futures)
-		{
-			future.get();
-		}
+			std::for_each(first + beginIndex, first + endIndex, f);
+		});
 
 	# endif
 	}
@@ -1609,47 +1539,12 @@ namespace s3d
 			return;
 		}
 
-		const size_t numThreads = Threading::GetConcurrency();
+		const auto first = begin();
 
-		if (numThreads <= 1)
+		Threading::ParallelFor(size(), [=, &f](size_t beginIndex, size_t endIndex)
 		{
-			return each(f);
-		}
-
-		const size_t countPerthread = Max<size_t>(1, (size() + (numThreads - 1)) / numThreads);
-
-		Array<std::future<std::ptrdiff_t>> futures;
-
-		auto it = begin();
-		size_t countLeft = size();
-
-		for (size_t i = 0; i < (numThreads - 1); ++i)
-		{
-			const size_t n = Min(countPerthread, countLeft);
-
-			if (n == 0)
-			{
-				break;
-			}
-
-			futures.emplace_back(std::async(std::launch::async, [=, &f]()
-			{
-				std::for_each(it, it + n, f);
-			}));
-
-			it += n;
-			countLeft -= n;
-		}
-
-		if (countLeft)
-		{
-			std::for_each(it, it + countLeft, f);
-		}
-
-		for (auto& future : futures)
-		{
-			future.get();
-		}
+			std::for_each(first + beginIndex, first + endIndex, f);
+		});
 
 	# endif
 	}
@@ -1665,61 +1560,18 @@ namespace s3d
 			return Array<Ret>{};
 		}
 
-		const size_t numThreads = Threading::GetConcurrency();
-
-		if (numThreads <= 1)
-		{
-			return map(f);
-		}
-
 		Array<Ret> new_array(size());
 
-		const size_t countPerthread = Max<size_t>(1, (size() + (numThreads - 1)) / numThreads);
-
-		Array<std::future<void>> futures;
-
-		auto itDst = new_array.begin();
-		auto itSrc = begin();
-		size_t countLeft = size();
-
-		for (size_t i = 0; i < (numThreads - 1); ++i)
-		{
-			const size_t n = Min(countPerthread, countLeft);
-
-			if (n == 0)
-			{
-				break;
-			}
-
-			futures.emplace_back(std::async(std::launch::async, [=, &f]() mutable
-			{
-				const auto itSrcEnd = itSrc + n;
-
-				while (itSrc != itSrcEnd)
-				{
-					*itDst++ = f(*itSrc++);
-				}
-			}));
-
-			itDst += n;
-			itSrc += n;
-			countLeft -= n;
-		}
+		const auto itSrc = begin();
+		const auto itDst = new_array.begin();
 
-		if (countLeft)
+		Threading::ParallelFor(size(), [=, &f](size_t beginIndex, size_t endIndex)
 		{
-			const auto itSrcEnd = end();
-
-			while (itSrc != itSrcEnd)
+			for (size_t i = beginIndex; i < endIndex; ++i)
 			{
-				*itDst++ = f(*itSrc++);
+				itDst[i] = f(itSrc[i]);
 			}
-		}
-
-		for (auto& future : futures)
-		{
-			future.get();
-		}
+		});
 
 		return new_array;
 	}
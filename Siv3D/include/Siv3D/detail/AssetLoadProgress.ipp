@@ -0,0 +1,34 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+# pragma once
+
+namespace s3d
+{
+	inline constexpr size_t AssetLoadProgress::finished() const noexcept
+	{
+		return (loaded + failed);
+	}
+
+	inline constexpr double AssetLoadProgress::progress() const noexcept
+	{
+		if (total == 0)
+		{
+			return 1.0;
+		}
+
+		return (static_cast<double>(finished()) / total);
+	}
+
+	inline constexpr bool AssetLoadProgress::isFinished() const noexcept
+	{
+		return (loading == 0);
+	}
+}
@@ -0,0 +1,714 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	namespace detail
+	{
+		[[nodiscard]]
+		inline size_t KDParallelTaskCount()
+		{
+		# ifndef SIV3D_NO_CONCURRENT_API
+
+			// 部分木の大きさの偏りを吸収できるよう、スレッド数の 4 倍程度に分割する
+			return ((Threading::GetWorkerCount() + 1) * 4);
+
+		# else
+
+			return 1;
+
+		# endif
+		}
+
+		/// @brief count 個以下の点を格納できる kd-tree の番号を返します。
+		[[nodiscard]]
+		inline size_t DynamicKDTreeSlot(const size_t count) noexcept
+		{
+			size_t slot = 0;
+
+			while ((size_t{ 1 } << slot) < count)
+			{
+				++slot;
+			}
+
+			return slot;
+		}
+
+		template <class ElementType>
+		class DynamicKDKnnResultSet
+		{
+		public:
+
+			DynamicKDKnnResultSet(size_t* indices, ElementType* distanceSqs, const size_t capacity) noexcept
+				: m_indices{ indices }
+				, m_distanceSqs{ distanceSqs }
+				, m_capacity{ capacity } {}
+
+			[[nodiscard]]
+			ElementType worstDist() const noexcept
+			{
+				return ((m_count < m_capacity) ? std::numeric_limits<ElementType>::max() : m_distanceSqs[m_capacity - 1]);
+			}
+
+			void addPoint(const ElementType distanceSq, const size_t index) noexcept
+			{
+				// 距離の近い順に並ぶよう挿入する
+				size_t i = ((m_count < m_capacity) ? m_count++ : (m_capacity - 1));
+
+				for (; (0 < i) && (distanceSq < m_distanceSqs[i - 1]); --i)
+				{
+					m_indices[i] = m_indices[i - 1];
+					m_distanceSqs[i] = m_distanceSqs[i - 1];
+				}
+
+				m_indices[i] = index;
+				m_distanceSqs[i] = distanceSq;
+			}
+
+			[[nodiscard]]
+			size_t size() const noexcept
+			{
+				return m_count;
+			}
+
+		private:
+
+			size_t* m_indices;
+
+			ElementType* m_distanceSqs;
+
+			size_t m_capacity;
+
+			size_t m_count = 0;
+		};
+
+		template <class ElementType>
+		class DynamicKDRadiusResultSet
+		{
+		public:
+
+			DynamicKDRadiusResultSet(const ElementType radiusSq, Array<std::pair<ElementType, size_t>>& matches) noexcept
+				: m_radiusSq{ radiusSq }
+				, m_matches{ matches } {}
+
+			[[nodiscard]]
+			ElementType worstDist() const noexcept
+			{
+				return m_radiusSq;
+			}
+
+			void addPoint(const ElementType distanceSq, const size_t index)
+			{
+				m_matches.emplace_back(distanceSq, index);
+			}
+
+		private:
+
+			ElementType m_radiusSq;
+
+			Array<std::pair<ElementType, size_t>>& m_matches;
+		};
+
+		template <class ElementType>
+		class DynamicKDRadiusIndexResultSet
+		{
+		public:
+
+			DynamicKDRadiusIndexResultSet(const ElementType radiusSq, Array<size_t>& results) noexcept
+				: m_radiusSq{ radiusSq }
+				, m_results{ results } {}
+
+			[[nodiscard]]
+			ElementType worstDist() const noexcept
+			{
+				return m_radiusSq;
+			}
+
+			void addPoint(const ElementType, const size_t index)
+			{
+				m_results.push_back(index);
+			}
+
+		private:
+
+			ElementType m_radiusSq;
+
+			Array<size_t>& m_results;
+		};
+	}
+
+	template <class DatasetAdapter>
+	inline DynamicKDTree<DatasetAdapter>::DynamicKDTree(const dataset_type& dataset)
+		: m_dataset{ &dataset }
+	{
+		rebuildIndex();
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::rebuildIndex()
+	{
+		release();
+
+		if (not m_dataset)
+		{
+			return;
+		}
+
+		const size_t count = std::size(*m_dataset);
+
+		m_locations.assign(count, NotContained);
+
+		if (count == 0)
+		{
+			return;
+		}
+
+		Array<size_t> indices(count);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			indices[i] = i;
+		}
+
+		const size_t slot = detail::DynamicKDTreeSlot(count);
+
+		m_trees.resize(slot + 1);
+
+		buildTree(slot, std::move(indices));
+
+		m_size = count;
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::insert(const size_t index)
+	{
+		if (m_locations.size() <= index)
+		{
+			m_locations.resize((index + 1), NotContained);
+		}
+
+		if (m_locations[index] != NotContained)
+		{
+			// 古い位置の点は kd-tree に残るが、探索では無視される
+			m_locations[index] = NotContained;
+			--m_size;
+			++m_staleCount;
+		}
+
+		// 空いている最小の kd-tree に、それより小さい kd-tree の点をまとめて構築し直す
+		Array<size_t> indices{ index };
+
+		size_t slot = 0;
+
+		for (; slot < m_trees.size(); ++slot)
+		{
+			Tree& tree = m_trees[slot];
+
+			if (tree.indices.isEmpty())
+			{
+				break;
+			}
+
+			for (const size_t i : tree.indices)
+			{
+				if (m_locations[i] == static_cast<int8>(slot))
+				{
+					indices << i;
+				}
+				else
+				{
+					--m_staleCount;
+				}
+			}
+
+			tree.indices.clear();
+			tree.nodes.clear();
+		}
+
+		if (slot == m_trees.size())
+		{
+			m_trees.emplace_back();
+		}
+
+		buildTree(slot, std::move(indices));
+
+		++m_size;
+
+		compactIfNeeded();
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::remove(const size_t index)
+	{
+		if (not contains(index))
+		{
+			return;
+		}
+
+		m_locations[index] = NotContained;
+		--m_size;
+		++m_staleCount;
+
+		compactIfNeeded();
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::update(const size_t index)
+	{
+		// insert() が古い点を無効にし、必要なら詰め直す
+		insert(index);
+	}
+
+	template <class DatasetAdapter>
+	inline bool DynamicKDTree<DatasetAdapter>::contains(const size_t index) const noexcept
+	{
+		return ((index < m_locations.size()) && (m_locations[index] != NotContained));
+	}
+
+	template <class DatasetAdapter>
+	inline size_t DynamicKDTree<DatasetAdapter>::size() const noexcept
+	{
+		return m_size;
+	}
+
+	template <class DatasetAdapter>
+	inline bool DynamicKDTree<DatasetAdapter>::isEmpty() const noexcept
+	{
+		return (m_size == 0);
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::release()
+	{
+		m_trees.clear();
+		m_locations.clear();
+		m_size = 0;
+		m_staleCount = 0;
+	}
+
+	template <class DatasetAdapter>
+	inline size_t DynamicKDTree<DatasetAdapter>::usedMemory() const
+	{
+		size_t bytes = (m_trees.capacity() * sizeof(Tree)) + m_locations.capacity();
+
+		for (const auto& tree : m_trees)
+		{
+			bytes += (tree.nodes.capacity() * sizeof(Node)) + (tree.indices.capacity() * sizeof(size_t));
+		}
+
+		return bytes;
+	}
+
+	template <class DatasetAdapter>
+	inline Array<size_t> DynamicKDTree<DatasetAdapter>::knnSearch(const size_t k, const point_type& point) const
+	{
+		Array<size_t> results;
+
+		knnSearch(results, k, point);
+
+		return results;
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::knnSearch(Array<size_t>& results, const size_t k, const point_type& point) const
+	{
+		Array<element_type> distanceSqs;
+
+		knnSearch(results, distanceSqs, k, point);
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::knnSearch(Array<size_t>& results, Array<element_type>& distanceSqResults, const size_t k, const point_type& point) const
+	{
+		results.resize(k);
+		distanceSqResults.resize(k);
+
+		detail::DynamicKDKnnResultSet<element_type> resultSet{ results.data(), distanceSqResults.data(), k };
+
+		if (k != 0)
+		{
+			const element_type* pPoint = adapter_type::GetPointer(point);
+
+			for (size_t slot = 0; slot < m_trees.size(); ++slot)
+			{
+				const Tree& tree = m_trees[slot];
+
+				if (not tree.nodes.isEmpty())
+				{
+					search(tree, static_cast<int8>(slot), tree.nodes.front(), pPoint, resultSet);
+				}
+			}
+		}
+
+		results.resize(resultSet.size());
+		distanceSqResults.resize(resultSet.size());
+	}
+
+	template <class DatasetAdapter>
+	inline Array<size_t> DynamicKDTree<DatasetAdapter>::radiusSearch(const point_type& point, const element_type radius, const SortByDistance sortByDistance) const
+	{
+		Array<size_t> results;
+
+		radiusSearch(results, point, radius, sortByDistance);
+
+		return results;
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::radiusSearch(Array<size_t>& results, const point_type& point, const element_type radius, const SortByDistance sortByDistance) const
+	{
+		results.clear();
+
+		const element_type* pPoint = adapter_type::GetPointer(point);
+
+		if (sortByDistance)
+		{
+			Array<std::pair<element_type, size_t>> matches;
+
+			detail::DynamicKDRadiusResultSet<element_type> resultSet{ (radius * radius), matches };
+
+			for (size_t slot = 0; slot < m_trees.size(); ++slot)
+			{
+				const Tree& tree = m_trees[slot];
+
+				if (not tree.nodes.isEmpty())
+				{
+					search(tree, static_cast<int8>(slot), tree.nodes.front(), pPoint, resultSet);
+				}
+			}
+
+			std::sort(matches.begin(), matches.end());
+
+			results.resize(matches.size());
+
+			for (size_t i = 0; i < matches.size(); ++i)
+			{
+				results[i] = matches[i].second;
+			}
+		}
+		else
+		{
+			detail::DynamicKDRadiusIndexResultSet<element_type> resultSet{ (radius * radius), results };
+
+			for (size_t slot = 0; slot < m_trees.size(); ++slot)
+			{
+				const Tree& tree = m_trees[slot];
+
+				if (not tree.nodes.isEmpty())
+				{
+					search(tree, static_cast<int8>(slot), tree.nodes.front(), pPoint, resultSet);
+				}
+			}
+		}
+	}
+
+	template <class DatasetAdapter>
+	inline Array<Array<size_t>> DynamicKDTree<DatasetAdapter>::knnSearchBatch(const size_t k, const Array<point_type>& points) const
+	{
+		Array<Array<size_t>> results;
+
+		knnSearchBatch(results, k, points);
+
+		return results;
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::knnSearchBatch(Array<Array<size_t>>& results, const size_t k, const Array<point_type>& points) const
+	{
+		results.resize(points.size());
+
+		detail::KDParallelFor(points.size(), [&](const size_t i)
+			{
+				knnSearch(results[i], k, points[i]);
+			});
+	}
+
+	template <class DatasetAdapter>
+	inline Array<Array<size_t>> DynamicKDTree<DatasetAdapter>::radiusSearchBatch(const Array<point_type>& points, const element_type radius, const SortByDistance sortByDistance) const
+	{
+		Array<Array<size_t>> results;
+
+		radiusSearchBatch(results, points, radius, sortByDistance);
+
+		return results;
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::radiusSearchBatch(Array<Array<size_t>>& results, const Array<point_type>& points, const element_type radius, const SortByDistance sortByDistance) const
+	{
+		results.resize(points.size());
+
+		detail::KDParallelFor(points.size(), [&](const size_t i)
+			{
+				radiusSearch(results[i], points[i], radius, sortByDistance);
+			});
+	}
+
+	template <class DatasetAdapter>
+	inline typename DynamicKDTree<DatasetAdapter>::element_type DynamicKDTree<DatasetAdapter>::getElement(const size_t index, const size_t dim) const
+	{
+		return DatasetAdapter::GetElement(*m_dataset, index, dim);
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::buildTree(const size_t treeIndex, Array<size_t>&& indices)
+	{
+		Tree& tree = m_trees[treeIndex];
+		tree.indices = std::move(indices);
+		tree.nodes.clear();
+
+		for (const size_t index : tree.indices)
+		{
+			m_locations[index] = static_cast<int8>(treeIndex);
+		}
+
+		if (tree.indices.isEmpty())
+		{
+			return;
+		}
+
+		// 上位の節点を分割して、独立した部分木を十分な数だけ作る
+		struct Subtree
+		{
+			uint32 node;
+
+			size_t begin;
+
+			size_t end;
+		};
+
+		// これより小さい部分木はタスクに分けない
+		constexpr size_t MinParallelSize = 2048;
+
+		const size_t taskCount = detail::KDParallelTaskCount();
+
+		tree.nodes.emplace_back();
+
+		Array<Subtree> subtrees{ Subtree{ 0, 0, tree.indices.size() } };
+
+		while (subtrees.size() < taskCount)
+		{
+			Array<Subtree> next;
+			bool divided = false;
+
+			for (const auto& subtree : subtrees)
+			{
+				if ((subtree.end - subtree.begin) <= MinParallelSize)
+				{
+					next << subtree;
+					continue;
+				}
+
+				Node node;
+				const size_t mid = splitRange(tree.indices, subtree.begin, subtree.end, node);
+
+				node.left = static_cast<uint32>(tree.nodes.size());
+				tree.nodes.emplace_back();
+
+				node.right = static_cast<uint32>(tree.nodes.size());
+				tree.nodes.emplace_back();
+
+				tree.nodes[subtree.node] = node;
+
+				next << Subtree{ node.left, subtree.begin, mid };
+				next << Subtree{ node.right, mid, subtree.end };
+				divided = true;
+			}
+
+			subtrees = std::move(next);
+
+			if (not divided)
+			{
+				break;
+			}
+		}
+
+		// 部分木は tree.indices の重ならない範囲を並べ替えるので、並列に構築できる
+		Array<Array<Node>> subtreeNodes(subtrees.size());
+
+		detail::KDParallelFor(subtrees.size(), [&](const size_t i)
+			{
+				buildNode(subtreeNodes[i], tree.indices, subtrees[i].begin, subtrees[i].end);
+			});
+
+		// 部分木の根を予約した節点に置き、残りの節点を末尾に連結する
+		for (size_t i = 0; i < subtrees.size(); ++i)
+		{
+			const Array<Node>& nodes = subtreeNodes[i];
+			const uint32 base = static_cast<uint32>(tree.nodes.size() - 1);
+
+			for (size_t k = 0; k < nodes.size(); ++k)
+			{
+				Node node = nodes[k];
+
+				if (0 <= node.dim)
+				{
+					node.left += base;
+					node.right += base;
+				}
+
+				if (k == 0)
+				{
+					tree.nodes[subtrees[i].node] = node;
+				}
+				else
+				{
+					tree.nodes << node;
+				}
+			}
+		}
+	}
+
+	template <class DatasetAdapter>
+	inline size_t DynamicKDTree<DatasetAdapter>::splitRange(Array<size_t>& indices, const size_t begin, const size_t end, Node& node) const
+	{
+		// 広がりが最も大きい次元で、中央値で分割する
+		int32 dim = 0;
+		element_type maxSpread = -1;
+
+		for (int32 d = 0; d < Dimensions; ++d)
+		{
+			element_type minValue = getElement(indices[begin], d);
+			element_type maxValue = minValue;
+
+			for (size_t i = (begin + 1); i < end; ++i)
+			{
+				const element_type value = getElement(indices[i], d);
+				minValue = Min(minValue, value);
+				maxValue = Max(maxValue, value);
+			}
+
+			if (maxSpread < (maxValue - minValue))
+			{
+				maxSpread = (maxValue - minValue);
+				dim = d;
+			}
+		}
+
+		const size_t mid = (begin + (end - begin) / 2);
+
+		std::nth_element((indices.begin() + begin), (indices.begin() + mid), (indices.begin() + end),
+			[this, dim](const size_t a, const size_t b) { return (getElement(a, dim) < getElement(b, dim)); });
+
+		node.dim = dim;
+		node.split = getElement(indices[mid], dim);
+
+		return mid;
+	}
+
+	template <class DatasetAdapter>
+	inline uint32 DynamicKDTree<DatasetAdapter>::buildNode(Array<Node>& nodes, Array<size_t>& indices, const size_t begin, const size_t end) const
+	{
+		const uint32 nodeIndex = static_cast<uint32>(nodes.size());
+		nodes.emplace_back();
+
+		if ((end - begin) <= LeafSize)
+		{
+			nodes[nodeIndex].begin = static_cast<uint32>(begin);
+			nodes[nodeIndex].end = static_cast<uint32>(end);
+			return nodeIndex;
+		}
+
+		Node node;
+		const size_t mid = splitRange(indices, begin, end, node);
+
+		node.left = buildNode(nodes, indices, begin, mid);
+		node.right = buildNode(nodes, indices, mid, end);
+
+		nodes[nodeIndex] = node;
+
+		return nodeIndex;
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::compact()
+	{
+		Array<size_t> indices(Arg::reserve = m_size);
+
+		for (size_t slot = 0; slot < m_trees.size(); ++slot)
+		{
+			for (const size_t index : m_trees[slot].indices)
+			{
+				if (m_locations[index] == static_cast<int8>(slot))
+				{
+					indices << index;
+				}
+			}
+		}
+
+		m_trees.clear();
+		m_staleCount = 0;
+
+		const size_t slot = detail::DynamicKDTreeSlot(indices.size());
+
+		m_trees.resize(slot + 1);
+
+		buildTree(slot, std::move(indices));
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::compactIfNeeded()
+	{
+		// 探索で無視する点が、有効な点より多くなったら詰め直す
+		if (Max(m_size, LeafSize) < m_staleCount)
+		{
+			compact();
+		}
+	}
+
+	template <class DatasetAdapter>
+	template <class ResultSet>
+	inline void DynamicKDTree<DatasetAdapter>::search(const Tree& tree, const int8 treeIndex, const Node& node, const element_type* point, ResultSet& resultSet) const
+	{
+		if (node.dim < 0)
+		{
+			for (uint32 i = node.begin; i < node.end; ++i)
+			{
+				const size_t index = tree.indices[i];
+
+				// 取り除かれた点や、別の kd-tree に移った点は無視する
+				if (m_locations[index] != treeIndex)
+				{
+					continue;
+				}
+
+				element_type distanceSq = 0;
+
+				for (int32 d = 0; d < Dimensions; ++d)
+				{
+					const element_type diff = (point[d] - getElement(index, d));
+					distanceSq += (diff * diff);
+				}
+
+				if (distanceSq < resultSet.worstDist())
+				{
+					resultSet.addPoint(distanceSq, index);
+				}
+			}
+
+			return;
+		}
+
+		const element_type diff = (point[node.dim] - node.split);
+		const Node& nearNode = tree.nodes[(diff < 0) ? node.left : node.right];
+		const Node& farNode = tree.nodes[(diff < 0) ? node.right : node.left];
+
+		search(tree, treeIndex, nearNode, point, resultSet);
+
+		// 分割面までの距離が現在の最悪距離より近い場合だけ、反対側も探索する
+		if ((diff * diff) < resultSet.worstDist())
+		{
+			search(tree, treeIndex, farNode, point, resultSet);
+		}
+	}
+}
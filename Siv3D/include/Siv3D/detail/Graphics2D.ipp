@@ -44,6 +44,10 @@ namespace s3d
 			void SetRenderTarget(const Optional<RenderTexture>& rt);
 			
 			void SetConstantBuffer(ShaderStage stage, uint32 slot, const ConstantBufferBase& buffer, const float* data, uint32 num_vectors);
+
+			void BeginBatchReorder();
+
+			void EndBatchReorder();
 		}
 
 		template <class Type>
@@ -44,6 +44,33 @@ namespace s3d
 			return DatasetAdapter::GetPointer(point);
 		}
 
+		/// @brief 探索のバッチなど、要素ごとに独立した処理をスレッドプールで並列に実行します。
+		template <class Fty>
+		inline void KDParallelFor(const size_t count, Fty f)
+		{
+		# ifndef SIV3D_NO_CONCURRENT_API
+
+			// 1 回の探索は軽いので、ある程度まとめてタスクにする
+			constexpr size_t GrainSize = 64;
+
+			Threading::ParallelFor(count, [&f](const size_t first, const size_t last)
+				{
+					for (size_t i = first; i < last; ++i)
+					{
+						f(i);
+					}
+				}, GrainSize);
+
+		# else
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				f(i);
+			}
+
+		# endif
+		}
+
 		template <class _DistanceType>
 		class RadiusResultsAdapter
 		{
@@ -121,7 +148,10 @@ namespace s3d
 	template <class DatasetAdapter>
 	inline size_t KDTree<DatasetAdapter>::usedMemory() const
 	{
-		return m_index.usedMemory();
+		// nanoflann の usedMemory() は const ではないが、内部の値を読むだけ
+		auto& index = const_cast<decltype(m_index)&>(m_index);
+
+		return index.usedMemory(index);
 	}
 
 	template <class DatasetAdapter>
@@ -204,4 +234,46 @@ namespace s3d
 			m_index.radiusSearchCustomCallback(adapter_type::GetPointer(point), resultSet, searchParams);
 		}
 	}
+
+	template <class DatasetAdapter>
+	inline Array<Array<size_t>> KDTree<DatasetAdapter>::knnSearchBatch(const size_t k, const Array<point_type>& points) const
+	{
+		Array<Array<size_t>> results;
+
+		knnSearchBatch(results, k, points);
+
+		return results;
+	}
+
+	template <class DatasetAdapter>
+	inline void KDTree<DatasetAdapter>::knnSearchBatch(Array<Array<size_t>>& results, const size_t k, const Array<point_type>& points) const
+	{
+		results.resize(points.size());
+
+		detail::KDParallelFor(points.size(), [&](const size_t i)
+			{
+				knnSearch(results[i], k, points[i]);
+			});
+	}
+
+	template <class DatasetAdapter>
+	inline Array<Array<size_t>> KDTree<DatasetAdapter>::radiusSearchBatch(const Array<point_type>& points, const element_type radius, const SortByDistance sortByDistance) const
+	{
+		Array<Array<size_t>> results;
+
+		radiusSearchBatch(results, points, radius, sortByDistance);
+
+		return results;
+	}
+
+	template <class DatasetAdapter>
+	inline void KDTree<DatasetAdapter>::radiusSearchBatch(Array<Array<size_t>>& results, const Array<point_type>& points, const element_type radius, const SortByDistance sortByDistance) const
+	{
+		results.resize(points.size());
+
+		detail::KDParallelFor(points.size(), [&](const size_t i)
+			{
+				radiusSearch(results[i], points[i], radius, sortByDistance);
+			});
+	}
 }
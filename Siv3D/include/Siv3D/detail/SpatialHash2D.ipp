@@ -0,0 +1,574 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	namespace detail
+	{
+		template <class Shape>
+		[[nodiscard]]
+		inline RectF BoundingRectOf(const Shape& shape)
+		{
+			if constexpr (std::is_same_v<Shape, RectF> || std::is_same_v<Shape, Rect>)
+			{
+				return RectF{ shape };
+			}
+			else if constexpr (std::is_same_v<Shape, Vec2> || std::is_same_v<Shape, Point>)
+			{
+				return RectF{ shape, 0, 0 };
+			}
+			else
+			{
+				return RectF{ shape.boundingRect() };
+			}
+		}
+	}
+
+	template <class Type>
+	inline size_t SpatialHash2D<Type>::CellRange::num_cells() const noexcept
+	{
+		return static_cast<size_t>((static_cast<int64>(x1) - x0 + 1) * (static_cast<int64>(y1) - y0 + 1));
+	}
+
+	template <class Type>
+	inline bool SpatialHash2D<Type>::CellRange::operator ==(const CellRange& other) const noexcept
+	{
+		return (x0 == other.x0) && (y0 == other.y0) && (x1 == other.x1) && (y1 == other.y1);
+	}
+
+	template <class Type>
+	inline SpatialHash2D<Type>::SpatialHash2D(const double cellSize)
+		: m_cellSize{ cellSize }
+		, m_inverseCellSize{ 1.0 / cellSize } {}
+
+	template <class Type>
+	inline typename SpatialHash2D<Type>::IDType SpatialHash2D<Type>::insert(const Type& value, const RectF& boundingRect)
+	{
+		IDType id;
+
+		if (not m_freeIDs.isEmpty())
+		{
+			id = m_freeIDs.back();
+			m_freeIDs.pop_back();
+		}
+		else
+		{
+			id = static_cast<IDType>(m_entries.size());
+			m_entries.emplace_back();
+		}
+
+		Entry& entry = m_entries[id];
+		entry.value		= value;
+		entry.rect		= boundingRect;
+		entry.active	= true;
+
+		link(id);
+
+		++m_size;
+
+		return id;
+	}
+
+	template <class Type>
+	inline typename SpatialHash2D<Type>::IDType SpatialHash2D<Type>::insert(const Type& value)
+	{
+		return insert(value, detail::BoundingRectOf(value));
+	}
+
+	template <class Type>
+	inline void SpatialHash2D<Type>::update(const IDType id, const RectF& boundingRect)
+	{
+		if (not contains(id))
+		{
+			return;
+		}
+
+		Entry& entry = m_entries[id];
+		entry.rect = boundingRect;
+
+		// 少し動いただけでセルが変わらなければ、登録し直す必要はない
+		if ((not entry.large) && (toCellRange(boundingRect) == entry.cells))
+		{
+			return;
+		}
+
+		unlink(id);
+
+		link(id);
+	}
+
+	template <class Type>
+	inline void SpatialHash2D<Type>::update(const IDType id, const Type& value)
+	{
+		if (not contains(id))
+		{
+			return;
+		}
+
+		m_entries[id].value = value;
+
+		update(id, detail::BoundingRectOf(value));
+	}
+
+	template <class Type>
+	inline bool SpatialHash2D<Type>::remove(const IDType id)
+	{
+		if (not contains(id))
+		{
+			return false;
+		}
+
+		unlink(id);
+
+		Entry& entry = m_entries[id];
+		entry.value		= Type{};
+		entry.active	= false;
+
+		m_freeIDs << id;
+
+		--m_size;
+
+		return true;
+	}
+
+	template <class Type>
+	inline bool SpatialHash2D<Type>::contains(const IDType id) const noexcept
+	{
+		return ((id < m_entries.size()) && m_entries[id].active);
+	}
+
+	template <class Type>
+	inline const Type& SpatialHash2D<Type>::operator [](const IDType id) const
+	{
+		return m_entries[id].value;
+	}
+
+	template <class Type>
+	inline Type& SpatialHash2D<Type>::operator [](const IDType id)
+	{
+		return m_entries[id].value;
+	}
+
+	template <class Type>
+	inline const RectF& SpatialHash2D<Type>::boundingRect(const IDType id) const
+	{
+		return m_entries[id].rect;
+	}
+
+	template <class Type>
+	inline size_t SpatialHash2D<Type>::size() const noexcept
+	{
+		return m_size;
+	}
+
+	template <class Type>
+	inline bool SpatialHash2D<Type>::isEmpty() const noexcept
+	{
+		return (m_size == 0);
+	}
+
+	template <class Type>
+	inline void SpatialHash2D<Type>::clear()
+	{
+		m_entries.clear();
+		m_freeIDs.clear();
+		m_cells.clear();
+		m_largeObjects.clear();
+		m_size = 0;
+	}
+
+	template <class Type>
+	inline void SpatialHash2D<Type>::reserve(const size_t n)
+	{
+		m_entries.reserve(n);
+		m_cells.reserve(n);
+	}
+
+	template <class Type>
+	inline double SpatialHash2D<Type>::cellSize() const noexcept
+	{
+		return m_cellSize;
+	}
+
+	template <class Type>
+	inline Array<typename SpatialHash2D<Type>::IDType> SpatialHash2D<Type>::query(const RectF& rect) const
+	{
+		Array<IDType> results;
+
+		query(rect, results);
+
+		return results;
+	}
+
+	template <class Type>
+	inline void SpatialHash2D<Type>::query(const RectF& rect, Array<IDType>& results) const
+	{
+		results.clear();
+
+		forEachGridCandidate(rect, [&](const IDType id) { results << id; });
+
+		for (const IDType id : m_largeObjects)
+		{
+			if (Overlaps(m_entries[id].rect, rect))
+			{
+				results << id;
+			}
+		}
+	}
+
+	template <class Type>
+	inline Array<typename SpatialHash2D<Type>::IDType> SpatialHash2D<Type>::query(const Circle& circle) const
+	{
+		Array<IDType> results;
+
+		query(circle, results);
+
+		return results;
+	}
+
+	template <class Type>
+	inline void SpatialHash2D<Type>::query(const Circle& circle, Array<IDType>& results) const
+	{
+		query(circle.boundingRect(), results);
+
+		results.remove_if([&](const IDType id)
+			{
+				const RectF& rect = m_entries[id].rect;
+
+				// 大きさが 0 の矩形も扱えるよう、最近点までの距離で判定する
+				const Vec2 closest{ Clamp(circle.x, rect.x, (rect.x + rect.w)), Clamp(circle.y, rect.y, (rect.y + rect.h)) };
+
+				return (circle.r * circle.r) < closest.distanceFromSq(circle.center);
+			});
+	}
+
+	template <class Type>
+	template <class Fty>
+	inline void SpatialHash2D<Type>::forEachOverlappingPair(Fty f) const
+	{
+		for (const auto& [key, ids] : m_cells)
+		{
+			forEachPairInCell(key, ids, f);
+		}
+
+		forEachPairWithLargeObjects(f);
+	}
+
+	template <class Type>
+	template <class Fty>
+	inline void SpatialHash2D<Type>::forEachIntersectingPair(Fty f) const
+	{
+		forEachOverlappingPair([&](const IDType a, const IDType b)
+			{
+				if (Geometry2D::Intersect(m_entries[a].value, m_entries[b].value))
+				{
+					f(a, b);
+				}
+			});
+	}
+
+	template <class Type>
+	inline Array<std::pair<typename SpatialHash2D<Type>::IDType, typename SpatialHash2D<Type>::IDType>> SpatialHash2D<Type>::getOverlappingPairs() const
+	{
+		return getPairs([](IDType, IDType) { return true; });
+	}
+
+	template <class Type>
+	inline Array<std::pair<typename SpatialHash2D<Type>::IDType, typename SpatialHash2D<Type>::IDType>> SpatialHash2D<Type>::getIntersectingPairs() const
+	{
+		return getPairs([this](const IDType a, const IDType b)
+			{
+				return Geometry2D::Intersect(m_entries[a].value, m_entries[b].value);
+			});
+	}
+
+	template <class Type>
+	inline typename SpatialHash2D<Type>::CellKey SpatialHash2D<Type>::MakeKey(const int32 x, const int32 y) noexcept
+	{
+		return ((static_cast<uint64>(static_cast<uint32>(x)) << 32) | static_cast<uint32>(y));
+	}
+
+	template <class Type>
+	inline bool SpatialHash2D<Type>::Overlaps(const RectF& a, const RectF& b) noexcept
+	{
+		// 大きさが 0 の矩形（点や水平な線分）も扱えるよう、接している場合も重なりとみなす
+		return (a.x <= (b.x + b.w))
+			&& (b.x <= (a.x + a.w))
+			&& (a.y <= (b.y + b.h))
+			&& (b.y <= (a.y + a.h));
+	}
+
+	template <class Type>
+	inline int32 SpatialHash2D<Type>::toCell(const double v) const noexcept
+	{
+		constexpr double Limit = static_cast<double>(1 << 30);
+
+		return static_cast<int32>(Clamp(std::floor(v * m_inverseCellSize), -Limit, Limit));
+	}
+
+	template <class Type>
+	inline typename SpatialHash2D<Type>::CellRange SpatialHash2D<Type>::toCellRange(const RectF& rect) const noexcept
+	{
+		return{ toCell(rect.x), toCell(rect.y), toCell(rect.x + rect.w), toCell(rect.y + rect.h) };
+	}
+
+	template <class Type>
+	inline void SpatialHash2D<Type>::link(const IDType id)
+	{
+		Entry& entry = m_entries[id];
+		entry.cells = toCellRange(entry.rect);
+		entry.large = (MaxCellsPerObject < entry.cells.num_cells());
+
+		if (entry.large)
+		{
+			m_largeObjects << id;
+			return;
+		}
+
+		for (int32 y = entry.cells.y0; y <= entry.cells.y1; ++y)
+		{
+			for (int32 x = entry.cells.x0; x <= entry.cells.x1; ++x)
+			{
+				m_cells[MakeKey(x, y)] << id;
+			}
+		}
+	}
+
+	template <class Type>
+	inline void SpatialHash2D<Type>::unlink(const IDType id)
+	{
+		const Entry& entry = m_entries[id];
+
+		if (entry.large)
+		{
+			if (auto it = std::find(m_largeObjects.begin(), m_largeObjects.end(), id);
+				it != m_largeObjects.end())
+			{
+				*it = m_largeObjects.back();
+				m_largeObjects.pop_back();
+			}
+
+			return;
+		}
+
+		for (int32 y = entry.cells.y0; y <= entry.cells.y1; ++y)
+		{
+			for (int32 x = entry.cells.x0; x <= entry.cells.x1; ++x)
+			{
+				auto itCell = m_cells.find(MakeKey(x, y));
+
+				if (itCell == m_cells.end())
+				{
+					continue;
+				}
+
+				Array<IDType>& ids = itCell->second;
+
+				if (auto it = std::find(ids.begin(), ids.end(), id);
+					it != ids.end())
+				{
+					*it = ids.back();
+					ids.pop_back();
+				}
+
+				// 空になったセルを残すと、オブジェクトが通り過ぎたセルが増え続け、セル全体を走査する処理が遅くなる
+				if (ids.isEmpty())
+				{
+					m_cells.erase(itCell);
+				}
+			}
+		}
+	}
+
+	template <class Type>
+	inline bool SpatialHash2D<Type>::isReportingCell(const RectF& rect, const RectF& other, const int32 x, const int32 y) const noexcept
+	{
+		return (toCell(Max(rect.x, other.x)) == x)
+			&& (toCell(Max(rect.y, other.y)) == y);
+	}
+
+	template <class Type>
+	template <class Fty>
+	inline void SpatialHash2D<Type>::forEachGridCandidate(const RectF& rect, Fty f) const
+	{
+		const CellRange range = toCellRange(rect);
+
+		const auto visitCell = [&](const int32 x, const int32 y, const Array<IDType>& ids)
+		{
+			for (const IDType id : ids)
+			{
+				const RectF& objectRect = m_entries[id].rect;
+
+				if (Overlaps(objectRect, rect) && isReportingCell(objectRect, rect, x, y))
+				{
+					f(id);
+				}
+			}
+		};
+
+		// 範囲が広い場合は、登録されているセルを走査したほうが速い
+		if (m_cells.size() < range.num_cells())
+		{
+			for (const auto& [key, ids] : m_cells)
+			{
+				const int32 x = static_cast<int32>(static_cast<uint32>(key >> 32));
+				const int32 y = static_cast<int32>(static_cast<uint32>(key));
+
+				if (InRange(x, range.x0, range.x1) && InRange(y, range.y0, range.y1))
+				{
+					visitCell(x, y, ids);
+				}
+			}
+
+			return;
+		}
+
+		for (int32 y = range.y0; y <= range.y1; ++y)
+		{
+			for (int32 x = range.x0; x <= range.x1; ++x)
+			{
+				if (auto it = m_cells.find(MakeKey(x, y));
+					it != m_cells.end())
+				{
+					visitCell(x, y, it->second);
+				}
+			}
+		}
+	}
+
+	template <class Type>
+	template <class Fty>
+	inline void SpatialHash2D<Type>::forEachPairInCell(const CellKey key, const Array<IDType>& ids, Fty& f) const
+	{
+		const int32 x = static_cast<int32>(static_cast<uint32>(key >> 32));
+		const int32 y = static_cast<int32>(static_cast<uint32>(key));
+		const size_t count = ids.size();
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const IDType a = ids[i];
+			const RectF& rectA = m_entries[a].rect;
+
+			for (size_t k = (i + 1); k < count; ++k)
+			{
+				const IDType b = ids[k];
+				const RectF& rectB = m_entries[b].rect;
+
+				if (Overlaps(rectA, rectB) && isReportingCell(rectA, rectB, x, y))
+				{
+					f(a, b);
+				}
+			}
+		}
+	}
+
+	template <class Type>
+	template <class Fty>
+	inline void SpatialHash2D<Type>::forEachPairWithLargeObjects(Fty& f) const
+	{
+		for (size_t i = 0; i < m_largeObjects.size(); ++i)
+		{
+			const IDType a = m_largeObjects[i];
+			const RectF& rectA = m_entries[a].rect;
+
+			forEachGridCandidate(rectA, [&](const IDType b) { f(a, b); });
+
+			for (size_t k = (i + 1); k < m_largeObjects.size(); ++k)
+			{
+				const IDType b = m_largeObjects[k];
+
+				if (Overlaps(rectA, m_entries[b].rect))
+				{
+					f(a, b);
+				}
+			}
+		}
+	}
+
+	template <class Type>
+	template <class Filter>
+	inline Array<std::pair<typename SpatialHash2D<Type>::IDType, typename SpatialHash2D<Type>::IDType>> SpatialHash2D<Type>::getPairs(Filter filter) const
+	{
+		Array<std::pair<IDType, IDType>> pairs;
+
+		auto addPair = [&](const IDType a, const IDType b)
+		{
+			if (filter(a, b))
+			{
+				pairs.emplace_back(a, b);
+			}
+		};
+
+	# ifndef SIV3D_NO_CONCURRENT_API
+
+		Array<std::pair<CellKey, const Array<IDType>*>> cells(Arg::reserve = m_cells.size());
+
+		for (const auto& [key, ids] : m_cells)
+		{
+			if (2 <= ids.size())
+			{
+				cells.emplace_back(key, &ids);
+			}
+		}
+
+		// ParallelFor() のブロックは GrainSize の倍数から始まるので、ブロックごとに結果を分けて持てる
+		constexpr size_t GrainSize = 256;
+
+		Array<Array<std::pair<IDType, IDType>>> blockPairs((cells.size() + GrainSize - 1) / GrainSize);
+
+		Threading::ParallelFor(cells.size(), [&](const size_t first, const size_t last)
+			{
+				auto& localPairs = blockPairs[first / GrainSize];
+
+				auto addLocalPair = [&](const IDType a, const IDType b)
+				{
+					if (filter(a, b))
+					{
+						localPairs.emplace_back(a, b);
+					}
+				};
+
+				for (size_t i = first; i < last; ++i)
+				{
+					forEachPairInCell(cells[i].first, *cells[i].second, addLocalPair);
+				}
+			}, GrainSize);
+
+		size_t total = 0;
+
+		for (const auto& localPairs : blockPairs)
+		{
+			total += localPairs.size();
+		}
+
+		pairs.reserve(total);
+
+		for (const auto& localPairs : blockPairs)
+		{
+			pairs.append(localPairs);
+		}
+
+	# else
+
+		for (const auto& [key, ids] : m_cells)
+		{
+			forEachPairInCell(key, ids, addPair);
+		}
+
+	# endif
+
+		forEachPairWithLargeObjects(addPair);
+
+		return pairs;
+	}
+}
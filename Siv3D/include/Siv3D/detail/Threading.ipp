@@ -0,0 +1,41 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# ifndef SIV3D_NO_CONCURRENT_API
+
+# include <memory>
+
+namespace s3d
+{
+	namespace Threading
+	{
+		template <class Fty, class... Args, std::enable_if_t<std::is_invocable_v<Fty, Args...>>*>
+		inline auto Submit(Fty&& f, Args&&... args)
+		{
+			using Result = std::invoke_result_t<std::decay_t<Fty>, std::decay_t<Args>...>;
+
+			auto task = std::make_shared<std::packaged_task<Result()>>(
+				[f = std::forward<Fty>(f), ...args = std::forward<Args>(args)]() mutable -> Result
+				{
+					return std::invoke(std::move(f), std::move(args)...);
+				});
+
+			AsyncTask<Result> result{ task->get_future() };
+
+			detail::PostTask_impl([task = std::move(task)]() { (*task)(); });
+
+			return result;
+		}
+	}
+}
+
+# endif
@@ -16,6 +16,7 @@
 # include <Siv3D/ScopeGuard.hpp>
 # include <Siv3D/Mat3x2.hpp>
 # include <Siv3D/ShaderCommon.hpp>
+# include <Siv3D/ProfilerZone.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 # include <Siv3D/Renderer/GL4/CRenderer_GL4.hpp>
 # include <Siv3D/Shader/GL4/CShader_GL4.hpp>
@@ -56,6 +57,24 @@ namespace s3d
 			m_vertexArray = 0;
 		}
 
+		//////////////////////////////////////////////////
+		//
+		//	instanced sprites
+		//
+		//////////////////////////////////////////////////
+
+		if (m_instanceBuffer)
+		{
+			::glDeleteBuffers(1, &m_instanceBuffer);
+			m_instanceBuffer = 0;
+		}
+
+		if (m_instanceVertexArray)
+		{
+			::glDeleteVertexArrays(1, &m_instanceVertexArray);
+			m_instanceVertexArray = 0;
+		}
+
 		CheckOpenGLError();
 	}
 
@@ -72,6 +91,7 @@ namespace s3d
 			LOG_INFO(U"📦 Loading vertex shaders for CRenderer2D_GL4:");
 			m_standardVS = std::make_unique<GL4StandardVS2D>();
 			m_standardVS->sprite				= GLSL{ Resource(U"engine/shader/glsl/sprite.vert"), { { U"VSConstants2D", 0 } } };
+			m_standardVS->sprite_instanced		= GLSL{ Resource(U"engine/shader/glsl/sprite_instanced.vert"), { { U"VSConstants2D", 0 } } };
 			m_standardVS->fullscreen_triangle	= GLSL{ Resource(U"engine/shader/glsl/fullscreen_triangle.vert"), {} };
 			if (not m_standardVS->setup())
 			{
@@ -103,10 +123,7 @@ namespace s3d
 		}
 
 		// バッファ作成関数を作成
-		m_bufferCreator = [this](Vertex2D::IndexType vertexSize, Vertex2D::IndexType indexSize)
-		{
-			return m_batches.requestBuffer(vertexSize, indexSize, m_commandManager);
-		};
+		m_bufferCreator = BufferCreatorFunc::Bind<&CRenderer2D_GL4::requestBuffer>(this);
 
 		// シャドウ画像を作成
 		{
@@ -140,6 +157,22 @@ namespace s3d
 			::glSamplerParameteri(m_sampler, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 		}
 
+		// instanced sprites
+		{
+			::glGenVertexArrays(1, &m_instanceVertexArray);
+			::glGenBuffers(1, &m_instanceBuffer);
+
+			::glBindVertexArray(m_instanceVertexArray);
+			{
+				for (GLuint i = 0; i < 5; ++i)
+				{
+					::glEnableVertexAttribArray(i);
+					::glVertexAttribDivisor(i, 1);
+				}
+			}
+			::glBindVertexArray(0);
+		}
+
 		CheckOpenGLError();
 	}
 
@@ -666,25 +699,73 @@ namespace s3d
 		}
 	}
 
-	void CRenderer2D_GL4::addTexturedParticles(const Texture& texture, const Array<Particle2D>& particles,
+	void CRenderer2D_GL4::addTexturedParticles(const Texture& texture, const ParticleStorage2D& particles,
 		ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc,
 		ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc)
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildTexturedParticles(m_bufferCreator, particles, sizeOverLifeTimeFunc, colorOverLifeTimeFunc))
+		for (size_t offset = 0; offset < particles.size(); offset += Vertex2DBuilder::MaxTexturedParticles)
 		{
-			if (not m_currentCustomVS)
+			const size_t n = Min((particles.size() - offset), Vertex2DBuilder::MaxTexturedParticles);
+
+			if (const auto indexCount = Vertex2DBuilder::BuildTexturedParticles(m_bufferCreator, particles, offset, n, sizeOverLifeTimeFunc, colorOverLifeTimeFunc))
 			{
-				m_commandManager.pushStandardVS(m_standardVS->spriteID);
+				if (not m_currentCustomVS)
+				{
+					m_commandManager.pushStandardVS(m_standardVS->spriteID);
+				}
+
+				if (not m_currentCustomPS)
+				{
+					m_commandManager.pushStandardPS(m_standardPS->textureID);
+				}
+
+				m_commandManager.pushPSTexture(0, texture);
+				m_commandManager.pushDraw(indexCount);
 			}
+		}
+	}
 
-			if (not m_currentCustomPS)
+	void CRenderer2D_GL4::addTexturedInstances(const Texture& texture, const SpriteInstance* instances, const size_t count)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		// カスタム VS は Vertex2D の入力を前提としているため、CPU で頂点に展開する
+		if (m_currentCustomVS)
+		{
+			for (size_t offset = 0; offset < count; offset += Vertex2DBuilder::MaxTexturedInstances)
 			{
-				m_commandManager.pushStandardPS(m_standardPS->textureID);
+				const size_t n = Min((count - offset), Vertex2DBuilder::MaxTexturedInstances);
+
+				if (const auto indexCount = Vertex2DBuilder::BuildTexturedInstances(m_bufferCreator, (instances + offset), n))
+				{
+					if (not m_currentCustomPS)
+					{
+						m_commandManager.pushStandardPS(m_standardPS->textureID);
+					}
+
+					m_commandManager.pushPSTexture(0, texture);
+					m_commandManager.pushDraw(indexCount);
+				}
 			}
 
-			m_commandManager.pushPSTexture(0, texture);
-			m_commandManager.pushDraw(indexCount);
+			// インスタンス描画の経路では flush() 時に集計される
+			m_stat.instanceCount += static_cast<uint32>(count);
+
+			return;
 		}
+
+		m_commandManager.pushStandardVS(m_standardVS->sprite_instancedID);
+
+		if (not m_currentCustomPS)
+		{
+			m_commandManager.pushStandardPS(m_standardPS->textureID);
+		}
+
+		m_commandManager.pushPSTexture(0, texture);
+		m_commandManager.pushDrawInstanced(instances, count);
 	}
 
 	Float4 CRenderer2D_GL4::getColorMul() const
@@ -921,6 +1002,16 @@ namespace s3d
 		m_commandManager.pushConstantBuffer(stage, slot, buffer, data, num_vectors);
 	}
 
+	void CRenderer2D_GL4::beginBatchReorder()
+	{
+		m_commandManager.beginReorder();
+	}
+
+	void CRenderer2D_GL4::endBatchReorder()
+	{
+		m_commandManager.endReorder(m_batches);
+	}
+
 	const Texture& CRenderer2D_GL4::getBoxShadowTexture() const noexcept
 	{
 		return *m_boxShadowTexture;
@@ -928,6 +1019,8 @@ namespace s3d
 
 	void CRenderer2D_GL4::flush()
 	{
+		SIV3D_PROFILE_ZONE(U"Renderer2D::flush");
+
 		ScopeGuard cleanUp = [this]()
 		{
 			m_batches.reset();
@@ -936,7 +1029,9 @@ namespace s3d
 			m_currentCustomPS.reset();
 		};
 
+		m_commandManager.finishReorder(m_batches);
 		m_commandManager.flush();
+		m_stat.savedDrawCalls += m_commandManager.getSavedDrawCalls();
 
 		pShader->usePipeline();
 
@@ -953,6 +1048,14 @@ namespace s3d
 		pRenderer->getDepthStencilState().set(DepthStencilState::Default2D);
 		pRenderer->getBackBuffer().bindSceneToContext(false);
 
+		// このフレームのインスタンスデータをまとめて転送する
+		if (const auto& instances = m_commandManager.getInstances())
+		{
+			::glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+			::glBufferData(GL_ARRAY_BUFFER, (sizeof(SpriteInstance) * instances.size()), nullptr, GL_STREAM_DRAW);
+			::glBufferSubData(GL_ARRAY_BUFFER, 0, (sizeof(SpriteInstance) * instances.size()), instances.data());
+		}
+
 		BatchInfo2D batchInfo;
 
 		LOG_COMMAND(U"----");
@@ -988,12 +1091,11 @@ namespace s3d
 
 					const GL4DrawCommand& draw = m_commandManager.getDraw(command.index);
 					const uint32 indexCount = draw.indexCount;
-					const uint32 startIndexLocation = batchInfo.startIndexLocation;
+					const uint32 startIndexLocation = (batchInfo.startIndexLocation + draw.indexOffset);
 					const uint32 baseVertexLocation = batchInfo.baseVertexLocation;
 					constexpr Vertex2D::IndexType* pBase = 0;
 
 					::glDrawElementsBaseVertex(GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, (pBase + startIndexLocation), baseVertexLocation);
-					batchInfo.startIndexLocation += indexCount;
 
 					++m_stat.drawCalls;
 					m_stat.triangleCount += (indexCount / 3);
@@ -1026,6 +1128,20 @@ namespace s3d
 					LOG_COMMAND(U"DrawNull[{}] count = {}"_fmt(command.index, draw));
 					break;
 				}
+			case GL4Renderer2DCommandType::DrawInstanced:
+				{
+					m_vsConstants2D._update_if_dirty();
+					m_psConstants2D._update_if_dirty();
+
+					const GL4DrawInstancedCommand& draw = m_commandManager.getDrawInstanced(command.index);
+
+					drawInstances(draw);
+
+					m_batches.setBuffers();
+
+					LOG_COMMAND(U"DrawInstanced[{}] instanceOffset = {}, instanceCount = {}"_fmt(command.index, draw.instanceOffset, draw.instanceCount));
+					break;
+				}
 			case GL4Renderer2DCommandType::ColorMul:
 				{
 					m_vsConstants2D->colorMul = m_commandManager.getColorMul(command.index);
@@ -1332,4 +1448,36 @@ namespace s3d
 
 		CheckOpenGLError();
 	}
+
+	Vertex2DBufferPointer CRenderer2D_GL4::requestBuffer(const Vertex2D::IndexType vertexSize, const Vertex2D::IndexType indexSize)
+	{
+		return m_batches.requestBuffer(vertexSize, indexSize, m_commandManager);
+	}
+
+	void CRenderer2D_GL4::drawInstances(const GL4DrawInstancedCommand& draw)
+	{
+		::glBindVertexArray(m_instanceVertexArray);
+		{
+			::glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+
+			// OpenGL 4.1 には baseInstance 付きの描画が無いため、属性のオフセットでインスタンスの開始位置を指定する
+			const size_t base = (sizeof(SpriteInstance) * draw.instanceOffset);
+			constexpr GLsizei stride = sizeof(SpriteInstance);
+			constexpr const GLubyte* pBase = nullptr;
+
+			::glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride, (pBase + base + offsetof(SpriteInstance, center)));
+			::glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, (pBase + base + offsetof(SpriteInstance, size)));
+			::glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, stride, (pBase + base + offsetof(SpriteInstance, uv)));
+			::glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, stride, (pBase + base + offsetof(SpriteInstance, color)));
+			::glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, stride, (pBase + base + offsetof(SpriteInstance, angle)));
+
+			// 四角形の 4 頂点は頂点シェーダで gl_VertexID から求める
+			::glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, draw.instanceCount);
+		}
+		::glBindVertexArray(0);
+
+		++m_stat.drawCalls;
+		m_stat.triangleCount += (draw.instanceCount * 2);
+		m_stat.instanceCount += draw.instanceCount;
+	}
 }
@@ -31,16 +31,20 @@ namespace s3d
 	struct GL4StandardVS2D
 	{
 		VertexShader sprite;
+		VertexShader sprite_instanced;
 		VertexShader fullscreen_triangle;
 
 		VertexShader::IDType spriteID;
+		VertexShader::IDType sprite_instancedID;
 
 		bool setup()
 		{
 			const bool result = sprite
+				&& sprite_instanced
 				&& fullscreen_triangle;
 
 			spriteID = sprite.id();
+			sprite_instancedID = sprite_instanced.id();
 
 			return result;
 		}
@@ -107,12 +111,25 @@ namespace s3d
 		GLuint m_vertexArray		= 0;
 		GLuint m_sampler			= 0;
 
+		//////////////////////////////////////////////////
+		//
+		//	instanced sprites
+		//
+		//////////////////////////////////////////////////
+		GLuint m_instanceVertexArray	= 0;
+		GLuint m_instanceBuffer			= 0;
+
 		// VertexBuilder でのメモリアロケーションを避けるためのバッファ
 		Array<Float2> m_buffer;
 
 
 		Renderer2DStat m_stat;
 
+		[[nodiscard]]
+		Vertex2DBufferPointer requestBuffer(Vertex2D::IndexType vertexSize, Vertex2D::IndexType indexSize);
+
+		void drawInstances(const GL4DrawInstancedCommand& draw);
+
 	public:
 
 		CRenderer2D_GL4();
@@ -181,10 +198,12 @@ namespace s3d
 
 		void addTexturedVertices(const Texture& texture, const Vertex2D* vertices, size_t vertexCount, const TriangleIndex* indices, size_t num_triangles) override;
 		
-		void addTexturedParticles(const Texture& texture, const Array<Particle2D>& particles,
+		void addTexturedParticles(const Texture& texture, const ParticleStorage2D& particles,
 			ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc,
 			ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc) override;
 
+		void addTexturedInstances(const Texture& texture, const SpriteInstance* instances, size_t count) override;
+
 
 		Float4 getColorMul() const override;
 
@@ -253,6 +272,10 @@ namespace s3d
 
 		void setConstantBuffer(ShaderStage stage, uint32 slot, const ConstantBufferBase& buffer, const float* data, uint32 num_vectors) override;
 
+		void beginBatchReorder() override;
+
+		void endBatchReorder() override;
+
 		const Texture& getBoxShadowTexture() const noexcept override;
 
 		void flush() override;
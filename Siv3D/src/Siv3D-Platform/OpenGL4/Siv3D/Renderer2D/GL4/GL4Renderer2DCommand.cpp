@@ -10,9 +10,47 @@
 //-----------------------------------------------
 
 # include "GL4Renderer2DCommand.hpp"
+# include "GL4Vertex2DBatch.hpp"
 
 namespace s3d
 {
+	namespace detail
+	{
+		enum class ReorderCommandKind : uint8
+		{
+			Ignore,
+
+			Draw,
+
+			State,
+
+			Barrier,
+		};
+
+		[[nodiscard]]
+		static constexpr ReorderCommandKind GetReorderCommandKind(const GL4Renderer2DCommandType type) noexcept
+		{
+			switch (type)
+			{
+			case GL4Renderer2DCommandType::Null:
+				return ReorderCommandKind::Ignore;
+			case GL4Renderer2DCommandType::Draw:
+				return ReorderCommandKind::Draw;
+			// 頂点バッファや描画先を切り替えるコマンドと、頂点バッファを使わない描画は、前後の描画と順序を入れ替えない
+			case GL4Renderer2DCommandType::SetBuffers:
+			case GL4Renderer2DCommandType::UpdateBuffers:
+			case GL4Renderer2DCommandType::DrawNull:
+			case GL4Renderer2DCommandType::DrawInstanced:
+			case GL4Renderer2DCommandType::Viewport:
+			case GL4Renderer2DCommandType::SetRT:
+			case GL4Renderer2DCommandType::SetConstantBuffer:
+				return ReorderCommandKind::Barrier;
+			default:
+				return ReorderCommandKind::State;
+			}
+		}
+	}
+
 	GL4Renderer2DCommandManager::GL4Renderer2DCommandManager()
 	{
 		m_vsSamplerStates.fill(Array<SamplerState>{ SamplerState::Default2D });
@@ -45,6 +83,8 @@ namespace s3d
 		{
 			m_draws.clear();
 			m_nullDraws.clear();
+			m_instancedDraws.clear();
+			m_instances.clear();
 			m_colorMuls			= { m_colorMuls.back() };
 			m_colorAdds			= { m_colorAdds.back() };
 			m_blendStates		= { m_blendStates.back() };
@@ -155,6 +195,12 @@ namespace s3d
 				m_currentPSTextures.fill(Texture::IDType::InvalidValue());
 			}
 		}
+
+		m_batchIndexCount = 0;
+		m_savedDrawCalls = 0;
+
+		// 並べ替えのスコープがフレームをまたぐ場合、新しいフレームの先頭から並べ替えを続ける
+		m_reorderCommandBegin = m_commands.size();
 	}
 
 	void GL4Renderer2DCommandManager::flush()
@@ -306,6 +352,7 @@ namespace s3d
 		flush();
 
 		m_commands.emplace_back(GL4Renderer2DCommandType::UpdateBuffers, batchIndex);
+		m_batchIndexCount = 0;
 	}
 
 	void GL4Renderer2DCommandManager::pushDraw(const Vertex2D::IndexType indexCount)
@@ -315,7 +362,13 @@ namespace s3d
 			flush();
 		}
 
+		if (m_currentDraw.indexCount == 0)
+		{
+			m_currentDraw.indexOffset = m_batchIndexCount;
+		}
+
 		m_currentDraw.indexCount += indexCount;
+		m_batchIndexCount += indexCount;
 	}
 
 	const GL4DrawCommand& GL4Renderer2DCommandManager::getDraw(const uint32 index) const noexcept
@@ -340,6 +393,35 @@ namespace s3d
 		return m_nullDraws[index];
 	}
 
+	void GL4Renderer2DCommandManager::pushDrawInstanced(const SpriteInstance* instances, const size_t count)
+	{
+		// 描画順序を保つため、保留中の描画とステートの変更を先に確定させる
+		flush();
+
+		const uint32 instanceOffset = static_cast<uint32>(m_instances.size());
+		m_instances.insert(m_instances.end(), instances, (instances + count));
+
+		// ステートの変更を挟まずに続くインスタンス描画は 1 回にまとめる
+		if (m_commands.back().type == GL4Renderer2DCommandType::DrawInstanced)
+		{
+			m_instancedDraws.back().instanceCount += static_cast<uint32>(count);
+			return;
+		}
+
+		m_commands.emplace_back(GL4Renderer2DCommandType::DrawInstanced, static_cast<uint32>(m_instancedDraws.size()));
+		m_instancedDraws.push_back({ instanceOffset, static_cast<uint32>(count) });
+	}
+
+	const GL4DrawInstancedCommand& GL4Renderer2DCommandManager::getDrawInstanced(const uint32 index) const noexcept
+	{
+		return m_instancedDraws[index];
+	}
+
+	const Array<SpriteInstance>& GL4Renderer2DCommandManager::getInstances() const noexcept
+	{
+		return m_instances;
+	}
+
 	void GL4Renderer2DCommandManager::pushColorMul(const Float4 & color)
 	{
 		constexpr auto command = GL4Renderer2DCommandType::ColorMul;
@@ -1185,4 +1267,258 @@ namespace s3d
 	{
 		return m_currentRT;
 	}
+
+	void GL4Renderer2DCommandManager::beginReorder()
+	{
+		if (m_reorderDepth++ == 0)
+		{
+			flush();
+
+			m_reorderCommandBegin = m_commands.size();
+		}
+	}
+
+	void GL4Renderer2DCommandManager::endReorder(GL4Vertex2DBatch& batches)
+	{
+		if (m_reorderDepth == 0)
+		{
+			return;
+		}
+
+		if (--m_reorderDepth == 0)
+		{
+			reorderCommands(batches);
+		}
+	}
+
+	void GL4Renderer2DCommandManager::finishReorder(GL4Vertex2DBatch& batches)
+	{
+		if (m_reorderDepth)
+		{
+			reorderCommands(batches);
+		}
+	}
+
+	uint32 GL4Renderer2DCommandManager::getSavedDrawCalls() const noexcept
+	{
+		return m_savedDrawCalls;
+	}
+
+	void GL4Renderer2DCommandManager::reorderCommands(GL4Vertex2DBatch& batches)
+	{
+		flush();
+
+		if (m_commands.size() <= m_reorderCommandBegin)
+		{
+			return;
+		}
+
+		// 並べ替える範囲の直前のステートと頂点バッファを求める
+		StateIndices state{};
+		uint32 batchIndex = 0;
+
+		for (size_t i = 0; i < m_reorderCommandBegin; ++i)
+		{
+			const auto& command = m_commands[i];
+
+			if (command.type == GL4Renderer2DCommandType::UpdateBuffers)
+			{
+				batchIndex = command.index;
+			}
+			else if (detail::GetReorderCommandKind(command.type) == detail::ReorderCommandKind::State)
+			{
+				state[FromEnum(command.type)] = command.index;
+			}
+		}
+
+		const Array<GL4Renderer2DCommand> commands(m_commands.begin() + m_reorderCommandBegin, m_commands.end());
+		m_commands.resize(m_reorderCommandBegin);
+
+		StateIndices emitted = state;
+		m_reorder.clear();
+		m_reorderStates.clear();
+
+		for (const auto& command : commands)
+		{
+			switch (detail::GetReorderCommandKind(command.type))
+			{
+			case detail::ReorderCommandKind::Draw:
+				{
+					const auto& draw = m_draws[command.index];
+					m_reorder.add(draw.indexOffset, draw.indexCount, static_cast<uint32>(m_reorderStates.size()), getReorderBounds(batches, batchIndex, draw, state));
+					m_reorderStates.push_back(state);
+				}
+				break;
+			case detail::ReorderCommandKind::State:
+				state[FromEnum(command.type)] = command.index;
+				break;
+			case detail::ReorderCommandKind::Barrier:
+				emitReorderedDraws(batches, batchIndex, emitted);
+				emitStateChanges(emitted, state);
+				m_commands.push_back(command);
+
+				if (command.type == GL4Renderer2DCommandType::UpdateBuffers)
+				{
+					batchIndex = command.index;
+				}
+				break;
+			default:
+				break;
+			}
+		}
+
+		emitReorderedDraws(batches, batchIndex, emitted);
+		emitStateChanges(emitted, state);
+
+		m_reorderCommandBegin = m_commands.size();
+	}
+
+	FloatRect GL4Renderer2DCommandManager::getReorderBounds(const GL4Vertex2DBatch& batches, const uint32 batchIndex, const GL4DrawCommand& draw, const StateIndices& states) const
+	{
+		// カスタム頂点シェーダが頂点をどこへ動かすかはわからないため、すべての描画と重なるものとして扱う
+		if (m_reservedVSs.contains(m_VSs[states[FromEnum(GL4Renderer2DCommandType::SetVS)]]))
+		{
+			return Renderer2DBatchReorder::InfiniteBounds;
+		}
+
+		const FloatRect bounds = batches.getBounds(batchIndex, draw.indexOffset, draw.indexCount);
+		return Renderer2DBatchReorder::TransformBounds(bounds, m_combinedTransforms[states[FromEnum(GL4Renderer2DCommandType::Transform)]]);
+	}
+
+	void GL4Renderer2DCommandManager::emitReorderedDraws(GL4Vertex2DBatch& batches, const uint32 batchIndex, StateIndices& emitted)
+	{
+		if (m_reorder.isEmpty())
+		{
+			return;
+		}
+
+		const uint32 baseIndexOffset = m_reorder.getItems().front().indexOffset;
+
+		if (m_reorder.sort([this](const uint32 a, const uint32 b) { return hasSameStates(m_reorderStates[a], m_reorderStates[b]); }))
+		{
+			// 描画の順に合わせてインデックスを並べ替え、同じグループの描画を連続した範囲にする
+			batches.reorderIndices(batchIndex, baseIndexOffset, m_reorder.getIndexRanges());
+		}
+
+		uint32 indexOffset = baseIndexOffset;
+		size_t drawCount = 0;
+
+		for (const auto& item : m_reorder.getItems())
+		{
+			emitStateChanges(emitted, m_reorderStates[item.stateID]);
+
+			if (const auto& last = m_commands.back();
+				(last.type == GL4Renderer2DCommandType::Draw)
+				&& ((m_draws[last.index].indexOffset + m_draws[last.index].indexCount) == indexOffset))
+			{
+				m_draws[last.index].indexCount += item.indexCount;
+			}
+			else
+			{
+				m_commands.emplace_back(GL4Renderer2DCommandType::Draw, static_cast<uint32>(m_draws.size()));
+				m_draws.push_back({ item.indexCount, indexOffset });
+				++drawCount;
+			}
+
+			indexOffset += item.indexCount;
+		}
+
+		m_savedDrawCalls += static_cast<uint32>(m_reorder.getItems().size() - drawCount);
+		m_reorder.clear();
+		m_reorderStates.clear();
+	}
+
+	void GL4Renderer2DCommandManager::emitStateChanges(StateIndices& emitted, const StateIndices& target)
+	{
+		for (uint32 i = 0; i < target.size(); ++i)
+		{
+			const auto type = ToEnum<GL4Renderer2DCommandType>(i);
+
+			if ((detail::GetReorderCommandKind(type) == detail::ReorderCommandKind::State)
+				&& (not isSameState(type, emitted[i], target[i])))
+			{
+				m_commands.emplace_back(type, target[i]);
+				emitted[i] = target[i];
+			}
+		}
+	}
+
+	bool GL4Renderer2DCommandManager::hasSameStates(const StateIndices& a, const StateIndices& b) const
+	{
+		if (a == b)
+		{
+			return true;
+		}
+
+		for (uint32 i = 0; i < a.size(); ++i)
+		{
+			const auto type = ToEnum<GL4Renderer2DCommandType>(i);
+
+			if ((detail::GetReorderCommandKind(type) == detail::ReorderCommandKind::State)
+				&& (not isSameState(type, a[i], b[i])))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool GL4Renderer2DCommandManager::isSameState(const GL4Renderer2DCommandType type, const uint32 a, const uint32 b) const
+	{
+		if (a == b)
+		{
+			return true;
+		}
+
+		// ステートは変更のたびに新しいインデックスに追加されるため、値を比較する
+		switch (type)
+		{
+		case GL4Renderer2DCommandType::ColorMul:
+			return (m_colorMuls[a] == m_colorMuls[b]);
+		case GL4Renderer2DCommandType::ColorAdd:
+			return (m_colorAdds[a] == m_colorAdds[b]);
+		case GL4Renderer2DCommandType::BlendState:
+			return (m_blendStates[a] == m_blendStates[b]);
+		case GL4Renderer2DCommandType::RasterizerState:
+			return (m_rasterizerStates[a] == m_rasterizerStates[b]);
+		case GL4Renderer2DCommandType::ScissorRect:
+			return (m_scissorRects[a] == m_scissorRects[b]);
+		case GL4Renderer2DCommandType::SDFParams:
+			return (m_sdfParams[a] == m_sdfParams[b]);
+		case GL4Renderer2DCommandType::InternalPSConstants:
+			return (m_internalPSConstants[a] == m_internalPSConstants[b]);
+		case GL4Renderer2DCommandType::SetVS:
+			return (m_VSs[a] == m_VSs[b]);
+		case GL4Renderer2DCommandType::SetPS:
+			return (m_PSs[a] == m_PSs[b]);
+		case GL4Renderer2DCommandType::Transform:
+			return (m_combinedTransforms[a] == m_combinedTransforms[b]);
+		default:
+			break;
+		}
+
+		if (InRange(type, GL4Renderer2DCommandType::VSSamplerState0, GL4Renderer2DCommandType::VSSamplerState7))
+		{
+			const uint32 slot = (FromEnum(type) - FromEnum(GL4Renderer2DCommandType::VSSamplerState0));
+			return (m_vsSamplerStates[slot][a] == m_vsSamplerStates[slot][b]);
+		}
+		else if (InRange(type, GL4Renderer2DCommandType::PSSamplerState0, GL4Renderer2DCommandType::PSSamplerState7))
+		{
+			const uint32 slot = (FromEnum(type) - FromEnum(GL4Renderer2DCommandType::PSSamplerState0));
+			return (m_psSamplerStates[slot][a] == m_psSamplerStates[slot][b]);
+		}
+		else if (InRange(type, GL4Renderer2DCommandType::VSTexture0, GL4Renderer2DCommandType::VSTexture7))
+		{
+			const uint32 slot = (FromEnum(type) - FromEnum(GL4Renderer2DCommandType::VSTexture0));
+			return (m_vsTextures[slot][a] == m_vsTextures[slot][b]);
+		}
+		else if (InRange(type, GL4Renderer2DCommandType::PSTexture0, GL4Renderer2DCommandType::PSTexture7))
+		{
+			const uint32 slot = (FromEnum(type) - FromEnum(GL4Renderer2DCommandType::PSTexture0));
+			return (m_psTextures[slot][a] == m_psTextures[slot][b]);
+		}
+
+		return false;
+	}
 }
@@ -25,7 +25,9 @@
 # include <Siv3D/Texture.hpp>
 # include <Siv3D/RenderTexture.hpp>
 # include <Siv3D/Mat3x2.hpp>
+# include <Siv3D/SpriteInstance.hpp>
 # include <Siv3D/Renderer2D/CurrentBatchStateChanges.hpp>
+# include <Siv3D/Renderer2D/Renderer2DBatchReorder.hpp>
 
 namespace s3d
 {
@@ -41,6 +43,8 @@ namespace s3d
 
 		DrawNull,
 
+		DrawInstanced,
+
 		ColorMul,
 
 		ColorAdd,
@@ -149,6 +153,15 @@ namespace s3d
 	struct GL4DrawCommand
 	{
 		uint32 indexCount = 0;
+
+		// バッチの先頭からのインデックスのオフセット
+		uint32 indexOffset = 0;
+	};
+
+	struct GL4DrawInstancedCommand
+	{
+		uint32 instanceOffset = 0;
+		uint32 instanceCount = 0;
 	};
 
 	struct GL4ConstantBufferCommand
@@ -161,6 +174,8 @@ namespace s3d
 		ConstantBufferBase cbBase;
 	};
 
+	class GL4Vertex2DBatch;
+
 	class GL4Renderer2DCommandManager
 	{
 	private:
@@ -172,6 +187,8 @@ namespace s3d
 		// buffer
 		Array<GL4DrawCommand> m_draws;
 		Array<uint32> m_nullDraws;
+		Array<GL4DrawInstancedCommand> m_instancedDraws;
+		Array<SpriteInstance> m_instances;
 		Array<Float4> m_colorMuls					= { Float4{ 1.0f, 1.0f, 1.0f, 1.0f } };
 		Array<Float4> m_colorAdds					= { Float4{ 0.0f, 0.0f, 0.0f, 0.0f } };
 		Array<BlendState> m_blendStates				= { BlendState::Default2D };
@@ -229,6 +246,25 @@ namespace s3d
 		HashTable<PixelShader::IDType, PixelShader> m_reservedPSs;
 		HashTable<Texture::IDType, Texture> m_reservedTextures;
 
+		// 現在のバッチに積まれたインデックスの数
+		uint32 m_batchIndexCount = 0;
+
+		// reorder
+		using StateIndices = std::array<uint32, (FromEnum(GL4Renderer2DCommandType::PSTexture7) + 1)>;
+
+		uint32 m_reorderDepth = 0;
+		size_t m_reorderCommandBegin = 0;
+		uint32 m_savedDrawCalls = 0;
+		Renderer2DBatchReorder m_reorder;
+		Array<StateIndices> m_reorderStates;
+
+		void reorderCommands(GL4Vertex2DBatch& batches);
+		FloatRect getReorderBounds(const GL4Vertex2DBatch& batches, uint32 batchIndex, const GL4DrawCommand& draw, const StateIndices& states) const;
+		void emitReorderedDraws(GL4Vertex2DBatch& batches, uint32 batchIndex, StateIndices& emitted);
+		void emitStateChanges(StateIndices& emitted, const StateIndices& target);
+		bool hasSameStates(const StateIndices& a, const StateIndices& b) const;
+		bool isSameState(GL4Renderer2DCommandType type, uint32 a, uint32 b) const;
+
 	public:
 
 		GL4Renderer2DCommandManager();
@@ -247,6 +283,10 @@ namespace s3d
 		void pushNullVertices(uint32 count);
 		uint32 getNullDraw(uint32 index) const noexcept;
 
+		void pushDrawInstanced(const SpriteInstance* instances, size_t count);
+		const GL4DrawInstancedCommand& getDrawInstanced(uint32 index) const noexcept;
+		const Array<SpriteInstance>& getInstances() const noexcept;
+
 		void pushColorMul(const Float4& color);
 		const Float4& getColorMul(uint32 index) const;
 		const Float4& getCurrentColorMul() const;
@@ -321,5 +361,10 @@ namespace s3d
 		void pushRT(const Optional<RenderTexture>& rt);
 		const Optional<RenderTexture>& getRT(uint32 index) const;
 		const Optional<RenderTexture>& getCurrentRT() const;
+
+		void beginReorder();
+		void endReorder(GL4Vertex2DBatch& batches);
+		void finishReorder(GL4Vertex2DBatch& batches);
+		uint32 getSavedDrawCalls() const noexcept;
 	};
 }
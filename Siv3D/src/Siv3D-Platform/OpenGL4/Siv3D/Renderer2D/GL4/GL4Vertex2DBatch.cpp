@@ -11,6 +11,7 @@
 
 # include <Siv3D/Common.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/Renderer2D/Renderer2DBatchReorder.hpp>
 # include "GL4Vertex2DBatch.hpp"
 
 namespace s3d
@@ -28,6 +29,40 @@ namespace s3d
 
 			return newArraySize;
 		}
+
+		static void SetVertex2DAttributes()
+		{
+			::glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 32, (const GLubyte*)0);	// Vertex2D::pos
+			::glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 32, (const GLubyte*)8);	// Vertex2D::tex
+			::glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, 32, (const GLubyte*)16);	// Vertex2D::color
+
+			::glEnableVertexAttribArray(0);
+			::glEnableVertexAttribArray(1);
+			::glEnableVertexAttribArray(2);
+		}
+
+		static void WaitFence(GLsync& fence)
+		{
+			if (not fence)
+			{
+				return;
+			}
+
+			for (;;)
+			{
+				const GLenum result = ::glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000); // 1 ms
+
+				if ((result == GL_ALREADY_SIGNALED)
+					|| (result == GL_CONDITION_SATISFIED)
+					|| (result == GL_WAIT_FAILED))
+				{
+					break;
+				}
+			}
+
+			::glDeleteSync(fence);
+			fence = nullptr;
+		}
 	}
 
 	GL4Vertex2DBatch::GL4Vertex2DBatch()
@@ -40,6 +75,8 @@ namespace s3d
 
 	GL4Vertex2DBatch::~GL4Vertex2DBatch()
 	{
+		releaseStreamBuffers();
+
 		if (m_indexBuffer)
 		{
 			::glDeleteBuffers(1, &m_indexBuffer);
@@ -72,15 +109,7 @@ namespace s3d
 				::glBufferData(GL_ARRAY_BUFFER, (sizeof(Vertex2D) * VertexBufferSize), nullptr, GL_DYNAMIC_DRAW);
 			}
 
-			{
-				::glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 32, (const GLubyte*)0);	// Vertex2D::pos
-				::glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 32, (const GLubyte*)8);	// Vertex2D::tex
-				::glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, 32, (const GLubyte*)16);	// Vertex2D::color
-
-				::glEnableVertexAttribArray(0);
-				::glEnableVertexAttribArray(1);
-				::glEnableVertexAttribArray(2);
-			}
+			detail::SetVertex2DAttributes();
 
 			{
 				::glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer);
@@ -89,6 +118,16 @@ namespace s3d
 		}
 		::glBindVertexArray(0);
 
+		// OpenGL 4.4 (ARB_buffer_storage) が使える場合は、永続的にマップしたバッファに頂点を直接書き込む
+		if (GLEW_ARB_buffer_storage && initStreamBuffers())
+		{
+			LOG_INFO(U"ℹ️ GL4Vertex2DBatch: persistent-mapped streaming enabled");
+		}
+		else
+		{
+			LOG_INFO(U"ℹ️ GL4Vertex2DBatch: persistent-mapped streaming is not available");
+		}
+
 		return true;
 	}
 
@@ -126,7 +165,7 @@ namespace s3d
 			(VertexBufferSize < (lastbatch.vertexPos + vertexSize) || IndexBufferSize < (lastbatch.indexPos + indexSize)))
 		{
 			commandManager.pushUpdateBuffers(static_cast<uint32>(m_batches.size()));
-			m_batches.emplace_back();
+			m_batches.push_back({ .vertexBase = m_vertexArrayWritePos, .indexBase = m_indexArrayWritePos });
 		}
 
 		auto& lastbatch = m_batches.back();
@@ -147,42 +186,52 @@ namespace s3d
 
 	void GL4Vertex2DBatch::reset()
 	{
-		m_batches.clear();
-		m_batches.emplace_back();
+		// この flush の描画の後にフェンスを置く。次の flush は同じ区間の続きから書き込む
+		if (m_streamFencePending)
+		{
+			fenceStreamRegion();
+		}
 
 		m_vertexArrayWritePos = 0;
 		m_indexArrayWritePos = 0;
+
+		m_batches.clear();
+		m_batches.emplace_back();
 	}
 
 	void GL4Vertex2DBatch::setBuffers()
 	{
-		::glBindVertexArray(m_vao);
-		::glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+		if (isStreaming())
+		{
+			::glBindVertexArray(m_streamVAO);
+			::glBindBuffer(GL_ARRAY_BUFFER, m_streamVertexBuffer);
+		}
+		else
+		{
+			::glBindVertexArray(m_vao);
+			::glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+		}
 	}
 
 	BatchInfo2D GL4Vertex2DBatch::updateBuffers(const size_t batchIndex)
 	{
 		assert(batchIndex < m_batches.size());
 
-		size_t vertexArrayReadPos = 0;
-		size_t indexArrayReadPos = 0;
+		const auto& currentBatch = m_batches[batchIndex];
+
+		setBuffers();
 
-		for (size_t i = 0; i < batchIndex; ++i)
+		if (isStreaming())
 		{
-			vertexArrayReadPos += m_batches[i].vertexPos;
-			indexArrayReadPos += m_batches[i].indexPos;
+			return streamBatch(currentBatch);
 		}
 
-		::glBindVertexArray(m_vao);
-		::glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
-
 		BatchInfo2D batchInfo;
-		const auto& currentBatch = m_batches[batchIndex];
 
 		// VB
 		if (const uint16 vertexSize = currentBatch.vertexPos)
 		{
-			const Vertex2D* pSrc = &m_vertexArray[vertexArrayReadPos];
+			const Vertex2D* pSrc = &m_vertexArray[currentBatch.vertexBase];
 
 			if (VertexBufferSize < (m_vertexBufferWritePos + vertexSize))
 			{
@@ -204,7 +253,7 @@ namespace s3d
 		// IB
 		if (const uint32 indexSize = currentBatch.indexPos)
 		{
-			const Vertex2D::IndexType* pSrc = &m_indexArray[indexArrayReadPos];
+			const Vertex2D::IndexType* pSrc = &m_indexArray[currentBatch.indexBase];
 
 			if (IndexBufferSize < (m_indexBufferWritePos + indexSize))
 			{
@@ -227,6 +276,171 @@ namespace s3d
 		return batchInfo;
 	}
 
+	FloatRect GL4Vertex2DBatch::getBounds(const size_t batchIndex, const uint32 indexOffset, const uint32 indexCount) const
+	{
+		assert(batchIndex < m_batches.size());
+
+		const auto& batch = m_batches[batchIndex];
+		const Vertex2D* pVertex = &m_vertexArray[batch.vertexBase];
+		const Vertex2D::IndexType* pIndex = &m_indexArray[batch.indexBase + indexOffset];
+
+		return Renderer2DBatchReorder::CalculateBounds(pVertex, pIndex, indexCount);
+	}
+
+	void GL4Vertex2DBatch::reorderIndices(const size_t batchIndex, const uint32 indexOffset, const Array<std::pair<uint32, uint32>>& ranges)
+	{
+		assert(batchIndex < m_batches.size());
+
+		Vertex2D::IndexType* const pIndex = &m_indexArray[m_batches[batchIndex].indexBase + indexOffset];
+
+		Renderer2DBatchReorder::ReorderIndices(pIndex, indexOffset, ranges, m_reorderBuffer);
+	}
+
+	bool GL4Vertex2DBatch::initStreamBuffers()
+	{
+		// 頂点とインデックスは配列から書き込むだけなので、書き込み専用でマップし、書き込んだ範囲を明示的にフラッシュする
+		constexpr GLbitfield StorageFlags = (GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT);
+		constexpr GLbitfield MapFlags = (GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_FLUSH_EXPLICIT_BIT);
+		constexpr GLsizeiptr VertexBufferBytes = (sizeof(Vertex2D) * StreamRegionVertexCount * NumStreamRegions);
+		constexpr GLsizeiptr IndexBufferBytes = (sizeof(Vertex2D::IndexType) * StreamRegionIndexCount * NumStreamRegions);
+
+		::glGenVertexArrays(1, &m_streamVAO);
+		::glGenBuffers(1, &m_streamVertexBuffer);
+		::glGenBuffers(1, &m_streamIndexBuffer);
+
+		::glBindVertexArray(m_streamVAO);
+		{
+			{
+				::glBindBuffer(GL_ARRAY_BUFFER, m_streamVertexBuffer);
+				::glBufferStorage(GL_ARRAY_BUFFER, VertexBufferBytes, nullptr, StorageFlags);
+				m_streamVertices = static_cast<Vertex2D*>(::glMapBufferRange(GL_ARRAY_BUFFER, 0, VertexBufferBytes, MapFlags));
+			}
+
+			detail::SetVertex2DAttributes();
+
+			{
+				::glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_streamIndexBuffer);
+				::glBufferStorage(GL_ELEMENT_ARRAY_BUFFER, IndexBufferBytes, nullptr, StorageFlags);
+				m_streamIndices = static_cast<Vertex2D::IndexType*>(::glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, IndexBufferBytes, MapFlags));
+			}
+		}
+		::glBindVertexArray(0);
+
+		if ((not m_streamVertices) || (not m_streamIndices))
+		{
+			releaseStreamBuffers();
+			return false;
+		}
+
+		return true;
+	}
+
+	void GL4Vertex2DBatch::releaseStreamBuffers()
+	{
+		for (auto& fence : m_streamFences)
+		{
+			if (fence)
+			{
+				::glDeleteSync(fence);
+				fence = nullptr;
+			}
+		}
+
+		if (m_streamIndexBuffer)
+		{
+			if (m_streamIndices)
+			{
+				::glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_streamIndexBuffer);
+				::glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+				m_streamIndices = nullptr;
+			}
+
+			::glDeleteBuffers(1, &m_streamIndexBuffer);
+			m_streamIndexBuffer = 0;
+		}
+
+		if (m_streamVertexBuffer)
+		{
+			if (m_streamVertices)
+			{
+				::glBindBuffer(GL_ARRAY_BUFFER, m_streamVertexBuffer);
+				::glUnmapBuffer(GL_ARRAY_BUFFER);
+				m_streamVertices = nullptr;
+			}
+
+			::glDeleteBuffers(1, &m_streamVertexBuffer);
+			m_streamVertexBuffer = 0;
+		}
+
+		if (m_streamVAO)
+		{
+			::glDeleteVertexArrays(1, &m_streamVAO);
+			m_streamVAO = 0;
+		}
+	}
+
+	bool GL4Vertex2DBatch::isStreaming() const noexcept
+	{
+		return (m_streamVertices != nullptr);
+	}
+
+	BatchInfo2D GL4Vertex2DBatch::streamBatch(const BatchBufferPos& batch)
+	{
+		const uint16 vertexSize = batch.vertexPos;
+		const uint32 indexSize = batch.indexPos;
+
+		if ((vertexSize == 0) && (indexSize == 0))
+		{
+			return{};
+		}
+
+		if ((StreamRegionVertexCount < (m_streamVertexWritePos + vertexSize))
+			|| (StreamRegionIndexCount < (m_streamIndexWritePos + indexSize)))
+		{
+			// 現在の区間を読む描画はすべて発行済みなので、フェンスを置いて次の区間へ進む
+			if (m_streamFencePending)
+			{
+				fenceStreamRegion();
+			}
+
+			m_streamRegion = ((m_streamRegion + 1) % NumStreamRegions);
+			m_streamVertexWritePos = 0;
+			m_streamIndexWritePos = 0;
+
+			// 一周して、GPU がまだ読んでいるかもしれない区間に戻ってきたときだけ待つ
+			detail::WaitFence(m_streamFences[m_streamRegion]);
+		}
+
+		const uint32 vertexBase = ((StreamRegionVertexCount * m_streamRegion) + m_streamVertexWritePos);
+		const uint32 indexBase = ((StreamRegionIndexCount * m_streamRegion) + m_streamIndexWritePos);
+
+		std::memcpy((m_streamVertices + vertexBase), &m_vertexArray[batch.vertexBase], (sizeof(Vertex2D) * vertexSize));
+		std::memcpy((m_streamIndices + indexBase), &m_indexArray[batch.indexBase], (sizeof(Vertex2D::IndexType) * indexSize));
+
+		::glFlushMappedBufferRange(GL_ARRAY_BUFFER, (sizeof(Vertex2D) * vertexBase), (sizeof(Vertex2D) * vertexSize));
+		::glFlushMappedBufferRange(GL_ELEMENT_ARRAY_BUFFER, (sizeof(Vertex2D::IndexType) * indexBase), (sizeof(Vertex2D::IndexType) * indexSize));
+
+		m_streamVertexWritePos += vertexSize;
+		m_streamIndexWritePos += indexSize;
+		m_streamFencePending = true;
+
+		return{ indexSize, indexBase, vertexBase };
+	}
+
+	void GL4Vertex2DBatch::fenceStreamRegion()
+	{
+		// 前の flush で置いたフェンスは、新しいフェンスが通過すれば不要になる
+		GLsync& fence = m_streamFences[m_streamRegion];
+
+		if (fence)
+		{
+			::glDeleteSync(fence);
+		}
+
+		fence = ::glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		m_streamFencePending = false;
+	}
+
 	void GL4Vertex2DBatch::advanceArrayWritePos(const uint16 vertexSize, const uint32 indexSize) noexcept
 	{
 		m_vertexArrayWritePos	+= vertexSize;
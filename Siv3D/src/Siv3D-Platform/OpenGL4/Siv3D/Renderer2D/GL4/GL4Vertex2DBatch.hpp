@@ -30,6 +30,11 @@ namespace s3d
 
 			uint32 indexPos = 0;
 
+			// バッチの先頭の頂点とインデックスの配列内の位置
+			uint32 vertexBase = 0;
+
+			uint32 indexBase = 0;
+
 			void advance(uint16 vertexSize, uint32 indexSize) noexcept
 			{
 				vertexPos += vertexSize;
@@ -53,6 +58,8 @@ namespace s3d
 
 		Array<BatchBufferPos> m_batches;
 
+		Array<Vertex2D::IndexType> m_reorderBuffer;
+
 		static constexpr uint32 InitialVertexArraySize	= 4096;
 		static constexpr uint32 InitialIndexArraySize	= (4096 * 8); // 32,768
 
@@ -62,6 +69,41 @@ namespace s3d
 		static constexpr uint32 VertexBufferSize		= 65535;// 65,535;
 		static constexpr uint32 IndexBufferSize			= ((VertexBufferSize + 1) * 4); // 524,288
 
+		// streaming
+		static constexpr uint32 NumStreamRegions			= 4;
+		static constexpr uint32 StreamRegionVertexCount		= (VertexBufferSize * 2); // 131,070
+		static constexpr uint32 StreamRegionIndexCount		= (IndexBufferSize * 2); // 1,048,576
+
+		GLuint m_streamVAO = 0;
+
+		GLuint m_streamVertexBuffer = 0;
+		Vertex2D* m_streamVertices = nullptr;
+		uint32 m_streamVertexWritePos = 0;
+
+		GLuint m_streamIndexBuffer = 0;
+		Vertex2D::IndexType* m_streamIndices = nullptr;
+		uint32 m_streamIndexWritePos = 0;
+
+		// 区間ごとに、その区間を読む最後の描画の後に置いたフェンス
+		std::array<GLsync, NumStreamRegions> m_streamFences{};
+		uint32 m_streamRegion = 0;
+
+		// 現在の区間に、まだフェンスを置いていない書き込みがある
+		bool m_streamFencePending = false;
+
+		[[nodiscard]]
+		bool initStreamBuffers();
+
+		void releaseStreamBuffers();
+
+		[[nodiscard]]
+		bool isStreaming() const noexcept;
+
+		[[nodiscard]]
+		BatchInfo2D streamBatch(const BatchBufferPos& batch);
+
+		void fenceStreamRegion();
+
 		void advanceArrayWritePos(uint16 vertexSize, uint32 indexSize) noexcept;
 
 	public:
@@ -85,5 +127,12 @@ namespace s3d
 
 		[[nodiscard]]
 		BatchInfo2D updateBuffers(size_t batchIndex);
+
+		// batchIndex 番目のバッチの [indexOffset, indexOffset + indexCount) のインデックスが参照する頂点を囲む長方形を返す
+		[[nodiscard]]
+		FloatRect getBounds(size_t batchIndex, uint32 indexOffset, uint32 indexCount) const;
+
+		// batchIndex 番目のバッチの indexOffset から始まるインデックスを、ranges (オフセット, 個数) の順に並べ替える
+		void reorderIndices(size_t batchIndex, uint32 indexOffset, const Array<std::pair<uint32, uint32>>& ranges);
 	};
 }
@@ -11,7 +11,7 @@
 
 # include "CTexture_GL4.hpp"
 # include <Siv3D/Error.hpp>
-# include <Siv3D/System.hpp>
+# include <Siv3D/Time.hpp>
 # include <Siv3D/EngineLog.hpp>
 # include <Siv3D/Texture/TextureCommon.hpp>
 
@@ -26,6 +26,12 @@ namespace s3d
 	{
 		LOG_SCOPED_TRACE(U"CTexture_GL4::~CTexture_GL4()");
 
+		if (m_pixelBufferPool)
+		{
+			::glDeleteBuffers(static_cast<GLsizei>(m_pixelBufferPool.size()), m_pixelBufferPool.data());
+			m_pixelBufferPool.clear();
+		}
+
 		m_textures.destroy();
 	}
 
@@ -52,49 +58,122 @@ namespace s3d
 		}
 	}
 
-	void CTexture_GL4::updateAsyncTextureLoad(const size_t maxUpdate)
+	void CTexture_GL4::updateAsyncTextureLoad(const uint64 budgetMicrosec)
 	{
 		if (not isMainThread())
 		{
 			return;
 		}
 
-		// 終了時は即座に全消去
-		if (maxUpdate == Largest<size_t>)
+		const uint64 startTimeMicrosec = Time::GetMicrosec();
+		const auto hasTime = [&]() { return ((Time::GetMicrosec() - startTimeMicrosec) < budgetMicrosec); };
+
+		m_asyncStat.completedLastUpdate = 0;
+		m_asyncStat.maxLatencyMicrosec = 0;
+
+		// 画像のコピーが終わったものからテクスチャを作成する
+		for (auto it = m_uploads.begin(); it != m_uploads.end();)
 		{
-			std::lock_guard lock{ m_requestsMutex };
+			if (not it->pRequest->copied.load(std::memory_order_acquire))
+			{
+				++it;
+				continue;
+			}
+
+			finishUpload(*it);
+			m_uploadBytesInFlight -= it->bufferSize;
+			it = m_uploads.erase(it);
 
-			for (auto& request : m_requests)
+			if (not hasTime())
 			{
-				request.waiting.get() = false;
+				break;
 			}
+		}
 
-			m_requests.clear();
+		// 新しい要求にピクセルバッファを割り当てる。時間が無くても 1 つは進める
+		// マップ中のピクセルバッファの数と合計サイズが上限に達したら、コピーが終わるまで待つ
+		size_t pendingCount = 0;
+		{
+			bool first = true;
 
-			return;
+			while ((first || hasTime())
+				&& (m_uploads.size() < MaxUploadsInFlight))
+			{
+				first = false;
+
+				Request* pRequest = nullptr;
+				{
+					std::lock_guard lock{ m_requestsMutex };
+
+					if (m_requests.isEmpty())
+					{
+						break;
+					}
+
+					if (m_uploads
+						&& (MaxUploadBytesInFlight < (m_uploadBytesInFlight + GetUploadSize(*m_requests.front()))))
+					{
+						break;
+					}
+
+					pRequest = m_requests.front();
+					m_requests.pop_front();
+				}
+
+				beginUpload(*pRequest);
+			}
+
+			std::lock_guard lock{ m_requestsMutex };
+			pendingCount = m_requests.size();
 		}
 
-		std::lock_guard lock{ m_requestsMutex };
+		m_asyncStat.queueDepth = static_cast<uint32>(pendingCount + m_uploads.size());
+	}
 
-		const size_t loadCount = Min(maxUpdate, m_requests.size());
+	void CTexture_GL4::cancelAsyncTextureLoad()
+	{
+		if (not isMainThread())
+		{
+			return;
+		}
 
-		for (size_t i = 0; i < loadCount; ++i)
 		{
-			auto& request = m_requests[i];
+			std::lock_guard lock{ m_requestsMutex };
 
-			if (*request.pMipmaps)
+			for (auto& pRequest : m_requests)
 			{
-				request.idResult.get() = createMipped(*request.pImage, *request.pMipmaps, *request.pDesc);
+				pRequest->mapped.set_value(nullptr);
+				pRequest->result.set_value(Texture::IDType::NullAsset());
 			}
-			else
+
+			m_requests.clear();
+		}
+
+		for (const auto& upload : m_uploads)
+		{
+			// マップしたバッファへのコピーが終わるまでは解放できない
+			while (not upload.pRequest->copied.load(std::memory_order_acquire))
 			{
-				request.idResult.get() = createUnmipped(*request.pImage, *request.pDesc);
+				std::this_thread::yield();
 			}
 
-			request.waiting.get() = false;
+			::glBindBuffer(GL_PIXEL_UNPACK_BUFFER, upload.pixelBuffer);
+			::glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+			::glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+			releasePixelBuffer(upload.pixelBuffer);
+
+			upload.pRequest->result.set_value(Texture::IDType::NullAsset());
 		}
 
-		m_requests.pop_front_N(loadCount);
+		m_uploads.clear();
+		m_uploadBytesInFlight = 0;
+
+		m_asyncStat.queueDepth = 0;
+	}
+
+	AsyncTextureLoadStat CTexture_GL4::getAsyncTextureLoadStat() const
+	{
+		return m_asyncStat;
 	}
 
 	size_t CTexture_GL4::getTextureCount() const
@@ -390,21 +469,140 @@ namespace s3d
 
 	Texture::IDType CTexture_GL4::pushRequest(const Image& image, const Array<Image>& mipmaps, const TextureDesc desc)
 	{
-		std::atomic<bool> waiting = true;
+		Request request;
+		request.pImage	= &image;
+		request.pMipmaps	= &mipmaps;
+		request.desc	= desc;
+		request.requestedTimeMicrosec = Time::GetMicrosec();
 
-		Texture::IDType result = Texture::IDType::NullAsset();
+		std::future<void*> mapped = request.mapped.get_future();
+		std::future<Texture::IDType> result = request.result.get_future();
 		{
 			std::lock_guard lock{ m_requestsMutex };
 
-			m_requests.push_back(Request{ &image, &mipmaps, &desc, std::ref(result), std::ref(waiting) });
+			m_requests.push_back(&request);
 		}
 
-		// [Siv3D ToDo] conditional_variable を使う
-		while (waiting)
+		// メインスレッドがマップしたピクセルバッファに、このスレッドで画像をコピーする
+		if (Byte* pDst = static_cast<Byte*>(mapped.get()))
 		{
-			System::Sleep(3);
+			std::memcpy(pDst, image.data(), image.size_bytes());
+			pDst += image.size_bytes();
+
+			for (const auto& mipmap : mipmaps)
+			{
+				std::memcpy(pDst, mipmap.data(), mipmap.size_bytes());
+				pDst += mipmap.size_bytes();
+			}
+
+			request.copied.store(true, std::memory_order_release);
 		}
 
-		return result;
+		return result.get();
+	}
+
+	size_t CTexture_GL4::GetUploadSize(const Request& request) noexcept
+	{
+		size_t bufferSize = request.pImage->size_bytes();
+
+		for (const auto& mipmap : *request.pMipmaps)
+		{
+			bufferSize += mipmap.size_bytes();
+		}
+
+		return bufferSize;
+	}
+
+	void CTexture_GL4::beginUpload(Request& request)
+	{
+		const size_t bufferSize = GetUploadSize(request);
+
+		// サイズ 0 のバッファはマップできない
+		if (bufferSize == 0)
+		{
+			request.mapped.set_value(nullptr);
+			request.result.set_value(Texture::IDType::NullAsset());
+			return;
+		}
+
+		const GLuint pixelBuffer = acquirePixelBuffer();
+		::glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer);
+		::glBufferData(GL_PIXEL_UNPACK_BUFFER, bufferSize, nullptr, GL_STREAM_DRAW);
+		void* const pMapped = ::glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, bufferSize, (GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+		::glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+		if (not pMapped)
+		{
+			LOG_FAIL(U"❌ CTexture_GL4::beginUpload(): glMapBufferRange() failed");
+			releasePixelBuffer(pixelBuffer);
+			request.mapped.set_value(nullptr);
+			request.result.set_value(Texture::IDType::NullAsset());
+			return;
+		}
+
+		m_uploads.push_back({ &request, pixelBuffer, bufferSize });
+		m_uploadBytesInFlight += bufferSize;
+
+		request.mapped.set_value(pMapped);
+	}
+
+	void CTexture_GL4::finishUpload(const Upload& upload)
+	{
+		Request& request = *upload.pRequest;
+		const Image& image = *request.pImage;
+		const Array<Size> mipSizes = request.pMipmaps->map([](const Image& mipmap) { return mipmap.size(); });
+
+		::glBindBuffer(GL_PIXEL_UNPACK_BUFFER, upload.pixelBuffer);
+		::glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+		auto texture = std::make_unique<GL4Texture>(GL4Texture::PixelBuffer{}, image.size(), mipSizes, request.desc);
+
+		::glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		releasePixelBuffer(upload.pixelBuffer);
+
+		Texture::IDType id = Texture::IDType::NullAsset();
+
+		if (texture->isInitialized())
+		{
+			const String info = U"(type: Default, size: {0}x{1}, format: {2})"_fmt(image.width(), image.height(), texture->getFormat().name());
+			id = m_textures.add(std::move(texture), info);
+		}
+
+		const uint64 latencyMicrosec = (Time::GetMicrosec() - request.requestedTimeMicrosec);
+		++m_asyncStat.completedLastUpdate;
+		++m_asyncStat.totalCompleted;
+		m_asyncStat.maxLatencyMicrosec = Max(m_asyncStat.maxLatencyMicrosec, latencyMicrosec);
+		m_totalLatencyMicrosec += latencyMicrosec;
+		m_asyncStat.averageLatencyMicrosec = (m_totalLatencyMicrosec / m_asyncStat.totalCompleted);
+
+		// これ以降、request は要求したスレッドによって破棄されうる
+		request.result.set_value(id);
+	}
+
+	GLuint CTexture_GL4::acquirePixelBuffer()
+	{
+		if (m_pixelBufferPool)
+		{
+			const GLuint pixelBuffer = m_pixelBufferPool.back();
+			m_pixelBufferPool.pop_back();
+			return pixelBuffer;
+		}
+
+		GLuint pixelBuffer = 0;
+		::glGenBuffers(1, &pixelBuffer);
+		return pixelBuffer;
+	}
+
+	void CTexture_GL4::releasePixelBuffer(const GLuint pixelBuffer)
+	{
+		if (m_pixelBufferPool.size() < MaxPooledPixelBuffers)
+		{
+			// 次の glBufferData() でデータ領域は確保し直される
+			m_pixelBufferPool.push_back(pixelBuffer);
+		}
+		else
+		{
+			::glDeleteBuffers(1, &pixelBuffer);
+		}
 	}
 }
@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # pragma once
+# include <future>
 # include <Siv3D/Common.hpp>
 # include <Siv3D/Texture/ITexture.hpp>
 # include <Siv3D/AssetHandleManager/AssetHandleManager.hpp>
@@ -27,7 +28,11 @@ namespace s3d
 
 		void init();
 
-		void updateAsyncTextureLoad(size_t maxUpdate) override;
+		void updateAsyncTextureLoad(uint64 budgetMicrosec) override;
+
+		void cancelAsyncTextureLoad() override;
+
+		AsyncTextureLoadStat getAsyncTextureLoadStat() const override;
 
 		size_t getTextureCount() const override;
 
@@ -98,22 +103,65 @@ namespace s3d
 
 		/////////////////////////////////
 		//
-		std::mutex m_requestsMutex;
-
+		// 別スレッドからのテクスチャ作成要求
+		//
+		// 1. 要求したスレッドが Request をキューに追加し、mapped を待つ
+		// 2. メインスレッドがピクセルバッファを確保してマップし、そのポインタを mapped で渡す
+		// 3. 要求したスレッドが画像をピクセルバッファにコピーし、copied を立てて result を待つ
+		// 4. メインスレッドがピクセルバッファからテクスチャを作成し、result で ID を返す
+		//
 		struct Request
 		{
 			const Image* pImage = nullptr;
 
 			const Array<Image>* pMipmaps = nullptr;
 
-			const TextureDesc* pDesc = nullptr;
+			TextureDesc desc = TextureDesc::Unmipped;
+
+			uint64 requestedTimeMicrosec = 0;
+
+			// マップしたピクセルバッファ。確保できなかった場合や取り消された場合は nullptr
+			std::promise<void*> mapped;
 
-			std::reference_wrapper<Texture::IDType> idResult;
+			std::atomic<bool> copied = false;
 
-			std::reference_wrapper<std::atomic<bool>> waiting;
+			std::promise<Texture::IDType> result;
 		};
 
-		Array<Request> m_requests;
+		struct Upload
+		{
+			Request* pRequest = nullptr;
+
+			GLuint pixelBuffer = 0;
+
+			size_t bufferSize = 0;
+		};
+
+		// 同時にマップしておくピクセルバッファの最大数
+		static constexpr size_t MaxUploadsInFlight = 8;
+
+		// 同時にマップしておくピクセルバッファの合計サイズの上限（1 つ目の要求は上限を超えても進める）
+		static constexpr size_t MaxUploadBytesInFlight = (64 << 20);
+
+		// 再利用のために保持しておくピクセルバッファの最大数
+		static constexpr size_t MaxPooledPixelBuffers = 4;
+
+		std::mutex m_requestsMutex;
+
+		Array<Request*> m_requests;
+
+		// メインスレッドからのみアクセスする
+		Array<Upload> m_uploads;
+
+		// メインスレッドからのみアクセスする
+		size_t m_uploadBytesInFlight = 0;
+
+		// メインスレッドからのみアクセスする
+		Array<GLuint> m_pixelBufferPool;
+
+		AsyncTextureLoadStat m_asyncStat;
+
+		uint64 m_totalLatencyMicrosec = 0;
 		//
 		/////////////////////////////////
 
@@ -121,5 +169,17 @@ namespace s3d
 		bool isMainThread() const noexcept;
 
 		Texture::IDType pushRequest(const Image& image, const Array<Image>& mipmaps, TextureDesc desc);
+
+		[[nodiscard]]
+		static size_t GetUploadSize(const Request& request) noexcept;
+
+		void beginUpload(Request& request);
+
+		void finishUpload(const Upload& upload);
+
+		[[nodiscard]]
+		GLuint acquirePixelBuffer();
+
+		void releasePixelBuffer(GLuint pixelBuffer);
 	};
 }
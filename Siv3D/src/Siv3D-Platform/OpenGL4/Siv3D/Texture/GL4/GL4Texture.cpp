@@ -67,6 +67,40 @@ namespace s3d
 		m_initialized	= true;
 	}
 
+	GL4Texture::GL4Texture(PixelBuffer, const Size& size, const Array<Size>& mipSizes, const TextureDesc desc)
+	{
+		const TextureFormat format =
+			detail::IsSRGB(desc) ? TextureFormat::R8G8B8A8_Unorm_SRGB : TextureFormat::R8G8B8A8_Unorm;
+
+		// [メインテクスチャ] を作成
+		{
+			::glGenTextures(1, &m_texture);
+			::glBindTexture(GL_TEXTURE_2D, m_texture);
+
+			// データのポインタは、バインドされたバッファ先頭からのオフセットとして扱われる
+			size_t offset = 0;
+			::glTexImage2D(GL_TEXTURE_2D, 0, format.GLInternalFormat(), size.x, size.y, 0,
+						   format.GLFormat(), format.GLType(), reinterpret_cast<const void*>(offset));
+			offset += (sizeof(Color) * size.x * size.y);
+
+			for (uint32 i = 0; i < mipSizes.size(); ++i)
+			{
+				const Size& mipSize = mipSizes[i];
+
+				::glTexImage2D(GL_TEXTURE_2D, (i + 1), format.GLInternalFormat(), mipSize.x, mipSize.y, 0,
+							   format.GLFormat(), format.GLType(), reinterpret_cast<const void*>(offset));
+				offset += (sizeof(Color) * mipSize.x * mipSize.y);
+			}
+			::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(mipSizes.size()));
+		}
+
+		m_size			= size;
+		m_format		= format;
+		m_textureDesc	= desc;
+		m_type			= (mipSizes ? TextureType::Dynamic : TextureType::Default);
+		m_initialized	= true;
+	}
+
 	GL4Texture::GL4Texture(Dynamic, const Size& size, const void* pData, const uint32, const TextureFormat& format, const TextureDesc desc)
 		: m_size{ size }
 		, m_format{ format }
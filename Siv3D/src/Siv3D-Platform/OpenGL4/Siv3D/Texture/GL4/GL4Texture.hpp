@@ -25,6 +25,7 @@ namespace s3d
 		struct Dynamic {};
 		struct Render {};
 		struct MSRender {};
+		struct PixelBuffer {};
 
 		SIV3D_NODISCARD_CXX20
 		GL4Texture(const Image& image, TextureDesc desc);
@@ -32,6 +33,13 @@ namespace s3d
 		SIV3D_NODISCARD_CXX20
 		GL4Texture(const Image& image, const Array<Image>& mips, TextureDesc desc);
 
+		/// @brief GL_PIXEL_UNPACK_BUFFER にバインドされたバッファから、ミップマップを含むテクスチャを作成します。
+		/// @param size テクスチャの大きさ
+		/// @param mipSizes ミップマップ画像の大きさ。バッファには各レベルの画像が隙間なく順に並んでいる必要があります。
+		/// @param desc テクスチャの設定
+		SIV3D_NODISCARD_CXX20
+		GL4Texture(PixelBuffer, const Size& size, const Array<Size>& mipSizes, TextureDesc desc);
+
 		SIV3D_NODISCARD_CXX20
 		GL4Texture(Dynamic, const Size& size, const void* pData, uint32 stride, const TextureFormat& format, TextureDesc desc);
 
@@ -16,6 +16,7 @@
 # include <Siv3D/ScopeGuard.hpp>
 # include <Siv3D/Mat3x2.hpp>
 # include <Siv3D/ShaderCommon.hpp>
+# include <Siv3D/ProfilerZone.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 # include <Siv3D/Renderer/GLES3/CRenderer_GLES3.hpp>
 # include <Siv3D/Shader/GLES3/CShader_GLES3.hpp>
@@ -106,10 +107,7 @@ namespace s3d
 		}
 
 		// バッファ作成関数を作成
-		m_bufferCreator = [this](Vertex2D::IndexType vertexSize, Vertex2D::IndexType indexSize)
-		{
-			return m_batches[m_drawCount % 2].requestBuffer(vertexSize, indexSize, m_commandManager);
-		};
+		m_bufferCreator = BufferCreatorFunc::Bind<&CRenderer2D_GLES3::requestBuffer>(this);
 
 		// シャドウ画像を作成
 		{
@@ -669,25 +667,57 @@ namespace s3d
 		}
 	}
 
-	void CRenderer2D_GLES3::addTexturedParticles(const Texture& texture, const Array<Particle2D>& particles,
+	void CRenderer2D_GLES3::addTexturedParticles(const Texture& texture, const ParticleStorage2D& particles,
 		ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc,
 		ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc)
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildTexturedParticles(m_bufferCreator, particles, sizeOverLifeTimeFunc, colorOverLifeTimeFunc))
+		for (size_t offset = 0; offset < particles.size(); offset += Vertex2DBuilder::MaxTexturedParticles)
 		{
-			if (not m_currentCustomVS)
+			const size_t n = Min((particles.size() - offset), Vertex2DBuilder::MaxTexturedParticles);
+
+			if (const auto indexCount = Vertex2DBuilder::BuildTexturedParticles(m_bufferCreator, particles, offset, n, sizeOverLifeTimeFunc, colorOverLifeTimeFunc))
 			{
-				m_commandManager.pushStandardVS(m_standardVS->spriteID);
+				if (not m_currentCustomVS)
+				{
+					m_commandManager.pushStandardVS(m_standardVS->spriteID);
+				}
+
+				if (not m_currentCustomPS)
+				{
+					m_commandManager.pushStandardPS(m_standardPS->textureID);
+				}
+
+				m_commandManager.pushPSTexture(0, texture);
+				m_commandManager.pushDraw(indexCount);
 			}
+		}
+	}
 
-			if (not m_currentCustomPS)
+	void CRenderer2D_GLES3::addTexturedInstances(const Texture& texture, const SpriteInstance* instances, const size_t count)
+	{
+		// インスタンス描画には未対応のため、CPU で頂点に展開する
+		for (size_t offset = 0; offset < count; offset += Vertex2DBuilder::MaxTexturedInstances)
+		{
+			const size_t n = Min((count - offset), Vertex2DBuilder::MaxTexturedInstances);
+
+			if (const auto indexCount = Vertex2DBuilder::BuildTexturedInstances(m_bufferCreator, (instances + offset), n))
 			{
-				m_commandManager.pushStandardPS(m_standardPS->textureID);
-			}
+				if (not m_currentCustomVS)
+				{
+					m_commandManager.pushStandardVS(m_standardVS->spriteID);
+				}
 
-			m_commandManager.pushPSTexture(0, texture);
-			m_commandManager.pushDraw(indexCount);
+				if (not m_currentCustomPS)
+				{
+					m_commandManager.pushStandardPS(m_standardPS->textureID);
+				}
+
+				m_commandManager.pushPSTexture(0, texture);
+				m_commandManager.pushDraw(indexCount);
+			}
 		}
+
+		m_stat.instanceCount += static_cast<uint32>(count);
 	}
 
 	Float4 CRenderer2D_GLES3::getColorMul() const
@@ -924,6 +954,16 @@ namespace s3d
 		m_commandManager.pushConstantBuffer(stage, slot, buffer, data, num_vectors);
 	}
 
+	void CRenderer2D_GLES3::beginBatchReorder()
+	{
+		m_commandManager.beginReorder();
+	}
+
+	void CRenderer2D_GLES3::endBatchReorder()
+	{
+		m_commandManager.endReorder(m_batches[m_drawCount % 2]);
+	}
+
 	const Texture& CRenderer2D_GLES3::getBoxShadowTexture() const noexcept
 	{
 		return *m_boxShadowTexture;
@@ -931,6 +971,8 @@ namespace s3d
 
 	void CRenderer2D_GLES3::flush()
 	{
+		SIV3D_PROFILE_ZONE(U"Renderer2D::flush");
+
 		GLES3Vertex2DBatch& batch = m_batches[m_drawCount % 2];
 
 		ScopeGuard cleanUp = [this, &batch]()
@@ -941,7 +983,9 @@ namespace s3d
 			m_currentCustomPS.reset();
 		};
 
+		m_commandManager.finishReorder(batch);
 		m_commandManager.flush();
+		m_stat.savedDrawCalls += m_commandManager.getSavedDrawCalls();
 
 		pShader->usePipeline();
 
@@ -993,12 +1037,11 @@ namespace s3d
 
 					const GLES3DrawCommand& draw = m_commandManager.getDraw(command.index);
 					const uint32 indexCount = draw.indexCount;
-					const uint32 startIndexLocation = batchInfo.startIndexLocation;
+					const uint32 startIndexLocation = (batchInfo.startIndexLocation + draw.indexOffset);
 					// const uint32 baseVertexLocation = batchInfo.baseVertexLocation;
 					constexpr Vertex2D::IndexType* pBase = 0;
 
 					::glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, (pBase + startIndexLocation));
-					batchInfo.startIndexLocation += indexCount;
 
 					++m_stat.drawCalls;
 					m_stat.triangleCount += (indexCount / 3);
@@ -1341,4 +1384,9 @@ namespace s3d
 
 		CheckOpenGLError();
 	}
+
+	Vertex2DBufferPointer CRenderer2D_GLES3::requestBuffer(const Vertex2D::IndexType vertexSize, const Vertex2D::IndexType indexSize)
+	{
+		return m_batches[m_drawCount % 2].requestBuffer(vertexSize, indexSize, m_commandManager);
+	}
 }
@@ -115,6 +115,9 @@ namespace s3d
 
 		Renderer2DStat m_stat;
 
+		[[nodiscard]]
+		Vertex2DBufferPointer requestBuffer(Vertex2D::IndexType vertexSize, Vertex2D::IndexType indexSize);
+
 	public:
 
 		CRenderer2D_GLES3();
@@ -183,10 +186,12 @@ namespace s3d
 
 		void addTexturedVertices(const Texture& texture, const Vertex2D* vertices, size_t vertexCount, const TriangleIndex* indices, size_t num_triangles) override;
 
-		void addTexturedParticles(const Texture& texture, const Array<Particle2D>& particles,
+		void addTexturedParticles(const Texture& texture, const ParticleStorage2D& particles,
 			ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc,
 			ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc) override;
 
+		void addTexturedInstances(const Texture& texture, const SpriteInstance* instances, size_t count) override;
+
 
 		Float4 getColorMul() const override;
 
@@ -255,6 +260,10 @@ namespace s3d
 
 		void setConstantBuffer(ShaderStage stage, uint32 slot, const ConstantBufferBase& buffer, const float* data, uint32 num_vectors) override;
 
+		void beginBatchReorder() override;
+
+		void endBatchReorder() override;
+
 		const Texture& getBoxShadowTexture() const noexcept override;
 
 		void flush() override;
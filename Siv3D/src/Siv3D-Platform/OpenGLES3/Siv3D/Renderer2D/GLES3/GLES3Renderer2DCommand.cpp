@@ -10,9 +10,46 @@
 //-----------------------------------------------
 
 # include "GLES3Renderer2DCommand.hpp"
+# include "GLES3Vertex2DBatch.hpp"
 
 namespace s3d
 {
+	namespace detail
+	{
+		enum class ReorderCommandKind : uint8
+		{
+			Ignore,
+
+			Draw,
+
+			State,
+
+			Barrier,
+		};
+
+		[[nodiscard]]
+		static constexpr ReorderCommandKind GetReorderCommandKind(const GLES3Renderer2DCommandType type) noexcept
+		{
+			switch (type)
+			{
+			case GLES3Renderer2DCommandType::Null:
+				return ReorderCommandKind::Ignore;
+			case GLES3Renderer2DCommandType::Draw:
+				return ReorderCommandKind::Draw;
+			// 頂点バッファや描画先を切り替えるコマンドと、頂点バッファを使わない描画は、前後の描画と順序を入れ替えない
+			case GLES3Renderer2DCommandType::SetBuffers:
+			case GLES3Renderer2DCommandType::UpdateBuffers:
+			case GLES3Renderer2DCommandType::DrawNull:
+			case GLES3Renderer2DCommandType::Viewport:
+			case GLES3Renderer2DCommandType::SetRT:
+			case GLES3Renderer2DCommandType::SetConstantBuffer:
+				return ReorderCommandKind::Barrier;
+			default:
+				return ReorderCommandKind::State;
+			}
+		}
+	}
+
 	GLES3Renderer2DCommandManager::GLES3Renderer2DCommandManager()
 	{
 		m_vsSamplerStates.fill(Array<SamplerState>{ SamplerState::Default2D });
@@ -155,6 +192,12 @@ namespace s3d
 				m_currentPSTextures.fill(Texture::IDType::InvalidValue());
 			}
 		}
+
+		m_batchIndexCount = 0;
+		m_savedDrawCalls = 0;
+
+		// 並べ替えのスコープがフレームをまたぐ場合、新しいフレームの先頭から並べ替えを続ける
+		m_reorderCommandBegin = m_commands.size();
 	}
 
 	void GLES3Renderer2DCommandManager::flush()
@@ -306,6 +349,7 @@ namespace s3d
 		flush();
 
 		m_commands.emplace_back(GLES3Renderer2DCommandType::UpdateBuffers, batchIndex);
+		m_batchIndexCount = 0;
 	}
 
 	void GLES3Renderer2DCommandManager::pushDraw(const Vertex2D::IndexType indexCount)
@@ -315,7 +359,13 @@ namespace s3d
 			flush();
 		}
 
+		if (m_currentDraw.indexCount == 0)
+		{
+			m_currentDraw.indexOffset = m_batchIndexCount;
+		}
+
 		m_currentDraw.indexCount += indexCount;
+		m_batchIndexCount += indexCount;
 	}
 
 	const GLES3DrawCommand& GLES3Renderer2DCommandManager::getDraw(const uint32 index) const noexcept
@@ -1185,4 +1235,258 @@ namespace s3d
 	{
 		return m_currentRT;
 	}
+
+	void GLES3Renderer2DCommandManager::beginReorder()
+	{
+		if (m_reorderDepth++ == 0)
+		{
+			flush();
+
+			m_reorderCommandBegin = m_commands.size();
+		}
+	}
+
+	void GLES3Renderer2DCommandManager::endReorder(GLES3Vertex2DBatch& batches)
+	{
+		if (m_reorderDepth == 0)
+		{
+			return;
+		}
+
+		if (--m_reorderDepth == 0)
+		{
+			reorderCommands(batches);
+		}
+	}
+
+	void GLES3Renderer2DCommandManager::finishReorder(GLES3Vertex2DBatch& batches)
+	{
+		if (m_reorderDepth)
+		{
+			reorderCommands(batches);
+		}
+	}
+
+	uint32 GLES3Renderer2DCommandManager::getSavedDrawCalls() const noexcept
+	{
+		return m_savedDrawCalls;
+	}
+
+	void GLES3Renderer2DCommandManager::reorderCommands(GLES3Vertex2DBatch& batches)
+	{
+		flush();
+
+		if (m_commands.size() <= m_reorderCommandBegin)
+		{
+			return;
+		}
+
+		// 並べ替える範囲の直前のステートと頂点バッファを求める
+		StateIndices state{};
+		uint32 batchIndex = 0;
+
+		for (size_t i = 0; i < m_reorderCommandBegin; ++i)
+		{
+			const auto& command = m_commands[i];
+
+			if (command.type == GLES3Renderer2DCommandType::UpdateBuffers)
+			{
+				batchIndex = command.index;
+			}
+			else if (detail::GetReorderCommandKind(command.type) == detail::ReorderCommandKind::State)
+			{
+				state[FromEnum(command.type)] = command.index;
+			}
+		}
+
+		const Array<GLES3Renderer2DCommand> commands(m_commands.begin() + m_reorderCommandBegin, m_commands.end());
+		m_commands.resize(m_reorderCommandBegin);
+
+		StateIndices emitted = state;
+		m_reorder.clear();
+		m_reorderStates.clear();
+
+		for (const auto& command : commands)
+		{
+			switch (detail::GetReorderCommandKind(command.type))
+			{
+			case detail::ReorderCommandKind::Draw:
+				{
+					const auto& draw = m_draws[command.index];
+					m_reorder.add(draw.indexOffset, draw.indexCount, static_cast<uint32>(m_reorderStates.size()), getReorderBounds(batches, batchIndex, draw, state));
+					m_reorderStates.push_back(state);
+				}
+				break;
+			case detail::ReorderCommandKind::State:
+				state[FromEnum(command.type)] = command.index;
+				break;
+			case detail::ReorderCommandKind::Barrier:
+				emitReorderedDraws(batches, batchIndex, emitted);
+				emitStateChanges(emitted, state);
+				m_commands.push_back(command);
+
+				if (command.type == GLES3Renderer2DCommandType::UpdateBuffers)
+				{
+					batchIndex = command.index;
+				}
+				break;
+			default:
+				break;
+			}
+		}
+
+		emitReorderedDraws(batches, batchIndex, emitted);
+		emitStateChanges(emitted, state);
+
+		m_reorderCommandBegin = m_commands.size();
+	}
+
+	FloatRect GLES3Renderer2DCommandManager::getReorderBounds(const GLES3Vertex2DBatch& batches, const uint32 batchIndex, const GLES3DrawCommand& draw, const StateIndices& states) const
+	{
+		// カスタム頂点シェーダが頂点をどこへ動かすかはわからないため、すべての描画と重なるものとして扱う
+		if (m_reservedVSs.contains(m_VSs[states[FromEnum(GLES3Renderer2DCommandType::SetVS)]]))
+		{
+			return Renderer2DBatchReorder::InfiniteBounds;
+		}
+
+		const FloatRect bounds = batches.getBounds(batchIndex, draw.indexOffset, draw.indexCount);
+		return Renderer2DBatchReorder::TransformBounds(bounds, m_combinedTransforms[states[FromEnum(GLES3Renderer2DCommandType::Transform)]]);
+	}
+
+	void GLES3Renderer2DCommandManager::emitReorderedDraws(GLES3Vertex2DBatch& batches, const uint32 batchIndex, StateIndices& emitted)
+	{
+		if (m_reorder.isEmpty())
+		{
+			return;
+		}
+
+		const uint32 baseIndexOffset = m_reorder.getItems().front().indexOffset;
+
+		if (m_reorder.sort([this](const uint32 a, const uint32 b) { return hasSameStates(m_reorderStates[a], m_reorderStates[b]); }))
+		{
+			// 描画の順に合わせてインデックスを並べ替え、同じグループの描画を連続した範囲にする
+			batches.reorderIndices(batchIndex, baseIndexOffset, m_reorder.getIndexRanges());
+		}
+
+		uint32 indexOffset = baseIndexOffset;
+		size_t drawCount = 0;
+
+		for (const auto& item : m_reorder.getItems())
+		{
+			emitStateChanges(emitted, m_reorderStates[item.stateID]);
+
+			if (const auto& last = m_commands.back();
+				(last.type == GLES3Renderer2DCommandType::Draw)
+				&& ((m_draws[last.index].indexOffset + m_draws[last.index].indexCount) == indexOffset))
+			{
+				m_draws[last.index].indexCount += item.indexCount;
+			}
+			else
+			{
+				m_commands.emplace_back(GLES3Renderer2DCommandType::Draw, static_cast<uint32>(m_draws.size()));
+				m_draws.push_back({ item.indexCount, indexOffset });
+				++drawCount;
+			}
+
+			indexOffset += item.indexCount;
+		}
+
+		m_savedDrawCalls += static_cast<uint32>(m_reorder.getItems().size() - drawCount);
+		m_reorder.clear();
+		m_reorderStates.clear();
+	}
+
+	void GLES3Renderer2DCommandManager::emitStateChanges(StateIndices& emitted, const StateIndices& target)
+	{
+		for (uint32 i = 0; i < target.size(); ++i)
+		{
+			const auto type = ToEnum<GLES3Renderer2DCommandType>(i);
+
+			if ((detail::GetReorderCommandKind(type) == detail::ReorderCommandKind::State)
+				&& (not isSameState(type, emitted[i], target[i])))
+			{
+				m_commands.emplace_back(type, target[i]);
+				emitted[i] = target[i];
+			}
+		}
+	}
+
+	bool GLES3Renderer2DCommandManager::hasSameStates(const StateIndices& a, const StateIndices& b) const
+	{
+		if (a == b)
+		{
+			return true;
+		}
+
+		for (uint32 i = 0; i < a.size(); ++i)
+		{
+			const auto type = ToEnum<GLES3Renderer2DCommandType>(i);
+
+			if ((detail::GetReorderCommandKind(type) == detail::ReorderCommandKind::State)
+				&& (not isSameState(type, a[i], b[i])))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool GLES3Renderer2DCommandManager::isSameState(const GLES3Renderer2DCommandType type, const uint32 a, const uint32 b) const
+	{
+		if (a == b)
+		{
+			return true;
+		}
+
+		// ステートは変更のたびに新しいインデックスに追加されるため、値を比較する
+		switch (type)
+		{
+		case GLES3Renderer2DCommandType::ColorMul:
+			return (m_colorMuls[a] == m_colorMuls[b]);
+		case GLES3Renderer2DCommandType::ColorAdd:
+			return (m_colorAdds[a] == m_colorAdds[b]);
+		case GLES3Renderer2DCommandType::BlendState:
+			return (m_blendStates[a] == m_blendStates[b]);
+		case GLES3Renderer2DCommandType::RasterizerState:
+			return (m_rasterizerStates[a] == m_rasterizerStates[b]);
+		case GLES3Renderer2DCommandType::ScissorRect:
+			return (m_scissorRects[a] == m_scissorRects[b]);
+		case GLES3Renderer2DCommandType::SDFParams:
+			return (m_sdfParams[a] == m_sdfParams[b]);
+		case GLES3Renderer2DCommandType::InternalPSConstants:
+			return (m_internalPSConstants[a] == m_internalPSConstants[b]);
+		case GLES3Renderer2DCommandType::SetVS:
+			return (m_VSs[a] == m_VSs[b]);
+		case GLES3Renderer2DCommandType::SetPS:
+			return (m_PSs[a] == m_PSs[b]);
+		case GLES3Renderer2DCommandType::Transform:
+			return (m_combinedTransforms[a] == m_combinedTransforms[b]);
+		default:
+			break;
+		}
+
+		if (InRange(type, GLES3Renderer2DCommandType::VSSamplerState0, GLES3Renderer2DCommandType::VSSamplerState7))
+		{
+			const uint32 slot = (FromEnum(type) - FromEnum(GLES3Renderer2DCommandType::VSSamplerState0));
+			return (m_vsSamplerStates[slot][a] == m_vsSamplerStates[slot][b]);
+		}
+		else if (InRange(type, GLES3Renderer2DCommandType::PSSamplerState0, GLES3Renderer2DCommandType::PSSamplerState7))
+		{
+			const uint32 slot = (FromEnum(type) - FromEnum(GLES3Renderer2DCommandType::PSSamplerState0));
+			return (m_psSamplerStates[slot][a] == m_psSamplerStates[slot][b]);
+		}
+		else if (InRange(type, GLES3Renderer2DCommandType::VSTexture0, GLES3Renderer2DCommandType::VSTexture7))
+		{
+			const uint32 slot = (FromEnum(type) - FromEnum(GLES3Renderer2DCommandType::VSTexture0));
+			return (m_vsTextures[slot][a] == m_vsTextures[slot][b]);
+		}
+		else if (InRange(type, GLES3Renderer2DCommandType::PSTexture0, GLES3Renderer2DCommandType::PSTexture7))
+		{
+			const uint32 slot = (FromEnum(type) - FromEnum(GLES3Renderer2DCommandType::PSTexture0));
+			return (m_psTextures[slot][a] == m_psTextures[slot][b]);
+		}
+
+		return false;
+	}
 }
@@ -26,6 +26,7 @@
 # include <Siv3D/RenderTexture.hpp>
 # include <Siv3D/Mat3x2.hpp>
 # include <Siv3D/Renderer2D/CurrentBatchStateChanges.hpp>
+# include <Siv3D/Renderer2D/Renderer2DBatchReorder.hpp>
 
 namespace s3d
 {
@@ -151,6 +152,9 @@ namespace s3d
 	struct GLES3DrawCommand
 	{
 		uint32 indexCount = 0;
+
+		// バッチの先頭からのインデックスのオフセット
+		uint32 indexOffset = 0;
 	};
 
 	struct GLES3ConstantBufferCommand
@@ -163,6 +167,8 @@ namespace s3d
 		ConstantBufferBase cbBase;
 	};
 
+	class GLES3Vertex2DBatch;
+
 	class GLES3Renderer2DCommandManager
 	{
 	private:
@@ -220,6 +226,25 @@ namespace s3d
 		HashTable<PixelShader::IDType, PixelShader> m_reservedPSs;
 		HashTable<Texture::IDType, Texture> m_reservedTextures;
 
+		// 現在のバッチに積まれたインデックスの数
+		uint32 m_batchIndexCount = 0;
+
+		// reorder
+		using StateIndices = std::array<uint32, (FromEnum(GLES3Renderer2DCommandType::PSTexture7) + 1)>;
+
+		uint32 m_reorderDepth = 0;
+		size_t m_reorderCommandBegin = 0;
+		uint32 m_savedDrawCalls = 0;
+		Renderer2DBatchReorder m_reorder;
+		Array<StateIndices> m_reorderStates;
+
+		void reorderCommands(GLES3Vertex2DBatch& batches);
+		FloatRect getReorderBounds(const GLES3Vertex2DBatch& batches, uint32 batchIndex, const GLES3DrawCommand& draw, const StateIndices& states) const;
+		void emitReorderedDraws(GLES3Vertex2DBatch& batches, uint32 batchIndex, StateIndices& emitted);
+		void emitStateChanges(StateIndices& emitted, const StateIndices& target);
+		bool hasSameStates(const StateIndices& a, const StateIndices& b) const;
+		bool isSameState(GLES3Renderer2DCommandType type, uint32 a, uint32 b) const;
+
 	public:
 
 		GLES3Renderer2DCommandManager();
@@ -312,5 +337,10 @@ namespace s3d
 		void pushRT(const Optional<RenderTexture>& rt);
 		const Optional<RenderTexture>& getRT(uint32 index) const;
 		const Optional<RenderTexture>& getCurrentRT() const;
+
+		void beginReorder();
+		void endReorder(GLES3Vertex2DBatch& batches);
+		void finishReorder(GLES3Vertex2DBatch& batches);
+		uint32 getSavedDrawCalls() const noexcept;
 	};
 }
@@ -11,6 +11,7 @@
 
 # include <Siv3D/Common.hpp>
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/Renderer2D/Renderer2DBatchReorder.hpp>
 # include "GLES3Vertex2DBatch.hpp"
 
 namespace s3d
@@ -165,14 +166,7 @@ namespace s3d
 	{
 		assert(batchIndex < m_batches.size());
 
-		size_t vertexArrayReadPos = 0;
-		size_t indexArrayReadPos = 0;
-
-		for (size_t i = 0; i < batchIndex; ++i)
-		{
-			vertexArrayReadPos += m_batches[i].vertexPos;
-			indexArrayReadPos += m_batches[i].indexPos;
-		}
+		const auto [vertexArrayReadPos, indexArrayReadPos] = getArrayReadPos(batchIndex);
 
 		::glBindVertexArray(m_vao);
 		::glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
@@ -230,9 +224,43 @@ namespace s3d
 		return batchInfo;
 	}
 
+	FloatRect GLES3Vertex2DBatch::getBounds(const size_t batchIndex, const uint32 indexOffset, const uint32 indexCount) const
+	{
+		assert(batchIndex < m_batches.size());
+
+		const auto [vertexArrayReadPos, indexArrayReadPos] = getArrayReadPos(batchIndex);
+		const Vertex2D* pVertex = &m_vertexArray[vertexArrayReadPos];
+		const Vertex2D::IndexType* pIndex = &m_indexArray[indexArrayReadPos + indexOffset];
+
+		return Renderer2DBatchReorder::CalculateBounds(pVertex, pIndex, indexCount);
+	}
+
+	void GLES3Vertex2DBatch::reorderIndices(const size_t batchIndex, const uint32 indexOffset, const Array<std::pair<uint32, uint32>>& ranges)
+	{
+		assert(batchIndex < m_batches.size());
+
+		Vertex2D::IndexType* const pIndex = &m_indexArray[getArrayReadPos(batchIndex).second + indexOffset];
+
+		Renderer2DBatchReorder::ReorderIndices(pIndex, indexOffset, ranges, m_reorderBuffer);
+	}
+
 	void GLES3Vertex2DBatch::advanceArrayWritePos(const uint16 vertexSize, const uint32 indexSize) noexcept
 	{
 		m_vertexArrayWritePos	+= vertexSize;
 		m_indexArrayWritePos	+= indexSize;
 	}
+
+	std::pair<size_t, size_t> GLES3Vertex2DBatch::getArrayReadPos(const size_t batchIndex) const noexcept
+	{
+		size_t vertexArrayReadPos = 0;
+		size_t indexArrayReadPos = 0;
+
+		for (size_t i = 0; i < batchIndex; ++i)
+		{
+			vertexArrayReadPos += m_batches[i].vertexPos;
+			indexArrayReadPos += m_batches[i].indexPos;
+		}
+
+		return{ vertexArrayReadPos, indexArrayReadPos };
+	}
 }
@@ -53,6 +53,8 @@ namespace s3d
 
 		Array<BatchBufferPos> m_batches;
 
+		Array<Vertex2D::IndexType> m_reorderBuffer;
+
 		static constexpr uint32 InitialVertexArraySize	= 4096;
 		static constexpr uint32 InitialIndexArraySize	= (4096 * 8); // 32,768
 
@@ -64,6 +66,9 @@ namespace s3d
 
 		void advanceArrayWritePos(uint16 vertexSize, uint32 indexSize) noexcept;
 
+		[[nodiscard]]
+		std::pair<size_t, size_t> getArrayReadPos(size_t batchIndex) const noexcept;
+
 	public:
 
 		GLES3Vertex2DBatch();
@@ -85,5 +90,12 @@ namespace s3d
 
 		[[nodiscard]]
 		BatchInfo2D updateBuffers(size_t batchIndex);
+
+		// batchIndex 番目のバッチの [indexOffset, indexOffset + indexCount) のインデックスが参照する頂点を囲む長方形を返す
+		[[nodiscard]]
+		FloatRect getBounds(size_t batchIndex, uint32 indexOffset, uint32 indexCount) const;
+
+		// batchIndex 番目のバッチの indexOffset から始まるインデックスを、ranges (オフセット, 個数) の順に並べ替える
+		void reorderIndices(size_t batchIndex, uint32 indexOffset, const Array<std::pair<uint32, uint32>>& ranges);
 	};
 }
@@ -11,7 +11,7 @@
 
 # include "CTexture_GLES3.hpp"
 # include <Siv3D/Error.hpp>
-# include <Siv3D/System.hpp>
+# include <Siv3D/Time.hpp>
 # include <Siv3D/EngineLog.hpp>
 # include <Siv3D/Texture/TextureCommon.hpp>
 
@@ -52,49 +52,63 @@ namespace s3d
 		}
 	}
 
-	void CTexture_GLES3::updateAsyncTextureLoad(const size_t maxUpdate)
+	void CTexture_GLES3::updateAsyncTextureLoad(const uint64 budgetMicrosec)
 	{
 		if (not isMainThread())
 		{
 			return;
 		}
 
-		// 終了時は即座に全消去
-		if (maxUpdate == Largest<size_t>)
-		{
-			std::lock_guard lock{ m_requestsMutex };
+		const uint64 startTimeMicrosec = Time::GetMicrosec();
 
-			for (auto& request : m_requests)
+		m_asyncStat.completedLastUpdate = 0;
+		m_asyncStat.maxLatencyMicrosec = 0;
+
+		// 時間が無くても 1 つは進める
+		for (bool first = true; (first || ((Time::GetMicrosec() - startTimeMicrosec) < budgetMicrosec)); first = false)
+		{
+			Request* pRequest = nullptr;
 			{
-				request.waiting.get() = false;
+				std::lock_guard lock{ m_requestsMutex };
+
+				if (m_requests.isEmpty())
+				{
+					break;
+				}
+
+				pRequest = m_requests.front();
+				m_requests.pop_front();
 			}
 
-			m_requests.clear();
+			finishRequest(*pRequest);
+		}
+
+		std::lock_guard lock{ m_requestsMutex };
+		m_asyncStat.queueDepth = static_cast<uint32>(m_requests.size());
+	}
 
+	void CTexture_GLES3::cancelAsyncTextureLoad()
+	{
+		if (not isMainThread())
+		{
 			return;
 		}
 
 		std::lock_guard lock{ m_requestsMutex };
 
-		const size_t loadCount = Min(maxUpdate, m_requests.size());
-
-		for (size_t i = 0; i < loadCount; ++i)
+		for (auto& pRequest : m_requests)
 		{
-			auto& request = m_requests[i];
+			pRequest->result.set_value(Texture::IDType::NullAsset());
+		}
 
-			if (*request.pMipmaps)
-			{
-				request.idResult.get() = createMipped(*request.pImage, *request.pMipmaps, *request.pDesc);
-			}
-			else
-			{
-				request.idResult.get() = createUnmipped(*request.pImage, *request.pDesc);
-			}
+		m_requests.clear();
 
-			request.waiting.get() = false;
-		}
+		m_asyncStat.queueDepth = 0;
+	}
 
-		m_requests.pop_front_N(loadCount);
+	AsyncTextureLoadStat CTexture_GLES3::getAsyncTextureLoadStat() const
+	{
+		return m_asyncStat;
 	}
 
 	size_t CTexture_GLES3::getTextureCount() const
@@ -390,21 +404,36 @@ namespace s3d
 
 	Texture::IDType CTexture_GLES3::pushRequest(const Image& image, const Array<Image>& mipmaps, const TextureDesc desc)
 	{
-		std::atomic<bool> waiting = true;
+		Request request;
+		request.pImage	= &image;
+		request.pMipmaps	= &mipmaps;
+		request.desc	= desc;
+		request.requestedTimeMicrosec = Time::GetMicrosec();
 
-		Texture::IDType result = Texture::IDType::NullAsset();
+		std::future<Texture::IDType> result = request.result.get_future();
 		{
 			std::lock_guard lock{ m_requestsMutex };
 
-			m_requests.push_back(Request{ &image, &mipmaps, &desc, std::ref(result), std::ref(waiting) });
+			m_requests.push_back(&request);
 		}
 
-		// [Siv3D ToDo] conditional_variable を使う
-		while (waiting)
-		{
-			System::Sleep(3);
-		}
+		return result.get();
+	}
+
+	void CTexture_GLES3::finishRequest(Request& request)
+	{
+		const Texture::IDType id = (*request.pMipmaps ?
+			createMipped(*request.pImage, *request.pMipmaps, request.desc)
+			: createUnmipped(*request.pImage, request.desc));
+
+		const uint64 latencyMicrosec = (Time::GetMicrosec() - request.requestedTimeMicrosec);
+		++m_asyncStat.completedLastUpdate;
+		++m_asyncStat.totalCompleted;
+		m_asyncStat.maxLatencyMicrosec = Max(m_asyncStat.maxLatencyMicrosec, latencyMicrosec);
+		m_totalLatencyMicrosec += latencyMicrosec;
+		m_asyncStat.averageLatencyMicrosec = (m_totalLatencyMicrosec / m_asyncStat.totalCompleted);
 
-		return result;
+		// これ以降、request は要求したスレッドによって破棄されうる
+		request.result.set_value(id);
 	}
 }
@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # pragma once
+# include <future>
 # include <Siv3D/Common.hpp>
 # include <Siv3D/Texture/ITexture.hpp>
 # include <Siv3D/AssetHandleManager/AssetHandleManager.hpp>
@@ -27,7 +28,11 @@ namespace s3d
 
 		void init();
 
-		void updateAsyncTextureLoad(size_t maxUpdate) override;
+		void updateAsyncTextureLoad(uint64 budgetMicrosec) override;
+
+		void cancelAsyncTextureLoad() override;
+
+		AsyncTextureLoadStat getAsyncTextureLoadStat() const override;
 
 		size_t getTextureCount() const override;
 
@@ -98,22 +103,31 @@ namespace s3d
 
 		/////////////////////////////////
 		//
-		std::mutex m_requestsMutex;
-
+		// 別スレッドからのテクスチャ作成要求
+		//
+		// WebGL では glMapBufferRange() が使えないため、ピクセルバッファを経由せず、
+		// メインスレッドで画像から直接テクスチャを作成して result で ID を返す
+		//
 		struct Request
 		{
 			const Image* pImage = nullptr;
 
 			const Array<Image>* pMipmaps = nullptr;
 
-			const TextureDesc* pDesc = nullptr;
+			TextureDesc desc = TextureDesc::Unmipped;
 
-			std::reference_wrapper<Texture::IDType> idResult;
+			uint64 requestedTimeMicrosec = 0;
 
-			std::reference_wrapper<std::atomic<bool>> waiting;
+			std::promise<Texture::IDType> result;
 		};
 
-		Array<Request> m_requests;
+		std::mutex m_requestsMutex;
+
+		Array<Request*> m_requests;
+
+		AsyncTextureLoadStat m_asyncStat;
+
+		uint64 m_totalLatencyMicrosec = 0;
 		//
 		/////////////////////////////////
 
@@ -121,5 +135,7 @@ namespace s3d
 		bool isMainThread() const noexcept;
 
 		Texture::IDType pushRequest(const Image& image, const Array<Image>& mipmaps, TextureDesc desc);
+
+		void finishRequest(Request& request);
 	};
 }
@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/ProfilerZone.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 # include <Siv3D/Resource/IResource.hpp>
 # include <Siv3D/Profiler/IProfiler.hpp>
@@ -129,6 +130,8 @@ namespace s3d
 
 	bool CSystem::update()
 	{
+		SIV3D_PROFILE_ZONE(U"System::Update");
+
 		if (m_termination)
 		{
 			return false;
@@ -16,6 +16,7 @@
 # include <Siv3D/ScopeGuard.hpp>
 # include <Siv3D/Mat3x2.hpp>
 # include <Siv3D/ShaderCommon.hpp>
+# include <Siv3D/ProfilerZone.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 # include <Siv3D/Renderer/D3D11/CRenderer_D3D11.hpp>
 # include <Siv3D/Shader/D3D11/CShader_D3D11.hpp>
@@ -104,10 +105,7 @@ namespace s3d
 		}
 
 		// バッファ作成関数を作成
-		m_bufferCreator = [this](Vertex2D::IndexType vertexSize, Vertex2D::IndexType indexSize)
-		{
-			return m_batches.requestBuffer(vertexSize, indexSize, m_commandManager);
-		};
+		m_bufferCreator = BufferCreatorFunc::Bind<&CRenderer2D_D3D11::requestBuffer>(this);
 
 		// シャドウ画像を作成
 		{
@@ -654,25 +652,57 @@ namespace s3d
 		}
 	}
 
-	void CRenderer2D_D3D11::addTexturedParticles(const Texture& texture, const Array<Particle2D>& particles,
+	void CRenderer2D_D3D11::addTexturedParticles(const Texture& texture, const ParticleStorage2D& particles,
 		ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc,
 		ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc)
 	{
-		if (const auto indexCount = Vertex2DBuilder::BuildTexturedParticles(m_bufferCreator, particles, sizeOverLifeTimeFunc, colorOverLifeTimeFunc))
+		for (size_t offset = 0; offset < particles.size(); offset += Vertex2DBuilder::MaxTexturedParticles)
 		{
-			if (not m_currentCustomVS)
+			const size_t n = Min((particles.size() - offset), Vertex2DBuilder::MaxTexturedParticles);
+
+			if (const auto indexCount = Vertex2DBuilder::BuildTexturedParticles(m_bufferCreator, particles, offset, n, sizeOverLifeTimeFunc, colorOverLifeTimeFunc))
 			{
-				m_commandManager.pushStandardVS(m_standardVS->spriteID);
+				if (not m_currentCustomVS)
+				{
+					m_commandManager.pushStandardVS(m_standardVS->spriteID);
+				}
+
+				if (not m_currentCustomPS)
+				{
+					m_commandManager.pushStandardPS(m_standardPS->textureID);
+				}
+
+				m_commandManager.pushPSTexture(0, texture);
+				m_commandManager.pushDraw(indexCount);
 			}
+		}
+	}
 
-			if (not m_currentCustomPS)
+	void CRenderer2D_D3D11::addTexturedInstances(const Texture& texture, const SpriteInstance* instances, const size_t count)
+	{
+		// インスタンス描画には未対応のため、CPU で頂点に展開する
+		for (size_t offset = 0; offset < count; offset += Vertex2DBuilder::MaxTexturedInstances)
+		{
+			const size_t n = Min((count - offset), Vertex2DBuilder::MaxTexturedInstances);
+
+			if (const auto indexCount = Vertex2DBuilder::BuildTexturedInstances(m_bufferCreator, (instances + offset), n))
 			{
-				m_commandManager.pushStandardPS(m_standardPS->textureID);
-			}
+				if (not m_currentCustomVS)
+				{
+					m_commandManager.pushStandardVS(m_standardVS->spriteID);
+				}
 
-			m_commandManager.pushPSTexture(0, texture);
-			m_commandManager.pushDraw(indexCount);
+				if (not m_currentCustomPS)
+				{
+					m_commandManager.pushStandardPS(m_standardPS->textureID);
+				}
+
+				m_commandManager.pushPSTexture(0, texture);
+				m_commandManager.pushDraw(indexCount);
+			}
 		}
+
+		m_stat.instanceCount += static_cast<uint32>(count);
 	}
 
 
@@ -910,6 +940,16 @@ namespace s3d
 		m_commandManager.pushConstantBuffer(stage, slot, buffer, data, num_vectors);
 	}
 
+	void CRenderer2D_D3D11::beginBatchReorder()
+	{
+		m_commandManager.beginReorder();
+	}
+
+	void CRenderer2D_D3D11::endBatchReorder()
+	{
+		m_commandManager.endReorder(m_batches);
+	}
+
 	const Texture& CRenderer2D_D3D11::getBoxShadowTexture() const noexcept
 	{
 		return *m_boxShadowTexture;
@@ -917,6 +957,8 @@ namespace s3d
 
 	void CRenderer2D_D3D11::flush()
 	{
+		SIV3D_PROFILE_ZONE(U"Renderer2D::flush");
+
 		ScopeGuard cleanUp = [this]()
 		{
 			m_batches.reset();
@@ -925,7 +967,9 @@ namespace s3d
 			m_currentCustomPS.reset();
 		};
 
+		m_commandManager.finishReorder(m_batches);
 		m_commandManager.flush();
+		m_stat.savedDrawCalls += m_commandManager.getSavedDrawCalls();
 
 		m_context->IASetInputLayout(m_inputLayout.Get());
 		pShader->setConstantBufferVS(0, m_vsConstants2D.base());
@@ -981,11 +1025,10 @@ namespace s3d
 
 					const D3D11DrawCommand& draw = m_commandManager.getDraw(command.index);
 					const uint32 indexCount = draw.indexCount;
-					const uint32 startIndexLocation = batchInfo.startIndexLocation;
+					const uint32 startIndexLocation = (batchInfo.startIndexLocation + draw.indexOffset);
 					const uint32 baseVertexLocation = batchInfo.baseVertexLocation;
 
 					m_context->DrawIndexed(indexCount, startIndexLocation, baseVertexLocation);
-					batchInfo.startIndexLocation += indexCount;
 					
 					++m_stat.drawCalls;
 					m_stat.triangleCount += (indexCount / 3);
@@ -1315,4 +1358,9 @@ namespace s3d
 
 		//Siv3DEngine::Get<ISiv3DProfiler>()->reportDrawcalls(1, 1);
 	}
+
+	Vertex2DBufferPointer CRenderer2D_D3D11::requestBuffer(const Vertex2D::IndexType vertexSize, const Vertex2D::IndexType indexSize)
+	{
+		return m_batches.requestBuffer(vertexSize, indexSize, m_commandManager);
+	}
 }
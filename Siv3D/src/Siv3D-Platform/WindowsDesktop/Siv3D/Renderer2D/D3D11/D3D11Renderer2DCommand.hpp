@@ -27,6 +27,7 @@
 # include <Siv3D/Mat3x2.hpp>
 # include <Siv3D/Common/D3D11.hpp>
 # include <Siv3D/Renderer2D/CurrentBatchStateChanges.hpp>
+# include <Siv3D/Renderer2D/Renderer2DBatchReorder.hpp>
 
 namespace s3d
 {
@@ -146,6 +147,9 @@ namespace s3d
 	struct D3D11DrawCommand
 	{
 		uint32 indexCount = 0;
+
+		// バッチの先頭からのインデックスのオフセット
+		uint32 indexOffset = 0;
 	};
 
 	struct D3D11ConstantBufferCommand
@@ -158,6 +162,8 @@ namespace s3d
 		ConstantBufferBase cbBase;
 	};
 
+	class D3D11Vertex2DBatch;
+
 	class D3D11Renderer2DCommandManager
 	{
 	private:
@@ -215,6 +221,25 @@ namespace s3d
 		HashTable<PixelShader::IDType, PixelShader> m_reservedPSs;
 		HashTable<Texture::IDType, Texture> m_reservedTextures;
 
+		// 現在のバッチに積まれたインデックスの数
+		uint32 m_batchIndexCount = 0;
+
+		// reorder
+		using StateIndices = std::array<uint32, (FromEnum(D3D11Renderer2DCommandType::PSTexture7) + 1)>;
+
+		uint32 m_reorderDepth = 0;
+		size_t m_reorderCommandBegin = 0;
+		uint32 m_savedDrawCalls = 0;
+		Renderer2DBatchReorder m_reorder;
+		Array<StateIndices> m_reorderStates;
+
+		void reorderCommands(D3D11Vertex2DBatch& batches);
+		FloatRect getReorderBounds(const D3D11Vertex2DBatch& batches, uint32 batchIndex, const D3D11DrawCommand& draw, const StateIndices& states) const;
+		void emitReorderedDraws(D3D11Vertex2DBatch& batches, uint32 batchIndex, StateIndices& emitted);
+		void emitStateChanges(StateIndices& emitted, const StateIndices& target);
+		bool hasSameStates(const StateIndices& a, const StateIndices& b) const;
+		bool isSameState(D3D11Renderer2DCommandType type, uint32 a, uint32 b) const;
+
 	public:
 
 		D3D11Renderer2DCommandManager();
@@ -307,5 +332,10 @@ namespace s3d
 		void pushRT(const Optional<RenderTexture>& rt);
 		const Optional<RenderTexture>& getRT(uint32 index) const;
 		const Optional<RenderTexture>& getCurrentRT() const;
+
+		void beginReorder();
+		void endReorder(D3D11Vertex2DBatch& batches);
+		void finishReorder(D3D11Vertex2DBatch& batches);
+		uint32 getSavedDrawCalls() const noexcept;
 	};
 }
@@ -53,6 +53,8 @@ namespace s3d
 		Array<Vertex2D::IndexType> m_indexArray;
 		uint32 m_indexArrayWritePos = 0;
 
+		Array<Vertex2D::IndexType> m_reorderBuffer;
+
 		Array<BatchBufferPos> m_batches;
 
 		static constexpr uint32 InitialVertexArraySize	= 4096;			// 4,096
@@ -66,6 +68,9 @@ namespace s3d
 
 		void advanceArrayWritePos(uint16 vertexSize, uint32 indexSize) noexcept;
 
+		[[nodiscard]]
+		std::pair<size_t, size_t> getArrayReadPos(size_t batchIndex) const noexcept;
+
 	public:
 
 		D3D11Vertex2DBatch();
@@ -87,5 +92,12 @@ namespace s3d
 
 		[[nodiscard]]
 		BatchInfo2D updateBuffers(size_t batchIndex);
+
+		// batchIndex 番目のバッチの [indexOffset, indexOffset + indexCount) のインデックスが参照する頂点を囲む長方形を返す
+		[[nodiscard]]
+		FloatRect getBounds(size_t batchIndex, uint32 indexOffset, uint32 indexCount) const;
+
+		// batchIndex 番目のバッチの indexOffset から始まるインデックスを、ranges (オフセット, 個数) の順に並べ替える
+		void reorderIndices(size_t batchIndex, uint32 indexOffset, const Array<std::pair<uint32, uint32>>& ranges);
 	};
 }
@@ -99,11 +99,21 @@ namespace s3d
 		}
 	}
 
-	void CTexture_D3D11::updateAsyncTextureLoad(const size_t)
+	void CTexture_D3D11::updateAsyncTextureLoad(const uint64)
 	{
 		// do nothing
 	}
 
+	void CTexture_D3D11::cancelAsyncTextureLoad()
+	{
+		// do nothing
+	}
+
+	AsyncTextureLoadStat CTexture_D3D11::getAsyncTextureLoadStat() const
+	{
+		return{};
+	}
+
 	size_t CTexture_D3D11::getTextureCount() const
 	{
 		return m_textures.size();
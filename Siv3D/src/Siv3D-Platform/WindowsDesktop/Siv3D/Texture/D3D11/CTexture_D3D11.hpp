@@ -45,7 +45,11 @@ namespace s3d
 
 		void init();
 
-		void updateAsyncTextureLoad(size_t maxUpdate) override;
+		void updateAsyncTextureLoad(uint64 budgetMicrosec) override;
+
+		void cancelAsyncTextureLoad() override;
+
+		AsyncTextureLoadStat getAsyncTextureLoadStat() const override;
 
 		size_t getTextureCount() const override;
 
@@ -16,6 +16,7 @@
 # include <Siv3D/ScopeGuard.hpp>
 # include <Siv3D/Mat3x2.hpp>
 # include <Siv3D/ShaderCommon.hpp>
+# include <Siv3D/ProfilerZone.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 # include <Siv3D/Renderer/Metal/CRenderer_Metal.hpp>
 # include <Siv3D/Shader/Metal/CShader_Metal.hpp>
@@ -110,10 +111,7 @@ namespace s3d
 		}
 
 		// バッファ作成関数を作成
-		m_bufferCreator = [this](Vertex2D::IndexType vertexSize, Vertex2D::IndexType indexSize)
-		{
-			return m_batches.requestBuffer(vertexSize, indexSize, m_commandManager);
-		};
+		m_bufferCreator = BufferCreatorFunc::Bind<&CRenderer2D_Metal::requestBuffer>(this);
 
 		// シャドウ画像を作成
 		{
@@ -576,13 +574,18 @@ namespace s3d
 
 	}
 
-	void CRenderer2D_Metal::addTexturedParticles(const Texture& texture, const Array<Particle2D>& particles,
+	void CRenderer2D_Metal::addTexturedParticles(const Texture& texture, const ParticleStorage2D& particles,
 		ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc,
 		ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc)
 	{
 
 	}
 
+	void CRenderer2D_Metal::addTexturedInstances(const Texture& texture, const SpriteInstance* instances, const size_t count)
+	{
+
+	}
+
 
 	Float4 CRenderer2D_Metal::getColorMul() const
 	{
@@ -767,6 +770,16 @@ namespace s3d
 		m_commandManager.pushConstantBuffer(stage, slot, buffer, data, num_vectors);
 	}
 
+	void CRenderer2D_Metal::beginBatchReorder()
+	{
+		// [Siv3D ToDo]
+	}
+
+	void CRenderer2D_Metal::endBatchReorder()
+	{
+		// [Siv3D ToDo]
+	}
+
 	const Texture& CRenderer2D_Metal::getBoxShadowTexture() const noexcept
 	{
 		return *m_boxShadowTexture;
@@ -779,6 +792,8 @@ namespace s3d
 
 	void CRenderer2D_Metal::flush(id<MTLCommandBuffer> commandBuffer)
 	{
+		SIV3D_PROFILE_ZONE(U"Renderer2D::flush");
+
 		ScopeGuard cleanUp = [this]()
 		{
 			m_commandManager.reset();
@@ -1138,4 +1153,9 @@ namespace s3d
 	{
 		m_batches.begin();
 	}
+
+	Vertex2DBufferPointer CRenderer2D_Metal::requestBuffer(const Vertex2D::IndexType vertexSize, const Vertex2D::IndexType indexSize)
+	{
+		return m_batches.requestBuffer(vertexSize, indexSize, m_commandManager);
+	}
 }
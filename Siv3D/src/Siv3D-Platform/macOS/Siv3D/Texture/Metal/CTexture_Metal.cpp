@@ -30,11 +30,21 @@ namespace s3d
 		
 	}
 
-	void CTexture_Metal::updateAsyncTextureLoad(const size_t)
+	void CTexture_Metal::updateAsyncTextureLoad(const uint64)
 	{
 		// [Siv3D ToDo]
 	}
 
+	void CTexture_Metal::cancelAsyncTextureLoad()
+	{
+		// [Siv3D ToDo]
+	}
+
+	AsyncTextureLoadStat CTexture_Metal::getAsyncTextureLoadStat() const
+	{
+		return{};
+	}
+
 	size_t CTexture_Metal::getTextureCount() const
 	{
 		// [Siv3D ToDo]
@@ -17,44 +17,67 @@
 
 namespace s3d
 {
-	Emission2D ArcEmitter2D::emit(const Vec2& emitterPosition, const double startSpeed)
+	namespace detail
 	{
-		const double a = Random(direction - angle * 0.5, direction + angle * 0.5);
-		const double aR = Math::ToRadians(a);
-		const Vec2 sourceOffset = RandomVec2(Circle{ Vec2{0, 0}, sourceRadius });
-
-		Emission2D emission;
-
-		if (fromShell)
+		template <class URBG>
+		[[nodiscard]]
+		static Emission2D Emit(const ArcEmitter2D& emitter, const Vec2& emitterPosition, const double startSpeed, URBG& urbg)
 		{
-			const Vec2 basePos = emitterPosition.movedBy(Circular{ r, aR }.fastToVec2());
-			emission.position = (basePos + sourceOffset);
+			const double a = Random(emitter.direction - emitter.angle * 0.5, emitter.direction + emitter.angle * 0.5, urbg);
+			const double aR = Math::ToRadians(a);
+			const Vec2 sourceOffset = RandomVec2(Circle{ Vec2{0, 0}, emitter.sourceRadius }, urbg);
 
-			if (randomDirection)
+			Emission2D emission;
+
+			if (emitter.fromShell)
 			{
-				emission.velocity = RandomVec2(startSpeed);
+				const Vec2 basePos = emitterPosition.movedBy(Circular{ emitter.r, aR }.fastToVec2());
+				emission.position = (basePos + sourceOffset);
+
+				if (emitter.randomDirection)
+				{
+					emission.velocity = RandomVec2(startSpeed, urbg);
+				}
+				else
+				{
+					emission.velocity = Circular{ startSpeed, aR }.fastToVec2();
+				}
 			}
 			else
 			{
-				emission.velocity = Circular{ startSpeed, aR }.fastToVec2();
+				const Vec2 basePos = emitterPosition.movedBy(Circular{ std::sqrt(Random(urbg)) * emitter.r, aR }.fastToVec2());
+				emission.position = (basePos + sourceOffset);
+
+				if (emitter.randomDirection)
+				{
+					emission.velocity = RandomVec2(startSpeed, urbg);
+				}
+				else
+				{
+					emission.velocity = Circular{ startSpeed, aR }.fastToVec2();
+				}
 			}
+
+			return emission;
 		}
-		else
-		{
-			const Vec2 basePos = emitterPosition.movedBy(Circular{ std::sqrt(Random()) * r, aR }.fastToVec2());
-			emission.position = (basePos + sourceOffset);
+	}
 
-			if (randomDirection)
-			{
-				emission.velocity = RandomVec2(startSpeed);
-			}
-			else
-			{
-				emission.velocity = Circular{ startSpeed, aR }.fastToVec2();
-			}
+	Emission2D ArcEmitter2D::emit(const Vec2& emitterPosition, const double startSpeed)
+	{
+		return detail::Emit(*this, emitterPosition, startSpeed, GetDefaultRNG());
+	}
+
+	void ArcEmitter2D::emitN(Emission2D* emissions, const size_t count, const Vec2& emitterPosition, const double startSpeed, SmallRNG& rng)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			emissions[i] = detail::Emit(*this, emitterPosition, startSpeed, rng);
 		}
+	}
 
-		return emission;
+	bool ArcEmitter2D::supportsParallelEmission() const noexcept
+	{
+		return true;
 	}
 
 	void ArcEmitter2D::drawDebug(const Vec2& emitterPosition) const
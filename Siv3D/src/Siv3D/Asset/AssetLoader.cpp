@@ -0,0 +1,187 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+# include <Siv3D/Threading.hpp>
+# include <Siv3D/Utility.hpp>
+# include <Siv3D/ProfilerZone.hpp>
+# include "AssetLoader.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// @brief アセットローダーのスレッド数の上限。ディスク I/O の競合を避けるため小さく抑える
+		inline constexpr size_t MaxAssetLoaderThreads = 4;
+	}
+
+	AssetLoadJob::AssetLoadJob(std::function<void(bool)> function)
+		: m_function{ std::move(function) } {}
+
+	bool AssetLoadJob::tryRun()
+	{
+		State expected = State::Pending;
+
+		if (not m_state.compare_exchange_strong(expected, State::Running, std::memory_order_acq_rel))
+		{
+			return false;
+		}
+
+		{
+			SIV3D_PROFILE_ZONE(U"Asset::load");
+
+			m_function(m_canceled.load(std::memory_order_acquire));
+		}
+
+		m_function = nullptr;
+
+		{
+			std::lock_guard lock{ m_mutex };
+			m_state.store(State::Done, std::memory_order_release);
+		}
+
+		m_condition.notify_all();
+
+		return true;
+	}
+
+	void AssetLoadJob::wait()
+	{
+		if (tryRun())
+		{
+			return;
+		}
+
+		std::unique_lock lock{ m_mutex };
+
+		m_condition.wait(lock, [this]() { return isDone(); });
+	}
+
+	bool AssetLoadJob::cancel() noexcept
+	{
+		m_canceled.store(true, std::memory_order_release);
+
+		return isPending();
+	}
+
+	bool AssetLoadJob::isPending() const noexcept
+	{
+		return (m_state.load(std::memory_order_acquire) == State::Pending);
+	}
+
+	bool AssetLoadJob::isDone() const noexcept
+	{
+		return (m_state.load(std::memory_order_acquire) == State::Done);
+	}
+
+	AssetLoader::AssetLoader(const size_t numThreads)
+	{
+		for (size_t i = 0; i < numThreads; ++i)
+		{
+			m_threads.emplace_back(&AssetLoader::workerMain, this);
+		}
+	}
+
+	AssetLoader::~AssetLoader()
+	{
+		cancelAll();
+
+		{
+			std::lock_guard lock{ m_mutex };
+			m_abort = true;
+		}
+
+		m_condition.notify_all();
+
+		for (auto& thread : m_threads)
+		{
+			thread.join();
+		}
+	}
+
+	void AssetLoader::post(const std::shared_ptr<AssetLoadJob>& job, const AssetLoadPriority priority)
+	{
+		if (m_threads.empty())
+		{
+			job->tryRun();
+			return;
+		}
+
+		{
+			std::lock_guard lock{ m_mutex };
+			m_queue.push(Entry{ priority, m_sequence++, job });
+		}
+
+		m_condition.notify_one();
+	}
+
+	void AssetLoader::cancelAll()
+	{
+		std::priority_queue<Entry> queue;
+
+		{
+			std::lock_guard lock{ m_mutex };
+			std::swap(queue, m_queue);
+		}
+
+		// 取り消したジョブはすぐにこのスレッドで実行し、アセットの状態を元に戻す
+		while (not queue.empty())
+		{
+			const auto& job = queue.top().job;
+
+			if (job->cancel())
+			{
+				job->tryRun();
+			}
+
+			queue.pop();
+		}
+	}
+
+	size_t AssetLoader::num_queued() const
+	{
+		std::lock_guard lock{ m_mutex };
+
+		return m_queue.size();
+	}
+
+	size_t AssetLoader::num_threads() const noexcept
+	{
+		return m_threads.size();
+	}
+
+	size_t AssetLoader::DefaultThreadCount() noexcept
+	{
+		return Clamp<size_t>((Threading::GetConcurrency() / 2), 1, detail::MaxAssetLoaderThreads);
+	}
+
+	void AssetLoader::workerMain()
+	{
+		for (;;)
+		{
+			std::shared_ptr<AssetLoadJob> job;
+
+			{
+				std::unique_lock lock{ m_mutex };
+
+				m_condition.wait(lock, [this]() { return (m_abort || (not m_queue.empty())); });
+
+				if (m_queue.empty())
+				{
+					return;
+				}
+
+				job = m_queue.top().job;
+				m_queue.pop();
+			}
+
+			job->tryRun();
+		}
+	}
+}
@@ -0,0 +1,143 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+# pragma once
+# include <thread>
+# include <mutex>
+# include <condition_variable>
+# include <atomic>
+# include <queue>
+# include <functional>
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/AssetLoadPriority.hpp>
+
+namespace s3d
+{
+	/// @brief アセットの非同期ロード 1 件分のジョブ
+	class AssetLoadJob
+	{
+	public:
+
+		/// @brief ジョブを作成します。
+		/// @param function ロード処理。引数には取り消されたかどうかが渡される
+		explicit AssetLoadJob(std::function<void(bool)> function);
+
+		/// @brief ジョブがまだ開始していなければ、呼び出し元のスレッドで実行します。
+		/// @return 実行した場合 true, すでに他のスレッドが開始していた場合 false
+		bool tryRun();
+
+		/// @brief ジョブの完了を待ちます。まだ開始していない場合は呼び出し元のスレッドで実行します。
+		void wait();
+
+		/// @brief ジョブを取り消します。
+		/// @return まだ開始していなかった場合 true, それ以外の場合は false
+		bool cancel() noexcept;
+
+		[[nodiscard]]
+		bool isPending() const noexcept;
+
+		[[nodiscard]]
+		bool isDone() const noexcept;
+
+	private:
+
+		enum class State : uint8
+		{
+			Pending,
+
+			Running,
+
+			Done,
+		};
+
+		std::function<void(bool)> m_function;
+
+		std::atomic<State> m_state = State::Pending;
+
+		std::atomic<bool> m_canceled = false;
+
+		std::mutex m_mutex;
+
+		std::condition_variable m_condition;
+	};
+
+	/// @brief アセットの非同期ロードを、優先度の高い順に少数のスレッドで処理するスレッドプール
+	/// @remark ファイル I/O を伴うため、並列計算用のスレッドプールとは別に、同時に実行するロードの数を制限する。
+	class AssetLoader
+	{
+	public:
+
+		/// @brief スレッド数を指定してアセットローダーを作成します。
+		/// @param numThreads スレッド数
+		explicit AssetLoader(size_t numThreads);
+
+		~AssetLoader();
+
+		/// @brief ジョブをキューに追加します。
+		/// @param job ジョブ
+		/// @param priority 優先度
+		/// @remark 同じジョブを複数回追加した場合、最初に取り出されたものだけが実行されます。
+		void post(const std::shared_ptr<AssetLoadJob>& job, AssetLoadPriority priority);
+
+		/// @brief キューにあるすべてのジョブを取り消します。
+		void cancelAll();
+
+		/// @brief キューにあるジョブの数を返します。
+		/// @return キューにあるジョブの数
+		[[nodiscard]]
+		size_t num_queued() const;
+
+		[[nodiscard]]
+		size_t num_threads() const noexcept;
+
+		/// @brief アセットローダーの既定のスレッド数を返します。
+		/// @return アセットローダーの既定のスレッド数
+		[[nodiscard]]
+		static size_t DefaultThreadCount() noexcept;
+
+	private:
+
+		struct Entry
+		{
+			AssetLoadPriority priority;
+
+			uint64 sequence;
+
+			std::shared_ptr<AssetLoadJob> job;
+
+			/// @brief 優先度が高いものを先に、同じ優先度では先に追加されたものを先に取り出す
+			[[nodiscard]]
+			friend bool operator <(const Entry& lhs, const Entry& rhs) noexcept
+			{
+				if (lhs.priority != rhs.priority)
+				{
+					return (lhs.priority < rhs.priority);
+				}
+
+				return (rhs.sequence < lhs.sequence);
+			}
+		};
+
+		std::priority_queue<Entry> m_queue;
+
+		uint64 m_sequence = 0;
+
+		Array<std::thread> m_threads;
+
+		mutable std::mutex m_mutex;
+
+		std::condition_variable m_condition;
+
+		bool m_abort = false;
+
+		void workerMain();
+	};
+}
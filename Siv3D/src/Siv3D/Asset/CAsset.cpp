@@ -18,6 +18,9 @@ namespace s3d
 {
 	namespace detail
 	{
+		/// @brief 別スレッドからのテクスチャ作成要求の処理に、1 フレームあたりに使う時間の目安（マイクロ秒）
+		inline constexpr uint64 AsyncTextureLoadBudgetMicrosec = 2000;
+
 		[[nodiscard]]
 		constexpr StringView GetAssetTypeName(const AssetType assetType) noexcept
 		{
@@ -45,7 +48,9 @@ namespace s3d
 	{
 		LOG_SCOPED_TRACE(U"CAsset::~CAsset()");
 
-		SIV3D_ENGINE(Texture)->updateAsyncTextureLoad(Largest<size_t>);
+		SIV3D_ENGINE(Texture)->cancelAsyncTextureLoad();
+
+		m_loader.cancelAll();
 
 		// wait for all
 		for (auto& assetList : m_assetLists)
@@ -59,7 +64,7 @@ namespace s3d
 
 	void CAsset::update()
 	{
-		SIV3D_ENGINE(Texture)->updateAsyncTextureLoad(4);
+		SIV3D_ENGINE(Texture)->updateAsyncTextureLoad(detail::AsyncTextureLoadBudgetMicrosec);
 	}
 
 	bool CAsset::registerAsset(const AssetType assetType, const AssetName& name, std::unique_ptr<IAsset>&& asset)
@@ -244,4 +249,92 @@ namespace s3d
 
 		return result;
 	}
+
+	template <class Fty>
+	void CAsset::eachAssetWithTag(const AssetTag& tag, Fty f)
+	{
+		for (auto& assetList : m_assetLists)
+		{
+			for (auto&& [name, asset] : assetList)
+			{
+				if (asset->getTags().includes(tag))
+				{
+					f(*asset);
+				}
+			}
+		}
+	}
+
+	void CAsset::postLoadJob(const std::shared_ptr<AssetLoadJob>& job, const AssetLoadPriority priority)
+	{
+		m_loader.post(job, priority);
+	}
+
+	size_t CAsset::loadAsyncGroup(const AssetTag& tag, const AssetLoadPriority priority)
+	{
+		size_t count = 0;
+
+		eachAssetWithTag(tag, [&](IAsset& asset)
+			{
+				asset.setLoadPriority(priority);
+
+				asset.loadAsync();
+
+				++count;
+			});
+
+		LOG_TRACE(U"ℹ️ Asset: Started loading {} assets tagged `{}`"_fmt(count, tag));
+
+		return count;
+	}
+
+	AssetLoadProgress CAsset::getGroupProgress(const AssetTag& tag)
+	{
+		AssetLoadProgress progress;
+
+		eachAssetWithTag(tag, [&](const IAsset& asset)
+			{
+				++progress.total;
+
+				switch (asset.getState())
+				{
+				case AssetState::AsyncLoading:
+					++progress.loading;
+					break;
+				case AssetState::Loaded:
+					++progress.loaded;
+					break;
+				case AssetState::Failed:
+					++progress.failed;
+					break;
+				default:
+					break;
+				}
+			});
+
+		return progress;
+	}
+
+	size_t CAsset::cancelGroup(const AssetTag& tag)
+	{
+		size_t count = 0;
+
+		eachAssetWithTag(tag, [&](IAsset& asset)
+			{
+				if (asset.cancelLoadAsync())
+				{
+					++count;
+				}
+			});
+
+		return count;
+	}
+
+	void CAsset::waitGroup(const AssetTag& tag)
+	{
+		eachAssetWithTag(tag, [&](IAsset& asset)
+			{
+				asset.wait();
+			});
+	}
 }
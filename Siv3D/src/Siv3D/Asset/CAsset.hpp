@@ -50,8 +50,23 @@ namespace s3d
 
 		HashTable<AssetName, AssetInfo> enumerate(AssetType assetType) override;
 
+		void postLoadJob(const std::shared_ptr<AssetLoadJob>& job, AssetLoadPriority priority) override;
+
+		size_t loadAsyncGroup(const AssetTag& tag, AssetLoadPriority priority) override;
+
+		AssetLoadProgress getGroupProgress(const AssetTag& tag) override;
+
+		size_t cancelGroup(const AssetTag& tag) override;
+
+		void waitGroup(const AssetTag& tag) override;
+
 	private:
 
 		std::array<HashTable<String, std::unique_ptr<IAsset>>, 5> m_assetLists;
+
+		AssetLoader m_loader{ AssetLoader::DefaultThreadCount() };
+
+		template <class Fty>
+		void eachAssetWithTag(const AssetTag& tag, Fty f);
 	};
 }
@@ -13,6 +13,7 @@
 # include <Siv3D/Common.hpp>
 # include <Siv3D/Asset.hpp>
 # include <Siv3D/HashTable.hpp>
+# include "AssetLoader.hpp"
 
 namespace s3d
 {
@@ -62,5 +63,15 @@ namespace s3d
 		virtual void unregisterAll(AssetType assetType) = 0;
 
 		virtual HashTable<AssetName, AssetInfo> enumerate(AssetType assetType) = 0;
+
+		virtual void postLoadJob(const std::shared_ptr<AssetLoadJob>& job, AssetLoadPriority priority) = 0;
+
+		virtual size_t loadAsyncGroup(const AssetTag& tag, AssetLoadPriority priority) = 0;
+
+		virtual AssetLoadProgress getGroupProgress(const AssetTag& tag) = 0;
+
+		virtual size_t cancelGroup(const AssetTag& tag) = 0;
+
+		virtual void waitGroup(const AssetTag& tag) = 0;
 	};
 }
@@ -10,6 +10,8 @@
 //-----------------------------------------------
 
 # include "IAssetDetail.hpp"
+# include "IAsset.hpp"
+# include <Siv3D/Common/Siv3DEngine.hpp>
 
 namespace s3d
 {
@@ -34,4 +36,59 @@ namespace s3d
 	{
 		return m_tags;
 	}
+
+	void IAsset::IAssetDetail::setLoadPriority(const AssetLoadPriority priority)
+	{
+		const bool raised = (m_priority < priority);
+
+		m_priority = priority;
+
+		// 待機中のジョブを新しい優先度で再投入する。先に取り出された方だけが実行される
+		if (raised && m_job && m_job->isPending())
+		{
+			SIV3D_ENGINE(Asset)->postLoadJob(m_job, m_priority);
+		}
+	}
+
+	AssetLoadPriority IAsset::IAssetDetail::getLoadPriority() const
+	{
+		return m_priority;
+	}
+
+	void IAsset::IAssetDetail::startLoadAsync(std::function<void(bool)> function)
+	{
+		m_job = std::make_shared<AssetLoadJob>(std::move(function));
+
+		SIV3D_ENGINE(Asset)->postLoadJob(m_job, m_priority);
+	}
+
+	void IAsset::IAssetDetail::waitLoadAsync()
+	{
+		if (m_job)
+		{
+			m_job->wait();
+
+			m_job.reset();
+		}
+	}
+
+	bool IAsset::IAssetDetail::cancelLoadAsync()
+	{
+		if (not m_job)
+		{
+			return false;
+		}
+
+		if (not m_job->cancel())
+		{
+			return false;
+		}
+
+		// 取り消されたジョブは、アセットを未初期化の状態に戻すだけなので、ここで実行する
+		m_job->tryRun();
+
+		m_job.reset();
+
+		return true;
+	}
 }
@@ -11,6 +11,7 @@
 
 # pragma once
 # include <Siv3D/Asset.hpp>
+# include "AssetLoader.hpp"
 
 namespace s3d
 {
@@ -32,10 +33,25 @@ namespace s3d
 		[[nodiscard]]
 		const Array<AssetTag>& getTags() const;
 
+		void setLoadPriority(AssetLoadPriority priority);
+
+		[[nodiscard]]
+		AssetLoadPriority getLoadPriority() const;
+
+		void startLoadAsync(std::function<void(bool)> function);
+
+		void waitLoadAsync();
+
+		bool cancelLoadAsync();
+
 	private:
 
 		Array<String> m_tags;
 
 		std::atomic<AssetState> m_state = AssetState::Uninitialized;
+
+		AssetLoadPriority m_priority = AssetLoadPriority::Normal;
+
+		std::shared_ptr<AssetLoadJob> m_job;
 	};
 }
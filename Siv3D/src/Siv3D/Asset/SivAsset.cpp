@@ -11,6 +11,8 @@
 
 # include <Siv3D/Asset.hpp>
 # include "IAssetDetail.hpp"
+# include "IAsset.hpp"
+# include <Siv3D/Common/Siv3DEngine.hpp>
 
 namespace s3d
 {
@@ -45,6 +47,21 @@ namespace s3d
 			|| (state == AssetState::Failed));
 	}
 
+	void IAsset::setLoadPriority(const AssetLoadPriority priority)
+	{
+		pImpl->setLoadPriority(priority);
+	}
+
+	AssetLoadPriority IAsset::getLoadPriority() const
+	{
+		return pImpl->getLoadPriority();
+	}
+
+	bool IAsset::cancelLoadAsync()
+	{
+		return pImpl->cancelLoadAsync();
+	}
+
 	bool IAsset::isUninitialized() const
 	{
 		return (pImpl->getState() == AssetState::Uninitialized);
@@ -59,4 +76,56 @@ namespace s3d
 	{
 		pImpl->setState(state);
 	}
+
+	void IAsset::startLoadAsync(std::function<bool()> load)
+	{
+		setState(AssetState::AsyncLoading);
+
+		pImpl->startLoadAsync([this, load = std::move(load)](const bool canceled)
+			{
+				if (canceled)
+				{
+					setState(AssetState::Uninitialized);
+					return;
+				}
+
+				try
+				{
+					setState(load() ? AssetState::Loaded : AssetState::Failed);
+				}
+				catch (...)
+				{
+					// ロード処理の例外でアセットローダーのスレッドを終了させない
+					setState(AssetState::Failed);
+				}
+			});
+	}
+
+	void IAsset::waitLoadAsync()
+	{
+		pImpl->waitLoadAsync();
+	}
+
+	namespace Asset
+	{
+		size_t LoadAsyncGroup(const AssetTag& tag, const AssetLoadPriority priority)
+		{
+			return SIV3D_ENGINE(Asset)->loadAsyncGroup(tag, priority);
+		}
+
+		AssetLoadProgress GetGroupProgress(const AssetTag& tag)
+		{
+			return SIV3D_ENGINE(Asset)->getGroupProgress(tag);
+		}
+
+		size_t CancelGroup(const AssetTag& tag)
+		{
+			return SIV3D_ENGINE(Asset)->cancelGroup(tag);
+		}
+
+		void WaitGroup(const AssetTag& tag)
+		{
+			SIV3D_ENGINE(Asset)->waitGroup(tag);
+		}
+	}
 }
@@ -0,0 +1,211 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+# include <cstring>
+# include <Siv3D/Compression.hpp>
+# include <Siv3D/Unicode.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include "AssetArchiveDetail.hpp"
+# include "AssetArchiveFormat.hpp"
+
+namespace s3d
+{
+	AssetArchive::AssetArchiveDetail::AssetArchiveDetail() {}
+
+	AssetArchive::AssetArchiveDetail::~AssetArchiveDetail()
+	{
+		close();
+	}
+
+	bool AssetArchive::AssetArchiveDetail::open(const FilePathView path)
+	{
+		close();
+
+		auto file = std::make_shared<MemoryMappedFileView>(path, MapAll::Yes);
+
+		if (not file->isOpen())
+		{
+			LOG_FAIL(U"❌ AssetArchive: Failed to open `{}`"_fmt(path));
+			return false;
+		}
+
+		if (file->mappedSize() != static_cast<size_t>(file->fileSize()))
+		{
+			LOG_FAIL(U"❌ AssetArchive: Failed to map `{}`"_fmt(path));
+			return false;
+		}
+
+		if (not readTOC(file->data(), file->mappedSize()))
+		{
+			LOG_FAIL(U"❌ AssetArchive: `{}` is not a valid asset archive"_fmt(path));
+			m_paths.clear();
+			m_entries.clear();
+			return false;
+		}
+
+		m_file = std::move(file);
+		m_path = path;
+
+		LOG_TRACE(U"ℹ️ AssetArchive: Opened `{}` ({} entries)"_fmt(path, m_paths.size()));
+
+		return true;
+	}
+
+	void AssetArchive::AssetArchiveDetail::close()
+	{
+		m_file.reset();
+		m_paths.clear();
+		m_entries.clear();
+		m_path.clear();
+	}
+
+	bool AssetArchive::AssetArchiveDetail::isOpen() const noexcept
+	{
+		return static_cast<bool>(m_file);
+	}
+
+	const Array<FilePath>& AssetArchive::AssetArchiveDetail::enumPaths() const noexcept
+	{
+		return m_paths;
+	}
+
+	const AssetArchive::AssetArchiveDetail::Entry* AssetArchive::AssetArchiveDetail::find(const FilePathView path) const
+	{
+		const auto it = m_entries.find(path);
+
+		if (it == m_entries.end())
+		{
+			return nullptr;
+		}
+
+		return &it->second;
+	}
+
+	const Byte* AssetArchive::AssetArchiveDetail::storedData(const Entry& entry) const noexcept
+	{
+		return (m_file->data() + entry.offset);
+	}
+
+	AssetArchive::SharedView AssetArchive::AssetArchiveDetail::acquire(const Entry& entry) const
+	{
+		if (not entry.compressed)
+		{
+			return{ m_file, storedData(entry), static_cast<size_t>(entry.originalSize) };
+		}
+
+		auto blob = std::make_shared<Blob>(extractToBlob(entry));
+
+		if (blob->size() != entry.originalSize)
+		{
+			return{};
+		}
+
+		const Byte* data = blob->data();
+		const size_t size = blob->size();
+		return{ std::move(blob), data, size };
+	}
+
+	Blob AssetArchive::AssetArchiveDetail::extractToBlob(const Entry& entry) const
+	{
+		const Byte* data = storedData(entry);
+
+		if (not entry.compressed)
+		{
+			return Blob{ data, static_cast<size_t>(entry.originalSize) };
+		}
+
+		Blob blob;
+
+		if ((not Compression::Decompress(data, static_cast<size_t>(entry.storedSize), blob))
+			|| (blob.size() != entry.originalSize))
+		{
+			LOG_FAIL(U"❌ AssetArchive: Failed to decompress an entry in `{}`"_fmt(m_path));
+			return{};
+		}
+
+		return blob;
+	}
+
+	const FilePath& AssetArchive::AssetArchiveDetail::path() const noexcept
+	{
+		return m_path;
+	}
+
+	bool AssetArchive::AssetArchiveDetail::readTOC(const Byte* data, const size_t fileSize)
+	{
+		if (fileSize < sizeof(AssetArchiveHeader))
+		{
+			return false;
+		}
+
+		AssetArchiveHeader header;
+		std::memcpy(&header, data, sizeof(header));
+
+		if ((std::memcmp(header.magic, AssetArchiveFormat::Magic, sizeof(header.magic)) != 0)
+			|| (header.version != AssetArchiveFormat::Version)
+			|| (fileSize < header.tocOffset)
+			|| ((fileSize - header.tocOffset) < header.tocSize))
+		{
+			return false;
+		}
+
+		// 目次に収まらないエントリ数を確保しないよう、先に検証する
+		if ((header.tocSize / sizeof(AssetArchiveTOCEntry)) < header.entryCount)
+		{
+			LOG_FAIL(U"❌ AssetArchive: The entry count ({}) exceeds the size of the table of contents ({} bytes)"_fmt(header.entryCount, header.tocSize));
+			return false;
+		}
+
+		const Byte* p = (data + header.tocOffset);
+		const Byte* const pEnd = (p + header.tocSize);
+
+		m_paths.reserve(header.entryCount);
+		m_entries.reserve(header.entryCount);
+
+		for (uint32 i = 0; i < header.entryCount; ++i)
+		{
+			if (static_cast<size_t>(pEnd - p) < sizeof(AssetArchiveTOCEntry))
+			{
+				return false;
+			}
+
+			AssetArchiveTOCEntry tocEntry;
+			std::memcpy(&tocEntry, p, sizeof(tocEntry));
+			p += sizeof(tocEntry);
+
+			if ((AssetArchiveFormat::MaxPathLength < tocEntry.pathLength)
+				|| (static_cast<size_t>(pEnd - p) < tocEntry.pathLength)
+				|| (header.tocOffset < tocEntry.offset)
+				|| ((header.tocOffset - tocEntry.offset) < tocEntry.storedSize))
+			{
+				return false;
+			}
+
+			const bool compressed = (tocEntry.flags & AssetArchiveFormat::FlagCompressed);
+
+			if ((not compressed) && (tocEntry.storedSize != tocEntry.originalSize))
+			{
+				return false;
+			}
+
+			FilePath path = Unicode::FromUTF8(std::string_view{ reinterpret_cast<const char*>(p), tocEntry.pathLength });
+			p += tocEntry.pathLength;
+
+			if (not m_entries.emplace(path, Entry{ tocEntry.offset, tocEntry.storedSize, tocEntry.originalSize, compressed }).second)
+			{
+				return false;
+			}
+
+			m_paths << std::move(path);
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,76 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+# pragma once
+# include <Siv3D/AssetArchive.hpp>
+# include <Siv3D/MemoryMappedFileView.hpp>
+# include <Siv3D/HashTable.hpp>
+
+namespace s3d
+{
+	class AssetArchive::AssetArchiveDetail
+	{
+	public:
+
+		struct Entry
+		{
+			uint64 offset = 0;
+
+			uint64 storedSize = 0;
+
+			uint64 originalSize = 0;
+
+			bool compressed = false;
+		};
+
+		AssetArchiveDetail();
+
+		~AssetArchiveDetail();
+
+		bool open(FilePathView path);
+
+		void close();
+
+		[[nodiscard]]
+		bool isOpen() const noexcept;
+
+		[[nodiscard]]
+		const Array<FilePath>& enumPaths() const noexcept;
+
+		[[nodiscard]]
+		const Entry* find(FilePathView path) const;
+
+		/// @brief エントリの格納されているデータの先頭へのポインタを返します。
+		[[nodiscard]]
+		const Byte* storedData(const Entry& entry) const noexcept;
+
+		[[nodiscard]]
+		SharedView acquire(const Entry& entry) const;
+
+		[[nodiscard]]
+		Blob extractToBlob(const Entry& entry) const;
+
+		[[nodiscard]]
+		const FilePath& path() const noexcept;
+
+	private:
+
+		/// @brief マップしたファイル。SharedView からも参照されるため、close() では参照を手放すだけにする
+		std::shared_ptr<const MemoryMappedFileView> m_file;
+
+		Array<FilePath> m_paths;
+
+		HashTable<FilePath, Entry> m_entries;
+
+		FilePath m_path;
+
+		bool readTOC(const Byte* data, size_t fileSize);
+	};
+}
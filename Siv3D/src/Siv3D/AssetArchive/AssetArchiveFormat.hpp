@@ -0,0 +1,73 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+# pragma once
+# include <Siv3D/Common.hpp>
+
+namespace s3d
+{
+	////////////////////////////////////////////////////////////////
+	//
+	//	アセットアーカイブ (.s3da) のファイル形式（リトルエンディアン）
+	//
+	//	[AssetArchiveHeader]
+	//	[エントリのデータ] ... 非圧縮のエントリは header.alignment の倍数の位置から始まる
+	//	[AssetArchiveTOCEntry + パス (UTF-8)] × header.entryCount
+	//
+	namespace AssetArchiveFormat
+	{
+		inline constexpr char Magic[4] = { 'S', '3', 'D', 'A' };
+
+		inline constexpr uint32 Version = 1;
+
+		/// @brief エントリのデータが zstd で圧縮されていることを表すフラグ
+		inline constexpr uint32 FlagCompressed = 0x1;
+
+		/// @brief パスの長さの上限（バイト）
+		inline constexpr uint32 MaxPathLength = 4096;
+	}
+
+	struct AssetArchiveHeader
+	{
+		char magic[4];
+
+		uint32 version;
+
+		/// @brief 目次の先頭の位置
+		uint64 tocOffset;
+
+		/// @brief 目次のサイズ（バイト）
+		uint64 tocSize;
+
+		uint32 entryCount;
+
+		/// @brief 非圧縮のエントリのアライメント
+		uint32 alignment;
+	};
+	static_assert(sizeof(AssetArchiveHeader) == 32);
+
+	struct AssetArchiveTOCEntry
+	{
+		/// @brief データの先頭の位置
+		uint64 offset;
+
+		/// @brief 格納されているデータのサイズ（バイト）
+		uint64 storedSize;
+
+		/// @brief 展開後のデータのサイズ（バイト）
+		uint64 originalSize;
+
+		uint32 flags;
+
+		/// @brief 直後に続くパス (UTF-8) の長さ（バイト）
+		uint32 pathLength;
+	};
+	static_assert(sizeof(AssetArchiveTOCEntry) == 32);
+}
@@ -0,0 +1,154 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+# include <Siv3D/AssetArchive.hpp>
+# include "AssetArchiveDetail.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// @brief 非圧縮のエントリはマップされたページから、圧縮されたエントリは展開したデータから読み込む
+		template <class Fty>
+		[[nodiscard]]
+		static auto ReadEntry(const AssetArchive& archive, const FilePathView path, Fty f)
+		{
+			if (archive.isCompressed(path))
+			{
+				return f(archive.extract(path));
+			}
+			else
+			{
+				return f(archive.view(path));
+			}
+		}
+	}
+
+	AssetArchive::AssetArchive()
+		: pImpl{ std::make_shared<AssetArchiveDetail>() } {}
+
+	AssetArchive::AssetArchive(const FilePathView path)
+		: AssetArchive{}
+	{
+		open(path);
+	}
+
+	AssetArchive::~AssetArchive()
+	{
+		// do nothing
+	}
+
+	bool AssetArchive::open(const FilePathView path)
+	{
+		return pImpl->open(path);
+	}
+
+	void AssetArchive::close()
+	{
+		pImpl->close();
+	}
+
+	bool AssetArchive::isOpen() const noexcept
+	{
+		return pImpl->isOpen();
+	}
+
+	AssetArchive::operator bool() const noexcept
+	{
+		return pImpl->isOpen();
+	}
+
+	const Array<FilePath>& AssetArchive::enumPaths() const
+	{
+		return pImpl->enumPaths();
+	}
+
+	bool AssetArchive::contains(const FilePathView path) const
+	{
+		return (pImpl->find(path) != nullptr);
+	}
+
+	bool AssetArchive::isCompressed(const FilePathView path) const
+	{
+		if (const auto* entry = pImpl->find(path))
+		{
+			return entry->compressed;
+		}
+
+		return false;
+	}
+
+	int64 AssetArchive::fileSize(const FilePathView path) const
+	{
+		if (const auto* entry = pImpl->find(path))
+		{
+			return static_cast<int64>(entry->originalSize);
+		}
+
+		return 0;
+	}
+
+	MemoryViewReader AssetArchive::view(const FilePathView path) const
+	{
+		const auto* entry = pImpl->find(path);
+
+		if ((not entry) || entry->compressed)
+		{
+			return{};
+		}
+
+		return MemoryViewReader{ pImpl->storedData(*entry), static_cast<size_t>(entry->originalSize) };
+	}
+
+	AssetArchive::SharedView AssetArchive::acquire(const FilePathView path) const
+	{
+		if (const auto* entry = pImpl->find(path))
+		{
+			return pImpl->acquire(*entry);
+		}
+
+		return{};
+	}
+
+	MemoryReader AssetArchive::extract(const FilePathView path) const
+	{
+		return MemoryReader{ extractToBlob(path) };
+	}
+
+	Blob AssetArchive::extractToBlob(const FilePathView path) const
+	{
+		if (const auto* entry = pImpl->find(path))
+		{
+			return pImpl->extractToBlob(*entry);
+		}
+
+		return{};
+	}
+
+	Image AssetArchive::loadImage(const FilePathView path, const ImageFormat format) const
+	{
+		return detail::ReadEntry(*this, path, [=](auto&& reader) { return Image{ std::move(reader), format }; });
+	}
+
+	Wave AssetArchive::loadWave(const FilePathView path, const AudioFormat format) const
+	{
+		return detail::ReadEntry(*this, path, [=](auto&& reader) { return Wave{ std::move(reader), format }; });
+	}
+
+	Texture AssetArchive::loadTexture(const FilePathView path, const TextureDesc desc) const
+	{
+		return detail::ReadEntry(*this, path, [=](auto&& reader) { return Texture{ std::move(reader), desc }; });
+	}
+
+	const FilePath& AssetArchive::path() const noexcept
+	{
+		return pImpl->path();
+	}
+}
@@ -0,0 +1,260 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <cstring>
+# include <Siv3D/BinaryWriter.hpp>
+# include <Siv3D/FileSystem.hpp>
+# include <Siv3D/Unicode.hpp>
+# include <Siv3D/Threading.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/AssetArchive/AssetArchiveFormat.hpp>
+# include "AssetArchiveWriterDetail.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// @brief 圧縮後のサイズが元のサイズのこの割合を超える場合は、非圧縮で格納する
+		inline constexpr double MaxCompressedRatio = 0.95;
+
+		/// @brief 一度に並列で読み込み・圧縮するエントリの数の、スレッドあたりの目安
+		inline constexpr size_t EntriesPerThread = 4;
+
+		struct PreparedEntry
+		{
+			Blob data;
+
+			uint64 originalSize = 0;
+
+			bool compressed = false;
+
+			bool succeeded = false;
+		};
+
+		[[nodiscard]]
+		static bool WritePadding(BinaryWriter& writer, const uint32 alignment)
+		{
+			static constexpr Byte Zeros[256] = {};
+
+			int64 padding = ((alignment - (writer.getPos() % alignment)) % alignment);
+
+			while (0 < padding)
+			{
+				const int64 size = Min<int64>(padding, sizeof(Zeros));
+
+				if (writer.write(Zeros, size) != size)
+				{
+					return false;
+				}
+
+				padding -= size;
+			}
+
+			return true;
+		}
+	}
+
+	AssetArchiveWriter::AssetArchiveWriterDetail::AssetArchiveWriterDetail() {}
+
+	AssetArchiveWriter::AssetArchiveWriterDetail::~AssetArchiveWriterDetail() {}
+
+	bool AssetArchiveWriter::AssetArchiveWriterDetail::addFile(const FilePathView sourcePath, const FilePathView archivePath, const int32 compressionLevel)
+	{
+		if (not FileSystem::IsFile(sourcePath))
+		{
+			LOG_FAIL(U"❌ AssetArchiveWriter: File `{}` not found"_fmt(sourcePath));
+			return false;
+		}
+
+		if (not reservePath(archivePath))
+		{
+			return false;
+		}
+
+		m_sources << Source{ FilePath{ archivePath }, FilePath{ sourcePath }, Blob{}, compressionLevel };
+
+		return true;
+	}
+
+	bool AssetArchiveWriter::AssetArchiveWriterDetail::addBlob(const Blob& blob, const FilePathView archivePath, const int32 compressionLevel)
+	{
+		if (not reservePath(archivePath))
+		{
+			return false;
+		}
+
+		m_sources << Source{ FilePath{ archivePath }, FilePath{}, blob, compressionLevel };
+
+		return true;
+	}
+
+	void AssetArchiveWriter::AssetArchiveWriterDetail::setAlignment(const uint32 alignment)
+	{
+		if ((alignment == 0) || ((alignment & (alignment - 1)) != 0))
+		{
+			LOG_FAIL(U"❌ AssetArchiveWriter: Alignment must be a power of two (given: {})"_fmt(alignment));
+			return;
+		}
+
+		m_alignment = alignment;
+	}
+
+	size_t AssetArchiveWriter::AssetArchiveWriterDetail::num_entries() const noexcept
+	{
+		return m_sources.size();
+	}
+
+	bool AssetArchiveWriter::AssetArchiveWriterDetail::save(const FilePathView path) const
+	{
+		BinaryWriter writer{ path };
+
+		if (not writer)
+		{
+			LOG_FAIL(U"❌ AssetArchiveWriter: Failed to create `{}`"_fmt(path));
+			return false;
+		}
+
+		// ヘッダは最後に書き込む
+		AssetArchiveHeader header{};
+		writer.write(header);
+
+		Array<Byte> toc;
+		const size_t chunkSize = ((Threading::GetWorkerCount() + 1) * detail::EntriesPerThread);
+		Array<detail::PreparedEntry> prepared;
+
+		// メモリの使用量を抑えるため、一定数ずつ読み込み・圧縮して書き出す
+		for (size_t chunkBegin = 0; chunkBegin < m_sources.size(); chunkBegin += chunkSize)
+		{
+			const size_t chunkEnd = Min((chunkBegin + chunkSize), m_sources.size());
+
+			prepared.clear();
+			prepared.resize(chunkEnd - chunkBegin);
+
+			Threading::ParallelFor((chunkEnd - chunkBegin), [&](const size_t first, const size_t last)
+			{
+				for (size_t i = first; i < last; ++i)
+				{
+					const Source& source = m_sources[chunkBegin + i];
+					detail::PreparedEntry& entry = prepared[i];
+
+					Blob data;
+
+					if (source.sourcePath)
+					{
+						// 読み込みに失敗したエントリは succeeded == false のまま残し、保存を中止させる
+						if (not data.createFromFile(source.sourcePath))
+						{
+							continue;
+						}
+					}
+					else
+					{
+						data = source.blob;
+					}
+
+					entry.originalSize = data.size();
+					entry.succeeded = true;
+
+					if ((source.compressionLevel != AssetArchiveWriter::Store) && (not data.isEmpty()))
+					{
+						Blob compressed;
+
+						if (Compression::Compress(data.data(), data.size(), compressed, source.compressionLevel)
+							&& (compressed.size() <= (data.size() * detail::MaxCompressedRatio)))
+						{
+							entry.data = std::move(compressed);
+							entry.compressed = true;
+							continue;
+						}
+					}
+
+					entry.data = std::move(data);
+				}
+			}, 1);
+
+			for (size_t i = chunkBegin; i < chunkEnd; ++i)
+			{
+				const Source& source = m_sources[i];
+				const detail::PreparedEntry& entry = prepared[i - chunkBegin];
+
+				if (not entry.succeeded)
+				{
+					LOG_FAIL(U"❌ AssetArchiveWriter: Failed to read `{}`"_fmt(source.sourcePath));
+					return false;
+				}
+
+				// 非圧縮のエントリは、マップしたページから直接読めるようアライメントを揃える
+				if ((not entry.compressed) && (not detail::WritePadding(writer, m_alignment)))
+				{
+					return false;
+				}
+
+				const std::string pathUTF8 = Unicode::ToUTF8(source.archivePath);
+
+				const AssetArchiveTOCEntry tocEntry
+				{
+					.offset			= static_cast<uint64>(writer.getPos()),
+					.storedSize		= entry.data.size(),
+					.originalSize	= entry.originalSize,
+					.flags			= (entry.compressed ? AssetArchiveFormat::FlagCompressed : 0u),
+					.pathLength		= static_cast<uint32>(pathUTF8.size()),
+				};
+
+				if (writer.write(entry.data.data(), entry.data.size()) != static_cast<int64>(entry.data.size()))
+				{
+					return false;
+				}
+
+				const Byte* pTOCEntry = reinterpret_cast<const Byte*>(&tocEntry);
+				toc.insert(toc.end(), pTOCEntry, (pTOCEntry + sizeof(tocEntry)));
+
+				const Byte* pPath = reinterpret_cast<const Byte*>(pathUTF8.data());
+				toc.insert(toc.end(), pPath, (pPath + pathUTF8.size()));
+			}
+		}
+
+		std::memcpy(header.magic, AssetArchiveFormat::Magic, sizeof(header.magic));
+		header.version		= AssetArchiveFormat::Version;
+		header.tocOffset	= static_cast<uint64>(writer.getPos());
+		header.tocSize		= toc.size();
+		header.entryCount	= static_cast<uint32>(m_sources.size());
+		header.alignment	= m_alignment;
+
+		if (writer.write(toc.data(), toc.size_bytes()) != static_cast<int64>(toc.size_bytes()))
+		{
+			return false;
+		}
+
+		writer.setPos(0);
+		writer.write(header);
+
+		LOG_TRACE(U"ℹ️ AssetArchiveWriter: Saved `{}` ({} entries)"_fmt(path, m_sources.size()));
+
+		return true;
+	}
+
+	bool AssetArchiveWriter::AssetArchiveWriterDetail::reservePath(const FilePathView archivePath)
+	{
+		if ((not archivePath) || (AssetArchiveFormat::MaxPathLength < Unicode::ToUTF8(archivePath).size()))
+		{
+			LOG_FAIL(U"❌ AssetArchiveWriter: Invalid path `{}`"_fmt(archivePath));
+			return false;
+		}
+
+		if (not m_archivePaths.emplace(archivePath).second)
+		{
+			LOG_FAIL(U"❌ AssetArchiveWriter: Path `{}` is already added"_fmt(archivePath));
+			return false;
+		}
+
+		return true;
+	}
+}
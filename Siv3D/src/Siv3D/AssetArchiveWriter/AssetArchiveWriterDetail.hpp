@@ -0,0 +1,60 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/AssetArchiveWriter.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/HashSet.hpp>
+
+namespace s3d
+{
+	class AssetArchiveWriter::AssetArchiveWriterDetail
+	{
+	public:
+
+		AssetArchiveWriterDetail();
+
+		~AssetArchiveWriterDetail();
+
+		bool addFile(FilePathView sourcePath, FilePathView archivePath, int32 compressionLevel);
+
+		bool addBlob(const Blob& blob, FilePathView archivePath, int32 compressionLevel);
+
+		void setAlignment(uint32 alignment);
+
+		[[nodiscard]]
+		size_t num_entries() const noexcept;
+
+		bool save(FilePathView path) const;
+
+	private:
+
+		struct Source
+		{
+			FilePath archivePath;
+
+			/// @brief 空の場合は blob のデータを使う
+			FilePath sourcePath;
+
+			Blob blob;
+
+			int32 compressionLevel = 0;
+		};
+
+		Array<Source> m_sources;
+
+		HashSet<FilePath> m_archivePaths;
+
+		uint32 m_alignment = DefaultAlignment;
+
+		bool reservePath(FilePathView archivePath);
+	};
+}
@@ -0,0 +1,85 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/AssetArchiveWriter.hpp>
+# include <Siv3D/FileSystem.hpp>
+# include "AssetArchiveWriterDetail.hpp"
+
+namespace s3d
+{
+	AssetArchiveWriter::AssetArchiveWriter()
+		: pImpl{ std::make_shared<AssetArchiveWriterDetail>() } {}
+
+	AssetArchiveWriter::~AssetArchiveWriter()
+	{
+		// do nothing
+	}
+
+	bool AssetArchiveWriter::addFile(const FilePathView sourcePath, const FilePathView archivePath, const int32 compressionLevel)
+	{
+		return pImpl->addFile(sourcePath, archivePath, compressionLevel);
+	}
+
+	bool AssetArchiveWriter::addBlob(const Blob& blob, const FilePathView archivePath, const int32 compressionLevel)
+	{
+		return pImpl->addBlob(blob, archivePath, compressionLevel);
+	}
+
+	size_t AssetArchiveWriter::addDirectory(const FilePathView sourceDirectory, const FilePathView archiveDirectory, const int32 compressionLevel)
+	{
+		if (not FileSystem::IsDirectory(sourceDirectory))
+		{
+			return 0;
+		}
+
+		FilePath destination{ archiveDirectory };
+
+		if (destination && (not destination.ends_with(U'/')))
+		{
+			destination.push_back(U'/');
+		}
+
+		const FilePath baseFullPath = FileSystem::FullPath(sourceDirectory);
+		size_t count = 0;
+
+		for (const auto& path : FileSystem::DirectoryContents(sourceDirectory, Recursive::Yes))
+		{
+			if (not FileSystem::IsFile(path))
+			{
+				continue;
+			}
+
+			const FilePath relativePath = FileSystem::RelativePath(path, baseFullPath);
+
+			if (pImpl->addFile(path, (destination + relativePath), compressionLevel))
+			{
+				++count;
+			}
+		}
+
+		return count;
+	}
+
+	void AssetArchiveWriter::setAlignment(const uint32 alignment)
+	{
+		pImpl->setAlignment(alignment);
+	}
+
+	size_t AssetArchiveWriter::num_entries() const noexcept
+	{
+		return pImpl->num_entries();
+	}
+
+	bool AssetArchiveWriter::save(const FilePathView path) const
+	{
+		return pImpl->save(path);
+	}
+}
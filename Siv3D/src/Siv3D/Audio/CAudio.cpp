@@ -18,6 +18,7 @@
 # include <Siv3D/AudioDecoder.hpp>
 # include <Siv3D/KlattTTSParameters.hpp>
 # include <Siv3D/DLL.hpp>
+# include <Siv3D/ProfilerZone.hpp>
 # include "CAudio.hpp"
 
 namespace s3d
@@ -197,6 +198,8 @@ namespace s3d
 
 	Audio::IDType CAudio::create(Wave&& wave, const Optional<AudioLoopTiming>& loop)
 	{
+		SIV3D_PROFILE_ZONE(U"Audio::create");
+
 		// Audio を作成
 		auto audio = std::make_unique<AudioData>(m_soloud.get(), std::move(wave), loop);
 
@@ -220,6 +223,8 @@ namespace s3d
 
 	Audio::IDType CAudio::createStreamingNonLoop(const FilePathView path)
 	{
+		SIV3D_PROFILE_ZONE(U"Audio::create");
+
 		// ストリーミングに対応しない形式の場合のフォールバック
 		if (const AudioFormat format = AudioDecoder::GetAudioFormat(path);
 			(format != AudioFormat::WAVE)
@@ -246,6 +251,8 @@ namespace s3d
 
 	Audio::IDType CAudio::createStreamingLoop(const FilePathView path, const uint64 loopBegin)
 	{
+		SIV3D_PROFILE_ZONE(U"Audio::create");
+
 		// ストリーミングに対応しない形式の場合のフォールバック
 		if (const AudioFormat format = AudioDecoder::GetAudioFormat(path);
 			(format != AudioFormat::WAVE)
@@ -15,43 +15,66 @@
 
 namespace s3d
 {
-	Emission2D CircleEmitter2D::emit(const Vec2& emitterPosition, const double startSpeed)
+	namespace detail
 	{
-		const Vec2 sourceOffset = RandomVec2(Circle{ Vec2{ 0, 0 }, sourceRadius });
-
-		Emission2D emission;
-
-		if (fromShell)
+		template <class URBG>
+		[[nodiscard]]
+		static Emission2D Emit(const CircleEmitter2D& emitter, const Vec2& emitterPosition, const double startSpeed, URBG& urbg)
 		{
-			const Vec2 v = RandomVec2();
-			const Vec2 basePos = emitterPosition.movedBy(v * r);
-			emission.position = (basePos + sourceOffset);
+			const Vec2 sourceOffset = RandomVec2(Circle{ Vec2{ 0, 0 }, emitter.sourceRadius }, urbg);
 
-			if (randomDirection)
+			Emission2D emission;
+
+			if (emitter.fromShell)
 			{
-				emission.velocity = RandomVec2(startSpeed);
+				const Vec2 v = RandomVec2(urbg);
+				const Vec2 basePos = emitterPosition.movedBy(v * emitter.r);
+				emission.position = (basePos + sourceOffset);
+
+				if (emitter.randomDirection)
+				{
+					emission.velocity = RandomVec2(startSpeed, urbg);
+				}
+				else
+				{
+					emission.velocity = (v * startSpeed);
+				}
 			}
 			else
 			{
-				emission.velocity = (v * startSpeed);
+				const Vec2 d = RandomVec2(Circle{ Vec2{0, 0}, emitter.r }, urbg);
+				emission.position = (d + emitterPosition) + sourceOffset;
+
+				if (emitter.randomDirection)
+				{
+					emission.velocity = RandomVec2(startSpeed, urbg);
+				}
+				else
+				{
+					emission.velocity = d.withLength(startSpeed);
+				}
 			}
+
+			return emission;
 		}
-		else
-		{
-			const Vec2 d = RandomVec2(Circle{ Vec2{0, 0}, r });
-			emission.position = (d + emitterPosition) + sourceOffset;
+	}
 
-			if (randomDirection)
-			{
-				emission.velocity = RandomVec2(startSpeed);
-			}
-			else
-			{
-				emission.velocity = d.withLength(startSpeed);
-			}
+	Emission2D CircleEmitter2D::emit(const Vec2& emitterPosition, const double startSpeed)
+	{
+		return detail::Emit(*this, emitterPosition, startSpeed, GetDefaultRNG());
+	}
+
+	void CircleEmitter2D::emitN(Emission2D* emissions, const size_t count, const Vec2& emitterPosition, const double startSpeed, SmallRNG& rng)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			emissions[i] = detail::Emit(*this, emitterPosition, startSpeed, rng);
 		}
+	}
 
-		return emission;
+	bool CircleEmitter2D::supportsParallelEmission() const noexcept
+	{
+		return true;
 	}
 
 	void CircleEmitter2D::drawDebug(const Vec2& emitterPosition) const
@@ -12,43 +12,143 @@
 # include <Siv3D/Compression.hpp>
 # include <Siv3D/BinaryReader.hpp>
 # include <Siv3D/BinaryWriter.hpp>
+# include <Siv3D/Unicode.hpp>
 # include <ThirdParty/zstd/zstd.h>
+# include <ThirdParty/zstd/zdict.h>
+# include <cstring>
+# include "ZstdContext.hpp"
 
 # include <Siv3D/EngineLog.hpp>
+# include <Siv3D/FormatLiteral.hpp>
 
 namespace s3d
 {
-	namespace Compression
+	namespace detail
 	{
-		Blob Compress(const void* data, const size_t size, const int32 compressionLevel)
+		/// @brief オプションを設定した圧縮コンテキスト
+		class CompressionContext
 		{
-			Blob blob;
+		public:
 
-			if (not Compress(data, size, blob, compressionLevel))
+			explicit CompressionContext(const CompressionOptions& options)
 			{
-				return{};
+				// ワーカースレッドを使うコンテキストはスレッドプールを持つため、使い捨てにする
+				if (0 < options.workers)
+				{
+					m_owned.reset(ZSTD_createCCtx());
+					m_cctx = m_owned.get();
+				}
+				else
+				{
+					m_cctx = GetThreadLocalCCtx();
+				}
+
+				if (not m_cctx)
+				{
+					return;
+				}
+
+				ZSTD_CCtx_reset(m_cctx, ZSTD_reset_session_and_parameters);
+
+				if (ZSTD_isError(ZSTD_CCtx_setParameter(m_cctx, ZSTD_c_compressionLevel, options.level)))
+				{
+					m_cctx = nullptr;
+					return;
+				}
+
+				if (0 < options.workers)
+				{
+					// マルチスレッドに対応していないビルドではエラーになるので、シングルスレッドで続ける
+					if (ZSTD_isError(ZSTD_CCtx_setParameter(m_cctx, ZSTD_c_nbWorkers, options.workers)))
+					{
+						LOG_FAIL(U"❌ Compression: Multithreaded compression is not supported in this build");
+					}
+				}
+
+				if (options.longDistanceMatching)
+				{
+					ZSTD_CCtx_setParameter(m_cctx, ZSTD_c_enableLongDistanceMatching, 1);
+				}
 			}
 
-			return blob;
-		}
+			[[nodiscard]]
+			explicit operator bool() const noexcept
+			{
+				return (m_cctx != nullptr);
+			}
 
-		bool Compress(const void* data, const size_t size, Blob& dst, const int32 compressionLevel)
-		{
-			const size_t bufferSize = ZSTD_compressBound(size);
+			[[nodiscard]]
+			ZSTD_CCtx* get() const noexcept
+			{
+				return m_cctx;
+			}
 
-			dst.resize(bufferSize);
+		private:
 
-			const size_t result = ZSTD_compress(dst.data(), dst.size(), data, size, compressionLevel);
+			std::unique_ptr<ZSTD_CCtx, CCtxDeleter> m_owned;
 
-			if (ZSTD_isError(result))
+			ZSTD_CCtx* m_cctx = nullptr;
+		};
+
+		/// @brief read(buffer, size) で読み込んだ入力を圧縮し、write(data, size) で書き出します。
+		template <class Reader, class Writer>
+		[[nodiscard]]
+		static bool CompressStream(ZSTD_CCtx* cctx, Reader read, Writer write)
+		{
+			const size_t inputBufferSize = ZSTD_CStreamInSize();
+			const auto pInputBuffer = std::make_unique<Byte[]>(inputBufferSize);
+
+			const size_t outputBufferSize = ZSTD_CStreamOutSize();
+			const auto pOutputBuffer = std::make_unique<Byte[]>(outputBufferSize);
+
+			for (;;)
 			{
-				dst.clear();
-				return false;
+				const size_t readSize = read(pInputBuffer.get(), inputBufferSize);
+				const ZSTD_EndDirective mode = ((readSize < inputBufferSize) ? ZSTD_e_end : ZSTD_e_continue);
+
+				ZSTD_inBuffer input = { pInputBuffer.get(), readSize, 0 };
+
+				for (;;)
+				{
+					ZSTD_outBuffer output = { pOutputBuffer.get(), outputBufferSize, 0 };
+
+					const size_t remaining = ZSTD_compressStream2(cctx, &output, &input, mode);
+
+					if (ZSTD_isError(remaining))
+					{
+						return false;
+					}
+
+					if (output.pos && (not write(pOutputBuffer.get(), output.pos)))
+					{
+						return false;
+					}
+
+					// ZSTD_e_end ではすべて書き出すまで、ZSTD_e_continue では入力を使い切るまで続ける
+					if ((mode == ZSTD_e_end) ? (remaining == 0) : (input.pos == input.size))
+					{
+						break;
+					}
+				}
+
+				if (mode == ZSTD_e_end)
+				{
+					return true;
+				}
 			}
+		}
+	}
 
-			dst.resize(result);
+	namespace Compression
+	{
+		Blob Compress(const void* data, const size_t size, const int32 compressionLevel)
+		{
+			return Compress(data, size, CompressionOptions{ .level = compressionLevel });
+		}
 
-			return true;
+		bool Compress(const void* data, const size_t size, Blob& dst, const int32 compressionLevel)
+		{
+			return Compress(data, size, dst, CompressionOptions{ .level = compressionLevel });
 		}
 
 		Blob Compress(const Blob& blob, const int32 compressionLevel)
@@ -61,11 +161,11 @@ namespace s3d
 			return Compress(blob.data(), blob.size(), dst, compressionLevel);
 		}
 
-		Blob CompressFile(const FilePathView path, const int32 compressionLevel)
+		Blob Compress(const void* data, const size_t size, const CompressionOptions& options)
 		{
 			Blob blob;
 
-			if (not CompressFile(path, blob, compressionLevel))
+			if (not Compress(data, size, blob, options))
 			{
 				return{};
 			}
@@ -73,173 +173,153 @@ namespace s3d
 			return blob;
 		}
 
-		bool CompressFile(const FilePathView path, Blob& dst, const int32 compressionLevel)
+		bool Compress(const void* data, const size_t size, Blob& dst, const CompressionOptions& options)
 		{
-			dst.clear();
-
-			BinaryReader reader{ path };
+			const detail::CompressionContext context{ options };
 
-			if (not reader)
+			if (not context)
 			{
+				dst.clear();
 				return false;
 			}
 
-			const size_t inputBufferSize = ZSTD_CStreamInSize();
-			const auto pInputBuffer = std::make_unique<Byte[]>(inputBufferSize);
+			const size_t bufferSize = ZSTD_compressBound(size);
 
-			const size_t outputBufferSize = ZSTD_CStreamOutSize();
-			const auto pOutputBuffer = std::make_unique<Byte[]>(outputBufferSize);
+			dst.resize(bufferSize);
 
-			ZSTD_CStream* const cStream = ZSTD_createCStream();
+			const size_t result = ZSTD_compress2(context.get(), dst.data(), dst.size(), data, size);
 
-			if (not cStream)
+			if (ZSTD_isError(result))
 			{
+				dst.clear();
 				return false;
 			}
 
-			if (const size_t ret = ZSTD_initCStream(cStream, compressionLevel); 
-				ZSTD_isError(ret))
-			{
-				ZSTD_freeCStream(cStream);
-				return false;
-			}
+			dst.resize(result);
 
-			size_t toRead = inputBufferSize;
+			return true;
+		}
 
-			while (const size_t read = static_cast<size_t>(reader.read(pInputBuffer.get(), toRead)))
-			{
-				ZSTD_inBuffer input = { pInputBuffer.get(), read, 0 };
+		Blob Compress(const Blob& blob, const CompressionOptions& options)
+		{
+			return Compress(blob.data(), blob.size(), options);
+		}
 
-				while (input.pos < input.size)
-				{
-					ZSTD_outBuffer output = { pOutputBuffer.get(), outputBufferSize, 0 };
+		bool Compress(const Blob& blob, Blob& dst, const CompressionOptions& options)
+		{
+			return Compress(blob.data(), blob.size(), dst, options);
+		}
 
-					toRead = ZSTD_compressStream(cStream, &output, &input);
+		Blob CompressFile(const FilePathView path, const int32 compressionLevel)
+		{
+			return CompressFile(path, CompressionOptions{ .level = compressionLevel });
+		}
 
-					if (ZSTD_isError(toRead))
-					{
-						ZSTD_freeCStream(cStream);
-						return false;
-					}
+		bool CompressFile(const FilePathView path, Blob& dst, const int32 compressionLevel)
+		{
+			return CompressFile(path, dst, CompressionOptions{ .level = compressionLevel });
+		}
 
-					if (toRead > inputBufferSize)
-					{
-						toRead = inputBufferSize;
-					}
+		Blob CompressFile(const FilePathView path, const CompressionOptions& options)
+		{
+			Blob blob;
 
-					dst.append(pOutputBuffer.get(), output.pos);
-				}
+			if (not CompressFile(path, blob, options))
+			{
+				return{};
 			}
 
-			ZSTD_outBuffer output = { pOutputBuffer.get(), outputBufferSize, 0 };
+			return blob;
+		}
+
+		bool CompressFile(const FilePathView path, Blob& dst, const CompressionOptions& options)
+		{
+			dst.clear();
+
+			BinaryReader reader{ path };
 
-			const size_t remainingToFlush = ZSTD_endStream(cStream, &output);
+			if (not reader)
+			{
+				return false;
+			}
 
-			ZSTD_freeCStream(cStream);
+			const detail::CompressionContext context{ options };
 
-			if (remainingToFlush)
+			if (not context)
 			{
 				return false;
 			}
 
-			dst.append(pOutputBuffer.get(), output.pos);
+			if (not detail::CompressStream(context.get(),
+				[&](void* buffer, const size_t size) { return static_cast<size_t>(reader.read(buffer, size)); },
+				[&](const void* data, const size_t size) { dst.append(data, size); return true; }))
+			{
+				dst.clear();
+				return false;
+			}
 
 			return true;
 		}
 
 		bool CompressToFile(const void* data, const size_t size, const FilePathView outputPath, const int32 compressionLevel)
 		{
-			const size_t inputBufferSize = ZSTD_CStreamInSize();
-			const size_t outputBufferSize = ZSTD_CStreamOutSize();
-			const auto pOutputBuffer = std::make_unique<Byte[]>(outputBufferSize);
+			return CompressToFile(data, size, outputPath, CompressionOptions{ .level = compressionLevel });
+		}
 
-			ZSTD_CStream* const cStream = ZSTD_createCStream();
+		bool CompressToFile(const Blob& blob, const FilePathView outputPath, const int32 compressionLevel)
+		{
+			return CompressToFile(blob.data(), blob.size(), outputPath, compressionLevel);
+		}
 
-			if (not cStream)
-			{
-				return false;
-			}
+		bool CompressToFile(const void* data, const size_t size, const FilePathView outputPath, const CompressionOptions& options)
+		{
+			const detail::CompressionContext context{ options };
 
-			if (const size_t ret = ZSTD_initCStream(cStream, compressionLevel); 
-				ZSTD_isError(ret))
+			if (not context)
 			{
-				ZSTD_freeCStream(cStream);
 				return false;
 			}
 
-			size_t toRead = inputBufferSize;
-
 			BinaryWriter writer{ outputPath };
 
 			if (not writer)
 			{
-				ZSTD_freeCStream(cStream);
 				return false;
 			}
 
-			size_t readPos = 0;
-
-			for (;;)
-			{
-				const size_t read = Min(toRead, (size - readPos));
-
-				if (read == 0)
-				{
-					break;
-				}
-
-				ZSTD_inBuffer input = { (static_cast<const Byte*>(data) + readPos), read, 0 };
+			// 入力全体のサイズを伝えると、圧縮データにサイズが記録され、ワーカースレッドへの分割も効率的になる
+			ZSTD_CCtx_setPledgedSrcSize(context.get(), size);
 
-				readPos += read;
+			size_t readPos = 0;
 
-				while (input.pos < input.size)
+			if (not detail::CompressStream(context.get(),
+				[&](void* buffer, const size_t bufferSize)
 				{
-					ZSTD_outBuffer output = { pOutputBuffer.get(), outputBufferSize, 0 };
-
-					toRead = ZSTD_compressStream(cStream, &output, &input);
-
-					if (ZSTD_isError(toRead))
-					{
-						writer.clear();
-
-						ZSTD_freeCStream(cStream);
-
-						return false;
-					}
-
-					if (toRead > inputBufferSize)
-					{
-						toRead = inputBufferSize;
-					}
-
-					writer.write(pOutputBuffer.get(), output.pos);
-				}
-			}
-
-			ZSTD_outBuffer output = { pOutputBuffer.get(), outputBufferSize, 0 };
-
-			const size_t remainingToFlush = ZSTD_endStream(cStream, &output);
-
-			ZSTD_freeCStream(cStream);
-
-			if (remainingToFlush)
+					const size_t read = Min(bufferSize, (size - readPos));
+					std::memcpy(buffer, (static_cast<const Byte*>(data) + readPos), read);
+					readPos += read;
+					return read;
+				},
+				[&](const void* output, const size_t outputSize) { return (writer.write(output, outputSize) == static_cast<int64>(outputSize)); }))
 			{
 				writer.clear();
-
 				return false;
 			}
 
-			writer.write(pOutputBuffer.get(), output.pos);
-
 			return true;
 		}
 
-		bool CompressToFile(const Blob& blob, const FilePathView outputPath, const int32 compressionLevel)
+		bool CompressToFile(const Blob& blob, const FilePathView outputPath, const CompressionOptions& options)
 		{
-			return CompressToFile(blob.data(), blob.size(), outputPath, compressionLevel);
+			return CompressToFile(blob.data(), blob.size(), outputPath, options);
 		}
 
 		bool CompressFileToFile(const FilePathView inputPath, const FilePathView outputPath, const int32 compressionLevel)
+		{
+			return CompressFileToFile(inputPath, outputPath, CompressionOptions{ .level = compressionLevel });
+		}
+
+		bool CompressFileToFile(const FilePathView inputPath, const FilePathView outputPath, const CompressionOptions& options)
 		{
 			BinaryReader reader{ inputPath };
 
@@ -248,79 +328,30 @@ namespace s3d
 				return false;
 			}
 
-			const size_t inputBufferSize = ZSTD_CStreamInSize();
-			const auto pInputBuffer = std::make_unique<Byte[]>(inputBufferSize);
-
-			const size_t outputBufferSize = ZSTD_CStreamOutSize();
-			const auto pOutputBuffer = std::make_unique<Byte[]>(outputBufferSize);
-
-			ZSTD_CStream* const cStream = ZSTD_createCStream();
+			const detail::CompressionContext context{ options };
 
-			if (not cStream)
+			if (not context)
 			{
 				return false;
 			}
 
-			if (const size_t ret = ZSTD_initCStream(cStream, compressionLevel); 
-				ZSTD_isError(ret))
-			{
-				ZSTD_freeCStream(cStream);
-				return false;
-			}
-
-			size_t toRead = inputBufferSize;
-
 			BinaryWriter writer{ outputPath };
 
 			if (not writer)
 			{
-				ZSTD_freeCStream(cStream);
 				return false;
 			}
 
-			while (const size_t read = static_cast<size_t>(reader.read(pInputBuffer.get(), toRead)))
-			{
-				ZSTD_inBuffer input = { pInputBuffer.get(), read, 0 };
-
-				while (input.pos < input.size)
-				{
-					ZSTD_outBuffer output = { pOutputBuffer.get(), outputBufferSize, 0 };
-
-					toRead = ZSTD_compressStream(cStream, &output, &input);
-
-					if (ZSTD_isError(toRead))
-					{
-						writer.clear();
-
-						ZSTD_freeCStream(cStream);
-
-						return false;
-					}
-
-					if (toRead > inputBufferSize)
-					{
-						toRead = inputBufferSize;
-					}
-
-					writer.write(pOutputBuffer.get(), output.pos);
-				}
-			}
-
-			ZSTD_outBuffer output = { pOutputBuffer.get(), outputBufferSize, 0 };
-
-			const size_t remainingToFlush = ZSTD_endStream(cStream, &output);
-
-			ZSTD_freeCStream(cStream);
+			ZSTD_CCtx_setPledgedSrcSize(context.get(), static_cast<unsigned long long>(reader.size()));
 
-			if (remainingToFlush)
+			if (not detail::CompressStream(context.get(),
+				[&](void* buffer, const size_t size) { return static_cast<size_t>(reader.read(buffer, size)); },
+				[&](const void* output, const size_t outputSize) { return (writer.write(output, outputSize) == static_cast<int64>(outputSize)); }))
 			{
 				writer.clear();
-
 				return false;
 			}
 
-			writer.write(pOutputBuffer.get(), output.pos);
-
 			return true;
 		}
 
@@ -607,5 +638,94 @@ namespace s3d
 
 			return true;
 		}
+
+		Blob TrainDictionary(const Array<Blob>& samples, const size_t maxDictionarySize)
+		{
+			if (samples.isEmpty() || (maxDictionarySize == 0))
+			{
+				return{};
+			}
+
+			// ZDICT はサンプルを連結したバッファと、各サンプルのサイズの配列を受け取る
+			Blob buffer;
+			Array<size_t> sampleSizes;
+			sampleSizes.reserve(samples.size());
+
+			for (const auto& sample : samples)
+			{
+				buffer.append(sample.data(), sample.size());
+				sampleSizes << sample.size();
+			}
+
+			Blob dictionary;
+			dictionary.resize(maxDictionarySize);
+
+			const size_t result = ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(),
+				buffer.data(), sampleSizes.data(), static_cast<unsigned>(sampleSizes.size()));
+
+			if (ZDICT_isError(result))
+			{
+				LOG_FAIL(U"❌ Compression::TrainDictionary(): {}"_fmt(Unicode::Widen(ZDICT_getErrorName(result))));
+				return{};
+			}
+
+			dictionary.resize(result);
+
+			return dictionary;
+		}
+
+		Blob CompressWithDictionary(const void* data, const size_t size, const CompressionDictionary& dictionary)
+		{
+			Blob blob;
+
+			if (not dictionary.compress(data, size, blob))
+			{
+				return{};
+			}
+
+			return blob;
+		}
+
+		bool CompressWithDictionary(const void* data, const size_t size, Blob& dst, const CompressionDictionary& dictionary)
+		{
+			return dictionary.compress(data, size, dst);
+		}
+
+		Blob CompressWithDictionary(const Blob& blob, const CompressionDictionary& dictionary)
+		{
+			return CompressWithDictionary(blob.data(), blob.size(), dictionary);
+		}
+
+		bool CompressWithDictionary(const Blob& blob, Blob& dst, const CompressionDictionary& dictionary)
+		{
+			return dictionary.compress(blob.data(), blob.size(), dst);
+		}
+
+		Blob DecompressWithDictionary(const void* data, const size_t size, const CompressionDictionary& dictionary)
+		{
+			Blob blob;
+
+			if (not dictionary.decompress(data, size, blob))
+			{
+				return{};
+			}
+
+			return blob;
+		}
+
+		bool DecompressWithDictionary(const void* data, const size_t size, Blob& dst, const CompressionDictionary& dictionary)
+		{
+			return dictionary.decompress(data, size, dst);
+		}
+
+		Blob DecompressWithDictionary(const Blob& blob, const CompressionDictionary& dictionary)
+		{
+			return DecompressWithDictionary(blob.data(), blob.size(), dictionary);
+		}
+
+		bool DecompressWithDictionary(const Blob& blob, Blob& dst, const CompressionDictionary& dictionary)
+		{
+			return dictionary.decompress(blob.data(), blob.size(), dst);
+		}
 	}
 }
@@ -0,0 +1,53 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <memory>
+# include <ThirdParty/zstd/zstd.h>
+
+namespace s3d
+{
+	namespace detail
+	{
+		struct CCtxDeleter
+		{
+			void operator ()(ZSTD_CCtx* p) const noexcept
+			{
+				ZSTD_freeCCtx(p);
+			}
+		};
+
+		struct DCtxDeleter
+		{
+			void operator ()(ZSTD_DCtx* p) const noexcept
+			{
+				ZSTD_freeDCtx(p);
+			}
+		};
+
+		/// @brief 呼び出し元のスレッドで再利用する圧縮コンテキストを返します。
+		/// @remark コンテキストの作成と破棄のコストを、小さなデータの圧縮のたびに払わないようにする
+		[[nodiscard]]
+		inline ZSTD_CCtx* GetThreadLocalCCtx()
+		{
+			thread_local const std::unique_ptr<ZSTD_CCtx, CCtxDeleter> cctx{ ZSTD_createCCtx() };
+			return cctx.get();
+		}
+
+		/// @brief 呼び出し元のスレッドで再利用する展開コンテキストを返します。
+		[[nodiscard]]
+		inline ZSTD_DCtx* GetThreadLocalDCtx()
+		{
+			thread_local const std::unique_ptr<ZSTD_DCtx, DCtxDeleter> dctx{ ZSTD_createDCtx() };
+			return dctx.get();
+		}
+	}
+}
@@ -0,0 +1,175 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <memory>
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/Compression/ZstdContext.hpp>
+# include "CompressionDictionaryDetail.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// @brief フレームに記録された展開後のサイズを信用して、一度に確保するサイズの上限
+		/// @remark これより大きい場合や不明な場合は、実際に展開できた分だけ確保するストリーム展開を使う
+		inline constexpr size_t MaxSingleShotDecompressSize = (64 << 20);
+	}
+
+	CompressionDictionary::CompressionDictionaryDetail::CompressionDictionaryDetail() {}
+
+	CompressionDictionary::CompressionDictionaryDetail::CompressionDictionaryDetail(const Blob& dictionary, const int32 compressionLevel)
+	{
+		if (dictionary.isEmpty())
+		{
+			return;
+		}
+
+		m_cDict = ZSTD_createCDict(dictionary.data(), dictionary.size(), compressionLevel);
+		m_dDict = ZSTD_createDDict(dictionary.data(), dictionary.size());
+
+		if ((not m_cDict) || (not m_dDict))
+		{
+			LOG_FAIL(U"❌ CompressionDictionary: Failed to load the dictionary");
+
+			ZSTD_freeCDict(m_cDict);
+			m_cDict = nullptr;
+
+			ZSTD_freeDDict(m_dDict);
+			m_dDict = nullptr;
+
+			return;
+		}
+
+		m_data = dictionary;
+		m_id = ZSTD_getDictID_fromDict(dictionary.data(), dictionary.size());
+	}
+
+	CompressionDictionary::CompressionDictionaryDetail::~CompressionDictionaryDetail()
+	{
+		ZSTD_freeCDict(m_cDict);
+
+		ZSTD_freeDDict(m_dDict);
+	}
+
+	bool CompressionDictionary::CompressionDictionaryDetail::isEmpty() const noexcept
+	{
+		return (m_cDict == nullptr);
+	}
+
+	uint32 CompressionDictionary::CompressionDictionaryDetail::id() const noexcept
+	{
+		return m_id;
+	}
+
+	const Blob& CompressionDictionary::CompressionDictionaryDetail::data() const noexcept
+	{
+		return m_data;
+	}
+
+	bool CompressionDictionary::CompressionDictionaryDetail::compress(const void* data, const size_t size, Blob& dst) const
+	{
+		dst.clear();
+
+		ZSTD_CCtx* const cctx = detail::GetThreadLocalCCtx();
+
+		if ((not m_cDict) || (not cctx))
+		{
+			return false;
+		}
+
+		dst.resize(ZSTD_compressBound(size));
+
+		const size_t result = ZSTD_compress_usingCDict(cctx, dst.data(), dst.size(), data, size, m_cDict);
+
+		if (ZSTD_isError(result))
+		{
+			dst.clear();
+			return false;
+		}
+
+		dst.resize(result);
+
+		return true;
+	}
+
+	bool CompressionDictionary::CompressionDictionaryDetail::decompress(const void* data, const size_t size, Blob& dst) const
+	{
+		dst.clear();
+
+		ZSTD_DCtx* const dctx = detail::GetThreadLocalDCtx();
+
+		if ((not m_dDict) || (not dctx))
+		{
+			return false;
+		}
+
+		const unsigned long long contentSize = ZSTD_getFrameContentSize(data, size);
+
+		if (contentSize == ZSTD_CONTENTSIZE_ERROR)
+		{
+			return false;
+		}
+
+		// 展開後のサイズがわかり、十分に小さい場合は、一度で展開する
+		// 壊れたデータや悪意のあるデータが巨大なサイズを記録していても、その分を確保しない
+		if ((contentSize != ZSTD_CONTENTSIZE_UNKNOWN)
+			&& (contentSize <= detail::MaxSingleShotDecompressSize))
+		{
+			dst.resize(static_cast<size_t>(contentSize));
+
+			const size_t result = ZSTD_decompress_usingDDict(dctx, dst.data(), dst.size(), data, size, m_dDict);
+
+			if (ZSTD_isError(result) || (result != dst.size()))
+			{
+				dst.clear();
+				return false;
+			}
+
+			return true;
+		}
+
+		ZSTD_DCtx_reset(dctx, ZSTD_reset_session_and_parameters);
+
+		if (ZSTD_isError(ZSTD_DCtx_refDDict(dctx, m_dDict)))
+		{
+			return false;
+		}
+
+		const size_t outputBufferSize = ZSTD_DStreamOutSize();
+		const auto pOutputBuffer = std::make_unique<Byte[]>(outputBufferSize);
+
+		ZSTD_inBuffer input = { data, size, 0 };
+		size_t remaining = 1;
+
+		while ((input.pos < input.size) || (remaining != 0))
+		{
+			ZSTD_outBuffer output = { pOutputBuffer.get(), outputBufferSize, 0 };
+
+			remaining = ZSTD_decompressStream(dctx, &output, &input);
+
+			if (ZSTD_isError(remaining)
+				|| ((output.pos == 0) && (input.pos == input.size) && (remaining != 0)))
+			{
+				// 壊れたデータや途中で切れたデータ
+				dst.clear();
+				ZSTD_DCtx_reset(dctx, ZSTD_reset_session_and_parameters);
+				return false;
+			}
+
+			dst.append(pOutputBuffer.get(), output.pos);
+		}
+
+		// スレッドで共有するコンテキストに辞書の参照を残さない
+		ZSTD_DCtx_reset(dctx, ZSTD_reset_session_and_parameters);
+
+		return true;
+	}
+}
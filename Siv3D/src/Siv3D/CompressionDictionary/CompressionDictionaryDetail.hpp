@@ -0,0 +1,52 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Compression.hpp>
+# include <ThirdParty/zstd/zstd.h>
+
+namespace s3d
+{
+	class CompressionDictionary::CompressionDictionaryDetail
+	{
+	public:
+
+		CompressionDictionaryDetail();
+
+		CompressionDictionaryDetail(const Blob& dictionary, int32 compressionLevel);
+
+		~CompressionDictionaryDetail();
+
+		[[nodiscard]]
+		bool isEmpty() const noexcept;
+
+		[[nodiscard]]
+		uint32 id() const noexcept;
+
+		[[nodiscard]]
+		const Blob& data() const noexcept;
+
+		bool compress(const void* data, size_t size, Blob& dst) const;
+
+		bool decompress(const void* data, size_t size, Blob& dst) const;
+
+	private:
+
+		Blob m_data;
+
+		// 辞書の解析結果。作成後は読み取り専用なので、複数のスレッドから同時に参照できる
+		ZSTD_CDict* m_cDict = nullptr;
+
+		ZSTD_DDict* m_dDict = nullptr;
+
+		uint32 m_id = 0;
+	};
+}
@@ -0,0 +1,57 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/Compression.hpp>
+# include "CompressionDictionaryDetail.hpp"
+
+namespace s3d
+{
+	CompressionDictionary::CompressionDictionary()
+		: pImpl{ std::make_shared<CompressionDictionaryDetail>() } {}
+
+	CompressionDictionary::CompressionDictionary(const Blob& dictionary, const int32 compressionLevel)
+		: pImpl{ std::make_shared<CompressionDictionaryDetail>(dictionary, compressionLevel) } {}
+
+	CompressionDictionary::~CompressionDictionary()
+	{
+		// do nothing
+	}
+
+	bool CompressionDictionary::isEmpty() const noexcept
+	{
+		return pImpl->isEmpty();
+	}
+
+	CompressionDictionary::operator bool() const noexcept
+	{
+		return (not isEmpty());
+	}
+
+	uint32 CompressionDictionary::id() const noexcept
+	{
+		return pImpl->id();
+	}
+
+	const Blob& CompressionDictionary::data() const noexcept
+	{
+		return pImpl->data();
+	}
+
+	bool CompressionDictionary::compress(const void* data, const size_t size, Blob& dst) const
+	{
+		return pImpl->compress(data, size, dst);
+	}
+
+	bool CompressionDictionary::decompress(const void* data, const size_t size, Blob& dst) const
+	{
+		return pImpl->decompress(data, size, dst);
+	}
+}
@@ -57,6 +57,8 @@ namespace s3d
 
 		Font::IDType create(Typeface typeface, FontMethod fontMethod, int32 fontSize, FontStyle style) override;
 
+		Font::IDType create(std::shared_ptr<const void> memoryOwner, const void* data, size_t size, size_t faceIndex, FontMethod fontMethod, int32 fontSize, FontStyle style) override;
+
 		void release(Font::IDType handleID) override;
 
 		bool addFallbackFont(Font::IDType handleID, const std::weak_ptr<AssetHandle<Font>::AssetIDWrapperType>& font) override;
@@ -107,8 +109,12 @@ namespace s3d
 	
 		bool preload(Font::IDType handleID, StringView chars) override;
 
+		bool preloadAsync(Font::IDType handleID, StringView chars) override;
+
 		const Texture& getTexture(Font::IDType handleID) override;
 
+		GlyphCacheStat getGlyphCacheStat(Font::IDType handleID) override;
+
 		Glyph getGlyph(Font::IDType handleID, StringView ch) override;
 
 		Array<Glyph> getGlyphs(Font::IDType handleID, StringView s) override;
@@ -167,5 +173,7 @@ namespace s3d
 		std::unique_ptr<EmojiData> m_defaultEmoji;
 
 		Array<std::unique_ptr<IconData>> m_defaultIcons;
+
+		Font::IDType addFont(std::unique_ptr<FontData>&& font);
 	};
 }
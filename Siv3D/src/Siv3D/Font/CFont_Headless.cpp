@@ -104,19 +104,7 @@ namespace s3d
 	Font::IDType CFont_Headless::create(const FilePathView path, const size_t faceIndex, const FontMethod fontMethod, const int32 fontSize, const FontStyle style)
 	{
 		// Font を作成
-		auto font = std::make_unique<FontData>(m_freeType, path, faceIndex, fontMethod, fontSize, style);
-
-		if (not font->isInitialized()) // もし作成に失敗していたら
-		{
-			return Font::IDType::NullAsset();
-		}
-
-		const auto& prop = font->getProperty();
-		const String fontName = (prop.styleName) ? (prop.familiyName + U' ' + prop.styleName) : (prop.familiyName);
-		const String info = U"(`{0}`, size: {1}, style: {2}, ascender: {3}, descender: {4})"_fmt(fontName, prop.fontPixelSize, detail::ToString(prop.style), prop.ascender, prop.descender);
-
-		// Font を管理に登録
-		return m_fonts.add(std::move(font), info);
+		return addFont(std::make_unique<FontData>(m_freeType, path, faceIndex, fontMethod, fontSize, style));
 	}
 
 	Font::IDType CFont_Headless::create(const Typeface typeface, const FontMethod fontMethod, const int32 fontSize, const FontStyle style)
@@ -126,6 +114,12 @@ namespace s3d
 		return create(info.path, info.faceIndex, fontMethod, fontSize, style);
 	}
 
+	Font::IDType CFont_Headless::create(std::shared_ptr<const void> memoryOwner, const void* data, const size_t size, const size_t faceIndex, const FontMethod fontMethod, const int32 fontSize, const FontStyle style)
+	{
+		// Font を作成
+		return addFont(std::make_unique<FontData>(m_freeType, std::move(memoryOwner), data, size, faceIndex, fontMethod, fontSize, style));
+	}
+
 	void CFont_Headless::release(const Font::IDType handleID)
 	{
 		m_fonts.erase(handleID);
@@ -265,11 +259,23 @@ namespace s3d
 		return font->getGlyphCache().preload(*font, chars);
 	}
 
+	bool CFont_Headless::preloadAsync(const Font::IDType handleID, const StringView chars)
+	{
+		const auto& font = m_fonts[handleID];
+
+		return font->getGlyphCache().preloadAsync(*font, chars);
+	}
+
 	const Texture& CFont_Headless::getTexture(const Font::IDType handleID)
 	{
 		return m_fonts[handleID]->getGlyphCache().getTexture();
 	}
 
+	GlyphCacheStat CFont_Headless::getGlyphCacheStat(const Font::IDType handleID)
+	{
+		return m_fonts[handleID]->getGlyphCache().getStat();
+	}
+
 	Glyph CFont_Headless::getGlyph(const Font::IDType handleID, const StringView ch)
 	{
 		if (not ch)
@@ -519,4 +525,19 @@ namespace s3d
 	{
 		return *m_emptyPixelShader;
 	}
+
+	Font::IDType CFont_Headless::addFont(std::unique_ptr<FontData>&& font)
+	{
+		if (not font->isInitialized()) // もし作成に失敗していたら
+		{
+			return Font::IDType::NullAsset();
+		}
+
+		const auto& prop = font->getProperty();
+		const String fontName = (prop.styleName) ? (prop.familiyName + U' ' + prop.styleName) : (prop.familiyName);
+		const String info = U"(`{0}`, size: {1}, style: {2}, ascender: {3}, descender: {4})"_fmt(fontName, prop.fontPixelSize, detail::ToString(prop.style), prop.ascender, prop.descender);
+
+		// Font を管理に登録
+		return m_fonts.add(std::move(font), info);
+	}
 }
@@ -9,7 +9,11 @@
 //
 //-----------------------------------------------
 
+# include <array>
 # include <Siv3D/FileSystem.hpp>
+# include <Siv3D/Hash.hpp>
+# include <Siv3D/MemoryMappedFileView.hpp>
+# include <Siv3D/CacheDirectory/CacheDirectory.hpp>
 # include <Siv3D/Font/IFont.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 # include <Siv3D/EngineLog.hpp>
@@ -25,6 +29,30 @@
 
 namespace s3d
 {
+	namespace detail
+	{
+		[[nodiscard]]
+		static uint64 MakeGlyphCacheKey(const uint64 fileHash, const size_t faceIndex, const FontMethod fontMethod, const int32 fontSize, const FontStyle style)
+		{
+			const std::array<uint64, 5> values =
+			{
+				fileHash,
+				static_cast<uint64>(faceIndex),
+				static_cast<uint64>(FromEnum(fontMethod)),
+				static_cast<uint64>(fontSize),
+				static_cast<uint64>(FromEnum(style)),
+			};
+
+			return Hash::XXHash3(values.data(), sizeof(values));
+		}
+
+		[[nodiscard]]
+		static FilePath GetGlyphCachePath(const uint64 key)
+		{
+			return (CacheDirectory::Engine() + U"font/glyph/{:0>16X}.bin"_fmt(key));
+		}
+	}
+
 	FontData::FontData(Null)
 	{
 		m_glyphCache = std::make_unique<BitmapGlyphCache>();
@@ -62,6 +90,48 @@ namespace s3d
 
 	# endif
 
+		init(faceIndex, fontMethod, fontSize, style, [&]()
+			{
+				uint64 fileHash = 0;
+
+			# if SIV3D_PLATFORM(WINDOWS)
+
+				if (FileSystem::IsResource(path))
+				{
+					fileHash = Hash::XXHash3(m_resource.data(), static_cast<size_t>(m_resource.size()));
+				}
+
+			# endif
+
+				if (not fileHash)
+				{
+					if (const MemoryMappedFileView view{ path };
+						view && view.mappedSize())
+					{
+						fileHash = Hash::XXHash3(view.data(), view.mappedSize());
+					}
+				}
+
+				return fileHash;
+			});
+	}
+
+	FontData::FontData(const FT_Library library, std::shared_ptr<const void> memoryOwner, const void* data, const size_t size, const size_t faceIndex, const FontMethod fontMethod, const int32 fontSize, const FontStyle style)
+		: m_memoryOwner{ std::move(memoryOwner) }
+	{
+		if (not m_fontFace.load(library, data, size, faceIndex, fontSize, style, fontMethod))
+		{
+			return;
+		}
+
+		init(faceIndex, fontMethod, fontSize, style, [=]()
+			{
+				return Hash::XXHash3(data, size);
+			});
+	}
+
+	void FontData::init(const size_t faceIndex, FontMethod fontMethod, const int32 fontSize, const FontStyle style, const std::function<uint64()>& getFileHash)
+	{
 		if (((fontMethod == FontMethod::SDF) || (fontMethod == FontMethod::MSDF))
 			&& (not FT_IS_SCALABLE(m_fontFace.getFT_Face())))
 		{
@@ -82,6 +152,18 @@ namespace s3d
 			break;
 		}
 
+		// SDF / MSDF のグリフの生成は重いため、キャッシュをファイルに保存して次回の起動時に再利用する
+		if ((fontMethod == FontMethod::SDF) || (fontMethod == FontMethod::MSDF))
+		{
+			const uint64 fileHash = getFileHash();
+
+			if (fileHash)
+			{
+				const uint64 key = detail::MakeGlyphCacheKey(fileHash, faceIndex, fontMethod, fontSize, style);
+				m_glyphCache->setPersistentCache(detail::GetGlyphCachePath(key), key);
+			}
+		}
+
 		m_method = fontMethod;
 
 		m_initialized = true;
@@ -89,7 +171,10 @@ namespace s3d
 
 	FontData::~FontData()
 	{
-
+		if (m_glyphCache)
+		{
+			m_glyphCache->storePersistentCache();
+		}
 	}
 
 	bool FontData::isInitialized() const noexcept
@@ -320,6 +405,16 @@ namespace s3d
 		return RenderMSDFGlyph(m_fontFace.getFT_Face(), glyphIndex, buffer, m_fontFace.getProperty());
 	}
 
+	std::function<SDFGlyph()> FontData::prepareSDFByGlyphIndex(const GlyphIndex glyphIndex, const int32 buffer) const
+	{
+		return PrepareSDFGlyph(m_fontFace.getFT_Face(), glyphIndex, buffer, m_fontFace.getProperty());
+	}
+
+	std::function<MSDFGlyph()> FontData::prepareMSDFByGlyphIndex(const GlyphIndex glyphIndex, const int32 buffer) const
+	{
+		return PrepareMSDFGlyph(m_fontFace.getFT_Face(), glyphIndex, buffer, m_fontFace.getProperty());
+	}
+
 	IGlyphCache& FontData::getGlyphCache() const
 	{
 		return *m_glyphCache;
@@ -32,6 +32,10 @@ namespace s3d
 
 		FontData(FT_Library library, FilePathView path, size_t faceIndex, FontMethod fontMethod, int32 fontSize, FontStyle style);
 
+		/// @brief メモリ上のフォントファイルからフォントを作成します。
+		/// @param memoryOwner data の寿命を管理するオブジェクト。フォントが破棄されるまで保持される
+		FontData(FT_Library library, std::shared_ptr<const void> memoryOwner, const void* data, size_t size, size_t faceIndex, FontMethod fontMethod, int32 fontSize, FontStyle style);
+
 		~FontData();
 
 		[[nodiscard]]
@@ -78,6 +82,16 @@ namespace s3d
 		[[nodiscard]]
 		MSDFGlyph renderMSDFByGlyphIndex(GlyphIndex glyphIndex, int32 buffer) const;
 
+		/// @brief SDF をワーカースレッドで生成するための関数を返します。
+		/// @remark アウトラインの読み込みはこの関数内で行われます。
+		[[nodiscard]]
+		std::function<SDFGlyph()> prepareSDFByGlyphIndex(GlyphIndex glyphIndex, int32 buffer) const;
+
+		/// @brief MSDF をワーカースレッドで生成するための関数を返します。
+		/// @remark アウトラインの読み込みはこの関数内で行われます。
+		[[nodiscard]]
+		std::function<MSDFGlyph()> prepareMSDFByGlyphIndex(GlyphIndex glyphIndex, int32 buffer) const;
+
 		[[nodiscard]]
 		IGlyphCache& getGlyphCache() const;
 
@@ -95,6 +109,9 @@ namespace s3d
 
 	# endif
 
+		/// @brief FreeType が参照するメモリ上のフォントファイル。m_fontFace より後に破棄する
+		std::shared_ptr<const void> m_memoryOwner;
+
 		FontFace m_fontFace;
 
 		Array<std::weak_ptr<AssetHandle<Font>::AssetIDWrapperType>> m_fallbackFonts;
@@ -104,5 +121,7 @@ namespace s3d
 		std::unique_ptr<IGlyphCache> m_glyphCache;
 
 		bool m_initialized = false;
+
+		void init(size_t faceIndex, FontMethod fontMethod, int32 fontSize, FontStyle style, const std::function<uint64()>& getFileHash);
 	};
 }
@@ -12,6 +12,7 @@
 # include <Siv3D/TextureRegion.hpp>
 # include <Siv3D/Math.hpp>
 # include <Siv3D/System.hpp>
+# include <Siv3D/ProfilerZone.hpp>
 # include <Siv3D/Font/IFont.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 # include "BitmapGlyphCache.hpp"
@@ -24,7 +25,7 @@ namespace s3d
 		{
 			return RectF{ 0 };
 		}
-		updateTexture();
+		m_atlas.updateTexture();
 
 		const auto& prop = font.getProperty();
 		const double scale = (size / prop.fontPixelSize);
@@ -65,7 +66,7 @@ namespace s3d
 
 			const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
 			{
-				const TextureRegion textureRegion = m_texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+				const TextureRegion textureRegion = m_atlas.getTextureRegion(cache);
 				const Vec2 posOffset = usebasePos ? cache.info.getBase(scale) : cache.info.getOffset(scale);
 				const Vec2 drawPos = (penPos + posOffset);
 
@@ -103,7 +104,7 @@ namespace s3d
 		{
 			// do tnohing
 		}
-		updateTexture();
+		m_atlas.updateTexture();
 
 		const double dotXAdvance = m_glyphTable.find(dotGlyphCluster[0].glyphIndex)->second.info.xAdvance;
 		const Vec2 areaBottomRight = area.br();
@@ -255,7 +256,7 @@ namespace s3d
 			{
 				const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
 				{
-					const TextureRegion textureRegion = m_texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+					const TextureRegion textureRegion = m_atlas.getTextureRegion(cache);
 					const Vec2 posOffset = cache.info.getOffset(scale);
 					const Vec2 drawPos = (newPenPositions[i] + posOffset);
 
@@ -283,7 +284,7 @@ namespace s3d
 		{
 			return RectF{ 0 };
 		}
-		updateTexture();
+		m_atlas.updateTexture();
 
 		const auto& prop = font.getProperty();
 		const double scale = (size / prop.fontPixelSize);
@@ -296,7 +297,7 @@ namespace s3d
 		{
 			const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
 			{
-				const TextureRegion textureRegion = m_texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+				const TextureRegion textureRegion = m_atlas.getTextureRegion(cache);
 				const Vec2 posOffset = usebasePos ? cache.info.getBase(scale) : cache.info.getOffset(scale);
 				const Vec2 drawPos = (penPos + posOffset);
 
@@ -482,11 +483,17 @@ namespace s3d
 		return prerender(font, font.getGlyphClusters(s, false), true);
 	}
 
+	bool BitmapGlyphCache::preloadAsync(const FontData& font, const StringView s)
+	{
+		// ビットマップのラスタライズは FT_Face を使うため、ワーカースレッドでは行わない
+		return preload(font, s);
+	}
+
 	const Texture& BitmapGlyphCache::getTexture() noexcept
 	{
-		updateTexture();
+		m_atlas.updateTexture();
 
-		return m_texture;
+		return m_atlas.getTexture();
 	}
 
 	TextureRegion BitmapGlyphCache::getTextureRegion(const FontData& font, const GlyphIndex glyphIndex)
@@ -495,10 +502,10 @@ namespace s3d
 		{
 			return{};
 		}
-		updateTexture();
+		m_atlas.updateTexture();
 
 		const auto& cache = m_glyphTable.find(glyphIndex)->second;
-		return m_texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+		return m_atlas.getTextureRegion(cache);
 	}
 
 	int32 BitmapGlyphCache::getBufferThickness(const GlyphIndex)
@@ -508,16 +515,19 @@ namespace s3d
 
 	bool BitmapGlyphCache::prerender(const FontData& font, const Array<GlyphCluster>& clusters, const bool isMainFont)
 	{
-		if (m_glyphTable.empty())
+		SIV3D_PROFILE_ZONE(U"GlyphCache::prerender");
+
+		// 新しいグリフの登録によって、このフレームで描画するグリフのページが追い出されないようにする
+		m_atlas.touchGlyphs(clusters, isMainFont, m_glyphTable);
+
+		if (not m_glyphTable.contains(0))
 		{
 			const BitmapGlyph glyph = font.renderBitmapByGlyphIndex(0);
 
-			if (not CacheGlyph(font, glyph.image, glyph, m_buffer, m_glyphTable))
+			if (not m_atlas.cacheGlyph(font, glyph.image, glyph, m_glyphTable))
 			{
 				return false;
 			}
-
-			m_hasDirty = true;
 		}
 
 		for (const auto& cluster : clusters)
@@ -539,39 +549,33 @@ namespace s3d
 				continue;
 			}
 
-			if (not CacheGlyph(font, glyph.image, glyph, m_buffer, m_glyphTable))
+			if (not m_atlas.cacheGlyph(font, glyph.image, glyph, m_glyphTable))
 			{
 				return false;
 			}
-
-			m_hasDirty = true;
 		}
 
 		// texture content can be updated in a different thread
 		if (System::GetRendererType() == EngineOption::Renderer::Direct3D11)
 		{
-			updateTexture();
+			m_atlas.updateTexture();
 		}
 
 		return true;
 	}
 
-	void BitmapGlyphCache::updateTexture()
+	GlyphCacheStat BitmapGlyphCache::getStat() const
 	{
-		if (not m_hasDirty)
-		{
-			return;
-		}
+		return m_atlas.getStat(m_glyphTable);
+	}
 
-		if (m_texture.size() == m_buffer.image.size())
-		{
-			m_texture.fill(m_buffer.image);
-		}
-		else
-		{
-			m_texture = DynamicTexture{ m_buffer.image };
-		}
+	void BitmapGlyphCache::setPersistentCache(FilePathView, uint64)
+	{
+		// ビットマップのキャッシュは永続化しない
+	}
 
-		m_hasDirty = false;
+	bool BitmapGlyphCache::storePersistentCache() const
+	{
+		return true;
 	}
 }
@@ -50,6 +50,8 @@ namespace s3d
 
 		bool preload(const FontData & font, StringView s) override;
 
+		bool preloadAsync(const FontData& font, StringView s) override;
+
 		[[nodiscard]]
 		const Texture& getTexture() noexcept override;
 
@@ -59,19 +61,21 @@ namespace s3d
 		[[nodiscard]]
 		int32 getBufferThickness(GlyphIndex glyphIndex) override;
 
-	private:
+		[[nodiscard]]
+		GlyphCacheStat getStat() const override;
 
-		HashTable<GlyphIndex, GlyphCache> m_glyphTable;
+		void setPersistentCache(FilePathView path, uint64 key) override;
 
-		DynamicTexture m_texture;
+		bool storePersistentCache() const override;
 
-		bool m_hasDirty = false;
+	private:
+
+		HashTable<GlyphIndex, GlyphCache> m_glyphTable;
 
-		BufferImage m_buffer = {};
+		GlyphAtlas m_atlas;
 
 		[[nodiscard]]
 		bool prerender(const FontData& font, const Array<GlyphCluster>& clusters, bool isMainFont);
 
-		void updateTexture();
 	};
 }
@@ -9,10 +9,115 @@
 //
 //-----------------------------------------------
 
+# include <cstring>
+# include <Siv3D/BinaryWriter.hpp>
+# include <Siv3D/MemoryMappedFileView.hpp>
+# include <Siv3D/FileSystem.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/Scene/IScene.hpp>
+# include <Siv3D/Common/Siv3DEngine.hpp>
 # include "GlyphCacheCommon.hpp"
 
 namespace s3d
 {
+	namespace detail
+	{
+		uint64 GetCurrentFrame()
+		{
+			return SIV3D_ENGINE(Scene)->getFrameCounter().getSystemFrameCount();
+		}
+
+		//
+		//	グリフキャッシュファイルの形式
+		//
+		//	[PersistentCacheHeader]
+		//	[PersistentCachePageHeader][Color * width * height] * pageCount
+		//	[PersistentCacheGlyph] * glyphCount
+		//
+		struct PersistentCacheHeader
+		{
+			static constexpr uint32 Signature = 0x43475333; // "3SGC"
+
+			static constexpr uint32 FormatVersion = 1;
+
+			uint32 signature = Signature;
+
+			uint32 version = FormatVersion;
+
+			uint64 key = 0;
+
+			int32 bufferWidth = 0;
+
+			uint32 pageCount = 0;
+
+			uint32 currentPage = 0;
+
+			uint32 glyphCount = 0;
+		};
+
+		struct PersistentCachePageHeader
+		{
+			int32 width = 0;
+
+			int32 height = 0;
+
+			Point penPos = { 0, 0 };
+
+			int32 currentMaxHeight = 0;
+		};
+
+		struct PersistentCacheGlyph
+		{
+			GlyphIndex glyphIndex = 0;
+
+			GlyphCache cache;
+		};
+
+		/// @brief キャッシュファイルに書き込むグリフのエントリを作成します。
+		/// @remark キャッシュファイルの内容が常に同じになるよう、パディングを 0 で埋めてからメンバを 1 つずつ代入します。
+		[[nodiscard]]
+		static PersistentCacheGlyph MakePersistentCacheGlyph(const GlyphIndex glyphIndex, const GlyphCache& cache) noexcept
+		{
+			PersistentCacheGlyph glyph;
+			std::memset(static_cast<void*>(&glyph), 0, sizeof(glyph));
+
+			glyph.glyphIndex					= glyphIndex;
+			glyph.cache.info.glyphIndex			= cache.info.glyphIndex;
+			glyph.cache.info.buffer				= cache.info.buffer;
+			glyph.cache.info.left				= cache.info.left;
+			glyph.cache.info.top				= cache.info.top;
+			glyph.cache.info.width				= cache.info.width;
+			glyph.cache.info.height				= cache.info.height;
+			glyph.cache.info.ascender			= cache.info.ascender;
+			glyph.cache.info.descender			= cache.info.descender;
+			glyph.cache.info.xAdvance			= cache.info.xAdvance;
+			glyph.cache.info.yAdvance			= cache.info.yAdvance;
+			glyph.cache.textureRegionLeft		= cache.textureRegionLeft;
+			glyph.cache.textureRegionTop		= cache.textureRegionTop;
+			glyph.cache.textureRegionWidth		= cache.textureRegionWidth;
+			glyph.cache.textureRegionHeight		= cache.textureRegionHeight;
+			glyph.cache.page					= cache.page;
+
+			return glyph;
+		}
+
+		template <class Type>
+		[[nodiscard]]
+		static bool ReadValue(const MemoryMappedFileView& view, size_t& offset, Type& value)
+		{
+			static_assert(std::is_trivially_copyable_v<Type>);
+
+			if (view.mappedSize() < (offset + sizeof(Type)))
+			{
+				return false;
+			}
+
+			std::memcpy(static_cast<void*>(&value), (view.data() + offset), sizeof(Type));
+			offset += sizeof(Type);
+			return true;
+		}
+	}
+
 	double GetTabAdvance(const double spaceWidth, const double scale, const double baseX, const double currentX, const int32 indentSize)
 	{
 		const double maxTabWidth = (spaceWidth * scale * indentSize);
@@ -46,58 +151,396 @@ namespace s3d
 		return true;
 	}
 
-	bool CacheGlyph(const FontData& font, const Image& image, const GlyphInfo& glyphInfo,
-		BufferImage& buffer, HashTable<GlyphIndex, GlyphCache>& glyphTable)
+	GlyphAtlas::GlyphAtlas(const Color& backgroundColor) noexcept
+		: m_backgroundColor{ backgroundColor } {}
+
+	int32 GlyphAtlas::getBufferWidth() const noexcept
+	{
+		return m_bufferWidth;
+	}
+
+	void GlyphAtlas::setBufferWidth(const int32 width) noexcept
+	{
+		m_bufferWidth = Max(width, 0);
+	}
+
+	void GlyphAtlas::touch(const GlyphCache& cache)
 	{
-		if (not buffer.image)
+		++m_stat.hitCount;
+
+		m_pages[cache.page].lastUsedFrame = detail::GetCurrentFrame();
+	}
+
+	void GlyphAtlas::touchGlyphs(const Array<GlyphCluster>& clusters, const bool isMainFont, const HashTable<GlyphIndex, GlyphCache>& glyphTable)
+	{
+		// .notdef はグリフが欠けたときの代替として参照されるので、統計には含めずに常に使用中にする
+		if (auto it = glyphTable.find(0);
+			it != glyphTable.end())
 		{
-			const int32 fontSize = font.getProperty().fontPixelSize;
-			const int32 baseWidth =
-				fontSize <= 16 ? 512 :
-				fontSize <= 32 ? 768 :
-				fontSize <= 48 ? 1024 :
-				fontSize <= 64 ? 1536 :
-				fontSize <= 256 ? 2048 : 4096;
-			const int32 baseHeight = (fontSize <= 256 ? 256 : 512);
-			buffer.image.resize(baseWidth, baseHeight, buffer.backgroundColor);
+			m_pages[it->second.page].lastUsedFrame = detail::GetCurrentFrame();
 		}
 
-		buffer.penPos.x += buffer.padding;
+		for (const auto& cluster : clusters)
+		{
+			if (isMainFont && (cluster.fontIndex != 0))
+			{
+				continue;
+			}
 
-		const int32 bitmapWidth		= image.width();
-		const int32 bitmapHeight	= image.height();
+			if (auto it = glyphTable.find(cluster.glyphIndex);
+				it != glyphTable.end())
+			{
+				touch(it->second);
+			}
+		}
+	}
 
-		if (buffer.image.width() < (buffer.penPos.x + (bitmapWidth + buffer.padding)))
+	bool GlyphAtlas::cacheGlyph(const FontData& font, const Image& image, const GlyphInfo& glyphInfo, HashTable<GlyphIndex, GlyphCache>& glyphTable)
+	{
+		if (not m_pages)
 		{
-			buffer.penPos.x = buffer.padding;
-			buffer.penPos.y += (buffer.currentMaxHeight + (buffer.padding * 2));
-			buffer.currentMaxHeight = 0;
+			addPage(font);
 		}
 
-		if (buffer.image.height() < (buffer.penPos.y + (bitmapHeight + buffer.padding)))
-		{
-			const int32 newHeight = ((buffer.penPos.y + (bitmapHeight + buffer.padding)) + 255) / 256 * 256;
+		const Size bitmapSize = image.size();
+		Point penPos{ 0, 0 };
 
-			if (BufferImage::MaxImageHeight < newHeight)
+		if (not allocate(m_pages[m_currentPage], bitmapSize, penPos))
+		{
+			if (m_pages.size() < MaxPages)
+			{
+				addPage(font);
+			}
+			else if (const auto pageIndex = findLeastRecentlyUsedPage(detail::GetCurrentFrame()))
 			{
+				evictPage(*pageIndex, glyphTable);
+				m_currentPage = *pageIndex;
+			}
+			else
+			{
+				// すべてのページが現在のフレームで使用中
 				return false;
 			}
 
-			buffer.image.resizeRows(newHeight, buffer.backgroundColor);
+			if (not allocate(m_pages[m_currentPage], bitmapSize, penPos))
+			{
+				return false;
+			}
 		}
 
-		image.overwrite(buffer.image, buffer.penPos);
+		Page& page = m_pages[m_currentPage];
+		image.overwrite(page.image, penPos);
+		page.lastUsedFrame = detail::GetCurrentFrame();
+
+		const Rect glyphRect{ penPos, bitmapSize };
+
+		if (page.dirtyRect.hasArea())
+		{
+			const int32 left	= Min(page.dirtyRect.x, glyphRect.x);
+			const int32 top		= Min(page.dirtyRect.y, glyphRect.y);
+			const int32 right	= Max(page.dirtyRect.br().x, glyphRect.br().x);
+			const int32 bottom	= Max(page.dirtyRect.br().y, glyphRect.br().y);
+			page.dirtyRect.set(left, top, (right - left), (bottom - top));
+		}
+		else
+		{
+			page.dirtyRect = glyphRect;
+		}
 
 		GlyphCache cache;
 		cache.info					= glyphInfo;
-		cache.textureRegionLeft		= static_cast<int16>(buffer.penPos.x);
-		cache.textureRegionTop		= static_cast<int16>(buffer.penPos.y);
-		cache.textureRegionWidth	= static_cast<int16>(bitmapWidth);
-		cache.textureRegionHeight	= static_cast<int16>(bitmapHeight);
+		cache.textureRegionLeft		= static_cast<int16>(penPos.x);
+		cache.textureRegionTop		= static_cast<int16>(penPos.y);
+		cache.textureRegionWidth	= static_cast<int16>(bitmapSize.x);
+		cache.textureRegionHeight	= static_cast<int16>(bitmapSize.y);
+		cache.page					= static_cast<uint16>(m_currentPage);
 		glyphTable.emplace(glyphInfo.glyphIndex, cache);
 
-		buffer.currentMaxHeight = Max(buffer.currentMaxHeight, bitmapHeight);
-		buffer.penPos.x += (bitmapWidth + buffer.padding);
+		++m_stat.missCount;
+		m_modified = true;
+
+		return true;
+	}
+
+	TextureRegion GlyphAtlas::getTextureRegion(const GlyphCache& cache) const
+	{
+		return m_pages[cache.page].texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+	}
+
+	const Texture& GlyphAtlas::getTexture() const noexcept
+	{
+		static const Texture emptyTexture;
+
+		if (not m_pages)
+		{
+			return emptyTexture;
+		}
+
+		return m_pages.front().texture;
+	}
+
+	void GlyphAtlas::updateTexture()
+	{
+		for (auto& page : m_pages)
+		{
+			if (page.texture.size() != page.image.size())
+			{
+				page.texture = DynamicTexture{ page.image };
+			}
+			else if (page.dirtyRect.hasArea())
+			{
+				page.texture.fillRegion(page.image, page.dirtyRect);
+			}
+
+			page.dirtyRect.set(0, 0, 0, 0);
+		}
+	}
+
+	GlyphCacheStat GlyphAtlas::getStat(const HashTable<GlyphIndex, GlyphCache>& glyphTable) const noexcept
+	{
+		GlyphCacheStat stat = m_stat;
+		stat.pageCount	= static_cast<uint32>(m_pages.size());
+		stat.glyphCount	= static_cast<uint32>(glyphTable.size());
+		return stat;
+	}
+
+	void GlyphAtlas::setPersistentCache(const FilePathView path, const uint64 key)
+	{
+		m_persistentCachePath	= path;
+		m_persistentCacheKey	= key;
+	}
+
+	void GlyphAtlas::restorePersistentCache(HashTable<GlyphIndex, GlyphCache>& glyphTable)
+	{
+		if (m_persistentCacheRestored)
+		{
+			return;
+		}
+
+		m_persistentCacheRestored = true;
+
+		if ((not m_persistentCachePath) || m_pages || (not FileSystem::Exists(m_persistentCachePath)))
+		{
+			return;
+		}
+
+		const MemoryMappedFileView view{ m_persistentCachePath };
+
+		if (not view)
+		{
+			return;
+		}
+
+		size_t offset = 0;
+		detail::PersistentCacheHeader header;
+
+		if ((not detail::ReadValue(view, offset, header))
+			|| (header.signature != detail::PersistentCacheHeader::Signature)
+			|| (header.version != detail::PersistentCacheHeader::FormatVersion)
+			|| (header.key != m_persistentCacheKey)
+			|| (header.bufferWidth != m_bufferWidth)
+			|| (MaxPages < header.pageCount)
+			|| (header.pageCount <= header.currentPage))
+		{
+			LOG_INFO(U"ℹ️ Glyph cache file `{}` is outdated"_fmt(m_persistentCachePath));
+			return;
+		}
+
+		Array<Page> pages(header.pageCount);
+
+		for (auto& page : pages)
+		{
+			detail::PersistentCachePageHeader pageHeader;
+
+			if ((not detail::ReadValue(view, offset, pageHeader))
+				|| (not InRange(pageHeader.height, 0, MaxPageHeight))
+				|| (not InRange(pageHeader.width, 0, 4096)))
+			{
+				return;
+			}
+
+			const size_t imageSize = (static_cast<size_t>(pageHeader.width) * pageHeader.height * sizeof(Color));
+
+			if (view.mappedSize() < (offset + imageSize))
+			{
+				return;
+			}
+
+			page.image.resize(pageHeader.width, pageHeader.height);
+			std::memcpy(page.image.data(), (view.data() + offset), imageSize);
+			offset += imageSize;
+
+			page.penPos				= pageHeader.penPos;
+			page.currentMaxHeight	= pageHeader.currentMaxHeight;
+			page.dirtyRect.set(Point{ 0, 0 }, page.image.size());
+		}
+
+		HashTable<GlyphIndex, GlyphCache> table;
+		table.reserve(header.glyphCount);
+
+		for (uint32 i = 0; i < header.glyphCount; ++i)
+		{
+			detail::PersistentCacheGlyph glyph;
+
+			if ((not detail::ReadValue(view, offset, glyph))
+				|| (header.pageCount <= glyph.cache.page))
+			{
+				return;
+			}
+
+			table.emplace(glyph.glyphIndex, glyph.cache);
+		}
+
+		m_pages			= std::move(pages);
+		m_currentPage	= header.currentPage;
+		glyphTable		= std::move(table);
+
+		LOG_INFO(U"ℹ️ {} glyphs restored from `{}`"_fmt(glyphTable.size(), m_persistentCachePath));
+	}
+
+	bool GlyphAtlas::storePersistentCache(const HashTable<GlyphIndex, GlyphCache>& glyphTable) const
+	{
+		if ((not m_persistentCachePath) || (not m_modified) || (not m_pages))
+		{
+			return true;
+		}
+
+		// 書き込み途中のファイルを読み込まないよう、一時ファイルに書き込んでから置き換える
+		const FilePath temporaryPath = (m_persistentCachePath + U".tmp");
+		{
+			BinaryWriter writer{ temporaryPath };
+
+			if (not writer)
+			{
+				return false;
+			}
+
+			detail::PersistentCacheHeader header;
+			header.key			= m_persistentCacheKey;
+			header.bufferWidth	= m_bufferWidth;
+			header.pageCount	= static_cast<uint32>(m_pages.size());
+			header.currentPage	= static_cast<uint32>(m_currentPage);
+			header.glyphCount	= static_cast<uint32>(glyphTable.size());
+			writer.write(header);
+
+			for (const auto& page : m_pages)
+			{
+				detail::PersistentCachePageHeader pageHeader;
+				pageHeader.width			= page.image.width();
+				pageHeader.height			= page.image.height();
+				pageHeader.penPos			= page.penPos;
+				pageHeader.currentMaxHeight	= page.currentMaxHeight;
+				writer.write(pageHeader);
+				writer.write(page.image.data(), page.image.size_bytes());
+			}
+
+			for (const auto& [glyphIndex, cache] : glyphTable)
+			{
+				writer.write(detail::MakePersistentCacheGlyph(glyphIndex, cache));
+			}
+		}
+
+		if (not FileSystem::Rename(temporaryPath, m_persistentCachePath))
+		{
+			FileSystem::Remove(temporaryPath);
+			return false;
+		}
+
+		return true;
+	}
+
+	void GlyphAtlas::addPage(const FontData& font)
+	{
+		const int32 fontSize = font.getProperty().fontPixelSize;
+		const int32 baseWidth =
+			fontSize <= 16 ? 512 :
+			fontSize <= 32 ? 768 :
+			fontSize <= 48 ? 1024 :
+			fontSize <= 64 ? 1536 :
+			fontSize <= 256 ? 2048 : 4096;
+		const int32 baseHeight = (fontSize <= 256 ? 256 : 512);
+
+		Page page;
+		page.image.resize(baseWidth, baseHeight, m_backgroundColor);
+		page.penPos = { 0, m_padding };
+
+		m_pages.push_back(std::move(page));
+		m_currentPage = (m_pages.size() - 1);
+	}
+
+	void GlyphAtlas::evictPage(const size_t pageIndex, HashTable<GlyphIndex, GlyphCache>& glyphTable)
+	{
+		for (auto it = glyphTable.begin(); it != glyphTable.end();)
+		{
+			if (it->second.page == pageIndex)
+			{
+				it = glyphTable.erase(it);
+				++m_stat.evictedGlyphCount;
+			}
+			else
+			{
+				++it;
+			}
+		}
+
+		Page& page = m_pages[pageIndex];
+
+		// 古いグリフがバイリニア補間で滲まないよう、ページ全体を消去する
+		page.image.fill(m_backgroundColor);
+		page.penPos = { 0, m_padding };
+		page.currentMaxHeight = 0;
+		page.dirtyRect.set(Point{ 0, 0 }, page.image.size());
+
+		++m_stat.evictedPageCount;
+	}
+
+	Optional<size_t> GlyphAtlas::findLeastRecentlyUsedPage(const uint64 currentFrame) const
+	{
+		Optional<size_t> result;
+
+		for (size_t i = 0; i < m_pages.size(); ++i)
+		{
+			// 現在のフレームで使用したページは、描画コマンドから参照されている可能性があるので追い出さない
+			if (currentFrame <= m_pages[i].lastUsedFrame)
+			{
+				continue;
+			}
+
+			if ((not result) || (m_pages[i].lastUsedFrame < m_pages[*result].lastUsedFrame))
+			{
+				result = i;
+			}
+		}
+
+		return result;
+	}
+
+	bool GlyphAtlas::allocate(Page& page, const Size& size, Point& pos)
+	{
+		page.penPos.x += m_padding;
+
+		if (page.image.width() < (page.penPos.x + (size.x + m_padding)))
+		{
+			page.penPos.x = m_padding;
+			page.penPos.y += (page.currentMaxHeight + (m_padding * 2));
+			page.currentMaxHeight = 0;
+		}
+
+		if (page.image.height() < (page.penPos.y + (size.y + m_padding)))
+		{
+			const int32 newHeight = ((page.penPos.y + (size.y + m_padding)) + 255) / 256 * 256;
+
+			if (MaxPageHeight < newHeight)
+			{
+				return false;
+			}
+
+			page.image.resizeRows(newHeight, m_backgroundColor);
+		}
+
+		pos = page.penPos;
+		page.currentMaxHeight = Max(page.currentMaxHeight, size.y);
+		page.penPos.x += (size.x + m_padding);
 
 		return true;
 	}
@@ -14,6 +14,13 @@
 # include <Siv3D/GlyphInfo.hpp>
 # include <Siv3D/Image.hpp>
 # include <Siv3D/HashTable.hpp>
+# include <Siv3D/Optional.hpp>
+# include <Siv3D/DynamicTexture.hpp>
+# include <Siv3D/TextureRegion.hpp>
+# include <Siv3D/GlyphCacheStat.hpp>
+# include <Siv3D/AsyncTask.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include <Siv3D/FormatLiteral.hpp>
 # include "../FontData.hpp"
 
 namespace s3d
@@ -29,23 +36,268 @@ namespace s3d
 		int16 textureRegionWidth = 0;
 
 		int16 textureRegionHeight = 0;
+
+		/// @brief グリフが格納されているページのインデックス
+		uint16 page = 0;
 	};
 
-	struct BufferImage
+	/// @brief 複数ページのキャッシュテクスチャにグリフを詰め込むアトラス
+	/// @remark すべてのページが埋まると、現在のフレームで使われていないページのうち最も長く使われていないページを追い出して再利用します。
+	/// @remark テクスチャの更新は、前回の更新以降に書き込まれた領域に限定されます。
+	class GlyphAtlas
 	{
-		static constexpr int32 MaxImageHeight = 4096;
+	public:
+
+		/// @brief 1 ページあたりの最大の高さ（ピクセル）
+		static constexpr int32 MaxPageHeight = 2048;
+
+		/// @brief 最大のページ数
+		static constexpr size_t MaxPages = 4;
+
+		GlyphAtlas() = default;
+
+		explicit GlyphAtlas(const Color& backgroundColor) noexcept;
+
+		[[nodiscard]]
+		int32 getBufferWidth() const noexcept;
+
+		void setBufferWidth(int32 width) noexcept;
+
+		/// @brief キャッシュ済みのグリフを参照したことを記録します。
+		/// @param cache グリフ
+		void touch(const GlyphCache& cache);
+
+		/// @brief これから描画するグリフと .notdef グリフのページを現在のフレームで使用中として記録し、追い出されないようにします。
+		/// @remark 新しいグリフを登録する前に呼び出す必要があります。
+		/// @param clusters 描画するグリフクラスタ
+		/// @param isMainFont メインのフォントの場合 true, フォールバックフォントの場合 false
+		/// @param glyphTable グリフテーブル
+		void touchGlyphs(const Array<GlyphCluster>& clusters, bool isMainFont, const HashTable<GlyphIndex, GlyphCache>& glyphTable);
+
+		/// @brief グリフの画像をアトラスに書き込み、グリフテーブルに登録します。
+		/// @param font フォント
+		/// @param image グリフの画像
+		/// @param glyphInfo グリフの情報
+		/// @param glyphTable グリフテーブル。ページを追い出した場合、そのページにあったグリフはテーブルから削除されます。
+		/// @return 登録に成功した場合 true, 空き領域が無い場合 false
+		[[nodiscard]]
+		bool cacheGlyph(const FontData& font, const Image& image, const GlyphInfo& glyphInfo, HashTable<GlyphIndex, GlyphCache>& glyphTable);
+
+		[[nodiscard]]
+		TextureRegion getTextureRegion(const GlyphCache& cache) const;
+
+		/// @brief 最初のページのテクスチャを返します。
+		[[nodiscard]]
+		const Texture& getTexture() const noexcept;
+
+		void updateTexture();
+
+		[[nodiscard]]
+		GlyphCacheStat getStat(const HashTable<GlyphIndex, GlyphCache>& glyphTable) const noexcept;
+
+		/// @brief アトラスの内容を永続化するキャッシュファイルを設定します。
+		/// @param path キャッシュファイルのパス
+		/// @param key フォントファイルと設定から作られるキー。キーが一致しないキャッシュファイルは使用されません。
+		void setPersistentCache(FilePathView path, uint64 key);
+
+		/// @brief キャッシュファイルからアトラスとグリフテーブルを復元します。
+		/// @remark 最初のグリフを登録する前に 1 回だけ読み込みを試み、2 回目以降の呼び出しは何もしません。
+		/// @param glyphTable グリフテーブル
+		void restorePersistentCache(HashTable<GlyphIndex, GlyphCache>& glyphTable);
+
+		/// @brief 復元後にグリフが追加されていれば、アトラスとグリフテーブルをキャッシュファイルに保存します。
+		/// @param glyphTable グリフテーブル
+		/// @return 保存に成功したか、保存の必要が無かった場合 true, それ以外の場合は false
+		bool storePersistentCache(const HashTable<GlyphIndex, GlyphCache>& glyphTable) const;
+
+	private:
+
+		struct Page
+		{
+			Image image;
+
+			DynamicTexture texture;
+
+			Point penPos = { 0, 0 };
+
+			int32 currentMaxHeight = 0;
+
+			/// @brief テクスチャに未反映の領域
+			Rect dirtyRect = { 0, 0, 0, 0 };
+
+			uint64 lastUsedFrame = 0;
+		};
+
+		Array<Page> m_pages;
+
+		size_t m_currentPage = 0;
+
+		Color m_backgroundColor{ 255, 0 };
+
+		int32 m_bufferWidth = 2;
+
+		int32 m_padding = 1;
+
+		GlyphCacheStat m_stat;
+
+		FilePath m_persistentCachePath;
+
+		uint64 m_persistentCacheKey = 0;
 
-		Image image;
+		bool m_persistentCacheRestored = false;
 
-		Color backgroundColor{ 255, 0 };
+		/// @brief キャッシュファイルの復元以降にグリフが追加されたか
+		bool m_modified = false;
 
-		int32 bufferWidth = 2;
+		void addPage(const FontData& font);
 
-		int32 padding = 1;
+		void evictPage(size_t pageIndex, HashTable<GlyphIndex, GlyphCache>& glyphTable);
 
-		Point penPos = { 0, padding };
+		[[nodiscard]]
+		Optional<size_t> findLeastRecentlyUsedPage(uint64 currentFrame) const;
 
-		int32 currentMaxHeight = 0;
+		[[nodiscard]]
+		bool allocate(Page& page, const Size& size, Point& pos);
+	};
+
+	namespace detail
+	{
+		[[nodiscard]]
+		uint64 GetCurrentFrame();
+	}
+
+	/// @brief ワーカースレッドで生成中のグリフの一覧
+	/// @tparam GlyphType グリフの型
+	template <class GlyphType>
+	class PendingGlyphs
+	{
+	public:
+
+		[[nodiscard]]
+		bool isEmpty() const noexcept
+		{
+			return (m_tasks.empty() && m_uploadFailed.empty());
+		}
+
+		[[nodiscard]]
+		bool contains(const GlyphIndex glyphIndex) const
+		{
+			return (m_tasks.contains(glyphIndex) || m_uploadFailed.contains(glyphIndex));
+		}
+
+		void push(const GlyphIndex glyphIndex, AsyncTask<GlyphType>&& task)
+		{
+			m_tasks.emplace(glyphIndex, std::move(task));
+		}
+
+		void clear()
+		{
+			m_tasks.clear();
+			m_uploadFailed.clear();
+		}
+
+		/// @brief 生成が完了していれば、そのグリフを取り出します。
+		/// @param glyphIndex グリフインデックス
+		/// @return 生成が完了したグリフ。生成中または一覧に無い場合は none
+		[[nodiscard]]
+		Optional<GlyphType> take(const GlyphIndex glyphIndex)
+		{
+			if (auto it = m_uploadFailed.find(glyphIndex);
+				it != m_uploadFailed.end())
+			{
+				GlyphType glyph = std::move(it->second);
+				m_uploadFailed.erase(it);
+				return glyph;
+			}
+
+			auto it = m_tasks.find(glyphIndex);
+
+			if ((it == m_tasks.end()) || (not it->second.isReady()))
+			{
+				return none;
+			}
+
+			GlyphType glyph = it->second.get();
+			m_tasks.erase(it);
+			return glyph;
+		}
+
+		/// @brief 生成が完了したグリフをアトラスに登録します。
+		/// @remark 1 フレームに 1 回だけ処理し、同じフレームでの 2 回目以降の呼び出しは何もしません。
+		/// @remark 登録に失敗したグリフは一覧に残して残りのグリフの登録を続け、次のフレームで再び登録を試みます。
+		/// @param font フォント
+		/// @param atlas アトラス
+		/// @param glyphTable グリフテーブル
+		/// @return 登録に失敗したグリフの数
+		size_t commit(const FontData& font, GlyphAtlas& atlas, HashTable<GlyphIndex, GlyphCache>& glyphTable)
+		{
+			if (isEmpty())
+			{
+				return 0;
+			}
+
+			const uint64 currentFrame = detail::GetCurrentFrame();
+
+			if (currentFrame == m_lastCommitFrame)
+			{
+				return 0;
+			}
+
+			m_lastCommitFrame = currentFrame;
+
+			// 前のフレームで登録に失敗したグリフを再び登録する
+			size_t failedCount = 0;
+
+			for (auto it = m_uploadFailed.begin(); it != m_uploadFailed.end();)
+			{
+				if ((not glyphTable.contains(it->first))
+					&& (not atlas.cacheGlyph(font, it->second.image, it->second, glyphTable)))
+				{
+					LOG_FAIL(U"❌ PendingGlyphs::commit(): Failed to add glyph {} to the atlas again. It will be retried"_fmt(it->first));
+					++failedCount;
+					++it;
+					continue;
+				}
+
+				it = m_uploadFailed.erase(it);
+			}
+
+			for (auto it = m_tasks.begin(); it != m_tasks.end();)
+			{
+				if (not it->second.isReady())
+				{
+					++it;
+					continue;
+				}
+
+				GlyphType glyph = it->second.get();
+				it = m_tasks.erase(it);
+
+				// 描画時に同期的に生成済みの場合は破棄する
+				if (glyphTable.contains(glyph.glyphIndex))
+				{
+					continue;
+				}
+
+				if (not atlas.cacheGlyph(font, glyph.image, glyph, glyphTable))
+				{
+					LOG_FAIL(U"❌ PendingGlyphs::commit(): Failed to add glyph {} to the atlas. It will be retried"_fmt(glyph.glyphIndex));
+					m_uploadFailed.emplace(glyph.glyphIndex, std::move(glyph));
+					++failedCount;
+				}
+			}
+
+			return failedCount;
+		}
+
+	private:
+
+		HashTable<GlyphIndex, AsyncTask<GlyphType>> m_tasks;
+
+		/// @brief 生成は完了したが、アトラスへの登録に失敗したグリフ
+		HashTable<GlyphIndex, GlyphType> m_uploadFailed;
+
+		uint64 m_lastCommitFrame = UINT64_MAX;
 	};
 
 	[[nodiscard]]
@@ -53,8 +305,4 @@ namespace s3d
 
 	[[nodiscard]]
 	bool ProcessControlCharacter(char32 ch, Vec2& penPos, int32& line, const Vec2& basePos, double scale, double lineHeightScale, const FontFaceProperty& prop);
-
-	[[nodiscard]]
-	bool CacheGlyph(const FontData& font, const Image& image, const GlyphInfo& glyphInfo,
-		BufferImage& buffer, HashTable<GlyphIndex, GlyphCache>& glyphTable);
 }
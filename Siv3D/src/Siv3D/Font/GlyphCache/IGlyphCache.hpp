@@ -48,6 +48,8 @@ namespace s3d
 
 		virtual bool preload(const FontData& font, StringView s) = 0;
 
+		virtual bool preloadAsync(const FontData& font, StringView s) = 0;
+
 		[[nodiscard]]
 		virtual const Texture& getTexture() noexcept = 0;
 
@@ -56,5 +58,12 @@ namespace s3d
 
 		[[nodiscard]]
 		virtual int32 getBufferThickness(GlyphIndex glyphIndex) = 0;
+
+		[[nodiscard]]
+		virtual GlyphCacheStat getStat() const = 0;
+
+		virtual void setPersistentCache(FilePathView path, uint64 key) = 0;
+
+		virtual bool storePersistentCache() const = 0;
 	};
 }
@@ -11,6 +11,8 @@
 
 # include <Siv3D/TextureRegion.hpp>
 # include <Siv3D/System.hpp>
+# include <Siv3D/Threading.hpp>
+# include <Siv3D/ProfilerZone.hpp>
 # include <Siv3D/Font/IFont.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 # include "MSDFGlyphCache.hpp"
@@ -23,7 +25,7 @@ namespace s3d
 		{
 			return RectF{ 0 };
 		}
-		updateTexture();
+		m_atlas.updateTexture();
 
 		const auto& prop = font.getProperty();
 		const double scale = (size / prop.fontPixelSize);
@@ -64,7 +66,7 @@ namespace s3d
 
 			const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
 			{
-				const TextureRegion textureRegion = m_texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+				const TextureRegion textureRegion = m_atlas.getTextureRegion(cache);
 				const Vec2 posOffset = usebasePos ? cache.info.getBase(scale) : cache.info.getOffset(scale);
 				const Vec2 drawPos = (penPos + posOffset);
 
@@ -102,7 +104,7 @@ namespace s3d
 		{
 			// do tnohing
 		}
-		updateTexture();
+		m_atlas.updateTexture();
 
 		const double dotXAdvance = m_glyphTable.find(dotGlyphCluster[0].glyphIndex)->second.info.xAdvance;
 		const Vec2 areaBottomRight = area.br();
@@ -254,7 +256,7 @@ namespace s3d
 			{
 				const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
 				{
-					const TextureRegion textureRegion = m_texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+					const TextureRegion textureRegion = m_atlas.getTextureRegion(cache);
 					const Vec2 posOffset = cache.info.getOffset(scale);
 					const Vec2 drawPos = (newPenPositions[i] + posOffset);
 
@@ -282,7 +284,7 @@ namespace s3d
 		{
 			return RectF{ 0 };
 		}
-		updateTexture();
+		m_atlas.updateTexture();
 
 		const auto& prop = font.getProperty();
 		const double scale = (size / prop.fontPixelSize);
@@ -295,7 +297,7 @@ namespace s3d
 		{
 			const auto& cache = m_glyphTable.find(cluster.glyphIndex)->second;
 			{
-				const TextureRegion textureRegion = m_texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+				const TextureRegion textureRegion = m_atlas.getTextureRegion(cache);
 				const Vec2 posOffset = usebasePos ? cache.info.getBase(scale) : cache.info.getOffset(scale);
 				const Vec2 drawPos = (penPos + posOffset);
 				RectF rect;
@@ -469,12 +471,15 @@ namespace s3d
 
 	void MSDFGlyphCache::setBufferWidth(const int32 width)
 	{
-		m_buffer.bufferWidth = Max(width, 0);
+		// 生成中のグリフはバッファ幅が異なるため破棄する
+		m_pendingGlyphs.clear();
+
+		m_atlas.setBufferWidth(width);
 	}
 
 	int32 MSDFGlyphCache::getBufferWidth() const noexcept
 	{
-		return m_buffer.bufferWidth;
+		return m_atlas.getBufferWidth();
 	}
 
 	bool MSDFGlyphCache::preload(const FontData& font, const StringView s)
@@ -482,11 +487,38 @@ namespace s3d
 		return prerender(font, font.getGlyphClusters(s, false), true);
 	}
 
+	bool MSDFGlyphCache::preloadAsync(const FontData& font, const StringView s)
+	{
+		m_atlas.restorePersistentCache(m_glyphTable);
+
+		for (const auto& cluster : font.getGlyphClusters(s, false))
+		{
+			if ((cluster.fontIndex != 0)
+				|| m_glyphTable.contains(cluster.glyphIndex)
+				|| m_pendingGlyphs.contains(cluster.glyphIndex))
+			{
+				continue;
+			}
+
+			// アウトラインの読み込みは FT_Face を使うため、このスレッドで行う
+			auto render = font.prepareMSDFByGlyphIndex(cluster.glyphIndex, m_atlas.getBufferWidth());
+
+			if (not render)
+			{
+				continue;
+			}
+
+			m_pendingGlyphs.push(cluster.glyphIndex, Threading::Submit(std::move(render)));
+		}
+
+		return true;
+	}
+
 	const Texture& MSDFGlyphCache::getTexture() noexcept
 	{
-		updateTexture();
+		m_atlas.updateTexture();
 
-		return m_texture;
+		return m_atlas.getTexture();
 	}
 
 	TextureRegion MSDFGlyphCache::getTextureRegion(const FontData& font, const GlyphIndex glyphIndex)
@@ -495,10 +527,10 @@ namespace s3d
 		{
 			return{};
 		}
-		updateTexture();
+		m_atlas.updateTexture();
 
 		const auto& cache = m_glyphTable.find(glyphIndex)->second;
-		return m_texture(cache.textureRegionLeft, cache.textureRegionTop, cache.textureRegionWidth, cache.textureRegionHeight);
+		return m_atlas.getTextureRegion(cache);
 	}
 
 	int32 MSDFGlyphCache::getBufferThickness(const GlyphIndex glyphIndex)
@@ -514,18 +546,26 @@ namespace s3d
 
 	bool MSDFGlyphCache::prerender(const FontData& font, const Array<GlyphCluster>& clusters, const bool isMainFont)
 	{
-		if (m_glyphTable.empty())
+		SIV3D_PROFILE_ZONE(U"GlyphCache::prerender");
+
+		m_atlas.restorePersistentCache(m_glyphTable);
+
+		// 新しいグリフの登録によって、このフレームで描画するグリフのページが追い出されないようにする
+		m_atlas.touchGlyphs(clusters, isMainFont, m_glyphTable);
+
+		if (not m_glyphTable.contains(0))
 		{
-			const MSDFGlyph glyph = font.renderMSDFByGlyphIndex(0, m_buffer.bufferWidth);
+			const MSDFGlyph glyph = font.renderMSDFByGlyphIndex(0, m_atlas.getBufferWidth());
 
-			if (not CacheGlyph(font, glyph.image, glyph, m_buffer, m_glyphTable))
+			if (not m_atlas.cacheGlyph(font, glyph.image, glyph, m_glyphTable))
 			{
 				return false;
 			}
-
-			m_hasDirty = true;
 		}
 
+		// 事前生成したグリフの登録に失敗しても、このフレームで描画するグリフが揃っていれば描画できる
+		m_pendingGlyphs.commit(font, m_atlas, m_glyphTable);
+
 		for (const auto& cluster : clusters)
 		{
 			if (isMainFont && (cluster.fontIndex != 0))
@@ -538,46 +578,42 @@ namespace s3d
 				continue;
 			}
 
-			const MSDFGlyph glyph = font.renderMSDFByGlyphIndex(cluster.glyphIndex, m_buffer.bufferWidth);
+			// 非同期の生成が完了していればその結果を使い、完了していなければこのスレッドで生成する
+			const MSDFGlyph glyph = m_pendingGlyphs.take(cluster.glyphIndex)
+				.value_or_eval([&]() { return font.renderMSDFByGlyphIndex(cluster.glyphIndex, m_atlas.getBufferWidth()); });
 
 			if (m_glyphTable.contains(glyph.glyphIndex))
 			{
 				continue;
 			}
 
-			if (not CacheGlyph(font, glyph.image, glyph, m_buffer, m_glyphTable))
+			if (not m_atlas.cacheGlyph(font, glyph.image, glyph, m_glyphTable))
 			{
 				return false;
 			}
-
-			m_hasDirty = true;
 		}
 
 		// texture content can be updated in a different thread
 		if (System::GetRendererType() == EngineOption::Renderer::Direct3D11)
 		{
-			updateTexture();
+			m_atlas.updateTexture();
 		}
 
 		return true;
 	}
 
-	void MSDFGlyphCache::updateTexture()
+	GlyphCacheStat MSDFGlyphCache::getStat() const
 	{
-		if (not m_hasDirty)
-		{
-			return;
-		}
+		return m_atlas.getStat(m_glyphTable);
+	}
 
-		if (m_texture.size() == m_buffer.image.size())
-		{
-			m_texture.fill(m_buffer.image);
-		}
-		else
-		{
-			m_texture = DynamicTexture{ m_buffer.image };
-		}
+	void MSDFGlyphCache::setPersistentCache(const FilePathView path, const uint64 key)
+	{
+		m_atlas.setPersistentCache(path, key);
+	}
 
-		m_hasDirty = false;
+	bool MSDFGlyphCache::storePersistentCache() const
+	{
+		return m_atlas.storePersistentCache(m_glyphTable);
 	}
 }
@@ -50,6 +50,8 @@ namespace s3d
 
 		bool preload(const FontData & font, StringView s) override;
 
+		bool preloadAsync(const FontData& font, StringView s) override;
+
 		[[nodiscard]]
 		const Texture& getTexture() noexcept override;
 
@@ -59,21 +61,25 @@ namespace s3d
 		[[nodiscard]]
 		int32 getBufferThickness(GlyphIndex glyphIndex) override;
 
+		[[nodiscard]]
+		GlyphCacheStat getStat() const override;
+
+		void setPersistentCache(FilePathView path, uint64 key) override;
+
+		bool storePersistentCache() const override;
+
 	private:
 
 		static constexpr int32 DefaultBuffer = 2;
 
 		HashTable<GlyphIndex, GlyphCache> m_glyphTable;
 
-		DynamicTexture m_texture;
-
-		bool m_hasDirty = false;
+		GlyphAtlas m_atlas{ Color{ 0, 0 } };
 
-		BufferImage m_buffer = { .image = {}, .backgroundColor = Color{ 0, 0 } };
+		PendingGlyphs<MSDFGlyph> m_pendingGlyphs;
 
 		[[nodiscard]]
 		bool prerender(const FontData& font, const Array<GlyphCluster>& clusters, bool isMainFont);
 
-		void updateTexture();
 	};
 }
@@ -139,7 +139,19 @@ namespace s3d
 		}
 	}
 
-	MSDFGlyph RenderMSDFGlyph(FT_Face face, const GlyphIndex glyphIndex, int32 buffer, const FontFaceProperty& prop)
+	MSDFGlyph RenderMSDFGlyph(FT_Face face, const GlyphIndex glyphIndex, const int32 buffer, const FontFaceProperty& prop)
+	{
+		const auto render = PrepareMSDFGlyph(face, glyphIndex, buffer, prop);
+
+		if (not render)
+		{
+			return{};
+		}
+
+		return render();
+	}
+
+	std::function<MSDFGlyph()> PrepareMSDFGlyph(FT_Face face, const GlyphIndex glyphIndex, int32 buffer, const FontFaceProperty& prop)
 	{
 		if (not LoadOutlineGlyph(face, glyphIndex, prop.style))
 		{
@@ -157,23 +169,31 @@ namespace s3d
 		const GlyphBBox bbox	= detail::GetBound(shape);
 		const int32 width		= static_cast<int32>(bbox.xMax - bbox.xMin);
 		const int32 height		= static_cast<int32>(bbox.yMax - bbox.yMin);
-		const Vec2 offset{ (-bbox.xMin+ buffer), (-bbox.yMin + buffer) };
-
-		msdfgen::Bitmap<float, 3> bitmap{ (width + (2 * buffer)), (height + (2 * buffer)) };
-		msdfgen::generateMSDF(bitmap, shape, 4.0, 1.0, msdfgen::Vector2(offset.x, offset.y));
-
-		MSDFGlyph result;
-		result.glyphIndex	= glyphIndex;
-		result.buffer		= buffer;
-		result.left			= static_cast<int16>(bbox.xMin);
-		result.top			= static_cast<int16>(bbox.yMax);
-		result.width		= static_cast<int16>(width);
-		result.height		= static_cast<int16>(height);
-		result.xAdvance		= (face->glyph->metrics.horiAdvance / 64.0);
-		result.yAdvance		= (face->glyph->metrics.vertAdvance / 64.0);
-		result.ascender		= prop.ascender;
-		result.descender	= prop.descender;
-		result.image		= detail::RenderMSDF(bitmap);
-		return result;
+
+		GlyphInfo info;
+		info.glyphIndex	= glyphIndex;
+		info.buffer		= buffer;
+		info.left		= static_cast<int16>(bbox.xMin);
+		info.top		= static_cast<int16>(bbox.yMax);
+		info.width		= static_cast<int16>(width);
+		info.height		= static_cast<int16>(height);
+		info.xAdvance	= (face->glyph->metrics.horiAdvance / 64.0);
+		info.yAdvance	= (face->glyph->metrics.vertAdvance / 64.0);
+		info.ascender	= prop.ascender;
+		info.descender	= prop.descender;
+
+		// ここから先は FT_Face にアクセスしない
+		return [shape = std::move(shape), bbox, info]()
+		{
+			const Vec2 offset{ (-bbox.xMin + info.buffer), (-bbox.yMin + info.buffer) };
+
+			msdfgen::Bitmap<float, 3> bitmap{ (info.width + (2 * info.buffer)), (info.height + (2 * info.buffer)) };
+			msdfgen::generateMSDF(bitmap, shape, 4.0, 1.0, msdfgen::Vector2(offset.x, offset.y));
+
+			MSDFGlyph result;
+			static_cast<GlyphInfo&>(result) = info;
+			result.image = detail::RenderMSDF(bitmap);
+			return result;
+		};
 	}
 }
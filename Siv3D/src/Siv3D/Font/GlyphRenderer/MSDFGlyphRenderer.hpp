@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # pragma once
+# include <functional>
 # include <Siv3D/Common.hpp>
 # include <Siv3D/MSDFGlyph.hpp>
 
@@ -22,4 +23,11 @@ namespace s3d
 
 	[[nodiscard]]
 	MSDFGlyph RenderMSDFGlyph(FT_Face face, GlyphIndex glyphIndex, int32 buffer, const FontFaceProperty& prop);
+
+	/// @brief グリフのアウトラインを読み込み、MSDF を生成する関数を返します。
+	/// @remark FT_Face はスレッドセーフでないため、この関数は FT_Face を所有するスレッドで呼ぶ必要があります。
+	/// @remark 返される関数は FT_Face にアクセスしないため、任意のスレッドで実行できます。
+	/// @return MSDF を生成する関数。アウトラインの読み込みに失敗した場合は空の関数
+	[[nodiscard]]
+	std::function<MSDFGlyph()> PrepareMSDFGlyph(FT_Face face, GlyphIndex glyphIndex, int32 buffer, const FontFaceProperty& prop);
 }
@@ -137,7 +137,19 @@ namespace s3d
 		}
 	}
 
-	SDFGlyph RenderSDFGlyph(FT_Face face, const GlyphIndex glyphIndex, int32 buffer, const FontFaceProperty& prop)
+	SDFGlyph RenderSDFGlyph(FT_Face face, const GlyphIndex glyphIndex, const int32 buffer, const FontFaceProperty& prop)
+	{
+		const auto render = PrepareSDFGlyph(face, glyphIndex, buffer, prop);
+
+		if (not render)
+		{
+			return{};
+		}
+
+		return render();
+	}
+
+	std::function<SDFGlyph()> PrepareSDFGlyph(FT_Face face, const GlyphIndex glyphIndex, int32 buffer, const FontFaceProperty& prop)
 	{
 		if (not LoadOutlineGlyph(face, glyphIndex, prop.style))
 		{
@@ -146,7 +158,7 @@ namespace s3d
 
 		buffer = Max(buffer, 0);
 
-		msdfgen::Shape shape;	
+		msdfgen::Shape shape;
 		if (not detail::GetShape(face, shape))
 		{
 			return{};
@@ -155,23 +167,31 @@ namespace s3d
 		const GlyphBBox bbox	= detail::GetBound(shape);
 		const int32 width		= static_cast<int32>(bbox.xMax - bbox.xMin);
 		const int32 height		= static_cast<int32>(bbox.yMax - bbox.yMin);
-		const Vec2 offset{ (-bbox.xMin+ buffer), (-bbox.yMin + buffer) };
-
-		msdfgen::Bitmap<float, 1> bitmap{ (width + (2 * buffer)), (height + (2 * buffer)) };
-		msdfgen::generateSDF(bitmap, shape, 8.0, 1.0, msdfgen::Vector2(offset.x, offset.y));
-
-		SDFGlyph result;
-		result.glyphIndex	= glyphIndex;
-		result.buffer		= buffer;
-		result.left			= static_cast<int16>(bbox.xMin);
-		result.top			= static_cast<int16>(bbox.yMax);
-		result.width		= static_cast<int16>(width);
-		result.height		= static_cast<int16>(height);
-		result.xAdvance		= (face->glyph->metrics.horiAdvance / 64.0);
-		result.yAdvance		= (face->glyph->metrics.vertAdvance / 64.0);
-		result.ascender		= prop.ascender;
-		result.descender	= prop.descender;
-		result.image		= detail::RenderMSDF(bitmap);
-		return result;
+
+		GlyphInfo info;
+		info.glyphIndex	= glyphIndex;
+		info.buffer		= buffer;
+		info.left		= static_cast<int16>(bbox.xMin);
+		info.top		= static_cast<int16>(bbox.yMax);
+		info.width		= static_cast<int16>(width);
+		info.height		= static_cast<int16>(height);
+		info.xAdvance	= (face->glyph->metrics.horiAdvance / 64.0);
+		info.yAdvance	= (face->glyph->metrics.vertAdvance / 64.0);
+		info.ascender	= prop.ascender;
+		info.descender	= prop.descender;
+
+		// ここから先は FT_Face にアクセスしない
+		return [shape = std::move(shape), bbox, info]()
+		{
+			const Vec2 offset{ (-bbox.xMin + info.buffer), (-bbox.yMin + info.buffer) };
+
+			msdfgen::Bitmap<float, 1> bitmap{ (info.width + (2 * info.buffer)), (info.height + (2 * info.buffer)) };
+			msdfgen::generateSDF(bitmap, shape, 8.0, 1.0, msdfgen::Vector2(offset.x, offset.y));
+
+			SDFGlyph result;
+			static_cast<GlyphInfo&>(result) = info;
+			result.image = detail::RenderMSDF(bitmap);
+			return result;
+		};
 	}
 }
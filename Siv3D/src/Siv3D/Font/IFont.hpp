@@ -34,6 +34,8 @@ namespace s3d
 
 		virtual Font::IDType create(Typeface typeface, FontMethod fontMethod, int32 fontSize, FontStyle style) = 0;
 
+		virtual Font::IDType create(std::shared_ptr<const void> memoryOwner, const void* data, size_t size, size_t faceIndex, FontMethod fontMethod, int32 fontSize, FontStyle style) = 0;
+
 		virtual void release(Font::IDType handleID) = 0;
 
 		virtual bool addFallbackFont(Font::IDType handleID, const std::weak_ptr<AssetHandle<Font>::AssetIDWrapperType>& font) = 0;
@@ -84,8 +86,12 @@ namespace s3d
 
 		virtual bool preload(Font::IDType handleID, StringView chars) = 0;
 
+		virtual bool preloadAsync(Font::IDType handleID, StringView chars) = 0;
+
 		virtual const Texture& getTexture(Font::IDType handleID) = 0;
 
+		virtual GlyphCacheStat getGlyphCacheStat(Font::IDType handleID) = 0;
+
 		virtual Glyph getGlyph(Font::IDType handleID, StringView ch) = 0;
 
 		virtual Array<Glyph> getGlyphs(Font::IDType handleID, StringView s) = 0;
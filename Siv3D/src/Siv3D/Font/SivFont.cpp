@@ -11,6 +11,7 @@
 
 # include <Siv3D/Font.hpp>
 # include <Siv3D/DrawableText.hpp>
+# include <Siv3D/AssetArchive.hpp>
 # include <Siv3D/Font/IFont.hpp>
 # include <Siv3D/FreestandingMessageBox/FreestandingMessageBox.hpp>
 # include <Siv3D/AssetMonitor/IAssetMonitor.hpp>
@@ -20,6 +21,22 @@
 
 namespace s3d
 {
+	namespace detail
+	{
+		[[nodiscard]]
+		static Font::IDType CreateFontFromArchive(const AssetArchive& archive, const FilePathView path, const size_t faceIndex, const FontMethod fontMethod, const int32 fontSize, const FontStyle style)
+		{
+			const AssetArchive::SharedView view = archive.acquire(path);
+
+			if (not view)
+			{
+				return Font::IDType::NullAsset();
+			}
+
+			return SIV3D_ENGINE(Font)->create(view.owner, view.data, view.size, faceIndex, fontMethod, fontSize, style);
+		}
+	}
+
 	template <>
 	AssetIDWrapper<AssetHandle<Font>>::AssetIDWrapper()
 	{
@@ -70,6 +87,15 @@ namespace s3d
 		SIV3D_ENGINE(AssetMonitor)->created();
 	}
 
+	Font::Font(const int32 fontSize, const AssetArchive& archive, const FilePathView path, const FontStyle style)
+		: Font{ FontMethod::Bitmap, fontSize, archive, path, 0, style } {}
+
+	Font::Font(const FontMethod fontMethod, const int32 fontSize, const AssetArchive& archive, const FilePathView path, const size_t faceIndex, const FontStyle style)
+		: AssetHandle{ std::make_shared<AssetIDWrapperType>(detail::CreateFontFromArchive(archive, path, faceIndex, fontMethod, fontSize, style)) }
+	{
+		SIV3D_ENGINE(AssetMonitor)->created();
+	}
+
 	Font::~Font() {}
 
 	bool Font::addFallback(const Font& font) const
@@ -294,11 +320,21 @@ namespace s3d
 		return SIV3D_ENGINE(Font)->preload(m_handle->id(), chars);
 	}
 
+	bool Font::preloadAsync(const StringView chars) const
+	{
+		return SIV3D_ENGINE(Font)->preloadAsync(m_handle->id(), chars);
+	}
+
 	const Texture& Font::getTexture() const
 	{
 		return SIV3D_ENGINE(Font)->getTexture(m_handle->id());
 	}
 
+	GlyphCacheStat Font::getGlyphCacheStat() const
+	{
+		return SIV3D_ENGINE(Font)->getGlyphCacheStat(m_handle->id());
+	}
+
 	Glyph Font::getGlyph(const char32 ch) const
 	{
 		return SIV3D_ENGINE(Font)->getGlyph(m_handle->id(), StringView(&ch, 1));
@@ -58,21 +58,16 @@ namespace s3d
 	{
 		if (isUninitialized())
 		{
-			setState(AssetState::AsyncLoading);
-
-			m_task = Async([this, hint = hint]()
+			startLoadAsync([this, hint = hint]()
 				{
-					setState(onLoad(*this, hint) ? AssetState::Loaded : AssetState::Failed);
+					return onLoad(*this, hint);
 				});
 		}
 	}
 
 	void FontAssetData::wait()
 	{
-		if (m_task.isValid())
-		{
-			m_task.get();
-		}
+		waitLoadAsync();
 	}
 
 	void FontAssetData::release()
@@ -84,6 +79,8 @@ namespace s3d
 
 		if (isAsyncLoading())
 		{
+			cancelLoadAsync();
+
 			wait();
 		}
 
@@ -211,6 +211,16 @@ namespace s3d
 			{
 				SIV3D_ENGINE(Renderer2D)->setConstantBuffer(stage, slot, buffer, data, num_vectors);
 			}
+
+			void BeginBatchReorder()
+			{
+				SIV3D_ENGINE(Renderer2D)->beginBatchReorder();
+			}
+
+			void EndBatchReorder()
+			{
+				SIV3D_ENGINE(Renderer2D)->endBatchReorder();
+			}
 		}
 	}
 }
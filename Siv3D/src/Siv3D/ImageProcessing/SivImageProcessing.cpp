@@ -9,71 +9,184 @@
 //
 //-----------------------------------------------
 
+# include <array>
 # include <Siv3D/ImageProcessing.hpp>
+# include <Siv3D/Threading.hpp>
 # include <Siv3D/OpenCV_Bridge.hpp>
 
 namespace s3d
 {
 	namespace detail
 	{
-		static Image GenerateMip(const Image& src)
+		/// @brief 並列化する際の 1 ブロックあたりの最小ピクセル数
+		inline constexpr size_t MipParallelGrainPixels = (1 << 16);
+
+		/// @brief sRGB と線形色空間の変換テーブル
+		struct SRGBTable
 		{
-			if (not src)
+			/// @brief sRGB (0-255) から線形 (0.0-1.0) への変換テーブル
+			std::array<float, 256> toLinear;
+
+			/// @brief 線形 (0-4095) から sRGB (0-255) への変換テーブル
+			std::array<uint8, 4096> toSRGB;
+
+			SRGBTable()
 			{
-				return{};
+				for (size_t i = 0; i < toLinear.size(); ++i)
+				{
+					const double c = (i / 255.0);
+					toLinear[i] = static_cast<float>((c <= 0.04045) ? (c / 12.92) : std::pow(((c + 0.055) / 1.055), 2.4));
+				}
+
+				for (size_t i = 0; i < toSRGB.size(); ++i)
+				{
+					const double c = (i / 4095.0);
+					const double s = ((c <= 0.0031308) ? (c * 12.92) : (1.055 * std::pow(c, (1.0 / 2.4)) - 0.055));
+					toSRGB[i] = static_cast<uint8>(Clamp((s * 255.0 + 0.5), 0.0, 255.0));
+				}
 			}
+		};
 
-			const Color* pSrc = src.data();
+		[[nodiscard]]
+		static const SRGBTable& GetSRGBTable()
+		{
+			static const SRGBTable table;
+			return table;
+		}
+
+		[[nodiscard]]
+		static int32 GetMipSourceIndex(const int32 dst, const int32 srcSize, const int32 dstSize) noexcept
+		{
+			return static_cast<int32>((static_cast<int64>(dst) * srcSize) / dstSize);
+		}
+
+		static void GenerateMipRowsSRGB(const Image& src, Image& dst, const int32 beginY, const int32 endY)
+		{
+			const SRGBTable& table = GetSRGBTable();
 			const int32 srcW = src.width();
 			const int32 srcH = src.height();
+			const int32 dstW = dst.width();
+			const int32 dstH = dst.height();
 
-			const int32 targetWidth = Max(src.width() / 2, 1);
-			const int32 targetHeight = Max(src.height() / 2, 1);
-			
-			if ((targetWidth <= 4) && (targetHeight <= 4))
+			for (int32 y = beginY; y < endY; ++y)
 			{
-				return src.scaled(targetWidth, targetHeight, InterpolationAlgorithm::Area);
+				const int32 sy0 = GetMipSourceIndex(y, srcH, dstH);
+				const Color* pSrc0 = src[sy0];
+				const Color* pSrc1 = src[Min((sy0 + 1), (srcH - 1))];
+				Color* pDst = dst[y];
+
+				for (int32 x = 0; x < dstW; ++x)
+				{
+					const int32 sx0 = GetMipSourceIndex(x, srcW, dstW);
+					const int32 sx1 = Min((sx0 + 1), (srcW - 1));
+					const Color& c0 = pSrc0[sx0];
+					const Color& c1 = pSrc0[sx1];
+					const Color& c2 = pSrc1[sx0];
+					const Color& c3 = pSrc1[sx1];
+
+					const auto toSRGB = [&](const uint8 a, const uint8 b, const uint8 c, const uint8 d)
+					{
+						const float sum = (table.toLinear[a] + table.toLinear[b] + table.toLinear[c] + table.toLinear[d]);
+						return table.toSRGB[static_cast<size_t>(sum * (4095.0f / 4.0f) + 0.5f)];
+					};
+
+					pDst->r = toSRGB(c0.r, c1.r, c2.r, c3.r);
+					pDst->g = toSRGB(c0.g, c1.g, c2.g, c3.g);
+					pDst->b = toSRGB(c0.b, c1.b, c2.b, c3.b);
+					pDst->a = static_cast<uint8>((c0.a + c1.a + c2.a + c3.a + 2) / 4); // アルファは線形
+					++pDst;
+				}
 			}
-			
-			Image result(targetWidth, targetHeight);
-			Color* pDst = result.data();
+		}
 
-			const float sddx = (srcW - 1.0f) / Max(targetWidth - 1, 1);
-			const float sddy = (srcH - 1.0f) / Max(targetHeight - 1, 1);
+		static void GenerateMipRows(const Image& src, Image& dst, const int32 beginY, const int32 endY)
+		{
+			const int32 srcW = src.width();
+			const int32 srcH = src.height();
+			const int32 dstW = dst.width();
+			const int32 dstH = dst.height();
 
-			for (int32 y = 0; y < targetHeight; ++y)
+			for (int32 y = beginY; y < endY; ++y)
 			{
-				float sy = y * sddy;
+				const int32 sy0 = GetMipSourceIndex(y, srcH, dstH);
+				const Color* pSrc0 = src[sy0];
+				const Color* pSrc1 = src[Min((sy0 + 1), (srcH - 1))];
+				Color* pDst = dst[y];
+				int32 x = 0;
 
-				const int32 dy = static_cast<int32>(sy);
+			# if SIV3D_INTRINSIC(SSE)
 
-				sy -= dy;
+				// 幅がちょうど半分になる場合は、出力 4 ピクセルずつ 2x2 ボックスフィルタを適用する
+				if (srcW == (dstW * 2))
+				{
+					const __m128i zero = ::_mm_setzero_si128();
+					const __m128i two = ::_mm_set1_epi16(2);
+
+					const auto average2 = [&](const __m128i row0, const __m128i row1)
+					{
+						// 2 ピクセル x 2 行を 16 ビットで加算
+						const __m128i lo = ::_mm_add_epi16(::_mm_unpacklo_epi8(row0, zero), ::_mm_unpacklo_epi8(row1, zero));
+						const __m128i hi = ::_mm_add_epi16(::_mm_unpackhi_epi8(row0, zero), ::_mm_unpackhi_epi8(row1, zero));
+						const __m128i sum = ::_mm_add_epi16(::_mm_unpacklo_epi64(lo, hi), ::_mm_unpackhi_epi64(lo, hi));
+						return ::_mm_srli_epi16(::_mm_add_epi16(sum, two), 2);
+					};
+
+					for (; (x + 4) <= dstW; x += 4)
+					{
+						const __m128i a0 = ::_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc0 + (x * 2)));
+						const __m128i a1 = ::_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc0 + (x * 2) + 4));
+						const __m128i b0 = ::_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc1 + (x * 2)));
+						const __m128i b1 = ::_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc1 + (x * 2) + 4));
+
+						const __m128i result = ::_mm_packus_epi16(average2(a0, b0), average2(a1, b1));
+						::_mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + x), result);
+					}
+				}
 
-				const int32 dyO = Min(dy + 1, srcH - 1);
+			# endif
 
-				for (int32 x = 0; x < targetWidth; ++x)
+				for (; x < dstW; ++x)
 				{
-					float sx = x * sddx;
+					const int32 sx0 = GetMipSourceIndex(x, srcW, dstW);
+					const int32 sx1 = Min((sx0 + 1), (srcW - 1));
+					const Color& c0 = pSrc0[sx0];
+					const Color& c1 = pSrc0[sx1];
+					const Color& c2 = pSrc1[sx0];
+					const Color& c3 = pSrc1[sx1];
+
+					pDst[x].set(static_cast<uint8>((c0.r + c1.r + c2.r + c3.r + 2) / 4),
+						static_cast<uint8>((c0.g + c1.g + c2.g + c3.g + 2) / 4),
+						static_cast<uint8>((c0.b + c1.b + c2.b + c3.b + 2) / 4),
+						static_cast<uint8>((c0.a + c1.a + c2.a + c3.a + 2) / 4));
+				}
+			}
+		}
 
-					const int32 dx = static_cast<int32>(sx);
+		[[nodiscard]]
+		static Image GenerateMip(const Image& src, const bool sRGB)
+		{
+			if (not src)
+			{
+				return{};
+			}
 
-					sx -= dx;
+			const int32 targetWidth = Max(src.width() / 2, 1);
+			const int32 targetHeight = Max(src.height() / 2, 1);
 
-					const int32 dxO = Min(dx + 1, srcW - 1);
+			if ((not sRGB) && (targetWidth <= 4) && (targetHeight <= 4))
+			{
+				return src.scaled(targetWidth, targetHeight, InterpolationAlgorithm::Area);
+			}
 
-					const Color& c0 = pSrc[dy * srcW + dx];
-					const Color& c1 = pSrc[dy * srcW + dxO];
-					const Color& c2 = pSrc[dyO * srcW + dx];
-					const Color& c3 = pSrc[dyO * srcW + dxO];
+			Image result(targetWidth, targetHeight);
 
-					const uint8 r = static_cast<uint8>((c0.r * (1 - sx) + c1.r * sx) * (1 - sy) + (c2.r * (1 - sx) + c3.r * sx) * sy);
-					const uint8 g = static_cast<uint8>((c0.g * (1 - sx) + c1.g * sx) * (1 - sy) + (c2.g * (1 - sx) + c3.g * sx) * sy);
-					const uint8 b = static_cast<uint8>((c0.b * (1 - sx) + c1.b * sx) * (1 - sy) + (c2.b * (1 - sx) + c3.b * sx) * sy);
-					const uint8 a = static_cast<uint8>((c0.a * (1 - sx) + c1.a * sx) * (1 - sy) + (c2.a * (1 - sx) + c3.a * sx) * sy);
+			const auto generateRows = (sRGB ? GenerateMipRowsSRGB : GenerateMipRows);
+			const size_t grainRows = Max<size_t>(1, (MipParallelGrainPixels / targetWidth));
 
-					(pDst++)->set(r, g, b, a);
-				}
-			}
+			Threading::ParallelFor(targetHeight, [&](const size_t first, const size_t last)
+				{
+					generateRows(src, result, static_cast<int32>(first), static_cast<int32>(last));
+				}, grainRows);
 
 			return result;
 		}
@@ -81,7 +194,7 @@ namespace s3d
 
 	namespace ImageProcessing
 	{
-		Array<Image> GenerateMips(const Image& src)
+		Array<Image> GenerateMips(const Image& src, const bool sRGB)
 		{
 			const size_t mipCount = (CalculateMipCount(src.width(), src.height()) - 1);
 
@@ -92,16 +205,31 @@ namespace s3d
 
 			Array<Image> mipImages(mipCount);
 
-			mipImages[0] = detail::GenerateMip(src);
+			mipImages[0] = detail::GenerateMip(src, sRGB);
 
 			for (size_t i = 1; i < mipCount; ++i)
 			{
-				mipImages[i] = detail::GenerateMip(mipImages[i - 1]);
+				mipImages[i] = detail::GenerateMip(mipImages[i - 1], sRGB);
 			}
 
 			return mipImages;
 		}
 
+		Array<Array<Image>> GenerateMips(const Array<Image>& images, const bool sRGB)
+		{
+			Array<Array<Image>> results(images.size());
+
+			Threading::ParallelFor(images.size(), [&](const size_t first, const size_t last)
+				{
+					for (size_t i = first; i < last; ++i)
+					{
+						results[i] = GenerateMips(images[i], sRGB);
+					}
+				}, 1);
+
+			return results;
+		}
+
 		void Sobel(const Image& src, Image& dst, const int32 dx, const int32 dy, int32 apertureSize)
 		{
 			// 1. パラメータチェック
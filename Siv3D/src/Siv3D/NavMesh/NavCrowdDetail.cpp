@@ -0,0 +1,971 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/Threading.hpp>
+# include "NavCrowdDetail.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		// 1 つのエージェントの通路のポリゴン数の上限
+		inline constexpr int32 CrowdMaxPathPolys = 256;
+
+		// 操舵のために求める経路の角の数
+		inline constexpr int32 CrowdMaxCorners = 4;
+
+		// 衝突回避で考慮する近くのエージェントの数
+		inline constexpr size_t CrowdMaxNeighbours = 6;
+
+		inline constexpr int32 CrowdMaxVisited = 16;
+
+		// 近くのエージェントを探す範囲（半径に対する倍率）
+		inline constexpr float CrowdCollisionQueryRange = 8.0f;
+
+		// 近くのエージェントを探すグリッドのセルの最小の大きさ（半径がすべて 0 でもセルの大きさが 0 にならないようにする）
+		inline constexpr float CrowdMinGridCellSize = 0.1f;
+
+		// 通路を短縮するために見通しを調べる範囲（半径に対する倍率）
+		inline constexpr float CrowdPathOptimizationRange = 30.0f;
+
+		// 目的地に到着したとみなす距離（半径に対する倍率）
+		inline constexpr float CrowdArrivalDistance = 0.25f;
+
+		// 重なったエージェントを押し離す強さ
+		inline constexpr float CrowdCollisionResolveFactor = 0.7f;
+
+		inline constexpr int32 CrowdSeparationIterations = 2;
+
+		// 1 つのスレッドがまとめて処理するエージェントの数
+		inline constexpr size_t CrowdGrainSize = 64;
+
+		// 速度障害物法による衝突回避のパラメータ
+		struct CrowdAvoidanceParameters
+		{
+			static constexpr float WeightDesiredVelocity = 2.0f;
+
+			static constexpr float WeightCurrentVelocity = 0.75f;
+
+			static constexpr float WeightSide = 0.75f;
+
+			static constexpr float WeightTimeToImpact = 2.5f;
+
+			static constexpr float HorizonTime = 2.5f;
+
+			static constexpr int32 Directions = 8;
+
+			static constexpr int32 Rings = 3;
+		};
+
+		template <class Fty>
+		static void ForEachAgentBlock(const size_t count, Fty&& f)
+		{
+		# ifndef SIV3D_NO_CONCURRENT_API
+
+			Threading::ParallelFor(count, f, CrowdGrainSize);
+
+		# else
+
+			f(0, count);
+
+		# endif
+		}
+
+		[[nodiscard]]
+		constexpr Float2 XZ(const Float3& v) noexcept
+		{
+			return{ v.x, v.z };
+		}
+
+		template <class Type>
+		static void SwapRemove(Array<Type>& values, const size_t index)
+		{
+			if ((index + 1) != values.size())
+			{
+				values[index] = std::move(values.back());
+			}
+
+			values.pop_back();
+		}
+
+		// 最後に共通するポリゴンを探す
+		[[nodiscard]]
+		static std::pair<int32, int32> FindFurthestCommon(const Array<dtPolyRef>& corridor, const dtPolyRef* visited, const int32 nvisited)
+		{
+			for (int32 i = (static_cast<int32>(corridor.size()) - 1); 0 <= i; --i)
+			{
+				for (int32 k = (nvisited - 1); 0 <= k; --k)
+				{
+					if (corridor[i] == visited[k])
+					{
+						return{ i, k };
+					}
+				}
+			}
+
+			return{ -1, -1 };
+		}
+
+		// 移動で通過したポリゴンを、通路の先頭に反映する
+		static void MergeCorridorStartMoved(Array<dtPolyRef>& corridor, const dtPolyRef* visited, const int32 nvisited)
+		{
+			const auto [furthestPath, furthestVisited] = FindFurthestCommon(corridor, visited, nvisited);
+
+			if (furthestPath < 0)
+			{
+				return;
+			}
+
+			Array<dtPolyRef> merged(Arg::reserve = (nvisited - furthestVisited + corridor.size() - furthestPath - 1));
+
+			for (int32 i = (nvisited - 1); furthestVisited <= i; --i)
+			{
+				merged << visited[i];
+			}
+
+			merged.insert(merged.end(), (corridor.begin() + furthestPath + 1), corridor.end());
+
+			if (detail::CrowdMaxPathPolys < merged.size())
+			{
+				merged.resize(detail::CrowdMaxPathPolys);
+			}
+
+			corridor = std::move(merged);
+		}
+
+		// 直進できることがわかった区間で、通路の先頭を置き換える
+		static bool MergeCorridorStartShortcut(Array<dtPolyRef>& corridor, const dtPolyRef* visited, const int32 nvisited)
+		{
+			const auto [furthestPath, furthestVisited] = FindFurthestCommon(corridor, visited, nvisited);
+
+			if ((furthestPath < 0) || (furthestVisited <= 0))
+			{
+				return false;
+			}
+
+			Array<dtPolyRef> merged(visited, (visited + furthestVisited));
+
+			merged.insert(merged.end(), (corridor.begin() + furthestPath), corridor.end());
+
+			corridor = std::move(merged);
+
+			return true;
+		}
+
+		// 円 c0 が速度 v で移動するとき、円 c1 と重なっている時間の範囲を求める
+		[[nodiscard]]
+		static bool SweepCircleCircle(const Float2& c0, const float r0, const Float2& v, const Float2& c1, const float r1, float& tmin, float& tmax) noexcept
+		{
+			const Float2 s = (c1 - c0);
+			const float r = (r0 + r1);
+			const float c = (s.lengthSq() - r * r);
+			const float a = v.lengthSq();
+
+			if (a < 1e-4f)
+			{
+				return false;
+			}
+
+			const float b = v.dot(s);
+			const float d = (b * b - a * c);
+
+			if (d < 0.0f)
+			{
+				return false;
+			}
+
+			const float rd = std::sqrt(d);
+			tmin = ((b - rd) / a);
+			tmax = ((b + rd) / a);
+
+			return true;
+		}
+	}
+
+	NavCrowd::NavCrowdDetail::NavCrowdDetail()
+		: m_grid{ 4.0 }
+	{
+		// do nothing
+	}
+
+	NavCrowd::NavCrowdDetail::NavCrowdDetail(const std::shared_ptr<NavMesh::NavMeshDetail>& navMesh, const Array<std::pair<int32, double>>& areaCosts)
+		: m_navMesh{ navMesh }
+		, m_filter{ detail::MakeQueryFilter(areaCosts) }
+		, m_grid{ 4.0 }
+		, m_tileGeneration{ navMesh->getTileGeneration() } {}
+
+	NavCrowd::NavCrowdDetail::~NavCrowdDetail()
+	{
+		// do nothing
+	}
+
+	NavCrowdAgentID NavCrowd::NavCrowdDetail::addAgent(const Float3& pos, const Float3& extent, const NavCrowdAgentParameters& parameters)
+	{
+		if ((not m_navMesh) || (not m_navMesh->isBuilt()))
+		{
+			return 0;
+		}
+
+		detail::NavMeshQueryPtr navmeshQuery = m_navMesh->acquireQuery();
+
+		if (not navmeshQuery)
+		{
+			return 0;
+		}
+
+		dtPolyRef ref = 0;
+		Float3 nearest = pos;
+		{
+			const auto lock = m_navMesh->lockTiles();
+
+			navmeshQuery->findNearestPoly(&pos.x, &extent.x, &m_filter, &ref, &nearest.x);
+		}
+
+		m_navMesh->releaseQuery(std::move(navmeshQuery));
+
+		if (ref == 0)
+		{
+			return 0;
+		}
+
+		const NavCrowdAgentID id = m_nextID++;
+
+		m_indices.emplace(id, m_ids.size());
+		m_ids << id;
+		m_positions << nearest;
+		m_velocities << Float3{ 0, 0, 0 };
+		m_requestedTargets << nearest;
+		m_targets << nearest;
+		m_partialPaths << false;
+		m_extents << extent;
+		m_radii << static_cast<float>(parameters.radius);
+		m_heights << static_cast<float>(parameters.height);
+		m_maxSpeeds << static_cast<float>(parameters.maxSpeed);
+		m_maxAccelerations << static_cast<float>(parameters.maxAcceleration);
+		m_states << AgentState::Idle;
+		m_corridors << Array<dtPolyRef>{ ref };
+
+		return id;
+	}
+
+	bool NavCrowd::NavCrowdDetail::removeAgent(const NavCrowdAgentID id)
+	{
+		auto it = m_indices.find(id);
+
+		if (it == m_indices.end())
+		{
+			return false;
+		}
+
+		const size_t index = it->second;
+		m_indices.erase(it);
+
+		if ((index + 1) != m_ids.size())
+		{
+			m_indices[m_ids.back()] = index;
+		}
+
+		detail::SwapRemove(m_ids, index);
+		detail::SwapRemove(m_positions, index);
+		detail::SwapRemove(m_velocities, index);
+		detail::SwapRemove(m_requestedTargets, index);
+		detail::SwapRemove(m_targets, index);
+		detail::SwapRemove(m_partialPaths, index);
+		detail::SwapRemove(m_extents, index);
+		detail::SwapRemove(m_radii, index);
+		detail::SwapRemove(m_heights, index);
+		detail::SwapRemove(m_maxSpeeds, index);
+		detail::SwapRemove(m_maxAccelerations, index);
+		detail::SwapRemove(m_states, index);
+		detail::SwapRemove(m_corridors, index);
+
+		return true;
+	}
+
+	void NavCrowd::NavCrowdDetail::clear()
+	{
+		m_ids.clear();
+		m_positions.clear();
+		m_velocities.clear();
+		m_requestedTargets.clear();
+		m_targets.clear();
+		m_partialPaths.clear();
+		m_extents.clear();
+		m_radii.clear();
+		m_heights.clear();
+		m_maxSpeeds.clear();
+		m_maxAccelerations.clear();
+		m_states.clear();
+		m_corridors.clear();
+		m_indices.clear();
+	}
+
+	bool NavCrowd::NavCrowdDetail::setTarget(const NavCrowdAgentID id, const Float3& target)
+	{
+		const size_t index = getIndex(id);
+
+		if (index == m_ids.size())
+		{
+			return false;
+		}
+
+		m_requestedTargets[index] = target;
+		m_targets[index] = target;
+		m_states[index] = AgentState::Planning;
+
+		return true;
+	}
+
+	bool NavCrowd::NavCrowdDetail::resetTarget(const NavCrowdAgentID id)
+	{
+		const size_t index = getIndex(id);
+
+		if (index == m_ids.size())
+		{
+			return false;
+		}
+
+		m_requestedTargets[index] = m_positions[index];
+		m_targets[index] = m_positions[index];
+		m_partialPaths[index] = false;
+		m_states[index] = AgentState::Idle;
+
+		if (m_corridors[index].size() > 1)
+		{
+			m_corridors[index].resize(1);
+		}
+
+		return true;
+	}
+
+	void NavCrowd::NavCrowdDetail::update(const double deltaTime)
+	{
+		if ((deltaTime <= 0.0) || (not m_navMesh) || m_ids.isEmpty())
+		{
+			return;
+		}
+
+		// 更新の間はタイルを差し替えさせない
+		const auto lock = m_navMesh->lockTiles();
+
+		if (not m_navMesh->isBuilt())
+		{
+			return;
+		}
+
+		if (const uint64 tileGeneration = m_navMesh->getTileGeneration();
+			tileGeneration != m_tileGeneration)
+		{
+			revalidateCorridors();
+
+			m_tileGeneration = tileGeneration;
+		}
+
+		const size_t num_agents = m_ids.size();
+		m_desiredVelocities.resize(num_agents);
+		m_newVelocities.resize(num_agents);
+		m_newPositions.resize(num_agents);
+		m_displacements.resize(num_agents);
+		m_neighbours.resize(num_agents);
+
+		planPaths();
+
+		findNeighbours();
+
+		steer();
+
+		avoidCollisions();
+
+		integrate(static_cast<float>(deltaTime));
+
+		separate();
+
+		moveAlongSurface();
+	}
+
+	size_t NavCrowd::NavCrowdDetail::num_agents() const noexcept
+	{
+		return m_ids.size();
+	}
+
+	bool NavCrowd::NavCrowdDetail::hasAgent(const NavCrowdAgentID id) const
+	{
+		return m_indices.contains(id);
+	}
+
+	size_t NavCrowd::NavCrowdDetail::getIndex(const NavCrowdAgentID id) const
+	{
+		if (auto it = m_indices.find(id);
+			it != m_indices.end())
+		{
+			return it->second;
+		}
+
+		return m_ids.size();
+	}
+
+	bool NavCrowd::NavCrowdDetail::isMoving(const NavCrowdAgentID id) const
+	{
+		const size_t index = getIndex(id);
+
+		if (index == m_ids.size())
+		{
+			return false;
+		}
+
+		return ((m_states[index] == AgentState::Planning)
+			|| (m_states[index] == AgentState::Moving));
+	}
+
+	const Array<NavCrowdAgentID>& NavCrowd::NavCrowdDetail::agentIDs() const noexcept
+	{
+		return m_ids;
+	}
+
+	const Array<Float3>& NavCrowd::NavCrowdDetail::positions() const noexcept
+	{
+		return m_positions;
+	}
+
+	const Array<Float3>& NavCrowd::NavCrowdDetail::velocities() const noexcept
+	{
+		return m_velocities;
+	}
+
+	const Array<float>& NavCrowd::NavCrowdDetail::radii() const noexcept
+	{
+		return m_radii;
+	}
+
+	void NavCrowd::NavCrowdDetail::revalidateCorridors()
+	{
+		// タイルが差し替えられると、通路のポリゴンは無効になっている可能性がある
+		detail::ForEachAgentBlock(m_ids.size(), [&](const size_t first, const size_t last)
+		{
+			detail::NavMeshQueryPtr navmeshQuery = m_navMesh->acquireQuery();
+
+			if (not navmeshQuery)
+			{
+				return;
+			}
+
+			for (size_t i = first; i < last; ++i)
+			{
+				dtPolyRef ref = 0;
+				Float3 nearest = m_positions[i];
+
+				navmeshQuery->findNearestPoly(&m_positions[i].x, &m_extents[i].x, &m_filter, &ref, &nearest.x);
+
+				if (ref == 0)
+				{
+					m_corridors[i].clear();
+					m_states[i] = AgentState::Idle;
+					continue;
+				}
+
+				m_positions[i] = nearest;
+				m_corridors[i] = { ref };
+
+				// 届かなかった目的地にも、新しいタイルでは届くかもしれない
+				if ((m_states[i] == AgentState::Moving)
+					|| (m_states[i] == AgentState::Blocked))
+				{
+					m_states[i] = AgentState::Planning;
+				}
+			}
+
+			m_navMesh->releaseQuery(std::move(navmeshQuery));
+		});
+	}
+
+	void NavCrowd::NavCrowdDetail::planPaths()
+	{
+		Array<uint32> requests;
+
+		for (uint32 i = 0; i < m_states.size(); ++i)
+		{
+			if (m_states[i] == AgentState::Planning)
+			{
+				requests << i;
+			}
+		}
+
+		detail::ForEachAgentBlock(requests.size(), [&](const size_t first, const size_t last)
+		{
+			detail::NavMeshQueryPtr navmeshQuery = m_navMesh->acquireQuery();
+
+			if (not navmeshQuery)
+			{
+				return;
+			}
+
+			Array<dtPolyRef> polys(detail::CrowdMaxPathPolys);
+
+			for (size_t r = first; r < last; ++r)
+			{
+				const uint32 i = requests[r];
+				Array<dtPolyRef>& corridor = m_corridors[i];
+				m_states[i] = AgentState::Idle;
+
+				if (not corridor)
+				{
+					continue;
+				}
+
+				// 計算し直すときも、前回の通路の終点ではなく指定された目的地を使う
+				const Float3& requestedTarget = m_requestedTargets[i];
+				dtPolyRef targetRef = 0;
+				Float3 target = requestedTarget;
+
+				if (dtStatusFailed(navmeshQuery->findNearestPoly(&requestedTarget.x, &m_extents[i].x, &m_filter, &targetRef, &target.x))
+					|| (targetRef == 0))
+				{
+					continue;
+				}
+
+				int32 npolys = 0;
+
+				if (dtStatusFailed(navmeshQuery->findPath(corridor.front(), targetRef, &m_positions[i].x, &target.x, &m_filter, polys.data(), &npolys, detail::CrowdMaxPathPolys))
+					|| (npolys <= 0))
+				{
+					continue;
+				}
+
+				// 目的地に届かない場合は、届くポリゴン上の最も近い点を目的地にする
+				const bool partial = (polys[npolys - 1] != targetRef);
+
+				if (partial)
+				{
+					navmeshQuery->closestPointOnPoly(polys[npolys - 1], &requestedTarget.x, &target.x, nullptr);
+				}
+
+				corridor.assign(polys.begin(), (polys.begin() + npolys));
+				m_targets[i] = target;
+				m_partialPaths[i] = partial;
+				m_states[i] = AgentState::Moving;
+			}
+
+			m_navMesh->releaseQuery(std::move(navmeshQuery));
+		});
+	}
+
+	void NavCrowd::NavCrowdDetail::findNeighbours()
+	{
+		const float maxRadius = *std::max_element(m_radii.begin(), m_radii.end());
+		const double cellSize = Max((maxRadius * detail::CrowdCollisionQueryRange), detail::CrowdMinGridCellSize);
+
+		if (m_grid.cellSize() != cellSize)
+		{
+			m_grid = SpatialHash2D<Circle>{ cellSize };
+		}
+
+		// 挿入順が ID になる
+		m_grid.clear();
+
+		for (size_t i = 0; i < m_ids.size(); ++i)
+		{
+			m_grid.insert(Circle{ m_positions[i].x, m_positions[i].z, m_radii[i] });
+		}
+
+		detail::ForEachAgentBlock(m_ids.size(), [&](const size_t first, const size_t last)
+		{
+			Array<uint32> candidates;
+			Array<std::pair<float, uint32>> sorted;
+
+			for (size_t i = first; i < last; ++i)
+			{
+				const Float2 pos = detail::XZ(m_positions[i]);
+				const float range = (m_radii[i] * detail::CrowdCollisionQueryRange);
+
+				m_grid.query(Circle{ pos, range }, candidates);
+
+				sorted.clear();
+
+				for (const uint32 k : candidates)
+				{
+					if (k == i)
+					{
+						continue;
+					}
+
+					// 高さの範囲が重ならないエージェントは無視する
+					if (((m_heights[i] + m_heights[k]) * 0.5f) < std::abs(m_positions[i].y - m_positions[k].y))
+					{
+						continue;
+					}
+
+					const float distanceSq = pos.distanceFromSq(detail::XZ(m_positions[k]));
+
+					if (distanceSq < (range * range))
+					{
+						sorted.emplace_back(distanceSq, k);
+					}
+				}
+
+				const size_t count = Min(sorted.size(), detail::CrowdMaxNeighbours);
+				std::partial_sort(sorted.begin(), (sorted.begin() + count), sorted.end());
+
+				Array<uint32>& neighbours = m_neighbours[i];
+				neighbours.clear();
+
+				for (size_t n = 0; n < count; ++n)
+				{
+					neighbours << sorted[n].second;
+				}
+			}
+		});
+	}
+
+	void NavCrowd::NavCrowdDetail::steer()
+	{
+		detail::ForEachAgentBlock(m_ids.size(), [&](const size_t first, const size_t last)
+		{
+			detail::NavMeshQueryPtr navmeshQuery = m_navMesh->acquireQuery();
+
+			if (not navmeshQuery)
+			{
+				return;
+			}
+
+			Float3 corners[detail::CrowdMaxCorners];
+			uint8 cornerFlags[detail::CrowdMaxCorners];
+			dtPolyRef cornerPolys[detail::CrowdMaxCorners];
+			dtPolyRef visited[detail::CrowdMaxVisited * 2];
+
+			for (size_t i = first; i < last; ++i)
+			{
+				m_desiredVelocities[i] = Float3{ 0, 0, 0 };
+
+				Array<dtPolyRef>& corridor = m_corridors[i];
+
+				if ((m_states[i] != AgentState::Moving) || (not corridor))
+				{
+					continue;
+				}
+
+				const Float3& pos = m_positions[i];
+				const Float3& target = m_targets[i];
+				const float radius = m_radii[i];
+
+				const auto findCorners = [&]()
+				{
+					int32 ncorners = 0;
+
+					navmeshQuery->findStraightPath(&pos.x, &target.x, corridor.data(), static_cast<int32>(corridor.size()),
+						&corners[0].x, cornerFlags, cornerPolys, &ncorners, detail::CrowdMaxCorners);
+
+					// すでに到達している角を取り除く
+					int32 skip = 0;
+
+					while ((skip < ncorners)
+						&& (not (cornerFlags[skip] & DT_STRAIGHTPATH_END))
+						&& (detail::XZ(corners[skip]).distanceFromSq(detail::XZ(pos)) < 0.0001f))
+					{
+						++skip;
+					}
+
+					std::copy((corners + skip), (corners + ncorners), corners);
+					std::copy((cornerFlags + skip), (cornerFlags + ncorners), cornerFlags);
+
+					return (ncorners - skip);
+				};
+
+				int32 ncorners = findCorners();
+
+				// 見通しのきく先の角まで直進できる場合、通路を短縮する
+				if (0 < ncorners)
+				{
+					Float3 goal = corners[Min(1, (ncorners - 1))];
+					const float distance = detail::XZ(goal).distanceFrom(detail::XZ(pos));
+					const float range = (radius * detail::CrowdPathOptimizationRange);
+
+					if (range < distance)
+					{
+						goal = (pos + (goal - pos) * (range / distance));
+					}
+
+					float t = 0.0f;
+					Float3 hitNormal;
+					int32 nvisited = 0;
+
+					if ((0.01f < distance)
+						&& dtStatusSucceed(navmeshQuery->raycast(corridor.front(), &pos.x, &goal.x, &m_filter, &t, &hitNormal.x, visited, &nvisited, (detail::CrowdMaxVisited * 2)))
+						&& (1 < nvisited) && (0.99f < t)
+						&& detail::MergeCorridorStartShortcut(corridor, visited, nvisited))
+					{
+						ncorners = findCorners();
+					}
+				}
+
+				const float distanceToTarget = detail::XZ(target).distanceFrom(detail::XZ(pos));
+
+				if ((ncorners == 0)
+					|| (distanceToTarget <= (radius * detail::CrowdArrivalDistance)))
+				{
+					m_states[i] = (m_partialPaths[i] ? AgentState::Blocked : AgentState::Idle);
+					corridor.resize(1);
+					continue;
+				}
+
+				const Float2 direction = (detail::XZ(corners[0]) - detail::XZ(pos)).normalized();
+				float speed = m_maxSpeeds[i];
+
+				// 目的地の手前で減速する
+				if (ncorners == 1)
+				{
+					speed *= Min(1.0f, (distanceToTarget / (radius * 2.0f)));
+				}
+
+				m_desiredVelocities[i] = Float3{ (direction.x * speed), 0.0f, (direction.y * speed) };
+			}
+
+			m_navMesh->releaseQuery(std::move(navmeshQuery));
+		});
+	}
+
+	void NavCrowd::NavCrowdDetail::avoidCollisions()
+	{
+		using Params = detail::CrowdAvoidanceParameters;
+
+		detail::ForEachAgentBlock(m_ids.size(), [&](const size_t first, const size_t last)
+		{
+			for (size_t i = first; i < last; ++i)
+			{
+				const Array<uint32>& neighbours = m_neighbours[i];
+				const Float2 desired = detail::XZ(m_desiredVelocities[i]);
+
+				if (not neighbours)
+				{
+					m_newVelocities[i] = m_desiredVelocities[i];
+					continue;
+				}
+
+				const Float2 pos = detail::XZ(m_positions[i]);
+				const Float2 vel = detail::XZ(m_velocities[i]);
+				const float radius = m_radii[i];
+				const float maxSpeed = m_maxSpeeds[i];
+				const float invMaxSpeed = ((0.0f < maxSpeed) ? (1.0f / maxSpeed) : 0.0f);
+
+				// 候補の速度の評価値（小さいほど良い）
+				const auto penalty = [&](const Float2& candidate)
+				{
+					float side = 0.0f;
+					float tmin = Params::HorizonTime;
+
+					for (const uint32 k : neighbours)
+					{
+						const Float2 otherPos = detail::XZ(m_positions[k]);
+						const Float2 otherVel = detail::XZ(m_velocities[k]);
+						const Float2 dp = (otherPos - pos).normalized();
+						const Float2 np{ -dp.y, dp.x };
+
+						// 相手も半分ずつ避けるとみなす (RVO)
+						const Float2 vab = (candidate * 2.0f - vel - otherVel);
+
+						// 相手の同じ側を通る速度を好む
+						side += Clamp(Min((dp.dot(vab) * 0.5f + 0.5f), (np.dot(vab) * 2.0f)), 0.0f, 1.0f);
+
+						float htmin = 0.0f, htmax = 0.0f;
+
+						if (not detail::SweepCircleCircle(pos, radius, vab, otherPos, m_radii[k], htmin, htmax))
+						{
+							continue;
+						}
+
+						// すでに重なっている場合は、より強く避ける
+						if ((htmin < 0.0f) && (0.0f < htmax))
+						{
+							htmin = (-htmin * 0.5f);
+						}
+
+						if (0.0f <= htmin)
+						{
+							tmin = Min(tmin, htmin);
+						}
+					}
+
+					side /= neighbours.size();
+
+					return (Params::WeightDesiredVelocity * (candidate.distanceFrom(desired) * invMaxSpeed))
+						+ (Params::WeightCurrentVelocity * (candidate.distanceFrom(vel) * invMaxSpeed))
+						+ (Params::WeightSide * side)
+						+ (Params::WeightTimeToImpact * (1.0f / (0.1f + tmin / Params::HorizonTime)));
+				};
+
+				Float2 best = desired;
+				float minPenalty = penalty(desired);
+
+				const auto evaluate = [&](const Float2& candidate)
+				{
+					if (const float p = penalty(candidate);
+						p < minPenalty)
+					{
+						minPenalty = p;
+						best = candidate;
+					}
+				};
+
+				evaluate(Float2{ 0.0f, 0.0f });
+
+				const Float2 base = (desired.isZero() ? vel : desired);
+				const float baseAngle = (base.isZero() ? 0.0f : std::atan2(base.y, base.x));
+
+				for (int32 ring = 1; ring <= Params::Rings; ++ring)
+				{
+					const float speed = (maxSpeed * ring / Params::Rings);
+					const float offset = ((ring % 2) * Math::PiF / Params::Directions);
+
+					for (int32 d = 0; d < Params::Directions; ++d)
+					{
+						const float angle = (baseAngle + offset + (d * Math::TwoPiF / Params::Directions));
+
+						evaluate(Float2{ (std::cos(angle) * speed), (std::sin(angle) * speed) });
+					}
+				}
+
+				m_newVelocities[i] = Float3{ best.x, 0.0f, best.y };
+			}
+		});
+	}
+
+	void NavCrowd::NavCrowdDetail::integrate(const float deltaTime)
+	{
+		detail::ForEachAgentBlock(m_ids.size(), [&](const size_t first, const size_t last)
+		{
+			for (size_t i = first; i < last; ++i)
+			{
+				Float2 dv = (detail::XZ(m_newVelocities[i]) - detail::XZ(m_velocities[i]));
+				const float maxDelta = (m_maxAccelerations[i] * deltaTime);
+
+				if ((maxDelta * maxDelta) < dv.lengthSq())
+				{
+					dv.setLength(maxDelta);
+				}
+
+				Float2 vel = (detail::XZ(m_velocities[i]) + dv);
+
+				if (vel.lengthSq() < 1e-8f)
+				{
+					vel.set(0.0f, 0.0f);
+				}
+
+				m_velocities[i] = Float3{ vel.x, 0.0f, vel.y };
+				m_newPositions[i] = (m_positions[i] + m_velocities[i] * deltaTime);
+			}
+		});
+	}
+
+	void NavCrowd::NavCrowdDetail::separate()
+	{
+		for (int32 iteration = 0; iteration < detail::CrowdSeparationIterations; ++iteration)
+		{
+			detail::ForEachAgentBlock(m_ids.size(), [&](const size_t first, const size_t last)
+			{
+				for (size_t i = first; i < last; ++i)
+				{
+					const Float2 pos = detail::XZ(m_newPositions[i]);
+					Float2 displacement{ 0.0f, 0.0f };
+					int32 count = 0;
+
+					for (const uint32 k : m_neighbours[i])
+					{
+						Float2 diff = (pos - detail::XZ(m_newPositions[k]));
+						const float minDistance = (m_radii[i] + m_radii[k]);
+						const float distanceSq = diff.lengthSq();
+
+						if ((minDistance * minDistance) < distanceSq)
+						{
+							continue;
+						}
+
+						const float distance = std::sqrt(distanceSq);
+
+						if (distance < 0.0001f)
+						{
+							// 完全に重なっている場合は、番号で押す向きを決める
+							diff = ((i < k) ? Float2{ -0.01f, 0.0f } : Float2{ 0.01f, 0.0f });
+							displacement += diff;
+						}
+						else
+						{
+							displacement += (diff * ((minDistance - distance) * 0.5f * detail::CrowdCollisionResolveFactor / distance));
+						}
+
+						++count;
+					}
+
+					m_displacements[i] = (count ? (displacement / static_cast<float>(count)) : Float2{ 0.0f, 0.0f });
+				}
+			});
+
+			for (size_t i = 0; i < m_ids.size(); ++i)
+			{
+				m_newPositions[i].x += m_displacements[i].x;
+				m_newPositions[i].z += m_displacements[i].y;
+			}
+		}
+	}
+
+	void NavCrowd::NavCrowdDetail::moveAlongSurface()
+	{
+		detail::ForEachAgentBlock(m_ids.size(), [&](const size_t first, const size_t last)
+		{
+			detail::NavMeshQueryPtr navmeshQuery = m_navMesh->acquireQuery();
+
+			if (not navmeshQuery)
+			{
+				return;
+			}
+
+			dtPolyRef visited[detail::CrowdMaxVisited];
+
+			for (size_t i = first; i < last; ++i)
+			{
+				Array<dtPolyRef>& corridor = m_corridors[i];
+
+				// ナビメッシュの外にいるエージェントは動かさない
+				if (not corridor)
+				{
+					continue;
+				}
+
+				Float3 result;
+				int32 nvisited = 0;
+
+				if (dtStatusFailed(navmeshQuery->moveAlongSurface(corridor.front(), &m_positions[i].x, &m_newPositions[i].x,
+					&m_filter, &result.x, visited, &nvisited, detail::CrowdMaxVisited)) || (nvisited == 0))
+				{
+					continue;
+				}
+
+				if (m_states[i] == AgentState::Moving)
+				{
+					detail::MergeCorridorStartMoved(corridor, visited, nvisited);
+				}
+				else
+				{
+					corridor = { visited[nvisited - 1] };
+				}
+
+				float height = 0.0f;
+
+				if (dtStatusSucceed(navmeshQuery->getPolyHeight(corridor.front(), &result.x, &height)))
+				{
+					result.y = height;
+				}
+
+				m_positions[i] = result;
+			}
+
+			m_navMesh->releaseQuery(std::move(navmeshQuery));
+		});
+	}
+}
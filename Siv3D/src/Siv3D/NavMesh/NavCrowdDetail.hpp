@@ -0,0 +1,150 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/NavCrowd.hpp>
+# include <Siv3D/HashTable.hpp>
+# include <Siv3D/SpatialHash2D.hpp>
+# include "NavMeshDetail.hpp"
+
+namespace s3d
+{
+	class NavCrowd::NavCrowdDetail
+	{
+	public:
+
+		NavCrowdDetail();
+
+		NavCrowdDetail(const std::shared_ptr<NavMesh::NavMeshDetail>& navMesh, const Array<std::pair<int32, double>>& areaCosts);
+
+		~NavCrowdDetail();
+
+		NavCrowdAgentID addAgent(const Float3& pos, const Float3& extent, const NavCrowdAgentParameters& parameters);
+
+		bool removeAgent(NavCrowdAgentID id);
+
+		void clear();
+
+		bool setTarget(NavCrowdAgentID id, const Float3& target);
+
+		bool resetTarget(NavCrowdAgentID id);
+
+		void update(double deltaTime);
+
+		size_t num_agents() const noexcept;
+
+		bool hasAgent(NavCrowdAgentID id) const;
+
+		size_t getIndex(NavCrowdAgentID id) const;
+
+		bool isMoving(NavCrowdAgentID id) const;
+
+		const Array<NavCrowdAgentID>& agentIDs() const noexcept;
+
+		const Array<Float3>& positions() const noexcept;
+
+		const Array<Float3>& velocities() const noexcept;
+
+		const Array<float>& radii() const noexcept;
+
+	private:
+
+		enum class AgentState : uint8
+		{
+			// 目的地が無い
+			Idle,
+
+			// 次の update() で経路を計算する
+			Planning,
+
+			// 経路に沿って移動中
+			Moving,
+
+			// 目的地に届かない経路の終点に着いた。タイルが差し替えられたら経路を計算し直す
+			Blocked,
+		};
+
+		std::shared_ptr<NavMesh::NavMeshDetail> m_navMesh;
+
+		dtQueryFilter m_filter;
+
+		////////////////////////////////////////////////////////////////
+		//
+		//	エージェントの番号ごとの状態
+		//
+		Array<NavCrowdAgentID> m_ids;
+
+		Array<Float3> m_positions;
+
+		Array<Float3> m_velocities;
+
+		// setTarget() で指定された目的地
+		Array<Float3> m_requestedTargets;
+
+		// 通路の終点。目的地に届かない場合は、届くポリゴン上の最も近い点
+		Array<Float3> m_targets;
+
+		// 通路が目的地に届いていない
+		Array<bool> m_partialPaths;
+
+		Array<Float3> m_extents;
+
+		Array<float> m_radii;
+
+		Array<float> m_heights;
+
+		Array<float> m_maxSpeeds;
+
+		Array<float> m_maxAccelerations;
+
+		Array<AgentState> m_states;
+
+		// 現在いるポリゴンから目的地のポリゴンまでの通路
+		Array<Array<dtPolyRef>> m_corridors;
+		//
+		////////////////////////////////////////////////////////////////
+
+		// update() の途中結果
+		Array<Float3> m_desiredVelocities;
+
+		Array<Float3> m_newVelocities;
+
+		Array<Float3> m_newPositions;
+
+		Array<Float2> m_displacements;
+
+		Array<Array<uint32>> m_neighbours;
+
+		SpatialHash2D<Circle> m_grid;
+
+		HashTable<NavCrowdAgentID, size_t> m_indices;
+
+		NavCrowdAgentID m_nextID = 1;
+
+		uint64 m_tileGeneration = 0;
+
+		void revalidateCorridors();
+
+		void planPaths();
+
+		void findNeighbours();
+
+		void steer();
+
+		void avoidCollisions();
+
+		void integrate(float deltaTime);
+
+		void separate();
+
+		void moveAlongSurface();
+	};
+}
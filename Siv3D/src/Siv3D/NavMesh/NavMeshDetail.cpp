@@ -10,6 +10,7 @@
 //-----------------------------------------------
 
 # include <Siv3D/Functor.hpp>
+# include <Siv3D/Threading.hpp>
 # include "NavMeshDetail.hpp"
 
 namespace s3d
@@ -106,6 +107,385 @@ namespace s3d
 
 			return cfg;
 		}
+
+		dtQueryFilter MakeQueryFilter(const Array<std::pair<int32, double>>& areaCosts)
+		{
+			dtQueryFilter filter;
+
+			for (const auto& areaCost : areaCosts)
+			{
+				if (areaCost.first <= RC_WALKABLE_AREA)
+				{
+					filter.setAreaCost(areaCost.first, static_cast<float>(areaCost.second));
+				}
+			}
+
+			return filter;
+		}
+
+		[[nodiscard]]
+		static Array<Float3> FindStraightPath(const dtNavMeshQuery& navmeshQuery, const Float3& start, const Float3& end,
+			const Array<dtPolyRef>& polys, const int32 npolys, const dtPolyRef endpoly)
+		{
+			float end2[3] = { end.x, end.y, end.z };
+
+			if (polys[static_cast<size_t>(npolys) - 1] != endpoly)
+			{
+				bool posOverPoly;
+				navmeshQuery.closestPointOnPoly(polys[static_cast<size_t>(npolys) - 1], &end.x, end2, &posOverPoly);
+			}
+
+			Array<Float3> buffer(NavMeshMaxStraightPathVertices);
+			{
+				int32 nvertices = 0;
+
+				navmeshQuery.findStraightPath(&start.x, end2, polys.data(), npolys, &buffer[0].x, 0, 0, &nvertices, NavMeshMaxStraightPathVertices);
+
+				buffer.resize(nvertices);
+			}
+
+			return buffer;
+		}
+
+		[[nodiscard]]
+		static Array<Float3> FindPath(const dtNavMeshQuery& navmeshQuery, const dtQueryFilter& filter, const Float3& start, const Float3& end, const Float3& extent)
+		{
+			dtPolyRef startpoly;
+			{
+				if (dtStatusFailed(navmeshQuery.findNearestPoly(&start.x, &extent.x, &filter, &startpoly, 0)))
+				{
+					return{};
+				}
+
+				if (startpoly == 0)
+				{
+					return{};
+				}
+			}
+
+			dtPolyRef endpoly;
+			{
+				if (dtStatusFailed(navmeshQuery.findNearestPoly(&end.x, &extent.x, &filter, &endpoly, 0)))
+				{
+					return{};
+				}
+
+				if (endpoly == 0)
+				{
+					return{};
+				}
+			}
+
+			Array<dtPolyRef> polys(NavMeshMaxPathPolys);
+			int32 npolys = 0;
+			{
+				if (dtStatusFailed(navmeshQuery.findPath(startpoly, endpoly, &start.x, &end.x, &filter, polys.data(), &npolys, NavMeshMaxPathPolys)))
+				{
+					return{};
+				}
+
+				if (npolys <= 0)
+				{
+					return{};
+				}
+			}
+
+			return FindStraightPath(navmeshQuery, start, end, polys, npolys, endpoly);
+		}
+
+		// タイルの番号に使う dtPolyRef のビット数の上限（残りはポリゴンの番号に使う）
+		inline constexpr int32 NavMeshMaxTileBits = 14;
+
+		[[nodiscard]]
+		static Array<NavMeshObstacle> GetObstacles(const HashTable<NavMeshObstacleID, NavMeshObstacle>& obstacles)
+		{
+			Array<NavMeshObstacle> results(Arg::reserve = obstacles.size());
+
+			for (const auto& obstacle : obstacles)
+			{
+				results << obstacle.second;
+			}
+
+			return results;
+		}
+
+		[[nodiscard]]
+		static Array<Array<uint32>> BinTriangles(const NavMeshTileSource& source)
+		{
+			Array<Array<uint32>> tileTriangles(static_cast<size_t>(source.tileCountX) * source.tileCountY);
+
+			if (not source.tiled)
+			{
+				for (uint32 i = 0; i < source.indices.size(); ++i)
+				{
+					tileTriangles.front() << i;
+				}
+
+				return tileTriangles;
+			}
+
+			const rcConfig& cfg = source.config;
+			const float margin = (cfg.borderSize * cfg.cs);
+
+			const auto toTile = [&](const float pos, const float origin, const float tileSize, const int32 tileCount)
+			{
+				return Clamp(static_cast<int32>(std::floor((pos - origin) / tileSize)), 0, (tileCount - 1));
+			};
+
+			for (uint32 i = 0; i < source.indices.size(); ++i)
+			{
+				const TriangleIndex& triangle = source.indices[i];
+				const Float3& p0 = source.vertices[triangle.i0];
+				const Float3& p1 = source.vertices[triangle.i1];
+				const Float3& p2 = source.vertices[triangle.i2];
+
+				const int32 minX = toTile((Min({ p0.x, p1.x, p2.x }) - margin), cfg.bmin[0], source.tileWidth, source.tileCountX);
+				const int32 maxX = toTile((Max({ p0.x, p1.x, p2.x }) + margin), cfg.bmin[0], source.tileWidth, source.tileCountX);
+				const int32 minY = toTile((Min({ p0.z, p1.z, p2.z }) - margin), cfg.bmin[2], source.tileHeight, source.tileCountY);
+				const int32 maxY = toTile((Max({ p0.z, p1.z, p2.z }) + margin), cfg.bmin[2], source.tileHeight, source.tileCountY);
+
+				for (int32 y = minY; y <= maxY; ++y)
+				{
+					for (int32 x = minX; x <= maxX; ++x)
+					{
+						tileTriangles[static_cast<size_t>(y) * source.tileCountX + x] << i;
+					}
+				}
+			}
+
+			return tileTriangles;
+		}
+
+		struct RecastTileData
+		{
+			rcHeightfield* hf = nullptr;
+
+			rcCompactHeightfield* chf = nullptr;
+
+			rcContourSet* cset = nullptr;
+
+			rcPolyMesh* mesh = nullptr;
+
+			rcPolyMeshDetail* dmesh = nullptr;
+
+			RecastTileData()
+			{
+				hf		= rcAllocHeightfield();
+				chf		= rcAllocCompactHeightfield();
+				cset	= rcAllocContourSet();
+				mesh	= rcAllocPolyMesh();
+				dmesh	= rcAllocPolyMeshDetail();
+
+				if ((not hf) || (not chf) || (not cset) || (not mesh) || (not dmesh))
+				{
+					release();
+
+					throw std::bad_alloc();
+				}
+			}
+
+			~RecastTileData()
+			{
+				release();
+			}
+
+			RecastTileData(const RecastTileData&) = delete;
+
+			RecastTileData& operator =(const RecastTileData&) = delete;
+
+			void release()
+			{
+				rcFreePolyMeshDetail(dmesh);
+				rcFreePolyMesh(mesh);
+				rcFreeContourSet(cset);
+				rcFreeCompactHeightfield(chf);
+				rcFreeHeightField(hf);
+
+				hf		= nullptr;
+				chf		= nullptr;
+				cset	= nullptr;
+				mesh	= nullptr;
+				dmesh	= nullptr;
+			}
+		};
+
+		[[nodiscard]]
+		static NavMeshTile BuildTile(const NavMeshTileSource& source, const Array<NavMeshObstacle>& obstacles, const Point& tilePos)
+		{
+			NavMeshTile tile;
+			tile.pos = tilePos;
+
+			const Array<uint32>& triangles = source.tileTriangles[static_cast<size_t>(tilePos.y) * source.tileCountX + tilePos.x];
+
+			if (not triangles)
+			{
+				return tile;
+			}
+
+			rcConfig cfg = source.config;
+
+			if (source.tiled)
+			{
+				const float border = (cfg.borderSize * cfg.cs);
+
+				cfg.width	= (cfg.tileSize + cfg.borderSize * 2);
+				cfg.height	= (cfg.tileSize + cfg.borderSize * 2);
+				cfg.bmin[0]	= (source.config.bmin[0] + tilePos.x * source.tileWidth - border);
+				cfg.bmin[2]	= (source.config.bmin[2] + tilePos.y * source.tileHeight - border);
+				cfg.bmax[0]	= (source.config.bmin[0] + (tilePos.x + 1) * source.tileWidth + border);
+				cfg.bmax[2]	= (source.config.bmin[2] + (tilePos.y + 1) * source.tileHeight + border);
+			}
+
+			const Array<TriangleIndex> indices = triangles.map([&](const uint32 i) { return source.indices[i]; });
+			const Array<uint8> areaIDs = triangles.map([&](const uint32 i) { return source.areaIDs[i]; });
+
+			// rcContext はスレッドごとに用意する
+			rcContext ctx{ false };
+			RecastTileData data;
+
+			if (not rcCreateHeightfield(&ctx, *data.hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch))
+			{
+				return tile;
+			}
+
+			const int32 flagMergeThreshold = 0;
+
+			rcRasterizeTriangles(&ctx, &source.vertices[0].x, static_cast<int32>(source.vertices.size()),
+				&(indices.front().i0), areaIDs.data(), static_cast<int32>(areaIDs.size()), *data.hf, flagMergeThreshold);
+
+			rcFilterLowHangingWalkableObstacles(&ctx, cfg.walkableClimb, *data.hf);
+			rcFilterLedgeSpans(&ctx, cfg.walkableHeight, cfg.walkableClimb, *data.hf);
+			rcFilterWalkableLowHeightSpans(&ctx, cfg.walkableHeight, *data.hf);
+
+			if (not rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *data.hf, *data.chf))
+			{
+				return tile;
+			}
+
+			// 障害物は侵食の前に書き込み、エージェントの半径の分だけ離れた経路にする
+			for (const auto& obstacle : obstacles)
+			{
+				if (obstacle.shape == NavMeshObstacleShape::Cylinder)
+				{
+					const float radius = ((obstacle.bmax.x - obstacle.bmin.x) * 0.5f);
+					const Float3 pos{ (obstacle.bmin.x + radius), obstacle.bmin.y, ((obstacle.bmin.z + obstacle.bmax.z) * 0.5f) };
+
+					rcMarkCylinderArea(&ctx, &pos.x, radius, (obstacle.bmax.y - obstacle.bmin.y), RC_NULL_AREA, *data.chf);
+				}
+				else
+				{
+					rcMarkBoxArea(&ctx, &obstacle.bmin.x, &obstacle.bmax.x, RC_NULL_AREA, *data.chf);
+				}
+			}
+
+			if (not rcErodeWalkableArea(&ctx, cfg.walkableRadius, *data.chf))
+			{
+				return tile;
+			}
+
+			if (not rcBuildDistanceField(&ctx, *data.chf))
+			{
+				return tile;
+			}
+
+			if (not rcBuildRegions(&ctx, *data.chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea))
+			{
+				return tile;
+			}
+
+			if (not rcBuildContours(&ctx, *data.chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *data.cset))
+			{
+				return tile;
+			}
+
+			if (not rcBuildPolyMesh(&ctx, *data.cset, cfg.maxVertsPerPoly, *data.mesh))
+			{
+				return tile;
+			}
+
+			if (not rcBuildPolyMeshDetail(&ctx, *data.mesh, *data.chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *data.dmesh))
+			{
+				return tile;
+			}
+
+			const auto& mesh	= *data.mesh;
+			const auto& dmesh	= *data.dmesh;
+
+			if (mesh.npolys == 0)
+			{
+				return tile;
+			}
+
+			for (int32 i = 0; i < mesh.npolys; ++i)
+			{
+				mesh.flags[i] = 1;
+			}
+
+			dtNavMeshCreateParams params;
+			std::memset(&params, 0, sizeof(params));
+
+			params.verts		= mesh.verts;
+			params.vertCount	= mesh.nverts;
+			params.polys		= mesh.polys;
+			params.polyAreas	= mesh.areas;
+			params.polyFlags	= mesh.flags;
+			params.polyCount	= mesh.npolys;
+			params.nvp			= mesh.nvp;
+
+			params.detailMeshes		= dmesh.meshes;
+			params.detailVerts		= dmesh.verts;
+			params.detailVertsCount	= dmesh.nverts;
+			params.detailTris		= dmesh.tris;
+			params.detailTriCount	= dmesh.ntris;
+
+			params.walkableHeight	= static_cast<float>(cfg.walkableHeight);
+			params.walkableClimb	= static_cast<float>(cfg.walkableClimb);
+			params.tileX			= tilePos.x;
+			params.tileY			= tilePos.y;
+			params.tileLayer		= 0;
+			rcVcopy(params.bmin, mesh.bmin);
+			rcVcopy(params.bmax, mesh.bmax);
+			params.cs = cfg.cs;
+			params.ch = cfg.ch;
+			params.buildBvTree = true;
+
+			unsigned char* navData = nullptr;
+
+			if (not dtCreateNavMeshData(&params, &navData, &tile.dataSize))
+			{
+				return tile;
+			}
+
+			tile.data.reset(navData);
+
+			return tile;
+		}
+
+		[[nodiscard]]
+		static Array<NavMeshTile> BuildTiles(const NavMeshTileSource& source, const Array<NavMeshObstacle>& obstacles, const Array<Point>& tiles)
+		{
+			Array<NavMeshTile> results(tiles.size());
+
+			const auto buildRange = [&](const size_t first, const size_t last)
+			{
+				for (size_t i = first; i < last; ++i)
+				{
+					results[i] = BuildTile(source, obstacles, tiles[i]);
+				}
+			};
+
+		# ifndef SIV3D_NO_CONCURRENT_API
+
+			Threading::ParallelFor(tiles.size(), buildRange, 1);
+
+		# else
+
+			buildRange(0, tiles.size());
+
+		# endif
+
+			return results;
+		}
 	}
 
 	NavMesh::NavMeshDetail::NavMeshDetail()
@@ -142,10 +522,16 @@ namespace s3d
 		try
 		{
 			const Array<Float3> vertex3 = vertices.map([](const Float2& v) { return Float3{ v.x, 0.0f, v.y }; });
-			build(config, detail::CalculateAABB(vertices), vertex3, indices, areaIDs);
+
+			if (not build(config, detail::CalculateAABB(vertices), vertex3, indices, areaIDs))
+			{
+				release();
+				return false;
+			}
 		}
 		catch (...)
 		{
+			release();
 			return false;
 		}
 
@@ -175,282 +561,563 @@ namespace s3d
 
 		try
 		{
-			build(config, detail::CalculateAABB(vertices), vertices, indices, areaIDs);
+			if (not build(config, detail::CalculateAABB(vertices), vertices, indices, areaIDs))
+			{
+				release();
+				return false;
+			}
 		}
 		catch (...)
 		{
+			release();
 			return false;
 		}
 
 		return true;
 	}
 
-	Array<Vec2> NavMesh::NavMeshDetail::query(const Float2& _start, const Float2& _end, const Array<std::pair<int32, double>>& areaCosts) const
+	Array<Vec2> NavMesh::NavMeshDetail::query(const Float2& start, const Float2& end, const Array<std::pair<int32, double>>& areaCosts) const
 	{
 		if (not m_built)
 		{
 			return{};
 		}
 
-		dtQueryFilter filter;
+		detail::NavMeshQueryPtr navmeshQuery = acquireQuery();
+
+		if (not navmeshQuery)
 		{
-			for (const auto& areaCost : areaCosts)
-			{
-				if (areaCost.first <= RC_WALKABLE_AREA)
-				{
-					filter.setAreaCost(areaCost.first, static_cast<float>(areaCost.second));
-				}
-			}
+			return{};
 		}
 
-		const Float3 start{ _start.x, 0.0f, _start.y }, end{ _end.x, 0.0f, _end.y };
-		constexpr Float3 extent{ 2.0f, 0.0f, 2.0f };
+		Array<Float3> path;
+		{
+			std::shared_lock lock{ m_navmeshMutex };
+
+			path = detail::FindPath(*navmeshQuery, detail::MakeQueryFilter(areaCosts),
+				Float3{ start.x, 0.0f, start.y }, Float3{ end.x, 0.0f, end.y }, detail::NavMeshExtent2D);
+		}
+
+		releaseQuery(std::move(navmeshQuery));
 
-		dtPolyRef startpoly;
+		return path.map([](const Float3& v) { return Vec2{ v.x, v.z }; });
+	}
+
+	Array<Vec3> NavMesh::NavMeshDetail::query(const Float3& start, const Float3& end, const Array<std::pair<int32, double>>& areaCosts) const
+	{
+		if (not m_built)
 		{
-			if (dtStatusFailed(m_data.navmeshQuery.findNearestPoly(&start.x, &extent.x, &filter, &startpoly, 0)))
-			{
-				return{};
-			}
+			return{};
+		}
 
-			if (startpoly == 0)
-			{
-				return{};
-			}
+		detail::NavMeshQueryPtr navmeshQuery = acquireQuery();
+
+		if (not navmeshQuery)
+		{
+			return{};
+		}
+
+		Array<Float3> path;
+		{
+			std::shared_lock lock{ m_navmeshMutex };
+
+			path = detail::FindPath(*navmeshQuery, detail::MakeQueryFilter(areaCosts), start, end, detail::NavMeshExtent3D);
+		}
+
+		releaseQuery(std::move(navmeshQuery));
+
+		return path.map([](const Float3& v) { return Vec3{ v }; });
+	}
+
+	Array<Array<Vec2>> NavMesh::NavMeshDetail::queryBatch(const Array<std::pair<Vec2, Vec2>>& startEnds, const Array<std::pair<int32, double>>& areaCosts) const
+	{
+		Array<Array<Vec2>> results(startEnds.size());
+
+		if (not m_built)
+		{
+			return results;
 		}
 
-		dtPolyRef endpoly;
+		const dtQueryFilter filter = detail::MakeQueryFilter(areaCosts);
+
+		// ブロックごとに 1 つの dtNavMeshQuery を使う
+		const auto queryRange = [&](const size_t first, const size_t last)
 		{
-			if (dtStatusFailed(m_data.navmeshQuery.findNearestPoly(&end.x, &extent.x, &filter, &endpoly, 0)))
+			detail::NavMeshQueryPtr navmeshQuery = acquireQuery();
+
+			if (not navmeshQuery)
 			{
-				return{};
+				return;
 			}
 
-			if (endpoly == 0)
+			std::shared_lock lock{ m_navmeshMutex };
+
+			for (size_t i = first; i < last; ++i)
 			{
-				return{};
+				const Vec2& start = startEnds[i].first;
+				const Vec2& end = startEnds[i].second;
+
+				results[i] = detail::FindPath(*navmeshQuery, filter,
+					Float3{ start.x, 0.0, start.y }, Float3{ end.x, 0.0, end.y }, detail::NavMeshExtent2D)
+					.map([](const Float3& v) { return Vec2{ v.x, v.z }; });
 			}
+
+			lock.unlock();
+
+			releaseQuery(std::move(navmeshQuery));
+		};
+
+	# ifndef SIV3D_NO_CONCURRENT_API
+
+		Threading::ParallelFor(startEnds.size(), queryRange, detail::QueryBatchGrainSize);
+
+	# else
+
+		queryRange(0, startEnds.size());
+
+	# endif
+
+		return results;
+	}
+
+	Array<Array<Vec3>> NavMesh::NavMeshDetail::queryBatch(const Array<std::pair<Vec3, Vec3>>& startEnds, const Array<std::pair<int32, double>>& areaCosts) const
+	{
+		Array<Array<Vec3>> results(startEnds.size());
+
+		if (not m_built)
+		{
+			return results;
 		}
 
-		constexpr int32 buffersize = 8192;
-		Array<dtPolyRef> polys(buffersize);
-		int32 npolys = 0;
+		const dtQueryFilter filter = detail::MakeQueryFilter(areaCosts);
+
+		// ブロックごとに 1 つの dtNavMeshQuery を使う
+		const auto queryRange = [&](const size_t first, const size_t last)
 		{
-			if (dtStatusFailed(m_data.navmeshQuery.findPath(startpoly, endpoly, &start.x, &end.x, &filter, polys.data(), &npolys, buffersize)))
+			detail::NavMeshQueryPtr navmeshQuery = acquireQuery();
+
+			if (not navmeshQuery)
 			{
-				return{};
+				return;
 			}
 
-			if (npolys <= 0)
+			std::shared_lock lock{ m_navmeshMutex };
+
+			for (size_t i = first; i < last; ++i)
 			{
-				return{};
+				results[i] = detail::FindPath(*navmeshQuery, filter,
+					Float3{ startEnds[i].first }, Float3{ startEnds[i].second }, detail::NavMeshExtent3D)
+					.map([](const Float3& v) { return Vec3{ v }; });
 			}
-		}
 
-		float end2[3] = { end.x, end.y, end.z };
+			lock.unlock();
 
-		if (polys[static_cast<size_t>(npolys) - 1] != endpoly)
-		{
-			bool posOverPoly;
-			m_data.navmeshQuery.closestPointOnPoly(polys[static_cast<size_t>(npolys) - 1], &end.x, end2, &posOverPoly);
-		}
+			releaseQuery(std::move(navmeshQuery));
+		};
 
-		constexpr int32 maxvertices = 8192;
+	# ifndef SIV3D_NO_CONCURRENT_API
 
-		Array<Float3> buffer(maxvertices);
-		{
-			int32 nvertices = 0;
+		Threading::ParallelFor(startEnds.size(), queryRange, detail::QueryBatchGrainSize);
 
-			m_data.navmeshQuery.findStraightPath(&start.x, end2, polys.data(), npolys, &buffer[0].x, 0, 0, &nvertices, maxvertices);
+	# else
 
-			buffer.resize(nvertices);
-		}
+		queryRange(0, startEnds.size());
 
-		return buffer.map([](const Float3& v) { return Vec2{ v.x, v.z }; });
+	# endif
+
+		return results;
 	}
 
-	Array<Vec3> NavMesh::NavMeshDetail::query(const Float3& start, const Float3& end, const Array<std::pair<int32, double>>& areaCosts) const
+	NavMeshQueryID NavMesh::NavMeshDetail::beginQuery(const Float3& start, const Float3& end, const Float3& extent, const Array<std::pair<int32, double>>& areaCosts)
 	{
+		SlicedQuery query;
+		query.start		= start;
+		query.end		= end;
+		query.extent	= extent;
+		query.filter	= detail::MakeQueryFilter(areaCosts);
+
+		std::lock_guard lock{ m_slicedQueryMutex };
+
+		const NavMeshQueryID id = m_nextQueryID++;
+
 		if (not m_built)
 		{
-			return{};
+			query.state = NavMeshQueryState::Failed;
 		}
-
-		dtQueryFilter filter;
+		else
 		{
-			for (const auto& areaCost : areaCosts)
-			{
-				if (areaCost.first <= RC_WALKABLE_AREA)
-				{
-					filter.setAreaCost(areaCost.first, static_cast<float>(areaCost.second));
-				}
-			}
+			m_pendingQueries.push_back(id);
 		}
 
-		constexpr Float3 extent{ 2.0f, 4.0f, 2.0f };
+		m_slicedQueries.emplace(id, std::move(query));
+
+		return id;
+	}
+
+	void NavMesh::NavMeshDetail::updateQueries(const int32 maxIterations)
+	{
+		std::lock_guard lock{ m_slicedQueryMutex };
 
-		dtPolyRef startpoly;
+		if ((not m_built) || m_pendingQueries.empty())
 		{
-			if (dtStatusFailed(m_data.navmeshQuery.findNearestPoly(&start.x, &extent.x, &filter, &startpoly, 0)))
-			{
-				return{};
-			}
+			return;
+		}
 
-			if (startpoly == 0)
+		if (not m_slicedNavmeshQuery)
+		{
+			if (m_slicedNavmeshQuery = acquireQuery();
+				not m_slicedNavmeshQuery)
 			{
-				return{};
+				return;
 			}
 		}
 
-		dtPolyRef endpoly;
+		std::shared_lock navmeshLock{ m_navmeshMutex };
+
+		// タイルが差し替えられた場合、計算中の経路探索はやり直す
+		const uint64 tileGeneration = m_tileGeneration;
+
+		int32 remainingIterations = maxIterations;
+
+		while ((0 < remainingIterations) && (not m_pendingQueries.empty()))
 		{
-			if (dtStatusFailed(m_data.navmeshQuery.findNearestPoly(&end.x, &extent.x, &filter, &endpoly, 0)))
-			{
-				return{};
-			}
+			const NavMeshQueryID id = m_pendingQueries.front();
+			auto it = m_slicedQueries.find(id);
 
-			if (endpoly == 0)
+			// 取り消された経路探索
+			if ((it == m_slicedQueries.end())
+				|| (it->second.state != NavMeshQueryState::InProgress))
 			{
-				return{};
+				m_pendingQueries.pop_front();
+				m_activeQueryID = 0;
+				continue;
 			}
-		}
 
-		constexpr int32 buffersize = 8192;
-		Array<dtPolyRef> polys(buffersize);
-		int32 npolys = 0;
-		{
-			if (dtStatusFailed(m_data.navmeshQuery.findPath(startpoly, endpoly, &start.x, &end.x, &filter, polys.data(), &npolys, buffersize)))
+			SlicedQuery& query = it->second;
+
+			if ((m_activeQueryID != id) || (m_slicedGeneration != tileGeneration))
 			{
-				return{};
+				m_activeQueryID = id;
+				m_slicedGeneration = tileGeneration;
+
+				if (not startSlicedQuery(query))
+				{
+					query.state = NavMeshQueryState::Failed;
+					m_pendingQueries.pop_front();
+					m_activeQueryID = 0;
+					continue;
+				}
 			}
 
-			if (npolys <= 0)
+			int32 doneIterations = 0;
+			const dtStatus status = m_slicedNavmeshQuery->updateSlicedFindPath(remainingIterations, &doneIterations);
+			remainingIterations -= Max(doneIterations, 1);
+
+			if (dtStatusInProgress(status))
 			{
-				return{};
+				break;
 			}
+
+			finishSlicedQuery(query, status);
+			m_pendingQueries.pop_front();
+			m_activeQueryID = 0;
 		}
+	}
 
-		float end2[3] = { end.x, end.y, end.z };
+	NavMeshQueryState NavMesh::NavMeshDetail::getQueryState(const NavMeshQueryID id) const
+	{
+		std::lock_guard lock{ m_slicedQueryMutex };
 
-		if (polys[static_cast<size_t>(npolys) - 1] != endpoly)
+		if (auto it = m_slicedQueries.find(id);
+			it != m_slicedQueries.end())
 		{
-			bool posOverPoly;
-			m_data.navmeshQuery.closestPointOnPoly(polys[static_cast<size_t>(npolys) - 1], &end.x, end2, &posOverPoly);
+			return it->second.state;
 		}
 
-		constexpr int32 maxvertices = 8192;
+		return NavMeshQueryState::Invalid;
+	}
+
+	bool NavMesh::NavMeshDetail::retrieveQueryResult(const NavMeshQueryID id, Array<Vec2>& path)
+	{
+		std::lock_guard lock{ m_slicedQueryMutex };
+
+		auto it = m_slicedQueries.find(id);
 
-		Array<Float3> buffer(maxvertices);
+		if ((it == m_slicedQueries.end())
+			|| (it->second.state == NavMeshQueryState::InProgress))
 		{
-			int32 nvertices = 0;
+			return false;
+		}
+
+		path = it->second.path.map([](const Float3& v) { return Vec2{ v.x, v.z }; });
+
+		m_slicedQueries.erase(it);
+
+		return true;
+	}
+
+	bool NavMesh::NavMeshDetail::retrieveQueryResult(const NavMeshQueryID id, Array<Vec3>& path)
+	{
+		std::lock_guard lock{ m_slicedQueryMutex };
 
-			m_data.navmeshQuery.findStraightPath(&start.x, end2, polys.data(), npolys, &buffer[0].x, 0, 0, &nvertices, maxvertices);
+		auto it = m_slicedQueries.find(id);
 
-			buffer.resize(nvertices);
+		if ((it == m_slicedQueries.end())
+			|| (it->second.state == NavMeshQueryState::InProgress))
+		{
+			return false;
 		}
 
-		return buffer.map([](const Float3& v) { return Vec3{ v }; });
+		path = it->second.path.map([](const Float3& v) { return Vec3{ v }; });
+
+		m_slicedQueries.erase(it);
+
+		return true;
 	}
 
-	bool NavMesh::NavMeshDetail::build(const NavMeshConfig& config, const NavMeshAABB& aabb,
-		const Array<Float3>& vertices, const Array<TriangleIndex>& indices, const Array<uint8>& areaIDs)
+	void NavMesh::NavMeshDetail::cancelQuery(const NavMeshQueryID id)
 	{
-		assert(not m_built);
+		std::lock_guard lock{ m_slicedQueryMutex };
+
+		// 待ち行列からは updateQueries() で取り除く
+		m_slicedQueries.erase(id);
+	}
+
+	NavMeshObstacleID NavMesh::NavMeshDetail::addObstacle(const detail::NavMeshObstacle& obstacle)
+	{
+		if (not m_built)
+		{
+			return 0;
+		}
 
-		init();
+		std::lock_guard lock{ m_tileMutex };
 
-		const rcConfig cfg = detail::MakeConfig(config, aabb);
+		const NavMeshObstacleID id = m_nextObstacleID++;
 
-		if (not rcCreateHeightfield(&m_data.ctx, *m_data.hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch))
+		m_obstacles.emplace(id, obstacle);
+
+		markDirtyTiles(obstacle);
+
+		return id;
+	}
+
+	bool NavMesh::NavMeshDetail::removeObstacle(const NavMeshObstacleID id)
+	{
+		std::lock_guard lock{ m_tileMutex };
+
+		auto it = m_obstacles.find(id);
+
+		if (it == m_obstacles.end())
 		{
 			return false;
 		}
 
-		const int32 flagMergeThreshold = 0;
+		markDirtyTiles(it->second);
 
-		rcRasterizeTriangles(&m_data.ctx, &vertices[0].x, static_cast<int32>(vertices.size()),
-			&(indices.front().i0), areaIDs.data(), static_cast<int32>(areaIDs.size()), *m_data.hf, flagMergeThreshold);
+		m_obstacles.erase(it);
 
-		rcFilterLowHangingWalkableObstacles(&m_data.ctx, cfg.walkableClimb, *m_data.hf);
-		rcFilterLedgeSpans(&m_data.ctx, cfg.walkableHeight, cfg.walkableClimb, *m_data.hf);
-		rcFilterWalkableLowHeightSpans(&m_data.ctx, cfg.walkableHeight, *m_data.hf);
+		return true;
+	}
+
+	void NavMesh::NavMeshDetail::clearObstacles()
+	{
+		std::lock_guard lock{ m_tileMutex };
 
-		if (not rcBuildCompactHeightfield(&m_data.ctx, cfg.walkableHeight, cfg.walkableClimb, *m_data.hf, *m_data.chf))
+		for (const auto& obstacle : m_obstacles)
 		{
-			return false;
+			markDirtyTiles(obstacle.second);
 		}
 
-		if (not rcErodeWalkableArea(&m_data.ctx, cfg.walkableRadius, *m_data.chf))
+		m_obstacles.clear();
+	}
+
+	size_t NavMesh::NavMeshDetail::num_obstacles() const
+	{
+		std::lock_guard lock{ m_tileMutex };
+
+		return m_obstacles.size();
+	}
+
+	bool NavMesh::NavMeshDetail::update()
+	{
+		if (not m_built)
 		{
 			return false;
 		}
 
-		if (not rcBuildDistanceField(&m_data.ctx, *m_data.chf))
+		std::lock_guard lock{ m_tileMutex };
+
+	# ifndef SIV3D_NO_CONCURRENT_API
+
+		bool updated = false;
+
+		if (m_tileTask.isReady())
+		{
+			updated = applyTileTask();
+		}
+
+		if ((not m_tileTask.isValid()) && (not m_dirtyTiles.empty()))
 		{
-			return false;
+			m_buildingTiles = takeDirtyTiles();
+
+			m_tileTask = Threading::Submit([source = m_tileSource, obstacles = detail::GetObstacles(m_obstacles), tiles = m_buildingTiles]()
+				{
+					return detail::BuildTiles(*source, obstacles, tiles);
+				});
 		}
 
-		if (not rcBuildRegions(&m_data.ctx, *m_data.chf, 0 /* border size */, cfg.minRegionArea, cfg.mergeRegionArea))
+		return updated;
+
+	# else
+
+		if (m_dirtyTiles.empty())
 		{
 			return false;
 		}
 
-		if (not rcBuildContours(&m_data.ctx, *m_data.chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *m_data.cset))
+		applyTiles(detail::BuildTiles(*m_tileSource, detail::GetObstacles(m_obstacles), takeDirtyTiles()));
+
+		return true;
+
+	# endif
+	}
+
+	void NavMesh::NavMeshDetail::rebuildTiles()
+	{
+		if (not m_built)
 		{
-			return false;
+			return;
 		}
 
-		if (not rcBuildPolyMesh(&m_data.ctx, *m_data.cset, cfg.maxVertsPerPoly, *m_data.mesh))
+		std::lock_guard lock{ m_tileMutex };
+
+	# ifndef SIV3D_NO_CONCURRENT_API
+
+		if (m_tileTask.isValid())
 		{
-			return false;
+			applyTileTask();
+		}
+
+	# endif
+
+		if (not m_dirtyTiles.empty())
+		{
+			applyTiles(detail::BuildTiles(*m_tileSource, detail::GetObstacles(m_obstacles), takeDirtyTiles()));
+		}
+	}
+
+	bool NavMesh::NavMeshDetail::isUpdating() const
+	{
+		std::lock_guard lock{ m_tileMutex };
+
+	# ifndef SIV3D_NO_CONCURRENT_API
+
+		if (m_tileTask.isValid())
+		{
+			return true;
 		}
 
-		if (not rcBuildPolyMeshDetail(&m_data.ctx, *m_data.mesh, *m_data.chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *m_data.dmesh))
+	# endif
+
+		return (not m_dirtyTiles.empty());
+	}
+
+	Size NavMesh::NavMeshDetail::getTileCount() const
+	{
+		if (not m_built)
+		{
+			return{ 0, 0 };
+		}
+
+		return{ m_tileSource->tileCountX, m_tileSource->tileCountY };
+	}
+
+	bool NavMesh::NavMeshDetail::build(const NavMeshConfig& config, const NavMeshAABB& aabb,
+		const Array<Float3>& vertices, const Array<TriangleIndex>& indices, const Array<uint8>& areaIDs)
+	{
+		assert(not m_built);
+
+		auto source = std::make_shared<detail::NavMeshTileSource>();
+		source->vertices	= vertices;
+		source->indices		= indices;
+		source->areaIDs		= areaIDs;
+		source->config		= detail::MakeConfig(config, aabb);
+
+		rcConfig& cfg = source->config;
+
+		if (0 < config.tileSize)
+		{
+			cfg.tileSize	= config.tileSize;
+			cfg.borderSize	= (cfg.walkableRadius + 3);
+
+			source->tileCountX	= ((cfg.width + cfg.tileSize - 1) / cfg.tileSize);
+			source->tileCountY	= ((cfg.height + cfg.tileSize - 1) / cfg.tileSize);
+			source->tileWidth	= (cfg.tileSize * cfg.cs);
+			source->tileHeight	= (cfg.tileSize * cfg.cs);
+			source->tiled		= true;
+		}
+		else
+		{
+			source->tileWidth	= (cfg.width * cfg.cs);
+			source->tileHeight	= (cfg.height * cfg.cs);
+		}
+
+		const int32 tileCount = (source->tileCountX * source->tileCountY);
+		const int32 tileBits = static_cast<int32>(dtIlog2(dtNextPow2(static_cast<uint32>(tileCount))));
+
+		// dtPolyRef の 22 ビットを、タイルの番号とポリゴンの番号で分け合う
+		if (detail::NavMeshMaxTileBits < tileBits)
 		{
 			return false;
 		}
 
-		const auto& mesh	= *m_data.mesh;
-		const auto& dmesh	= *m_data.dmesh;
+		source->tileTriangles = detail::BinTriangles(*source);
+
+		dtNavMeshParams params;
+		rcVcopy(params.orig, cfg.bmin);
+		params.tileWidth	= source->tileWidth;
+		params.tileHeight	= source->tileHeight;
+		params.maxTiles		= (1 << tileBits);
+		params.maxPolys		= (1 << (22 - tileBits));
 
-		for (int32 i = 0; i < mesh.npolys; ++i)
+		m_data.navmesh = std::shared_ptr<dtNavMesh>(dtAllocNavMesh(), dtFreeNavMesh);
+
+		if (not m_data.navmesh)
 		{
-			mesh.flags[i] = 1;
+			throw std::bad_alloc();
 		}
 
-		dtNavMeshCreateParams params;
-		std::memset(&params, 0, sizeof(params));
+		if (dtStatusFailed(m_data.navmesh->init(&params)))
+		{
+			return false;
+		}
 
-		params.verts		= mesh.verts;
-		params.vertCount	= mesh.nverts;
-		params.polys		= mesh.polys;
-		params.polyAreas	= mesh.areas;
-		params.polyFlags	= mesh.flags;
-		params.polyCount	= mesh.npolys;
-		params.nvp			= mesh.nvp;
+		Array<Point> tiles;
 
-		params.detailMeshes		= dmesh.meshes;
-		params.detailVerts		= dmesh.verts;
-		params.detailVertsCount	= dmesh.nverts;
-		params.detailTris		= dmesh.tris;
-		params.detailTriCount	= dmesh.ntris;
+		for (int32 y = 0; y < source->tileCountY; ++y)
+		{
+			for (int32 x = 0; x < source->tileCountX; ++x)
+			{
+				tiles.emplace_back(x, y);
+			}
+		}
 
-		params.walkableHeight	= static_cast<float>(cfg.walkableHeight);
-		params.walkableClimb	= static_cast<float>(cfg.walkableClimb);
-		rcVcopy(params.bmin, mesh.bmin);
-		rcVcopy(params.bmax, mesh.bmax);
-		params.cs = cfg.cs;
-		params.ch = cfg.ch;
-		params.buildBvTree = true;
+		Array<detail::NavMeshTile> builtTiles = detail::BuildTiles(*source, {}, tiles);
 
-		if (not dtCreateNavMeshData(&params, &m_navData, &m_navDataSize))
+		if (not builtTiles.any([](const detail::NavMeshTile& tile) { return static_cast<bool>(tile.data); }))
 		{
 			return false;
 		}
 
-		m_data.navmesh->init(m_navData, m_navDataSize, DT_TILE_FREE_DATA);
+		m_tileSource = std::move(source);
 
-		if (dtStatusFailed(m_data.navmeshQuery.init(m_data.navmesh.get(), 2048)))
+		applyTiles(std::move(builtTiles));
+
+		if (detail::NavMeshQueryPtr navmeshQuery = acquireQuery())
+		{
+			releaseQuery(std::move(navmeshQuery));
+		}
+		else
 		{
 			return false;
 		}
@@ -460,89 +1127,217 @@ namespace s3d
 		return true;
 	}
 
-	void NavMesh::NavMeshDetail::init()
+	void NavMesh::NavMeshDetail::markDirtyTiles(const detail::NavMeshObstacle& obstacle)
 	{
-		try
+		const detail::NavMeshTileSource& source = *m_tileSource;
+		const rcConfig& cfg = source.config;
+
+		// 障害物は、境界の余白が重なる隣のタイルにも影響する
+		const float margin = (cfg.borderSize * cfg.cs);
+
+		const auto toTile = [&](const float pos, const float origin, const float tileSize, const int32 tileCount)
 		{
-			if (m_data.hf = rcAllocHeightfield(); 
-				not m_data.hf)
-			{
-				throw std::bad_alloc();
-			}
+			return Clamp(static_cast<int32>(std::floor((pos - origin) / tileSize)), 0, (tileCount - 1));
+		};
 
-			if (m_data.chf = rcAllocCompactHeightfield();
-				not m_data.chf)
-			{
-				throw std::bad_alloc();
-			}
+		const int32 minX = toTile((obstacle.bmin.x - margin), cfg.bmin[0], source.tileWidth, source.tileCountX);
+		const int32 maxX = toTile((obstacle.bmax.x + margin), cfg.bmin[0], source.tileWidth, source.tileCountX);
+		const int32 minY = toTile((obstacle.bmin.z - margin), cfg.bmin[2], source.tileHeight, source.tileCountY);
+		const int32 maxY = toTile((obstacle.bmax.z + margin), cfg.bmin[2], source.tileHeight, source.tileCountY);
 
-			if (m_data.cset = rcAllocContourSet(); 
-				not m_data.cset)
+		for (int32 y = minY; y <= maxY; ++y)
+		{
+			for (int32 x = minX; x <= maxX; ++x)
 			{
-				throw std::bad_alloc();
+				m_dirtyTiles.emplace(x, y);
 			}
+		}
+	}
+
+	Array<Point> NavMesh::NavMeshDetail::takeDirtyTiles()
+	{
+		Array<Point> tiles(m_dirtyTiles.begin(), m_dirtyTiles.end());
+
+		m_dirtyTiles.clear();
 
-			if (m_data.mesh = rcAllocPolyMesh();
-				not m_data.mesh)
+		return tiles;
+	}
+
+	void NavMesh::NavMeshDetail::applyTiles(Array<detail::NavMeshTile>&& tiles)
+	{
+		{
+			// 構築済みのタイルを差し替える間だけ、経路探索を止める
+			std::unique_lock lock{ m_navmeshMutex };
+
+			for (auto& tile : tiles)
 			{
-				throw std::bad_alloc();
+				if (const dtTileRef ref = m_data.navmesh->getTileRefAt(tile.pos.x, tile.pos.y, 0))
+				{
+					m_data.navmesh->removeTile(ref, nullptr, nullptr);
+				}
+
+				if (tile.data
+					&& dtStatusSucceed(m_data.navmesh->addTile(tile.data.get(), tile.dataSize, DT_TILE_FREE_DATA, 0, nullptr)))
+				{
+					// 所有権は dtNavMesh に移る
+					tile.data.release();
+				}
 			}
+		}
 
-			if (m_data.dmesh = rcAllocPolyMeshDetail();
-				not m_data.dmesh)
+		++m_tileGeneration;
+	}
+
+# ifndef SIV3D_NO_CONCURRENT_API
+
+	bool NavMesh::NavMeshDetail::applyTileTask()
+	{
+		try
+		{
+			applyTiles(m_tileTask.get());
+		}
+		catch (...)
+		{
+			// 失敗したタイルは次の update() で再び構築する
+			m_dirtyTiles.insert(m_buildingTiles.begin(), m_buildingTiles.end());
+			m_buildingTiles.clear();
+			return false;
+		}
+
+		m_buildingTiles.clear();
+
+		return true;
+	}
+
+# endif
+
+	bool NavMesh::NavMeshDetail::isBuilt() const noexcept
+	{
+		return m_built;
+	}
+
+	std::shared_lock<std::shared_mutex> NavMesh::NavMeshDetail::lockTiles() const
+	{
+		return std::shared_lock{ m_navmeshMutex };
+	}
+
+	uint64 NavMesh::NavMeshDetail::getTileGeneration() const noexcept
+	{
+		return m_tileGeneration;
+	}
+
+	detail::NavMeshQueryPtr NavMesh::NavMeshDetail::acquireQuery() const
+	{
+		{
+			std::lock_guard lock{ m_queryPoolMutex };
+
+			if (m_queryPool)
 			{
-				throw std::bad_alloc();
+				detail::NavMeshQueryPtr navmeshQuery = std::move(m_queryPool.back());
+				m_queryPool.pop_back();
+				return navmeshQuery;
 			}
+		}
 
-			m_data.navmesh = std::shared_ptr<dtNavMesh>(dtAllocNavMesh(), dtFreeNavMesh);
+		detail::NavMeshQueryPtr navmeshQuery{ dtAllocNavMeshQuery() };
+
+		if ((not navmeshQuery)
+			|| dtStatusFailed(navmeshQuery->init(m_data.navmesh.get(), detail::NavMeshMaxNodes)))
+		{
+			return{};
 		}
-		catch (...)
+
+		return navmeshQuery;
+	}
+
+	void NavMesh::NavMeshDetail::releaseQuery(detail::NavMeshQueryPtr&& navmeshQuery) const
+	{
+		std::lock_guard lock{ m_queryPoolMutex };
+
+		m_queryPool.push_back(std::move(navmeshQuery));
+	}
+
+	bool NavMesh::NavMeshDetail::startSlicedQuery(SlicedQuery& query)
+	{
+		// dtNavMeshQuery はフィルタのポインタを保持するので、探索が終わるまで同じアドレスに置く
+		m_slicedFilter = query.filter;
+
+		dtPolyRef startpoly = 0;
+
+		if (dtStatusFailed(m_slicedNavmeshQuery->findNearestPoly(&query.start.x, &query.extent.x, &m_slicedFilter, &startpoly, 0))
+			|| (startpoly == 0))
 		{
-			release();
+			return false;
+		}
 
-			throw;
+		if (dtStatusFailed(m_slicedNavmeshQuery->findNearestPoly(&query.end.x, &query.extent.x, &m_slicedFilter, &query.endRef, 0))
+			|| (query.endRef == 0))
+		{
+			return false;
 		}
+
+		return (not dtStatusFailed(m_slicedNavmeshQuery->initSlicedFindPath(startpoly, query.endRef, &query.start.x, &query.end.x, &m_slicedFilter)));
 	}
 
-	void NavMesh::NavMeshDetail::release()
+	void NavMesh::NavMeshDetail::finishSlicedQuery(SlicedQuery& query, const dtStatus status)
 	{
-		if (not m_built)
+		query.state = NavMeshQueryState::Failed;
+
+		if (dtStatusFailed(status))
 		{
 			return;
 		}
 
-		m_data.navmesh.reset();
+		Array<dtPolyRef> polys(detail::NavMeshMaxPathPolys);
+		int32 npolys = 0;
 
-		if (m_data.dmesh)
+		if (dtStatusFailed(m_slicedNavmeshQuery->finalizeSlicedFindPath(polys.data(), &npolys, detail::NavMeshMaxPathPolys))
+			|| (npolys <= 0))
 		{
-			rcFreePolyMeshDetail(m_data.dmesh);
-			m_data.dmesh = nullptr;
+			return;
 		}
 
-		if (m_data.mesh)
+		query.path = detail::FindStraightPath(*m_slicedNavmeshQuery, query.start, query.end, polys, npolys, query.endRef);
+
+		if (query.path)
 		{
-			rcFreePolyMesh(m_data.mesh);
-			m_data.mesh = nullptr;
+			query.state = NavMeshQueryState::Succeeded;
 		}
+	}
 
-		if (m_data.cset)
+	void NavMesh::NavMeshDetail::release()
+	{
 		{
-			rcFreeContourSet(m_data.cset);
-			m_data.cset = nullptr;
+			std::lock_guard lock{ m_slicedQueryMutex };
+			m_slicedQueries.clear();
+			m_pendingQueries.clear();
+			m_slicedNavmeshQuery.reset();
+			m_activeQueryID = 0;
 		}
 
-		if (m_data.chf)
 		{
-			rcFreeCompactHeightfield(m_data.chf);
-			m_data.chf = nullptr;
+			std::lock_guard lock{ m_queryPoolMutex };
+			m_queryPool.clear();
 		}
 
-		if (m_data.hf)
 		{
-			rcFreeHeightField(m_data.hf);
-			m_data.hf = nullptr;
+			std::lock_guard lock{ m_tileMutex };
+
+		# ifndef SIV3D_NO_CONCURRENT_API
+
+			// 構築中のタイルは、完了しても反映しない
+			m_tileTask = AsyncTask<Array<detail::NavMeshTile>>{};
+			m_buildingTiles.clear();
+
+		# endif
+
+			m_obstacles.clear();
+			m_dirtyTiles.clear();
+			m_tileSource.reset();
 		}
 
+		m_data.navmesh.reset();
+
 		m_built = false;
 	}
 }
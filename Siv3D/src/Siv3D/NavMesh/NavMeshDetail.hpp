@@ -11,7 +11,14 @@
 
 # pragma once
 # include <cfloat>
+# include <mutex>
+# include <shared_mutex>
+# include <atomic>
+# include <deque>
 # include <Siv3D/NavMesh.hpp>
+# include <Siv3D/HashTable.hpp>
+# include <Siv3D/HashSet.hpp>
+# include <Siv3D/Threading.hpp>
 # include <RecastDetour/Recast.h>
 # include <RecastDetour/DetourCommon.h>
 # include <RecastDetour/DetourNavMesh.h>
@@ -27,6 +34,96 @@ namespace s3d
 		float bmax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
 	};
 
+	namespace detail
+	{
+		// 1 つの dtNavMeshQuery が探索できるノードの最大数
+		inline constexpr int32 NavMeshMaxNodes = 2048;
+
+		inline constexpr int32 NavMeshMaxPathPolys = 8192;
+
+		inline constexpr int32 NavMeshMaxStraightPathVertices = 8192;
+
+		// queryBatch() で、1 つの dtNavMeshQuery がまとめて処理する経路の数
+		inline constexpr size_t QueryBatchGrainSize = 8;
+
+		inline constexpr Float3 NavMeshExtent2D{ 2.0f, 0.0f, 2.0f };
+
+		inline constexpr Float3 NavMeshExtent3D{ 2.0f, 4.0f, 2.0f };
+
+		struct NavMeshQueryDeleter
+		{
+			void operator()(dtNavMeshQuery* query) const noexcept
+			{
+				dtFreeNavMeshQuery(query);
+			}
+		};
+
+		using NavMeshQueryPtr = std::unique_ptr<dtNavMeshQuery, NavMeshQueryDeleter>;
+
+		[[nodiscard]]
+		dtQueryFilter MakeQueryFilter(const Array<std::pair<int32, double>>& areaCosts);
+
+		struct NavMeshDataDeleter
+		{
+			void operator()(unsigned char* data) const noexcept
+			{
+				dtFree(data);
+			}
+		};
+
+		using NavMeshDataPtr = std::unique_ptr<unsigned char, NavMeshDataDeleter>;
+
+		// タイルの構築に使う、構築後は変更されない入力データ
+		struct NavMeshTileSource
+		{
+			Array<Float3> vertices;
+
+			Array<TriangleIndex> indices;
+
+			Array<uint8> areaIDs;
+
+			// 各タイル（境界の余白を含む）と重なる三角形の番号
+			Array<Array<uint32>> tileTriangles;
+
+			rcConfig config;
+
+			int32 tileCountX = 1;
+
+			int32 tileCountY = 1;
+
+			float tileWidth = 0.0f;
+
+			float tileHeight = 0.0f;
+
+			bool tiled = false;
+		};
+
+		enum class NavMeshObstacleShape : uint8
+		{
+			Cylinder,
+
+			Box,
+		};
+
+		struct NavMeshObstacle
+		{
+			NavMeshObstacleShape shape = NavMeshObstacleShape::Box;
+
+			Float3 bmin;
+
+			Float3 bmax;
+		};
+
+		struct NavMeshTile
+		{
+			Point pos{ 0, 0 };
+
+			NavMeshDataPtr data;
+
+			int32 dataSize = 0;
+		};
+	}
+
 	class NavMesh::NavMeshDetail
 	{
 	public:
@@ -43,39 +140,150 @@ namespace s3d
 
 		Array<Vec3> query(const Float3& start, const Float3& end, const Array<std::pair<int32, double>>& areaCosts) const;
 
+		Array<Array<Vec2>> queryBatch(const Array<std::pair<Vec2, Vec2>>& startEnds, const Array<std::pair<int32, double>>& areaCosts) const;
+
+		Array<Array<Vec3>> queryBatch(const Array<std::pair<Vec3, Vec3>>& startEnds, const Array<std::pair<int32, double>>& areaCosts) const;
+
+		NavMeshQueryID beginQuery(const Float3& start, const Float3& end, const Float3& extent, const Array<std::pair<int32, double>>& areaCosts);
+
+		void updateQueries(int32 maxIterations);
+
+		NavMeshQueryState getQueryState(NavMeshQueryID id) const;
+
+		bool retrieveQueryResult(NavMeshQueryID id, Array<Vec2>& path);
+
+		bool retrieveQueryResult(NavMeshQueryID id, Array<Vec3>& path);
+
+		void cancelQuery(NavMeshQueryID id);
+
+		NavMeshObstacleID addObstacle(const detail::NavMeshObstacle& obstacle);
+
+		bool removeObstacle(NavMeshObstacleID id);
+
+		void clearObstacles();
+
+		size_t num_obstacles() const;
+
+		bool update();
+
+		void rebuildTiles();
+
+		bool isUpdating() const;
+
+		Size getTileCount() const;
+
+		[[nodiscard]]
+		bool isBuilt() const noexcept;
+
+		/// @brief 経路探索の間、タイルの差し替えを止めます。
+		[[nodiscard]]
+		std::shared_lock<std::shared_mutex> lockTiles() const;
+
+		/// @brief タイルを差し替えるたびに増える値を返します。
+		[[nodiscard]]
+		uint64 getTileGeneration() const noexcept;
+
+		[[nodiscard]]
+		detail::NavMeshQueryPtr acquireQuery() const;
+
+		void releaseQuery(detail::NavMeshQueryPtr&& query) const;
+
 	private:
 
-		struct Data
+		struct SlicedQuery
 		{
-			rcContext ctx;
+			Float3 start;
 
-			rcHeightfield* hf = nullptr;
+			Float3 end;
 
-			rcCompactHeightfield* chf = nullptr;
+			Float3 extent;
 
-			rcContourSet* cset = nullptr;
+			dtQueryFilter filter;
 
-			rcPolyMesh* mesh = nullptr;
+			dtPolyRef endRef = 0;
 
-			rcPolyMeshDetail* dmesh = nullptr;
+			NavMeshQueryState state = NavMeshQueryState::InProgress;
 
-			std::shared_ptr<dtNavMesh> navmesh;
+			Array<Float3> path;
+		};
 
-			dtNavMeshQuery navmeshQuery;
+		struct Data
+		{
+			std::shared_ptr<dtNavMesh> navmesh;
 
 		} m_data;
 
-		unsigned char* m_navData = nullptr;
+		// 経路探索（共有ロック）とタイルの差し替え（排他ロック）
+		mutable std::shared_mutex m_navmeshMutex;
+
+		// タイルを差し替えるたびに増える
+		std::atomic<uint64> m_tileGeneration = 0;
+
+		// 障害物とタイルの再構築
+		mutable std::mutex m_tileMutex;
+
+		std::shared_ptr<const detail::NavMeshTileSource> m_tileSource;
+
+		HashTable<NavMeshObstacleID, detail::NavMeshObstacle> m_obstacles;
+
+		NavMeshObstacleID m_nextObstacleID = 1;
+
+		HashSet<Point> m_dirtyTiles;
 
-		int32 m_navDataSize = 0;
+	# ifndef SIV3D_NO_CONCURRENT_API
+
+		AsyncTask<Array<detail::NavMeshTile>> m_tileTask;
+
+		Array<Point> m_buildingTiles;
+
+	# endif
+
+		// 同時に実行される経路探索がそれぞれ使う dtNavMeshQuery
+		mutable std::mutex m_queryPoolMutex;
+
+		mutable Array<detail::NavMeshQueryPtr> m_queryPool;
+
+		// 複数フレームに分けて計算する経路探索
+		mutable std::mutex m_slicedQueryMutex;
+
+		HashTable<NavMeshQueryID, SlicedQuery> m_slicedQueries;
+
+		std::deque<NavMeshQueryID> m_pendingQueries;
+
+		detail::NavMeshQueryPtr m_slicedNavmeshQuery;
+
+		// 計算中の経路探索のフィルタ（dtNavMeshQuery がポインタを保持する）
+		dtQueryFilter m_slicedFilter;
+
+		NavMeshQueryID m_activeQueryID = 0;
+
+		NavMeshQueryID m_nextQueryID = 1;
+
+		uint64 m_slicedGeneration = 0;
 
 		bool m_built = false;
 
 		bool build(const NavMeshConfig& config, const NavMeshAABB& aabb,
 			const Array<Float3>& vertices, const Array<TriangleIndex>& indices, const Array<uint8>& areaIDs);
 
-		void init();
-
 		void release();
+
+		void markDirtyTiles(const detail::NavMeshObstacle& obstacle);
+
+		[[nodiscard]]
+		Array<Point> takeDirtyTiles();
+
+		void applyTiles(Array<detail::NavMeshTile>&& tiles);
+
+	# ifndef SIV3D_NO_CONCURRENT_API
+
+		bool applyTileTask();
+
+	# endif
+
+		[[nodiscard]]
+		bool startSlicedQuery(SlicedQuery& query);
+
+		void finishSlicedQuery(SlicedQuery& query, dtStatus status);
 	};
 }
@@ -0,0 +1,113 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/NavCrowd.hpp>
+# include "NavCrowdDetail.hpp"
+
+namespace s3d
+{
+	NavCrowd::NavCrowd()
+		: pImpl{ std::make_shared<NavCrowdDetail>() }
+	{
+
+	}
+
+	NavCrowd::NavCrowd(const NavMesh& navMesh, const Array<std::pair<int32, double>>& areaCosts)
+		: pImpl{ std::make_shared<NavCrowdDetail>(navMesh.pImpl, areaCosts) }
+	{
+
+	}
+
+	NavCrowd::~NavCrowd()
+	{
+
+	}
+
+	NavCrowdAgentID NavCrowd::addAgent(const Vec2& pos, const NavCrowdAgentParameters& parameters)
+	{
+		return pImpl->addAgent(Float3{ pos.x, 0.0, pos.y }, detail::NavMeshExtent2D, parameters);
+	}
+
+	NavCrowdAgentID NavCrowd::addAgent(const Vec3& pos, const NavCrowdAgentParameters& parameters)
+	{
+		return pImpl->addAgent(pos, detail::NavMeshExtent3D, parameters);
+	}
+
+	bool NavCrowd::removeAgent(const NavCrowdAgentID id)
+	{
+		return pImpl->removeAgent(id);
+	}
+
+	void NavCrowd::clear()
+	{
+		pImpl->clear();
+	}
+
+	bool NavCrowd::setTarget(const NavCrowdAgentID id, const Vec2& target)
+	{
+		return pImpl->setTarget(id, Float3{ target.x, 0.0, target.y });
+	}
+
+	bool NavCrowd::setTarget(const NavCrowdAgentID id, const Vec3& target)
+	{
+		return pImpl->setTarget(id, target);
+	}
+
+	bool NavCrowd::resetTarget(const NavCrowdAgentID id)
+	{
+		return pImpl->resetTarget(id);
+	}
+
+	void NavCrowd::update(const double deltaTime)
+	{
+		pImpl->update(deltaTime);
+	}
+
+	size_t NavCrowd::num_agents() const noexcept
+	{
+		return pImpl->num_agents();
+	}
+
+	bool NavCrowd::hasAgent(const NavCrowdAgentID id) const
+	{
+		return pImpl->hasAgent(id);
+	}
+
+	size_t NavCrowd::getIndex(const NavCrowdAgentID id) const
+	{
+		return pImpl->getIndex(id);
+	}
+
+	bool NavCrowd::isMoving(const NavCrowdAgentID id) const
+	{
+		return pImpl->isMoving(id);
+	}
+
+	const Array<NavCrowdAgentID>& NavCrowd::agentIDs() const noexcept
+	{
+		return pImpl->agentIDs();
+	}
+
+	const Array<Float3>& NavCrowd::positions() const noexcept
+	{
+		return pImpl->positions();
+	}
+
+	const Array<Float3>& NavCrowd::velocities() const noexcept
+	{
+		return pImpl->velocities();
+	}
+
+	const Array<float>& NavCrowd::radii() const noexcept
+	{
+		return pImpl->radii();
+	}
+}
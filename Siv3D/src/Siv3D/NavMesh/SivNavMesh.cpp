@@ -64,4 +64,113 @@ namespace s3d
 	{
 		return pImpl->query(start, end, areaCosts);
 	}
+
+	Array<Array<Vec2>> NavMesh::queryBatch(const Array<std::pair<Vec2, Vec2>>& startEnds, const Array<std::pair<int32, double>>& areaCosts) const
+	{
+		return pImpl->queryBatch(startEnds, areaCosts);
+	}
+
+	Array<Array<Vec3>> NavMesh::queryBatch(const Array<std::pair<Vec3, Vec3>>& startEnds, const Array<std::pair<int32, double>>& areaCosts) const
+	{
+		return pImpl->queryBatch(startEnds, areaCosts);
+	}
+
+	NavMeshQueryID NavMesh::beginQuery(const Vec2& start, const Vec2& end, const Array<std::pair<int32, double>>& areaCosts)
+	{
+		return pImpl->beginQuery(Float3{ start.x, 0.0, start.y }, Float3{ end.x, 0.0, end.y }, detail::NavMeshExtent2D, areaCosts);
+	}
+
+	NavMeshQueryID NavMesh::beginQuery(const Vec3& start, const Vec3& end, const Array<std::pair<int32, double>>& areaCosts)
+	{
+		return pImpl->beginQuery(start, end, detail::NavMeshExtent3D, areaCosts);
+	}
+
+	void NavMesh::updateQueries(const int32 maxIterations)
+	{
+		pImpl->updateQueries(maxIterations);
+	}
+
+	NavMeshQueryState NavMesh::getQueryState(const NavMeshQueryID id) const
+	{
+		return pImpl->getQueryState(id);
+	}
+
+	bool NavMesh::retrieveQueryResult(const NavMeshQueryID id, Array<Vec2>& path)
+	{
+		return pImpl->retrieveQueryResult(id, path);
+	}
+
+	bool NavMesh::retrieveQueryResult(const NavMeshQueryID id, Array<Vec3>& path)
+	{
+		return pImpl->retrieveQueryResult(id, path);
+	}
+
+	void NavMesh::cancelQuery(const NavMeshQueryID id)
+	{
+		pImpl->cancelQuery(id);
+	}
+
+	NavMeshObstacleID NavMesh::addObstacle(const Circle& circle)
+	{
+		// 2D のナビメッシュは y = 0 の平面上に構築されている
+		return pImpl->addObstacle({ detail::NavMeshObstacleShape::Cylinder,
+			Float3{ (circle.x - circle.r), -1.0, (circle.y - circle.r) }, Float3{ (circle.x + circle.r), 1.0, (circle.y + circle.r) } });
+	}
+
+	NavMeshObstacleID NavMesh::addObstacle(const RectF& rect)
+	{
+		return pImpl->addObstacle({ detail::NavMeshObstacleShape::Box,
+			Float3{ rect.x, -1.0, rect.y }, Float3{ (rect.x + rect.w), 1.0, (rect.y + rect.h) } });
+	}
+
+	NavMeshObstacleID NavMesh::addObstacle(const Cylinder& cylinder)
+	{
+		const Vec3 halfSize{ cylinder.r, (cylinder.h * 0.5), cylinder.r };
+
+		return pImpl->addObstacle({ detail::NavMeshObstacleShape::Cylinder,
+			Float3{ cylinder.center - halfSize }, Float3{ cylinder.center + halfSize } });
+	}
+
+	NavMeshObstacleID NavMesh::addObstacle(const Box& box)
+	{
+		const Vec3 halfSize = (box.size * 0.5);
+
+		return pImpl->addObstacle({ detail::NavMeshObstacleShape::Box,
+			Float3{ box.center - halfSize }, Float3{ box.center + halfSize } });
+	}
+
+	bool NavMesh::removeObstacle(const NavMeshObstacleID id)
+	{
+		return pImpl->removeObstacle(id);
+	}
+
+	void NavMesh::clearObstacles()
+	{
+		pImpl->clearObstacles();
+	}
+
+	size_t NavMesh::num_obstacles() const
+	{
+		return pImpl->num_obstacles();
+	}
+
+	bool NavMesh::update()
+	{
+		return pImpl->update();
+	}
+
+	void NavMesh::rebuildTiles()
+	{
+		pImpl->rebuildTiles();
+	}
+
+	bool NavMesh::isUpdating() const
+	{
+		return pImpl->isUpdating();
+	}
+
+	Size NavMesh::getTileCount() const
+	{
+		return pImpl->getTileCount();
+	}
 }
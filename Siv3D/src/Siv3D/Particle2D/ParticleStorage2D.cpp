@@ -0,0 +1,212 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/Threading.hpp>
+# include "ParticleStorage2D.hpp"
+
+namespace s3d
+{
+	size_t ParticleStorage2D::size() const noexcept
+	{
+		return m_positionX.size();
+	}
+
+	bool ParticleStorage2D::isEmpty() const noexcept
+	{
+		return m_positionX.isEmpty();
+	}
+
+	void ParticleStorage2D::clear() noexcept
+	{
+		resize(0);
+	}
+
+	void ParticleStorage2D::reserve(const size_t n)
+	{
+		m_positionX.reserve(n);
+		m_positionY.reserve(n);
+		m_velocityX.reserve(n);
+		m_velocityY.reserve(n);
+		m_rotation.reserve(n);
+		m_angularVelocity.reserve(n);
+		m_startSize.reserve(n);
+		m_startLifeTime.reserve(n);
+		m_remainingLifeTime.reserve(n);
+		m_startColor.reserve(n);
+	}
+
+	void ParticleStorage2D::push_back(const Particle2D& particle)
+	{
+		m_positionX.push_back(particle.position.x);
+		m_positionY.push_back(particle.position.y);
+		m_velocityX.push_back(particle.velocity.x);
+		m_velocityY.push_back(particle.velocity.y);
+		m_rotation.push_back(particle.rotation);
+		m_angularVelocity.push_back(particle.startAngularVelocity);
+		m_startSize.push_back(particle.startSize);
+		m_startLifeTime.push_back(particle.startLifeTime);
+		m_remainingLifeTime.push_back(particle.remainingLifeTime);
+		m_startColor.push_back(particle.startColor);
+	}
+
+	void ParticleStorage2D::update(const float deltaTime, const Float2& deltaVelocity, const bool parallel)
+	{
+		const size_t count = size();
+
+		if (parallel && (ParallelUpdateThreshold <= count))
+		{
+			// SIMD の 4 要素単位がブロックをまたがないよう、ブロックの大きさを 4 の倍数にする
+			const size_t grainSize = (ParallelUpdateThreshold / 4);
+
+			Threading::ParallelFor(count, [&](const size_t first, const size_t last)
+				{
+					updateRange(first, last, deltaTime, deltaVelocity);
+				}, grainSize);
+		}
+		else
+		{
+			updateRange(0, count, deltaTime, deltaVelocity);
+		}
+	}
+
+	void ParticleStorage2D::removeDead()
+	{
+		const size_t count = size();
+		const float* const pRemainingLifeTime = m_remainingLifeTime.data();
+
+		// 最初に寿命が尽きたパーティクルより前は移動しない
+		size_t i = 0;
+
+		while ((i < count) && (0.0f <= pRemainingLifeTime[i]))
+		{
+			++i;
+		}
+
+		size_t aliveCount = i;
+
+		for (; i < count; ++i)
+		{
+			if (0.0f <= pRemainingLifeTime[i])
+			{
+				moveElement(i, aliveCount++);
+			}
+		}
+
+		resize(aliveCount);
+	}
+
+	void ParticleStorage2D::shrinkTo(const size_t maxParticles)
+	{
+		const size_t count = size();
+
+		if (count <= maxParticles)
+		{
+			return;
+		}
+
+		const size_t removeCount = (count - maxParticles);
+
+		// 先頭の removeCount 個（最も古いパーティクル）を削除し、残りを前に詰める
+		for (size_t i = removeCount; i < count; ++i)
+		{
+			moveElement(i, (i - removeCount));
+		}
+
+		resize(maxParticles);
+	}
+
+	Particle2D ParticleStorage2D::get(const size_t i) const noexcept
+	{
+		Particle2D particle;
+		particle.position				= { m_positionX[i], m_positionY[i] };
+		particle.velocity				= { m_velocityX[i], m_velocityY[i] };
+		particle.startColor				= m_startColor[i];
+		particle.startSize				= m_startSize[i];
+		particle.rotation				= m_rotation[i];
+		particle.startAngularVelocity	= m_angularVelocity[i];
+		particle.startLifeTime			= m_startLifeTime[i];
+		particle.remainingLifeTime		= m_remainingLifeTime[i];
+		return particle;
+	}
+
+	void ParticleStorage2D::updateRange(size_t first, const size_t last, const float deltaTime, const Float2& deltaVelocity) noexcept
+	{
+		float* const pPosX = m_positionX.data();
+		float* const pPosY = m_positionY.data();
+		float* const pVelX = m_velocityX.data();
+		float* const pVelY = m_velocityY.data();
+		float* const pRotation = m_rotation.data();
+		const float* const pAngularVelocity = m_angularVelocity.data();
+		float* const pRemainingLifeTime = m_remainingLifeTime.data();
+
+	# if SIV3D_INTRINSIC(SSE)
+
+		{
+			const __m128 dt = ::_mm_set_ps1(deltaTime);
+			const __m128 dvx = ::_mm_set_ps1(deltaVelocity.x);
+			const __m128 dvy = ::_mm_set_ps1(deltaVelocity.y);
+
+			// first は 4 の倍数なので、16 バイト境界に揃ったロードとストアができる
+			for (; (first + 4) <= last; first += 4)
+			{
+				const __m128 vx = ::_mm_add_ps(::_mm_load_ps(pVelX + first), dvx);
+				const __m128 vy = ::_mm_add_ps(::_mm_load_ps(pVelY + first), dvy);
+				::_mm_store_ps((pVelX + first), vx);
+				::_mm_store_ps((pVelY + first), vy);
+
+				::_mm_store_ps((pPosX + first), ::_mm_add_ps(::_mm_load_ps(pPosX + first), ::_mm_mul_ps(vx, dt)));
+				::_mm_store_ps((pPosY + first), ::_mm_add_ps(::_mm_load_ps(pPosY + first), ::_mm_mul_ps(vy, dt)));
+				::_mm_store_ps((pRotation + first), ::_mm_add_ps(::_mm_load_ps(pRotation + first), ::_mm_mul_ps(::_mm_load_ps(pAngularVelocity + first), dt)));
+				::_mm_store_ps((pRemainingLifeTime + first), ::_mm_sub_ps(::_mm_load_ps(pRemainingLifeTime + first), dt));
+			}
+		}
+
+	# endif
+
+		for (; first < last; ++first)
+		{
+			pRemainingLifeTime[first] -= deltaTime;
+			pVelX[first] += deltaVelocity.x;
+			pVelY[first] += deltaVelocity.y;
+			pPosX[first] += (pVelX[first] * deltaTime);
+			pPosY[first] += (pVelY[first] * deltaTime);
+			pRotation[first] += (pAngularVelocity[first] * deltaTime);
+		}
+	}
+
+	void ParticleStorage2D::moveElement(const size_t from, const size_t to) noexcept
+	{
+		m_positionX[to]			= m_positionX[from];
+		m_positionY[to]			= m_positionY[from];
+		m_velocityX[to]			= m_velocityX[from];
+		m_velocityY[to]			= m_velocityY[from];
+		m_rotation[to]			= m_rotation[from];
+		m_angularVelocity[to]	= m_angularVelocity[from];
+		m_startSize[to]			= m_startSize[from];
+		m_startLifeTime[to]		= m_startLifeTime[from];
+		m_remainingLifeTime[to]	= m_remainingLifeTime[from];
+		m_startColor[to]		= m_startColor[from];
+	}
+
+	void ParticleStorage2D::resize(const size_t n)
+	{
+		m_positionX.resize(n);
+		m_positionY.resize(n);
+		m_velocityX.resize(n);
+		m_velocityY.resize(n);
+		m_rotation.resize(n);
+		m_angularVelocity.resize(n);
+		m_startSize.resize(n);
+		m_startLifeTime.resize(n);
+		m_remainingLifeTime.resize(n);
+		m_startColor.resize(n);
+	}
+}
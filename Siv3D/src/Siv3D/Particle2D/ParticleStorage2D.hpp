@@ -0,0 +1,113 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/Allocator.hpp>
+# include <Siv3D/PointVector.hpp>
+# include <Siv3D/Particle2D.hpp>
+
+namespace s3d
+{
+	/// @brief パーティクルを要素ごとの配列 (Structure of Arrays) で保持するクラス
+	/// @remark 各配列は 16 バイト境界に揃えられ、update() は 4 個ずつ SIMD で更新します。
+	/// @remark パーティクルは生成された順に並び、削除後も残りのパーティクルの順序は保たれます。
+	class ParticleStorage2D
+	{
+	public:
+
+		using FloatArray = Array<float, Allocator<float, 16>>;
+
+		/// @brief update() を並列に実行する最小のパーティクル数
+		static constexpr size_t ParallelUpdateThreshold = (1 << 15);
+
+		[[nodiscard]]
+		size_t size() const noexcept;
+
+		[[nodiscard]]
+		bool isEmpty() const noexcept;
+
+		void clear() noexcept;
+
+		void reserve(size_t n);
+
+		void push_back(const Particle2D& particle);
+
+		/// @brief すべてのパーティクルの寿命、速度、位置、回転を更新します。
+		/// @param deltaTime 経過時間（秒）
+		/// @param deltaVelocity 経過時間で加わる速度
+		/// @param parallel パーティクル数が ParallelUpdateThreshold 以上のときに、スレッドプールで並列に更新する場合 true
+		void update(float deltaTime, const Float2& deltaVelocity, bool parallel);
+
+		/// @brief 寿命が尽きたパーティクルを削除し、残りのパーティクルを前に詰めます。
+		void removeDead();
+
+		/// @brief パーティクル数が maxParticles 以下になるよう、古いパーティクルから削除します。
+		/// @param maxParticles 最大のパーティクル数
+		void shrinkTo(size_t maxParticles);
+
+		/// @brief i 番目のパーティクルを返します。
+		/// @param i インデックス
+		/// @return i 番目のパーティクル
+		[[nodiscard]]
+		Particle2D get(size_t i) const noexcept;
+
+		[[nodiscard]]
+		const float* positionX() const noexcept { return m_positionX.data(); }
+
+		[[nodiscard]]
+		const float* positionY() const noexcept { return m_positionY.data(); }
+
+		[[nodiscard]]
+		const float* rotation() const noexcept { return m_rotation.data(); }
+
+		[[nodiscard]]
+		const float* startSize() const noexcept { return m_startSize.data(); }
+
+		[[nodiscard]]
+		const float* startLifeTime() const noexcept { return m_startLifeTime.data(); }
+
+		[[nodiscard]]
+		const float* remainingLifeTime() const noexcept { return m_remainingLifeTime.data(); }
+
+		[[nodiscard]]
+		const Float4* startColor() const noexcept { return m_startColor.data(); }
+
+	private:
+
+		FloatArray m_positionX;
+
+		FloatArray m_positionY;
+
+		FloatArray m_velocityX;
+
+		FloatArray m_velocityY;
+
+		FloatArray m_rotation;
+
+		FloatArray m_angularVelocity;
+
+		FloatArray m_startSize;
+
+		FloatArray m_startLifeTime;
+
+		FloatArray m_remainingLifeTime;
+
+		Array<Float4> m_startColor;
+
+		void updateRange(size_t first, size_t last, float deltaTime, const Float2& deltaVelocity) noexcept;
+
+		void moveElement(size_t from, size_t to) noexcept;
+
+		void resize(size_t n);
+	};
+}
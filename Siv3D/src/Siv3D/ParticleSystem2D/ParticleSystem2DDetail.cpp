@@ -11,6 +11,8 @@
 
 # include <Siv3D/ScopedRenderStates2D.hpp>
 # include <Siv3D/Math.hpp>
+# include <Siv3D/Random.hpp>
+# include <Siv3D/Threading.hpp>
 # include <Siv3D/Renderer2D/IRenderer2D.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 # include "ParticleSystem2DDetail.hpp"
@@ -32,11 +34,13 @@ namespace s3d
 		};
 	}
 
-	ParticleSystem2D::ParticleSystem2DDetail::ParticleSystem2DDetail() {}
+	ParticleSystem2D::ParticleSystem2DDetail::ParticleSystem2DDetail()
+		: m_seed{ GetDefaultRNG()() } {}
 
 	ParticleSystem2D::ParticleSystem2DDetail::ParticleSystem2DDetail(const Vec2& position, const Vec2& force)
 		: m_position{ position }
-		, m_force{ force } {}
+		, m_force{ force }
+		, m_seed{ GetDefaultRNG()() } {}
 
 	ParticleSystem2D::ParticleSystem2DDetail::ParticleSystem2DDetail(const Vec2& position, const Vec2& force, std::unique_ptr<IEmitter2D>&& emitter,
 		const ParticleSystem2DParameters& parameters, const Texture& texture)
@@ -44,7 +48,8 @@ namespace s3d
 		, m_force{ force }
 		, m_parameters{ parameters }
 		, m_emitter{ std::move(emitter) }
-		, m_particleTexture{ texture } {}
+		, m_particleTexture{ texture }
+		, m_seed{ GetDefaultRNG()() } {}
 
 	ParticleSystem2D::ParticleSystem2DDetail::~ParticleSystem2DDetail() {}
 
@@ -73,11 +78,29 @@ namespace s3d
 		m_particleTexture = texture;
 	}
 
+	void ParticleSystem2D::ParticleSystem2DDetail::setSeed(const uint64 seed) noexcept
+	{
+		m_seed = seed;
+		m_emissionBlockCount = 0;
+	}
+
 	size_t ParticleSystem2D::ParticleSystem2DDetail::num_particles() const noexcept
 	{
 		return m_particles.size();
 	}
 
+	Array<Particle2D> ParticleSystem2D::ParticleSystem2DDetail::getParticles() const
+	{
+		Array<Particle2D> particles(Arg::reserve = m_particles.size());
+
+		for (size_t i = 0; i < m_particles.size(); ++i)
+		{
+			particles.push_back(m_particles.get(i));
+		}
+
+		return particles;
+	}
+
 	void ParticleSystem2D::ParticleSystem2DDetail::prewarm()
 	{
 		if (not m_emitter)
@@ -146,18 +169,17 @@ namespace s3d
 	{
 		const Float2 deltaVelocity = (m_force * deltaTime);
 
-		for (auto& particle : m_particles)
-		{
-			particle.update(deltaTime, deltaVelocity);
-		}
+		m_particles.update(deltaTime, deltaVelocity, true);
 
-		m_particles.remove_if([](const Particle2D& p) { return p.isDead(); });
+		m_particles.removeDead();
 	}
 
 	void ParticleSystem2D::ParticleSystem2DDetail::addParticles(const ParticleSystem2DParameters& params)
 	{
 		const double timePerParticle = (1.0 / params.rate);
 
+		m_newLifeTimes.clear();
+
 		while (m_remainingTime > timePerParticle)
 		{
 			m_remainingTime -= timePerParticle;
@@ -168,28 +190,69 @@ namespace s3d
 				continue;
 			}
 
-			const double startRotationDeg = params.startRotationDeg + Random(-params.randomStartRotationDeg * 0.5, params.randomStartRotationDeg * 0.5);
-			const double angularVelocityDeg = params.startAngularVelocityDeg + Random(-params.randomStartAngularVelocityDeg * 0.5, params.randomStartAngularVelocityDeg * 0.5);
-
-			Particle2D particle(
-				m_emitter->emit(m_position, params.startSpeed),
-				params.startColor.toFloat4(),
-				static_cast<float>(params.startSize),
-				static_cast<float>(Math::ToRadians(startRotationDeg)),
-				static_cast<float>(Math::ToRadians(angularVelocityDeg)),
-				static_cast<float>(params.startLifeTime),
-				static_cast<float>(remainigLifeTime)
-			);
-
-			const float perParticledeltaTime = (particle.startLifeTime - particle.remainingLifeTime);
-			particle.advance(perParticledeltaTime, m_force * perParticledeltaTime);
-			m_particles << particle;
+			m_newLifeTimes << static_cast<float>(remainigLifeTime);
 		}
 
-		if (const size_t maxParticles = static_cast<size_t>(params.maxParticles); m_particles.size() > maxParticles)
+		if (const size_t count = m_newLifeTimes.size())
 		{
-			m_particles.erase(m_particles.begin(), m_particles.begin() + (m_particles.size() - maxParticles));
+			const size_t numBlocks = ((count + (EmissionBlockSize - 1)) / EmissionBlockSize);
+			m_newEmissions.resize(count);
+			m_newParticles.resize(count);
+
+			// ブロックごとに、システムのシード値とブロックの通し番号から乱数エンジンを初期化する。
+			// 生成結果はスレッド数や実行順序に依存しない。
+			const auto emitBlocks = [&](const size_t firstBlock, const size_t lastBlock)
+			{
+				for (size_t block = firstBlock; block < lastBlock; ++block)
+				{
+					const size_t first = (block * EmissionBlockSize);
+					const size_t n = Min(EmissionBlockSize, (count - first));
+					SmallRNG rng{ m_seed + (m_emissionBlockCount + block) * 0x9E3779B97F4A7C15ull };
+
+					m_emitter->emitN((m_newEmissions.data() + first), n, m_position, params.startSpeed, rng);
+
+					for (size_t i = first; i < (first + n); ++i)
+					{
+						const double startRotationDeg = params.startRotationDeg + Random(-params.randomStartRotationDeg * 0.5, params.randomStartRotationDeg * 0.5, rng);
+						const double angularVelocityDeg = params.startAngularVelocityDeg + Random(-params.randomStartAngularVelocityDeg * 0.5, params.randomStartAngularVelocityDeg * 0.5, rng);
+
+						Particle2D particle(
+							m_newEmissions[i],
+							params.startColor.toFloat4(),
+							static_cast<float>(params.startSize),
+							static_cast<float>(Math::ToRadians(startRotationDeg)),
+							static_cast<float>(Math::ToRadians(angularVelocityDeg)),
+							static_cast<float>(params.startLifeTime),
+							m_newLifeTimes[i]
+						);
+
+						const float perParticledeltaTime = (particle.startLifeTime - particle.remainingLifeTime);
+						particle.advance(perParticledeltaTime, m_force * perParticledeltaTime);
+						m_newParticles[i] = particle;
+					}
+				}
+			};
+
+			if ((1 < numBlocks) && m_emitter->supportsParallelEmission())
+			{
+				Threading::ParallelFor(numBlocks, emitBlocks, 1);
+			}
+			else
+			{
+				emitBlocks(0, numBlocks);
+			}
+
+			m_emissionBlockCount += numBlocks;
+
+			m_particles.reserve(m_particles.size() + count);
+
+			for (const auto& particle : m_newParticles)
+			{
+				m_particles.push_back(particle);
+			}
 		}
+
+		m_particles.shrinkTo(static_cast<size_t>(params.maxParticles));
 	}
 
 	void ParticleSystem2D::ParticleSystem2DDetail::drawParticle() const
@@ -199,8 +262,9 @@ namespace s3d
 		const ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc =
 			m_parameters.colorOverLifeTimeFunc ? m_parameters.colorOverLifeTimeFunc : detail::DefaultColorOverLifeTimeFunc;
 
-		for (const auto& particle : m_particles)
+		for (size_t i = 0; i < m_particles.size(); ++i)
 		{
+			const Particle2D particle = m_particles.get(i);
 			const float size = sizeOverLifeTimeFunc(particle.startSize, particle.startLifeTime, particle.remainingLifeTime);
 			const Float4 color = colorOverLifeTimeFunc(particle.startColor, particle.startLifeTime, particle.remainingLifeTime);
 
@@ -227,8 +291,9 @@ namespace s3d
 		const ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc =
 			m_parameters.colorOverLifeTimeFunc ? m_parameters.colorOverLifeTimeFunc : detail::DefaultColorOverLifeTimeFunc;
 
-		for (const auto& particle : m_particles)
+		for (size_t i = 0; i < m_particles.size(); ++i)
 		{
+			const Particle2D particle = m_particles.get(i);
 			const float size = sizeOverLifeTimeFunc(particle.startSize, particle.startLifeTime, particle.remainingLifeTime);
 			const Float4 color = colorOverLifeTimeFunc(particle.startColor, particle.startLifeTime, particle.remainingLifeTime);
 
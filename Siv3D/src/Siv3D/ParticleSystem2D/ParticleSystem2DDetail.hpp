@@ -12,6 +12,7 @@
 # pragma once
 # include <Siv3D/ParticleSystem2D.hpp>
 # include <Siv3D/Particle2D.hpp>
+# include <Siv3D/Particle2D/ParticleStorage2D.hpp>
 
 namespace s3d
 {
@@ -38,8 +39,12 @@ namespace s3d
 
 		void setTexture(const Texture& texture) noexcept;
 
+		void setSeed(uint64 seed) noexcept;
+
 		size_t num_particles() const noexcept;
 
+		Array<Particle2D> getParticles() const;
+
 		void prewarm();
 
 		void update(double deltaTime);
@@ -50,7 +55,10 @@ namespace s3d
 
 	private:
 
-		Array<Particle2D> m_particles;
+		/// @brief 1 つの乱数エンジンで生成するパーティクルの数
+		static constexpr size_t EmissionBlockSize = 256;
+
+		ParticleStorage2D m_particles;
 		double m_remainingTime = 0.0;
 
 		Vec2 m_position = Vec2(0, 0);
@@ -60,6 +68,16 @@ namespace s3d
 		std::unique_ptr<IEmitter2D> m_emitter;
 		Texture m_particleTexture;
 
+		uint64 m_seed = 0;
+
+		uint64 m_emissionBlockCount = 0;
+
+		Array<float> m_newLifeTimes;
+
+		Array<Emission2D> m_newEmissions;
+
+		Array<Particle2D> m_newParticles;
+
 		void updateCurrentparticles(float deltaTime);
 
 		void addParticles(const ParticleSystem2DParameters& params);
@@ -51,11 +51,21 @@ namespace s3d
 		pImpl->setTexture(texture);
 	}
 
+	void ParticleSystem2D::setSeed(const uint64 seed) noexcept
+	{
+		pImpl->setSeed(seed);
+	}
+
 	size_t ParticleSystem2D::num_particles() const noexcept
 	{
 		return pImpl->num_particles();
 	}
 
+	Array<Particle2D> ParticleSystem2D::getParticles() const
+	{
+		return pImpl->getParticles();
+	}
+
 	void ParticleSystem2D::prewarm()
 	{
 		pImpl->prewarm();
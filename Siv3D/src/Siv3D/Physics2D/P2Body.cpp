@@ -400,6 +400,30 @@ namespace s3d
 		return{ detail::ToVec2(pImpl->getBody().GetPosition()), pImpl->getBody().GetAngle() };
 	}
 
+	Vec2 P2Body::getInterpolatedPos(const double alpha) const noexcept
+	{
+		if (isEmpty())
+		{
+			return{ 0, 0 };
+		}
+
+		const Vec2 previous = detail::ToVec2(pImpl->getPreviousPosition());
+
+		return previous.lerp(getPos(), alpha);
+	}
+
+	double P2Body::getInterpolatedAngle(const double alpha) const noexcept
+	{
+		if (isEmpty())
+		{
+			return 0.0;
+		}
+
+		const double previous = pImpl->getPreviousAngle();
+
+		return (previous + (getAngle() - previous) * alpha);
+	}
+
 	P2Body& P2Body::setVelocity(const Vec2 v) noexcept
 	{
 		if (isEmpty())
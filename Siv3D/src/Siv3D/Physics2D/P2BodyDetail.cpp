@@ -37,6 +37,8 @@ namespace s3d
 		bodyDef.position	= detail::ToB2Vec2(center);
 		m_body = m_world->getWorldPtr()->CreateBody(&bodyDef);
 		m_body->SetUserData(this);
+
+		storePreviousTransform();
 	}
 
 	P2Body::P2BodyDetail::~P2BodyDetail()
@@ -135,4 +137,20 @@ namespace s3d
 	{
 		return m_shapes;
 	}
+
+	void P2Body::P2BodyDetail::storePreviousTransform() noexcept
+	{
+		m_previousPosition	= m_body->GetPosition();
+		m_previousAngle		= m_body->GetAngle();
+	}
+
+	const b2Vec2& P2Body::P2BodyDetail::getPreviousPosition() const noexcept
+	{
+		return m_previousPosition;
+	}
+
+	float P2Body::P2BodyDetail::getPreviousAngle() const noexcept
+	{
+		return m_previousAngle;
+	}
 }
@@ -57,6 +57,14 @@ namespace s3d
 		[[nodiscard]]
 		const Array<std::shared_ptr<P2Shape>>& getShapes() const noexcept;
 
+		void storePreviousTransform() noexcept;
+
+		[[nodiscard]]
+		const b2Vec2& getPreviousPosition() const noexcept;
+
+		[[nodiscard]]
+		float getPreviousAngle() const noexcept;
+
 	private:
 
 		std::shared_ptr<detail::P2WorldDetail> m_world;
@@ -66,5 +74,9 @@ namespace s3d
 		b2Body* m_body = nullptr;
 
 		Array<std::shared_ptr<P2Shape>> m_shapes;
+
+		b2Vec2 m_previousPosition = { 0.0f, 0.0f };
+
+		float m_previousAngle = 0.0f;
 	};
 }
@@ -0,0 +1,55 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/Threading.hpp>
+# include "P2TaskExecutor.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		int32 P2TaskExecutor::GetTaskCount()
+		{
+		# ifndef SIV3D_NO_CONCURRENT_API
+
+			// 島ごとの負荷の偏りを吸収できるよう、スレッド数の 4 倍程度のタスクに分割する
+			return static_cast<int32>((Threading::GetWorkerCount() + 1) * 4);
+
+		# else
+
+			return 1;
+
+		# endif
+		}
+
+		void P2TaskExecutor::Run(b2Task* task, const int32 count)
+		{
+		# ifndef SIV3D_NO_CONCURRENT_API
+
+			Threading::ParallelFor(static_cast<size_t>(count), [task](const size_t first, const size_t last)
+				{
+					for (size_t i = first; i < last; ++i)
+					{
+						task->Execute(static_cast<int32>(i));
+					}
+				}, 1);
+
+		# else
+
+			for (int32 i = 0; i < count; ++i)
+			{
+				task->Execute(i);
+			}
+
+		# endif
+		}
+	}
+}
@@ -0,0 +1,29 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "P2Common.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// @brief 互いに独立した島の求解をスレッドプールで並列に実行します。
+		class P2TaskExecutor : public b2TaskExecutor
+		{
+		public:
+
+			int32 GetTaskCount() override;
+
+			void Run(b2Task* task, int32 count) override;
+		};
+	}
+}
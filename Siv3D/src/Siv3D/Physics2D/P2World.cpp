@@ -26,6 +26,36 @@ namespace s3d
 		return pImpl->update(timeStep, velocityIterations, positionIterations);
 	}
 
+	size_t P2World::updateFixed(const double deltaTime, const double fixedTimeStep, const size_t maxSteps, const int32 velocityIterations, const int32 positionIterations) const
+	{
+		if (fixedTimeStep <= 0.0)
+		{
+			throw Error{ U"P2World::updateFixed(): fixedTimeStep must be greater than 0" };
+		}
+
+		return pImpl->updateFixed(deltaTime, fixedTimeStep, maxSteps, velocityIterations, positionIterations);
+	}
+
+	double P2World::getInterpolationAlpha() const noexcept
+	{
+		return pImpl->getInterpolationAlpha();
+	}
+
+	const P2WorldProfile& P2World::getProfile() const noexcept
+	{
+		return pImpl->getProfile();
+	}
+
+	void P2World::setParallelIslandsEnabled(const bool enabled)
+	{
+		pImpl->setParallelIslandsEnabled(enabled);
+	}
+
+	bool P2World::getParallelIslandsEnabled() const
+	{
+		return pImpl->getParallelIslandsEnabled();
+	}
+
 	void P2World::setSleepEnabled(const bool enabled)
 	{
 		pImpl->getData().SetAllowSleeping(enabled);
@@ -9,8 +9,10 @@
 //
 //-----------------------------------------------
 
+# include <cmath>
 # include <Siv3D/Physics2D/P2Body.hpp>
 # include "P2WorldDetail.hpp"
+# include "P2BodyDetail.hpp"
 # include "P2Common.hpp"
 
 namespace s3d
@@ -19,13 +21,82 @@ namespace s3d
 		: m_world{ detail::ToB2Vec2(gravity) }
 	{
 		m_world.SetContactListener(&m_contactListner);
+		m_world.SetTaskExecutor(&m_taskExecutor);
 	}
 
 	void detail::P2WorldDetail::update(const double timeStep, const int32 velocityIterations, const int32 positionIterations)
 	{
 		m_contactListner.clearContacts();
 
-		m_world.Step(static_cast<float>(timeStep), velocityIterations, positionIterations);
+		m_profile = {};
+
+		step(timeStep, velocityIterations, positionIterations);
+	}
+
+	size_t detail::P2WorldDetail::updateFixed(const double deltaTime, const double fixedTimeStep, const size_t maxSteps, const int32 velocityIterations, const int32 positionIterations)
+	{
+		// 負の経過時間は 0 として扱う（蓄積時間が負になると、ステップ数への変換が未定義動作になる）
+		m_accumulatedTime += Max(deltaTime, 0.0);
+
+		const size_t steps = Min(static_cast<size_t>(m_accumulatedTime / fixedTimeStep), maxSteps);
+
+		if (steps)
+		{
+			m_contactListner.clearContacts();
+
+			m_profile = {};
+
+			// 加えられた力を全てのステップに適用する
+			m_world.SetAutoClearForces(false);
+
+			for (size_t i = 0; i < steps; ++i)
+			{
+				// 補間のため、最後のステップの前の状態を保存する
+				if ((i + 1) == steps)
+				{
+					storePreviousTransforms();
+				}
+
+				step(fixedTimeStep, velocityIterations, positionIterations);
+			}
+
+			m_world.ClearForces();
+			m_world.SetAutoClearForces(true);
+
+			m_accumulatedTime -= (steps * fixedTimeStep);
+		}
+
+		// 処理が追いつかない分は切り捨てる
+		if (fixedTimeStep <= m_accumulatedTime)
+		{
+			m_accumulatedTime = std::fmod(m_accumulatedTime, fixedTimeStep);
+		}
+
+		m_interpolationAlpha = (m_accumulatedTime / fixedTimeStep);
+
+		return steps;
+	}
+
+	double detail::P2WorldDetail::getInterpolationAlpha() const noexcept
+	{
+		return m_interpolationAlpha;
+	}
+
+	const P2WorldProfile& detail::P2WorldDetail::getProfile() const noexcept
+	{
+		return m_profile;
+	}
+
+	void detail::P2WorldDetail::setParallelIslandsEnabled(const bool enabled)
+	{
+		m_parallelIslandsEnabled = enabled;
+
+		m_world.SetTaskExecutor(enabled ? &m_taskExecutor : nullptr);
+	}
+
+	bool detail::P2WorldDetail::getParallelIslandsEnabled() const noexcept
+	{
+		return m_parallelIslandsEnabled;
 	}
 
 	P2Body detail::P2WorldDetail::createPlaceholder(const std::shared_ptr<P2WorldDetail>& world, const P2BodyType bodyType, const Vec2& center)
@@ -163,4 +234,25 @@ namespace s3d
 	{
 		return ++m_currentID;
 	}
+
+	void detail::P2WorldDetail::step(const double timeStep, const int32 velocityIterations, const int32 positionIterations)
+	{
+		m_world.Step(static_cast<float>(timeStep), velocityIterations, positionIterations);
+
+		const b2Profile& profile = m_world.GetProfile();
+		++m_profile.stepCount;
+		m_profile.step			+= profile.step;
+		m_profile.collide		+= profile.collide;
+		m_profile.solve			+= (profile.solve - profile.broadphase); // b2Profile::solve はブロードフェーズを含む
+		m_profile.broadphase	+= profile.broadphase;
+		m_profile.solveTOI		+= profile.solveTOI;
+	}
+
+	void detail::P2WorldDetail::storePreviousTransforms()
+	{
+		for (b2Body* body = m_world.GetBodyList(); body; body = body->GetNext())
+		{
+			static_cast<P2Body::P2BodyDetail*>(body->GetUserData().pBody)->storePreviousTransform();
+		}
+	}
 }
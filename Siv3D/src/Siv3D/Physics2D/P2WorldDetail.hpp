@@ -13,6 +13,7 @@
 # include <Siv3D/Physics2D/P2World.hpp>
 # include "P2Common.hpp"
 # include "P2ContactListener.hpp"
+# include "P2TaskExecutor.hpp"
 
 namespace s3d
 {
@@ -24,6 +25,19 @@ namespace s3d
 
 		void update(double timeStep, int32 velocityIterations, int32 positionIterations);
 
+		size_t updateFixed(double deltaTime, double fixedTimeStep, size_t maxSteps, int32 velocityIterations, int32 positionIterations);
+
+		[[nodiscard]]
+		double getInterpolationAlpha() const noexcept;
+
+		[[nodiscard]]
+		const P2WorldProfile& getProfile() const noexcept;
+
+		void setParallelIslandsEnabled(bool enabled);
+
+		[[nodiscard]]
+		bool getParallelIslandsEnabled() const noexcept;
+
 		[[nodiscard]]
 		P2Body createPlaceholder(const std::shared_ptr<P2WorldDetail>& world, P2BodyType bodyType, const Vec2& worldPos);
 
@@ -83,13 +97,27 @@ namespace s3d
 
 	private:
 
+		P2TaskExecutor m_taskExecutor;
+
 		b2World m_world;
 
 		P2ContactListener m_contactListner;
 
+		P2WorldProfile m_profile;
+
+		double m_accumulatedTime = 0.0;
+
+		double m_interpolationAlpha = 0.0;
+
+		bool m_parallelIslandsEnabled = true;
+
 		std::atomic<P2BodyID> m_currentID = { 0 };
 
 		[[nodiscard]]
 		P2BodyID generateNextID() noexcept;
+
+		void step(double timeStep, int32 velocityIterations, int32 positionIterations);
+
+		void storePreviousTransforms();
 	};
 }
@@ -14,6 +14,30 @@
 
 namespace s3d
 {
+	namespace detail
+	{
+		template <class URBG>
+		[[nodiscard]]
+		static Emission2D Emit(const Polygon& polygon, const double sourceRadius, DiscreteDistribution& triangleWeights, const Vec2& emitterPosition, const double startSpeed, URBG& urbg)
+		{
+			if (not polygon)
+			{
+				return Emission2D{ emitterPosition, RandomVec2(startSpeed, urbg) };
+			}
+
+			const Vec2 sourceOffset = RandomVec2(Circle{ Vec2{ 0, 0 }, sourceRadius }, urbg);
+			const size_t randomTriangleIndex = triangleWeights(urbg);
+			const Triangle randomTriangle = polygon.triangle(randomTriangleIndex);
+			const Vec2 randomPos = RandomVec2(randomTriangle, urbg);
+			const Vec2 pos = (emitterPosition + randomPos + sourceOffset);
+
+			Emission2D emission;
+			emission.position = pos;
+			emission.velocity = RandomVec2(startSpeed, urbg);
+			return emission;
+		}
+	}
+
 	PolygonEmitter2D::PolygonEmitter2D(Polygon&& polygon)
 		: m_polygon{ std::move(polygon) }
 	{
@@ -37,23 +61,25 @@ namespace s3d
 	PolygonEmitter2D::PolygonEmitter2D(const Polygon& polygon)
 		: PolygonEmitter2D{ Polygon{ polygon } } {}
 
-	Emission2D PolygonEmitter2D::emit(const Vec2& emitterPosition, double startSpeed)
+	Emission2D PolygonEmitter2D::emit(const Vec2& emitterPosition, const double startSpeed)
 	{
-		if (not m_polygon)
+		return detail::Emit(m_polygon, sourceRadius, m_triangleWeights, emitterPosition, startSpeed, GetDefaultRNG());
+	}
+
+	void PolygonEmitter2D::emitN(Emission2D* emissions, const size_t count, const Vec2& emitterPosition, const double startSpeed, SmallRNG& rng)
+	{
+		// 複数のスレッドから同時に呼ばれるため、分布オブジェクトは呼び出しごとに複製する
+		DiscreteDistribution triangleWeights = m_triangleWeights;
+
+		for (size_t i = 0; i < count; ++i)
 		{
-			return Emission2D{ emitterPosition, RandomVec2(startSpeed) };
+			emissions[i] = detail::Emit(m_polygon, sourceRadius, triangleWeights, emitterPosition, startSpeed, rng);
 		}
+	}
 
-		const Vec2 sourceOffset = RandomVec2(Circle{ Vec2{ 0, 0 }, sourceRadius });
-		const size_t randomTriangleIndex = m_triangleWeights(GetDefaultRNG());
-		const Triangle randomTriangle = m_polygon.triangle(randomTriangleIndex);
-		const Vec2 randomPos = RandomVec2(randomTriangle);
-		const Vec2 pos = (emitterPosition + randomPos + sourceOffset);
-
-		Emission2D emission;
-		emission.position = pos;
-		emission.velocity = RandomVec2(startSpeed);
-		return emission;
+	bool PolygonEmitter2D::supportsParallelEmission() const noexcept
+	{
+		return true;
 	}
 
 	void PolygonEmitter2D::drawDebug(const Vec2& emitterPosition) const
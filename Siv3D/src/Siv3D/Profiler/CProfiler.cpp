@@ -24,6 +24,7 @@
 # include <Siv3D/Audio/IAudio.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 # include "CProfiler.hpp"
+# include "ProfilerTrace.hpp"
 
 namespace s3d
 {
@@ -32,10 +33,14 @@ namespace s3d
 		LOG_SCOPED_TRACE(U"CProfiler::init()");
 
 		m_fpsTimestampMillisec = Time::GetMillisec();
+
+		ProfilerTrace::SetMainThread();
 	}
 
 	void CProfiler::beginFrame()
 	{
+		ProfilerTrace::MarkFrame();
+
 		// FPS
 		{
 			if (const int64 timestampMillisec = Time::GetMillisec();
@@ -57,9 +62,18 @@ namespace s3d
 				const auto stat = SIV3D_ENGINE(Renderer2D)->getStat();
 				m_stat.drawCalls = stat.drawCalls;
 				m_stat.triangleCount = stat.triangleCount;
+				m_stat.instanceCount = stat.instanceCount;
+				m_stat.savedDrawCalls = stat.savedDrawCalls;
 			}
 
 			m_stat.textureCount	= static_cast<uint32>(SIV3D_ENGINE(Texture)->getTextureCount());
+
+			{
+				const auto stat = SIV3D_ENGINE(Texture)->getAsyncTextureLoadStat();
+				m_stat.textureUploadQueueDepth = stat.queueDepth;
+				m_stat.textureUploadLatencyMicrosec = static_cast<uint32>(Min<uint64>(stat.maxLatencyMicrosec, Largest<uint32>));
+			}
+
 			m_stat.fontCount	= static_cast<uint32>(SIV3D_ENGINE(Font)->getFontCount());
 			m_stat.audioCount	= static_cast<uint32>(SIV3D_ENGINE(Audio)->getAudioCount());
 			m_stat.activeVoice	= static_cast<uint32>(GlobalAudio::GetActiveVoiceCount());
@@ -0,0 +1,440 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <mutex>
+# include <atomic>
+# include <array>
+# include <memory>
+# include <thread>
+# include <algorithm>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/String.hpp>
+# include <Siv3D/Unicode.hpp>
+# include <Siv3D/BinaryWriter.hpp>
+# include <Siv3D/FormatLiteral.hpp>
+# include <Siv3D/Time.hpp>
+# include <Siv3D/EngineLog.hpp>
+# include "ProfilerTrace.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		struct TraceEvent
+		{
+			enum class Type : uint8
+			{
+				Zone,
+
+				Frame,
+			};
+
+			const char32* name = nullptr;
+
+			uint64 beginNanosec = 0;
+
+			uint64 endNanosec = 0;
+
+			Type type = Type::Zone;
+		};
+
+		////////////////////////////////////////////////////////////////
+		//
+		//	TraceBuffer
+		//
+		//	スレッドごとの追記専用のイベント列。
+		//	書き込むのは所有するスレッドだけで、count を release で公開する。
+		//	読み出し側は count を acquire で読み、それより前のイベントだけを読む。
+		//
+		class TraceBuffer
+		{
+		public:
+
+			static constexpr size_t ChunkSize = 4096;
+
+			static constexpr size_t MaxChunks = 256;
+
+			TraceBuffer(const uint32 threadIndex, const bool isMainThread)
+				: m_threadIndex{ threadIndex }
+				, m_isMainThread{ isMainThread } {}
+
+			~TraceBuffer()
+			{
+				for (auto& chunk : m_chunks)
+				{
+					delete[] chunk.load(std::memory_order_relaxed);
+				}
+			}
+
+			void push(const TraceEvent& event, const uint64 epoch) noexcept
+			{
+				// 新しい記録が始まっていたら、先頭から書き直す
+				if (m_epoch.load(std::memory_order_relaxed) != epoch)
+				{
+					m_count.store(0, std::memory_order_relaxed);
+					m_epoch.store(epoch, std::memory_order_release);
+				}
+
+				const size_t index = m_count.load(std::memory_order_relaxed);
+				const size_t chunkIndex = (index / ChunkSize);
+
+				if (MaxChunks <= chunkIndex)
+				{
+					m_dropped.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+
+				TraceEvent* chunk = m_chunks[chunkIndex].load(std::memory_order_relaxed);
+
+				if (not chunk)
+				{
+					chunk = new (std::nothrow) TraceEvent[ChunkSize];
+
+					if (not chunk)
+					{
+						m_dropped.fetch_add(1, std::memory_order_relaxed);
+						return;
+					}
+
+					m_chunks[chunkIndex].store(chunk, std::memory_order_release);
+				}
+
+				chunk[index % ChunkSize] = event;
+
+				m_count.store((index + 1), std::memory_order_release);
+			}
+
+			/// @brief 指定した記録で書き込まれたイベントを取得します。
+			void read(const uint64 epoch, Array<TraceEvent>& events) const
+			{
+				if (m_epoch.load(std::memory_order_acquire) != epoch)
+				{
+					return;
+				}
+
+				const size_t count = m_count.load(std::memory_order_acquire);
+
+				for (size_t i = 0; i < count; ++i)
+				{
+					events << m_chunks[i / ChunkSize].load(std::memory_order_acquire)[i % ChunkSize];
+				}
+			}
+
+			void resetDropped() noexcept
+			{
+				m_dropped.store(0, std::memory_order_relaxed);
+			}
+
+			[[nodiscard]]
+			size_t dropped() const noexcept
+			{
+				return m_dropped.load(std::memory_order_relaxed);
+			}
+
+			[[nodiscard]]
+			uint32 threadIndex() const noexcept
+			{
+				return m_threadIndex;
+			}
+
+			[[nodiscard]]
+			bool isMainThread() const noexcept
+			{
+				return m_isMainThread;
+			}
+
+		private:
+
+			std::array<std::atomic<TraceEvent*>, MaxChunks> m_chunks{};
+
+			std::atomic<size_t> m_count = 0;
+
+			std::atomic<uint64> m_epoch = 0;
+
+			std::atomic<size_t> m_dropped = 0;
+
+			uint32 m_threadIndex = 0;
+
+			bool m_isMainThread = false;
+		};
+
+		class TraceRegistry
+		{
+		public:
+
+			[[nodiscard]]
+			static TraceRegistry& Get()
+			{
+				static TraceRegistry registry;
+				return registry;
+			}
+
+			void setMainThread()
+			{
+				std::lock_guard lock{ m_mutex };
+				m_mainThreadID = std::this_thread::get_id();
+			}
+
+			[[nodiscard]]
+			bool isTracing() const noexcept
+			{
+				return m_tracing.load(std::memory_order_relaxed);
+			}
+
+			void begin()
+			{
+				// 書き出し中に新しい記録を始めない
+				std::lock_guard traceLock{ m_traceMutex };
+				{
+					std::lock_guard lock{ m_mutex };
+
+					// 終了したスレッドのバッファを解放する
+					m_buffers.remove_if([](const std::shared_ptr<TraceBuffer>& buffer) { return (buffer.use_count() == 1); });
+
+					for (auto& buffer : m_buffers)
+					{
+						buffer->resetDropped();
+					}
+				}
+
+				m_startNanosec.store(Time::GetNanosec(), std::memory_order_relaxed);
+				m_epoch.fetch_add(1, std::memory_order_acq_rel);
+				m_tracing.store(true, std::memory_order_release);
+			}
+
+			void end()
+			{
+				m_tracing.store(false, std::memory_order_release);
+			}
+
+			void push(const TraceEvent& event) noexcept
+			{
+				if (TraceBuffer* buffer = getThreadBuffer())
+				{
+					buffer->push(event, m_epoch.load(std::memory_order_acquire));
+				}
+			}
+
+			bool save(const FilePathView path);
+
+		private:
+
+			// begin() と save() を直列化する
+			std::mutex m_traceMutex;
+
+			// m_buffers などを保護する。スレッドのバッファの登録で取るので、長く保持しない
+			std::mutex m_mutex;
+
+			Array<std::shared_ptr<TraceBuffer>> m_buffers;
+
+			std::thread::id m_mainThreadID;
+
+			std::atomic<bool> m_tracing = false;
+
+			std::atomic<uint64> m_epoch = 0;
+
+			std::atomic<uint64> m_startNanosec = 0;
+
+			[[nodiscard]]
+			TraceBuffer* getThreadBuffer() noexcept
+			{
+				// スレッドの終了後もイベントを読めるよう、レジストリとスレッドで共有する
+				thread_local std::shared_ptr<TraceBuffer> t_buffer;
+
+				if (not t_buffer)
+				{
+					try
+					{
+						std::lock_guard lock{ m_mutex };
+						t_buffer = std::make_shared<TraceBuffer>(m_nextThreadIndex++, (std::this_thread::get_id() == m_mainThreadID));
+						m_buffers << t_buffer;
+					}
+					catch (...)
+					{
+						return nullptr;
+					}
+				}
+
+				return t_buffer.get();
+			}
+
+			uint32 m_nextThreadIndex = 0;
+		};
+
+		static void AppendEscaped(std::string& output, const char32* name)
+		{
+			for (const char c : Unicode::ToUTF8(name))
+			{
+				if ((c == '"') || (c == '\\'))
+				{
+					output.push_back('\\');
+					output.push_back(c);
+				}
+				else if (static_cast<unsigned char>(c) < 0x20)
+				{
+					output.push_back(' ');
+				}
+				else
+				{
+					output.push_back(c);
+				}
+			}
+		}
+
+		static void AppendMicrosec(std::string& output, const uint64 nanosec)
+		{
+			output += std::to_string(nanosec / 1000);
+			output.push_back('.');
+
+			const std::string fraction = std::to_string(nanosec % 1000);
+			output.append((3 - fraction.size()), '0');
+			output += fraction;
+		}
+
+		bool TraceRegistry::save(const FilePathView path)
+		{
+			// 読み出しの途中で begin() が epoch と開始時刻を書き換えないようにする
+			std::lock_guard traceLock{ m_traceMutex };
+
+			Array<std::shared_ptr<TraceBuffer>> buffers;
+			{
+				std::lock_guard lock{ m_mutex };
+				buffers = m_buffers;
+			}
+
+			const uint64 epoch = m_epoch.load(std::memory_order_acquire);
+			const uint64 startNanosec = m_startNanosec.load(std::memory_order_relaxed);
+
+			if (epoch == 0)
+			{
+				LOG_FAIL(U"❌ Profiler::SaveTrace(): Profiler::BeginTrace() has not been called");
+				return false;
+			}
+
+			std::string output = R"({"displayTimeUnit":"ms","traceEvents":[)";
+			bool first = true;
+			size_t dropped = 0;
+
+			Array<TraceEvent> events;
+
+			for (const auto& buffer : buffers)
+			{
+				events.clear();
+				buffer->read(epoch, events);
+				dropped += buffer->dropped();
+
+				if (events.isEmpty())
+				{
+					continue;
+				}
+
+				// 子の区間は親より先に終わるので、開始時刻の順（同時なら長い順）に並べ直す
+				std::sort(events.begin(), events.end(), [](const TraceEvent& a, const TraceEvent& b)
+					{
+						return (a.beginNanosec != b.beginNanosec) ? (a.beginNanosec < b.beginNanosec) : (b.endNanosec < a.endNanosec);
+					});
+
+				const std::string tid = std::to_string(buffer->threadIndex());
+
+				output += (first ? "" : ",");
+				output += R"({"name":"thread_name","ph":"M","pid":1,"tid":)" + tid + R"(,"args":{"name":")";
+				output += (buffer->isMainThread() ? std::string{ "Main" } : ("Thread " + tid));
+				output += R"("}})";
+				first = false;
+
+				for (const auto& event : events)
+				{
+					const uint64 begin = ((startNanosec < event.beginNanosec) ? (event.beginNanosec - startNanosec) : 0);
+
+					output += R"(,{"name":")";
+					AppendEscaped(output, event.name);
+
+					if (event.type == TraceEvent::Type::Zone)
+					{
+						output += R"(","ph":"X","ts":)";
+						AppendMicrosec(output, begin);
+						output += R"(,"dur":)";
+						AppendMicrosec(output, (event.endNanosec - event.beginNanosec));
+					}
+					else
+					{
+						output += R"(","ph":"i","s":"g","ts":)";
+						AppendMicrosec(output, begin);
+					}
+
+					output += R"(,"pid":1,"tid":)" + tid + "}";
+				}
+			}
+
+			output += "]}\n";
+
+			if (dropped)
+			{
+				LOG_WARNING(U"Profiler::SaveTrace(): {} events were dropped because the trace buffer was full"_fmt(dropped));
+			}
+
+			BinaryWriter writer{ path };
+
+			if (not writer)
+			{
+				LOG_FAIL(U"❌ Profiler::SaveTrace(): Failed to open `{}`"_fmt(path));
+				return false;
+			}
+
+			return (writer.write(output.data(), output.size()) == static_cast<int64>(output.size()));
+		}
+	}
+
+	namespace ProfilerTrace
+	{
+		void SetMainThread()
+		{
+			detail::TraceRegistry::Get().setMainThread();
+		}
+
+		void Begin()
+		{
+			detail::TraceRegistry::Get().begin();
+		}
+
+		void End()
+		{
+			detail::TraceRegistry::Get().end();
+		}
+
+		bool IsTracing() noexcept
+		{
+			return detail::TraceRegistry::Get().isTracing();
+		}
+
+		void AddZone(const char32* name, const uint64 beginNanosec, const uint64 endNanosec) noexcept
+		{
+			detail::TraceRegistry::Get().push({ name, beginNanosec, endNanosec, detail::TraceEvent::Type::Zone });
+		}
+
+		void MarkFrame() noexcept
+		{
+			if (not IsTracing())
+			{
+				return;
+			}
+
+			const uint64 time = Time::GetNanosec();
+
+			detail::TraceRegistry::Get().push({ U"Frame", time, time, detail::TraceEvent::Type::Frame });
+		}
+
+		bool Save(const FilePathView path)
+		{
+			return detail::TraceRegistry::Get().save(path);
+		}
+	}
+}
@@ -0,0 +1,40 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <Siv3D/Common.hpp>
+# include <Siv3D/StringView.hpp>
+
+namespace s3d
+{
+	/// @brief 区間計測の記録
+	/// @remark エンジンの寿命とは独立しているので、終了処理中のワーカースレッドからも安全に呼べる
+	namespace ProfilerTrace
+	{
+		/// @brief 呼び出し元のスレッドをメインスレッドとして登録します。
+		void SetMainThread();
+
+		void Begin();
+
+		void End();
+
+		[[nodiscard]]
+		bool IsTracing() noexcept;
+
+		/// @brief 呼び出し元のスレッドのバッファに区間を記録します。
+		void AddZone(const char32* name, uint64 beginNanosec, uint64 endNanosec) noexcept;
+
+		/// @brief フレームの区切りを記録します。
+		void MarkFrame() noexcept;
+
+		bool Save(FilePathView path);
+	}
+}
@@ -11,6 +11,7 @@
 
 # include <Siv3D/Profiler.hpp>
 # include <Siv3D/Profiler/IProfiler.hpp>
+# include <Siv3D/Profiler/ProfilerTrace.hpp>
 # include <Siv3D/AssetMonitor/IAssetMonitor.hpp>
 # include <Siv3D/Common/Siv3DEngine.hpp>
 
@@ -32,5 +33,25 @@ namespace s3d
 		{
 			return SIV3D_ENGINE(Profiler)->getStat();
 		}
+
+		void BeginTrace()
+		{
+			ProfilerTrace::Begin();
+		}
+
+		void EndTrace()
+		{
+			ProfilerTrace::End();
+		}
+
+		bool IsTracing() noexcept
+		{
+			return ProfilerTrace::IsTracing();
+		}
+
+		bool SaveTrace(const FilePathView path)
+		{
+			return ProfilerTrace::Save(path);
+		}
 	}
 }
@@ -18,7 +18,11 @@ namespace s3d
 	{
 		Print << U"Draw calls\t\t\t" << drawCalls;
 		Print << U"Triangle count\t\t" << triangleCount;
+		Print << U"Instance count\t\t" << instanceCount;
+		Print << U"Saved draw calls\t\t" << savedDrawCalls;
 		Print << U"Texture count\t\t" << textureCount;
+		Print << U"Texture upload queue\t" << textureUploadQueueDepth;
+		Print << U"Texture upload latency\t" << textureUploadLatencyMicrosec << U" us";
 		Print << U"Font count\t\t\t" << fontCount;
 		Print << U"Audio count\t\t" << audioCount;
 		Print << U"Active voice\t\t" << activeVoice;
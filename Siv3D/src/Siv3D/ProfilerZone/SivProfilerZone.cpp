@@ -0,0 +1,34 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/ProfilerZone.hpp>
+# include <Siv3D/Time.hpp>
+# include <Siv3D/Profiler/ProfilerTrace.hpp>
+
+namespace s3d
+{
+	ProfilerZone::ProfilerZone(const char32* name) noexcept
+	{
+		if (ProfilerTrace::IsTracing())
+		{
+			m_name = name;
+			m_beginNanosec = Time::GetNanosec();
+		}
+	}
+
+	ProfilerZone::~ProfilerZone()
+	{
+		if (m_name)
+		{
+			ProfilerTrace::AddZone(m_name, m_beginNanosec, Time::GetNanosec());
+		}
+	}
+}
@@ -15,63 +15,86 @@
 
 namespace s3d
 {
-	Emission2D RectEmitter2D::emit(const Vec2& emitterPosition, const double startSpeed)
+	namespace detail
 	{
-		const Vec2 sourceOffset = RandomVec2(Circle{ Vec2{ 0, 0 }, sourceRadius });
-
-		Emission2D emission;
-
-		if (fromShell)
+		template <class URBG>
+		[[nodiscard]]
+		static Emission2D Emit(const RectEmitter2D& emitter, const Vec2& emitterPosition, const double startSpeed, URBG& urbg)
 		{
-			const double perimeter = (width + height) * 2.0;
-			const double rnd = Random(perimeter);
-			const Vec2 topLeft = (Vec2{ -width, -height } * 0.5);
-			Vec2 d;
+			const Vec2 sourceOffset = RandomVec2(Circle{ Vec2{ 0, 0 }, emitter.sourceRadius }, urbg);
 
-			if (rnd < width)
-			{
-				d = topLeft.movedBy(rnd, 0);
-			}
-			else if (rnd < (width + height))
-			{
-				d = topLeft.movedBy(width, (rnd - width));
-			}
-			else if (rnd < (width + height + width))
-			{
-				d = topLeft.movedBy(width - (rnd - width - height), height);
-			}
-			else
+			Emission2D emission;
+
+			if (emitter.fromShell)
 			{
-				d = topLeft.movedBy(0, perimeter - rnd);
-			}
+				const double perimeter = (emitter.width + emitter.height) * 2.0;
+				const double rnd = Random(perimeter, urbg);
+				const Vec2 topLeft = (Vec2{ -emitter.width, -emitter.height } * 0.5);
+				Vec2 d;
 
-			emission.position = (d + emitterPosition) + sourceOffset;
+				if (rnd < emitter.width)
+				{
+					d = topLeft.movedBy(rnd, 0);
+				}
+				else if (rnd < (emitter.width + emitter.height))
+				{
+					d = topLeft.movedBy(emitter.width, (rnd - emitter.width));
+				}
+				else if (rnd < (emitter.width + emitter.height + emitter.width))
+				{
+					d = topLeft.movedBy(emitter.width - (rnd - emitter.width - emitter.height), emitter.height);
+				}
+				else
+				{
+					d = topLeft.movedBy(0, perimeter - rnd);
+				}
 
-			if (randomDirection)
-			{
-				emission.velocity = RandomVec2(startSpeed);
+				emission.position = (d + emitterPosition) + sourceOffset;
+
+				if (emitter.randomDirection)
+				{
+					emission.velocity = RandomVec2(startSpeed, urbg);
+				}
+				else
+				{
+					emission.velocity = d.withLength(startSpeed);
+				}
 			}
 			else
 			{
-				emission.velocity = d.withLength(startSpeed);
+				const Vec2 d = RandomVec2(RectF{ Arg::center(0, 0), emitter.width, emitter.height }, urbg);
+				emission.position = (d + emitterPosition) + sourceOffset;
+
+				if (emitter.randomDirection)
+				{
+					emission.velocity = RandomVec2(startSpeed, urbg);
+				}
+				else
+				{
+					emission.velocity = d.withLength(startSpeed);
+				}
 			}
+
+			return emission;
 		}
-		else
-		{
-			const Vec2 d = RandomVec2(RectF{ Arg::center(0, 0), width, height });
-			emission.position = (d + emitterPosition) + sourceOffset;
+	}
 
-			if (randomDirection)
-			{
-				emission.velocity = RandomVec2(startSpeed);
-			}
-			else
-			{
-				emission.velocity = d.withLength(startSpeed);
-			}
+	Emission2D RectEmitter2D::emit(const Vec2& emitterPosition, const double startSpeed)
+	{
+		return detail::Emit(*this, emitterPosition, startSpeed, GetDefaultRNG());
+	}
+
+	void RectEmitter2D::emitN(Emission2D* emissions, const size_t count, const Vec2& emitterPosition, const double startSpeed, SmallRNG& rng)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			emissions[i] = detail::Emit(*this, emitterPosition, startSpeed, rng);
 		}
+	}
 
-		return emission;
+	bool RectEmitter2D::supportsParallelEmission() const noexcept
+	{
+		return true;
 	}
 
 	void RectEmitter2D::drawDebug(const Vec2& emitterPosition) const
@@ -30,7 +30,9 @@
 # include <Siv3D/ConstantBuffer.hpp>
 # include <Siv3D/Mat3x2.hpp>
 # include <Siv3D/Particle2D.hpp>
+# include <Siv3D/Particle2D/ParticleStorage2D.hpp>
 # include <Siv3D/ParticleSystem2DParameters.hpp>
+# include <Siv3D/SpriteInstance.hpp>
 
 namespace s3d
 {
@@ -41,6 +43,8 @@ namespace s3d
 	{
 		uint32 drawCalls = 0;
 		uint32 triangleCount = 0;
+		uint32 instanceCount = 0;
+		uint32 savedDrawCalls = 0;
 	};
 
 	class SIV3D_NOVTABLE ISiv3DRenderer2D
@@ -113,10 +117,12 @@ namespace s3d
 
 		virtual void addTexturedVertices(const Texture& texture, const Vertex2D* vertices, size_t vertexCount, const TriangleIndex* indices, size_t num_triangles) = 0;
 
-		virtual void addTexturedParticles(const Texture& texture, const Array<Particle2D>& particles,
+		virtual void addTexturedParticles(const Texture& texture, const ParticleStorage2D& particles,
 			ParticleSystem2DParameters::SizeOverLifeTimeFunc sizeOverLifeTimeFunc,
 			ParticleSystem2DParameters::ColorOverLifeTimeFunc colorOverLifeTimeFunc) = 0;
 
+		virtual void addTexturedInstances(const Texture& texture, const SpriteInstance* instances, size_t count) = 0;
+
 
 		virtual Float4 getColorMul() const = 0;
 
@@ -186,6 +192,11 @@ namespace s3d
 		virtual void setConstantBuffer(ShaderStage stage, uint32 slot, const ConstantBufferBase& buffer, const float* data, uint32 num_vectors) = 0;
 
 
+		virtual void beginBatchReorder() = 0;
+
+		virtual void endBatchReorder() = 0;
+
+
 		virtual const Texture& getBoxShadowTexture() const noexcept = 0;
 
 
@@ -182,13 +182,19 @@ namespace s3d
 		// do nothing
 	}
 
-	void CRenderer2D_Null::addTexturedParticles(const Texture&, const Array<Particle2D>&,
+	void CRenderer2D_Null::addTexturedParticles(const Texture&, const ParticleStorage2D&,
 		ParticleSystem2DParameters::SizeOverLifeTimeFunc,
 		ParticleSystem2DParameters::ColorOverLifeTimeFunc)
 	{
 		// do nothing
 	}
 
+	void CRenderer2D_Null::addTexturedInstances(const Texture&, const SpriteInstance*, const size_t count)
+	{
+		// 描画はしないが、インスタンス描画のテストのためにインスタンス数を記録する
+		m_stat.instanceCount += static_cast<uint32>(count);
+	}
+
 
 	Float4 CRenderer2D_Null::getColorMul() const
 	{
@@ -342,6 +348,16 @@ namespace s3d
 		// do nothing
 	}
 
+	void CRenderer2D_Null::beginBatchReorder()
+	{
+		// do nothing
+	}
+
+	void CRenderer2D_Null::endBatchReorder()
+	{
+		// do nothing
+	}
+
 	const Texture& CRenderer2D_Null::getBoxShadowTexture() const noexcept
 	{
 		return *m_emptyTexture;
@@ -0,0 +1,165 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Renderer2DBatchReorder.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		[[nodiscard]]
+		static constexpr bool Intersects(const FloatRect& a, const FloatRect& b) noexcept
+		{
+			return ((a.left < b.right) && (b.left < a.right)
+				&& (a.top < b.bottom) && (b.top < a.bottom));
+		}
+
+		[[nodiscard]]
+		static constexpr FloatRect Union(const FloatRect& a, const FloatRect& b) noexcept
+		{
+			return{ Min(a.left, b.left), Min(a.top, b.top), Max(a.right, b.right), Max(a.bottom, b.bottom) };
+		}
+	}
+
+	void Renderer2DBatchReorder::clear() noexcept
+	{
+		m_items.clear();
+	}
+
+	bool Renderer2DBatchReorder::isEmpty() const noexcept
+	{
+		return m_items.isEmpty();
+	}
+
+	void Renderer2DBatchReorder::add(const uint32 indexOffset, const uint32 indexCount, const uint32 stateID, const FloatRect& bounds)
+	{
+		m_items.push_back({ .indexOffset = indexOffset, .indexCount = indexCount, .stateID = stateID, .bounds = bounds });
+	}
+
+	bool Renderer2DBatchReorder::sort(const std::function<bool(uint32, uint32)>& hasSameStates)
+	{
+		// 描画をグループに振り分ける。
+		// 同じステートのグループを後ろから探し、それより後のどのグループとも重ならなければ、そのグループの末尾に加える
+		m_groups.clear();
+
+		for (uint32 i = 0; i < m_items.size(); ++i)
+		{
+			auto& item = m_items[i];
+			uint32 target = static_cast<uint32>(m_groups.size());
+
+			for (size_t k = 0; k < Min(m_groups.size(), MaxLookback); ++k)
+			{
+				const uint32 groupIndex = static_cast<uint32>(m_groups.size() - 1 - k);
+				const auto& group = m_groups[groupIndex];
+
+				if (hasSameStates(m_items[group.firstItem].stateID, item.stateID))
+				{
+					target = groupIndex;
+					break;
+				}
+
+				if (detail::Intersects(group.bounds, item.bounds))
+				{
+					break;
+				}
+			}
+
+			if (target == m_groups.size())
+			{
+				m_groups.push_back({ i, item.bounds });
+			}
+			else
+			{
+				m_groups[target].bounds = detail::Union(m_groups[target].bounds, item.bounds);
+			}
+
+			item.group = target;
+		}
+
+		const auto byGroup = [](const Item& a, const Item& b) { return (a.group < b.group); };
+
+		if (std::is_sorted(m_items.begin(), m_items.end(), byGroup))
+		{
+			return false;
+		}
+
+		std::stable_sort(m_items.begin(), m_items.end(), byGroup);
+
+		m_ranges.clear();
+
+		for (const auto& item : m_items)
+		{
+			m_ranges.emplace_back(item.indexOffset, item.indexCount);
+		}
+
+		return true;
+	}
+
+	const Array<Renderer2DBatchReorder::Item>& Renderer2DBatchReorder::getItems() const noexcept
+	{
+		return m_items;
+	}
+
+	const Array<std::pair<uint32, uint32>>& Renderer2DBatchReorder::getIndexRanges() const noexcept
+	{
+		return m_ranges;
+	}
+
+	FloatRect Renderer2DBatchReorder::CalculateBounds(const Vertex2D* pVertex, const Vertex2D::IndexType* pIndex, const uint32 indexCount) noexcept
+	{
+		const Vertex2D::IndexType* const pIndexEnd = (pIndex + indexCount);
+
+		Float2 minPos{ Largest<float>, Largest<float> };
+		Float2 maxPos{ -Largest<float>, -Largest<float> };
+
+		while (pIndex != pIndexEnd)
+		{
+			const Float2 pos = pVertex[*pIndex++].pos;
+			minPos.x = Min(minPos.x, pos.x);
+			minPos.y = Min(minPos.y, pos.y);
+			maxPos.x = Max(maxPos.x, pos.x);
+			maxPos.y = Max(maxPos.y, pos.y);
+		}
+
+		return{ minPos.x, minPos.y, maxPos.x, maxPos.y };
+	}
+
+	FloatRect Renderer2DBatchReorder::TransformBounds(const FloatRect& rect, const Mat3x2& mat) noexcept
+	{
+		const Float2 p0 = mat.transformPoint(Float2{ rect.left, rect.top });
+		const Float2 p1 = mat.transformPoint(Float2{ rect.right, rect.top });
+		const Float2 p2 = mat.transformPoint(Float2{ rect.left, rect.bottom });
+		const Float2 p3 = mat.transformPoint(Float2{ rect.right, rect.bottom });
+
+		return{ Min(Min(p0.x, p1.x), Min(p2.x, p3.x)), Min(Min(p0.y, p1.y), Min(p2.y, p3.y)),
+			Max(Max(p0.x, p1.x), Max(p2.x, p3.x)), Max(Max(p0.y, p1.y), Max(p2.y, p3.y)) };
+	}
+
+	void Renderer2DBatchReorder::ReorderIndices(Vertex2D::IndexType* const pIndex, const uint32 indexOffset, const Array<std::pair<uint32, uint32>>& ranges, Array<Vertex2D::IndexType>& buffer)
+	{
+		size_t indexCount = 0;
+
+		for (const auto& range : ranges)
+		{
+			indexCount += range.second;
+		}
+
+		buffer.assign(pIndex, (pIndex + indexCount));
+
+		Vertex2D::IndexType* pDst = pIndex;
+
+		for (const auto& [offset, count] : ranges)
+		{
+			std::memcpy(pDst, (buffer.data() + (offset - indexOffset)), (sizeof(Vertex2D::IndexType) * count));
+			pDst += count;
+		}
+	}
+}
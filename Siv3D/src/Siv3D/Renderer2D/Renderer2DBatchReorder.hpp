@@ -0,0 +1,110 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <functional>
+# include <Siv3D/Common.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/Vertex2D.hpp>
+# include <Siv3D/FloatRect.hpp>
+# include <Siv3D/Mat3x2.hpp>
+
+namespace s3d
+{
+	/// @brief ScopedBatchReorder のスコープ内の描画を、同じステートで、間の描画と重ならないものどうしでまとめる
+	/// @remark コマンドの解釈と頂点・インデックスバッファの読み書きは各バックエンドが行い、このクラスは描画の並べ替えだけを扱います。
+	class Renderer2DBatchReorder
+	{
+	public:
+
+		struct Item
+		{
+			/// @brief バッチの先頭からのインデックスのオフセット
+			uint32 indexOffset = 0;
+
+			uint32 indexCount = 0;
+
+			/// @brief 描画時のステートを表す、バックエンドが割り当てた番号
+			uint32 stateID = 0;
+
+			/// @brief 描画が影響する範囲
+			FloatRect bounds{ 0.0f, 0.0f, 0.0f, 0.0f };
+
+			uint32 group = 0;
+		};
+
+		/// @brief 同じステートのグループを探すときに遡るグループの最大数
+		static constexpr size_t MaxLookback = 64;
+
+		/// @brief すべての描画と重なるものとして扱う範囲
+		static constexpr FloatRect InfiniteBounds{ -Largest<float>, -Largest<float>, Largest<float>, Largest<float> };
+
+		void clear() noexcept;
+
+		[[nodiscard]]
+		bool isEmpty() const noexcept;
+
+		/// @brief 並べ替える描画を、元の描画順に追加します。
+		/// @param indexOffset バッチの先頭からのインデックスのオフセット
+		/// @param indexCount インデックスの数
+		/// @param stateID 描画時のステートを表す番号
+		/// @param bounds 描画が影響する範囲
+		void add(uint32 indexOffset, uint32 indexCount, uint32 stateID, const FloatRect& bounds);
+
+		/// @brief 描画をグループに振り分け、グループの順に並べ替えます。
+		/// @param hasSameStates 2 つのステート番号が同じステートを表すかを返す関数
+		/// @return 描画の順序が変わった場合 true, それ以外の場合は false
+		bool sort(const std::function<bool(uint32, uint32)>& hasSameStates);
+
+		/// @brief 描画の一覧を返します。`sort()` の後は並べ替え後の順になります。
+		[[nodiscard]]
+		const Array<Item>& getItems() const noexcept;
+
+		/// @brief 並べ替える前の各描画のインデックスの範囲を、並べ替え後の順で返します。
+		/// @remark `sort()` が true を返した後に有効です。
+		[[nodiscard]]
+		const Array<std::pair<uint32, uint32>>& getIndexRanges() const noexcept;
+
+		/// @brief インデックスが参照する頂点を囲む範囲を返します。
+		/// @param pVertex バッチの頂点の先頭
+		/// @param pIndex 描画のインデックスの先頭
+		/// @param indexCount インデックスの数
+		/// @return 頂点を囲む範囲
+		[[nodiscard]]
+		static FloatRect CalculateBounds(const Vertex2D* pVertex, const Vertex2D::IndexType* pIndex, uint32 indexCount) noexcept;
+
+		/// @brief 範囲を座標変換し、変換後の範囲を囲む範囲を返します。
+		[[nodiscard]]
+		static FloatRect TransformBounds(const FloatRect& rect, const Mat3x2& mat) noexcept;
+
+		/// @brief インデックスを `getIndexRanges()` の順に並べ替えます。
+		/// @param pIndex 並べ替える範囲の先頭のインデックス
+		/// @param indexOffset pIndex のバッチの先頭からのオフセット
+		/// @param ranges 並べ替え後の順に並んだ、並べ替え前のインデックスの範囲
+		/// @param buffer 作業用のバッファ
+		static void ReorderIndices(Vertex2D::IndexType* pIndex, uint32 indexOffset, const Array<std::pair<uint32, uint32>>& ranges, Array<Vertex2D::IndexType>& buffer);
+
+	private:
+
+		struct Group
+		{
+			uint32 firstItem = 0;
+
+			FloatRect bounds{ 0.0f, 0.0f, 0.0f, 0.0f };
+		};
+
+		Array<Item> m_items;
+
+		Array<Group> m_groups;
+
+		Array<std::pair<uint32, uint32>> m_ranges;
+	};
+}
@@ -13,6 +13,7 @@
 # include <Siv3D/FastMath.hpp>
 # include <Siv3D/Math.hpp>
 # include <Siv3D/OffsetCircular.hpp>
+# include <Siv3D/SIMDMath.hpp>
 
 namespace s3d
 {
@@ -116,11 +117,279 @@ namespace s3d
 				: r <= 12.0f ? 8
 				: static_cast<Vertex2D::IndexType>(Min(64.0f, r * 0.2f + 6));
 		}
+
+		////////////////////////////////////////////////////////////////
+		//
+		//	SIMD kernels
+		//
+		//	DirectXMath を使い、x86 では SSE, ARM では NEON の命令で 4 頂点ずつ処理する。
+		//
+		////////////////////////////////////////////////////////////////
+
+		/// @brief v = (x0, y0, x1, y1) の前半を p0 の座標に、後半を p1 の座標に書き込みます。
+		inline void SIV3D_VECTOR_CALL StorePositions2(Vertex2D* p0, Vertex2D* p1, const DirectX::XMVECTOR v) noexcept
+		{
+			using namespace DirectX;
+			XMStoreFloat2(reinterpret_cast<XMFLOAT2*>(&p0->pos), v);
+			XMStoreFloat2(reinterpret_cast<XMFLOAT2*>(&p1->pos), XMVectorSwizzle<2, 3, 2, 3>(v));
+		}
+
+		/// @brief 連続する count 個の頂点の色を設定します。
+		inline void FillColor(Vertex2D* pDst, const size_t count, const Float4& color) noexcept
+		{
+			using namespace DirectX;
+			const XMVECTOR c = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&color));
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&(pDst++)->color), c);
+			}
+		}
+
+		/// @brief 円周を quality 等分した点 i, i + 1, i + 2, i + 3 の単位ベクトル (cos, -sin) を計算します。
+		/// @param cs01 点 i, i + 1 の (x, y, x, y)
+		/// @param cs23 点 i + 2, i + 3 の (x, y, x, y)
+		/// @remark FastMath::SinCos() と同じ近似式ですが、積和演算が融合されるビルド (FMA, NEON) では最下位ビットが異なることがあります。
+		inline void ComputeUnitCircle4(const float radDelta, const size_t i, DirectX::XMVECTOR& cs01, DirectX::XMVECTOR& cs23) noexcept
+		{
+			using namespace DirectX;
+			const XMVECTOR rad = XMVectorMultiply(XMVectorReplicate(radDelta),
+				XMVectorAdd(XMVectorReplicate(static_cast<float>(i)), XMVectorSet(0.0f, 1.0f, 2.0f, 3.0f)));
+
+			XMVECTOR s, c;
+			XMVectorSinCos(&s, &c, rad);
+
+			const XMVECTOR ns = XMVectorNegate(s);
+			cs01 = XMVectorMergeXY(c, ns);
+			cs23 = XMVectorMergeZW(c, ns);
+		}
+
+		/// @brief 円周上の quality 個の点を、連続する頂点の座標に書き込みます。
+		/// @param pCS 単位円上の点のテーブル。nullptr の場合は radDelta から計算します。
+		inline void WriteCirclePositions(Vertex2D* pDst, const Float2* pCS, const Vertex2D::IndexType quality, const float radDelta, const float r, const Float2& center) noexcept
+		{
+			using namespace DirectX;
+			const XMVECTOR vr = XMVectorReplicate(r);
+			const XMVECTOR vc = XMVectorSet(center.x, center.y, center.x, center.y);
+
+			size_t i = 0;
+
+			for (; (i + 4) <= quality; i += 4)
+			{
+				XMVECTOR cs01, cs23;
+
+				if (pCS)
+				{
+					cs01 = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(pCS + i));
+					cs23 = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(pCS + i + 2));
+				}
+				else
+				{
+					ComputeUnitCircle4(radDelta, i, cs01, cs23);
+				}
+
+				StorePositions2((pDst + 0), (pDst + 1), XMVectorMultiplyAdd(cs01, vr, vc));
+				StorePositions2((pDst + 2), (pDst + 3), XMVectorMultiplyAdd(cs23, vr, vc));
+				pDst += 4;
+			}
+
+			for (; i < quality; ++i)
+			{
+				if (pCS)
+				{
+					(pDst++)->pos.set(r * pCS[i].x + center.x, r * pCS[i].y + center.y);
+				}
+				else
+				{
+					const auto [s, c] = FastMath::SinCos(radDelta * i);
+					(pDst++)->pos.set(center.x + r * c, center.y - r * s);
+				}
+			}
+		}
+
+		/// @brief 円周上の quality 個の点について、外周と内周の座標を交互に頂点に書き込みます。
+		/// @param pCS 単位円上の点のテーブル。nullptr の場合は radDelta から計算します。
+		inline void WriteCircleFramePositions(Vertex2D* pDst, const Float2* pCS, const Vertex2D::IndexType quality, const float radDelta, const float rOuter, const float rInner, const Float2& center) noexcept
+		{
+			using namespace DirectX;
+			const XMVECTOR vrOuter = XMVectorReplicate(rOuter);
+			const XMVECTOR vrInner = XMVectorReplicate(rInner);
+			const XMVECTOR vc = XMVectorSet(center.x, center.y, center.x, center.y);
+
+			size_t i = 0;
+
+			for (; (i + 4) <= quality; i += 4)
+			{
+				XMVECTOR cs01, cs23;
+
+				if (pCS)
+				{
+					cs01 = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(pCS + i));
+					cs23 = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(pCS + i + 2));
+				}
+				else
+				{
+					ComputeUnitCircle4(radDelta, i, cs01, cs23);
+				}
+
+				StorePositions2((pDst + 0), (pDst + 2), XMVectorMultiplyAdd(cs01, vrOuter, vc));
+				StorePositions2((pDst + 1), (pDst + 3), XMVectorMultiplyAdd(cs01, vrInner, vc));
+				StorePositions2((pDst + 4), (pDst + 6), XMVectorMultiplyAdd(cs23, vrOuter, vc));
+				StorePositions2((pDst + 5), (pDst + 7), XMVectorMultiplyAdd(cs23, vrInner, vc));
+				pDst += 8;
+			}
+
+			for (; i < quality; ++i)
+			{
+				if (pCS)
+				{
+					(pDst++)->pos.set(rOuter * pCS[i].x + center.x, rOuter * pCS[i].y + center.y);
+					(pDst++)->pos.set(rInner * pCS[i].x + center.x, rInner * pCS[i].y + center.y);
+				}
+				else
+				{
+					const auto [s, c] = FastMath::SinCos(radDelta * i);
+					(pDst++)->pos.set(center.x + rOuter * c, center.y - rOuter * s);
+					(pDst++)->pos.set(center.x + rInner * c, center.y - rInner * s);
+				}
+			}
+		}
+
+		/// @brief 0 から π/2 までを (quality - 1) 等分した角度について、(sin * r, -cos * r) を書き込みます。
+		inline void WriteQuarterCircle(Float2* pDst, const Vertex2D::IndexType quality, const float r) noexcept
+		{
+			using namespace DirectX;
+			const float radDelta = (Math::HalfPiF / (quality - 1));
+			const XMVECTOR vr = XMVectorReplicate(r);
+
+			size_t i = 0;
+
+			for (; (i + 4) <= quality; i += 4)
+			{
+				const XMVECTOR rad = XMVectorMultiply(XMVectorReplicate(radDelta),
+					XMVectorAdd(XMVectorReplicate(static_cast<float>(i)), XMVectorSet(0.0f, 1.0f, 2.0f, 3.0f)));
+
+				XMVECTOR s, c;
+				XMVectorSinCos(&s, &c, rad);
+
+				const XMVECTOR x = XMVectorMultiply(s, vr);
+				const XMVECTOR y = XMVectorNegate(XMVectorMultiply(c, vr));
+				XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(pDst + i), XMVectorMergeXY(x, y));
+				XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(pDst + i + 2), XMVectorMergeZW(x, y));
+			}
+
+			for (; i < quality; ++i)
+			{
+				const auto [s, c] = FastMath::SinCos(radDelta * i);
+				pDst[i].set(s * r, -c * r);
+			}
+		}
+
+		/// @brief 折れ線の点 p1 における、太さ (thicknessHalf * 2) の線の継ぎ目の 2 頂点を計算します。
+		inline void WriteMiterJoint(Vertex2D* pDst, const Float2& p0, const Float2& p1, const Float2& p2, const float thicknessHalf) noexcept
+		{
+			const Float2 line = p1 - p0;
+			const Float2 normal = Float2{ -line.y, line.x }.normalized();
+			const Float2 v = (p2 - p1).normalized() + (p1 - p0).normalized();
+			const Float2 tangent = (v.lengthSq() > 0.001f) ? v.normalized() : (p2 - p0).normalized();
+			const Float2 miter = Float2{ -tangent.y, tangent.x };
+			const float length = thicknessHalf / miter.dot(normal);
+			const Float2 result0 = p1 + miter * length;
+			const Float2 result1 = p1 - miter * length;
+
+			pDst[0].pos.set(result0);
+			pDst[1].pos.set(result1);
+		}
+
+		/// @brief 折れ線の点 points[1] から points[count] までの継ぎ目の頂点を、点 1 つにつき 2 頂点ずつ書き込みます。
+		/// @param points 折れ線の点。(count + 2) 個の要素が必要です。
+		inline void WriteMiterJoints(Vertex2D* pDst, const Float2* points, const size_t count, const float thicknessHalf) noexcept
+		{
+			using namespace DirectX;
+			const XMVECTOR vThicknessHalf = XMVectorReplicate(thicknessHalf);
+			const XMVECTOR vThreshold = XMVectorReplicate(0.001f);
+
+			// (x0, y0, x1, y1), (x2, y2, x3, y3) を (x0, x1, x2, x3), (y0, y1, y2, y3) に並べ替えて読み込む
+			const auto loadSoA = [](const Float2* p, XMVECTOR& x, XMVECTOR& y)
+			{
+				const XMVECTOR a = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(p));
+				const XMVECTOR b = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(p + 2));
+				x = XMVectorPermute<XM_PERMUTE_0X, XM_PERMUTE_0Z, XM_PERMUTE_1X, XM_PERMUTE_1Z>(a, b);
+				y = XMVectorPermute<XM_PERMUTE_0Y, XM_PERMUTE_0W, XM_PERMUTE_1Y, XM_PERMUTE_1W>(a, b);
+			};
+
+			const auto invLength = [](const XMVECTOR x, const XMVECTOR y)
+			{
+				return XMVectorReciprocal(XMVectorSqrt(XMVectorAdd(XMVectorMultiply(x, x), XMVectorMultiply(y, y))));
+			};
+
+			size_t i = 0;
+
+			for (; (i + 4) <= count; i += 4)
+			{
+				XMVECTOR p0x, p0y, p1x, p1y, p2x, p2y;
+				loadSoA((points + i), p0x, p0y);
+				loadSoA((points + i + 1), p1x, p1y);
+				loadSoA((points + i + 2), p2x, p2y);
+
+				// line = p1 - p0
+				const XMVECTOR lx = XMVectorSubtract(p1x, p0x);
+				const XMVECTOR ly = XMVectorSubtract(p1y, p0y);
+				const XMVECTOR lInv = invLength(lx, ly);
+
+				// normal = (-line.y, line.x).normalized()
+				const XMVECTOR nx = XMVectorMultiply(XMVectorNegate(ly), lInv);
+				const XMVECTOR ny = XMVectorMultiply(lx, lInv);
+
+				// v = (p2 - p1).normalized() + (p1 - p0).normalized()
+				const XMVECTOR dx = XMVectorSubtract(p2x, p1x);
+				const XMVECTOR dy = XMVectorSubtract(p2y, p1y);
+				const XMVECTOR dInv = invLength(dx, dy);
+				const XMVECTOR vx = XMVectorAdd(XMVectorMultiply(dx, dInv), XMVectorMultiply(lx, lInv));
+				const XMVECTOR vy = XMVectorAdd(XMVectorMultiply(dy, dInv), XMVectorMultiply(ly, lInv));
+
+				// tangent = (v.lengthSq() > 0.001f) ? v.normalized() : (p2 - p0).normalized()
+				const XMVECTOR vLengthSq = XMVectorAdd(XMVectorMultiply(vx, vx), XMVectorMultiply(vy, vy));
+				const XMVECTOR vInv = XMVectorReciprocal(XMVectorSqrt(vLengthSq));
+				const XMVECTOR ex = XMVectorSubtract(p2x, p0x);
+				const XMVECTOR ey = XMVectorSubtract(p2y, p0y);
+				const XMVECTOR eInv = invLength(ex, ey);
+				const XMVECTOR useV = XMVectorGreater(vLengthSq, vThreshold);
+				const XMVECTOR tx = XMVectorSelect(XMVectorMultiply(ex, eInv), XMVectorMultiply(vx, vInv), useV);
+				const XMVECTOR ty = XMVectorSelect(XMVectorMultiply(ey, eInv), XMVectorMultiply(vy, vInv), useV);
+
+				// miter = (-tangent.y, tangent.x)
+				const XMVECTOR mx = XMVectorNegate(ty);
+				const XMVECTOR my = tx;
+
+				// length = thicknessHalf / miter.dot(normal)
+				const XMVECTOR length = XMVectorDivide(vThicknessHalf, XMVectorAdd(XMVectorMultiply(mx, nx), XMVectorMultiply(my, ny)));
+				const XMVECTOR ox = XMVectorMultiply(mx, length);
+				const XMVECTOR oy = XMVectorMultiply(my, length);
+
+				const XMVECTOR r0x = XMVectorAdd(p1x, ox);
+				const XMVECTOR r0y = XMVectorAdd(p1y, oy);
+				const XMVECTOR r1x = XMVectorSubtract(p1x, ox);
+				const XMVECTOR r1y = XMVectorSubtract(p1y, oy);
+
+				StorePositions2((pDst + 0), (pDst + 2), XMVectorMergeXY(r0x, r0y));
+				StorePositions2((pDst + 1), (pDst + 3), XMVectorMergeXY(r1x, r1y));
+				StorePositions2((pDst + 4), (pDst + 6), XMVectorMergeZW(r0x, r0y));
+				StorePositions2((pDst + 5), (pDst + 7), XMVectorMergeZW(r1x, r1y));
+				pDst += 8;
+			}
+
+			for (; i < count; ++i)
+			{
+				WriteMiterJoint(pDst, points[i], points[i + 1], points[i + 2], thicknessHalf);
+				pDst += 2;
+			}
+		}
 	}
 
 	namespace Vertex2DBuilder
 	{
-		Vertex2D::IndexType BuildLine(const LineStyle& style, const BufferCreatorFunc& bufferCreator, const Float2& begin, const Float2& end, const float thickness, const Float4(&colors)[2], const float scale)
+		Vertex2D::IndexType BuildLine(const LineStyle& style, const BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, const float thickness, const Float4(&colors)[2], const float scale)
 		{
 			if (thickness <= 0.0f)
 			{
@@ -160,7 +429,7 @@ namespace s3d
 			}
 		}
 
-		Vertex2D::IndexType BuildCappedLine(const BufferCreatorFunc& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2])
+		Vertex2D::IndexType BuildCappedLine(const BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2])
 		{
 			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
 			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -191,7 +460,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildUncappedLine(const BufferCreatorFunc& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2])
+		Vertex2D::IndexType BuildUncappedLine(const BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2])
 		{
 			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
 			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -218,7 +487,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildUncappedLine(const BufferCreatorFunc& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float& startAngle)
+		Vertex2D::IndexType BuildUncappedLine(const BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float& startAngle)
 		{
 			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
 			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -247,7 +516,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildSquareDotLine(const BufferCreatorFunc& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], const float dotOffset, const float scale)
+		Vertex2D::IndexType BuildSquareDotLine(const BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], const float dotOffset, const float scale)
 		{
 			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
 			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -285,7 +554,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildRoundDotLine(const BufferCreatorFunc& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], const float dotOffset, const bool hasAlignedDot)
+		Vertex2D::IndexType BuildRoundDotLine(const BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], const float dotOffset, const bool hasAlignedDot)
 		{
 			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
 			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -328,7 +597,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildTriangle(const BufferCreatorFunc& bufferCreator, const Float2(&points)[3], const Float4& color)
+		Vertex2D::IndexType BuildTriangle(const BufferCreatorFunc bufferCreator, const Float2(&points)[3], const Float4& color)
 		{
 			constexpr Vertex2D::IndexType vertexSize = 3, indexSize = 3;
 			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -349,7 +618,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildTriangle(const BufferCreatorFunc& bufferCreator, const Float2(&points)[3], const Float4(&colors)[3])
+		Vertex2D::IndexType BuildTriangle(const BufferCreatorFunc bufferCreator, const Float2(&points)[3], const Float4(&colors)[3])
 		{
 			constexpr Vertex2D::IndexType vertexSize = 3, indexSize = 3;
 			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -370,7 +639,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildRect(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, const Float4& color)
+		Vertex2D::IndexType BuildRect(const BufferCreatorFunc bufferCreator, const FloatRect& rect, const Float4& color)
 		{
 			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
 			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -393,7 +662,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildRect(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, const Float4(&colors)[4])
+		Vertex2D::IndexType BuildRect(const BufferCreatorFunc bufferCreator, const FloatRect& rect, const Float4(&colors)[4])
 		{
 			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
 			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -416,7 +685,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildRectFrame(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, float thickness, const Float4& innerColor, const Float4& outerColor)
+		Vertex2D::IndexType BuildRectFrame(const BufferCreatorFunc bufferCreator, const FloatRect& rect, float thickness, const Float4& innerColor, const Float4& outerColor)
 		{
 			constexpr Vertex2D::IndexType vertexSize = 8, indexSize = 24;
 			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -449,7 +718,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildCircle(const BufferCreatorFunc& bufferCreator, const Float2& center, float r, const Float4& innerColor, const Float4& outerColor, const float scale)
+		Vertex2D::IndexType BuildCircle(const BufferCreatorFunc bufferCreator, const Float2& center, float r, const Float4& innerColor, const Float4& outerColor, const float scale)
 		{
 			const float absR = Abs(r);
 			const Vertex2D::IndexType quality = detail::CalculateCircleQuality(absR * scale);
@@ -462,42 +731,17 @@ namespace s3d
 			}
 
 			// 中心
-			const float centerX = center.x;
-			const float centerY = center.y;
-			pVertex[0].pos.set(centerX, centerY);
+			pVertex[0].pos.set(center);
 
 			// 周
-			if (quality <= detail::MaxSinCosTableQuality)
 			{
-				const Float2* pCS = detail::GetSinCosTableStartPtr(quality);
-				Vertex2D* pDst = &pVertex[1];
-
-				for (Vertex2D::IndexType i = 0; i < quality; ++i)
-				{
-					(pDst++)->pos.set(r * pCS->x + centerX, r * pCS->y + centerY);
-					++pCS;
-				}
-			}
-			else
-			{
-				const float radDelta = Math::TwoPiF / quality;
-				Vertex2D* pDst = &pVertex[1];
-
-				for (Vertex2D::IndexType i = 0; i < quality; ++i)
-				{
-					const float rad = (radDelta * i);
-					const auto [s, c] = FastMath::SinCos(rad);
-					(pDst++)->pos.set(centerX + r * c, centerY - r * s);
-				}
+				const Float2* pCS = ((quality <= detail::MaxSinCosTableQuality) ? detail::GetSinCosTableStartPtr(quality) : nullptr);
+				detail::WriteCirclePositions(&pVertex[1], pCS, quality, (Math::TwoPiF / quality), r, center);
 			}
 
 			{
-				(pVertex++)->color = innerColor;
-
-				for (size_t i = 1; i < vertexSize; ++i)
-				{
-					(pVertex++)->color = outerColor;
-				}
+				pVertex[0].color = innerColor;
+				detail::FillColor(&pVertex[1], quality, outerColor);
 			}
 
 			{
@@ -516,7 +760,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildCircleFrame(const BufferCreatorFunc& bufferCreator, const Float2& center, const float rInner, const float thickness, const Float4& innerColor, const Float4& outerColor, const float scale)
+		Vertex2D::IndexType BuildCircleFrame(const BufferCreatorFunc bufferCreator, const Float2& center, const float rInner, const float thickness, const Float4& innerColor, const Float4& outerColor, const float scale)
 		{
 			const float rOuter = (rInner + thickness);
 			const Vertex2D::IndexType quality = detail::CalculateCircleFrameQuality(rOuter * scale);
@@ -528,33 +772,9 @@ namespace s3d
 				return 0;
 			}
 
-			const float centerX = center.x;
-			const float centerY = center.y;
-
-			if (quality <= detail::MaxSinCosTableQuality)
-			{
-				const Float2* pCS = detail::GetSinCosTableStartPtr(quality);
-				Vertex2D* pDst = pVertex;
-
-				for (Vertex2D::IndexType i = 0; i < quality; ++i)
-				{
-					(pDst++)->pos.set(rOuter * pCS->x + centerX, rOuter * pCS->y + centerY);
-					(pDst++)->pos.set(rInner * pCS->x + centerX, rInner * pCS->y + centerY);
-					++pCS;
-				}
-			}
-			else
 			{
-				const float radDelta = Math::TwoPiF / quality;
-				Vertex2D* pDst = pVertex;
-
-				for (Vertex2D::IndexType i = 0; i < quality; ++i)
-				{
-					const float rad = (radDelta * i);
-					const auto [s, c] = FastMath::SinCos(rad);
-					(pDst++)->pos.set(centerX + rOuter * c, centerY - rOuter * s);
-					(pDst++)->pos.set(centerX + rInner * c, centerY - rInner * s);
-				}
+				const Float2* pCS = ((quality <= detail::MaxSinCosTableQuality) ? detail::GetSinCosTableStartPtr(quality) : nullptr);
+				detail::WriteCircleFramePositions(pVertex, pCS, quality, (Math::TwoPiF / quality), rOuter, rInner, center);
 			}
 
 			for (Vertex2D::IndexType i = 0; i < quality; ++i)
@@ -563,18 +783,26 @@ namespace s3d
 				(pVertex++)->color = innerColor;
 			}
 
-			for (Vertex2D::IndexType i = 0; i < quality; ++i)
 			{
+				// 最後の四角形だけが先頭の頂点に戻る
+				for (Vertex2D::IndexType i = 0; i < (quality - 1); ++i)
+				{
+					for (Vertex2D::IndexType k = 0; k < 6; ++k)
+					{
+						*pIndex++ = (indexOffset + (i * 2 + detail::RectIndexTable[k]));
+					}
+				}
+
 				for (Vertex2D::IndexType k = 0; k < 6; ++k)
 				{
-					*pIndex++ = (indexOffset + (i * 2 + detail::RectIndexTable[k]) % (quality * 2));
+					*pIndex++ = (indexOffset + ((quality - 1) * 2 + detail::RectIndexTable[k]) % (quality * 2));
 				}
 			}
 
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildCirclePie(const BufferCreatorFunc& bufferCreator, const Float2& center, float r, float startAngle, float _angle, const Float4& innerColor, const Float4& outerColor, float scale)
+		Vertex2D::IndexType BuildCirclePie(const BufferCreatorFunc bufferCreator, const Float2& center, float r, float startAngle, float _angle, const Float4& innerColor, const Float4& outerColor, float scale)
 		{
 			if (_angle == 0.0f)
 			{
@@ -631,7 +859,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildCircleArc(const BufferCreatorFunc& bufferCreator, const LineStyle& style, const Float2& center, const float rInner, const float startAngle, const float _angle, const float thickness, const Float4& innerColor, const Float4& outerColor, const float scale)
+		Vertex2D::IndexType BuildCircleArc(const BufferCreatorFunc bufferCreator, const LineStyle& style, const Float2& center, const float rInner, const float startAngle, const float _angle, const float thickness, const Float4& innerColor, const Float4& outerColor, const float scale)
 		{
 			if (style.hasRoundCap())
 			{
@@ -652,7 +880,7 @@ namespace s3d
 			}
 		}
 
-		Vertex2D::IndexType BuildUncappedCircleArc(const BufferCreatorFunc& bufferCreator, const Float2& center, const float rInner, const float startAngle, const float _angle, const float thickness, const Float4& innerColor, const Float4& outerColor, const float scale)
+		Vertex2D::IndexType BuildUncappedCircleArc(const BufferCreatorFunc bufferCreator, const Float2& center, const float rInner, const float startAngle, const float _angle, const float thickness, const Float4& innerColor, const Float4& outerColor, const float scale)
 		{
 			if (_angle == 0.0f)
 			{
@@ -704,7 +932,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildEllipse(const BufferCreatorFunc& bufferCreator, const Float2& center, float a, float b, const Float4& innerColor, const Float4& outerColor, float scale)
+		Vertex2D::IndexType BuildEllipse(const BufferCreatorFunc bufferCreator, const Float2& center, float a, float b, const Float4& innerColor, const Float4& outerColor, float scale)
 		{
 			const float majorAxis = Max(Abs(a), Abs(b));
 			const Vertex2D::IndexType quality = static_cast<Vertex2D::IndexType>(Clamp(majorAxis * scale * 0.225f + 18.0f, 6.0f, 255.0f));
@@ -771,7 +999,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildEllipseFrame(const BufferCreatorFunc& bufferCreator, const Float2& center, float aInner, float bInner, float thickness, const Float4& innerColor, const Float4& outerColor, float scale)
+		Vertex2D::IndexType BuildEllipseFrame(const BufferCreatorFunc bufferCreator, const Float2& center, float aInner, float bInner, float thickness, const Float4& innerColor, const Float4& outerColor, float scale)
 		{
 			const float aOuter = (aInner + thickness);
 			const float bOuter = (bInner + thickness);
@@ -831,7 +1059,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildQuad(const BufferCreatorFunc& bufferCreator, const FloatQuad& quad, const Float4 color)
+		Vertex2D::IndexType BuildQuad(const BufferCreatorFunc bufferCreator, const FloatQuad& quad, const Float4 color)
 		{
 			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
 			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -854,7 +1082,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildQuad(const BufferCreatorFunc& bufferCreator, const FloatQuad& quad, const Float4(&colors)[4])
+		Vertex2D::IndexType BuildQuad(const BufferCreatorFunc bufferCreator, const FloatQuad& quad, const Float4(&colors)[4])
 		{
 			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
 			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -877,22 +1105,13 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildRoundRect(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const FloatRect& rect, float w, float h, float r, const Float4& color, float scale)
+		Vertex2D::IndexType BuildRoundRect(const BufferCreatorFunc bufferCreator, Array<Float2>& buffer, const FloatRect& rect, float w, float h, float r, const Float4& color, float scale)
 		{
 			const float rr = Min({ w * 0.5f, h * 0.5f, Max(0.0f, r) });
 			const Vertex2D::IndexType quality = detail::CaluculateFanQuality(rr * scale);
 
 			buffer.resize(quality);
-			{
-				const float radDelta = (Math::HalfPiF / (quality - 1));
-
-				for (int32 i = 0; i < quality; ++i)
-				{
-					const float rad = (radDelta * i);
-					const auto [s, c] = FastMath::SinCos(rad);
-					buffer[i].set(s * rr, -c * rr);
-				}
-			}
+			detail::WriteQuarterCircle(buffer.data(), quality, rr);
 
 			const bool uniteV = (h * 0.5f == rr);
 			const bool uniteH = (w * 0.5f == rr);
@@ -940,10 +1159,7 @@ namespace s3d
 					++pDst;
 				}
 
-				for (size_t i = 0; i < vertexSize; ++i)
-				{
-					(pVertex++)->color = color;
-				}
+				detail::FillColor(pVertex, vertexSize, color);
 			}
 
 			for (Vertex2D::IndexType i = 0; i < (vertexSize - 2); ++i)
@@ -956,7 +1172,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildLineString(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const LineStyle& style, const Vec2* points, const size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const CloseRing closeRing, const float scale)
+		Vertex2D::IndexType BuildLineString(const BufferCreatorFunc bufferCreator, Array<Float2>& buffer, const LineStyle& style, const Vec2* points, const size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const CloseRing closeRing, const float scale)
 		{
 			if ((size < 2)
 				|| (32760 <= size)
@@ -999,7 +1215,7 @@ namespace s3d
 			}
 		}
 
-		Vertex2D::IndexType BuildClosedLineString(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const Vec2* points, const size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const float scale)
+		Vertex2D::IndexType BuildClosedLineString(const BufferCreatorFunc bufferCreator, Array<Float2>& buffer, const Vec2* points, const size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const float scale)
 		{
 			const float th2 = (0.01f / scale);
 			const double th2D = th2;
@@ -1127,58 +1343,12 @@ namespace s3d
 
 			const float thicknessHalf = (thickness * 0.5f);
 
-			{
-				const Float2 p0 = buf2.back();
-				const Float2 p1 = buf2[0];
-				const Float2 p2 = buf2[1];
-				const Float2 line = p1 - p0;
-				const Float2 normal = Float2{ -line.y, line.x }.normalized();
-				const Float2 v = (p2 - p1).normalized() + (p1 - p0).normalized();
-				const Float2 tangent = (v.lengthSq() > 0.001f) ? v.normalized() : (p2 - p0).normalized();
-				const Float2 miter = Float2{ -tangent.y, tangent.x };
-				const float length = thicknessHalf / miter.dot(normal);
-				const Float2 result0 = p1 + miter * length;
-				const Float2 result1 = p1 - miter * length;
-
-				pVertex[0].pos.set(result0);
-				pVertex[1].pos.set(result1);
-			}
-
-			for (Vertex2D::IndexType i = 0; i < (newSize - 2); ++i)
-			{
-				const Float2 p0 = buf2[i];
-				const Float2 p1 = buf2[i + 1];
-				const Float2 p2 = buf2[i + 2];
-				const Float2 line = p1 - p0;
-				const Float2 normal = Float2{ -line.y, line.x }.normalized();
-				const Float2 v = (p2 - p1).normalized() + (p1 - p0).normalized();
-				const Float2 tangent = (v.lengthSq() > 0.001f) ? v.normalized() : (p2 - p0).normalized();
-				const Float2 miter = Float2{ -tangent.y, tangent.x };
-				const float length = thicknessHalf / miter.dot(normal);
-				const Float2 result0 = p1 + miter * length;
-				const Float2 result1 = p1 - miter * length;
+			detail::WriteMiterJoint(pVertex, buf2.back(), buf2[0], buf2[1], thicknessHalf);
 
-				pVertex[i * 2 + 2].pos.set(result0);
-				pVertex[i * 2 + 3].pos.set(result1);
-			}
+			detail::WriteMiterJoints((pVertex + 2), buf2.data(), (newSize - 2), thicknessHalf);
 
 			
-			{
-				const Float2 p0 = buf2[newSize - 2];
-				const Float2 p1 = buf2[newSize - 1];
-				const Float2 p2 = buf2[0];
-				const Float2 line = p1 - p0;
-				const Float2 normal = Float2{ -line.y, line.x }.normalized();
-				const Float2 v = (p2 - p1).normalized() + (p1 - p0).normalized();
-				const Float2 tangent = (v.lengthSq() > 0.001f) ? v.normalized() : (p2 - p0).normalized();
-				const Float2 miter = Float2{ -tangent.y, tangent.x };
-				const float length = thicknessHalf / miter.dot(normal);
-				const Float2 result0 = p1 + miter * length;
-				const Float2 result1 = p1 - miter * length;
-
-				pVertex[newSize * 2 - 2].pos.set(result0);
-				pVertex[newSize * 2 - 1].pos.set(result1);
-			}
+			detail::WriteMiterJoint((pVertex + (newSize * 2 - 2)), buf2[newSize - 2], buf2[newSize - 1], buf2[0], thicknessHalf);
 
 			if (offset)
 			{
@@ -1191,10 +1361,7 @@ namespace s3d
 				}
 			}
 
-			for (size_t i = 0; i < vertexSize; ++i)
-			{
-				(pVertex++)->color = color;
-			}
+			detail::FillColor(pVertex, vertexSize, color);
 
 			{
 				const Vertex2D::IndexType count = static_cast<Vertex2D::IndexType>(newSize);
@@ -1211,7 +1378,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildCappedLineString(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const Vec2* points, const size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const float scale)
+		Vertex2D::IndexType BuildCappedLineString(const BufferCreatorFunc bufferCreator, Array<Float2>& buffer, const Vec2* points, const size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const float scale)
 		{
 			const float th2 = (0.01f / scale);
 			const double th2D = th2;
@@ -1316,23 +1483,7 @@ namespace s3d
 				pVertex[1].pos.set(p0 - vNormalBegin - lineHalf);
 			}
 
-			for (Vertex2D::IndexType i = 0; i < (newSize - 2); ++i)
-			{
-				const Float2 p0 = buf2[i];
-				const Float2 p1 = buf2[i + 1];
-				const Float2 p2 = buf2[i + 2];
-				const Float2 line = p1 - p0;
-				const Float2 normal = Float2{ -line.y, line.x }.normalized();
-				const Float2 v = (p2 - p1).normalized() + (p1 - p0).normalized();
-				const Float2 tangent = (v.lengthSq() > 0.001f) ? v.normalized() : (p2 - p0).normalized();
-				const Float2 miter = Float2{ -tangent.y, tangent.x };
-				const float length = thicknessHalf / miter.dot(normal);
-				const Float2 result0 = p1 + miter * length;
-				const Float2 result1 = p1 - miter * length;
-
-				pVertex[i * 2 + 2].pos.set(result0);
-				pVertex[i * 2 + 3].pos.set(result1);
-			}
+			detail::WriteMiterJoints((pVertex + 2), buf2.data(), (newSize - 2), thicknessHalf);
 
 			{
 				const Float2 p0 = buf2[newSize - 2];
@@ -1356,10 +1507,7 @@ namespace s3d
 				}
 			}
 
-			for (size_t i = 0; i < vertexSize; ++i)
-			{
-				(pVertex++)->color = color;
-			}
+			detail::FillColor(pVertex, vertexSize, color);
 
 			{
 				const Vertex2D::IndexType count = static_cast<Vertex2D::IndexType>(newSize - 1);
@@ -1376,7 +1524,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildUncappedLineString(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const Vec2* points, const size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const float scale, float* startAngle0, float* startAngle1)
+		Vertex2D::IndexType BuildUncappedLineString(const BufferCreatorFunc bufferCreator, Array<Float2>& buffer, const Vec2* points, const size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const Float4& color, const float scale, float* startAngle0, float* startAngle1)
 		{
 			const float th2 = (0.01f / scale);
 			const double th2D = th2;
@@ -1485,23 +1633,7 @@ namespace s3d
 				pVertex[1].pos.set(p0 - vNormalBegin);
 			}
 
-			for (Vertex2D::IndexType i = 0; i < (newSize - 2); ++i)
-			{
-				const Float2 p0 = buf2[i];
-				const Float2 p1 = buf2[i + 1];
-				const Float2 p2 = buf2[i + 2];
-				const Float2 line = p1 - p0;
-				const Float2 normal = Float2{ -line.y, line.x }.normalized();
-				const Float2 v = (p2 - p1).normalized() + (p1 - p0).normalized();
-				const Float2 tangent = (v.lengthSq() > 0.001f) ? v.normalized() : (p2 - p0).normalized();
-				const Float2 miter = Float2{ -tangent.y, tangent.x };
-				const float length = thicknessHalf / miter.dot(normal);
-				const Float2 result0 = p1 + miter * length;
-				const Float2 result1 = p1 - miter * length;
-
-				pVertex[i * 2 + 2].pos.set(result0);
-				pVertex[i * 2 + 3].pos.set(result1);
-			}
+			detail::WriteMiterJoints((pVertex + 2), buf2.data(), (newSize - 2), thicknessHalf);
 
 			{
 				const Float2 p0 = buf2[newSize - 2];
@@ -1529,10 +1661,7 @@ namespace s3d
 				}
 			}
 
-			for (size_t i = 0; i < vertexSize; ++i)
-			{
-				(pVertex++)->color = color;
-			}
+			detail::FillColor(pVertex, vertexSize, color);
 
 			{
 				const Vertex2D::IndexType count = static_cast<Vertex2D::IndexType>(newSize - 1);
@@ -1549,7 +1678,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildDefaultLineString(const BufferCreatorFunc& bufferCreator, const Vec2* points, const ColorF* colors, const size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const CloseRing closeRing, const float scale)
+		Vertex2D::IndexType BuildDefaultLineString(const BufferCreatorFunc bufferCreator, const Vec2* points, const ColorF* colors, const size_t size, const Optional<Float2>& offset, const float thickness, const bool inner, const CloseRing closeRing, const float scale)
 		{
 			if ((size < 2)
 				|| (32760 <= size)
@@ -1800,7 +1929,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildPolygon(const BufferCreatorFunc& bufferCreator, const Array<Float2>& vertices, const Array<TriangleIndex>& tirnagleIndices, const Optional<Float2>& offset, const Float4& color)
+		Vertex2D::IndexType BuildPolygon(const BufferCreatorFunc bufferCreator, const Array<Float2>& vertices, const Array<TriangleIndex>& tirnagleIndices, const Optional<Float2>& offset, const Float4& color)
 		{
 			if (vertices.isEmpty()
 				|| tirnagleIndices.isEmpty())
@@ -1855,7 +1984,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildPolygon(const BufferCreatorFunc& bufferCreator, const Vertex2D* vertices, const size_t vertexCount, const TriangleIndex* indices, const size_t num_triangles)
+		Vertex2D::IndexType BuildPolygon(const BufferCreatorFunc bufferCreator, const Vertex2D* vertices, const size_t vertexCount, const TriangleIndex* indices, const size_t num_triangles)
 		{
 			if ((not vertices)
 				|| (vertexCount == 0)
@@ -1890,7 +2019,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildPolygonTransformed(const BufferCreatorFunc& bufferCreator, const Array<Float2>& vertices, const Array<TriangleIndex>& tirnagleIndices, const float s, const float c, const Float2& offset, const Float4& color)
+		Vertex2D::IndexType BuildPolygonTransformed(const BufferCreatorFunc bufferCreator, const Array<Float2>& vertices, const Array<TriangleIndex>& tirnagleIndices, const float s, const float c, const Float2& offset, const Float4& color)
 		{
 			if (vertices.isEmpty()
 				|| tirnagleIndices.isEmpty())
@@ -1935,7 +2064,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildPolygonFrame(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const Float2* points, const size_t size, const float thickness, const Float4& color, const float scale)
+		Vertex2D::IndexType BuildPolygonFrame(const BufferCreatorFunc bufferCreator, Array<Float2>& buffer, const Float2* points, const size_t size, const float thickness, const Float4& color, const float scale)
 		{
 			if ((size < 3)
 				|| (32760 <= size)
@@ -2068,62 +2197,13 @@ namespace s3d
 
 			const float thicknessHalf = (thickness * 0.5f);
 
-			{
-				const Float2 p0 = buf2.back();
-				const Float2 p1 = buf2[0];
-				const Float2 p2 = buf2[1];
-				const Float2 line = p1 - p0;
-				const Float2 normal = Float2{ -line.y, line.x }.normalized();
-				const Float2 v = (p2 - p1).normalized() + (p1 - p0).normalized();
-				const Float2 tangent = (v.lengthSq() > 0.001f) ? v.normalized() : (p2 - p0).normalized();
-				const Float2 miter = Float2{ -tangent.y, tangent.x };
-				const float length = thicknessHalf / miter.dot(normal);
-				const Float2 result0 = p1 + miter * length;
-				const Float2 result1 = p1 - miter * length;
-
-				pVertex[0].pos.set(result0);
-				pVertex[1].pos.set(result1);
-			}
-
-			for (Vertex2D::IndexType i = 0; i < (newSize - 2); ++i)
-			{
-				const Float2 p0 = buf2[i];
-				const Float2 p1 = buf2[i + 1];
-				const Float2 p2 = buf2[i + 2];
-				const Float2 line = p1 - p0;
-				const Float2 normal = Float2{ -line.y, line.x }.normalized();
-				const Float2 v = (p2 - p1).normalized() + (p1 - p0).normalized();
-				const Float2 tangent = (v.lengthSq() > 0.001f) ? v.normalized() : (p2 - p0).normalized();
-				const Float2 miter = Float2{ -tangent.y, tangent.x };
-				const float length = thicknessHalf / miter.dot(normal);
-				const Float2 result0 = p1 + miter * length;
-				const Float2 result1 = p1 - miter * length;
+			detail::WriteMiterJoint(pVertex, buf2.back(), buf2[0], buf2[1], thicknessHalf);
 
-				pVertex[i * 2 + 2].pos.set(result0);
-				pVertex[i * 2 + 3].pos.set(result1);
-			}
-
-			{
-				const Float2 p0 = buf2[newSize - 2];
-				const Float2 p1 = buf2[newSize - 1];
-				const Float2 p2 = buf2[0];
-				const Float2 line = p1 - p0;
-				const Float2 normal = Float2{ -line.y, line.x }.normalized();
-				const Float2 v = (p2 - p1).normalized() + (p1 - p0).normalized();
-				const Float2 tangent = (v.lengthSq() > 0.001f) ? v.normalized() : (p2 - p0).normalized();
-				const Float2 miter = Float2{ -tangent.y, tangent.x };
-				const float length = thicknessHalf / miter.dot(normal);
-				const Float2 result0 = p1 + miter * length;
-				const Float2 result1 = p1 - miter * length;
+			detail::WriteMiterJoints((pVertex + 2), buf2.data(), (newSize - 2), thicknessHalf);
 
-				pVertex[newSize * 2 - 2].pos.set(result0);
-				pVertex[newSize * 2 - 1].pos.set(result1);
-			}
+			detail::WriteMiterJoint((pVertex + (newSize * 2 - 2)), buf2[newSize - 2], buf2[newSize - 1], buf2[0], thicknessHalf);
 
-			for (size_t i = 0; i < vertexSize; ++i)
-			{
-				(pVertex++)->color = color;
-			}
+			detail::FillColor(pVertex, vertexSize, color);
 
 			{
 				const Vertex2D::IndexType count = static_cast<Vertex2D::IndexType>(newSize);
@@ -2140,7 +2220,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildTextureRegion(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4& color)
+		Vertex2D::IndexType BuildTextureRegion(const BufferCreatorFunc bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4& color)
 		{
 			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
 			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -2163,7 +2243,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildTextureRegion(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4(&colors)[4])
+		Vertex2D::IndexType BuildTextureRegion(const BufferCreatorFunc bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4(&colors)[4])
 		{
 			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
 			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -2186,7 +2266,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildTexturedCircle(const BufferCreatorFunc& bufferCreator, const Circle& circle, const FloatRect& uv, const Float4& color, const float scale)
+		Vertex2D::IndexType BuildTexturedCircle(const BufferCreatorFunc bufferCreator, const Circle& circle, const FloatRect& uv, const Float4& color, const float scale)
 		{
 			const float rf = static_cast<float>(circle.r);
 			const float absR = Abs(rf);
@@ -2223,10 +2303,7 @@ namespace s3d
 				}
 			}
 
-			for (size_t i = 0; i < vertexSize; ++i)
-			{
-				(pVertex++)->color = color;
-			}
+			detail::FillColor(pVertex, vertexSize, color);
 
 			{
 				for (Vertex2D::IndexType i = 0; i < (quality - 1); ++i)
@@ -2244,7 +2321,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildTexturedQuad(const BufferCreatorFunc& bufferCreator, const FloatQuad& quad, const FloatRect& uv, const Float4& color)
+		Vertex2D::IndexType BuildTexturedQuad(const BufferCreatorFunc bufferCreator, const FloatQuad& quad, const FloatRect& uv, const Float4& color)
 		{
 			constexpr Vertex2D::IndexType vertexSize = 4, indexSize = 6;
 			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
@@ -2267,22 +2344,13 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildTexturedRoundRect(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const FloatRect& rect, const float w, const float h, const float r, const FloatRect& uvRect, const Float4& color, const float scale)
+		Vertex2D::IndexType BuildTexturedRoundRect(const BufferCreatorFunc bufferCreator, Array<Float2>& buffer, const FloatRect& rect, const float w, const float h, const float r, const FloatRect& uvRect, const Float4& color, const float scale)
 		{
 			const float rr = Min({ w * 0.5f, h * 0.5f, Max(0.0f, r) });
 			const Vertex2D::IndexType quality = detail::CaluculateFanQuality(rr * scale);
 
 			buffer.resize(quality);
-			{
-				const float radDelta = (Math::HalfPiF / (quality - 1));
-
-				for (int32 i = 0; i < quality; ++i)
-				{
-					const float rad = (radDelta * i);
-					const auto [s, c] = FastMath::SinCos(rad);
-					buffer[i].set(s * rr, -c * rr);
-				}
-			}
+			detail::WriteQuarterCircle(buffer.data(), quality, rr);
 
 			const bool uniteV = (h * 0.5f == rr);
 			const bool uniteH = (w * 0.5f == rr);
@@ -2368,7 +2436,7 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildTexturedVertices(const BufferCreatorFunc& bufferCreator, const Vertex2D* vertices, const size_t vertexCount, const TriangleIndex* indices, const size_t num_triangles)
+		Vertex2D::IndexType BuildTexturedVertices(const BufferCreatorFunc bufferCreator, const Vertex2D* vertices, const size_t vertexCount, const TriangleIndex* indices, const size_t num_triangles)
 		{
 			if ((not vertices)
 				|| (vertexCount == 0)
@@ -2403,11 +2471,14 @@ namespace s3d
 			return indexSize;
 		}
 
-		Vertex2D::IndexType BuildTexturedParticles(const BufferCreatorFunc& bufferCreator, const Array<Particle2D>& particles,
+		Vertex2D::IndexType BuildTexturedParticles(const BufferCreatorFunc bufferCreator, const ParticleStorage2D& particles, const size_t offset, const size_t count,
 			const ParticleSystem2DParameters::SizeOverLifeTimeFunc& sizeOverLifeTimeFunc, const ParticleSystem2DParameters::ColorOverLifeTimeFunc& colorOverLifeTimeFunc)
 		{
-			const Vertex2D::IndexType vertexSize = static_cast<Vertex2D::IndexType>(particles.size() * 4);
-			const Vertex2D::IndexType indexSize = static_cast<Vertex2D::IndexType>(particles.size() * 6);
+			assert(count <= MaxTexturedParticles);
+			assert((offset + count) <= particles.size());
+
+			const Vertex2D::IndexType vertexSize = static_cast<Vertex2D::IndexType>(count * 4);
+			const Vertex2D::IndexType indexSize = static_cast<Vertex2D::IndexType>(count * 6);
 			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
 
 			if (not pVertex)
@@ -2415,17 +2486,25 @@ namespace s3d
 				return 0;
 			}
 
-			for (const auto& particle : particles)
+			const float* pPositionX = (particles.positionX() + offset);
+			const float* pPositionY = (particles.positionY() + offset);
+			const float* pRotation = (particles.rotation() + offset);
+			const float* pStartSize = (particles.startSize() + offset);
+			const float* pStartLifeTime = (particles.startLifeTime() + offset);
+			const float* pRemainingLifeTime = (particles.remainingLifeTime() + offset);
+			const Float4* pStartColor = (particles.startColor() + offset);
+
+			for (size_t i = 0; i < count; ++i)
 			{
-				const float size = sizeOverLifeTimeFunc(particle.startSize, particle.startLifeTime, particle.remainingLifeTime);
-				const Float4 color = colorOverLifeTimeFunc(particle.startColor, particle.startLifeTime, particle.remainingLifeTime);
+				const float size = sizeOverLifeTimeFunc(pStartSize[i], pStartLifeTime[i], pRemainingLifeTime[i]);
+				const Float4 color = colorOverLifeTimeFunc(pStartColor[i], pStartLifeTime[i], pRemainingLifeTime[i]);
 
 				const float size_half = (size * 0.5f);
-				const float cx = particle.position.x;
-				const float cy = particle.position.y;
+				const float cx = pPositionX[i];
+				const float cy = pPositionY[i];
 
 				const float x = size_half;
-				const auto [s, c] = FastMath::SinCos(particle.rotation);
+				const auto [s, c] = FastMath::SinCos(pRotation[i]);
 				const float xc = x * c;
 				const float xs = x * s;
 
@@ -2439,7 +2518,70 @@ namespace s3d
 			{
 				Vertex2D::IndexType indexBase = indexOffset;
 
-				for (Vertex2D::IndexType n = 0; n < particles.size(); ++n)
+				for (size_t n = 0; n < count; ++n)
+				{
+					for (Vertex2D::IndexType i = 0; i < 6; ++i)
+					{
+						*pIndex++ = (indexBase + detail::RectIndexTable[i]);
+					}
+
+					indexBase += 4;
+				}
+			}
+
+			return indexSize;
+		}
+
+		Vertex2D::IndexType BuildTexturedInstances(const BufferCreatorFunc bufferCreator, const SpriteInstance* instances, const size_t count)
+		{
+			assert(count <= MaxTexturedInstances);
+
+			const Vertex2D::IndexType vertexSize = static_cast<Vertex2D::IndexType>(count * 4);
+			const Vertex2D::IndexType indexSize = static_cast<Vertex2D::IndexType>(count * 6);
+			auto [pVertex, pIndex, indexOffset] = bufferCreator(vertexSize, indexSize);
+
+			if (not pVertex)
+			{
+				return 0;
+			}
+
+			for (const SpriteInstance* pInstance = instances; pInstance != (instances + count); ++pInstance)
+			{
+				const SpriteInstance& instance = *pInstance;
+				const float cx = instance.center.x;
+				const float cy = instance.center.y;
+				const float wHalf = (instance.size.x * 0.5f);
+				const float hHalf = (instance.size.y * 0.5f);
+				const FloatRect& uv = instance.uv;
+
+				if (instance.angle == 0.0f)
+				{
+					pVertex[0].set((cx - wHalf), (cy - hHalf), uv.left, uv.top, instance.color);
+					pVertex[1].set((cx + wHalf), (cy - hHalf), uv.right, uv.top, instance.color);
+					pVertex[2].set((cx - wHalf), (cy + hHalf), uv.left, uv.bottom, instance.color);
+					pVertex[3].set((cx + wHalf), (cy + hHalf), uv.right, uv.bottom, instance.color);
+				}
+				else
+				{
+					const auto [s, c] = FastMath::SinCos(instance.angle);
+					const float wc = (wHalf * c);
+					const float ws = (wHalf * s);
+					const float hc = (hHalf * c);
+					const float hs = (hHalf * s);
+
+					pVertex[0].set({ (-wc + hs + cx), (-ws - hc + cy) }, uv.left, uv.top, instance.color);
+					pVertex[1].set({ (wc + hs + cx), (ws - hc + cy) }, uv.right, uv.top, instance.color);
+					pVertex[2].set({ (-wc - hs + cx), (-ws + hc + cy) }, uv.left, uv.bottom, instance.color);
+					pVertex[3].set({ (wc - hs + cx), (ws + hc + cy) }, uv.right, uv.bottom, instance.color);
+				}
+
+				pVertex += 4;
+			}
+
+			{
+				Vertex2D::IndexType indexBase = indexOffset;
+
+				for (size_t n = 0; n < count; ++n)
 				{
 					for (Vertex2D::IndexType i = 0; i < 6; ++i)
 					{
@@ -10,6 +10,8 @@
 //-----------------------------------------------
 
 # pragma once
+# include <memory>
+# include <type_traits>
 # include <Siv3D/Common.hpp>
 # include <Siv3D/Vertex2D.hpp>
 # include <Siv3D/FloatRect.hpp>
@@ -21,125 +23,193 @@
 # include <Siv3D/YesNo.hpp>
 # include <Siv3D/PredefinedYesNo.hpp>
 # include <Siv3D/Particle2D.hpp>
+# include <Siv3D/Particle2D/ParticleStorage2D.hpp>
 # include <Siv3D/ParticleSystem2DParameters.hpp>
+# include <Siv3D/SpriteInstance.hpp>
 # include "Vertex2DBufferPointer.hpp"
 
 namespace s3d
 {
-	using BufferCreatorFunc = std::function<Vertex2DBufferPointer(Vertex2D::IndexType, Vertex2D::IndexType)>;
+	/// @brief 頂点バッファの確保を要求する関数への参照
+	/// @remark std::function と異なり、所有権を持たず、構築時の型消去のコストや空チェックがありません。
+	/// @remark 2 つのポインタだけを持つので、値渡しで使います。
+	class BufferCreatorFunc
+	{
+	public:
+
+		BufferCreatorFunc() = default;
+
+		/// @brief オブジェクトのメンバ関数を呼ぶ BufferCreatorFunc を作成します。
+		/// @tparam MemberFunction Vertex2DBufferPointer(Vertex2D::IndexType, Vertex2D::IndexType) のシグネチャを持つメンバ関数
+		/// @tparam Object オブジェクトの型
+		/// @param object オブジェクト。BufferCreatorFunc より長い寿命を持つ必要があります。
+		/// @return BufferCreatorFunc
+		template <auto MemberFunction, class Object>
+		[[nodiscard]]
+		static constexpr BufferCreatorFunc Bind(Object* object) noexcept
+		{
+			return BufferCreatorFunc{ object,
+				[](void* p, const Vertex2D::IndexType vertexSize, const Vertex2D::IndexType indexSize) -> Vertex2DBufferPointer
+				{
+					return (static_cast<Object*>(p)->*MemberFunction)(vertexSize, indexSize);
+				} };
+		}
+
+		/// @brief 関数オブジェクトを参照する BufferCreatorFunc を作成します。
+		/// @tparam Fty 関数オブジェクトの型
+		/// @param f 関数オブジェクト。BufferCreatorFunc より長い寿命を持つ必要があります。
+		template <class Fty, std::enable_if_t<(not std::is_same_v<std::remove_cv_t<Fty>, BufferCreatorFunc>)
+			&& std::is_invocable_r_v<Vertex2DBufferPointer, Fty&, Vertex2D::IndexType, Vertex2D::IndexType>>* = nullptr>
+		constexpr BufferCreatorFunc(Fty& f) noexcept
+			: m_object{ const_cast<void*>(static_cast<const void*>(std::addressof(f))) }
+			, m_function{ [](void* p, const Vertex2D::IndexType vertexSize, const Vertex2D::IndexType indexSize) -> Vertex2DBufferPointer
+				{
+					return (*static_cast<Fty*>(p))(vertexSize, indexSize);
+				} } {}
+
+		Vertex2DBufferPointer operator ()(const Vertex2D::IndexType vertexSize, const Vertex2D::IndexType indexSize) const
+		{
+			return m_function(m_object, vertexSize, indexSize);
+		}
+
+	private:
+
+		using FunctionType = Vertex2DBufferPointer(*)(void*, Vertex2D::IndexType, Vertex2D::IndexType);
+
+		void* m_object = nullptr;
+
+		FunctionType m_function = nullptr;
+
+		constexpr BufferCreatorFunc(void* object, FunctionType function) noexcept
+			: m_object{ object }
+			, m_function{ function } {}
+	};
 
 	namespace Vertex2DBuilder
 	{
 		[[nodiscard]]
-		Vertex2D::IndexType BuildLine(const LineStyle& style, const BufferCreatorFunc& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float scale);
+		Vertex2D::IndexType BuildLine(const LineStyle& style, BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float scale);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildCappedLine(const BufferCreatorFunc& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2]);
+		Vertex2D::IndexType BuildCappedLine(BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2]);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildUncappedLine(const BufferCreatorFunc& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2]);
+		Vertex2D::IndexType BuildUncappedLine(BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2]);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildUncappedLine(const BufferCreatorFunc& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float& startAngle);
+		Vertex2D::IndexType BuildUncappedLine(BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float& startAngle);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildSquareDotLine(const BufferCreatorFunc& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float dotOffset, float scale);
+		Vertex2D::IndexType BuildSquareDotLine(BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float dotOffset, float scale);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildRoundDotLine(const BufferCreatorFunc& bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float dotOffset, bool hasAlignedDot);
+		Vertex2D::IndexType BuildRoundDotLine(BufferCreatorFunc bufferCreator, const Float2& begin, const Float2& end, float thickness, const Float4(&colors)[2], float dotOffset, bool hasAlignedDot);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildTriangle(const BufferCreatorFunc& bufferCreator, const Float2(&points)[3], const Float4& color);
+		Vertex2D::IndexType BuildTriangle(BufferCreatorFunc bufferCreator, const Float2(&points)[3], const Float4& color);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildTriangle(const BufferCreatorFunc& bufferCreator, const Float2(&points)[3], const Float4(&colors)[3]);
+		Vertex2D::IndexType BuildTriangle(BufferCreatorFunc bufferCreator, const Float2(&points)[3], const Float4(&colors)[3]);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildRect(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, const Float4& color);
+		Vertex2D::IndexType BuildRect(BufferCreatorFunc bufferCreator, const FloatRect& rect, const Float4& color);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildRect(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, const Float4(&colors)[4]);
+		Vertex2D::IndexType BuildRect(BufferCreatorFunc bufferCreator, const FloatRect& rect, const Float4(&colors)[4]);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildRectFrame(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, float thickness, const Float4& innerColor, const Float4& outerColor);
+		Vertex2D::IndexType BuildRectFrame(BufferCreatorFunc bufferCreator, const FloatRect& rect, float thickness, const Float4& innerColor, const Float4& outerColor);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildCircle(const BufferCreatorFunc& bufferCreator, const Float2& center, float r, const Float4& innerColor, const Float4& outerColor, float scale);
+		Vertex2D::IndexType BuildCircle(BufferCreatorFunc bufferCreator, const Float2& center, float r, const Float4& innerColor, const Float4& outerColor, float scale);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildCircleFrame(const BufferCreatorFunc& bufferCreator, const Float2& center, float rInner, float thickness, const Float4& innerColor, const Float4& outerColor, float scale);
+		Vertex2D::IndexType BuildCircleFrame(BufferCreatorFunc bufferCreator, const Float2& center, float rInner, float thickness, const Float4& innerColor, const Float4& outerColor, float scale);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildCirclePie(const BufferCreatorFunc& bufferCreator, const Float2& center, float r, float startAngle, float angle, const Float4& innerColor, const Float4& outerColor, float scale);
+		Vertex2D::IndexType BuildCirclePie(BufferCreatorFunc bufferCreator, const Float2& center, float r, float startAngle, float angle, const Float4& innerColor, const Float4& outerColor, float scale);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildCircleArc(const BufferCreatorFunc& bufferCreator, const LineStyle& style, const Float2& center, float rInner, float startAngle, float angle, float thickness, const Float4& innerColor, const Float4& outerColor, float scale);
+		Vertex2D::IndexType BuildCircleArc(BufferCreatorFunc bufferCreator, const LineStyle& style, const Float2& center, float rInner, float startAngle, float angle, float thickness, const Float4& innerColor, const Float4& outerColor, float scale);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildUncappedCircleArc(const BufferCreatorFunc& bufferCreator, const Float2& center, float rInner, float startAngle, float angle, float thickness, const Float4& innerColor, const Float4& outerColor, float scale);
+		Vertex2D::IndexType BuildUncappedCircleArc(BufferCreatorFunc bufferCreator, const Float2& center, float rInner, float startAngle, float angle, float thickness, const Float4& innerColor, const Float4& outerColor, float scale);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildEllipse(const BufferCreatorFunc& bufferCreator, const Float2& center, float a, float b, const Float4& innerColor, const Float4& outerColor, float scale);
+		Vertex2D::IndexType BuildEllipse(BufferCreatorFunc bufferCreator, const Float2& center, float a, float b, const Float4& innerColor, const Float4& outerColor, float scale);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildEllipseFrame(const BufferCreatorFunc& bufferCreator, const Float2& center, float aInner, float bInner, float thickness, const Float4& innerColor, const Float4& outerColor, float scale);
+		Vertex2D::IndexType BuildEllipseFrame(BufferCreatorFunc bufferCreator, const Float2& center, float aInner, float bInner, float thickness, const Float4& innerColor, const Float4& outerColor, float scale);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildQuad(const BufferCreatorFunc& bufferCreator, const FloatQuad& quad, const Float4 color);
+		Vertex2D::IndexType BuildQuad(BufferCreatorFunc bufferCreator, const FloatQuad& quad, const Float4 color);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildQuad(const BufferCreatorFunc& bufferCreator, const FloatQuad& quad, const Float4(&colors)[4]);
+		Vertex2D::IndexType BuildQuad(BufferCreatorFunc bufferCreator, const FloatQuad& quad, const Float4(&colors)[4]);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildRoundRect(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const FloatRect& rect, float w, float h, float r, const Float4& color, float scale);
+		Vertex2D::IndexType BuildRoundRect(BufferCreatorFunc bufferCreator, Array<Float2>& buffer, const FloatRect& rect, float w, float h, float r, const Float4& color, float scale);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildLineString(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const LineStyle& style, const Vec2* points, size_t size, const Optional<Float2>& offset, float thickness, bool inner, const Float4& color, CloseRing closeRing, float scale);
+		Vertex2D::IndexType BuildLineString(BufferCreatorFunc bufferCreator, Array<Float2>& buffer, const LineStyle& style, const Vec2* points, size_t size, const Optional<Float2>& offset, float thickness, bool inner, const Float4& color, CloseRing closeRing, float scale);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildClosedLineString(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const Vec2* points, size_t size, const Optional<Float2>& offset, float thickness, bool inner, const Float4& color, float scale);
+		Vertex2D::IndexType BuildClosedLineString(BufferCreatorFunc bufferCreator, Array<Float2>& buffer, const Vec2* points, size_t size, const Optional<Float2>& offset, float thickness, bool inner, const Float4& color, float scale);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildCappedLineString(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const Vec2* points, size_t size, const Optional<Float2>& offset, float thickness, bool inner, const Float4& color, float scale);
+		Vertex2D::IndexType BuildCappedLineString(BufferCreatorFunc bufferCreator, Array<Float2>& buffer, const Vec2* points, size_t size, const Optional<Float2>& offset, float thickness, bool inner, const Float4& color, float scale);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildUncappedLineString(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const Vec2* points, size_t size, const Optional<Float2>& offset, float thickness, bool inner, const Float4& color, float scale, float* startAngle0, float* startAngle1);
+		Vertex2D::IndexType BuildUncappedLineString(BufferCreatorFunc bufferCreator, Array<Float2>& buffer, const Vec2* points, size_t size, const Optional<Float2>& offset, float thickness, bool inner, const Float4& color, float scale, float* startAngle0, float* startAngle1);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildDefaultLineString(const BufferCreatorFunc& bufferCreator, const Vec2* points, const ColorF* colors, size_t size, const Optional<Float2>& offset, float thickness, bool inner, CloseRing closeRing, float scale);
+		Vertex2D::IndexType BuildDefaultLineString(BufferCreatorFunc bufferCreator, const Vec2* points, const ColorF* colors, size_t size, const Optional<Float2>& offset, float thickness, bool inner, CloseRing closeRing, float scale);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildPolygon(const BufferCreatorFunc& bufferCreator, const Array<Float2>& vertices, const Array<TriangleIndex>& tirnagleIndices, const Optional<Float2>& offset, const Float4& color);
+		Vertex2D::IndexType BuildPolygon(BufferCreatorFunc bufferCreator, const Array<Float2>& vertices, const Array<TriangleIndex>& tirnagleIndices, const Optional<Float2>& offset, const Float4& color);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildPolygon(const BufferCreatorFunc& bufferCreator, const Vertex2D* vertices, size_t vertexCount, const TriangleIndex* indices, size_t num_triangles);
+		Vertex2D::IndexType BuildPolygon(BufferCreatorFunc bufferCreator, const Vertex2D* vertices, size_t vertexCount, const TriangleIndex* indices, size_t num_triangles);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildPolygonTransformed(const BufferCreatorFunc& bufferCreator, const Array<Float2>& vertices, const Array<TriangleIndex>& tirnagleIndices, float s, float c, const Float2& offset, const Float4& color);
+		Vertex2D::IndexType BuildPolygonTransformed(BufferCreatorFunc bufferCreator, const Array<Float2>& vertices, const Array<TriangleIndex>& tirnagleIndices, float s, float c, const Float2& offset, const Float4& color);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildPolygonFrame(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const Float2* points, size_t size, float thickness, const Float4& color, float scale);
+		Vertex2D::IndexType BuildPolygonFrame(BufferCreatorFunc bufferCreator, Array<Float2>& buffer, const Float2* points, size_t size, float thickness, const Float4& color, float scale);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildTextureRegion(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4& color);
+		Vertex2D::IndexType BuildTextureRegion(BufferCreatorFunc bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4& color);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildTextureRegion(const BufferCreatorFunc& bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4(&colors)[4]);
+		Vertex2D::IndexType BuildTextureRegion(BufferCreatorFunc bufferCreator, const FloatRect& rect, const FloatRect& uv, const Float4(&colors)[4]);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildTexturedCircle(const BufferCreatorFunc& bufferCreator, const Circle& circle, const FloatRect& uv, const Float4& color, float scale);
+		Vertex2D::IndexType BuildTexturedCircle(BufferCreatorFunc bufferCreator, const Circle& circle, const FloatRect& uv, const Float4& color, float scale);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildTexturedQuad(const BufferCreatorFunc& bufferCreator, const FloatQuad& quad, const FloatRect& uv, const Float4& color);
+		Vertex2D::IndexType BuildTexturedQuad(BufferCreatorFunc bufferCreator, const FloatQuad& quad, const FloatRect& uv, const Float4& color);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildTexturedRoundRect(const BufferCreatorFunc& bufferCreator, Array<Float2>& buffer, const FloatRect& rect, float w, float h, float r, const FloatRect& uvRect, const Float4& color, float scale);
+		Vertex2D::IndexType BuildTexturedRoundRect(BufferCreatorFunc bufferCreator, Array<Float2>& buffer, const FloatRect& rect, float w, float h, float r, const FloatRect& uvRect, const Float4& color, float scale);
 
 		[[nodiscard]]
-		Vertex2D::IndexType BuildTexturedVertices(const BufferCreatorFunc& bufferCreator, const Vertex2D* vertices, size_t vertexCount, const TriangleIndex* indices, size_t num_triangles);
+		Vertex2D::IndexType BuildTexturedVertices(BufferCreatorFunc bufferCreator, const Vertex2D* vertices, size_t vertexCount, const TriangleIndex* indices, size_t num_triangles);
+
+		/// @brief BuildTexturedParticles() に一度に渡せるパーティクルの最大数（インデックス数が Vertex2D::IndexType に収まる範囲）
+		inline constexpr size_t MaxTexturedParticles = 8192;
 
+		/// @brief パーティクルの [offset, offset + count) の範囲を、回転した四角形の頂点に展開します。
+		/// @param count パーティクルの個数。MaxTexturedParticles 以下である必要があります。
 		[[nodiscard]]
-		Vertex2D::IndexType BuildTexturedParticles(const BufferCreatorFunc& bufferCreator, const Array<Particle2D>& particles,
+		Vertex2D::IndexType BuildTexturedParticles(BufferCreatorFunc bufferCreator, const ParticleStorage2D& particles, size_t offset, size_t count,
 			const ParticleSystem2DParameters::SizeOverLifeTimeFunc& sizeOverLifeTimeFunc, const ParticleSystem2DParameters::ColorOverLifeTimeFunc& colorOverLifeTimeFunc);
+
+		/// @brief BuildTexturedInstances() に一度に渡せるインスタンスの最大数（インデックス数が Vertex2D::IndexType に収まる範囲）
+		inline constexpr size_t MaxTexturedInstances = 8192;
+
+		/// @brief インスタンス描画をサポートしないレンダラー向けに、各インスタンスを回転した四角形の頂点に展開します。
+		/// @param count インスタンスの個数。MaxTexturedInstances 以下である必要があります。
+		[[nodiscard]]
+		Vertex2D::IndexType BuildTexturedInstances(BufferCreatorFunc bufferCreator, const SpriteInstance* instances, size_t count);
 	}
 }
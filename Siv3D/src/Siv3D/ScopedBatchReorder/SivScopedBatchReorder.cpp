@@ -0,0 +1,36 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include <Siv3D/ScopedBatchReorder.hpp>
+# include <Siv3D/Graphics2D.hpp>
+
+namespace s3d
+{
+	ScopedBatchReorder::ScopedBatchReorder()
+		: m_active{ true }
+	{
+		Graphics2D::Internal::BeginBatchReorder();
+	}
+
+	ScopedBatchReorder::ScopedBatchReorder(ScopedBatchReorder&& other) noexcept
+		: m_active{ other.m_active }
+	{
+		other.m_active = false;
+	}
+
+	ScopedBatchReorder::~ScopedBatchReorder()
+	{
+		if (m_active)
+		{
+			Graphics2D::Internal::EndBatchReorder();
+		}
+	}
+}
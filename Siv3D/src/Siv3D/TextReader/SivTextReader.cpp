@@ -82,6 +82,11 @@ namespace s3d
 		return pImpl->readLine(line);
 	}
 
+	Optional<StringView> TextReader::readLineView()
+	{
+		return pImpl->readLineView();
+	}
+
 	bool TextReader::readLines(Array<String>& lines)
 	{
 		return pImpl->readLines(lines);
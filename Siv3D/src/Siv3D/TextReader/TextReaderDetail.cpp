@@ -9,15 +9,120 @@
 //
 //-----------------------------------------------
 
+# include <bit>
+# include <cstring>
+# include <algorithm>
 # include "TextReaderDetail.hpp"
 # include <Siv3D/BinaryReader.hpp>
 # include <Siv3D/FileSystem.hpp>
 # include <Siv3D/Endian.hpp>
 # include <Siv3D/Unicode.hpp>
 # include <Siv3D/UnicodeConverter.hpp>
+# include <Siv3D/SIMD.hpp>
+# include <Siv3D/Unicode/UnicodeUtility.hpp>
 
 namespace s3d
 {
+	namespace detail
+	{
+		/// @brief IReader から一度に読み込むバイト数
+		inline constexpr size_t TextReaderBufferSize = (64 * 1024);
+
+		[[nodiscard]]
+		inline constexpr bool IsUTF16(const TextEncoding encoding) noexcept
+		{
+			return ((encoding == TextEncoding::UTF16LE)
+				|| (encoding == TextEncoding::UTF16BE));
+		}
+
+		/// @brief [first, last) から最初の '\n' または '\0' を探します。
+		/// @return 見つかった位置。見つからなかった場合は last
+		[[nodiscard]]
+		static const char8* FindLineEnd(const char8* first, const char8* const last) noexcept
+		{
+		# if SIV3D_INTRINSIC(SSE)
+
+			const __m128i newLine = ::_mm_set1_epi8('\n');
+			const __m128i zero = ::_mm_setzero_si128();
+
+			while (16 <= (last - first))
+			{
+				const __m128i v = ::_mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+				const __m128i match = ::_mm_or_si128(::_mm_cmpeq_epi8(v, newLine), ::_mm_cmpeq_epi8(v, zero));
+
+				if (const uint32 mask = static_cast<uint32>(::_mm_movemask_epi8(match)))
+				{
+					return (first + std::countr_zero(mask));
+				}
+
+				first += 16;
+			}
+
+		# endif
+
+			for (; first != last; ++first)
+			{
+				if ((*first == '\n') || (*first == '\0'))
+				{
+					return first;
+				}
+			}
+
+			return last;
+		}
+
+		/// @brief [first, last) のうち、末尾で途切れている UTF-8 のシーケンスを除いたバイト数を返します。
+		[[nodiscard]]
+		static size_t CompleteUTF8Size(const char8* first, const char8* const last) noexcept
+		{
+			const size_t size = (last - first);
+
+			for (size_t i = 1; i <= Min<size_t>(size, 4); ++i)
+			{
+				const uint8 c = static_cast<uint8>(last[-static_cast<ptrdiff_t>(i)]);
+
+				if ((c & 0xC0) == 0x80)
+				{
+					continue;
+				}
+
+				const size_t sequenceLength = ((c < 0xC0) ? 1 : (c < 0xE0) ? 2 : (c < 0xF0) ? 3 : 4);
+
+				return ((i < sequenceLength) ? (size - i) : size);
+			}
+
+			return size;
+		}
+
+		/// @brief UTF-8 のバイト列を UTF-32 に変換して s の末尾に追加し、'\r' を取り除きます。
+		static void AppendUTF8(String& s, const std::string_view bytes)
+		{
+			if (bytes.empty())
+			{
+				return;
+			}
+
+			const size_t offset = s.size();
+
+			if (size_t length = 0;
+				UTF8_Validate(bytes, length))
+			{
+				s.resize(offset + length);
+
+				UTF8_DecodeValid((s.data() + offset), bytes);
+			}
+			else
+			{
+				s.append(Unicode::FromUTF8(bytes));
+			}
+
+			if (std::memchr(bytes.data(), '\r', bytes.size()))
+			{
+				s.erase(std::remove((s.begin() + offset), s.end(), U'\r'), s.end());
+			}
+		}
+	}
+
 	TextReader::TextReaderDetail::TextReaderDetail()
 	{
 		// do nothing
@@ -103,6 +208,8 @@ namespace s3d
 		m_reader.reset();
 
 		m_info = {};
+
+		resetBuffer();
 	}
 
 	bool TextReader::TextReaderDetail::isOpen() const noexcept
@@ -139,101 +246,32 @@ namespace s3d
 
 	Optional<String> TextReader::TextReaderDetail::readLine()
 	{
-		if (not m_info.isOpen) SIV3D_UNLIKELY
-		{
-			return none;
-		}
-
 		String line;
 
-		for (;;)
+		if (readLine(line))
 		{
-			char32 codePoint;
-
-			if (not readCodePoint(codePoint))
-			{
-				if (line)
-				{
-					return line;
-				}
-
-				return none;
-			}
-
-			if ((codePoint == U'\n') || (codePoint == U'\0'))
-			{
-				return line;
-			}
-			else if (codePoint != U'\r')
-			{
-				line.push_back(codePoint);
-			}
+			return line;
 		}
+
+		return none;
 	}
 
 	Array<String> TextReader::TextReaderDetail::readLines()
 	{
-		if (not m_info.isOpen) SIV3D_UNLIKELY
-		{
-			return{};
-		}
-
 		Array<String> lines;
-		String line;
 
-		for (;;)
-		{
-			char32 codePoint;
+		readLines(lines);
 
-			if (not readCodePoint(codePoint))
-			{
-				if (line)
-				{
-					lines.push_back(std::move(line));
-				}
-
-				return lines;
-			}
-
-			if ((codePoint == U'\n') || (codePoint == U'\0'))
-			{
-				lines.push_back(line);
-				line.clear();
-			}
-			else if (codePoint != U'\r')
-			{
-				line.push_back(codePoint);
-			}
-		}
+		return lines;
 	}
 
 	String TextReader::TextReaderDetail::readAll()
 	{
-		if (not m_info.isOpen) SIV3D_UNLIKELY
-		{
-			return{};
-		}
-
 		String s;
 
-		for (;;)
-		{
-			char32 codePoint;
-
-			if (not readCodePoint(codePoint))
-			{
-				return s;
-			}
+		readAll(s);
 
-			if (codePoint == U'\0')
-			{
-				return s;
-			}
-			else if (codePoint != U'\r')
-			{
-				s.push_back(codePoint);
-			}
-		}
+		return s;
 	}
 
 	bool TextReader::TextReaderDetail::readChar(char32& ch)
@@ -275,6 +313,11 @@ namespace s3d
 			return false;
 		}
 
+		if (not detail::IsUTF16(m_info.encoding))
+		{
+			return readLineUTF8(line);
+		}
+
 		for (;;)
 		{
 			char32 codePoint;
@@ -300,6 +343,16 @@ namespace s3d
 		}
 	}
 
+	Optional<StringView> TextReader::TextReaderDetail::readLineView()
+	{
+		if (readLine(m_lineView))
+		{
+			return StringView{ m_lineView };
+		}
+
+		return none;
+	}
+
 	bool TextReader::TextReaderDetail::readLines(Array<String>& lines)
 	{
 		lines.clear();
@@ -311,35 +364,17 @@ namespace s3d
 
 		String line;
 
-		for (;;)
+		while (readLine(line))
 		{
-			char32 codePoint;
-
-			if (not readCodePoint(codePoint))
-			{
-				if (line)
-				{
-					lines.push_back(std::move(line));
-				}
-
-				if (not lines)
-				{
-					return false;
-				}
-
-				return true;
-			}
+			lines.push_back(line);
+		}
 
-			if ((codePoint == U'\n') || (codePoint == U'\0'))
-			{
-				lines.push_back(line);
-				line.clear();
-			}
-			else if (codePoint != U'\r')
-			{
-				line.push_back(codePoint);
-			}
+		if (not lines)
+		{
+			return false;
 		}
+
+		return true;
 	}
 
 	bool TextReader::TextReaderDetail::readAll(String& s)
@@ -351,6 +386,16 @@ namespace s3d
 			return false;
 		}
 
+		if (not detail::IsUTF16(m_info.encoding))
+		{
+			if (readAllUTF8(s))
+			{
+				return true;
+			}
+
+			return (not s.isEmpty());
+		}
+
 		for (;;)
 		{
 			char32 codePoint;
@@ -386,14 +431,131 @@ namespace s3d
 		return m_info.fullPath;
 	}
 
+	void TextReader::TextReaderDetail::resetBuffer()
+	{
+		m_buffer.clear();
+		m_buffer.shrink_to_fit();
+		m_bufferBegin = 0;
+		m_bufferEnd = 0;
+		m_lineView.clear();
+	}
+
+	bool TextReader::TextReaderDetail::fillBuffer()
+	{
+		// 未読のバイト列をバッファの先頭に詰める
+		if (m_bufferBegin != 0)
+		{
+			std::memmove(m_buffer.data(), (m_buffer.data() + m_bufferBegin), (m_bufferEnd - m_bufferBegin));
+			m_bufferEnd -= m_bufferBegin;
+			m_bufferBegin = 0;
+		}
+
+		// 1 行がバッファより長い場合は拡張する
+		if (m_bufferEnd == m_buffer.size())
+		{
+			m_buffer.resize(Max(detail::TextReaderBufferSize, (m_buffer.size() * 2)));
+		}
+
+		const int64 readSize = m_reader->read((m_buffer.data() + m_bufferEnd), static_cast<int64>(m_buffer.size() - m_bufferEnd));
+
+		if (readSize <= 0)
+		{
+			return false;
+		}
+
+		m_bufferEnd += static_cast<size_t>(readSize);
+
+		return true;
+	}
+
+	bool TextReader::TextReaderDetail::readLineUTF8(String& line)
+	{
+		// 未読のバイト列のうち、改行を含まないことを確認済みのバイト数
+		size_t scannedSize = 0;
+
+		for (;;)
+		{
+			const char8* const first = (m_buffer.data() + m_bufferBegin);
+			const char8* const last = (m_buffer.data() + m_bufferEnd);
+			const char8* const lineEnd = detail::FindLineEnd((first + scannedSize), last);
+
+			if (lineEnd != last)
+			{
+				detail::AppendUTF8(line, std::string_view(first, (lineEnd - first)));
+				m_bufferBegin += ((lineEnd - first) + 1);
+				return true;
+			}
+
+			scannedSize = (last - first);
+
+			if (not fillBuffer())
+			{
+				detail::AppendUTF8(line, std::string_view((m_buffer.data() + m_bufferBegin), (m_bufferEnd - m_bufferBegin)));
+				m_bufferBegin = m_bufferEnd;
+				return (not line.isEmpty());
+			}
+		}
+	}
+
+	bool TextReader::TextReaderDetail::readAllUTF8(String& s)
+	{
+		for (;;)
+		{
+			const char8* const first = (m_buffer.data() + m_bufferBegin);
+			const char8* const last = (m_buffer.data() + m_bufferEnd);
+
+			if (first != last)
+			{
+				if (const void* p = std::memchr(first, '\0', (last - first)))
+				{
+					const size_t size = (static_cast<const char8*>(p) - first);
+					detail::AppendUTF8(s, std::string_view(first, size));
+					m_bufferBegin += (size + 1);
+					return true;
+				}
+
+				// 途切れている UTF-8 のシーケンスは次の読み込みに回す
+				const size_t size = detail::CompleteUTF8Size(first, last);
+				detail::AppendUTF8(s, std::string_view(first, size));
+				m_bufferBegin += size;
+			}
+
+			if (not fillBuffer())
+			{
+				detail::AppendUTF8(s, std::string_view((m_buffer.data() + m_bufferBegin), (m_bufferEnd - m_bufferBegin)));
+				m_bufferBegin = m_bufferEnd;
+				return false;
+			}
+		}
+	}
+
 	bool TextReader::TextReaderDetail::readByte(uint8& c)
 	{
-		return m_reader->read(c);
+		if ((m_bufferBegin == m_bufferEnd)
+			&& (not fillBuffer()))
+		{
+			return false;
+		}
+
+		c = static_cast<uint8>(m_buffer[m_bufferBegin++]);
+
+		return true;
 	}
 
 	bool TextReader::TextReaderDetail::readTwoBytes(uint16& c)
 	{
-		return m_reader->read(c);
+		while ((m_bufferEnd - m_bufferBegin) < sizeof(uint16))
+		{
+			if (not fillBuffer())
+			{
+				return false;
+			}
+		}
+
+		std::memcpy(&c, (m_buffer.data() + m_bufferBegin), sizeof(uint16));
+		m_bufferBegin += sizeof(uint16);
+
+		return true;
 	}
 
 	bool TextReader::TextReaderDetail::readUTF8(char32& c)
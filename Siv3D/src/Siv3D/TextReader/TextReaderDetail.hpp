@@ -11,6 +11,8 @@
 
 # pragma once
 # include <Siv3D/TextReader.hpp>
+# include <Siv3D/Array.hpp>
+# include <Siv3D/String.hpp>
 
 namespace s3d
 {
@@ -27,6 +29,27 @@ namespace s3d
 			bool isOpen = false;
 		} m_info;
 
+		// IReader からまとめて読み込んだバイト列。[m_bufferBegin, m_bufferEnd) が未読
+		Array<char8> m_buffer;
+
+		size_t m_bufferBegin = 0;
+
+		size_t m_bufferEnd = 0;
+
+		// readLineView() が返す文字列の実体
+		String m_lineView;
+
+		void resetBuffer();
+
+		[[nodiscard]]
+		bool fillBuffer();
+
+		[[nodiscard]]
+		bool readLineUTF8(String& line);
+
+		[[nodiscard]]
+		bool readAllUTF8(String& s);
+
 		[[nodiscard]]
 		bool readByte(uint8& c);
 
@@ -80,6 +103,9 @@ namespace s3d
 		[[nodiscard]]
 		bool readLine(String& line);
 
+		[[nodiscard]]
+		Optional<StringView> readLineView();
+
 		bool readLines(Array<String>& lines);
 
 		bool readAll(String& s);
@@ -15,6 +15,25 @@
 
 namespace s3d
 {
+	/// @brief 別スレッドからのテクスチャ作成要求の統計
+	struct AsyncTextureLoadStat
+	{
+		/// @brief 待機中またはアップロード中の要求の数
+		uint32 queueDepth = 0;
+
+		/// @brief 直近の updateAsyncTextureLoad() で完了した要求の数
+		uint32 completedLastUpdate = 0;
+
+		/// @brief 直近の updateAsyncTextureLoad() で完了した要求の、要求から完了までの最大時間（マイクロ秒）
+		uint64 maxLatencyMicrosec = 0;
+
+		/// @brief これまでに完了した要求の数
+		uint64 totalCompleted = 0;
+
+		/// @brief これまでに完了した要求の、要求から完了までの平均時間（マイクロ秒）
+		uint64 averageLatencyMicrosec = 0;
+	};
+
 	class SIV3D_NOVTABLE ISiv3DTexture
 	{
 	public:
@@ -23,7 +42,15 @@ namespace s3d
 
 		virtual ~ISiv3DTexture() = default;
 
-		virtual void updateAsyncTextureLoad(size_t maxUpdate) = 0;
+		/// @brief 別スレッドからのテクスチャ作成要求を処理します。
+		/// @param budgetMicrosec このフレームで処理に使う時間の目安（マイクロ秒）
+		virtual void updateAsyncTextureLoad(uint64 budgetMicrosec) = 0;
+
+		/// @brief 未処理のテクスチャ作成要求をすべて取り消し、要求したスレッドに空のテクスチャを返します。
+		virtual void cancelAsyncTextureLoad() = 0;
+
+		[[nodiscard]]
+		virtual AsyncTextureLoadStat getAsyncTextureLoadStat() const = 0;
 
 		virtual size_t getTextureCount() const = 0;
 
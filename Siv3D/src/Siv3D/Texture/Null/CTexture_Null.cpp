@@ -25,11 +25,21 @@ namespace s3d
 		LOG_SCOPED_TRACE(U"CTexture_Null::~CTexture_Null()");
 	}
 
-	void CTexture_Null::updateAsyncTextureLoad(const size_t)
+	void CTexture_Null::updateAsyncTextureLoad(const uint64)
 	{
 		// do nothing
 	}
 
+	void CTexture_Null::cancelAsyncTextureLoad()
+	{
+		// do nothing
+	}
+
+	AsyncTextureLoadStat CTexture_Null::getAsyncTextureLoadStat() const
+	{
+		return{};
+	}
+
 	size_t CTexture_Null::getTextureCount() const
 	{
 		return 0;
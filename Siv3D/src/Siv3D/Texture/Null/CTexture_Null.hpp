@@ -25,7 +25,11 @@ namespace s3d
 
 		~CTexture_Null() override;
 
-		void updateAsyncTextureLoad(size_t maxUpdate) override;
+		void updateAsyncTextureLoad(uint64 budgetMicrosec) override;
+
+		void cancelAsyncTextureLoad() override;
+
+		AsyncTextureLoadStat getAsyncTextureLoadStat() const override;
 
 		size_t getTextureCount() const override;
 
@@ -56,7 +56,7 @@ namespace s3d
 	Texture::Texture(const Image& image, const TextureDesc desc)
 		: AssetHandle{ std::make_shared<AssetIDWrapperType>(
 			detail::IsMipped(desc) ?
-				SIV3D_ENGINE(Texture)->createMipped(image, ImageProcessing::GenerateMips(image), desc) :
+				SIV3D_ENGINE(Texture)->createMipped(image, ImageProcessing::GenerateMips(image, detail::IsSRGB(desc)), desc) :
 				SIV3D_ENGINE(Texture)->createUnmipped(image, desc)) }
 	{
 		SIV3D_ENGINE(AssetMonitor)->created();
@@ -388,6 +388,16 @@ namespace s3d
 		return drawAtClipped(pos.x, pos.y, clipRect, diffuse);
 	}
 
+	void Texture::drawInstanced(const Array<SpriteInstance>& instances) const
+	{
+		if (not instances)
+		{
+			return;
+		}
+
+		SIV3D_ENGINE(Renderer2D)->addTexturedInstances(*this, instances.data(), instances.size());
+	}
+
 	TextureRegion Texture::operator ()(const double x, const double y, const double w, const double h) const
 	{
 		const Size size = SIV3D_ENGINE(Texture)->getSize(m_handle->id());
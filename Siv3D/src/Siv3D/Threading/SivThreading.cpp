@@ -10,11 +10,324 @@
 //-----------------------------------------------
 
 # include <thread>
+# include <mutex>
+# include <condition_variable>
+# include <atomic>
+# include <deque>
+# include <memory>
+# include <exception>
 # include <Siv3D/Threading.hpp>
+# include <Siv3D/Array.hpp>
 # include <Siv3D/Utility.hpp>
 
 namespace s3d
 {
+	namespace detail
+	{
+		////////////////////////////////////////////////////////////////
+		//
+		//	ThreadPool
+		//
+		//	各ワーカースレッドがタスクの両端キューを持ち、
+		//	自分のキューは末尾から (LIFO)、他のスレッドのキューは先頭から (FIFO) 取り出す。
+		//	ワーカースレッド以外から投入されたタスクは共有キューに入る。
+		//
+		class ThreadPool
+		{
+		public:
+
+			explicit ThreadPool(const size_t numWorkers)
+			{
+				for (size_t i = 0; i < numWorkers; ++i)
+				{
+					m_localQueues.push_back(std::make_unique<WorkQueue>());
+				}
+
+				for (size_t i = 0; i < numWorkers; ++i)
+				{
+					m_threads.emplace_back(&ThreadPool::workerMain, this, i);
+				}
+			}
+
+			~ThreadPool()
+			{
+				{
+					std::lock_guard lock{ m_sleepMutex };
+					m_abort = true;
+				}
+
+				m_sleepCondition.notify_all();
+
+				for (auto& thread : m_threads)
+				{
+					thread.join();
+				}
+			}
+
+			[[nodiscard]]
+			size_t num_workers() const noexcept
+			{
+				return m_threads.size();
+			}
+
+			[[nodiscard]]
+			bool isWorkerThread() const noexcept
+			{
+				return (t_currentPool == this);
+			}
+
+			void post(std::function<void()> task)
+			{
+				if (m_threads.empty())
+				{
+					task();
+					return;
+				}
+
+				{
+					std::lock_guard lock{ m_sleepMutex };
+					++m_pendingCount;
+				}
+
+				{
+					WorkQueue& queue = (isWorkerThread() ? *m_localQueues[t_workerIndex] : m_globalQueue);
+					std::lock_guard lock{ queue.mutex };
+					queue.tasks.push_back(std::move(task));
+				}
+
+				m_sleepCondition.notify_one();
+			}
+
+			/// @brief 待機中のタスクを 1 つ取り出して実行します。
+			/// @return タスクを実行した場合 true, 実行できるタスクが無かった場合 false
+			bool tryRunPendingTask()
+			{
+				std::function<void()> task;
+
+				if (not popTask((isWorkerThread() ? t_workerIndex : 0), task))
+				{
+					return false;
+				}
+
+				runTask(task);
+
+				return true;
+			}
+
+		private:
+
+			struct WorkQueue
+			{
+				std::mutex mutex;
+
+				std::deque<std::function<void()>> tasks;
+			};
+
+			Array<std::unique_ptr<WorkQueue>> m_localQueues;
+
+			WorkQueue m_globalQueue;
+
+			Array<std::thread> m_threads;
+
+			std::mutex m_sleepMutex;
+
+			std::condition_variable m_sleepCondition;
+
+			std::atomic<size_t> m_pendingCount = 0;
+
+			bool m_abort = false;
+
+			inline static thread_local const ThreadPool* t_currentPool = nullptr;
+
+			inline static thread_local size_t t_workerIndex = 0;
+
+			static bool PopBack(WorkQueue& queue, std::function<void()>& task)
+			{
+				std::lock_guard lock{ queue.mutex };
+
+				if (queue.tasks.empty())
+				{
+					return false;
+				}
+
+				task = std::move(queue.tasks.back());
+				queue.tasks.pop_back();
+				return true;
+			}
+
+			static bool PopFront(WorkQueue& queue, std::function<void()>& task)
+			{
+				std::lock_guard lock{ queue.mutex };
+
+				if (queue.tasks.empty())
+				{
+					return false;
+				}
+
+				task = std::move(queue.tasks.front());
+				queue.tasks.pop_front();
+				return true;
+			}
+
+			bool popTask(const size_t workerIndex, std::function<void()>& task)
+			{
+				if (m_pendingCount.load(std::memory_order_acquire) == 0)
+				{
+					return false;
+				}
+
+				const bool found = [&]()
+				{
+					if (isWorkerThread() && PopBack(*m_localQueues[workerIndex], task))
+					{
+						return true;
+					}
+
+					if (PopFront(m_globalQueue, task))
+					{
+						return true;
+					}
+
+					// 他のワーカースレッドのキューから盗む
+					const size_t numQueues = m_localQueues.size();
+
+					for (size_t i = 1; i <= numQueues; ++i)
+					{
+						if (PopFront(*m_localQueues[(workerIndex + i) % numQueues], task))
+						{
+							return true;
+						}
+					}
+
+					return false;
+				}();
+
+				if (found)
+				{
+					--m_pendingCount;
+				}
+
+				return found;
+			}
+
+			static void runTask(std::function<void()>& task)
+			{
+				try
+				{
+					task();
+				}
+				catch (...)
+				{
+					// Submit() と ParallelFor() は例外を自身で捕捉して呼び出し元に伝える。
+					// それ以外の例外でワーカースレッドを終了させない。
+				}
+
+				task = nullptr;
+			}
+
+			void workerMain(const size_t workerIndex)
+			{
+				t_currentPool = this;
+				t_workerIndex = workerIndex;
+
+				std::function<void()> task;
+
+				for (;;)
+				{
+					if (popTask(workerIndex, task))
+					{
+						runTask(task);
+						continue;
+					}
+
+					std::unique_lock lock{ m_sleepMutex };
+
+					m_sleepCondition.wait(lock, [this]() { return (m_abort || (0 < m_pendingCount)); });
+
+					if (m_abort && (m_pendingCount == 0))
+					{
+						return;
+					}
+				}
+			}
+		};
+
+		[[nodiscard]]
+		static ThreadPool& GetThreadPool()
+		{
+			static ThreadPool pool{ (Threading::GetConcurrency() - 1) };
+			return pool;
+		}
+
+		struct ParallelForJob
+		{
+			const std::function<void(size_t, size_t)>* function = nullptr;
+
+			size_t count = 0;
+
+			size_t grainSize = 1;
+
+			size_t numBlocks = 0;
+
+			std::atomic<size_t> nextBlock = 0;
+
+			std::atomic<size_t> completedBlocks = 0;
+
+			std::mutex mutex;
+
+			std::condition_variable condition;
+
+			std::exception_ptr exception;
+
+			[[nodiscard]]
+			bool isDone() const noexcept
+			{
+				return (completedBlocks.load(std::memory_order_acquire) == numBlocks);
+			}
+
+			void run()
+			{
+				for (;;)
+				{
+					const size_t block = nextBlock.fetch_add(1);
+
+					if (numBlocks <= block)
+					{
+						return;
+					}
+
+					const size_t first = (block * grainSize);
+					const size_t last = Min((first + grainSize), count);
+
+					try
+					{
+						(*function)(first, last);
+					}
+					catch (...)
+					{
+						std::lock_guard lock{ mutex };
+
+						if (not exception)
+						{
+							exception = std::current_exception();
+						}
+					}
+
+					if ((completedBlocks.fetch_add(1, std::memory_order_acq_rel) + 1) == numBlocks)
+					{
+						std::lock_guard lock{ mutex };
+						condition.notify_all();
+					}
+				}
+			}
+		};
+
+		void PostTask_impl(std::function<void()> task)
+		{
+			GetThreadPool().post(std::move(task));
+		}
+	}
+
 	namespace Threading
 	{
 		size_t GetConcurrency() noexcept
@@ -22,5 +335,71 @@ namespace s3d
 			static const size_t n = Max<size_t>(1, std::thread::hardware_concurrency());
 			return n;
 		}
+
+		size_t GetWorkerCount() noexcept
+		{
+			return detail::GetThreadPool().num_workers();
+		}
+
+		bool IsWorkerThread() noexcept
+		{
+			return detail::GetThreadPool().isWorkerThread();
+		}
+
+		void ParallelFor(const size_t count, const std::function<void(size_t, size_t)>& f, size_t grainSize)
+		{
+			if (count == 0)
+			{
+				return;
+			}
+
+			detail::ThreadPool& pool = detail::GetThreadPool();
+			const size_t numWorkers = pool.num_workers();
+
+			if (grainSize == 0)
+			{
+				// 負荷の偏りを吸収できるよう、スレッド数の 4 倍程度のブロックに分割する
+				grainSize = Max<size_t>(1, (count / ((numWorkers + 1) * 4)));
+			}
+
+			const size_t numBlocks = ((count + (grainSize - 1)) / grainSize);
+
+			if ((numWorkers == 0) || (numBlocks <= 1))
+			{
+				f(0, count);
+				return;
+			}
+
+			auto job = std::make_shared<detail::ParallelForJob>();
+			job->function	= &f;
+			job->count		= count;
+			job->grainSize	= grainSize;
+			job->numBlocks	= numBlocks;
+
+			// 呼び出し元のスレッドも参加するので、ワーカーへの依頼は (ブロック数 - 1) 個まで
+			for (size_t i = 0; i < Min(numWorkers, (numBlocks - 1)); ++i)
+			{
+				pool.post([job]() { job->run(); });
+			}
+
+			job->run();
+
+			// 他のスレッドが処理中のブロックの完了を、待機中のタスクを手伝いながら待つ
+			while (not job->isDone())
+			{
+				if (pool.tryRunPendingTask())
+				{
+					continue;
+				}
+
+				std::unique_lock lock{ job->mutex };
+				job->condition.wait_for(lock, std::chrono::microseconds{ 500 }, [&]() { return job->isDone(); });
+			}
+
+			if (job->exception)
+			{
+				std::rethrow_exception(job->exception);
+			}
+		}
 	}
 }
@@ -25,6 +25,17 @@ namespace s3d
 
 		String FromUTF8(const std::string_view s)
 		{
+			if (size_t length = 0;
+				detail::UTF8_Validate(s, length))
+			{
+				String result(length, '0');
+
+				detail::UTF8_DecodeValid(&result[0], s);
+
+				return result;
+			}
+
+			// 不正なバイト列を含む場合は、1 バイトずつ U+FFFD に置き換える
 			String result(detail::UTF32_Length(s), '0');
 
 			const char8* pSrc = s.data();
@@ -84,14 +95,7 @@ namespace s3d
 		{
 			std::string result(detail::UTF8_Length(s), '0');
 
-			const char32* pSrc = s.data();
-			const char32* const pSrcEnd = pSrc + s.size();
-			char8* pDst = &result[0];
-
-			while (pSrc != pSrcEnd)
-			{
-				detail::UTF8_Encode(&pDst, *pSrc++);
-			}
+			detail::UTF8_Encode(&result[0], s);
 
 			return result;
 		}
@@ -139,6 +143,17 @@ namespace s3d
 
 		std::u32string UTF8ToUTF32(const std::string_view s)
 		{
+			if (size_t length = 0;
+				detail::UTF8_Validate(s, length))
+			{
+				std::u32string result(length, '0');
+
+				detail::UTF8_DecodeValid(&result[0], s);
+
+				return result;
+			}
+
+			// 不正なバイト列を含む場合は、1 バイトずつ U+FFFD に置き換える
 			std::u32string result(detail::UTF32_Length(s), '0');
 
 			const char8* pSrc = s.data();
@@ -201,14 +216,7 @@ namespace s3d
 		{
 			std::string result(detail::UTF8_Length(s), '0');
 
-			const char32* pSrc = s.data();
-			const char32* const pSrcEnd = pSrc + s.size();
-			char8* pDst = &result[0];
-
-			while (pSrc != pSrcEnd)
-			{
-				detail::UTF8_Encode(&pDst, *pSrc++);
-			}
+			detail::UTF8_Encode(&result[0], s);
 
 			return result;
 		}
@@ -9,6 +9,8 @@
 //
 //-----------------------------------------------
 
+# include <array>
+# include <Siv3D/SIMD.hpp>
 # include "UnicodeUtility.hpp"
 # include <ThirdParty/miniutf/miniutf.hpp>
 
@@ -16,6 +18,244 @@ namespace s3d
 {
 	namespace detail
 	{
+	# if SIV3D_INTRINSIC(SSE)
+
+		using ShuffleTable16 = std::array<std::array<uint8, 16>, 16>;
+
+		using ShuffleTable256 = std::array<std::array<uint8, 16>, 256>;
+
+		// 4 つの 32-bit 値のうち、マスクのビットが立っているものを前に詰めるシャッフル
+		[[nodiscard]]
+		static constexpr ShuffleTable16 MakeLeftPackTable() noexcept
+		{
+			ShuffleTable16 table{};
+
+			for (size_t mask = 0; mask < table.size(); ++mask)
+			{
+				table[mask].fill(0x80);
+
+				size_t n = 0;
+
+				for (uint8 lane = 0; lane < 4; ++lane)
+				{
+					if (mask & (1 << lane))
+					{
+						for (uint8 i = 0; i < 4; ++i)
+						{
+							table[mask][n++] = static_cast<uint8>(lane * 4 + i);
+						}
+					}
+				}
+			}
+
+			return table;
+		}
+
+		// 4 つの 32-bit 値から、それぞれ先頭の (長さ) バイトを前に詰めるシャッフル
+		// 添字は各レーンの (UTF-8 の長さ - 1) を 2 ビットずつ並べたもの
+		[[nodiscard]]
+		static constexpr ShuffleTable256 MakeUTF8PackTable() noexcept
+		{
+			ShuffleTable256 table{};
+
+			for (size_t index = 0; index < table.size(); ++index)
+			{
+				table[index].fill(0x80);
+
+				size_t n = 0;
+
+				for (uint8 lane = 0; lane < 4; ++lane)
+				{
+					const size_t length = (((index >> (lane * 2)) & 0b11) + 1);
+
+					for (uint8 i = 0; i < length; ++i)
+					{
+						table[index][n++] = static_cast<uint8>(lane * 4 + i);
+					}
+				}
+			}
+
+			return table;
+		}
+
+		alignas(16) static constexpr ShuffleTable16 LeftPackTable = MakeLeftPackTable();
+
+		// 4 ビット値の立っているビットの数
+		// （POPCNT 命令を前提にしないため、表を引く）
+		static constexpr std::array<uint8, 16> PopCount4 = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+		alignas(16) static constexpr ShuffleTable256 UTF8PackTable = MakeUTF8PackTable();
+
+		[[nodiscard]]
+		inline __m128i GreaterEqualU8(const __m128i v, const uint8 value) noexcept
+		{
+			return ::_mm_cmpeq_epi8(::_mm_max_epu8(v, ::_mm_set1_epi8(static_cast<char>(value))), v);
+		}
+
+		[[nodiscard]]
+		inline __m128i ShiftRight4U8(const __m128i v) noexcept
+		{
+			return ::_mm_and_si128(::_mm_srli_epi16(v, 4), ::_mm_set1_epi8(0x0F));
+		}
+
+		// 4 ビット値による 16 エントリの表引き
+		[[nodiscard]]
+		inline __m128i Lookup16(const __m128i indices,
+			const uint8 e0, const uint8 e1, const uint8 e2, const uint8 e3, const uint8 e4, const uint8 e5, const uint8 e6, const uint8 e7,
+			const uint8 e8, const uint8 e9, const uint8 e10, const uint8 e11, const uint8 e12, const uint8 e13, const uint8 e14, const uint8 e15) noexcept
+		{
+			const __m128i table = ::_mm_setr_epi8(
+				static_cast<char>(e0), static_cast<char>(e1), static_cast<char>(e2), static_cast<char>(e3),
+				static_cast<char>(e4), static_cast<char>(e5), static_cast<char>(e6), static_cast<char>(e7),
+				static_cast<char>(e8), static_cast<char>(e9), static_cast<char>(e10), static_cast<char>(e11),
+				static_cast<char>(e12), static_cast<char>(e13), static_cast<char>(e14), static_cast<char>(e15));
+
+			return ::_mm_shuffle_epi8(table, indices);
+		}
+
+		//	UTF-8 の検証
+		//
+		//	J. Keiser, D. Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte" (2021)
+		//	の表引きによる方法。各バイトとその直前のバイトの上位・下位 4 ビットから、起こりうるエラーの集合を求めて積をとる。
+		//	miniutf と同じ結果にするため、サロゲートのコードポイントを表すバイト列は正しいものとして扱う。
+		//
+		[[nodiscard]]
+		inline __m128i CheckSpecialCases(const __m128i input, const __m128i prev1) noexcept
+		{
+			constexpr uint8 TooShort		= (1 << 0);
+			constexpr uint8 TooLong			= (1 << 1);
+			constexpr uint8 Overlong3		= (1 << 2);
+			constexpr uint8 TooLarge		= (1 << 3);
+			constexpr uint8 Overlong2		= (1 << 5);
+			constexpr uint8 TooLarge1000	= (1 << 6);
+			constexpr uint8 Overlong4		= (1 << 6);
+			constexpr uint8 TwoConts		= (1 << 7);
+			constexpr uint8 Carry			= (TooShort | TooLong | TwoConts);
+
+			const __m128i byte1High = Lookup16(ShiftRight4U8(prev1),
+				// 0_______
+				TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong,
+				// 10______
+				TwoConts, TwoConts, TwoConts, TwoConts,
+				// 1100____
+				(TooShort | Overlong2),
+				// 1101____
+				TooShort,
+				// 1110____
+				(TooShort | Overlong3),
+				// 1111____
+				(TooShort | TooLarge | TooLarge1000 | Overlong4));
+
+			const __m128i byte1Low = Lookup16(::_mm_and_si128(prev1, ::_mm_set1_epi8(0x0F)),
+				// ____0000
+				(Carry | Overlong3 | Overlong2 | Overlong4),
+				// ____0001
+				(Carry | Overlong2),
+				// ____001_
+				Carry, Carry,
+				// ____0100
+				(Carry | TooLarge),
+				// ____0101 - ____1111
+				(Carry | TooLarge | TooLarge1000), (Carry | TooLarge | TooLarge1000), (Carry | TooLarge | TooLarge1000),
+				(Carry | TooLarge | TooLarge1000), (Carry | TooLarge | TooLarge1000), (Carry | TooLarge | TooLarge1000),
+				(Carry | TooLarge | TooLarge1000), (Carry | TooLarge | TooLarge1000), (Carry | TooLarge | TooLarge1000),
+				(Carry | TooLarge | TooLarge1000), (Carry | TooLarge | TooLarge1000));
+
+			const __m128i byte2High = Lookup16(ShiftRight4U8(input),
+				// 0_______
+				TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort,
+				// 1000____
+				(TooLong | Overlong2 | TwoConts | Overlong3 | TooLarge1000 | Overlong4),
+				// 1001____
+				(TooLong | Overlong2 | TwoConts | Overlong3 | TooLarge),
+				// 101_____
+				(TooLong | Overlong2 | TwoConts | TooLarge),
+				(TooLong | Overlong2 | TwoConts | TooLarge),
+				// 11______
+				TooShort, TooShort, TooShort, TooShort);
+
+			return ::_mm_and_si128(::_mm_and_si128(byte1High, byte1Low), byte2High);
+		}
+
+		[[nodiscard]]
+		inline __m128i CheckMultibyteLengths(const __m128i input, const __m128i prevInput, const __m128i specialCases) noexcept
+		{
+			const __m128i prev2 = _mm_alignr_epi8(input, prevInput, 14);
+			const __m128i prev3 = _mm_alignr_epi8(input, prevInput, 13);
+
+			// 3 バイト目と 4 バイト目の位置だけ 0x80 以上になる
+			const __m128i isThirdByte = ::_mm_subs_epu8(prev2, ::_mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+			const __m128i isFourthByte = ::_mm_subs_epu8(prev3, ::_mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+			const __m128i must23 = ::_mm_and_si128(::_mm_or_si128(isThirdByte, isFourthByte), ::_mm_set1_epi8(static_cast<char>(0x80)));
+
+			return ::_mm_xor_si128(must23, specialCases);
+		}
+
+		// 継続バイト (0x80 - 0xBF) 以外の位置で -1 (0xFF) になる
+		[[nodiscard]]
+		inline __m128i IsLeadingByte(const __m128i input) noexcept
+		{
+			return ::_mm_cmpgt_epi8(input, ::_mm_set1_epi8(-65));
+		}
+
+		// 8-bit のカウンタを 64-bit に合計する
+		[[nodiscard]]
+		inline size_t HorizontalSumU8(const __m128i counts) noexcept
+		{
+			const __m128i sums = ::_mm_sad_epu8(counts, ::_mm_setzero_si128());
+			return (static_cast<size_t>(::_mm_cvtsi128_si32(sums)) + static_cast<size_t>(_mm_extract_epi16(sums, 4)));
+		}
+
+		[[nodiscard]]
+		inline size_t HorizontalSumU32(const __m128i sums) noexcept
+		{
+			const __m128i s = ::_mm_add_epi32(sums, _mm_srli_si128(sums, 8));
+			return static_cast<uint32>(::_mm_cvtsi128_si32(::_mm_add_epi32(s, _mm_srli_si128(s, 4))));
+		}
+
+		// 4 つのコードポイントの UTF-8 での長さのうち、0x80, 0x800, 0x10000 以上であるレーンのマスク
+		struct UTF8LengthMasks
+		{
+			__m128i ge80;
+
+			__m128i ge800;
+
+			__m128i ge10000;
+		};
+
+		[[nodiscard]]
+		inline __m128i ReplaceInvalidCodePoints(const __m128i codePoints) noexcept
+		{
+			const __m128i limit = ::_mm_set1_epi32(0x110000);
+			const __m128i invalid = ::_mm_cmpeq_epi32(::_mm_min_epu32(codePoints, limit), limit);
+
+			// REPLACEMENT CHARACTER (0xFFFD)
+			return ::_mm_blendv_epi8(codePoints, ::_mm_set1_epi32(0xFFFD), invalid);
+		}
+
+		[[nodiscard]]
+		inline UTF8LengthMasks GetUTF8LengthMasks(const __m128i codePoints) noexcept
+		{
+			return{ ::_mm_cmpgt_epi32(codePoints, ::_mm_set1_epi32(0x7F)),
+				::_mm_cmpgt_epi32(codePoints, ::_mm_set1_epi32(0x7FF)),
+				::_mm_cmpgt_epi32(codePoints, ::_mm_set1_epi32(0xFFFF)) };
+		}
+
+		[[nodiscard]]
+		inline uint32 MoveMask32(const __m128i mask) noexcept
+		{
+			return static_cast<uint32>(::_mm_movemask_ps(::_mm_castsi128_ps(mask)));
+		}
+
+		// 4 ビットを 2 ビット間隔に広げる
+		[[nodiscard]]
+		constexpr uint32 SpreadBits4(const uint32 bits) noexcept
+		{
+			return ((bits & 0b0001) | ((bits & 0b0010) << 1) | ((bits & 0b0100) << 2) | ((bits & 0b1000) << 3));
+		}
+
+	# endif
+
 		//
 		// UTF-8
 		//
@@ -73,6 +313,28 @@ namespace s3d
 			const char32* pSrc = s.data();
 			const char32* const pSrcEnd = pSrc + s.size();
 
+		# if SIV3D_INTRINSIC(SSE)
+
+			while ((pSrc + 4) <= pSrcEnd)
+			{
+				// 32-bit のレーンがあふれないよう、一定の回数ごとに合計する
+				const size_t count = Min<size_t>(((pSrcEnd - pSrc) / 4), (1 << 24));
+				__m128i sums = ::_mm_setzero_si128();
+
+				for (size_t i = 0; i < count; ++i, pSrc += 4)
+				{
+					const __m128i codePoints = ReplaceInvalidCodePoints(::_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc)));
+					const UTF8LengthMasks masks = GetUTF8LengthMasks(codePoints);
+
+					// マスクは -1 なので、引くと 1 増える
+					sums = ::_mm_sub_epi32(::_mm_sub_epi32(::_mm_sub_epi32(sums, masks.ge80), masks.ge800), masks.ge10000);
+				}
+
+				result += ((count * 4) + HorizontalSumU32(sums));
+			}
+
+		# endif
+
 			while (pSrc != pSrcEnd)
 			{
 				result += UTF8_Length(*pSrc++);
@@ -117,6 +379,274 @@ namespace s3d
 			}
 		}
 
+		void UTF8_Encode(char8* dst, const StringView s) noexcept
+		{
+			const char32* pSrc = s.data();
+			const char32* const pSrcEnd = pSrc + s.size();
+
+		# if SIV3D_INTRINSIC(SSE)
+
+			// 残りが 16 文字以上あれば、出力にも 16 バイト以上の余裕がある
+			while ((pSrc + 16) <= pSrcEnd)
+			{
+				const __m128i v0 = ::_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc));
+				const __m128i nonAscii = ::_mm_set1_epi32(~0x7F);
+
+				if (::_mm_testz_si128(v0, nonAscii))
+				{
+					const __m128i v1 = ::_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 4));
+					const __m128i v2 = ::_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 8));
+					const __m128i v3 = ::_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 12));
+
+					if (::_mm_testz_si128(::_mm_or_si128(::_mm_or_si128(v1, v2), v3), nonAscii))
+					{
+						const __m128i bytes = ::_mm_packus_epi16(::_mm_packus_epi32(v0, v1), ::_mm_packus_epi32(v2, v3));
+						::_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), bytes);
+						dst += 16;
+						pSrc += 16;
+						continue;
+					}
+				}
+
+				const __m128i codePoints = ReplaceInvalidCodePoints(v0);
+				const UTF8LengthMasks masks = GetUTF8LengthMasks(codePoints);
+
+				const __m128i m3F = ::_mm_set1_epi32(0x3F);
+				const __m128i m80 = ::_mm_set1_epi32(0x80);
+				const __m128i t0 = ::_mm_or_si128(::_mm_and_si128(codePoints, m3F), m80);
+				const __m128i t1 = ::_mm_or_si128(::_mm_and_si128(::_mm_srli_epi32(codePoints, 6), m3F), m80);
+				const __m128i t2 = ::_mm_or_si128(::_mm_and_si128(::_mm_srli_epi32(codePoints, 12), m3F), m80);
+
+				// 各レーンに、UTF-8 のバイト列を先頭から下位バイトに並べる
+				const __m128i e2 = ::_mm_or_si128(::_mm_or_si128(::_mm_srli_epi32(codePoints, 6), ::_mm_set1_epi32(0xC0)),
+					::_mm_slli_epi32(t0, 8));
+				const __m128i e3 = ::_mm_or_si128(::_mm_or_si128(::_mm_srli_epi32(codePoints, 12), ::_mm_set1_epi32(0xE0)),
+					::_mm_or_si128(::_mm_slli_epi32(t1, 8), ::_mm_slli_epi32(t0, 16)));
+				const __m128i e4 = ::_mm_or_si128(::_mm_or_si128(::_mm_srli_epi32(codePoints, 18), ::_mm_set1_epi32(0xF0)),
+					::_mm_or_si128(::_mm_slli_epi32(t2, 8), ::_mm_or_si128(::_mm_slli_epi32(t1, 16), ::_mm_slli_epi32(t0, 24))));
+
+				__m128i encoded = ::_mm_blendv_epi8(codePoints, e2, masks.ge80);
+				encoded = ::_mm_blendv_epi8(encoded, e3, masks.ge800);
+				encoded = ::_mm_blendv_epi8(encoded, e4, masks.ge10000);
+
+				const uint32 ge80 = MoveMask32(masks.ge80);
+				const uint32 ge800 = MoveMask32(masks.ge800);
+				const uint32 ge10000 = MoveMask32(masks.ge10000);
+				const uint32 index = (SpreadBits4(ge80) + SpreadBits4(ge800) + SpreadBits4(ge10000));
+
+				const __m128i shuffle = ::_mm_load_si128(reinterpret_cast<const __m128i*>(UTF8PackTable[index].data()));
+				::_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), ::_mm_shuffle_epi8(encoded, shuffle));
+
+				dst += (4 + PopCount4[ge80] + PopCount4[ge800] + PopCount4[ge10000]);
+				pSrc += 4;
+			}
+
+		# endif
+
+			while (pSrc != pSrcEnd)
+			{
+				UTF8_Encode(&dst, *pSrc++);
+			}
+		}
+
+		bool UTF8_Validate(const std::string_view s, size_t& utf32Length) noexcept
+		{
+			size_t length = 0;
+
+			const char8* pSrc = s.data();
+			const char8* const pSrcEnd = pSrc + s.size();
+
+		# if SIV3D_INTRINSIC(SSE)
+
+			{
+				const char8* const pSrcBegin = pSrc;
+
+				// 末尾の 3 バイトが、これより長いバイト列の途中で終わっていないか
+				const __m128i maxValue = ::_mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+					static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+
+				__m128i error = ::_mm_setzero_si128();
+				__m128i prevInput = ::_mm_setzero_si128();
+				__m128i prevIncomplete = ::_mm_setzero_si128();
+
+				// 先頭バイトの数を数える 8-bit のカウンタ
+				__m128i leadingCounts = ::_mm_setzero_si128();
+				int32 numCountedBlocks = 0;
+
+				for (; (pSrc + 16) <= pSrcEnd; pSrc += 16)
+				{
+					const __m128i input = ::_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc));
+
+					if (::_mm_movemask_epi8(input) == 0)
+					{
+						error = ::_mm_or_si128(error, prevIncomplete);
+						prevIncomplete = ::_mm_setzero_si128();
+						prevInput = input;
+						length += 16;
+						continue;
+					}
+
+					if (numCountedBlocks == 255)
+					{
+						length += HorizontalSumU8(leadingCounts);
+						leadingCounts = ::_mm_setzero_si128();
+						numCountedBlocks = 0;
+					}
+
+					const __m128i prev1 = _mm_alignr_epi8(input, prevInput, 15);
+					const __m128i specialCases = CheckSpecialCases(input, prev1);
+					error = ::_mm_or_si128(error, CheckMultibyteLengths(input, prevInput, specialCases));
+
+					prevIncomplete = ::_mm_subs_epu8(input, maxValue);
+					prevInput = input;
+					leadingCounts = ::_mm_sub_epi8(leadingCounts, IsLeadingByte(input));
+					++numCountedBlocks;
+				}
+
+				length += HorizontalSumU8(leadingCounts);
+
+				if (not ::_mm_testz_si128(error, error))
+				{
+					return false;
+				}
+
+				// 最後のブロックの末尾で途切れているバイト列は、その先頭から調べ直す
+				for (int32 k = 1; (k <= 3) && (pSrcBegin <= (pSrc - k)); ++k)
+				{
+					const uint8 ch = static_cast<uint8>(pSrc[-k]);
+
+					if ((ch & 0xC0) == 0x80)
+					{
+						continue;
+					}
+
+					const int32 sequenceLength = ((0xF0 <= ch) ? 4 : (0xE0 <= ch) ? 3 : (0xC0 <= ch) ? 2 : 1);
+
+					if (k < sequenceLength)
+					{
+						pSrc -= k;
+						--length;
+					}
+
+					break;
+				}
+			}
+
+		# endif
+
+			while (pSrc != pSrcEnd)
+			{
+				const offset_pt result = utf8_decode_check(pSrc, (pSrcEnd - pSrc));
+
+				if (result.offset < 0)
+				{
+					return false;
+				}
+
+				pSrc += result.offset;
+
+				++length;
+			}
+
+			utf32Length = length;
+
+			return true;
+		}
+
+		void UTF8_DecodeValid(char32* dst, const std::string_view s) noexcept
+		{
+			const char8* pSrc = s.data();
+			const char8* const pSrcEnd = pSrc + s.size();
+
+		# if SIV3D_INTRINSIC(SSE)
+
+			// 各バイトの位置から始まるバイト列を 4 バイト先まで読んでコードポイントを求め、先頭バイトの位置のものだけを出力に詰める。
+			// 残りが 32 バイト以上あれば、後半の 4 バイトから始まるコードポイントが 4 つ以上残っているので、16 バイト単位で書き込める。
+			for (; (pSrc + 32) <= pSrcEnd; pSrc += 16)
+			{
+				const __m128i b0 = ::_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc));
+
+				if (::_mm_movemask_epi8(b0) == 0)
+				{
+					::_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), ::_mm_cvtepu8_epi32(b0));
+					::_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4), ::_mm_cvtepu8_epi32(_mm_srli_si128(b0, 4)));
+					::_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 8), ::_mm_cvtepu8_epi32(_mm_srli_si128(b0, 8)));
+					::_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 12), ::_mm_cvtepu8_epi32(_mm_srli_si128(b0, 12)));
+					dst += 16;
+					continue;
+				}
+
+				const __m128i b1 = ::_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 1));
+				const __m128i b2 = ::_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 2));
+				const __m128i b3 = ::_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + 3));
+
+				const __m128i is2 = GreaterEqualU8(b0, 0xC0);
+				const __m128i is3 = GreaterEqualU8(b0, 0xE0);
+				const __m128i is4 = GreaterEqualU8(b0, 0xF0);
+
+				const __m128i m03 = ::_mm_set1_epi8(0x03);
+				const __m128i m07 = ::_mm_set1_epi8(0x07);
+				const __m128i m0F = ::_mm_set1_epi8(0x0F);
+				const __m128i m1C = ::_mm_set1_epi8(0x1C);
+				const __m128i m3F = ::_mm_set1_epi8(0x3F);
+				const __m128i mC0 = ::_mm_set1_epi8(static_cast<char>(0xC0));
+				const __m128i mF0 = ::_mm_set1_epi8(static_cast<char>(0xF0));
+
+				// コードポイントの下位・中位・上位バイト
+				const __m128i low2 = ::_mm_or_si128(::_mm_and_si128(b1, m3F), ::_mm_and_si128(::_mm_slli_epi16(b0, 6), mC0));
+				const __m128i low3 = ::_mm_or_si128(::_mm_and_si128(b2, m3F), ::_mm_and_si128(::_mm_slli_epi16(b1, 6), mC0));
+				const __m128i low4 = ::_mm_or_si128(::_mm_and_si128(b3, m3F), ::_mm_and_si128(::_mm_slli_epi16(b2, 6), mC0));
+				const __m128i mid2 = ::_mm_and_si128(::_mm_srli_epi16(b0, 2), m07);
+				const __m128i mid3 = ::_mm_or_si128(::_mm_and_si128(::_mm_srli_epi16(b1, 2), m0F), ::_mm_and_si128(::_mm_slli_epi16(b0, 4), mF0));
+				const __m128i mid4 = ::_mm_or_si128(::_mm_and_si128(::_mm_srli_epi16(b2, 2), m0F), ::_mm_and_si128(::_mm_slli_epi16(b1, 4), mF0));
+				const __m128i high4 = ::_mm_or_si128(::_mm_and_si128(::_mm_srli_epi16(b1, 4), m03), ::_mm_and_si128(::_mm_slli_epi16(b0, 2), m1C));
+
+				const __m128i low = ::_mm_blendv_epi8(::_mm_blendv_epi8(::_mm_blendv_epi8(b0, low2, is2), low3, is3), low4, is4);
+				const __m128i mid = ::_mm_blendv_epi8(::_mm_blendv_epi8(::_mm_and_si128(mid2, is2), mid3, is3), mid4, is4);
+				const __m128i high = ::_mm_and_si128(high4, is4);
+
+				const __m128i zero = ::_mm_setzero_si128();
+				const __m128i lowMidLo = ::_mm_unpacklo_epi8(low, mid);
+				const __m128i lowMidHi = ::_mm_unpackhi_epi8(low, mid);
+				const __m128i highLo = ::_mm_unpacklo_epi8(high, zero);
+				const __m128i highHi = ::_mm_unpackhi_epi8(high, zero);
+
+				const __m128i codePoints[4] =
+				{
+					::_mm_unpacklo_epi16(lowMidLo, highLo),
+					::_mm_unpackhi_epi16(lowMidLo, highLo),
+					::_mm_unpacklo_epi16(lowMidHi, highHi),
+					::_mm_unpackhi_epi16(lowMidHi, highHi),
+				};
+
+				// 継続バイト (0x80 - 0xBF) 以外の位置
+				const uint32 leadingMask = (~static_cast<uint32>(::_mm_movemask_epi8(::_mm_cmplt_epi8(b0, ::_mm_set1_epi8(-64)))) & 0xFFFF);
+
+				for (size_t i = 0; i < 4; ++i)
+				{
+					const uint32 mask = ((leadingMask >> (i * 4)) & 0xF);
+					const __m128i shuffle = ::_mm_load_si128(reinterpret_cast<const __m128i*>(LeftPackTable[mask].data()));
+					::_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), ::_mm_shuffle_epi8(codePoints[i], shuffle));
+					dst += PopCount4[mask];
+				}
+			}
+
+			// 前のブロックで出力したバイト列の続きを読み飛ばす
+			while ((pSrc != pSrcEnd) && ((static_cast<uint8>(*pSrc) & 0xC0) == 0x80))
+			{
+				++pSrc;
+			}
+
+		# endif
+
+			while (pSrc != pSrcEnd)
+			{
+				int32 offset;
+				*dst++ = utf8_decode(pSrc, (pSrcEnd - pSrc), offset);
+				pSrc += offset;
+			}
+		}
+
 		//
 		// UTF-16
 		//
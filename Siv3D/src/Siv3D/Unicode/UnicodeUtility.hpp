@@ -31,6 +31,24 @@ namespace s3d
 
 		void UTF8_Encode(char8** s, char32 codePoint) noexcept;
 
+		/// @brief UTF-32 文字列を UTF-8 に変換します。
+		/// @param dst 変換結果の書き込み先。`UTF8_Length(s)` バイトの領域が必要です
+		/// @param s UTF-32 文字列
+		void UTF8_Encode(char8* dst, StringView s) noexcept;
+
+		/// @brief UTF-8 文字列が正しいかを調べ、UTF-32 に変換したときの長さを求めます。
+		/// @param s UTF-8 文字列
+		/// @param utf32Length UTF-32 に変換したときの長さの格納先
+		/// @remark サロゲートのコードポイントを表すバイト列は、miniutf と同様に正しいものとして扱います。
+		/// @return 正しい UTF-8 文字列である場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool UTF8_Validate(std::string_view s, size_t& utf32Length) noexcept;
+
+		/// @brief `UTF8_Validate()` で正しいことを確かめた UTF-8 文字列を UTF-32 に変換します。
+		/// @param dst 変換結果の書き込み先。UTF-32 に変換したときの長さの領域が必要です
+		/// @param s 正しい UTF-8 文字列
+		void UTF8_DecodeValid(char32* dst, std::string_view s) noexcept;
+
 
 		//
 		// UTF-16
@@ -392,6 +392,7 @@ private:
 
 	friend class b2World;
 	friend class b2Island;
+	friend class b2SolveIslandsTask;
 	friend class b2ContactManager;
 	friend class b2ContactSolver;
 	friend class b2Contact;
@@ -82,6 +82,9 @@
 /// Maximum number of contacts to be handled to solve a TOI impact.
 #define b2_maxTOIContacts			32
 
+/// Minimum number of bodies in the world before islands are handed to the task executor.
+#define b2_minParallelBodyCount		256
+
 /// The maximum linear position correction used when solving constraints. This helps to
 /// prevent overshoot. Meters.
 #define b2_maxLinearCorrection		(0.2f * b2_lengthUnitsPerMeter)
@@ -71,6 +71,11 @@ public:
 	/// by you and must remain in scope.
 	void SetDebugDraw(b2Draw* debugDraw);
 
+	/// Register a task executor used to solve independent islands on multiple threads.
+	/// Pass nullptr to solve the islands on the calling thread. The executor is owned
+	/// by you and must remain in scope.
+	void SetTaskExecutor(b2TaskExecutor* executor);
+
 	/// Create a rigid body given a definition. No reference to the definition
 	/// is retained.
 	/// @warning This function is locked during callbacks.
@@ -222,6 +227,8 @@ private:
 	friend class b2Controller;
 
 	void Solve(const b2TimeStep& step);
+	void SolveIslands(const b2TimeStep& step);
+	void SolveIslandsParallel(const b2TimeStep& step);
 	void SolveTOI(const b2TimeStep& step);
 
 	void DrawShape(b2Fixture* shape, const b2Transform& xf, const b2Color& color);
@@ -243,6 +250,10 @@ private:
 	b2DestructionListener* m_destructionListener;
 	b2Draw* m_debugDraw;
 
+	b2TaskExecutor* m_taskExecutor;
+	b2StackAllocator** m_taskAllocators;
+	int32 m_taskAllocatorCount;
+
 	// This is used to compute the time step ratio to
 	// support a variable time step.
 	float m_inv_dt0;
@@ -158,4 +158,31 @@ public:
 									const b2Vec2& normal, float fraction) = 0;
 };
 
+
+/// A unit of work that the world hands to a b2TaskExecutor.
+class B2_API b2Task
+{
+public:
+	virtual ~b2Task() {}
+
+	/// Execute the work item with the given index.
+	virtual void Execute(int32 index) = 0;
+};
+
+/// Implement this class to let the world solve independent islands on multiple threads.
+/// See b2World::SetTaskExecutor
+class B2_API b2TaskExecutor
+{
+public:
+	virtual ~b2TaskExecutor() {}
+
+	/// Return the number of tasks the island work should be split into.
+	/// Return a value less than 2 to solve the islands on the calling thread.
+	virtual int32 GetTaskCount() = 0;
+
+	/// Call task->Execute(index) for every index in [0, count), possibly concurrently,
+	/// and return after all calls have finished.
+	virtual void Run(b2Task* task, int32 count) = 0;
+};
+
 #endif
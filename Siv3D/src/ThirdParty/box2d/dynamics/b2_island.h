@@ -32,6 +32,7 @@ class b2Joint;
 class b2StackAllocator;
 class b2ContactListener;
 struct b2ContactVelocityConstraint;
+struct b2ContactImpulse;
 struct b2Profile;
 
 /// This is an internal class.
@@ -40,6 +41,13 @@ class b2Island
 public:
 	b2Island(int32 bodyCapacity, int32 contactCapacity, int32 jointCapacity,
 			b2StackAllocator* allocator, b2ContactListener* listener);
+
+	/// Wrap island data that is owned by the caller. The solver state is indexed by
+	/// b2Body::m_islandIndex, which the caller must assign. Instead of calling a listener,
+	/// the contact impulses are written to the impulses array, if it is not nullptr.
+	b2Island(b2Body** bodies, int32 bodyCount, b2Contact** contacts, int32 contactCount,
+			b2Joint** joints, int32 jointCount, b2Position* positions, b2Velocity* velocities,
+			b2StackAllocator* allocator, b2ContactImpulse* impulses);
 	~b2Island();
 
 	void Clear()
@@ -77,6 +85,7 @@ public:
 
 	b2StackAllocator* m_allocator;
 	b2ContactListener* m_listener;
+	b2ContactImpulse* m_impulses;
 
 	b2Body** m_bodies;
 	b2Contact** m_contacts;
@@ -92,6 +101,8 @@ public:
 	int32 m_bodyCapacity;
 	int32 m_contactCapacity;
 	int32 m_jointCapacity;
+
+	bool m_ownsArrays;
 };
 
 #endif
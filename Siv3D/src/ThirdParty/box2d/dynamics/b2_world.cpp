@@ -45,6 +45,10 @@ b2World::b2World(const b2Vec2& gravity)
 	m_destructionListener = nullptr;
 	m_debugDraw = nullptr;
 
+	m_taskExecutor = nullptr;
+	m_taskAllocators = nullptr;
+	m_taskAllocatorCount = 0;
+
 	m_bodyList = nullptr;
 	m_jointList = nullptr;
 
@@ -90,6 +94,13 @@ b2World::~b2World()
 
 		b = bNext;
 	}
+
+	for (int32 i = 0; i < m_taskAllocatorCount; ++i)
+	{
+		m_taskAllocators[i]->~b2StackAllocator();
+		b2Free(m_taskAllocators[i]);
+	}
+	b2Free(m_taskAllocators);
 }
 
 void b2World::SetDestructionListener(b2DestructionListener* listener)
@@ -112,6 +123,11 @@ void b2World::SetDebugDraw(b2Draw* debugDraw)
 	m_debugDraw = debugDraw;
 }
 
+void b2World::SetTaskExecutor(b2TaskExecutor* executor)
+{
+	m_taskExecutor = executor;
+}
+
 b2Body* b2World::CreateBody(const b2BodyDef* def)
 {
 	b2Assert(IsLocked() == false);
@@ -397,6 +413,55 @@ void b2World::Solve(const b2TimeStep& step)
 	m_profile.solveVelocity = 0.0f;
 	m_profile.solvePosition = 0.0f;
 
+	// Gear joints reference bodies outside of their island, so they are only
+	// supported by the serial solver.
+	bool parallel = m_taskExecutor != nullptr && m_bodyCount >= b2_minParallelBodyCount;
+	for (b2Joint* j = m_jointList; j && parallel; j = j->m_next)
+	{
+		if (j->GetType() == e_gearJoint)
+		{
+			parallel = false;
+		}
+	}
+
+	if (parallel && m_taskExecutor->GetTaskCount() > 1)
+	{
+		SolveIslandsParallel(step);
+	}
+	else
+	{
+		SolveIslands(step);
+	}
+
+	{
+		b2Timer timer;
+		// Synchronize fixtures, check for out of range bodies.
+		for (b2Body* b = m_bodyList; b; b = b->GetNext())
+		{
+			// If a body was not in an island then it did not move.
+			if ((b->m_flags & b2Body::e_islandFlag) == 0)
+			{
+				continue;
+			}
+
+			if (b->GetType() == b2_staticBody)
+			{
+				continue;
+			}
+
+			// Update fixtures (for broad-phase).
+			b->SynchronizeFixtures();
+		}
+
+		// Look for new contacts.
+		m_contactManager.FindNewContacts();
+		m_profile.broadphase = timer.GetMilliseconds();
+	}
+}
+
+// Build and solve all awake islands one after another on the calling thread.
+void b2World::SolveIslands(const b2TimeStep& step)
+{
 	// Size the island for the worst case.
 	b2Island island(m_bodyCount,
 					m_contactManager.m_contactCount,
@@ -554,31 +619,416 @@ void b2World::Solve(const b2TimeStep& step)
 	}
 
 	m_stackAllocator.Free(stack);
+}
 
+struct b2IslandRange
+{
+	int32 bodyStart;
+	int32 bodyCount;
+	int32 contactStart;
+	int32 contactCount;
+	int32 jointStart;
+	int32 jointCount;
+};
+
+struct b2IslandTaskRange
+{
+	int32 islandStart;
+	int32 islandCount;
+	int32 bodyStart;
+	int32 bodyCount;
+	int32 stateStart;
+	b2Profile profile;
+};
+
+// Solves a contiguous range of islands per task. Static bodies are shared between islands,
+// so each static body has the same island index in all tasks and every task keeps its own
+// copy of the solver state. Only the static bodies referenced by the contacts and joints of
+// the task's islands are copied, like the serial flood fill adds them to each island.
+class b2SolveIslandsTask : public b2Task
+{
+public:
+	void Execute(int32 index) override
 	{
-		b2Timer timer;
-		// Synchronize fixtures, check for out of range bodies.
-		for (b2Body* b = m_bodyList; b; b = b->GetNext())
+		b2IslandTaskRange* range = ranges + index;
+		b2Position* positions = statePositions + range->stateStart;
+		b2Velocity* velocities = stateVelocities + range->stateStart;
+
+		for (int32 i = range->islandStart; i < range->islandStart + range->islandCount; ++i)
 		{
-			// If a body was not in an island then it did not move.
-			if ((b->m_flags & b2Body::e_islandFlag) == 0)
+			const b2IslandRange* r = islands + i;
+
+			for (int32 j = 0; j < r->contactCount; ++j)
 			{
-				continue;
+				b2Contact* contact = contacts[r->contactStart + j];
+				CopyStatic(contact->GetFixtureA()->GetBody(), positions, velocities);
+				CopyStatic(contact->GetFixtureB()->GetBody(), positions, velocities);
 			}
 
-			if (b->GetType() == b2_staticBody)
+			for (int32 j = 0; j < r->jointCount; ++j)
 			{
-				continue;
+				b2Joint* joint = joints[r->jointStart + j];
+				CopyStatic(joint->GetBodyA(), positions, velocities);
+				CopyStatic(joint->GetBodyB(), positions, velocities);
 			}
+		}
 
-			// Update fixtures (for broad-phase).
-			b->SynchronizeFixtures();
+		for (int32 i = 0; i < range->bodyCount; ++i)
+		{
+			bodies[range->bodyStart + i]->m_islandIndex = staticCount + i;
 		}
 
-		// Look for new contacts.
-		m_contactManager.FindNewContacts();
-		m_profile.broadphase = timer.GetMilliseconds();
+		range->profile.solveInit = 0.0f;
+		range->profile.solveVelocity = 0.0f;
+		range->profile.solvePosition = 0.0f;
+
+		for (int32 i = range->islandStart; i < range->islandStart + range->islandCount; ++i)
+		{
+			const b2IslandRange* r = islands + i;
+
+			// Contacts are reported by the world after all tasks have finished.
+			b2Island island(bodies + r->bodyStart, r->bodyCount,
+							contacts + r->contactStart, r->contactCount,
+							joints + r->jointStart, r->jointCount,
+							positions, velocities, allocators[index],
+							impulses ? impulses + r->contactStart : nullptr);
+
+			b2Profile profile;
+			island.Solve(&profile, *step, gravity, allowSleep);
+			range->profile.solveInit += profile.solveInit;
+			range->profile.solveVelocity += profile.solveVelocity;
+			range->profile.solvePosition += profile.solvePosition;
+		}
+	}
+
+	static void CopyStatic(b2Body* b, b2Position* positions, b2Velocity* velocities)
+	{
+		if (b->GetType() != b2_staticBody)
+		{
+			return;
+		}
+
+		// The same static body may be copied more than once. The state is the same each time.
+		int32 i = b->m_islandIndex;
+		positions[i].c = b->m_sweep.c;
+		positions[i].a = b->m_sweep.a;
+		velocities[i].v = b->m_linearVelocity;
+		velocities[i].w = b->m_angularVelocity;
+	}
+
+	const b2TimeStep* step;
+	b2Vec2 gravity;
+	bool allowSleep;
+
+	const b2IslandRange* islands;
+	b2IslandTaskRange* ranges;
+	b2Body** bodies;
+	int32 staticCount;
+	b2Contact** contacts;
+	b2Joint** joints;
+	b2Position* statePositions;
+	b2Velocity* stateVelocities;
+	b2ContactImpulse* impulses;
+	b2StackAllocator** allocators;
+};
+
+// Build all awake islands on the calling thread, then solve them with the task executor.
+// The islands are the same as in SolveIslands, except that static bodies are tracked
+// separately instead of being added to every island that touches them.
+void b2World::SolveIslandsParallel(const b2TimeStep& step)
+{
+	int32 contactCapacity = m_contactManager.m_contactCount;
+
+	b2IslandRange* islands = (b2IslandRange*)m_stackAllocator.Allocate(m_bodyCount * sizeof(b2IslandRange));
+	b2Body** bodies = (b2Body**)m_stackAllocator.Allocate(m_bodyCount * sizeof(b2Body*));
+	b2Body** statics = (b2Body**)m_stackAllocator.Allocate(m_bodyCount * sizeof(b2Body*));
+	b2Contact** contacts = (b2Contact**)m_stackAllocator.Allocate(contactCapacity * sizeof(b2Contact*));
+	b2Joint** joints = (b2Joint**)m_stackAllocator.Allocate(m_jointCount * sizeof(b2Joint*));
+
+	int32 islandCount = 0;
+	int32 bodyCount = 0;
+	int32 staticCount = 0;
+	int32 contactCount = 0;
+	int32 jointCount = 0;
+
+	// Clear all the island flags.
+	for (b2Body* b = m_bodyList; b; b = b->m_next)
+	{
+		b->m_flags &= ~b2Body::e_islandFlag;
+	}
+	for (b2Contact* c = m_contactManager.m_contactList; c; c = c->m_next)
+	{
+		c->m_flags &= ~b2Contact::e_islandFlag;
+	}
+	for (b2Joint* j = m_jointList; j; j = j->m_next)
+	{
+		j->m_islandFlag = false;
 	}
+
+	// Build all awake islands.
+	int32 stackSize = m_bodyCount;
+	b2Body** stack = (b2Body**)m_stackAllocator.Allocate(stackSize * sizeof(b2Body*));
+	for (b2Body* seed = m_bodyList; seed; seed = seed->m_next)
+	{
+		if (seed->m_flags & b2Body::e_islandFlag)
+		{
+			continue;
+		}
+
+		if (seed->IsAwake() == false || seed->IsEnabled() == false)
+		{
+			continue;
+		}
+
+		// The seed can be dynamic or kinematic.
+		if (seed->GetType() == b2_staticBody)
+		{
+			continue;
+		}
+
+		b2IslandRange* island = islands + islandCount++;
+		island->bodyStart = bodyCount;
+		island->contactStart = contactCount;
+		island->jointStart = jointCount;
+
+		int32 stackCount = 0;
+		stack[stackCount++] = seed;
+		seed->m_flags |= b2Body::e_islandFlag;
+
+		// Perform a depth first search (DFS) on the constraint graph.
+		while (stackCount > 0)
+		{
+			// Grab the next body off the stack and add it to the island.
+			// Static bodies are never pushed onto the stack.
+			b2Body* b = stack[--stackCount];
+			b2Assert(b->IsEnabled() == true);
+			bodies[bodyCount++] = b;
+
+			// Make sure the body is awake (without resetting sleep timer).
+			b->m_flags |= b2Body::e_awakeFlag;
+
+			// Search all contacts connected to this body.
+			for (b2ContactEdge* ce = b->m_contactList; ce; ce = ce->next)
+			{
+				b2Contact* contact = ce->contact;
+
+				// Has this contact already been added to an island?
+				if (contact->m_flags & b2Contact::e_islandFlag)
+				{
+					continue;
+				}
+
+				// Is this contact solid and touching?
+				if (contact->IsEnabled() == false ||
+					contact->IsTouching() == false)
+				{
+					continue;
+				}
+
+				// Skip sensors.
+				bool sensorA = contact->m_fixtureA->m_isSensor;
+				bool sensorB = contact->m_fixtureB->m_isSensor;
+				if (sensorA || sensorB)
+				{
+					continue;
+				}
+
+				contacts[contactCount++] = contact;
+				contact->m_flags |= b2Contact::e_islandFlag;
+
+				b2Body* other = ce->other;
+
+				// Was the other body already added to an island?
+				if (other->m_flags & b2Body::e_islandFlag)
+				{
+					continue;
+				}
+
+				other->m_flags |= b2Body::e_islandFlag;
+
+				// To keep islands as small as possible, we don't
+				// propagate islands across static bodies.
+				if (other->GetType() == b2_staticBody)
+				{
+					other->m_islandIndex = staticCount;
+					statics[staticCount++] = other;
+					continue;
+				}
+
+				b2Assert(stackCount < stackSize);
+				stack[stackCount++] = other;
+			}
+
+			// Search all joints connect to this body.
+			for (b2JointEdge* je = b->m_jointList; je; je = je->next)
+			{
+				if (je->joint->m_islandFlag == true)
+				{
+					continue;
+				}
+
+				b2Body* other = je->other;
+
+				// Don't simulate joints connected to diabled bodies.
+				if (other->IsEnabled() == false)
+				{
+					continue;
+				}
+
+				joints[jointCount++] = je->joint;
+				je->joint->m_islandFlag = true;
+
+				if (other->m_flags & b2Body::e_islandFlag)
+				{
+					continue;
+				}
+
+				other->m_flags |= b2Body::e_islandFlag;
+
+				if (other->GetType() == b2_staticBody)
+				{
+					other->m_islandIndex = staticCount;
+					statics[staticCount++] = other;
+					continue;
+				}
+
+				b2Assert(stackCount < stackSize);
+				stack[stackCount++] = other;
+			}
+		}
+
+		island->bodyCount = bodyCount - island->bodyStart;
+		island->contactCount = contactCount - island->contactStart;
+		island->jointCount = jointCount - island->jointStart;
+	}
+
+	m_stackAllocator.Free(stack);
+
+	if (islandCount > 0)
+	{
+		// Split the islands into contiguous ranges of roughly equal cost.
+		int32 taskCount = b2Min(m_taskExecutor->GetTaskCount(), islandCount);
+		b2IslandTaskRange* ranges = (b2IslandTaskRange*)m_stackAllocator.Allocate(taskCount * sizeof(b2IslandTaskRange));
+
+		double totalCost = bodyCount + contactCount + jointCount;
+		double cost = 0.0;
+		int32 rangeCount = 0;
+		int32 stateCount = 0;
+		b2IslandTaskRange* range = nullptr;
+		for (int32 i = 0; i < islandCount; ++i)
+		{
+			const b2IslandRange* island = islands + i;
+
+			if (range == nullptr)
+			{
+				range = ranges + rangeCount++;
+				range->islandStart = i;
+				range->islandCount = 0;
+				range->bodyStart = island->bodyStart;
+				range->bodyCount = 0;
+				range->stateStart = stateCount;
+			}
+
+			++range->islandCount;
+			range->bodyCount += island->bodyCount;
+			cost += island->bodyCount + island->contactCount + island->jointCount;
+
+			if (cost * taskCount >= totalCost * rangeCount)
+			{
+				stateCount += staticCount + range->bodyCount;
+				range = nullptr;
+			}
+		}
+
+		b2Assert(range == nullptr && rangeCount <= taskCount);
+
+		b2Position* positions = (b2Position*)m_stackAllocator.Allocate(stateCount * sizeof(b2Position));
+		b2Velocity* velocities = (b2Velocity*)m_stackAllocator.Allocate(stateCount * sizeof(b2Velocity));
+
+		b2ContactListener* listener = m_contactManager.m_contactListener;
+		b2ContactImpulse* impulses = nullptr;
+		if (listener)
+		{
+			impulses = (b2ContactImpulse*)m_stackAllocator.Allocate(contactCount * sizeof(b2ContactImpulse));
+		}
+
+		// Each task needs its own stack allocator for the contact solver.
+		if (m_taskAllocatorCount < rangeCount)
+		{
+			b2StackAllocator** allocators = (b2StackAllocator**)b2Alloc(rangeCount * sizeof(b2StackAllocator*));
+			for (int32 i = 0; i < m_taskAllocatorCount; ++i)
+			{
+				allocators[i] = m_taskAllocators[i];
+			}
+			for (int32 i = m_taskAllocatorCount; i < rangeCount; ++i)
+			{
+				void* mem = b2Alloc(sizeof(b2StackAllocator));
+				allocators[i] = new (mem) b2StackAllocator;
+			}
+
+			b2Free(m_taskAllocators);
+			m_taskAllocators = allocators;
+			m_taskAllocatorCount = rangeCount;
+		}
+
+		b2SolveIslandsTask task;
+		task.step = &step;
+		task.gravity = m_gravity;
+		task.allowSleep = m_allowSleep;
+		task.islands = islands;
+		task.ranges = ranges;
+		task.bodies = bodies;
+		task.staticCount = staticCount;
+		task.contacts = contacts;
+		task.joints = joints;
+		task.statePositions = positions;
+		task.stateVelocities = velocities;
+		task.impulses = impulses;
+		task.allocators = m_taskAllocators;
+
+		if (rangeCount == 1)
+		{
+			task.Execute(0);
+		}
+		else
+		{
+			m_taskExecutor->Run(&task, rangeCount);
+		}
+
+		for (int32 i = 0; i < rangeCount; ++i)
+		{
+			m_profile.solveInit += ranges[i].profile.solveInit;
+			m_profile.solveVelocity += ranges[i].profile.solveVelocity;
+			m_profile.solvePosition += ranges[i].profile.solvePosition;
+		}
+
+		// Report the contacts in island order on the calling thread.
+		if (listener)
+		{
+			for (int32 i = 0; i < contactCount; ++i)
+			{
+				listener->PostSolve(contacts[i], impulses + i);
+			}
+
+			m_stackAllocator.Free(impulses);
+		}
+
+		m_stackAllocator.Free(velocities);
+		m_stackAllocator.Free(positions);
+		m_stackAllocator.Free(ranges);
+	}
+
+	// Allow static bodies to participate in islands of the next step.
+	for (int32 i = 0; i < staticCount; ++i)
+	{
+		statics[i]->m_flags &= ~b2Body::e_islandFlag;
+	}
+
+	m_stackAllocator.Free(joints);
+	m_stackAllocator.Free(contacts);
+	m_stackAllocator.Free(statics);
+	m_stackAllocator.Free(bodies);
+	m_stackAllocator.Free(islands);
 }
 
 // Find TOI contacts and solve them.
@@ -0,0 +1,92 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+# include "Siv3DTest.hpp"
+
+TEST_CASE("Asset::LoadAsyncGroup()")
+{
+	std::atomic<size_t> loadCount = 0;
+
+	for (int32 i = 0; i < 100; ++i)
+	{
+		auto data = std::make_unique<TextureAssetData>(FilePathView{}, TextureDesc::Unmipped, Array<AssetTag>{ U"Siv3DTest.Group" });
+		data->onLoad = [&loadCount, i](TextureAssetData&, const String&)
+		{
+			++loadCount;
+			return ((i % 10) != 0);
+		};
+		data->onRelease = [](TextureAssetData&) {};
+
+		TextureAsset::Register(U"Siv3DTest.Asset.{}"_fmt(i), std::move(data));
+	}
+
+	REQUIRE(Asset::GetGroupProgress(U"Siv3DTest.Group").total == 100);
+	REQUIRE(Asset::GetGroupProgress(U"Siv3DTest.Group").finished() == 0);
+
+	REQUIRE(Asset::LoadAsyncGroup(U"Siv3DTest.Group", AssetLoadPriority::High) == 100);
+
+	Asset::WaitGroup(U"Siv3DTest.Group");
+
+	const AssetLoadProgress progress = Asset::GetGroupProgress(U"Siv3DTest.Group");
+	REQUIRE(progress.total == 100);
+	REQUIRE(progress.loaded == 90);
+	REQUIRE(progress.failed == 10);
+	REQUIRE(progress.isFinished());
+	REQUIRE(progress.progress() == 1.0);
+	REQUIRE(loadCount == 100);
+
+	// 一度ロードしたアセットは再度ロードされない
+	Asset::LoadAsyncGroup(U"Siv3DTest.Group");
+	Asset::WaitGroup(U"Siv3DTest.Group");
+	REQUIRE(loadCount == 100);
+
+	for (int32 i = 0; i < 100; ++i)
+	{
+		TextureAsset::Unregister(U"Siv3DTest.Asset.{}"_fmt(i));
+	}
+
+	REQUIRE(Asset::GetGroupProgress(U"Siv3DTest.Group").total == 0);
+	REQUIRE(Asset::GetGroupProgress(U"Siv3DTest.Group").progress() == 1.0);
+}
+
+TEST_CASE("Asset::CancelGroup()")
+{
+	std::atomic<size_t> loadCount = 0;
+
+	for (int32 i = 0; i < 1000; ++i)
+	{
+		auto data = std::make_unique<TextureAssetData>(FilePathView{}, TextureDesc::Unmipped, Array<AssetTag>{ U"Siv3DTest.Cancel" });
+		data->onLoad = [&loadCount](TextureAssetData&, const String&)
+		{
+			++loadCount;
+			return true;
+		};
+		data->onRelease = [](TextureAssetData&) {};
+
+		TextureAsset::Register(U"Siv3DTest.Asset.{}"_fmt(i), std::move(data));
+	}
+
+	Asset::LoadAsyncGroup(U"Siv3DTest.Cancel", AssetLoadPriority::Low);
+
+	const size_t canceled = Asset::CancelGroup(U"Siv3DTest.Cancel");
+
+	Asset::WaitGroup(U"Siv3DTest.Cancel");
+
+	// 取り消されたアセットは未初期化の状態に戻り、ロードされない
+	const AssetLoadProgress progress = Asset::GetGroupProgress(U"Siv3DTest.Cancel");
+	REQUIRE(progress.isFinished());
+	REQUIRE(progress.loaded == loadCount);
+	REQUIRE((progress.loaded + canceled) == 1000);
+
+	for (int32 i = 0; i < 1000; ++i)
+	{
+		TextureAsset::Unregister(U"Siv3DTest.Asset.{}"_fmt(i));
+	}
+}
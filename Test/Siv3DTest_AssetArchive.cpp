@@ -0,0 +1,117 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+// Siv3D TODO: Excluded Test Case
+# if !SIV3D_PLATFORM(WEB)
+
+TEST_CASE("AssetArchive")
+{
+	const FilePath archivePath = FileSystem::FullPath(U"test/runtime/assetarchive/test.s3da");
+
+	const Blob compressible{ Array<Byte>(100000, Byte{ 0x5A }) };
+	const Blob incompressible{ Array<Byte>{ Byte{ 1 }, Byte{ 2 }, Byte{ 3 } } };
+
+	{
+		AssetArchiveWriter writer;
+		REQUIRE(writer.addBlob(compressible, U"data/compressible.bin"));
+		REQUIRE(writer.addBlob(incompressible, U"data/incompressible.bin"));
+		REQUIRE(writer.addBlob(compressible, U"data/stored.bin", AssetArchiveWriter::Store));
+		REQUIRE(writer.addBlob(Blob{}, U"data/empty.bin"));
+		REQUIRE(writer.addFile(U"test/image/png/3x3.png", U"image/3x3.png"));
+		REQUIRE(writer.addBlob(incompressible, U"data/stored.bin") == false);
+		REQUIRE(writer.num_entries() == 5);
+
+		writer.setAlignment(4096);
+		REQUIRE(writer.save(archivePath));
+	}
+
+	SECTION("read")
+	{
+		const AssetArchive archive{ archivePath };
+		REQUIRE(archive.isOpen());
+		REQUIRE(archive.enumPaths().size() == 5);
+		REQUIRE(archive.contains(U"data/stored.bin"));
+		REQUIRE(archive.contains(U"data/missing.bin") == false);
+
+		REQUIRE(archive.isCompressed(U"data/compressible.bin"));
+		REQUIRE(archive.isCompressed(U"data/incompressible.bin") == false);
+		REQUIRE(archive.isCompressed(U"data/stored.bin") == false);
+		REQUIRE(archive.fileSize(U"data/compressible.bin") == 100000);
+
+		REQUIRE(archive.extractToBlob(U"data/compressible.bin").asArray() == compressible.asArray());
+		REQUIRE(archive.extractToBlob(U"data/incompressible.bin").asArray() == incompressible.asArray());
+		REQUIRE(archive.extractToBlob(U"data/stored.bin").asArray() == compressible.asArray());
+		REQUIRE(archive.extractToBlob(U"data/empty.bin").isEmpty());
+
+		// 非圧縮のエントリはアライメントが揃えられ、マップされたページを直接参照する
+		const MemoryViewReader view = archive.view(U"data/stored.bin");
+		REQUIRE(view.size() == 100000);
+		REQUIRE(archive.view(U"data/compressible.bin").size() == 0);
+
+		const AssetArchive::SharedView shared = archive.acquire(U"data/stored.bin");
+		REQUIRE(shared.size == 100000);
+		REQUIRE((reinterpret_cast<uintptr_t>(shared.data) % 4096) == 0);
+
+		const Image image = archive.loadImage(U"image/3x3.png");
+		const Image expected{ U"test/image/png/3x3.png" };
+		REQUIRE(image.size() == expected.size());
+		REQUIRE(std::equal(image.begin(), image.end(), expected.begin()));
+	}
+
+	SECTION("shared view outlives the archive")
+	{
+		AssetArchive::SharedView shared;
+		{
+			AssetArchive archive{ archivePath };
+			shared = archive.acquire(U"data/stored.bin");
+		}
+
+		REQUIRE(shared);
+		REQUIRE(Blob{ shared.data, shared.size }.asArray() == compressible.asArray());
+	}
+
+	SECTION("invalid archive")
+	{
+		REQUIRE(AssetArchive{ U"test/image/png/3x3.png" }.isOpen() == false);
+		REQUIRE(AssetArchive{ U"test/runtime/assetarchive/missing.s3da" }.isOpen() == false);
+	}
+
+	SECTION("entry count exceeding the table of contents")
+	{
+		// ヘッダの entryCount（オフセット 24）を、目次に収まらない値に書き換える
+		Array<Byte> data = Blob{ archivePath }.asArray();
+		REQUIRE(32 <= data.size());
+
+		const uint32 entryCount = 0xFFFFFFFF;
+		std::memcpy(&data[24], &entryCount, sizeof(entryCount));
+
+		const FilePath brokenPath = FileSystem::FullPath(U"test/runtime/assetarchive/broken.s3da");
+		REQUIRE(Blob{ data }.save(brokenPath));
+		REQUIRE(AssetArchive{ brokenPath }.isOpen() == false);
+	}
+
+	SECTION("source file removed before save")
+	{
+		const FilePath sourcePath = U"test/runtime/assetarchive/source.png";
+		REQUIRE(FileSystem::Copy(U"test/image/png/3x3.png", sourcePath, CopyOption::OverwriteExisting));
+
+		AssetArchiveWriter writer;
+		REQUIRE(writer.addFile(sourcePath, U"image/source.png"));
+		REQUIRE(FileSystem::Remove(sourcePath));
+
+		// 読み込めなかったエントリを空のデータとして書き込まず、保存に失敗する
+		REQUIRE(writer.save(U"test/runtime/assetarchive/removed.s3da") == false);
+	}
+}
+
+# endif
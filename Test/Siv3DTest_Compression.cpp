@@ -0,0 +1,64 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+TEST_CASE("Compression")
+{
+	Array<Byte> bytes;
+
+	for (size_t i = 0; i < 200000; ++i)
+	{
+		bytes << static_cast<Byte>((i * 7) % 61);
+	}
+
+	const Blob source{ bytes };
+
+	SECTION("options")
+	{
+		const Blob compressed = Compression::Compress(source, CompressionOptions{ .level = 3, .workers = 2, .longDistanceMatching = true });
+		REQUIRE(compressed.size() < source.size());
+		REQUIRE(Compression::Decompress(compressed).asArray() == source.asArray());
+
+		const Blob defaultLevel = Compression::Compress(source);
+		REQUIRE(Compression::Decompress(defaultLevel).asArray() == source.asArray());
+	}
+
+	SECTION("dictionary")
+	{
+		Array<Blob> samples;
+
+		for (int32 i = 0; i < 1000; ++i)
+		{
+			const std::string json = "{\"id\":" + std::to_string(i) + ",\"name\":\"player" + std::to_string(i % 17)
+				+ "\",\"position\":{\"x\":" + std::to_string(i * 3) + ",\"y\":" + std::to_string(i * 5) + "},\"active\":true}";
+			samples << Blob{ json.data(), json.size() };
+		}
+
+		const Blob dictionaryData = Compression::TrainDictionary(samples, 4096);
+		REQUIRE(not dictionaryData.isEmpty());
+
+		const CompressionDictionary dictionary{ dictionaryData };
+		REQUIRE(dictionary);
+		REQUIRE(dictionary.id() != 0);
+
+		for (const auto& sample : samples.take(50))
+		{
+			const Blob compressed = Compression::CompressWithDictionary(sample, dictionary);
+			REQUIRE(not compressed.isEmpty());
+			REQUIRE(compressed.size() < Compression::Compress(sample).size());
+			REQUIRE(Compression::DecompressWithDictionary(compressed, dictionary).asArray() == sample.asArray());
+		}
+
+		REQUIRE(CompressionDictionary{}.isEmpty());
+		REQUIRE(Compression::CompressWithDictionary(source, CompressionDictionary{}).isEmpty());
+	}
+}
@@ -0,0 +1,217 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+TEST_CASE("Font : glyph cache eviction")
+{
+	// キャッシュテクスチャの幅が最大の 2048 になり、1 ページに 64 グリフ程度しか入らない大きさ
+	const Font font{ FontMethod::Bitmap, 256 };
+
+	// 前のフレームまでの描画を確定させる
+	System::Update();
+
+	const RectF firstRegion = font(U"一").draw();
+	const RectF notdefRegion = font(U"\U000F0000").draw();
+
+	System::Update();
+
+	// 1 フレームに 64 文字ずつ、ページの上限 (4 ページ) を超えるまで異なる漢字を描く
+	for (char32 ch = U'\u4E01'; ch < U'\u9FA0';)
+	{
+		String text;
+
+		for (; (ch < U'\u9FA0') && (text.size() < 64); ++ch)
+		{
+			text.push_back(ch);
+		}
+
+		font(text).draw();
+
+		System::Update();
+
+		if (font.getGlyphCacheStat().evictedPageCount)
+		{
+			break;
+		}
+	}
+
+	const GlyphCacheStat stat = font.getGlyphCacheStat();
+	REQUIRE(stat.pageCount == 4);
+	REQUIRE(stat.evictedPageCount > 0);
+	REQUIRE(stat.evictedGlyphCount > 0);
+	REQUIRE(stat.glyphCount < stat.missCount);
+
+	// 追い出されたグリフは再び生成され、追い出し後も同じように描画できる
+	REQUIRE(font(U"一").draw() == firstRegion);
+
+	// .notdef グリフは追い出されない
+	REQUIRE(font(U"\U000F0000").draw() == notdefRegion);
+	REQUIRE(notdefRegion.w > 0.0);
+
+	System::Update();
+
+	// 同じフレームで描いたグリフのページは、後から描いたグリフによって追い出されない
+	const String text = U"一二三四五六七八九十";
+	font(text).draw();
+
+	for (char32 ch = U'\u5000'; ch < U'\u5100'; ch += 64)
+	{
+		String s;
+
+		for (char32 i = 0; i < 64; ++i)
+		{
+			s.push_back(ch + i);
+		}
+
+		font(s).draw();
+	}
+
+	const uint64 missCount = font.getGlyphCacheStat().missCount;
+	font(text).draw();
+	REQUIRE(font.getGlyphCacheStat().missCount == missCount);
+
+	System::Update();
+}
+
+TEST_CASE("Font : preloadAsync() upload failure")
+{
+	const Font font{ FontMethod::SDF, 256 };
+
+	// 前のフレームまでの描画を確定させる
+	System::Update();
+
+	// 同じフレームの中で、アトラスが埋まって登録に失敗するまで異なる漢字を 1 文字ずつ描く
+	String cachedText;
+	char32 failedChar = U'\u4E01';
+
+	for (; failedChar < U'\u9FA0'; ++failedChar)
+	{
+		if (font(failedChar).draw().w == 0.0)
+		{
+			break;
+		}
+
+		if (cachedText.size() < 10)
+		{
+			cachedText.push_back(failedChar);
+		}
+	}
+
+	REQUIRE(failedChar < U'\u9FA0');
+
+	// 登録できなかった文字を事前生成し、生成の完了を待つ
+	REQUIRE(font.preloadAsync(String(1, failedChar)));
+	System::Sleep(1000);
+
+	// 事前生成したグリフの登録に失敗しても、キャッシュ済みのグリフだけの文字列は描ける
+	const uint64 missCount = font.getGlyphCacheStat().missCount;
+	REQUIRE(font(cachedText).draw().w > 0.0);
+	REQUIRE(font.getGlyphCacheStat().missCount == missCount);
+
+	System::Update();
+
+	// 次のフレームで登録が再び試みられる
+	REQUIRE(font(cachedText).draw().w > 0.0);
+	REQUIRE(font.getGlyphCacheStat().missCount == (missCount + 1));
+
+	REQUIRE(font(failedChar).draw().w > 0.0);
+	REQUIRE(font.getGlyphCacheStat().missCount == (missCount + 1));
+
+	System::Update();
+}
+
+// Siv3D TODO: Excluded Test Case
+# if !SIV3D_PLATFORM(WEB)
+
+TEST_CASE("Font : persistent glyph cache")
+{
+	const FilePath cacheDirectory = (FileSystem::GetFolderPath(SpecialFolder::LocalAppData) + U"Siv3D/" SIV3D_VERSION_STRING U"/font/glyph/");
+	const String text = U"Siv3D グリフキャッシュ";
+
+	// 新しく生成されたグリフの数を返す
+	const auto drawAndGetMissCount = [&](const FontMethod fontMethod, const int32 fontSize, const Typeface typeface)
+	{
+		const Font font{ fontMethod, fontSize, typeface };
+		font(text).draw();
+		const uint64 missCount = font.getGlyphCacheStat().missCount;
+		System::Update();
+		return missCount;
+	};
+
+	// キャッシュファイルは再生成されるので、以前のテストの結果が影響しないようにすべて削除する
+	FileSystem::Remove(cacheDirectory);
+
+	// 前のフレームまでの描画を確定させる
+	System::Update();
+
+	SECTION("save and load")
+	{
+		REQUIRE(drawAndGetMissCount(FontMethod::SDF, 40, Typeface::Regular) > 0);
+		REQUIRE(FileSystem::DirectoryContents(cacheDirectory).size() == 1);
+
+		// フォントを破棄したときに保存されたキャッシュファイルから復元される
+		REQUIRE(drawAndGetMissCount(FontMethod::SDF, 40, Typeface::Regular) == 0);
+		REQUIRE(drawAndGetMissCount(FontMethod::MSDF, 40, Typeface::Regular) > 0);
+		REQUIRE(drawAndGetMissCount(FontMethod::MSDF, 40, Typeface::Regular) == 0);
+		REQUIRE(FileSystem::DirectoryContents(cacheDirectory).size() == 2);
+	}
+
+	SECTION("different font or size")
+	{
+		REQUIRE(drawAndGetMissCount(FontMethod::SDF, 40, Typeface::Regular) > 0);
+
+		// フォントファイル、大きさ、方式が異なる場合はキャッシュファイルを共有しない
+		REQUIRE(drawAndGetMissCount(FontMethod::SDF, 41, Typeface::Regular) > 0);
+		REQUIRE(drawAndGetMissCount(FontMethod::SDF, 40, Typeface::Bold) > 0);
+		REQUIRE(drawAndGetMissCount(FontMethod::MSDF, 40, Typeface::Regular) > 0);
+		REQUIRE(FileSystem::DirectoryContents(cacheDirectory).size() == 4);
+
+		// ビットマップのキャッシュは保存しない
+		REQUIRE(drawAndGetMissCount(FontMethod::Bitmap, 40, Typeface::Regular) > 0);
+		REQUIRE(FileSystem::DirectoryContents(cacheDirectory).size() == 4);
+	}
+
+	SECTION("stale or corrupted file")
+	{
+		REQUIRE(drawAndGetMissCount(FontMethod::SDF, 40, Typeface::Regular) > 0);
+
+		const Array<FilePath> files = FileSystem::DirectoryContents(cacheDirectory);
+		REQUIRE(files.size() == 1);
+		const FilePath path = files.front();
+		const int64 fileSize = FileSystem::FileSize(path);
+
+		// ファイル形式のバージョンが異なるファイルは使わずに再生成する
+		{
+			Blob blob{ path };
+			blob.data()[4] = Byte{ 0xFF };
+			REQUIRE(blob.save(path));
+		}
+
+		REQUIRE(drawAndGetMissCount(FontMethod::SDF, 40, Typeface::Regular) > 0);
+		REQUIRE(drawAndGetMissCount(FontMethod::SDF, 40, Typeface::Regular) == 0);
+
+		// 途中で切れているファイルは使わずに再生成する
+		{
+			Blob blob{ path };
+			blob.resize(blob.size() / 2);
+			REQUIRE(blob.save(path));
+		}
+
+		REQUIRE(drawAndGetMissCount(FontMethod::SDF, 40, Typeface::Regular) > 0);
+		REQUIRE(FileSystem::FileSize(path) == fileSize);
+		REQUIRE(drawAndGetMissCount(FontMethod::SDF, 40, Typeface::Regular) == 0);
+	}
+
+	FileSystem::Remove(cacheDirectory);
+}
+
+# endif
@@ -201,3 +201,96 @@ TEST_CASE("Image")
 		}
 	}
 }
+
+TEST_CASE("ImageProcessing::GenerateMips()")
+{
+	SECTION("2x2 box filter")
+	{
+		Image image{ 64, 32 };
+
+		for (int32 y = 0; y < image.height(); ++y)
+		{
+			for (int32 x = 0; x < image.width(); ++x)
+			{
+				image[y][x] = Color(static_cast<uint8>(x * 4), static_cast<uint8>(y * 8), static_cast<uint8>((x + y) % 2 * 255), 255);
+			}
+		}
+
+		const Array<Image> mips = ImageProcessing::GenerateMips(image);
+		REQUIRE(mips.size() == 5);
+		REQUIRE(mips[0].size() == Size(32, 16));
+		REQUIRE(mips[4].size() == Size(2, 1));
+
+		for (int32 y = 0; y < mips[0].height(); ++y)
+		{
+			for (int32 x = 0; x < mips[0].width(); ++x)
+			{
+				const Color& c0 = image[y * 2][x * 2];
+				const Color& c1 = image[y * 2][x * 2 + 1];
+				const Color& c2 = image[y * 2 + 1][x * 2];
+				const Color& c3 = image[y * 2 + 1][x * 2 + 1];
+				REQUIRE(mips[0][y][x].r == (c0.r + c1.r + c2.r + c3.r + 2) / 4);
+				REQUIRE(mips[0][y][x].g == (c0.g + c1.g + c2.g + c3.g + 2) / 4);
+				REQUIRE(mips[0][y][x].b == (c0.b + c1.b + c2.b + c3.b + 2) / 4);
+				REQUIRE(mips[0][y][x].a == 255);
+			}
+		}
+	}
+
+	SECTION("sRGB")
+	{
+		Image image{ 16, 16 };
+
+		for (int32 y = 0; y < image.height(); ++y)
+		{
+			for (int32 x = 0; x < image.width(); ++x)
+			{
+				image[y][x] = (IsEven(x) ? Color(0) : Color(255));
+			}
+		}
+
+		const Array<Image> linearMips = ImageProcessing::GenerateMips(image);
+		const Array<Image> srgbMips = ImageProcessing::GenerateMips(image, true);
+		REQUIRE(linearMips[0][0][0].r == 128);
+		REQUIRE(srgbMips[0][0][0].r == 188);
+		REQUIRE(srgbMips[0][0][0].a == 255);
+	}
+
+	SECTION("Batch")
+	{
+		const Array<Image> images = { Image{ 256, 256, Palette::Orange }, Image{ 100, 60, Palette::Skyblue }, Image{} };
+		const Array<Array<Image>> results = ImageProcessing::GenerateMips(images);
+		REQUIRE(results.size() == images.size());
+
+		for (size_t i = 0; i < images.size(); ++i)
+		{
+			const Array<Image> mips = ImageProcessing::GenerateMips(images[i]);
+			REQUIRE(results[i].size() == mips.size());
+
+			for (size_t level = 0; level < mips.size(); ++level)
+			{
+				REQUIRE(results[i][level].size() == mips[level].size());
+				REQUIRE(std::equal(results[i][level].begin(), results[i][level].end(), mips[level].begin()));
+			}
+		}
+	}
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("ImageProcessing::GenerateMips() benchmark")
+{
+	const Array<Image> images(16, Image{ 2048, 2048, Palette::Orange });
+
+	BENCHMARK("GenerateMips() 2048x2048")
+	{
+		return ImageProcessing::GenerateMips(images[0]);
+	};
+
+	BENCHMARK("GenerateMips() 16 x 2048x2048")
+	{
+		return ImageProcessing::GenerateMips(images);
+	};
+}
+
+# endif
@@ -0,0 +1,269 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+namespace
+{
+	struct Vec2Adapter : KDTreeAdapter<Array<Vec2>, Vec2>
+	{
+		static const element_type* GetPointer(const point_type& point)
+		{
+			return &point.x;
+		}
+
+		static element_type GetElement(const dataset_type& dataset, size_t index, size_t dim)
+		{
+			return dataset[index].elem(dim);
+		}
+	};
+
+	[[nodiscard]]
+	Array<size_t> BruteForceKnn(const Array<Vec2>& points, const Array<bool>& contained, const Vec2& center, const size_t k)
+	{
+		Array<std::pair<double, size_t>> candidates;
+
+		for (size_t i = 0; i < points.size(); ++i)
+		{
+			if (contained[i])
+			{
+				candidates.emplace_back(center.distanceFromSq(points[i]), i);
+			}
+		}
+
+		std::sort(candidates.begin(), candidates.end());
+
+		return candidates.take(k).map([](const std::pair<double, size_t>& candidate) { return candidate.second; });
+	}
+
+	[[nodiscard]]
+	Array<size_t> BruteForceRadius(const Array<Vec2>& points, const Array<bool>& contained, const Vec2& center, const double radius)
+	{
+		Array<size_t> results;
+
+		for (size_t i = 0; i < points.size(); ++i)
+		{
+			if (contained[i] && (center.distanceFromSq(points[i]) < (radius * radius)))
+			{
+				results << i;
+			}
+		}
+
+		return results;
+	}
+}
+
+TEST_CASE("DynamicKDTree")
+{
+	SmallRNG rng{ 12345 };
+
+	Array<Vec2> points(5000);
+
+	for (auto& point : points)
+	{
+		point = RandomVec2(RectF{ 1000, 1000 }, rng);
+	}
+
+	Array<bool> contained(points.size(), true);
+
+	DynamicKDTree<Vec2Adapter> tree{ points };
+	REQUIRE(tree.size() == points.size());
+
+	for (int32 i = 0; i < 1000; ++i)
+	{
+		const size_t index = (rng() % points.size());
+
+		switch (i % 3)
+		{
+		case 0:
+			tree.remove(index);
+			contained[index] = false;
+			break;
+		case 1:
+			points[index] = RandomVec2(RectF{ 1000, 1000 }, rng);
+			tree.update(index);
+			contained[index] = true;
+			break;
+		default:
+			points << RandomVec2(RectF{ 1000, 1000 }, rng);
+			contained << true;
+			tree.insert(points.size() - 1);
+			break;
+		}
+	}
+
+	REQUIRE(tree.size() == static_cast<size_t>(contained.count(true)));
+
+	Array<Vec2> centers;
+
+	for (int32 i = 0; i < 100; ++i)
+	{
+		centers << RandomVec2(RectF{ 1000, 1000 }, rng);
+	}
+
+	const Array<Array<size_t>> results = tree.knnSearchBatch(8, centers);
+	REQUIRE(results.size() == centers.size());
+
+	for (size_t i = 0; i < centers.size(); ++i)
+	{
+		REQUIRE(results[i] == BruteForceKnn(points, contained, centers[i], 8));
+	}
+
+	for (const auto& center : centers)
+	{
+		// 範囲内の点をすべて、重複なく返す
+		REQUIRE(tree.radiusSearch(center, 50.0).sorted() == BruteForceRadius(points, contained, center, 50.0));
+	}
+
+	tree.rebuildIndex();
+	REQUIRE(tree.size() == points.size());
+}
+
+TEST_CASE("DynamicKDTree : repeated updates")
+{
+	SmallRNG rng{ 23456 };
+
+	Array<Vec2> points(200);
+
+	for (auto& point : points)
+	{
+		point = RandomVec2(RectF{ 1000, 1000 }, rng);
+	}
+
+	const Array<bool> contained(points.size(), true);
+
+	DynamicKDTree<Vec2Adapter> tree{ points };
+
+	// update() だけを繰り返しても、古い点が溜まり続けずに詰め直される
+	for (int32 i = 0; i < 20000; ++i)
+	{
+		const size_t index = (rng() % points.size());
+		points[index] = RandomVec2(RectF{ 1000, 1000 }, rng);
+		tree.update(index);
+	}
+
+	REQUIRE(tree.size() == points.size());
+
+	for (int32 i = 0; i < 100; ++i)
+	{
+		const Vec2 center = RandomVec2(RectF{ 1000, 1000 }, rng);
+		REQUIRE(tree.knnSearch(8, center) == BruteForceKnn(points, contained, center, 8));
+		REQUIRE(tree.radiusSearch(center, 100.0).sorted() == BruteForceRadius(points, contained, center, 100.0));
+	}
+}
+
+TEST_CASE("KDTree::knnSearchBatch()")
+{
+	SmallRNG rng{ 54321 };
+
+	Array<Vec2> points(1000);
+
+	for (auto& point : points)
+	{
+		point = RandomVec2(RectF{ 100, 100 }, rng);
+	}
+
+	const KDTree<Vec2Adapter> tree{ points };
+
+	const Array<Vec2> centers = { Vec2{ 10, 10 }, Vec2{ 50, 50 }, Vec2{ 90, 20 } };
+
+	const Array<Array<size_t>> results = tree.knnSearchBatch(4, centers);
+	REQUIRE(results.size() == centers.size());
+
+	for (size_t i = 0; i < centers.size(); ++i)
+	{
+		REQUIRE(results[i] == tree.knnSearch(4, centers[i]));
+	}
+
+	const Array<Array<size_t>> radiusResults = tree.radiusSearchBatch(centers, 10.0, SortByDistance::Yes);
+
+	for (size_t i = 0; i < centers.size(); ++i)
+	{
+		REQUIRE(radiusResults[i] == tree.radiusSearch(centers[i], 10.0, SortByDistance::Yes));
+	}
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+// 10 万個の動く点の近傍探索のベンチマーク
+TEST_CASE("KDTree : benchmark")
+{
+	constexpr size_t N = 100'000;
+
+	SmallRNG rng{ 0 };
+
+	Array<Vec2> points(N);
+
+	for (auto& point : points)
+	{
+		point = RandomVec2(RectF{ 4000, 4000 }, rng);
+	}
+
+	const Array<Vec2> centers = points.take(10'000);
+
+	BENCHMARK("KDTree::rebuildIndex() | 100K")
+	{
+		KDTree<Vec2Adapter> tree{ points };
+		return tree.usedMemory();
+	};
+
+	BENCHMARK("DynamicKDTree::rebuildIndex() | 100K")
+	{
+		DynamicKDTree<Vec2Adapter> tree{ points };
+		return tree.usedMemory();
+	};
+
+	{
+		DynamicKDTree<Vec2Adapter> tree{ points };
+
+		BENCHMARK("DynamicKDTree::update() | 1K of 100K")
+		{
+			for (size_t i = 0; i < 1000; ++i)
+			{
+				tree.update(i * 100);
+			}
+
+			return tree.size();
+		};
+	}
+
+	{
+		const KDTree<Vec2Adapter> tree{ points };
+
+		BENCHMARK("KDTree::knnSearch() | 10K queries")
+		{
+			size_t sum = 0;
+
+			for (const auto& center : centers)
+			{
+				sum += tree.knnSearch(8, center).size();
+			}
+
+			return sum;
+		};
+
+		BENCHMARK("KDTree::knnSearchBatch() | 10K queries")
+		{
+			return tree.knnSearchBatch(8, centers).size();
+		};
+	}
+
+	{
+		const DynamicKDTree<Vec2Adapter> tree{ points };
+
+		BENCHMARK("DynamicKDTree::knnSearchBatch() | 10K queries")
+		{
+			return tree.knnSearchBatch(8, centers).size();
+		};
+	}
+}
+
+# endif
@@ -0,0 +1,366 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+namespace
+{
+	// 壁で区切られた格子状のナビメッシュを作る
+	NavMesh MakeMaze(const bool walls = true, const NavMeshConfig& config = {})
+	{
+		constexpr int32 N = 40;
+		constexpr float CellSize = 5.0f;
+
+		Array<Float2> vertices;
+		Array<TriangleIndex> indices;
+
+		for (int32 y = 0; y <= N; ++y)
+		{
+			for (int32 x = 0; x <= N; ++x)
+			{
+				vertices << Float2{ (x * CellSize), (y * CellSize) };
+			}
+		}
+
+		for (int32 y = 0; y < N; ++y)
+		{
+			for (int32 x = 0; x < N; ++x)
+			{
+				if (walls && ((x % 8) == 4) && ((y % 10) != 0))
+				{
+					continue;
+				}
+
+				const auto i0 = static_cast<TriangleIndex::value_type>(y * (N + 1) + x);
+				const auto i1 = static_cast<TriangleIndex::value_type>(i0 + 1);
+				const auto i2 = static_cast<TriangleIndex::value_type>(i0 + N + 1);
+				const auto i3 = static_cast<TriangleIndex::value_type>(i2 + 1);
+
+				indices << TriangleIndex{ i0, i2, i1 } << TriangleIndex{ i1, i2, i3 };
+			}
+		}
+
+		NavMesh navMesh;
+		navMesh.build(vertices, indices, config);
+		return navMesh;
+	}
+
+	double GetLength(const Array<Vec2>& path)
+	{
+		double length = 0.0;
+
+		for (size_t i = 1; i < path.size(); ++i)
+		{
+			length += path[i - 1].distanceFrom(path[i]);
+		}
+
+		return length;
+	}
+
+	Array<std::pair<Vec2, Vec2>> MakeStartEnds(const size_t count)
+	{
+		DefaultRNG rng{ 12345 };
+
+		Array<std::pair<Vec2, Vec2>> startEnds(count);
+
+		for (auto& startEnd : startEnds)
+		{
+			startEnd.first	= Vec2{ Random(1.0, 199.0, rng), Random(1.0, 199.0, rng) };
+			startEnd.second	= Vec2{ Random(1.0, 199.0, rng), Random(1.0, 199.0, rng) };
+		}
+
+		return startEnds;
+	}
+}
+
+TEST_CASE("NavMesh.queryBatch")
+{
+	const NavMesh navMesh = MakeMaze();
+	const Array<std::pair<Vec2, Vec2>> startEnds = MakeStartEnds(200);
+
+	const Array<Array<Vec2>> paths = navMesh.queryBatch(startEnds);
+	REQUIRE(paths.size() == startEnds.size());
+
+	size_t found = 0;
+
+	for (size_t i = 0; i < startEnds.size(); ++i)
+	{
+		REQUIRE(paths[i] == navMesh.query(startEnds[i].first, startEnds[i].second));
+		found += (not paths[i].isEmpty());
+	}
+
+	REQUIRE(0 < found);
+
+	REQUIRE(NavMesh{}.queryBatch(startEnds).all([](const Array<Vec2>& path) { return path.isEmpty(); }));
+}
+
+TEST_CASE("NavMesh.beginQuery")
+{
+	NavMesh navMesh = MakeMaze();
+	const Array<std::pair<Vec2, Vec2>> startEnds = MakeStartEnds(50);
+
+	Array<NavMeshQueryID> ids;
+
+	for (const auto& startEnd : startEnds)
+	{
+		ids << navMesh.beginQuery(startEnd.first, startEnd.second);
+		REQUIRE(navMesh.getQueryState(ids.back()) == NavMeshQueryState::InProgress);
+	}
+
+	navMesh.cancelQuery(ids[3]);
+	REQUIRE(navMesh.getQueryState(ids[3]) == NavMeshQueryState::Invalid);
+
+	// 1 回の呼び出しでは少しずつしか進まない
+	navMesh.updateQueries(16);
+	REQUIRE(navMesh.getQueryState(ids.back()) == NavMeshQueryState::InProgress);
+
+	Array<Vec2> path;
+	REQUIRE(navMesh.retrieveQueryResult(ids.back(), path) == false);
+
+	for (int32 i = 0; i < 10000; ++i)
+	{
+		if (navMesh.getQueryState(ids.back()) != NavMeshQueryState::InProgress)
+		{
+			break;
+		}
+
+		navMesh.updateQueries(64);
+	}
+
+	for (size_t i = 0; i < startEnds.size(); ++i)
+	{
+		if (i == 3)
+		{
+			continue;
+		}
+
+		const Array<Vec2> expected = navMesh.query(startEnds[i].first, startEnds[i].second);
+
+		REQUIRE(navMesh.getQueryState(ids[i]) == (expected ? NavMeshQueryState::Succeeded : NavMeshQueryState::Failed));
+		REQUIRE(navMesh.retrieveQueryResult(ids[i], path));
+		REQUIRE(path == expected);
+		REQUIRE(navMesh.getQueryState(ids[i]) == NavMeshQueryState::Invalid);
+	}
+}
+
+TEST_CASE("NavMesh obstacles")
+{
+	NavMesh navMesh = MakeMaze(false, NavMeshConfig{ .tileSize = 32 });
+	REQUIRE(navMesh.getTileCount() == Size{ 7, 7 });
+
+	const Vec2 start{ 100, 20 }, end{ 100, 180 };
+	const Array<Vec2> open = navMesh.query(start, end);
+	REQUIRE(GetLength(open) == Approx(160.0));
+
+	// 通路の右端だけを空けた壁
+	const RectF wall{ -10, 95, 170, 10 };
+	const NavMeshObstacleID wallID = navMesh.addObstacle(wall);
+	REQUIRE(wallID != 0);
+	REQUIRE(navMesh.num_obstacles() == 1);
+	REQUIRE(navMesh.isUpdating());
+
+	// 反映されるまでは以前のタイルが使われる
+	REQUIRE(navMesh.query(start, end) == open);
+
+	navMesh.rebuildTiles();
+	REQUIRE(not navMesh.isUpdating());
+
+	const Array<Vec2> detour = navMesh.query(start, end);
+	REQUIRE(GetLength(detour) > 200.0);
+	REQUIRE(detour.none([&](const Vec2& p) { return wall.intersects(p); }));
+
+	// バックグラウンドでの再構築
+	const Circle circle{ 175, 100, 30 };
+	navMesh.addObstacle(circle);
+
+	for (int32 i = 0; (i < 10000) && navMesh.isUpdating(); ++i)
+	{
+		navMesh.update();
+		System::Sleep(1);
+	}
+
+	REQUIRE(not navMesh.isUpdating());
+
+	// 目的地には到達できず、手前までの経路になる
+	const Array<Vec2> blocked = navMesh.query(start, end);
+	REQUIRE(blocked);
+	REQUIRE(blocked.back().distanceFrom(end) > 50.0);
+
+	REQUIRE(navMesh.removeObstacle(wallID));
+	REQUIRE(not navMesh.removeObstacle(wallID));
+	navMesh.clearObstacles();
+	REQUIRE(navMesh.num_obstacles() == 0);
+	navMesh.rebuildTiles();
+
+	REQUIRE(navMesh.query(start, end) == open);
+}
+
+TEST_CASE("NavMesh tile count overflow")
+{
+	const Array<Float2> vertices = { { 0, 0 }, { 200, 0 }, { 0, 200 }, { 200, 200 } };
+	const Array<TriangleIndex> indices = { { 0, 2, 1 }, { 1, 2, 3 } };
+
+	// タイルの数が dtPolyRef のタイル番号のビット数に収まらない
+	NavMesh navMesh;
+	REQUIRE(not navMesh.build(vertices, indices, NavMeshConfig{ .tileSize = 1 }));
+	REQUIRE(navMesh.getTileCount() == Size{ 0, 0 });
+	REQUIRE(not navMesh.query(Vec2{ 10, 10 }, Vec2{ 190, 190 }));
+
+	REQUIRE(navMesh.build(vertices, indices, NavMeshConfig{ .tileSize = 32 }));
+	REQUIRE(navMesh.getTileCount() == Size{ 7, 7 });
+	REQUIRE(navMesh.query(Vec2{ 10, 10 }, Vec2{ 190, 190 }));
+}
+
+TEST_CASE("NavCrowd")
+{
+	const NavMesh navMesh = MakeMaze(false);
+	NavCrowd crowd{ navMesh };
+
+	const NavCrowdAgentParameters parameters{ .radius = 1.0, .maxSpeed = 10.0, .maxAcceleration = 30.0 };
+	REQUIRE(crowd.addAgent(Vec2{ -100, -100 }, parameters) == 0);
+
+	// 2 つの列が正面からすれ違う
+	Array<NavCrowdAgentID> ids;
+	Array<Vec2> targets;
+
+	for (int32 i = 0; i < 10; ++i)
+	{
+		const double x = (20 + i * 8);
+
+		ids << crowd.addAgent(Vec2{ x, 20 }, parameters);
+		targets << Vec2{ x, 180 };
+
+		ids << crowd.addAgent(Vec2{ x, 180 }, parameters);
+		targets << Vec2{ x, 20 };
+	}
+
+	REQUIRE(crowd.num_agents() == ids.size());
+	REQUIRE(not ids.includes(0));
+
+	for (size_t i = 0; i < ids.size(); ++i)
+	{
+		REQUIRE(crowd.setTarget(ids[i], targets[i]));
+		REQUIRE(crowd.isMoving(ids[i]));
+	}
+
+	double minDistance = Math::Inf;
+
+	for (int32 step = 0; step < (60 * 60); ++step)
+	{
+		crowd.update(1.0 / 60.0);
+
+		const Array<Float3>& positions = crowd.positions();
+
+		for (size_t i = 0; i < positions.size(); ++i)
+		{
+			for (size_t k = (i + 1); k < positions.size(); ++k)
+			{
+				minDistance = Min(minDistance, Vec2{ positions[i].xz() }.distanceFrom(positions[k].xz()));
+			}
+		}
+
+		if (ids.none([&](NavCrowdAgentID id) { return crowd.isMoving(id); }))
+		{
+			break;
+		}
+	}
+
+	// 半径の和 2.0 から大きくめり込まない
+	REQUIRE(minDistance > 1.5);
+
+	for (size_t i = 0; i < ids.size(); ++i)
+	{
+		REQUIRE(not crowd.isMoving(ids[i]));
+		REQUIRE(Vec2{ crowd.positions()[crowd.getIndex(ids[i])].xz() }.distanceFrom(targets[i]) < 1.0);
+	}
+
+	// 削除すると最後のエージェントがその番号に移動する
+	REQUIRE(crowd.removeAgent(ids.front()));
+	REQUIRE(not crowd.removeAgent(ids.front()));
+	REQUIRE(not crowd.hasAgent(ids.front()));
+	REQUIRE(crowd.getIndex(ids.front()) == crowd.num_agents());
+	REQUIRE(crowd.getIndex(ids.back()) == 0);
+	REQUIRE(crowd.agentIDs().front() == ids.back());
+	REQUIRE(crowd.positions().size() == (ids.size() - 1));
+	REQUIRE(crowd.velocities().size() == (ids.size() - 1));
+	REQUIRE(crowd.radii().size() == (ids.size() - 1));
+
+	crowd.clear();
+	REQUIRE(crowd.num_agents() == 0);
+	REQUIRE(not crowd.hasAgent(ids.back()));
+}
+
+TEST_CASE("NavCrowd target blocked by an obstacle")
+{
+	NavMesh navMesh = MakeMaze(false, NavMeshConfig{ .tileSize = 32 });
+	NavCrowd crowd{ navMesh };
+
+	const NavCrowdAgentParameters parameters{ .radius = 1.0, .maxSpeed = 10.0, .maxAcceleration = 30.0 };
+	const Vec2 target{ 100, 180 };
+	const NavCrowdAgentID id = crowd.addAgent(Vec2{ 100, 20 }, parameters);
+
+	// 通路全体をふさぐ壁
+	const NavMeshObstacleID wallID = navMesh.addObstacle(RectF{ -10, 95, 220, 10 });
+	navMesh.rebuildTiles();
+
+	REQUIRE(crowd.setTarget(id, target));
+
+	const auto updateWhileMoving = [&]()
+	{
+		for (int32 step = 0; (step < (60 * 60)) && crowd.isMoving(id); ++step)
+		{
+			crowd.update(1.0 / 60.0);
+		}
+	};
+
+	// 壁の手前で止まる
+	updateWhileMoving();
+	REQUIRE(not crowd.isMoving(id));
+	REQUIRE(Vec2{ crowd.positions()[crowd.getIndex(id)].xz() }.distanceFrom(target) > 50.0);
+
+	// 壁が無くなると、壁の手前の点ではなく、指定した目的地に向かって再び動き出す
+	REQUIRE(navMesh.removeObstacle(wallID));
+	navMesh.rebuildTiles();
+
+	crowd.update(1.0 / 60.0);
+	REQUIRE(crowd.isMoving(id));
+
+	updateWhileMoving();
+	REQUIRE(not crowd.isMoving(id));
+	REQUIRE(Vec2{ crowd.positions()[crowd.getIndex(id)].xz() }.distanceFrom(target) < 1.0);
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("NavMesh.queryBatch benchmark")
+{
+	const NavMesh navMesh = MakeMaze();
+	const Array<std::pair<Vec2, Vec2>> startEnds = MakeStartEnds(4000);
+
+	BENCHMARK("query")
+	{
+		size_t n = 0;
+
+		for (const auto& startEnd : startEnds)
+		{
+			n += navMesh.query(startEnd.first, startEnd.second).size();
+		}
+
+		return n;
+	};
+
+	BENCHMARK("queryBatch")
+	{
+		return navMesh.queryBatch(startEnds).size();
+	};
+}
+
+# endif
@@ -0,0 +1,196 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+namespace
+{
+	// 床の上に物体を積んだ山を複数作る（山ごとに独立した島になる）
+	Array<P2Body> MakePiles(P2World& world, const int32 piles, const int32 bodiesPerPile)
+	{
+		Array<P2Body> bodies;
+
+		for (int32 p = 0; p < piles; ++p)
+		{
+			const double x = (p * 300.0);
+
+			bodies << world.createRect(P2Static, Vec2{ x, 0 }, SizeF{ 240, 20 });
+
+			for (int32 i = 0; i < bodiesPerPile; ++i)
+			{
+				const Vec2 pos{ (x + (i % 3) * 8.0 - 8.0), (-30.0 - i * 22.0) };
+
+				if (i % 4 == 0)
+				{
+					bodies << world.createCircle(P2Dynamic, pos, 10);
+				}
+				else
+				{
+					bodies << world.createRect(P2Dynamic, pos, 20);
+				}
+			}
+		}
+
+		return bodies;
+	}
+}
+
+TEST_CASE("P2World parallel islands")
+{
+	P2World serialWorld;
+	P2World parallelWorld;
+	serialWorld.setParallelIslandsEnabled(false);
+	REQUIRE(serialWorld.getParallelIslandsEnabled() == false);
+	REQUIRE(parallelWorld.getParallelIslandsEnabled() == true);
+
+	const Array<P2Body> serialBodies = MakePiles(serialWorld, 40, 16);
+	const Array<P2Body> parallelBodies = MakePiles(parallelWorld, 40, 16);
+
+	for (int32 i = 0; i < 180; ++i)
+	{
+		serialWorld.update(1.0 / 60.0);
+		parallelWorld.update(1.0 / 60.0);
+	}
+
+	// 島は互いに独立しているので、並列に解いても結果は完全に一致する
+	for (size_t i = 0; i < serialBodies.size(); ++i)
+	{
+		REQUIRE(serialBodies[i].getPos() == parallelBodies[i].getPos());
+		REQUIRE(serialBodies[i].getAngle() == parallelBodies[i].getAngle());
+	}
+
+	REQUIRE(serialWorld.getCollisions().size() == parallelWorld.getCollisions().size());
+
+	for (const auto& [pair, collision] : serialWorld.getCollisions())
+	{
+		const auto it = parallelWorld.getCollisions().find(pair);
+		REQUIRE(it != parallelWorld.getCollisions().end());
+		REQUIRE(collision.num_contacts() == it->second.num_contacts());
+
+		for (size_t k = 0; k < collision.num_contacts(); ++k)
+		{
+			REQUIRE(collision.contact(k).normalImpulse == it->second.contact(k).normalImpulse);
+		}
+	}
+}
+
+TEST_CASE("P2World parallel islands sharing static bodies")
+{
+	// 1 つの床と 1 つの支点を、すべての島が共有する
+	const auto makeWorld = [](P2World& world, Array<P2Body>& bodies, Array<P2PivotJoint>& joints)
+	{
+		const P2Body floor = world.createRect(P2Static, Vec2{ 6000, 0 }, SizeF{ 12400, 20 });
+		const P2Body anchor = world.createCircle(P2Static, Vec2{ 6000, -1000 }, 5);
+		bodies << floor << anchor;
+
+		for (int32 p = 0; p < 40; ++p)
+		{
+			const double x = (p * 300.0);
+
+			for (int32 i = 0; i < 8; ++i)
+			{
+				bodies << world.createRect(P2Dynamic, Vec2{ (x + (i % 3) * 8.0 - 8.0), (-30.0 - i * 22.0) }, 20);
+			}
+
+			const P2Body pendulum = world.createCircle(P2Dynamic, Vec2{ x, -800 }, 10);
+			joints << world.createPivotJoint(anchor, pendulum, Vec2{ x, -1000 });
+			bodies << pendulum;
+		}
+	};
+
+	P2World serialWorld;
+	P2World parallelWorld;
+	serialWorld.setParallelIslandsEnabled(false);
+
+	Array<P2Body> serialBodies, parallelBodies;
+	Array<P2PivotJoint> serialJoints, parallelJoints;
+	makeWorld(serialWorld, serialBodies, serialJoints);
+	makeWorld(parallelWorld, parallelBodies, parallelJoints);
+
+	for (int32 i = 0; i < 180; ++i)
+	{
+		serialWorld.update(1.0 / 60.0);
+		parallelWorld.update(1.0 / 60.0);
+	}
+
+	for (size_t i = 0; i < serialBodies.size(); ++i)
+	{
+		REQUIRE(serialBodies[i].getPos() == parallelBodies[i].getPos());
+		REQUIRE(serialBodies[i].getAngle() == parallelBodies[i].getAngle());
+	}
+}
+
+TEST_CASE("P2World fixed time step")
+{
+	P2World world;
+	const P2Body body = world.createCircle(P2Dynamic, Vec2{ 0, 0 }, 10);
+
+	// 2 進数で正確に表せる時間を使う
+	constexpr double TimeStep = (1.0 / 64.0);
+
+	REQUIRE(world.updateFixed((TimeStep * 0.5), TimeStep) == 0);
+	REQUIRE(world.getInterpolationAlpha() == 0.5);
+	REQUIRE(body.getPos() == Vec2{ 0, 0 });
+
+	REQUIRE(world.updateFixed((TimeStep * 2.5), TimeStep) == 3);
+	REQUIRE(world.getInterpolationAlpha() == 0.0);
+	REQUIRE(world.getProfile().stepCount == 3);
+	REQUIRE(body.getPos().y > 0.0);
+
+	// 補間した位置は、最後のステップの前後の位置の間にある
+	const Vec2 previous = body.getInterpolatedPos(0.0);
+	const Vec2 current = body.getPos();
+	REQUIRE(previous.y < current.y);
+	REQUIRE(body.getInterpolatedPos(1.0).y == Approx(current.y));
+	REQUIRE(body.getInterpolatedPos(0.5).y == Approx((previous.y + current.y) * 0.5));
+
+	// 処理が追いつかない分は切り捨てる
+	REQUIRE(world.updateFixed(1.0, TimeStep, 4) == 4);
+	REQUIRE(world.getInterpolationAlpha() < 1.0);
+	REQUIRE(world.updateFixed(0.0, TimeStep) == 0);
+
+	// 負の経過時間は 0 として扱う
+	const double alpha = world.getInterpolationAlpha();
+	REQUIRE(world.updateFixed(-1.0, TimeStep) == 0);
+	REQUIRE(world.getInterpolationAlpha() == alpha);
+	REQUIRE(world.updateFixed(TimeStep, TimeStep) == 1);
+
+	REQUIRE_THROWS_AS(world.updateFixed(0.1, 0.0), Error);
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("P2World.update benchmark")
+{
+	P2World world;
+	const Array<P2Body> bodies = MakePiles(world, 500, 40);
+
+	for (int32 i = 0; i < 60; ++i)
+	{
+		world.update(1.0 / 60.0);
+	}
+
+	BENCHMARK("P2World.update | 20k bodies")
+	{
+		world.update(1.0 / 60.0);
+		return world.getProfile().step;
+	};
+
+	world.setParallelIslandsEnabled(false);
+
+	BENCHMARK("P2World.update | 20k bodies, serial")
+	{
+		world.update(1.0 / 60.0);
+		return world.getProfile().step;
+	};
+}
+
+# endif
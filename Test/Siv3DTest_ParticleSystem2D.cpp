@@ -0,0 +1,223 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+TEST_CASE("IEmitter2D::emitN()")
+{
+	const auto emitTwice = [](IEmitter2D& emitter)
+	{
+		Array<Emission2D> a(100), b(100);
+		SmallRNG rngA{ 12345 }, rngB{ 12345 };
+		emitter.emitN(a.data(), a.size(), Vec2{ 100, 100 }, 50.0, rngA);
+		emitter.emitN(b.data(), b.size(), Vec2{ 100, 100 }, 50.0, rngB);
+
+		for (size_t i = 0; i < a.size(); ++i)
+		{
+			REQUIRE(a[i].position == b[i].position);
+			REQUIRE(a[i].velocity == b[i].velocity);
+		}
+	};
+
+	SECTION("CircleEmitter2D")
+	{
+		CircleEmitter2D emitter;
+		emitter.fromShell = true;
+		REQUIRE(emitter.supportsParallelEmission());
+		emitTwice(emitter);
+	}
+
+	SECTION("ArcEmitter2D")
+	{
+		ArcEmitter2D emitter;
+		REQUIRE(emitter.supportsParallelEmission());
+		emitTwice(emitter);
+	}
+
+	SECTION("RectEmitter2D")
+	{
+		RectEmitter2D emitter;
+		emitter.fromShell = true;
+		REQUIRE(emitter.supportsParallelEmission());
+		emitTwice(emitter);
+	}
+
+	SECTION("PolygonEmitter2D")
+	{
+		PolygonEmitter2D emitter{ Shape2D::Star(100, Vec2{ 0, 0 }).asPolygon() };
+		REQUIRE(emitter.supportsParallelEmission());
+		emitTwice(emitter);
+	}
+}
+
+TEST_CASE("ParticleSystem2D : update")
+{
+	ParticleSystem2DParameters parameters;
+	parameters.rate = 1010.0;
+	parameters.maxParticles = 100000;
+	parameters.startLifeTime = 1.0;
+	parameters.startSpeed = 50.0;
+	parameters.startAngularVelocityDeg = 90.0;
+
+	const Vec2 force{ 0, 10 };
+	ParticleSystem2D system{ Vec2{ 0, 0 }, force, CircleEmitter2D{}, parameters, Texture{} };
+	system.setSeed(1);
+	system.update(0.1);
+
+	const Array<Particle2D> before = system.getParticles();
+	REQUIRE(before.size() == system.num_particles());
+	REQUIRE(100 <= before.size());
+
+	// 古いパーティクルから順に並ぶ
+	for (size_t i = 1; i < before.size(); ++i)
+	{
+		REQUIRE(before[i - 1].remainingLifeTime <= before[i].remainingLifeTime);
+	}
+
+	// 以降は新しいパーティクルを生成しない
+	parameters.rate = 0.0;
+	system.setParameters(parameters);
+
+	SECTION("position, velocity and lifetime")
+	{
+		constexpr float deltaTime = 0.05f;
+		const Float2 deltaVelocity{ force * deltaTime };
+
+		system.update(deltaTime);
+
+		const Array<Particle2D> after = system.getParticles();
+		REQUIRE(after.size() == before.size());
+
+		for (size_t i = 0; i < after.size(); ++i)
+		{
+			const Float2 velocity = (before[i].velocity + deltaVelocity);
+			const Float2 position = (before[i].position + velocity * deltaTime);
+			REQUIRE(after[i].remainingLifeTime == (before[i].remainingLifeTime - deltaTime));
+			REQUIRE(after[i].velocity.x == Approx(velocity.x));
+			REQUIRE(after[i].velocity.y == Approx(velocity.y));
+			REQUIRE(after[i].position.x == Approx(position.x).margin(1e-4));
+			REQUIRE(after[i].position.y == Approx(position.y).margin(1e-4));
+			REQUIRE(after[i].rotation == Approx(before[i].rotation + before[i].startAngularVelocity * deltaTime).margin(1e-5));
+		}
+	}
+
+	SECTION("expiration")
+	{
+		// 残りの寿命は 0.9 ～ 1.0 秒なので、およそ半数のパーティクルの寿命が尽きる
+		constexpr float deltaTime = 0.95f;
+		const Float2 deltaVelocity{ force * deltaTime };
+
+		system.update(deltaTime);
+
+		const Array<Particle2D> expected = before.filter([=](const Particle2D& p) { return (0.0f <= (p.remainingLifeTime - deltaTime)); });
+		const Array<Particle2D> after = system.getParticles();
+		REQUIRE(0 < after.size());
+		REQUIRE(after.size() < before.size());
+		REQUIRE(after.size() == expected.size());
+
+		// 残ったパーティクルの順序は保たれる
+		for (size_t i = 0; i < after.size(); ++i)
+		{
+			const Float2 velocity = (expected[i].velocity + deltaVelocity);
+			const Float2 position = (expected[i].position + velocity * deltaTime);
+			REQUIRE(after[i].remainingLifeTime == (expected[i].remainingLifeTime - deltaTime));
+			REQUIRE(after[i].position.x == Approx(position.x).margin(1e-3));
+			REQUIRE(after[i].position.y == Approx(position.y).margin(1e-3));
+		}
+
+		system.update(1.0);
+		REQUIRE(system.num_particles() == 0);
+		REQUIRE(system.getParticles().isEmpty());
+	}
+}
+
+TEST_CASE("ParticleSystem2D : maxParticles")
+{
+	ParticleSystem2DParameters parameters;
+	parameters.rate = 1000.0;
+	parameters.maxParticles = 50;
+	parameters.startLifeTime = 1.0;
+
+	ParticleSystem2D system{ Vec2{ 0, 0 }, Vec2{ 0, 0 }, CircleEmitter2D{}, parameters, Texture{} };
+	system.setSeed(1);
+
+	for (int32 i = 0; i < 3; ++i)
+	{
+		system.update(0.1);
+
+		// 古いパーティクルから削除され、直近の 0.05 秒に生成されたものが残る
+		const Array<Particle2D> particles = system.getParticles();
+		REQUIRE(particles.size() == 50);
+
+		for (size_t k = 0; k < particles.size(); ++k)
+		{
+			REQUIRE(0.94f < particles[k].remainingLifeTime);
+
+			if (k)
+			{
+				REQUIRE(particles[k - 1].remainingLifeTime <= particles[k].remainingLifeTime);
+			}
+		}
+	}
+}
+
+TEST_CASE("ParticleSystem2D : seeded emission")
+{
+	ParticleSystem2DParameters parameters;
+	parameters.rate = 20000.0;
+	parameters.maxParticles = 100000;
+	parameters.startLifeTime = 2.0;
+	parameters.startSpeed = 80.0;
+
+	ParticleSystem2D a{ Vec2{ 0, 0 }, Vec2{ 0, 10 }, CircleEmitter2D{}, parameters, Texture{} };
+	ParticleSystem2D b{ Vec2{ 0, 0 }, Vec2{ 0, 10 }, CircleEmitter2D{}, parameters, Texture{} };
+	ParticleSystem2D c{ Vec2{ 0, 0 }, Vec2{ 0, 10 }, CircleEmitter2D{}, parameters, Texture{} };
+	a.setSeed(42);
+	b.setSeed(42);
+	c.setSeed(43);
+
+	const auto isSameState = [](const Array<Particle2D>& x, const Array<Particle2D>& y)
+	{
+		if (x.size() != y.size())
+		{
+			return false;
+		}
+
+		for (size_t i = 0; i < x.size(); ++i)
+		{
+			if ((x[i].position != y[i].position)
+				|| (x[i].velocity != y[i].velocity)
+				|| (x[i].remainingLifeTime != y[i].remainingLifeTime))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	};
+
+	for (int32 i = 0; i < 10; ++i)
+	{
+		a.update(1.0 / 60.0);
+		b.update(1.0 / 60.0);
+		c.update(1.0 / 60.0);
+
+		const Array<Particle2D> particlesA = a.getParticles();
+		const Array<Particle2D> particlesB = b.getParticles();
+		const Array<Particle2D> particlesC = c.getParticles();
+
+		REQUIRE(0 < particlesA.size());
+		REQUIRE(isSameState(particlesA, particlesB));
+
+		// シードが異なれば発生位置と速度も異なる
+		REQUIRE(not isSameState(particlesA, particlesC));
+	}
+}
@@ -0,0 +1,66 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+// Siv3D TODO: Excluded Test Case
+# if !SIV3D_PLATFORM(WEB)
+
+TEST_CASE("Profiler::SaveTrace")
+{
+	const FilePath path = FileSystem::FullPath(U"test/runtime/profiler/trace.json");
+
+	{
+		SIV3D_PROFILE_ZONE(U"Test::Ignored");
+	}
+
+	Profiler::BeginTrace();
+	REQUIRE(Profiler::IsTracing());
+
+	{
+		SIV3D_PROFILE_ZONE(U"Test::Outer");
+
+		{
+			SIV3D_PROFILE_ZONE(U"Test::\"Inner\"");
+		}
+
+		Threading::ParallelFor(64, [](size_t, size_t)
+			{
+				SIV3D_PROFILE_ZONE(U"Test::Parallel");
+			}, 1);
+	}
+
+	Profiler::EndTrace();
+	REQUIRE(not Profiler::IsTracing());
+
+	{
+		SIV3D_PROFILE_ZONE(U"Test::AfterEnd");
+	}
+
+	REQUIRE(Profiler::SaveTrace(path));
+
+	const String json = TextReader{ path }.readAll();
+	REQUIRE(json.starts_with(U"{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+	REQUIRE(json.includes(U"\"thread_name\""));
+	REQUIRE(json.includes(U"\"Test::Outer\""));
+	REQUIRE(json.includes(U"\"Test::\\\"Inner\\\"\""));
+	REQUIRE(json.count(U"\"Test::Parallel\"") == 64);
+	REQUIRE(not json.includes(U"Test::Ignored"));
+	REQUIRE(not json.includes(U"Test::AfterEnd"));
+
+	// 新しい記録を始めると以前の記録は破棄される
+	Profiler::BeginTrace();
+	Profiler::EndTrace();
+	REQUIRE(Profiler::SaveTrace(path));
+	REQUIRE(not TextReader{ path }.readAll().includes(U"Test::Outer"));
+}
+
+# endif
@@ -0,0 +1,492 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+# include "../Siv3D/src/Siv3D/Renderer2D/Renderer2DBatchReorder.hpp"
+# include "../Siv3D/src/Siv3D/Renderer2D/Vertex2DBuilder.hpp"
+
+TEST_CASE("Renderer2D : Texture::drawInstanced()")
+{
+	const Texture texture{ Image{ 16, 16, Palette::White } };
+
+	Array<SpriteInstance> instances(1000);
+
+	for (size_t i = 0; i < instances.size(); ++i)
+	{
+		instances[i].center = Float2{ (i % 40) * 20.0f, (i / 40) * 20.0f };
+		instances[i].size = Float2{ 16.0f, 16.0f };
+		instances[i].angle = (i * 0.01f);
+	}
+
+	// 前のフレームまでの描画を確定させる
+	System::Update();
+
+	texture.drawInstanced(instances);
+	texture.drawInstanced(instances.take(10));
+	texture.drawInstanced({});
+
+	// インスタンス数はフレームの終わりに集計される
+	System::Update();
+
+	REQUIRE(Profiler::GetStat().instanceCount == 1010);
+}
+
+TEST_CASE("Renderer2D : ScopedBatchReorder")
+{
+	const Texture textureA{ Image{ 16, 16, Palette::White } };
+	const Texture textureB{ Image{ 16, 16, Palette::Black } };
+
+	// 2 つのテクスチャを交互に描く
+	const auto drawSprites = [&](const bool overlap)
+	{
+		for (int32 i = 0; i < 100; ++i)
+		{
+			const Vec2 pos = (overlap ? Vec2{ 100, 100 } : Vec2{ ((i % 20) * 40), ((i / 20) * 20) });
+			textureA.draw(pos);
+			textureB.draw(pos.movedBy(20, 0));
+		}
+	};
+
+	// 前のフレームまでの描画を確定させる
+	System::Update();
+
+	drawSprites(false);
+
+	System::Update();
+
+	const ProfilerStat unsorted = Profiler::GetStat();
+	REQUIRE(unsorted.savedDrawCalls == 0);
+
+	SECTION("non-overlapping draws")
+	{
+		{
+			const ScopedBatchReorder reorder;
+			drawSprites(false);
+		}
+
+		System::Update();
+
+		const ProfilerStat sorted = Profiler::GetStat();
+		REQUIRE((sorted.drawCalls + sorted.savedDrawCalls) == unsorted.drawCalls);
+		REQUIRE(sorted.triangleCount == unsorted.triangleCount);
+	}
+
+	SECTION("overlapping draws")
+	{
+		{
+			const ScopedBatchReorder reorder;
+			drawSprites(true);
+		}
+
+		System::Update();
+
+		const ProfilerStat sorted = Profiler::GetStat();
+		REQUIRE(sorted.savedDrawCalls == 0);
+		REQUIRE(sorted.drawCalls == unsorted.drawCalls);
+	}
+}
+
+TEST_CASE("Renderer2D : Renderer2DBatchReorder")
+{
+	// 4 つの頂点からなる四角形を横に並べる
+	Array<Vertex2D> vertices;
+	Array<Vertex2D::IndexType> indices;
+
+	for (int32 i = 0; i < 4; ++i)
+	{
+		const auto base = static_cast<Vertex2D::IndexType>(vertices.size());
+
+		for (const Float2& pos : { Float2{ 0, 0 }, Float2{ 10, 0 }, Float2{ 0, 10 }, Float2{ 10, 10 } })
+		{
+			Vertex2D vertex{};
+			vertex.pos = pos.movedBy((i * 20.0f), 0.0f);
+			vertices.push_back(vertex);
+		}
+
+		for (const Vertex2D::IndexType index : { 0, 1, 2, 2, 1, 3 })
+		{
+			indices.push_back(base + index);
+		}
+	}
+
+	const auto getBounds = [&](const uint32 quad)
+	{
+		return Renderer2DBatchReorder::CalculateBounds(vertices.data(), (indices.data() + (quad * 6)), 6);
+	};
+
+	SECTION("bounds")
+	{
+		const FloatRect bounds = getBounds(1);
+		REQUIRE(bounds.left == 20.0f);
+		REQUIRE(bounds.top == 0.0f);
+		REQUIRE(bounds.right == 30.0f);
+		REQUIRE(bounds.bottom == 10.0f);
+
+		const FloatRect transformed = Renderer2DBatchReorder::TransformBounds(bounds, (Mat3x2::Rotate(Math::HalfPi) * Mat3x2::Translate(5, 5)));
+		REQUIRE(transformed.left == Approx(-5.0f));
+		REQUIRE(transformed.top == Approx(25.0f));
+		REQUIRE(transformed.right == Approx(5.0f));
+		REQUIRE(transformed.bottom == Approx(35.0f));
+	}
+
+	// 四角形ごとのステート
+	const Array<uint32> states = { 0, 1, 0, 1 };
+	const auto hasSameStates = [&](const uint32 a, const uint32 b) { return (states[a] == states[b]); };
+
+	SECTION("non-overlapping draws")
+	{
+		Renderer2DBatchReorder reorder;
+
+		for (uint32 i = 0; i < 4; ++i)
+		{
+			reorder.add((i * 6), 6, i, getBounds(i));
+		}
+
+		REQUIRE(reorder.sort(hasSameStates));
+		REQUIRE(reorder.getItems().map([](const auto& item) { return item.stateID; }) == Array<uint32>{ 0, 2, 1, 3 });
+		REQUIRE(reorder.getIndexRanges() == Array<std::pair<uint32, uint32>>{ { 0, 6 }, { 12, 6 }, { 6, 6 }, { 18, 6 } });
+
+		Array<Vertex2D::IndexType> reordered = indices;
+		Array<Vertex2D::IndexType> buffer;
+		Renderer2DBatchReorder::ReorderIndices(reordered.data(), 0, reorder.getIndexRanges(), buffer);
+
+		REQUIRE(reordered.size() == indices.size());
+		REQUIRE(std::equal(reordered.begin(), reordered.begin() + 6, indices.begin()));
+		REQUIRE(std::equal(reordered.begin() + 6, reordered.begin() + 12, indices.begin() + 12));
+		REQUIRE(std::equal(reordered.begin() + 12, reordered.begin() + 18, indices.begin() + 6));
+		REQUIRE(std::equal(reordered.begin() + 18, reordered.end(), indices.begin() + 18));
+
+		// インデックスの途中の範囲だけを並べ替える
+		reordered = indices;
+		Renderer2DBatchReorder::ReorderIndices((reordered.data() + 6), 6, { { 12, 6 }, { 6, 6 } }, buffer);
+		REQUIRE(std::equal(reordered.begin() + 6, reordered.begin() + 12, indices.begin() + 12));
+		REQUIRE(std::equal(reordered.begin() + 12, reordered.begin() + 18, indices.begin() + 6));
+	}
+
+	SECTION("overlapping draws")
+	{
+		Renderer2DBatchReorder reorder;
+
+		// 間の描画と重なる描画は、前の同じステートのグループに加えない
+		for (uint32 i = 0; i < 4; ++i)
+		{
+			reorder.add((i * 6), 6, i, getBounds(0));
+		}
+
+		REQUIRE(not reorder.sort(hasSameStates));
+		REQUIRE(reorder.getItems().map([](const auto& item) { return item.stateID; }) == Array<uint32>{ 0, 1, 2, 3 });
+
+		// 範囲がわからない描画は、すべての描画と重なるものとして扱う
+		reorder.clear();
+		reorder.add(0, 6, 0, getBounds(0));
+		reorder.add(6, 6, 1, Renderer2DBatchReorder::InfiniteBounds);
+		reorder.add(12, 6, 2, getBounds(2));
+
+		REQUIRE(not reorder.sort(hasSameStates));
+	}
+}
+
+TEST_CASE("Renderer2D : Vertex2DBuilder circle positions")
+{
+	// SIMD で計算した円の頂点座標を、スカラー版の計算と比べる
+	// SSE 版はスカラー版と同じ順序で乗算と加算を行うが、FMA や NEON で積和演算が融合されるビルドや
+	// 標準ライブラリの sin / cos の実装によっては最下位ビットが異なりうるため、半径と中心座標に比例した誤差を許す
+	Array<Vertex2D> vertices;
+	Array<Vertex2D::IndexType> indices;
+
+	const auto bufferCreator = [&](const Vertex2D::IndexType vertexSize, const Vertex2D::IndexType indexSize)
+	{
+		vertices.assign(vertexSize, Vertex2D{});
+		indices.assign(indexSize, 0);
+		return Vertex2DBufferPointer{ vertices.data(), indices.data(), 0 };
+	};
+
+	const auto getReference = [](const float r, const Vertex2D::IndexType i, const Vertex2D::IndexType quality)
+	{
+		const float rad = ((Math::TwoPiF / quality) * i);
+
+		// 品質が 40 以下のときは std::sin / std::cos のテーブル、それ以外は FastMath::SinCos() を使う
+		if (quality <= 40)
+		{
+			return Float2{ (r * std::cos(rad)), (r * -std::sin(rad)) };
+		}
+		else
+		{
+			const auto [s, c] = FastMath::SinCos(rad);
+			return Float2{ (r * c), -(r * s) };
+		}
+	};
+
+	const Float2 center{ 123.25f, -45.5f };
+
+	for (const float scale : { 0.5f, 1.0f, 4.0f })
+	{
+		for (const float r : { 2.0f, 5.0f, 20.0f, 37.5f, 100.0f, 1000.0f })
+		{
+			const float tolerance = (1e-5f * (r + center.length()));
+
+			// Circle
+			{
+				REQUIRE(Vertex2DBuilder::BuildCircle(bufferCreator, center, r, Float4{ 1, 1, 1, 1 }, Float4{ 1, 1, 1, 1 }, scale) != 0);
+
+				const auto quality = static_cast<Vertex2D::IndexType>(vertices.size() - 1);
+				REQUIRE(vertices[0].pos == center);
+
+				for (Vertex2D::IndexType i = 0; i < quality; ++i)
+				{
+					const Float2 expected = (center + getReference(r, i, quality));
+					REQUIRE(vertices[i + 1].pos.x == Approx(expected.x).margin(tolerance));
+					REQUIRE(vertices[i + 1].pos.y == Approx(expected.y).margin(tolerance));
+				}
+			}
+
+			// CircleFrame
+			{
+				const float thickness = (r * 0.3f);
+				REQUIRE(Vertex2DBuilder::BuildCircleFrame(bufferCreator, center, r, thickness, Float4{ 1, 1, 1, 1 }, Float4{ 1, 1, 1, 1 }, scale) != 0);
+
+				const auto quality = static_cast<Vertex2D::IndexType>(vertices.size() / 2);
+
+				for (Vertex2D::IndexType i = 0; i < quality; ++i)
+				{
+					const Float2 outer = (center + getReference((r + thickness), i, quality));
+					const Float2 inner = (center + getReference(r, i, quality));
+					REQUIRE(vertices[i * 2].pos.x == Approx(outer.x).margin(tolerance));
+					REQUIRE(vertices[i * 2].pos.y == Approx(outer.y).margin(tolerance));
+					REQUIRE(vertices[i * 2 + 1].pos.x == Approx(inner.x).margin(tolerance));
+					REQUIRE(vertices[i * 2 + 1].pos.y == Approx(inner.y).margin(tolerance));
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("Renderer2D : streamed vertex buffers")
+{
+	// 永続マップされた頂点バッファは区間をリングとして使い回すため、一周して前の区間を上書きした後の描画結果を確かめる
+	const RenderTexture renderTexture{ Size{ 64, 64 } };
+	Image image;
+
+	// 前のフレームまでの描画を確定させる
+	System::Update();
+
+	for (int32 frame = 0; frame < 8; ++frame)
+	{
+		const Color color = ((frame % 2) ? Palette::Red : Palette::Blue);
+		{
+			const ScopedRenderTarget2D target{ renderTexture.clear(Palette::Black) };
+
+			// 1 つの区間に収まらない量の頂点を 1 フレームおきに書き込む
+			if ((frame % 2) == 0)
+			{
+				for (int32 i = 0; i < 60000; ++i)
+				{
+					Rect{ 48, 48, 8 }.draw(Palette::White);
+				}
+			}
+
+			Rect{ 0, 0, 32, 64 }.draw(color);
+			Circle{ 48, 16, 8 }.draw(Palette::White);
+		}
+
+		Graphics2D::Flush();
+		renderTexture.readAsImage(image);
+
+		REQUIRE(image[Point{ 16, 32 }] == color);
+		REQUIRE(image[Point{ 48, 16 }] == Palette::White);
+		REQUIRE(image[Point{ 40, 32 }] == Palette::Black);
+		REQUIRE(image[Point{ 52, 52 }] == (((frame % 2) == 0) ? Palette::White : Palette::Black));
+
+		System::Update();
+	}
+}
+
+# ifndef SIV3D_NO_CONCURRENT_API
+
+TEST_CASE("Renderer2D : Texture created on another thread")
+{
+	// 同時にアップロードできるピクセルバッファの数より多くのテクスチャを別スレッドで作成する
+	constexpr int32 TextureCount = 12;
+
+	const auto getColor = [](const int32 i)
+	{
+		return Color{ static_cast<uint8>(i * 20), static_cast<uint8>(255 - i * 20), 128 };
+	};
+
+	Array<AsyncTask<Texture>> tasks;
+
+	for (int32 i = 0; i < TextureCount; ++i)
+	{
+		tasks << Async([=]()
+		{
+			const TextureDesc desc = ((i % 2) ? TextureDesc::Mipped : TextureDesc::Unmipped);
+			return Texture{ Image{ 8, 8, getColor(i) }, desc };
+		});
+	}
+
+	// 空の画像からはアップロードせずに空のテクスチャを作成する
+	AsyncTask<Texture> emptyTask = Async([]() { return Texture{ Image{} }; });
+
+	// テクスチャの作成はメインスレッドの System::Update() で進む
+	for (int32 frame = 0; frame < 600; ++frame)
+	{
+		if (tasks.all([](const AsyncTask<Texture>& task) { return task.isReady(); })
+			&& emptyTask.isReady())
+		{
+			break;
+		}
+
+		System::Update();
+	}
+
+	REQUIRE(emptyTask.isReady());
+	REQUIRE(emptyTask.get().isEmpty());
+
+	const RenderTexture renderTexture{ Size{ 16, 16 } };
+	Image image;
+
+	for (int32 i = 0; i < TextureCount; ++i)
+	{
+		REQUIRE(tasks[i].isReady());
+
+		const Texture texture = tasks[i].get();
+		REQUIRE(not texture.isEmpty());
+		REQUIRE(texture.size() == Size{ 8, 8 });
+		{
+			const ScopedRenderTarget2D target{ renderTexture.clear(Palette::Black) };
+			texture.draw(0, 0);
+		}
+
+		Graphics2D::Flush();
+		renderTexture.readAsImage(image);
+
+		REQUIRE(image[Point{ 1, 1 }] == getColor(i));
+		REQUIRE(image[Point{ 6, 6 }] == getColor(i));
+		REQUIRE(image[Point{ 12, 12 }] == Palette::Black);
+	}
+
+	System::Update();
+}
+
+# endif
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+// 2D 図形の頂点生成のベンチマーク
+// 頂点はレンダラのバッチに書き込まれ、Graphics2D::Flush() で GPU に送られる。
+// 計測値には頂点の生成と、バッファへの書き込み・転送の両方が含まれる
+TEST_CASE("Renderer2D : benchmark")
+{
+	constexpr int32 N = 100'000;
+
+	BENCHMARK("Rect::draw() | 100K")
+	{
+		for (int32 i = 0; i < N; ++i)
+		{
+			Rect{ (i % 800), (i % 600), 16 }.draw();
+		}
+
+		// 蓄積した頂点を GPU に送る
+		Graphics2D::Flush();
+	};
+
+	BENCHMARK("Circle::draw() | 100K")
+	{
+		for (int32 i = 0; i < N; ++i)
+		{
+			Circle{ (i % 800), (i % 600), 8 }.draw();
+		}
+
+		Graphics2D::Flush();
+	};
+
+	BENCHMARK("Circle::drawFrame() | 100K")
+	{
+		for (int32 i = 0; i < N; ++i)
+		{
+			Circle{ (i % 800), (i % 600), 8 }.drawFrame(2);
+		}
+
+		Graphics2D::Flush();
+	};
+
+	// 大きな円は sin/cos をテーブルではなく計算で求める
+	BENCHMARK("Circle::draw() r = 200 | 10K")
+	{
+		for (int32 i = 0; i < (N / 10); ++i)
+		{
+			Circle{ (i % 800), (i % 600), 200 }.draw();
+		}
+
+		Graphics2D::Flush();
+	};
+
+	BENCHMARK("Circle::drawFrame() r = 200 | 10K")
+	{
+		for (int32 i = 0; i < (N / 10); ++i)
+		{
+			Circle{ (i % 800), (i % 600), 200 }.drawFrame(4);
+		}
+
+		Graphics2D::Flush();
+	};
+
+	BENCHMARK("RoundRect::draw() | 100K")
+	{
+		for (int32 i = 0; i < N; ++i)
+		{
+			RoundRect{ (i % 800), (i % 600), 120, 80, 20 }.draw();
+		}
+
+		Graphics2D::Flush();
+	};
+
+	const LineString lineString{ Array<Vec2>::IndexedGenerate(1000, [](size_t i)
+		{
+			return Vec2{ (i * 0.8), (300 + 100 * std::sin(i * 0.1)) };
+		}) };
+
+	BENCHMARK("LineString::draw() 1000 points | 100")
+	{
+		for (int32 i = 0; i < (N / 1000); ++i)
+		{
+			lineString.draw(4);
+		}
+
+		Graphics2D::Flush();
+	};
+
+	const Texture texture{ Image{ 16, 16, Palette::White } };
+
+	BENCHMARK("Texture::drawAt() | 100K")
+	{
+		for (int32 i = 0; i < N; ++i)
+		{
+			texture.drawAt((i % 800), (i % 600));
+		}
+
+		Graphics2D::Flush();
+	};
+
+	const Array<SpriteInstance> instances = Array<SpriteInstance>::IndexedGenerate(N, [](size_t i)
+		{
+			return SpriteInstance{ .center = Float2{ (i % 800), (i % 600) }, .size = Float2{ 16, 16 } };
+		});
+
+	BENCHMARK("Texture::drawInstanced() | 100K")
+	{
+		texture.drawInstanced(instances);
+
+		Graphics2D::Flush();
+	};
+}
+
+# endif
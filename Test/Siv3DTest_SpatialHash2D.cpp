@@ -0,0 +1,174 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+namespace
+{
+	using IDPair = std::pair<SpatialHash2D<Circle>::IDType, SpatialHash2D<Circle>::IDType>;
+
+	[[nodiscard]]
+	IDPair Ordered(const uint32 a, const uint32 b)
+	{
+		return{ Min(a, b), Max(a, b) };
+	}
+}
+
+TEST_CASE("SpatialHash2D")
+{
+	SmallRNG rng{ 2021 };
+
+	SpatialHash2D<Circle> hash{ 40.0 };
+	Array<Circle> circles;
+	Array<bool> contained;
+
+	for (int32 i = 0; i < 2000; ++i)
+	{
+		// 多くのセルにまたがる大きな円も混ぜる
+		const double r = ((i % 250 == 0) ? 400.0 : Random(1.0, 30.0, rng));
+		circles << Circle{ RandomVec2(RectF{ -500, -500, 2000, 2000 }, rng), r };
+		contained << true;
+		REQUIRE(hash.insert(circles.back()) == static_cast<uint32>(i));
+	}
+
+	for (int32 i = 0; i < 1000; ++i)
+	{
+		const uint32 id = static_cast<uint32>(rng() % circles.size());
+
+		if (not contained[id])
+		{
+			continue;
+		}
+
+		if (i % 5 == 0)
+		{
+			REQUIRE(hash.remove(id));
+			contained[id] = false;
+		}
+		else
+		{
+			circles[id].moveBy(RandomVec2(20.0, rng));
+			hash.update(id, circles[id]);
+		}
+	}
+
+	REQUIRE(hash.size() == static_cast<size_t>(contained.count(true)));
+
+	SECTION("pairs")
+	{
+		Array<IDPair> expected;
+
+		for (uint32 a = 0; a < circles.size(); ++a)
+		{
+			for (uint32 b = (a + 1); b < circles.size(); ++b)
+			{
+				if (contained[a] && contained[b] && circles[a].intersects(circles[b]))
+				{
+					expected.emplace_back(a, b);
+				}
+			}
+		}
+
+		Array<IDPair> pairs;
+		hash.forEachIntersectingPair([&](uint32 a, uint32 b) { pairs << Ordered(a, b); });
+		REQUIRE(pairs.sorted() == expected);
+
+		REQUIRE(hash.getIntersectingPairs().map([](const IDPair& p) { return Ordered(p.first, p.second); }).sorted() == expected);
+		REQUIRE(expected.size() <= hash.getOverlappingPairs().size());
+	}
+
+	SECTION("query")
+	{
+		const RectF area{ 100, 200, 300, 150 };
+
+		Array<uint32> expected;
+
+		for (uint32 id = 0; id < circles.size(); ++id)
+		{
+			const RectF rect = circles[id].boundingRect();
+
+			if (contained[id]
+				&& (rect.x <= area.x + area.w) && (area.x <= rect.x + rect.w)
+				&& (rect.y <= area.y + area.h) && (area.y <= rect.y + rect.h))
+			{
+				expected << id;
+			}
+		}
+
+		REQUIRE(hash.query(area).sorted() == expected);
+		REQUIRE(hash.query(RectF{ -100000, -100000, 200000, 200000 }).size() == hash.size());
+
+		for (const auto id : hash.query(Circle{ 500, 500, 60 }))
+		{
+			REQUIRE(circles[id].boundingRect().intersects(Circle{ 500, 500, 60 }));
+		}
+	}
+
+	SECTION("reuse ID")
+	{
+		const uint32 removedID = static_cast<uint32>(std::find(contained.begin(), contained.end(), true) - contained.begin());
+		REQUIRE(hash.remove(removedID));
+		REQUIRE(not hash.contains(removedID));
+
+		// 直前に remove() した ID が再利用される
+		const uint32 id = hash.insert(Circle{ 0, 0, 1 });
+		REQUIRE(id == removedID);
+		REQUIRE(hash.size() == static_cast<size_t>(contained.count(true)));
+		REQUIRE(hash.contains(id));
+		REQUIRE(hash[id] == Circle{ 0, 0, 1 });
+		REQUIRE(hash.boundingRect(id) == RectF{ -1, -1, 2, 2 });
+	}
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+// 10 万個の動く円の衝突判定のベンチマーク
+TEST_CASE("SpatialHash2D : benchmark")
+{
+	constexpr size_t N = 100'000;
+
+	SmallRNG rng{ 0 };
+
+	Array<Circle> circles(N);
+
+	SpatialHash2D<Circle> hash{ 16.0 };
+
+	for (auto& circle : circles)
+	{
+		circle = Circle{ RandomVec2(RectF{ 8000, 8000 }, rng), 4 };
+		hash.insert(circle);
+	}
+
+	BENCHMARK("SpatialHash2D::update() | 100K")
+	{
+		for (uint32 i = 0; i < N; ++i)
+		{
+			circles[i].moveBy(RandomVec2(2.0, rng));
+			hash.update(i, circles[i]);
+		}
+
+		return hash.size();
+	};
+
+	BENCHMARK("SpatialHash2D::forEachIntersectingPair() | 100K")
+	{
+		size_t count = 0;
+		hash.forEachIntersectingPair([&](uint32, uint32) { ++count; });
+		return count;
+	};
+
+	BENCHMARK("SpatialHash2D::getIntersectingPairs() | 100K")
+	{
+		return hash.getIntersectingPairs().size();
+	};
+}
+
+# endif
@@ -1416,4 +1416,161 @@ TEST_CASE("TextReader::readAll(String&) | LONG")
 	}
 }
 
+
+TEST_CASE("TextReader::readLineView() | LONG")
+{
+	SECTION("UTF8_NO_BOM")
+	{
+		const FilePath path = FileSystem::FullPath(U"test/text/long/utf8_no_bom.txt");
+		TextReader reader(path);
+		REQUIRE(reader.readLineView() == U"あいうえお");
+		REQUIRE(reader.readLineView() == U"𩸽齟齬😎🙊");
+		REQUIRE(reader.readLineView() == U"ABC");
+		REQUIRE(reader.readLineView() == U"");
+		REQUIRE(reader.readLineView() == U"AB");
+		REQUIRE(reader.readLineView() == U"");
+		REQUIRE(reader.readLineView() == U"A");
+		REQUIRE(reader.readLineView() == U"");
+		REQUIRE(reader.readLineView() == none);
+		REQUIRE(reader.readLineView() == none);
+	}
+
+	SECTION("UTF16LE")
+	{
+		const FilePath path = FileSystem::FullPath(U"test/text/long/utf16_le.txt");
+		TextReader reader(path);
+		REQUIRE(reader.readLineView() == U"あいうえお");
+		REQUIRE(reader.readLineView() == U"𩸽齟齬😎🙊");
+		REQUIRE(reader.readLineView() == U"ABC");
+		REQUIRE(reader.readLineView() == U"");
+		REQUIRE(reader.readLineView() == U"AB");
+		REQUIRE(reader.readLineView() == U"");
+		REQUIRE(reader.readLineView() == U"A");
+		REQUIRE(reader.readLineView() == U"");
+		REQUIRE(reader.readLineView() == none);
+		REQUIRE(reader.readLineView() == none);
+	}
+}
+
+TEST_CASE("TextReader | LARGE")
+{
+	// 内部バッファの境界をまたぐ行や、バッファより長い行を含むテキスト
+	Array<String> expectedLines;
+	std::string text;
+	{
+		const String pattern = U"あいうえお𩸽齟齬😎🙊ABC";
+
+		for (size_t i = 0; i < 20000; ++i)
+		{
+			const size_t length = ((i == 10000) ? 100000 : (i * 7 % 97));
+			String line;
+
+			for (size_t k = 0; k < length; ++k)
+			{
+				line.push_back(pattern[(i + k) % pattern.size()]);
+			}
+
+			text += line.toUTF8();
+			text += ((i % 3 == 0) ? "\r\n" : "\n");
+			expectedLines << line;
+		}
+	}
+
+	SECTION("readLine()")
+	{
+		TextReader reader{ MemoryReader{ text.data(), text.size() }, TextEncoding::UTF8_NO_BOM };
+
+		for (const auto& expected : expectedLines)
+		{
+			REQUIRE(reader.readLine() == expected);
+		}
+
+		REQUIRE(reader.readLine() == none);
+	}
+
+	SECTION("readLineView()")
+	{
+		TextReader reader{ MemoryReader{ text.data(), text.size() }, TextEncoding::UTF8_NO_BOM };
+
+		for (const auto& expected : expectedLines)
+		{
+			REQUIRE(reader.readLineView() == expected);
+		}
+
+		REQUIRE(reader.readLineView() == none);
+	}
+
+	SECTION("readLines()")
+	{
+		TextReader reader{ MemoryReader{ text.data(), text.size() }, TextEncoding::UTF8_NO_BOM };
+		REQUIRE(reader.readLines() == expectedLines);
+	}
+
+	SECTION("readAll()")
+	{
+		TextReader reader{ MemoryReader{ text.data(), text.size() }, TextEncoding::UTF8_NO_BOM };
+		REQUIRE(reader.readAll() == (expectedLines.join(U"\n", U"", U"") + U"\n"));
+	}
+
+	SECTION("readLine() and readChar()")
+	{
+		TextReader reader{ MemoryReader{ text.data(), text.size() }, TextEncoding::UTF8_NO_BOM };
+
+		for (const auto& expected : expectedLines)
+		{
+			if (expected.isEmpty())
+			{
+				REQUIRE(reader.readLine() == expected);
+				continue;
+			}
+
+			REQUIRE(reader.readChar() == expected.front());
+			REQUIRE(reader.readLine() == expected.substr(1));
+		}
+
+		REQUIRE(reader.readChar() == none);
+	}
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("TextReader : benchmark")
+{
+	std::string text;
+
+	for (size_t i = 0; i < 200000; ++i)
+	{
+		text += "The quick brown fox jumps over the lazy dog. 吾輩は猫である。\r\n";
+	}
+
+	BENCHMARK("TextReader::readLine(String&)")
+	{
+		TextReader reader{ MemoryReader{ text.data(), text.size() }, TextEncoding::UTF8_NO_BOM };
+		String line;
+		size_t length = 0;
+
+		while (reader.readLine(line))
+		{
+			length += line.size();
+		}
+
+		return length;
+	};
+
+	BENCHMARK("TextReader::readLineView()")
+	{
+		TextReader reader{ MemoryReader{ text.data(), text.size() }, TextEncoding::UTF8_NO_BOM };
+		size_t length = 0;
+
+		while (const auto line = reader.readLineView())
+		{
+			length += line->size();
+		}
+
+		return length;
+	};
+}
+
+# endif
+
 SIV3D_DISABLE_MSVC_WARNINGS_POP()
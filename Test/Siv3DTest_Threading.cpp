@@ -0,0 +1,76 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+TEST_CASE("Threading::ParallelFor()")
+{
+	SECTION("covers every index exactly once")
+	{
+		for (size_t grainSize : { 0, 1, 7, 1000 })
+		{
+			Array<int32> v(10000, 0);
+
+			Threading::ParallelFor(v.size(), [&](size_t first, size_t last)
+			{
+				for (size_t i = first; i < last; ++i)
+				{
+					++v[i];
+				}
+			}, grainSize);
+
+			REQUIRE(v.all([](int32 n) { return (n == 1); }));
+		}
+	}
+
+	SECTION("nested")
+	{
+		std::atomic<size_t> count = 0;
+
+		Threading::ParallelFor(64, [&](size_t first, size_t last)
+		{
+			for (size_t i = first; i < last; ++i)
+			{
+				Threading::ParallelFor(64, [&](size_t f, size_t l)
+				{
+					count += (l - f);
+				}, 1);
+			}
+		}, 1);
+
+		REQUIRE(count == (64 * 64));
+	}
+
+	SECTION("exception")
+	{
+		REQUIRE_THROWS_AS(Threading::ParallelFor(100, [](size_t, size_t) { throw std::runtime_error{ "" }; }, 1), std::runtime_error);
+	}
+}
+
+TEST_CASE("Threading::Submit()")
+{
+	auto task = Threading::Submit([](int32 a, int32 b) { return (a + b); }, 20, 22);
+
+	REQUIRE(task.get() == 42);
+}
+
+TEST_CASE("Grid::parallel_map()")
+{
+	Grid<int32> grid(64, 64);
+	int32 value = 0;
+
+	for (auto& n : grid)
+	{
+		n = value++;
+	}
+
+	REQUIRE(grid.map([](int32 n) { return (n * 2); }) == grid.parallel_map([](int32 n) { return (n * 2); }));
+}
@@ -0,0 +1,237 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# include "Siv3DTest.hpp"
+
+namespace
+{
+	// 以前の 1 文字ずつの変換。SIMD による変換の結果と比較する
+	String FromUTF8_Scalar(const std::string_view s)
+	{
+		String result;
+
+		const char* pSrc = s.data();
+		const char* const pSrcEnd = (pSrc + s.size());
+
+		while (pSrc != pSrcEnd)
+		{
+			const uint8 b0 = static_cast<uint8>(pSrc[0]);
+			const size_t rest = (pSrcEnd - pSrc);
+			const auto continuation = [&](const size_t i) { return ((i < rest) && ((static_cast<uint8>(pSrc[i]) & 0xC0) == 0x80)); };
+
+			char32 ch = 0xFFFD;
+			size_t length = 1;
+
+			if (b0 < 0x80)
+			{
+				ch = b0;
+			}
+			else if ((0xC0 <= b0) && (b0 < 0xE0) && continuation(1))
+			{
+				if (const char32 cp = (((b0 & 0x1F) << 6) | (pSrc[1] & 0x3F)); 0x80 <= cp)
+				{
+					ch = cp;
+					length = 2;
+				}
+			}
+			else if ((0xE0 <= b0) && (b0 < 0xF0) && continuation(1) && continuation(2))
+			{
+				if (const char32 cp = (((b0 & 0x0F) << 12) | ((pSrc[1] & 0x3F) << 6) | (pSrc[2] & 0x3F)); 0x800 <= cp)
+				{
+					ch = cp;
+					length = 3;
+				}
+			}
+			else if ((0xF0 <= b0) && (b0 < 0xF8) && continuation(1) && continuation(2) && continuation(3))
+			{
+				if (const char32 cp = (((b0 & 0x0F) << 18) | ((pSrc[1] & 0x3F) << 12) | ((pSrc[2] & 0x3F) << 6) | (pSrc[3] & 0x3F));
+					(0x10000 <= cp) && (cp < 0x110000))
+				{
+					ch = cp;
+					length = 4;
+				}
+			}
+
+			result.push_back(ch);
+			pSrc += length;
+		}
+
+		return result;
+	}
+
+	std::string ToUTF8_Scalar(const StringView s)
+	{
+		std::string result;
+
+		for (char32 ch : s)
+		{
+			if (0x110000 <= ch)
+			{
+				ch = 0xFFFD;
+			}
+
+			if (ch < 0x80)
+			{
+				result.push_back(static_cast<char>(ch));
+			}
+			else if (ch < 0x800)
+			{
+				result.push_back(static_cast<char>(0xC0 | (ch >> 6)));
+				result.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+			}
+			else if (ch < 0x10000)
+			{
+				result.push_back(static_cast<char>(0xE0 | (ch >> 12)));
+				result.push_back(static_cast<char>(0x80 | ((ch >> 6) & 0x3F)));
+				result.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+			}
+			else
+			{
+				result.push_back(static_cast<char>(0xF0 | (ch >> 18)));
+				result.push_back(static_cast<char>(0x80 | ((ch >> 12) & 0x3F)));
+				result.push_back(static_cast<char>(0x80 | ((ch >> 6) & 0x3F)));
+				result.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+			}
+		}
+
+		return result;
+	}
+
+	String MakeRandomText(const size_t length, const double asciiRatio, DefaultRNG& rng)
+	{
+		constexpr char32 Samples[] = { 0x7F, 0x80, 0x7FF, 0x800, 0x3042, 0xD800, 0xFFFD, 0xFFFF, 0x10000, 0x1F600, 0x10FFFF, 0x110000, 0xFFFFFFFF };
+
+		String text(length, U'\0');
+
+		for (auto& ch : text)
+		{
+			if (RandomBool(asciiRatio, rng))
+			{
+				ch = static_cast<char32>(Random(0x00, 0x7F, rng));
+			}
+			else if (RandomBool(0.5, rng))
+			{
+				ch = Samples[Random(std::size(Samples) - 1, rng)];
+			}
+			else
+			{
+				ch = static_cast<char32>(Random(0x80, 0x10FFFF, rng));
+			}
+		}
+
+		return text;
+	}
+}
+
+TEST_CASE("Unicode.FromUTF8")
+{
+	REQUIRE(Unicode::FromUTF8("") == U"");
+	REQUIRE(Unicode::FromUTF8("Siv3D") == U"Siv3D");
+	REQUIRE(Unicode::FromUTF8("\xE3\x81\x82\xF0\x9F\x98\x80 Siv3D \xC3\xA9") == U"あ😀 Siv3D é");
+
+	// 不正なバイト列は 1 バイトずつ U+FFFD になる
+	REQUIRE(Unicode::FromUTF8("a\x80" "b") == U"a�b");
+	REQUIRE(Unicode::FromUTF8("\xC0\xAF") == U"��");
+	REQUIRE(Unicode::FromUTF8("\xE0\x80\xAF") == U"���");
+	REQUIRE(Unicode::FromUTF8("\xF4\x90\x80\x80") == U"����");
+	REQUIRE(Unicode::FromUTF8("0123456789abcdef\xE3\x81") == U"0123456789abcdef��");
+
+	// サロゲートのコードポイントは、そのまま変換される
+	REQUIRE(Unicode::FromUTF8("\xED\xA0\x80")[0] == 0xD800);
+
+	DefaultRNG rng{ 12345 };
+
+	for (int32 i = 0; i < 2000; ++i)
+	{
+		std::string utf8 = ToUTF8_Scalar(MakeRandomText(Random(0, 200, rng), Random(0.0, 1.0, rng), rng));
+
+		// 一部を壊す
+		if ((not utf8.empty()) && RandomBool(0.5, rng))
+		{
+			utf8[Random(utf8.size() - 1, rng)] = static_cast<char>(Random(0x00, 0xFF, rng));
+		}
+
+		const String expected = FromUTF8_Scalar(utf8);
+		REQUIRE(Unicode::FromUTF8(utf8) == expected);
+		REQUIRE(Unicode::UTF8ToUTF32(utf8) == expected.toUTF32());
+	}
+}
+
+TEST_CASE("Unicode.ToUTF8")
+{
+	REQUIRE(Unicode::ToUTF8(U"") == "");
+	REQUIRE(Unicode::ToUTF8(U"あ😀 Siv3D é") == "\xE3\x81\x82\xF0\x9F\x98\x80 Siv3D \xC3\xA9");
+	REQUIRE(Unicode::ToUTF8(String(1, static_cast<char32>(0x110000))) == "\xEF\xBF\xBD");
+
+	DefaultRNG rng{ 12345 };
+
+	for (int32 i = 0; i < 2000; ++i)
+	{
+		const String text = MakeRandomText(Random(0, 200, rng), Random(0.0, 1.0, rng), rng);
+		const std::string expected = ToUTF8_Scalar(text);
+
+		REQUIRE(Unicode::ToUTF8(text) == expected);
+		REQUIRE(Unicode::UTF32ToUTF8(text.toUTF32()) == expected);
+	}
+}
+
+# if defined(SIV3D_RUN_BENCHMARK)
+
+TEST_CASE("Unicode : benchmark")
+{
+	DefaultRNG rng{ 12345 };
+	const String ascii = MakeRandomText(4'000'000, 1.0, rng);
+	const String mixed = MakeRandomText(4'000'000, 0.7, rng);
+	const std::string asciiUTF8 = Unicode::ToUTF8(ascii);
+	const std::string mixedUTF8 = Unicode::ToUTF8(mixed);
+
+	BENCHMARK("FromUTF8() scalar | ASCII")
+	{
+		return FromUTF8_Scalar(asciiUTF8).size();
+	};
+
+	BENCHMARK("Unicode::FromUTF8() | ASCII")
+	{
+		return Unicode::FromUTF8(asciiUTF8).size();
+	};
+
+	BENCHMARK("FromUTF8() scalar | mixed")
+	{
+		return FromUTF8_Scalar(mixedUTF8).size();
+	};
+
+	BENCHMARK("Unicode::FromUTF8() | mixed")
+	{
+		return Unicode::FromUTF8(mixedUTF8).size();
+	};
+
+	BENCHMARK("ToUTF8() scalar | ASCII")
+	{
+		return ToUTF8_Scalar(ascii).size();
+	};
+
+	BENCHMARK("Unicode::ToUTF8() | ASCII")
+	{
+		return Unicode::ToUTF8(ascii).size();
+	};
+
+	BENCHMARK("ToUTF8() scalar | mixed")
+	{
+		return ToUTF8_Scalar(mixed).size();
+	};
+
+	BENCHMARK("Unicode::ToUTF8() | mixed")
+	{
+		return Unicode::ToUTF8(mixed).size();
+	};
+}
+
+# endif
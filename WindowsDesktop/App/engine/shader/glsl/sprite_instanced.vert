@@ -0,0 +1,68 @@
+//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2021 Ryo Suzuki
+//	Copyright (c) 2016-2021 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# version 410
+
+//
+//	VSInput (per instance)
+//
+layout(location = 0) in vec2 InstanceCenter;
+layout(location = 1) in vec2 InstanceSize;
+layout(location = 2) in vec4 InstanceUV;
+layout(location = 3) in vec4 InstanceColor;
+layout(location = 4) in float InstanceAngle;
+
+//
+//	VSOutput
+//
+layout(location = 0) out vec4 Color;
+layout(location = 1) out vec2 UV;
+out gl_PerVertex
+{
+	vec4 gl_Position;
+};
+
+//
+//	Siv3D Functions
+//
+vec4 s3d_Transform2D(const vec2 pos, const vec4 t[2])
+{
+	return vec4(t[0].zw + (pos.x * t[0].xy) + (pos.y * t[1].xy), t[1].zw);
+}
+
+//
+//	Constant Buffer
+//
+layout(std140) uniform VSConstants2D
+{
+	vec4 g_transform[2];
+	vec4 g_colorMul;
+};
+
+//
+//	Functions
+//
+void main()
+{
+	// GL_TRIANGLE_STRIP: (0, 0), (1, 0), (0, 1), (1, 1)
+	const vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+
+	const vec2 local = ((corner - 0.5) * InstanceSize);
+	const float s = sin(InstanceAngle);
+	const float c = cos(InstanceAngle);
+	const vec2 pos = InstanceCenter + vec2((local.x * c - local.y * s), (local.x * s + local.y * c));
+
+	gl_Position = s3d_Transform2D(pos, g_transform);
+
+	Color = (InstanceColor * g_colorMul);
+
+	UV = mix(InstanceUV.xy, InstanceUV.zw, corner);
+}